@@ -28,9 +28,11 @@
 //*************************************************************************************************
 
 #include <blaze/math/Accuracy.h>
+#include <blaze/math/AssemblyPattern.h>
 #include <blaze/math/CMathTrait.h>
 #include <blaze/math/CompressedMatrix.h>
 #include <blaze/math/CompressedVector.h>
+#include <blaze/math/CSRMatrix.h>
 #include <blaze/math/Constants.h>
 #include <blaze/math/Constraints.h>
 #include <blaze/math/DynamicMatrix.h>
@@ -0,0 +1,36 @@
+//=================================================================================================
+/*!
+//  \file blaze/config/Prefetch.h
+//  \brief Configuration of the software prefetching of the sparse matrix kernels
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+
+namespace blaze {
+
+//*************************************************************************************************
+/*!\brief Prefetch distance of the sparse matrix kernels.
+// \ingroup config
+//
+// This setting specifies the number of non-zero elements the sparse matrix/dense vector
+// multiplication kernels look ahead to prefetch the indexed elements of the dense vector
+// operand (or target). A value of 0 disables the software prefetching.
+*/
+const size_t prefetchDistance = 8UL;
+//*************************************************************************************************
+
+} // namespace blaze
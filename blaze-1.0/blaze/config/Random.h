@@ -27,13 +27,17 @@ namespace blaze {
 // \ingroup config
 //
 // This type definition represents the type of the random number generated used in the Blaze
-// library. The default random number generator is the boost::mt19937 mersenne-twister pseudo
-// random number generator. For more information see the class description of the boost library:
+// library. The default random number generator is the counter-based Philox4x32-10 generator
+// (see the Philox class description). Since every thread of the Blaze library generates its
+// random numbers from its own stream, the random number generator has to provide independent,
+// seekable streams in the same way as the Philox class:
 //
-//   http://www.boost.org/doc/libs/1_35_0/libs/random/random-generators.html#mersenne_twister\n
-//   http://www.boost.org/doc/libs/1_35_0/boost/random/mersenne_twister.hpp
+//  - a constructor taking the seed and the number of the stream,
+//  - a seed() function that restarts the stream with a new seed,
+//  - the uniform() and fill() functions for floating point values,
+//  - the skip() and split() functions for the parallel generation of random numbers.
 */
-typedef boost::mt19937  RNG;
+typedef Philox  RNG;
 //*************************************************************************************************
 
 } // namespace blaze
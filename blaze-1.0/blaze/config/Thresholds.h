@@ -157,4 +157,189 @@ const size_t TDMATDMATMULT_THRESHOLD = 10000UL;
 const size_t TDMATTDMATMULT_THRESHOLD = 10000UL;
 //*************************************************************************************************
 
+
+//*************************************************************************************************
+/*!\brief SMP dense vector assignment threshold.
+// \ingroup config
+//
+// This threshold specifies when an assignment of a plain dense vector or of an element-wise
+// dense vector expression (as for instance a dense vector addition or a dense vector/scalar
+// multiplication) can be executed in parallel. In case the number of elements of the target
+// vector is equal or higher than this value, the assignment is executed in parallel. If the
+// number of elements is below this threshold the assignment is executed single-threaded.
+//
+// The default setting for this threshold is 38000.
+*/
+const size_t SMP_DVECASSIGN_THRESHOLD = 38000UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief SMP dense matrix assignment threshold.
+// \ingroup config
+//
+// This threshold specifies when an assignment of a plain dense matrix or of an element-wise
+// dense matrix expression (as for instance a dense matrix addition or a dense matrix/scalar
+// multiplication) can be executed in parallel. In case the number of elements of the target
+// matrix is equal or higher than this value, the assignment is executed in parallel. If the
+// number of elements is below this threshold the assignment is executed single-threaded.
+//
+// The default setting for this threshold is 48400 (which for instance corresponds to a matrix
+// size of \f$ 220 \times 220 \f$).
+*/
+const size_t SMP_DMATASSIGN_THRESHOLD = 48400UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief SMP row-major dense matrix/dense vector multiplication threshold.
+// \ingroup config
+//
+// This threshold specifies when a row-major dense matrix/dense vector multiplication can be
+// executed in parallel. In case the number of elements in the dense matrix is equal or higher
+// than this value, the multiplication is executed in parallel. If the number of elements is
+// below this threshold the multiplication is executed single-threaded. Note that this setting
+// only applies to the Blaze kernels, i.e. in case BLAS mode is disabled or in case the number
+// of elements in the matrix is below the DMATDVECMULT_THRESHOLD.
+//
+// The default setting for this threshold is 62500 (which for instance corresponds to a matrix
+// size of \f$ 250 \times 250 \f$).
+*/
+const size_t SMP_DMATDVECMULT_THRESHOLD = 62500UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief SMP dense matrix/dense matrix multiplication threshold.
+// \ingroup config
+//
+// This threshold specifies when a dense matrix/dense matrix multiplication can be executed in
+// parallel. In case the number of elements of the target matrix is equal or higher than this
+// value, the multiplication is executed in parallel. If the number of elements is below this
+// threshold the multiplication is executed single-threaded. The threshold applies to all
+// combinations of row-major and column-major matrices, but only to the Blaze kernels, i.e. in
+// case BLAS mode is disabled.
+//
+// The default setting for this threshold is 10000 (which for instance corresponds to a matrix
+// size of \f$ 100 \times 100 \f$).
+*/
+const size_t SMP_DMATDMATMULT_THRESHOLD = 10000UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief SMP row-major sparse matrix/dense vector multiplication threshold.
+// \ingroup config
+//
+// This threshold specifies when a row-major sparse matrix/dense vector multiplication can be
+// executed in parallel. In case the number of rows of the sparse matrix is equal or higher than
+// this value, the rows are partitioned into one block of approximately equal number of non-zero
+// elements per thread and the multiplication is executed in parallel. If the number of rows is
+// below this threshold the multiplication is executed single-threaded.
+//
+// The default setting for this threshold is 10000.
+*/
+const size_t SMP_SMATDVECMULT_THRESHOLD = 10000UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief SMP column-major sparse matrix/dense vector multiplication threshold.
+// \ingroup config
+//
+// This threshold specifies when a column-major sparse matrix/dense vector multiplication can be
+// executed in parallel. In case the number of columns of the sparse matrix is equal or higher
+// than this value, each thread accumulates the product of a block of columns into a private
+// vector and the private vectors are summed up in parallel. If the number of columns is below
+// this threshold the multiplication is executed single-threaded.
+//
+// The default setting for this threshold is 20000.
+*/
+const size_t SMP_TSMATDVECMULT_THRESHOLD = 20000UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief SMP sparse matrix/sparse matrix multiplication threshold.
+// \ingroup config
+//
+// This threshold specifies when a sparse matrix/sparse matrix multiplication can be executed in
+// parallel. In case the number of rows (row-major result) or columns (column-major result) of
+// the resulting matrix is equal or higher than this value, the rows/columns are partitioned into
+// one block of approximately equal number of partial products per thread and both the symbolic
+// and the numeric phase of the multiplication are executed in parallel. If the number of rows/
+// columns is below this threshold the multiplication is executed single-threaded.
+//
+// The default setting for this threshold is 1000.
+*/
+const size_t SMP_SMATSMATMULT_THRESHOLD = 1000UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief SMP compressed matrix assembly threshold.
+// \ingroup config
+//
+// This threshold specifies when the assembly of a compressed matrix from triplets (see the
+// AssemblyPattern class) and the refill of its values are executed in parallel. In case the
+// number of triplets is equal or higher than this value, the counting, scattering, sorting and
+// merging of the triplets is executed in parallel. If the number of triplets is below this
+// threshold the assembly is executed single-threaded.
+//
+// The default setting for this threshold is 50000.
+*/
+const size_t SMP_ASSEMBLY_THRESHOLD = 50000UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief SMP projected Gauss-Seidel threshold.
+// \ingroup config
+//
+// This threshold specifies when the sweeps of the projected Gauss-Seidel solver (see the PGS
+// class) are executed in parallel. In case the number of unknowns of the complementarity problem
+// is equal or higher than this value, the contacts of a contact LCP are colored such that the
+// contacts of a single color are not coupled via the system matrix and all contacts of a color
+// are updated in parallel. Additionally, the sweeps of the Jacobi mode are executed in parallel.
+// If the number of unknowns is below this threshold, the sweeps are executed single-threaded
+// in the natural order of the unknowns.
+//
+// The default setting for this threshold is 3000.
+*/
+const size_t SMP_PGS_THRESHOLD = 3000UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief SMP batched solver threshold.
+// \ingroup config
+//
+// This threshold specifies when a batch of small problems (see the Batch class) is solved in
+// parallel. In case the total number of unknowns of all problems of the batch is equal or
+// higher than this value, the problems are distributed to the threads such that all threads
+// receive approximately the same amount of work. If the total number of unknowns is below this
+// threshold the problems are solved single-threaded.
+//
+// The default setting for this threshold is 1000.
+*/
+const size_t SMP_BATCH_THRESHOLD = 1000UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief SMP random initialization threshold.
+// \ingroup config
+//
+// This threshold specifies when the initialization of a DynamicVector, DynamicMatrix or
+// CompressedMatrix with random values (see the randomize() functions) is executed in parallel.
+// In case the number of values to be generated is equal or higher than this value, the values
+// are generated in parallel. Due to the counter-based random number generator, the resulting
+// values do not depend on the number of threads. If the number of values is below this
+// threshold the values are generated single-threaded.
+//
+// The default setting for this threshold is 50000.
+*/
+const size_t SMP_RANDOMIZE_THRESHOLD = 50000UL;
+//*************************************************************************************************
+
 } // namespace blaze
@@ -0,0 +1,829 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/AssemblyPattern.h
+//  \brief Header file for the triplet assembly of compressed matrices
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_ASSEMBLYPATTERN_H_
+#define _BLAZE_MATH_ASSEMBLYPATTERN_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/system/Thresholds.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Null.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Sparsity pattern for the repeated assembly of a compressed matrix from triplets.
+// \ingroup compressed_matrix
+//
+// The AssemblyPattern class enables the efficient construction of a CompressedMatrix from an
+// unordered list of (row,column,value) triplets, as for instance produced by the assembly of a
+// finite element or a contact problem. In contrast to the insertion via the function call
+// operator or the insert() function, the assembly does not require any particular order of the
+// triplets and duplicate triplets (i.e. several triplets for the same matrix element) are summed
+// up. The assembly is performed in four steps: the triplets are counted per row (or column in
+// case of a column-major matrix), the counts are converted to offsets via a prefix sum, the
+// triplets are scattered into their rows and finally each row is sorted and its duplicates are
+// merged. In case the number of triplets exceeds the SMP_ASSEMBLY_THRESHOLD, all steps except
+// the prefix sum are executed in parallel (see \ref smp). The result does not depend on the
+// number of threads, since the triplets of a matrix element are always summed up in the order
+// of the triplet list.
+//
+// The AssemblyPattern records the mapping of the triplets to the non-zero elements of the matrix.
+// In case a matrix has to be assembled repeatedly from triplets with identical indices but
+// different values (as for instance in every time step of a simulation), the values of the
+// matrix can be refilled in place without repeating the sorting of the triplets:
+
+   \code
+   using blaze::AssemblyPattern;
+   using blaze::CompressedMatrix;
+
+   std::vector<size_t> rows, columns;  // The row and column indices of the triplets
+   std::vector<double> values;         // The values of the triplets
+   // ... Initialization of the triplets
+
+   CompressedMatrix<double> A( m, n );
+   AssemblyPattern pattern;
+
+   assemble( A, rows.begin(), columns.begin(), values.begin(), values.size(), pattern );
+
+   for( ... ) {
+      // ... Recomputation of the triplet values
+      refill( A, values.begin(), pattern );  // Writes the summed values into the existing elements
+   }
+   \endcode
+
+// In case the pattern is not required, the matrix can be assembled directly via
+// \c assemble( A, rows.begin(), columns.begin(), values.begin(), values.size() ).
+*/
+class AssemblyPattern
+{
+ public:
+   //**Constructor*********************************************************************************
+   /*!\name Constructor */
+   //@{
+   explicit inline AssemblyPattern();
+   //@}
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   inline size_t rows()     const;
+   inline size_t columns()  const;
+   inline size_t triplets() const;
+   inline size_t nonZeros() const;
+   inline void   clear();
+   //@}
+   //**********************************************************************************************
+
+   //**Assembly functions**************************************************************************
+   /*!\name Assembly functions */
+   //@{
+   template< typename Type, bool SO, typename IT1, typename IT2, typename IT3 >
+   void assemble( CompressedMatrix<Type,SO>& A, IT1 rows, IT2 columns, IT3 values, size_t triplets );
+
+   template< typename Type, bool SO, typename IT >
+   void refill( CompressedMatrix<Type,SO>& A, IT values ) const;
+   //@}
+   //**********************************************************************************************
+
+ private:
+   //**Type definitions****************************************************************************
+   //! Sort key of a triplet, consisting of the inner (column/row) index and the triplet index.
+   typedef std::pair<size_t,size_t>  Key;
+   //**********************************************************************************************
+
+   //**Assembly kernels****************************************************************************
+   /*!\name Assembly kernels */
+   //@{
+   template< typename IT1, typename IT2 >
+   void build( size_t outer, size_t inner, IT1 outerIndex, IT2 innerIndex, size_t triplets );
+
+   template< typename Type, bool SO >
+   bool matches( const CompressedMatrix<Type,SO>& A ) const;
+
+   template< typename IT1, typename IT2 >
+   static void countKernel( IT1 outerIndex, IT2 innerIndex, size_t triplets, size_t parts,
+                            size_t outer, size_t inner, size_t* counts, size_t pbegin,
+                            size_t pend );
+
+   template< typename IT1, typename IT2 >
+   static void scatterKernel( IT1 outerIndex, IT2 innerIndex, size_t triplets, size_t parts,
+                              size_t outer, size_t* counts, Key* keys, size_t pbegin, size_t pend );
+
+   inline void sortKernel( Key* keys, size_t ibegin, size_t iend );
+   inline void slotKernel( const Key* keys, size_t ibegin, size_t iend );
+
+   template< typename Type, bool SO, typename IT >
+   void appendKernel( CompressedMatrix<Type,SO>& A, IT values, size_t ibegin, size_t iend ) const;
+
+   template< typename Type, bool SO, typename IT >
+   void refillKernel( CompressedMatrix<Type,SO>& A, IT values, size_t ibegin, size_t iend ) const;
+   //@}
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   /*!\name Member variables */
+   //@{
+   size_t m_;                        //!< The number of rows of the assembled matrix.
+   size_t n_;                        //!< The number of columns of the assembled matrix.
+   bool   storageOrder_;             //!< The storage order of the assembled matrix.
+   bool   parallel_;                 //!< Flag for the parallel execution of the assembly.
+   std::vector<size_t> offsets_;     //!< The offsets of the triplets of each row/column in \a order_.
+   std::vector<size_t> order_;       //!< The triplets ordered by rows/columns and inner indices.
+   std::vector<size_t> slotBegin_;   //!< The offsets of the non-zero elements of each row/column.
+   std::vector<size_t> slotIndex_;   //!< The inner index of each non-zero element.
+   std::vector<size_t> slotOffset_;  //!< The offset of the triplets of each non-zero element in \a order_.
+   //@}
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CONSTRUCTOR
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief The default constructor for AssemblyPattern.
+*/
+inline AssemblyPattern::AssemblyPattern()
+   : m_           ( 0UL )    // The number of rows of the assembled matrix
+   , n_           ( 0UL )    // The number of columns of the assembled matrix
+   , storageOrder_( false )  // The storage order of the assembled matrix
+   , parallel_    ( false )  // Flag for the parallel execution of the assembly
+   , offsets_     ()         // The offsets of the triplets of each row/column
+   , order_       ()         // The ordered triplets
+   , slotBegin_   ()         // The offsets of the non-zero elements of each row/column
+   , slotIndex_   ()         // The inner index of each non-zero element
+   , slotOffset_  ()         // The offset of the triplets of each non-zero element
+{}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the number of rows of the assembled matrix.
+//
+// \return The number of rows of the assembled matrix.
+*/
+inline size_t AssemblyPattern::rows() const
+{
+   return m_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the number of columns of the assembled matrix.
+//
+// \return The number of columns of the assembled matrix.
+*/
+inline size_t AssemblyPattern::columns() const
+{
+   return n_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the number of triplets of the pattern.
+//
+// \return The number of triplets.
+*/
+inline size_t AssemblyPattern::triplets() const
+{
+   return order_.size();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the number of non-zero elements of the assembled matrix.
+//
+// \return The number of non-zero elements.
+*/
+inline size_t AssemblyPattern::nonZeros() const
+{
+   return slotIndex_.size();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Clearing the assembly pattern.
+//
+// \return void
+*/
+inline void AssemblyPattern::clear()
+{
+   AssemblyPattern tmp;
+   std::swap( m_, tmp.m_ );
+   std::swap( n_, tmp.n_ );
+   std::swap( storageOrder_, tmp.storageOrder_ );
+   std::swap( parallel_, tmp.parallel_ );
+   offsets_.swap( tmp.offsets_ );
+   order_.swap( tmp.order_ );
+   slotBegin_.swap( tmp.slotBegin_ );
+   slotIndex_.swap( tmp.slotIndex_ );
+   slotOffset_.swap( tmp.slotOffset_ );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  ASSEMBLY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Assembly of a compressed matrix from the given triplets.
+//
+// \param A The target compressed matrix.
+// \param rows Random access iterator to the row indices of the triplets.
+// \param columns Random access iterator to the column indices of the triplets.
+// \param values Random access iterator to the values of the triplets.
+// \param triplets The total number of triplets.
+// \return void
+// \exception std::invalid_argument Invalid triplet index.
+//
+// This function replaces all elements of the given matrix by the sum of the given triplets and
+// records the according sparsity pattern for subsequent refill() calls. The size of the matrix
+// remains unchanged, i.e. all row indices have to be in the range \f$[0..M-1]\f$ and all column
+// indices in the range \f$[0..N-1]\f$. In case any index is out of range, a \a std::invalid_argument
+// exception is thrown, the matrix remains unchanged and the pattern is cleared. The capacity of
+// the resulting matrix matches exactly the number of non-zero elements.
+*/
+template< typename Type  // Data type of the sparse matrix
+        , bool SO        // Storage order of the sparse matrix
+        , typename IT1   // Type of the row index iterator
+        , typename IT2   // Type of the column index iterator
+        , typename IT3 > // Type of the value iterator
+void AssemblyPattern::assemble( CompressedMatrix<Type,SO>& A, IT1 rows, IT2 columns,
+                                IT3 values, size_t triplets )
+{
+   clear();
+
+   parallel_ = ( triplets >= SMP_ASSEMBLY_THRESHOLD );
+
+   if( SO )
+      build( A.columns(), A.rows(), columns, rows, triplets );
+   else
+      build( A.rows(), A.columns(), rows, columns, triplets );
+
+   m_            = A.rows();
+   n_            = A.columns();
+   storageOrder_ = SO;
+
+   const size_t outer( slotBegin_.size() - 1UL );
+
+   std::vector<size_t> nonzeros( outer );
+   for( size_t i=0UL; i<outer; ++i )
+      nonzeros[i] = slotBegin_[i+1UL] - slotBegin_[i];
+
+   CompressedMatrix<Type,SO> tmp( m_, n_, nonzeros );
+
+   if( parallel_ )
+      smpFor( outer, 64UL, boost::bind( &AssemblyPattern::appendKernel<Type,SO,IT3>, this,
+                                        boost::ref( tmp ), values, _1, _2 ) );
+   else
+      appendKernel( tmp, values, 0UL, outer );
+
+   A.swap( tmp );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Refilling the values of a compressed matrix from the given triplet values.
+//
+// \param A The compressed matrix to be refilled.
+// \param values Random access iterator to the new values of the triplets.
+// \return void
+// \exception std::invalid_argument Matrix does not match the assembly pattern.
+//
+// This function overwrites the values of all non-zero elements of the given matrix by the sum
+// of the according triplet values. The values have to be given in the order of the triplets of
+// the previous assemble() call, which determined the pattern. The sparsity pattern of the matrix
+// must not have been changed since then. In case the size, the storage order or the non-zero
+// elements of any row/column of the matrix do not match the pattern, a \a std::invalid_argument
+// exception is thrown and the matrix remains unchanged.
+*/
+template< typename Type  // Data type of the sparse matrix
+        , bool SO        // Storage order of the sparse matrix
+        , typename IT >  // Type of the value iterator
+void AssemblyPattern::refill( CompressedMatrix<Type,SO>& A, IT values ) const
+{
+   if( !matches( A ) )
+      throw std::invalid_argument( "Matrix does not match the assembly pattern" );
+
+   const size_t outer( slotBegin_.size() - 1UL );
+
+   if( parallel_ )
+      smpFor( outer, 64UL, boost::bind( &AssemblyPattern::refillKernel<Type,SO,IT>, this,
+                                        boost::ref( A ), values, _1, _2 ) );
+   else
+      refillKernel( A, values, 0UL, outer );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  ASSEMBLY KERNELS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Computation of the sparsity pattern of the given triplets.
+//
+// \param outer The number of rows (row-major) or columns (column-major) of the matrix.
+// \param inner The number of columns (row-major) or rows (column-major) of the matrix.
+// \param outerIndex Random access iterator to the outer indices of the triplets.
+// \param innerIndex Random access iterator to the inner indices of the triplets.
+// \param triplets The total number of triplets.
+// \return void
+// \exception std::invalid_argument Invalid triplet index.
+*/
+template< typename IT1    // Type of the outer index iterator
+        , typename IT2 >  // Type of the inner index iterator
+void AssemblyPattern::build( size_t outer, size_t inner, IT1 outerIndex, IT2 innerIndex,
+                             size_t triplets )
+{
+   const size_t parts( ( parallel_ )?( getNumThreads() ):( 1UL ) );
+
+   // Counting the triplets per row/column and part and the invalid triplets per part
+   std::vector<size_t> counts( parts*outer+parts, 0UL );
+   smpFor( parts, 1UL, boost::bind( &AssemblyPattern::countKernel<IT1,IT2>, outerIndex,
+                                    innerIndex, triplets, parts, outer, inner, &counts[0],
+                                    _1, _2 ) );
+
+   for( size_t p=0UL; p<parts; ++p ) {
+      if( counts[parts*outer+p] > 0UL )
+         throw std::invalid_argument( "Invalid triplet index" );
+   }
+
+   // Computing the offsets of the rows/columns and of the parts within the rows/columns
+   offsets_.resize( outer+1UL );
+
+   size_t sum( 0UL );
+   for( size_t i=0UL; i<outer; ++i ) {
+      offsets_[i] = sum;
+      for( size_t p=0UL; p<parts; ++p ) {
+         const size_t count( counts[p*outer+i] );
+         counts[p*outer+i] = sum;
+         sum += count;
+      }
+   }
+   offsets_[outer] = sum;
+
+   // Scattering the triplets into their rows/columns
+   std::vector<Key> keys( triplets );
+   Key* const key( ( triplets > 0UL )?( &keys[0] ):( NULL ) );
+   smpFor( parts, 1UL, boost::bind( &AssemblyPattern::scatterKernel<IT1,IT2>, outerIndex,
+                                    innerIndex, triplets, parts, outer, &counts[0], key,
+                                    _1, _2 ) );
+
+   // Sorting the rows/columns and counting the distinct inner indices
+   slotBegin_.resize( outer+1UL );
+   slotBegin_[0UL] = 0UL;
+
+   if( parallel_ )
+      smpFor( outer, 64UL, boost::bind( &AssemblyPattern::sortKernel, this, key, _1, _2 ) );
+   else
+      sortKernel( key, 0UL, outer );
+
+   for( size_t i=0UL; i<outer; ++i ) {
+      slotBegin_[i+1UL] += slotBegin_[i];
+   }
+
+   // Merging the duplicate triplets
+   order_.resize( triplets );
+   slotIndex_.resize( slotBegin_[outer] );
+   slotOffset_.resize( slotBegin_[outer]+1UL );
+   slotOffset_[slotBegin_[outer]] = triplets;
+
+   if( parallel_ )
+      smpFor( outer, 64UL, boost::bind( &AssemblyPattern::slotKernel, this, key, _1, _2 ) );
+   else
+      slotKernel( key, 0UL, outer );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Checks whether the given compressed matrix matches the assembly pattern.
+//
+// \param A The compressed matrix to be checked.
+// \return \a true in case the matrix matches the pattern, \a false if not.
+//
+// The matrix matches the pattern in case the size and the storage order of the matrix match the
+// pattern and in case every row/column contains exactly the non-zero elements of the pattern.
+*/
+template< typename Type  // Data type of the sparse matrix
+        , bool SO >      // Storage order of the sparse matrix
+bool AssemblyPattern::matches( const CompressedMatrix<Type,SO>& A ) const
+{
+   typedef typename CompressedMatrix<Type,SO>::ConstIterator  ConstIterator;
+
+   if( A.rows() != m_ || A.columns() != n_ || SO != storageOrder_ || A.nonZeros() != nonZeros() )
+      return false;
+
+   const size_t outer( slotBegin_.size() - 1UL );
+
+   for( size_t i=0UL; i<outer; ++i )
+   {
+      if( A.nonZeros( i ) != slotBegin_[i+1UL] - slotBegin_[i] )
+         return false;
+
+      ConstIterator element( A.begin( i ) );
+
+      for( size_t s=slotBegin_[i]; s<slotBegin_[i+1UL]; ++s, ++element ) {
+         if( element->index() != slotIndex_[s] )
+            return false;
+      }
+   }
+
+   return true;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Counting the triplets of the given parts per row/column.
+//
+// \param outerIndex Random access iterator to the outer indices of the triplets.
+// \param innerIndex Random access iterator to the inner indices of the triplets.
+// \param triplets The total number of triplets.
+// \param parts The total number of parts.
+// \param outer The number of rows/columns.
+// \param inner The number of columns/rows.
+// \param counts The counters of the parts, followed by the invalid triplet counter of each part.
+// \param pbegin The first part.
+// \param pend The end of the range of parts.
+// \return void
+//
+// Triplets with an out-of-range index are not counted per row/column but in the invalid triplet
+// counter of the part behind the counters of all parts, since the kernel is executed by the
+// threads of the global thread pool, which cannot propagate exceptions.
+*/
+template< typename IT1    // Type of the outer index iterator
+        , typename IT2 >  // Type of the inner index iterator
+void AssemblyPattern::countKernel( IT1 outerIndex, IT2 innerIndex, size_t triplets,
+                                   size_t parts, size_t outer, size_t inner, size_t* counts,
+                                   size_t pbegin, size_t pend )
+{
+   for( size_t p=pbegin; p<pend; ++p )
+   {
+      size_t* const count( counts + p*outer );
+      const size_t kend( ( ( p+1UL ) * triplets ) / parts );
+
+      for( size_t k=( p*triplets )/parts; k<kend; ++k )
+      {
+         const size_t i( static_cast<size_t>( outerIndex[k] ) );
+         const size_t j( static_cast<size_t>( innerIndex[k] ) );
+
+         if( i < outer && j < inner )
+            ++count[i];
+         else ++counts[parts*outer+p];
+      }
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Scattering the triplets of the given parts into their rows/columns.
+//
+// \param outerIndex Random access iterator to the outer indices of the triplets.
+// \param innerIndex Random access iterator to the inner indices of the triplets.
+// \param triplets The total number of triplets.
+// \param parts The total number of parts.
+// \param outer The number of rows/columns.
+// \param counts The offsets of the parts within the rows/columns.
+// \param keys The sort keys of the triplets, ordered by rows/columns.
+// \param pbegin The first part.
+// \param pend The end of the range of parts.
+// \return void
+//
+// Since the parts are ordered and each part scatters its triplets in ascending order, the
+// triplets of each row/column remain in the order of the triplet list.
+*/
+template< typename IT1    // Type of the outer index iterator
+        , typename IT2 >  // Type of the inner index iterator
+void AssemblyPattern::scatterKernel( IT1 outerIndex, IT2 innerIndex, size_t triplets,
+                                     size_t parts, size_t outer, size_t* counts, Key* keys,
+                                     size_t pbegin, size_t pend )
+{
+   for( size_t p=pbegin; p<pend; ++p )
+   {
+      size_t* const offset( counts + p*outer );
+      const size_t kend( ( ( p+1UL ) * triplets ) / parts );
+
+      for( size_t k=( p*triplets )/parts; k<kend; ++k ) {
+         keys[offset[outerIndex[k]]++] = Key( static_cast<size_t>( innerIndex[k] ), k );
+      }
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Sorting the triplets of the given rows/columns by their inner indices.
+//
+// \param keys The sort keys of the triplets, ordered by rows/columns.
+// \param ibegin The first row/column.
+// \param iend The end of the range of rows/columns.
+// \return void
+//
+// The keys are sorted by inner index and triplet index, i.e. the triplets of a matrix element
+// remain in the order of the triplet list. The number of distinct inner indices of row/column
+// \a i is stored in \a slotBegin_[i+1].
+*/
+inline void AssemblyPattern::sortKernel( Key* keys, size_t ibegin, size_t iend )
+{
+   for( size_t i=ibegin; i<iend; ++i )
+   {
+      Key* const first( keys+offsets_[i] );
+      Key* const last ( keys+offsets_[i+1UL] );
+
+      std::sort( first, last );
+
+      size_t slots( 0UL );
+      for( const Key* key=first; key!=last; ++key ) {
+         if( key == first || key->first != (key-1)->first )
+            ++slots;
+      }
+
+      slotBegin_[i+1UL] = slots;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computation of the non-zero elements of the given rows/columns.
+//
+// \param keys The sorted keys of the triplets.
+// \param ibegin The first row/column.
+// \param iend The end of the range of rows/columns.
+// \return void
+*/
+inline void AssemblyPattern::slotKernel( const Key* keys, size_t ibegin, size_t iend )
+{
+   for( size_t i=ibegin; i<iend; ++i )
+   {
+      size_t slot( slotBegin_[i] );
+
+      for( size_t k=offsets_[i]; k<offsets_[i+1UL]; ++k )
+      {
+         if( k == offsets_[i] || keys[k].first != keys[k-1UL].first ) {
+            slotIndex_ [slot] = keys[k].first;
+            slotOffset_[slot] = k;
+            ++slot;
+         }
+
+         order_[k] = keys[k].second;
+      }
+
+      BLAZE_INTERNAL_ASSERT( slot == slotBegin_[i+1UL], "Invalid number of non-zero elements" );
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Appending the summed triplets of the given rows/columns to a compressed matrix.
+//
+// \param A The target compressed matrix.
+// \param values Random access iterator to the values of the triplets.
+// \param ibegin The first row/column.
+// \param iend The end of the range of rows/columns.
+// \return void
+*/
+template< typename Type  // Data type of the sparse matrix
+        , bool SO        // Storage order of the sparse matrix
+        , typename IT >  // Type of the value iterator
+void AssemblyPattern::appendKernel( CompressedMatrix<Type,SO>& A, IT values,
+                                    size_t ibegin, size_t iend ) const
+{
+   for( size_t i=ibegin; i<iend; ++i )
+   {
+      for( size_t s=slotBegin_[i]; s<slotBegin_[i+1UL]; ++s )
+      {
+         Type tmp( values[order_[slotOffset_[s]]] );
+         for( size_t k=slotOffset_[s]+1UL; k<slotOffset_[s+1UL]; ++k )
+            tmp += values[order_[k]];
+
+         if( SO )
+            A.append( slotIndex_[s], i, tmp );
+         else
+            A.append( i, slotIndex_[s], tmp );
+      }
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Refilling the non-zero elements of the given rows/columns of a compressed matrix.
+//
+// \param A The compressed matrix to be refilled.
+// \param values Random access iterator to the values of the triplets.
+// \param ibegin The first row/column.
+// \param iend The end of the range of rows/columns.
+// \return void
+*/
+template< typename Type  // Data type of the sparse matrix
+        , bool SO        // Storage order of the sparse matrix
+        , typename IT >  // Type of the value iterator
+void AssemblyPattern::refillKernel( CompressedMatrix<Type,SO>& A, IT values,
+                                    size_t ibegin, size_t iend ) const
+{
+   typedef typename CompressedMatrix<Type,SO>::Iterator  Iterator;
+
+   for( size_t i=ibegin; i<iend; ++i )
+   {
+      BLAZE_INTERNAL_ASSERT( A.nonZeros( i ) == slotBegin_[i+1UL] - slotBegin_[i], "Invalid sparsity pattern" );
+
+      Iterator element( A.begin( i ) );
+
+      for( size_t s=slotBegin_[i]; s<slotBegin_[i+1UL]; ++s, ++element )
+      {
+         BLAZE_INTERNAL_ASSERT( element->index() == slotIndex_[s], "Invalid sparsity pattern" );
+
+         Type tmp( values[order_[slotOffset_[s]]] );
+         for( size_t k=slotOffset_[s]+1UL; k<slotOffset_[s+1UL]; ++k )
+            tmp += values[order_[k]];
+
+         element->value() = tmp;
+      }
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  GLOBAL FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\name AssemblyPattern functions */
+//@{
+template< typename Type, bool SO, typename IT1, typename IT2, typename IT3 >
+inline void assemble( CompressedMatrix<Type,SO>& A, IT1 rows, IT2 columns, IT3 values,
+                      size_t triplets );
+
+template< typename Type, bool SO, typename IT1, typename IT2, typename IT3 >
+inline void assemble( CompressedMatrix<Type,SO>& A, IT1 rows, IT2 columns, IT3 values,
+                      size_t triplets, AssemblyPattern& pattern );
+
+template< typename Type, bool SO, typename IT >
+inline void refill( CompressedMatrix<Type,SO>& A, IT values, const AssemblyPattern& pattern );
+//@}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Assembly of a compressed matrix from the given triplets.
+// \ingroup compressed_matrix
+//
+// \param A The target compressed matrix.
+// \param rows Random access iterator to the row indices of the triplets.
+// \param columns Random access iterator to the column indices of the triplets.
+// \param values Random access iterator to the values of the triplets.
+// \param triplets The total number of triplets.
+// \return void
+// \exception std::invalid_argument Invalid triplet index.
+//
+// This function replaces all elements of the given matrix by the sum of the given triplets
+// (see the AssemblyPattern class description for details).
+*/
+template< typename Type  // Data type of the sparse matrix
+        , bool SO        // Storage order of the sparse matrix
+        , typename IT1   // Type of the row index iterator
+        , typename IT2   // Type of the column index iterator
+        , typename IT3 > // Type of the value iterator
+inline void assemble( CompressedMatrix<Type,SO>& A, IT1 rows, IT2 columns, IT3 values,
+                      size_t triplets )
+{
+   AssemblyPattern pattern;
+   pattern.assemble( A, rows, columns, values, triplets );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Assembly of a compressed matrix from the given triplets.
+// \ingroup compressed_matrix
+//
+// \param A The target compressed matrix.
+// \param rows Random access iterator to the row indices of the triplets.
+// \param columns Random access iterator to the column indices of the triplets.
+// \param values Random access iterator to the values of the triplets.
+// \param triplets The total number of triplets.
+// \param pattern The resulting assembly pattern for subsequent refill() calls.
+// \return void
+// \exception std::invalid_argument Invalid triplet index.
+//
+// This function replaces all elements of the given matrix by the sum of the given triplets
+// and records the sparsity pattern in \a pattern (see the AssemblyPattern class description
+// for details).
+*/
+template< typename Type  // Data type of the sparse matrix
+        , bool SO        // Storage order of the sparse matrix
+        , typename IT1   // Type of the row index iterator
+        , typename IT2   // Type of the column index iterator
+        , typename IT3 > // Type of the value iterator
+inline void assemble( CompressedMatrix<Type,SO>& A, IT1 rows, IT2 columns, IT3 values,
+                      size_t triplets, AssemblyPattern& pattern )
+{
+   pattern.assemble( A, rows, columns, values, triplets );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Refilling the values of a compressed matrix from the given triplet values.
+// \ingroup compressed_matrix
+//
+// \param A The compressed matrix to be refilled.
+// \param values Random access iterator to the new values of the triplets.
+// \param pattern The assembly pattern of the matrix.
+// \return void
+// \exception std::invalid_argument Matrix does not match the assembly pattern.
+//
+// This function overwrites the values of all non-zero elements of the given matrix by the sum
+// of the according triplet values without changing the sparsity pattern of the matrix (see the
+// AssemblyPattern class description for details).
+*/
+template< typename Type  // Data type of the sparse matrix
+        , bool SO        // Storage order of the sparse matrix
+        , typename IT >  // Type of the value iterator
+inline void refill( CompressedMatrix<Type,SO>& A, IT values, const AssemblyPattern& pattern )
+{
+   pattern.refill( A, values );
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -0,0 +1,1360 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/CSRMatrix.h
+//  \brief Implementation of a MxN sparse matrix with structure-of-arrays (CSR) storage
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_CSRMATRIX_H_
+#define _BLAZE_MATH_CSRMATRIX_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <boost/type_traits/remove_reference.hpp>
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/shims/IsDefault.h>
+#include <blaze/math/shims/IsNaN.h>
+#include <blaze/math/sparse/SparseElement.h>
+#include <blaze/math/SparseMatrix.h>
+#include <blaze/math/Types.h>
+#include <blaze/math/typetraits/IsCSRMatrix.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/constraints/Const.h>
+#include <blaze/util/constraints/Pointer.h>
+#include <blaze/util/constraints/Reference.h>
+#include <blaze/util/constraints/Volatile.h>
+#include <blaze/util/Memory.h>
+#include <blaze/util/Null.h>
+#include <blaze/util/TrueType.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\defgroup csr_matrix CSRMatrix
+// \ingroup sparse_matrix
+*/
+/*!\brief Efficient implementation of a \f$ M \times N \f$ row-major sparse matrix with
+//        structure-of-arrays storage.
+// \ingroup csr_matrix
+//
+// The CSRMatrix class template is a row-major sparse matrix that stores its non-zero elements
+// in the classic compressed sparse row (CSR) format: In contrast to the CompressedMatrix class
+// template, which stores an array of index-value pairs, the CSRMatrix stores the values, the
+// column indices and the row offsets of the non-zero elements in three separate arrays:
+
+   \code
+   values : [ A(0,j0) A(0,j1) ... A(1,j0) ... ]  // The non-zero values, row by row
+   indices: [ j0      j1      ... j0      ... ]  // The according column indices (32-bit)
+   offsets: [ 0  nnz(row 0)  nnz(rows 0..1) ... ]  // The M+1 row offsets
+   \endcode
+
+// The separate value array enables the vectorized evaluation of sparse matrix/dense vector
+// multiplications (the column indices are used to gather the according vector elements) and
+// the 32-bit indices halve the index traffic of double precision matrices. The type of the
+// elements can be specified via the template parameter:
+
+   \code
+   template< typename Type >
+   class CSRMatrix;
+   \endcode
+
+//  - Type: specifies the type of the matrix elements. CSRMatrix can be used with any
+//          non-cv-qualified element type.
+//
+// A CSRMatrix can be created from any sparse matrix or sparse matrix expression, can be filled
+// row by row via the low-level append() and finalize() functions and can be used as operand
+// in all sparse matrix expressions. The results of these expressions are CompressedMatrix
+// instances:
+
+   \code
+   using blaze::CSRMatrix;
+   using blaze::CompressedMatrix;
+   using blaze::DynamicVector;
+
+   CompressedMatrix<double> A( 1000UL, 1000UL );
+   // ... Initialization of A
+
+   CSRMatrix<double> B( A );           // Conversion of the compressed matrix A
+   CSRMatrix<double> C( 3UL, 3UL, 4UL );  // Empty 3x3 matrix with capacity for 4 non-zeros
+
+   C.append( 0UL, 0UL, 1.0 ); C.finalize( 0UL );  // Filling the first row
+   C.append( 1UL, 2UL, 2.0 ); C.finalize( 1UL );  // Filling the second row
+   C.finalize( 2UL );                              // Finalizing the empty third row
+
+   DynamicVector<double> x( 1000UL, 1.0 ), y;
+   y = B * x;  // Vectorized sparse matrix/dense vector multiplication
+   \endcode
+
+// Since the CSR arrays match the storage of a compressed Eigen::SparseMatrix with row-major
+// storage order and \c int indices, a CSRMatrix can directly operate on the buffers of an Eigen
+// matrix and vice versa, without copying any element:
+
+   \code
+   Eigen::SparseMatrix<double,Eigen::RowMajor> E( m, n );
+   // ... Initialization of E
+   E.makeCompressed();
+
+   // Zero-copy import: the CSRMatrix refers to the buffers of E
+   blaze::CSRMatrix<double> A( E.rows(), E.cols(), E.outerIndexPtr(), E.innerIndexPtr(), E.valuePtr() );
+
+   // Zero-copy export: the Eigen matrix refers to the buffers of A
+   Eigen::MappedSparseMatrix<double,Eigen::RowMajor> F( A.rows(), A.columns(), A.nonZeros(),
+                                                         A.offsets(), A.indices(), A.values() );
+   \endcode
+
+// A CSRMatrix referring to external buffers does not take ownership of the buffers, i.e. the
+// buffers have to outlive the matrix. Modifications of the values and of the sparsity pattern
+// within the capacity of the buffers (via the begin() and end() iterators or the append() and
+// finalize() functions) are directly applied to the external buffers. All functions that
+// require a reallocation (as for instance reserve() or the assignment operators) copy the
+// matrix to internally managed memory before they are applied.
+*/
+template< typename Type >  // Data type of the sparse matrix
+class CSRMatrix : public SparseMatrix< CSRMatrix<Type>, false >
+{
+ public:
+   //**Type definitions****************************************************************************
+   typedef int  IndexType;  //!< Type of the column indices and the row offsets.
+   //**********************************************************************************************
+
+ private:
+   //**Private class SoAIterator*******************************************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Iterator over the non-zero elements of a row of a CSRMatrix.
+   //
+   // The SoAIterator class provides the index-value interface of sparse matrix elements (i.e.
+   // the value() and index() functions, which are accessed via the arrow operator) on top of
+   // the separate value and column index arrays of the CSRMatrix.
+   */
+   template< typename VT >  // Type of the accessed values
+   class SoAIterator
+   {
+    public:
+      typedef SparseElement<Type>        Element;           //!< Element type of the sparse matrix.
+      typedef std::forward_iterator_tag  IteratorCategory;  //!< The iterator category.
+      typedef Element                    ValueType;         //!< Type of the underlying elements.
+      typedef ValueType*                 PointerType;       //!< Pointer return type.
+      typedef ValueType&                 ReferenceType;     //!< Reference return type.
+      typedef ptrdiff_t                  DifferenceType;    //!< Difference between two iterators.
+
+      // STL iterator requirements
+      typedef IteratorCategory  iterator_category;  //!< The iterator category.
+      typedef ValueType         value_type;         //!< Type of the underlying elements.
+      typedef PointerType       pointer;            //!< Pointer return type.
+      typedef ReferenceType     reference;          //!< Reference return type.
+      typedef DifferenceType    difference_type;    //!< Difference between two iterators.
+
+      inline SoAIterator()
+         : value_( NULL )  // Pointer to the current value
+         , index_( NULL )  // Pointer to the current column index
+      {}
+
+      inline SoAIterator( VT* value, const IndexType* index )
+         : value_( value )  // Pointer to the current value
+         , index_( index )  // Pointer to the current column index
+      {}
+
+      template< typename Other >
+      inline SoAIterator( const SoAIterator<Other>& it )
+         : value_( it.value_ )  // Pointer to the current value
+         , index_( it.index_ )  // Pointer to the current column index
+      {}
+
+      inline SoAIterator& operator++() {
+         ++value_;
+         ++index_;
+         return *this;
+      }
+
+      inline const SoAIterator operator++( int ) {
+         const SoAIterator tmp( *this );
+         ++value_;
+         ++index_;
+         return tmp;
+      }
+
+      inline const Element operator*() const { return Element( *value_, *index_ ); }
+      inline const SoAIterator* operator->() const { return this; }
+
+      inline VT&    value() const { return *value_; }
+      inline size_t index() const { return static_cast<size_t>( *index_ ); }
+
+      template< typename Other >
+      inline bool operator==( const SoAIterator<Other>& rhs ) const { return index_ == rhs.index_; }
+
+      template< typename Other >
+      inline bool operator!=( const SoAIterator<Other>& rhs ) const { return index_ != rhs.index_; }
+
+      template< typename Other >
+      inline DifferenceType operator-( const SoAIterator<Other>& rhs ) const {
+         return index_ - rhs.index_;
+      }
+
+    private:
+      VT*              value_;  //!< Pointer to the current value.
+      const IndexType* index_;  //!< Pointer to the current column index.
+
+      template< typename Other > friend class SoAIterator;
+   };
+   /*! \endcond */
+   //**********************************************************************************************
+
+ public:
+   //**Type definitions****************************************************************************
+   typedef CSRMatrix<Type>               This;            //!< Type of this CSRMatrix instance.
+   typedef CompressedMatrix<Type,false>  ResultType;      //!< Result type for expression template evaluations.
+   typedef CompressedMatrix<Type,true>   OppositeType;    //!< Result type with opposite storage order for expression template evaluations.
+   typedef CompressedMatrix<Type,true>   TransposeType;   //!< Transpose type for expression template evaluations.
+   typedef Type                          ElementType;     //!< Type of the sparse matrix elements.
+   typedef const This&                   CompositeType;   //!< Data type for composite expression templates.
+   typedef const Type&                   ConstReference;  //!< Reference to a constant sparse matrix value.
+   typedef SoAIterator<Type>             Iterator;        //!< Iterator over non-constant elements.
+   typedef SoAIterator<const Type>       ConstIterator;   //!< Iterator over constant elements.
+   //**********************************************************************************************
+
+   //**Compilation flags***************************************************************************
+   //! Compilation flag for the detection of aliasing effects.
+   /*! This compilation switch indicates whether this type potentially causes compuation errors
+       due to aliasing effects. In case the type can cause aliasing effects, the \a canAlias
+       switch is set to \a true, otherwise it is set to \a false. */
+   enum { canAlias = 0 };
+   //**********************************************************************************************
+
+   //**Constructors********************************************************************************
+   /*!\name Constructors */
+   //@{
+                                    explicit inline CSRMatrix();
+                                    explicit inline CSRMatrix( size_t m, size_t n );
+                                    explicit inline CSRMatrix( size_t m, size_t n, size_t nonzeros );
+                                             inline CSRMatrix( size_t m, size_t n, IndexType* offsets,
+                                                               IndexType* indices, Type* values );
+                                             inline CSRMatrix( const CSRMatrix& sm );
+   template< typename MT, bool SO >          inline CSRMatrix( const SparseMatrix<MT,SO>& sm );
+   //@}
+   //**********************************************************************************************
+
+   //**Destructor**********************************************************************************
+   /*!\name Destructor */
+   //@{
+   inline ~CSRMatrix();
+   //@}
+   //**********************************************************************************************
+
+   //**Data access functions***********************************************************************
+   /*!\name Data access functions */
+   //@{
+   inline ConstReference   operator()( size_t i, size_t j ) const;
+   inline Iterator         begin( size_t i );
+   inline ConstIterator    begin( size_t i ) const;
+   inline Iterator         end  ( size_t i );
+   inline ConstIterator    end  ( size_t i ) const;
+   inline IndexType*       offsets();
+   inline const IndexType* offsets() const;
+   inline IndexType*       indices();
+   inline const IndexType* indices() const;
+   inline Type*            values();
+   inline const Type*      values() const;
+   //@}
+   //**********************************************************************************************
+
+   //**Assignment operators************************************************************************
+   /*!\name Assignment operators */
+   //@{
+                                    inline CSRMatrix& operator=( const CSRMatrix& rhs );
+   template< typename MT, bool SO > inline CSRMatrix& operator=( const SparseMatrix<MT,SO>& rhs );
+   //@}
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   inline size_t        rows() const;
+   inline size_t        columns() const;
+   inline size_t        capacity() const;
+   inline size_t        nonZeros() const;
+   inline size_t        nonZeros( size_t i ) const;
+   inline void          reset();
+   inline void          clear();
+   inline ConstIterator find   ( size_t i, size_t j ) const;
+          void          reserve( size_t nonzeros );
+   inline void          swap( CSRMatrix& sm ) /* throw() */;
+   //@}
+   //**********************************************************************************************
+
+   //**Low-level utility functions*****************************************************************
+   /*!\name Low-level utility functions */
+   //@{
+   inline void append  ( size_t i, size_t j, const Type& value );
+   inline void finalize( size_t i );
+   //@}
+   //**********************************************************************************************
+
+   //**Expression template evaluation functions****************************************************
+   /*!\name Expression template evaluation functions */
+   //@{
+   template< typename Other > inline bool isAliased( const Other* alias ) const;
+   template< typename MT >    inline void assign   ( const SparseMatrix<MT,false>& rhs );
+   template< typename MT >    inline void assign   ( const SparseMatrix<MT,true>&  rhs );
+   //@}
+   //**********************************************************************************************
+
+ private:
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   static inline void checkIndexRange( size_t size );
+   //@}
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   /*!\name Member variables */
+   //@{
+   size_t     m_;         //!< The current number of rows of the sparse matrix.
+   size_t     n_;         //!< The current number of columns of the sparse matrix.
+   size_t     capacity_;  //!< The maximum number of non-zero elements of the sparse matrix.
+   IndexType* offsets_;   //!< The M+1 offsets of the rows within the index and value arrays.
+   IndexType* indices_;   //!< The column indices of the non-zero elements.
+   Type*      values_;    //!< The values of the non-zero elements.
+   bool       owner_;     //!< Flag for internally managed memory.
+
+   static const Type zero_;  //!< Neutral element for accesses to zero elements.
+   //@}
+   //**********************************************************************************************
+
+   //**Compile time checks*************************************************************************
+   /*! \cond BLAZE_INTERNAL */
+   BLAZE_CONSTRAINT_MUST_NOT_BE_POINTER_TYPE  ( Type );
+   BLAZE_CONSTRAINT_MUST_NOT_BE_REFERENCE_TYPE( Type );
+   BLAZE_CONSTRAINT_MUST_NOT_BE_CONST         ( Type );
+   BLAZE_CONSTRAINT_MUST_NOT_BE_VOLATILE      ( Type );
+   /*! \endcond */
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  DEFINITION AND INITIALIZATION OF THE STATIC MEMBER VARIABLES
+//
+//=================================================================================================
+
+template< typename Type >
+const Type CSRMatrix<Type>::zero_ = Type();
+
+
+
+
+//=================================================================================================
+//
+//  CONSTRUCTORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief The default constructor for CSRMatrix.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline CSRMatrix<Type>::CSRMatrix()
+   : m_       ( 0UL )                          // The current number of rows of the sparse matrix
+   , n_       ( 0UL )                          // The current number of columns of the sparse matrix
+   , capacity_( 0UL )                          // The maximum number of non-zero elements
+   , offsets_ ( allocate<IndexType>( 1UL ) )  // The offsets of the rows
+   , indices_ ( NULL )                         // The column indices of the non-zero elements
+   , values_  ( NULL )                         // The values of the non-zero elements
+   , owner_   ( true )                         // Flag for internally managed memory
+{
+   offsets_[0UL] = 0;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Constructor for a matrix of size \f$ M \times N \f$.
+//
+// \param m The number of rows of the matrix.
+// \param n The number of columns of the matrix.
+// \exception std::invalid_argument Invalid number of columns.
+//
+// The matrix is initialized to the zero matrix and has no free capacity. In case the number
+// of columns exceeds the range of the 32-bit column indices, a \a std::invalid_argument
+// exception is thrown.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline CSRMatrix<Type>::CSRMatrix( size_t m, size_t n )
+   : m_       ( m )                                 // The current number of rows of the sparse matrix
+   , n_       ( n )                                 // The current number of columns of the sparse matrix
+   , capacity_( 0UL )                               // The maximum number of non-zero elements
+   , offsets_ ( allocate<IndexType>( m+1UL ) )     // The offsets of the rows
+   , indices_ ( NULL )                              // The column indices of the non-zero elements
+   , values_  ( NULL )                              // The values of the non-zero elements
+   , owner_   ( true )                              // Flag for internally managed memory
+{
+   checkIndexRange( n );
+   std::fill( offsets_, offsets_+m_+1UL, IndexType( 0 ) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Constructor for a matrix of size \f$ M \times N \f$ with capacity for \a nonzeros elements.
+//
+// \param m The number of rows of the matrix.
+// \param n The number of columns of the matrix.
+// \param nonzeros The maximum number of non-zero elements of the sparse matrix.
+// \exception std::invalid_argument Invalid number of columns.
+// \exception std::invalid_argument Invalid number of non-zero elements.
+//
+// The matrix is initialized to the zero matrix. In case the number of columns or the number of
+// non-zero elements exceeds the range of the 32-bit indices, a \a std::invalid_argument exception
+// is thrown.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline CSRMatrix<Type>::CSRMatrix( size_t m, size_t n, size_t nonzeros )
+   : m_       ( m )                                 // The current number of rows of the sparse matrix
+   , n_       ( n )                                 // The current number of columns of the sparse matrix
+   , capacity_( nonzeros )                          // The maximum number of non-zero elements
+   , offsets_ ( allocate<IndexType>( m+1UL ) )     // The offsets of the rows
+   , indices_ ( allocate<IndexType>( nonzeros ) )  // The column indices of the non-zero elements
+   , values_  ( allocate<Type>( nonzeros ) )       // The values of the non-zero elements
+   , owner_   ( true )                              // Flag for internally managed memory
+{
+   checkIndexRange( n );
+   checkIndexRange( nonzeros );
+   std::fill( offsets_, offsets_+m_+1UL, IndexType( 0 ) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Constructor for a \f$ M \times N \f$ matrix referring to external CSR buffers.
+//
+// \param m The number of rows of the matrix.
+// \param n The number of columns of the matrix.
+// \param offsets The array of the \a m+1 row offsets.
+// \param indices The array of the column indices.
+// \param values The array of the values.
+//
+// This constructor creates a CSRMatrix that directly operates on the given external buffers
+// (as for instance the buffers of a compressed Eigen::SparseMatrix with row-major storage order)
+// without copying any element. The matrix does not take ownership of the buffers, i.e. the
+// buffers have to outlive the matrix. The column indices of each row are required to be
+// strictly increasing, the capacity of the matrix is given by \a offsets[m].
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline CSRMatrix<Type>::CSRMatrix( size_t m, size_t n, IndexType* offsets,
+                                   IndexType* indices, Type* values )
+   : m_       ( m )          // The current number of rows of the sparse matrix
+   , n_       ( n )          // The current number of columns of the sparse matrix
+   , capacity_( offsets[m] )  // The maximum number of non-zero elements
+   , offsets_ ( offsets )    // The offsets of the rows
+   , indices_ ( indices )    // The column indices of the non-zero elements
+   , values_  ( values )     // The values of the non-zero elements
+   , owner_   ( false )      // Flag for internally managed memory
+{
+   BLAZE_USER_ASSERT( offsets[0UL] == 0, "Invalid row offsets" );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief The copy constructor for CSRMatrix.
+//
+// \param sm Sparse matrix to be copied.
+//
+// The copy always resides in internally managed memory, even in case the given matrix refers
+// to external buffers.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline CSRMatrix<Type>::CSRMatrix( const CSRMatrix& sm )
+   : m_       ( sm.m_ )                                // The current number of rows of the sparse matrix
+   , n_       ( sm.n_ )                                // The current number of columns of the sparse matrix
+   , capacity_( sm.nonZeros() )                        // The maximum number of non-zero elements
+   , offsets_ ( allocate<IndexType>( m_+1UL ) )       // The offsets of the rows
+   , indices_ ( allocate<IndexType>( capacity_ ) )    // The column indices of the non-zero elements
+   , values_  ( allocate<Type>( capacity_ ) )         // The values of the non-zero elements
+   , owner_   ( true )                                 // Flag for internally managed memory
+{
+   std::copy( sm.offsets_, sm.offsets_+m_+1UL, offsets_ );
+   std::copy( sm.indices_, sm.indices_+capacity_, indices_ );
+   std::copy( sm.values_ , sm.values_ +capacity_, values_  );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Conversion constructor from different sparse matrices.
+//
+// \param sm Sparse matrix to be copied.
+// \exception std::invalid_argument Invalid number of columns.
+// \exception std::invalid_argument Invalid number of non-zero elements.
+//
+// This constructor converts the given row-major or column-major sparse matrix or sparse matrix
+// expression to CSR storage. In case the number of columns or the number of non-zero elements
+// exceeds the range of the 32-bit indices, a \a std::invalid_argument exception is thrown.
+*/
+template< typename Type >  // Data type of the sparse matrix
+template< typename MT      // Type of the foreign sparse matrix
+        , bool SO >        // Storage order of the foreign sparse matrix
+inline CSRMatrix<Type>::CSRMatrix( const SparseMatrix<MT,SO>& sm )
+   : m_       ( (~sm).rows() )                    // The current number of rows of the sparse matrix
+   , n_       ( (~sm).columns() )                 // The current number of columns of the sparse matrix
+   , capacity_( 0UL )                             // The maximum number of non-zero elements
+   , offsets_ ( allocate<IndexType>( m_+1UL ) )  // The offsets of the rows
+   , indices_ ( NULL )                            // The column indices of the non-zero elements
+   , values_  ( NULL )                            // The values of the non-zero elements
+   , owner_   ( true )                            // Flag for internally managed memory
+{
+   checkIndexRange( n_ );
+   std::fill( offsets_, offsets_+m_+1UL, IndexType( 0 ) );
+   assign( ~sm );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  DESTRUCTOR
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief The destructor for CSRMatrix.
+//
+// External buffers (see the according constructor) are not released.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline CSRMatrix<Type>::~CSRMatrix()
+{
+   if( owner_ ) {
+      deallocate( offsets_ );
+      deallocate( indices_ );
+      deallocate( values_  );
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  DATA ACCESS FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief 2D-access to the sparse matrix elements.
+//
+// \param i Access index for the row. The index has to be in the range \f$[0..M-1]\f$.
+// \param j Access index for the column. The index has to be in the range \f$[0..N-1]\f$.
+// \return Reference to the accessed value.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline typename CSRMatrix<Type>::ConstReference
+   CSRMatrix<Type>::operator()( size_t i, size_t j ) const
+{
+   BLAZE_USER_ASSERT( i < m_, "Invalid row access index"    );
+   BLAZE_USER_ASSERT( j < n_, "Invalid column access index" );
+
+   const ConstIterator pos( find( i, j ) );
+
+   if( pos == end( i ) )
+      return zero_;
+   else
+      return pos->value();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns an iterator to the first non-zero element of row \a i.
+//
+// \param i The row index.
+// \return Iterator to the first non-zero element of row \a i.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline typename CSRMatrix<Type>::Iterator CSRMatrix<Type>::begin( size_t i )
+{
+   BLAZE_USER_ASSERT( i < m_, "Invalid sparse matrix row access index" );
+   return Iterator( values_+offsets_[i], indices_+offsets_[i] );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns an iterator to the first non-zero element of row \a i.
+//
+// \param i The row index.
+// \return Iterator to the first non-zero element of row \a i.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline typename CSRMatrix<Type>::ConstIterator CSRMatrix<Type>::begin( size_t i ) const
+{
+   BLAZE_USER_ASSERT( i < m_, "Invalid sparse matrix row access index" );
+   return ConstIterator( values_+offsets_[i], indices_+offsets_[i] );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns an iterator just past the last non-zero element of row \a i.
+//
+// \param i The row index.
+// \return Iterator just past the last non-zero element of row \a i.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline typename CSRMatrix<Type>::Iterator CSRMatrix<Type>::end( size_t i )
+{
+   BLAZE_USER_ASSERT( i < m_, "Invalid sparse matrix row access index" );
+   return Iterator( values_+offsets_[i+1UL], indices_+offsets_[i+1UL] );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns an iterator just past the last non-zero element of row \a i.
+//
+// \param i The row index.
+// \return Iterator just past the last non-zero element of row \a i.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline typename CSRMatrix<Type>::ConstIterator CSRMatrix<Type>::end( size_t i ) const
+{
+   BLAZE_USER_ASSERT( i < m_, "Invalid sparse matrix row access index" );
+   return ConstIterator( values_+offsets_[i+1UL], indices_+offsets_[i+1UL] );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Low-level data access to the \a M+1 row offsets.
+//
+// \return Pointer to the row offsets.
+//
+// The non-zero elements of row \a i are stored at the positions \f$ [offsets[i]..offsets[i+1]) \f$
+// of the index and value arrays.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline typename CSRMatrix<Type>::IndexType* CSRMatrix<Type>::offsets()
+{
+   return offsets_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Low-level data access to the \a M+1 row offsets.
+//
+// \return Pointer to the row offsets.
+//
+// The non-zero elements of row \a i are stored at the positions \f$ [offsets[i]..offsets[i+1]) \f$
+// of the index and value arrays.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline const typename CSRMatrix<Type>::IndexType* CSRMatrix<Type>::offsets() const
+{
+   return offsets_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Low-level data access to the column indices of the non-zero elements.
+//
+// \return Pointer to the column indices.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline typename CSRMatrix<Type>::IndexType* CSRMatrix<Type>::indices()
+{
+   return indices_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Low-level data access to the column indices of the non-zero elements.
+//
+// \return Pointer to the column indices.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline const typename CSRMatrix<Type>::IndexType* CSRMatrix<Type>::indices() const
+{
+   return indices_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Low-level data access to the values of the non-zero elements.
+//
+// \return Pointer to the values.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline Type* CSRMatrix<Type>::values()
+{
+   return values_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Low-level data access to the values of the non-zero elements.
+//
+// \return Pointer to the values.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline const Type* CSRMatrix<Type>::values() const
+{
+   return values_;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  ASSIGNMENT OPERATORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Copy assignment operator for CSRMatrix.
+//
+// \param rhs Sparse matrix to be copied.
+// \return Reference to the assigned sparse matrix.
+//
+// The sparse matrix is resized according to the given \f$ M \times N \f$ matrix and initialized
+// as a copy of this matrix. The result always resides in internally managed memory.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline CSRMatrix<Type>& CSRMatrix<Type>::operator=( const CSRMatrix& rhs )
+{
+   if( &rhs == this ) return *this;
+
+   CSRMatrix tmp( rhs );
+   swap( tmp );
+
+   return *this;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Assignment operator for different sparse matrices.
+//
+// \param rhs Sparse matrix to be copied.
+// \return Reference to the assigned sparse matrix.
+//
+// The sparse matrix is resized according to the given \f$ M \times N \f$ matrix and initialized
+// as a copy of this matrix. The result always resides in internally managed memory.
+*/
+template< typename Type >  // Data type of the sparse matrix
+template< typename MT      // Type of the right-hand side sparse matrix
+        , bool SO >        // Storage order of the right-hand side sparse matrix
+inline CSRMatrix<Type>& CSRMatrix<Type>::operator=( const SparseMatrix<MT,SO>& rhs )
+{
+   CSRMatrix tmp( ~rhs );
+   swap( tmp );
+
+   return *this;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the current number of rows of the sparse matrix.
+//
+// \return The number of rows of the sparse matrix.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline size_t CSRMatrix<Type>::rows() const
+{
+   return m_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the current number of columns of the sparse matrix.
+//
+// \return The number of columns of the sparse matrix.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline size_t CSRMatrix<Type>::columns() const
+{
+   return n_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the maximum capacity of the sparse matrix.
+//
+// \return The capacity of the sparse matrix.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline size_t CSRMatrix<Type>::capacity() const
+{
+   return capacity_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the number of non-zero elements in the sparse matrix
+//
+// \return The number of non-zero elements in the sparse matrix.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline size_t CSRMatrix<Type>::nonZeros() const
+{
+   return static_cast<size_t>( offsets_[m_] );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the number of non-zero elements in the specified row.
+//
+// \param i The index of the row.
+// \return The number of non-zero elements of row \a i.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline size_t CSRMatrix<Type>::nonZeros( size_t i ) const
+{
+   BLAZE_USER_ASSERT( i < m_, "Invalid row access index" );
+   return static_cast<size_t>( offsets_[i+1UL] - offsets_[i] );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Reset to the default initial values.
+//
+// \return void
+//
+// This function removes all non-zero elements from the sparse matrix. In case the matrix refers
+// to external buffers, the matrix is reset to an empty matrix in internally managed memory and
+// the external buffers remain unchanged.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline void CSRMatrix<Type>::reset()
+{
+   if( owner_ ) {
+      std::fill( offsets_, offsets_+m_+1UL, IndexType( 0 ) );
+   }
+   else {
+      CSRMatrix tmp( m_, n_ );
+      swap( tmp );
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Clearing the sparse matrix.
+//
+// \return void
+//
+// After the clear() function, the size of the sparse matrix is 0.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline void CSRMatrix<Type>::clear()
+{
+   CSRMatrix tmp;
+   swap( tmp );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Searches for a specific matrix element.
+//
+// \param i The row index of the search element. The index has to be in the range \f$[0..M-1]\f$.
+// \param j The column index of the search element. The index has to be in the range \f$[0..N-1]\f$.
+// \return Iterator to the element in case the index is found, end() iterator otherwise.
+//
+// The element is determined by a binary search within the column indices of row \a i.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline typename CSRMatrix<Type>::ConstIterator
+   CSRMatrix<Type>::find( size_t i, size_t j ) const
+{
+   BLAZE_USER_ASSERT( i < m_, "Invalid row access index"    );
+   BLAZE_USER_ASSERT( j < n_, "Invalid column access index" );
+
+   const IndexType* const first( indices_+offsets_[i] );
+   const IndexType* const last ( indices_+offsets_[i+1UL] );
+   const IndexType* const pos  ( std::lower_bound( first, last, static_cast<IndexType>( j ) ) );
+
+   if( pos != last && static_cast<size_t>( *pos ) == j )
+      return ConstIterator( values_+( pos-indices_ ), pos );
+   else
+      return end( i );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Setting the minimum capacity of the sparse matrix.
+//
+// \param nonzeros The new minimum capacity of the sparse matrix.
+// \return void
+// \exception std::invalid_argument Invalid number of non-zero elements.
+//
+// This function increases the capacity of the sparse matrix to at least \a nonzeros elements.
+// The current values of the matrix elements are preserved. In case the matrix refers to external
+// buffers, the matrix is copied to internally managed memory. In case the number of non-zero
+// elements exceeds the range of the 32-bit indices, a \a std::invalid_argument exception is
+// thrown.
+*/
+template< typename Type >  // Data type of the sparse matrix
+void CSRMatrix<Type>::reserve( size_t nonzeros )
+{
+   if( owner_ && nonzeros <= capacity_ ) return;
+
+   checkIndexRange( nonzeros );
+
+   const size_t newCapacity( std::max( nonzeros, capacity_ ) );
+   const size_t used( nonZeros() );
+
+   IndexType* const newOffsets( allocate<IndexType>( m_+1UL ) );
+   IndexType* const newIndices( allocate<IndexType>( newCapacity ) );
+   Type*      const newValues ( allocate<Type>( newCapacity ) );
+
+   std::copy( offsets_, offsets_+m_+1UL, newOffsets );
+   std::copy( indices_, indices_+used, newIndices );
+   std::copy( values_ , values_ +used, newValues  );
+
+   if( owner_ ) {
+      deallocate( offsets_ );
+      deallocate( indices_ );
+      deallocate( values_  );
+   }
+
+   capacity_ = newCapacity;
+   offsets_  = newOffsets;
+   indices_  = newIndices;
+   values_   = newValues;
+   owner_    = true;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Swapping the contents of two sparse matrices.
+//
+// \param sm The sparse matrix to be swapped.
+// \return void
+// \exception no-throw guarantee.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline void CSRMatrix<Type>::swap( CSRMatrix& sm ) /* throw() */
+{
+   std::swap( m_, sm.m_ );
+   std::swap( n_, sm.n_ );
+   std::swap( capacity_, sm.capacity_ );
+   std::swap( offsets_, sm.offsets_ );
+   std::swap( indices_, sm.indices_ );
+   std::swap( values_ , sm.values_  );
+   std::swap( owner_  , sm.owner_   );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Checks whether the given size can be represented by the 32-bit indices.
+//
+// \param size The size to be checked.
+// \return void
+// \exception std::invalid_argument Invalid size for 32-bit indices.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline void CSRMatrix<Type>::checkIndexRange( size_t size )
+{
+   if( size > static_cast<size_t>( std::numeric_limits<IndexType>::max() ) )
+      throw std::invalid_argument( "Invalid size for 32-bit indices" );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  LOW-LEVEL UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Appending an element to the specified row of the sparse matrix.
+//
+// \param i The row index of the new element. The index has to be in the range \f$[0..M-1]\f$.
+// \param j The column index of the new element. The index has to be in the range \f$[0..N-1]\f$.
+// \param value The value of the element to be appended.
+// \return void
+//
+// This function provides a very efficient way to fill a sparse matrix with elements. It appends
+// a new element to the end of the specified row without any additional parameter verification
+// or memory allocation. Therefore it is strictly necessary to keep the following preconditions
+// in mind:
+//
+//  - the rows have to be filled in ascending order and each row has to be completed via the
+//    finalize() function before elements are appended to the next row
+//  - the index of the new element must be strictly larger than the largest index of non-zero
+//    elements in the specified row of the sparse matrix
+//  - the current number of non-zero elements must be smaller than the capacity of the matrix.
+//
+// Ignoring these preconditions might result in undefined behavior!
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline void CSRMatrix<Type>::append( size_t i, size_t j, const Type& value )
+{
+   BLAZE_USER_ASSERT( i < m_, "Invalid row access index"    );
+   BLAZE_USER_ASSERT( j < n_, "Invalid column access index" );
+   BLAZE_USER_ASSERT( static_cast<size_t>( offsets_[i+1UL] ) < capacity_, "Not enough reserved space left" );
+   BLAZE_USER_ASSERT( offsets_[i] == offsets_[i+1UL] || static_cast<IndexType>( j ) > indices_[offsets_[i+1UL]-1], "Index is not strictly increasing" );
+
+   const IndexType pos( offsets_[i+1UL]++ );
+   indices_[pos] = static_cast<IndexType>( j );
+   values_ [pos] = value;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Finalizing the element insertion of a row.
+//
+// \param i The index of the row to be finalized \f$[0..M-1]\f$.
+// \return void
+//
+// This function is part of the low-level interface to efficiently fill the matrix with elements.
+// After completion of row \a i via the append() function, this function has to be called to
+// finalize row \a i and prepare the next row for the insertion process via append().
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline void CSRMatrix<Type>::finalize( size_t i )
+{
+   BLAZE_USER_ASSERT( i < m_, "Invalid row access index" );
+
+   if( i != m_-1UL )
+      offsets_[i+2UL] = offsets_[i+1UL];
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  EXPRESSION TEMPLATE EVALUATION FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns whether the matrix is aliased with the given address \a alias.
+//
+// \param alias The alias to be checked.
+// \return \a true in case the alias corresponds to this matrix, \a false if not.
+*/
+template< typename Type >   // Data type of the sparse matrix
+template< typename Other >  // Data type of the foreign expression
+inline bool CSRMatrix<Type>::isAliased( const Other* alias ) const
+{
+   return static_cast<const void*>( this ) == static_cast<const void*>( alias );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Default implementation of the assignment of a row-major sparse matrix.
+//
+// \param rhs The right-hand side sparse matrix to be assigned.
+// \return void
+//
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates. Calling this function explicitly might result
+// in erroneous results and/or in compilation errors. Instead of using this function use the
+// assignment operator.
+*/
+template< typename Type >  // Data type of the sparse matrix
+template< typename MT >    // Type of the right-hand side sparse matrix
+inline void CSRMatrix<Type>::assign( const SparseMatrix<MT,false>& rhs )
+{
+   typedef typename MT::CompositeType                                  CT;
+   typedef typename boost::remove_reference<CT>::type::ConstIterator  RhsConstIterator;
+
+   BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+
+   CT A( ~rhs );  // Evaluation of the right-hand side sparse matrix
+
+   std::fill( offsets_, offsets_+m_+1UL, IndexType( 0 ) );
+   reserve( A.nonZeros() );
+
+   size_t k( 0UL );
+
+   for( size_t i=0UL; i<m_; ++i ) {
+      for( RhsConstIterator element=A.begin(i); element!=A.end(i); ++element, ++k ) {
+         indices_[k] = static_cast<IndexType>( element->index() );
+         values_ [k] = element->value();
+      }
+      offsets_[i+1UL] = static_cast<IndexType>( k );
+   }
+
+   BLAZE_INTERNAL_ASSERT( k <= capacity_, "Invalid number of non-zero elements" );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Default implementation of the assignment of a column-major sparse matrix.
+//
+// \param rhs The right-hand side sparse matrix to be assigned.
+// \return void
+//
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates. Calling this function explicitly might result
+// in erroneous results and/or in compilation errors. Instead of using this function use the
+// assignment operator.
+*/
+template< typename Type >  // Data type of the sparse matrix
+template< typename MT >    // Type of the right-hand side sparse matrix
+inline void CSRMatrix<Type>::assign( const SparseMatrix<MT,true>& rhs )
+{
+   typedef typename MT::CompositeType                                  CT;
+   typedef typename boost::remove_reference<CT>::type::ConstIterator  RhsConstIterator;
+
+   BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+
+   CT A( ~rhs );  // Evaluation of the right-hand side sparse matrix
+
+   std::fill( offsets_, offsets_+m_+1UL, IndexType( 0 ) );
+   reserve( A.nonZeros() );
+
+   // Counting the number of non-zero elements per row
+   for( size_t j=0UL; j<n_; ++j ) {
+      for( RhsConstIterator element=A.begin(j); element!=A.end(j); ++element )
+         ++offsets_[element->index()+1UL];
+   }
+
+   for( size_t i=0UL; i<m_; ++i ) {
+      offsets_[i+1UL] += offsets_[i];
+   }
+
+   // Scattering the non-zero elements into the rows in ascending column order
+   std::vector<IndexType> pos( offsets_, offsets_+m_ );
+
+   for( size_t j=0UL; j<n_; ++j ) {
+      for( RhsConstIterator element=A.begin(j); element!=A.end(j); ++element ) {
+         const IndexType k( pos[element->index()]++ );
+         indices_[k] = static_cast<IndexType>( j );
+         values_ [k] = element->value();
+      }
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  GLOBAL OPERATORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\name CSRMatrix operators */
+//@{
+template< typename Type >
+inline bool isnan( const CSRMatrix<Type>& m );
+
+template< typename Type >
+inline void reset( CSRMatrix<Type>& m );
+
+template< typename Type >
+inline void clear( CSRMatrix<Type>& m );
+
+template< typename Type >
+inline bool isDefault( const CSRMatrix<Type>& m );
+
+template< typename Type >
+inline void swap( CSRMatrix<Type>& a, CSRMatrix<Type>& b ) /* throw() */;
+//@}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Checks the given sparse matrix for not-a-number elements.
+// \ingroup csr_matrix
+//
+// \param m The sparse matrix to be checked for not-a-number elements.
+// \return \a true if at least one element of the sparse matrix is not-a-number, \a false otherwise.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline bool isnan( const CSRMatrix<Type>& m )
+{
+   const Type* const values( m.values() );
+
+   for( size_t k=0UL; k<m.nonZeros(); ++k )
+      if( isnan( values[k] ) ) return true;
+   return false;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Resetting the given sparse matrix.
+// \ingroup csr_matrix
+//
+// \param m The sparse matrix to be resetted.
+// \return void
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline void reset( CSRMatrix<Type>& m )
+{
+   m.reset();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Clearing the given sparse matrix.
+// \ingroup csr_matrix
+//
+// \param m The sparse matrix to be cleared.
+// \return void
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline void clear( CSRMatrix<Type>& m )
+{
+   m.clear();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns whether the given sparse matrix is in default state.
+// \ingroup csr_matrix
+//
+// \param m The sparse matrix to be tested for its default state.
+// \return \a true in case the given matrix is component-wise zero, \a false otherwise.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline bool isDefault( const CSRMatrix<Type>& m )
+{
+   const Type* const values( m.values() );
+
+   for( size_t k=0UL; k<m.nonZeros(); ++k )
+      if( !isDefault( values[k] ) ) return false;
+   return true;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Swapping the contents of two sparse matrices.
+// \ingroup csr_matrix
+//
+// \param a The first sparse matrix to be swapped.
+// \param b The second sparse matrix to be swapped.
+// \return void
+// \exception no-throw guarantee.
+*/
+template< typename Type >  // Data type of the sparse matrix
+inline void swap( CSRMatrix<Type>& a, CSRMatrix<Type>& b ) /* throw() */
+{
+   a.swap( b );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  ISCSRMATRIX SPECIALIZATIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+template< typename T >
+struct IsCSRMatrix< CSRMatrix<T> > : public TrueType
+{
+   enum { value = 1 };
+   typedef TrueType  Type;
+};
+
+template< typename T >
+struct IsCSRMatrix< const CSRMatrix<T> > : public TrueType
+{
+   enum { value = 1 };
+   typedef TrueType  Type;
+};
+
+template< typename T >
+struct IsCSRMatrix< volatile CSRMatrix<T> > : public TrueType
+{
+   enum { value = 1 };
+   typedef TrueType  Type;
+};
+
+template< typename T >
+struct IsCSRMatrix< const volatile CSRMatrix<T> > : public TrueType
+{
+   enum { value = 1 };
+   typedef TrueType  Type;
+};
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -38,6 +38,8 @@
 #include <blaze/math/shims/Equal.h>
 #include <blaze/math/shims/IsDefault.h>
 #include <blaze/math/shims/IsNaN.h>
+#include <blaze/math/smp/Randomize.h>
+#include <blaze/math/smp/ThreadBackend.h>
 #include <blaze/math/sparse/MatrixAccessProxy.h>
 #include <blaze/math/sparse/SparseElement.h>
 #include <blaze/math/SparseMatrix.h>
@@ -46,8 +48,10 @@
 #include <blaze/math/typetraits/IsSparseMatrix.h>
 #include <blaze/system/Precision.h>
 #include <blaze/system/StorageOrder.h>
+#include <blaze/system/Thresholds.h>
 #include <blaze/util/Assert.h>
 #include <blaze/util/constraints/Const.h>
+#include <blaze/util/constraints/FloatingPoint.h>
 #include <blaze/util/constraints/Numeric.h>
 #include <blaze/util/constraints/Pointer.h>
 #include <blaze/util/constraints/Reference.h>
@@ -3796,6 +3800,12 @@ inline void reset( CompressedMatrix<Type,SO>& m );
 template< typename Type, bool SO >
 inline void clear( CompressedMatrix<Type,SO>& m );
 
+template< typename Type, bool SO >
+inline void randomize( CompressedMatrix<Type,SO>& m );
+
+template< typename Type, bool SO >
+inline void randomize( CompressedMatrix<Type,SO>& m, Type min, Type max );
+
 template< typename Type, bool SO >
 inline bool isDefault( const CompressedMatrix<Type,SO>& m );
 
@@ -3866,6 +3876,65 @@ inline void clear( CompressedMatrix<Type,SO>& m )
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Initialization of the non-zero elements of the given sparse matrix with random values.
+// \ingroup compressed_matrix
+//
+// \param m The sparse matrix to be initialized.
+// \return void
+//
+// This function initializes all non-zero elements of the given sparse matrix with random values
+// in the range \f$ [0..1) \f$. For more details see the randomize() function with explicit bounds.
+*/
+template< typename Type  // Data type of the sparse matrix
+        , bool SO >      // Storage order
+inline void randomize( CompressedMatrix<Type,SO>& m )
+{
+   randomize( m, Type(0), Type(1) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Initialization of the non-zero elements of the given sparse matrix with random values
+//        in the given range.
+// \ingroup compressed_matrix
+//
+// \param m The sparse matrix to be initialized.
+// \param min The smallest possible random value.
+// \param max The upper bound of the random values.
+// \return void
+//
+// This function initializes all non-zero elements of the given sparse matrix with random values
+// in the range \f$ [min..max) \f$. The sparsity pattern of the matrix is not changed. The values
+// are taken from the random number stream of the calling thread (see the splitStream() function)
+// in the order of the non-zero elements and are generated several at a time by means of
+// vectorized operations. In case the number of non-zero elements is equal or higher than the
+// SMP_RANDOMIZE_THRESHOLD, the values are generated in parallel. Independent of the number of
+// threads, the matrix receives the same values. This function can only be used for floating
+// point element types. The attempt to use it with any other element type results in a
+// compilation error.
+*/
+template< typename Type  // Data type of the sparse matrix
+        , bool SO >      // Storage order
+inline void randomize( CompressedMatrix<Type,SO>& m, Type min, Type max )
+{
+   BLAZE_CONSTRAINT_MUST_BE_FLOATING_POINT_TYPE( Type );
+   BLAZE_USER_ASSERT( min <= max, "Invalid min/max value pair" );
+
+   const size_t outer   ( ( SO )?( m.columns() ):( m.rows() ) );
+   const size_t nonzeros( m.nonZeros() );
+
+   const SparseRandomizeTask< CompressedMatrix<Type,SO> > task( m, splitStream<Type>( nonzeros ), min, max );
+
+   if( nonzeros < SMP_RANDOMIZE_THRESHOLD )
+      task( 0UL, outer );
+   else
+      smpFor( outer, 64UL, task );
+}
+//*************************************************************************************************
+
+
 //*************************************************************************************************
 /*!\brief Returns whether the given sparse matrix is in default state.
 // \ingroup compressed_matrix
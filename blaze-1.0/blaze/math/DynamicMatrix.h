@@ -38,6 +38,8 @@
 #include <blaze/math/shims/IsDefault.h>
 #include <blaze/math/shims/IsNaN.h>
 #include <blaze/math/shims/Reset.h>
+#include <blaze/math/smp/Randomize.h>
+#include <blaze/math/smp/ThreadBackend.h>
 #include <blaze/math/Types.h>
 #include <blaze/math/typetraits/CanAlias.h>
 #include <blaze/math/typetraits/IsResizable.h>
@@ -46,8 +48,10 @@
 #include <blaze/system/Precision.h>
 #include <blaze/system/Restrict.h>
 #include <blaze/system/StorageOrder.h>
+#include <blaze/system/Thresholds.h>
 #include <blaze/util/Assert.h>
 #include <blaze/util/constraints/Const.h>
+#include <blaze/util/constraints/FloatingPoint.h>
 #include <blaze/util/constraints/Numeric.h>
 #include <blaze/util/constraints/Pointer.h>
 #include <blaze/util/constraints/Reference.h>
@@ -314,37 +318,43 @@ class DynamicMatrix : public DenseMatrix< DynamicMatrix<Type,SO>, SO >
    template< typename Other > inline bool          isAliased( const Other* alias ) const;
                               inline IntrinsicType get      ( size_t i, size_t j ) const;
 
+   template< typename MT > inline void assign( const DenseMatrix<MT,SO>& rhs );
+
    template< typename MT >
    inline typename DisableIf< VectorizedAssign<MT> >::Type
-      assign( const DenseMatrix<MT,SO>& rhs );
+      assign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend );
 
    template< typename MT >
    inline typename EnableIf< VectorizedAssign<MT> >::Type
-      assign( const DenseMatrix<MT,SO>& rhs );
+      assign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend );
 
    template< typename MT > inline void assign( const DenseMatrix<MT,!SO>&  rhs );
    template< typename MT > inline void assign( const SparseMatrix<MT,SO>&  rhs );
    template< typename MT > inline void assign( const SparseMatrix<MT,!SO>& rhs );
 
+   template< typename MT > inline void addAssign( const DenseMatrix<MT,SO>& rhs );
+
    template< typename MT >
    inline typename DisableIf< VectorizedAddAssign<MT> >::Type
-      addAssign( const DenseMatrix<MT,SO>& rhs );
+      addAssign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend );
 
    template< typename MT >
    inline typename EnableIf< VectorizedAddAssign<MT> >::Type
-      addAssign( const DenseMatrix<MT,SO>& rhs );
+      addAssign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend );
 
    template< typename MT > inline void addAssign( const DenseMatrix<MT,!SO>&  rhs );
    template< typename MT > inline void addAssign( const SparseMatrix<MT,SO>&  rhs );
    template< typename MT > inline void addAssign( const SparseMatrix<MT,!SO>& rhs );
 
+   template< typename MT > inline void subAssign( const DenseMatrix<MT,SO>& rhs );
+
    template< typename MT >
    inline typename DisableIf< VectorizedSubAssign<MT> >::Type
-      subAssign( const DenseMatrix<MT,SO>& rhs );
+      subAssign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend );
 
    template< typename MT >
    inline typename EnableIf< VectorizedSubAssign<MT> >::Type
-      subAssign( const DenseMatrix<MT,SO>& rhs );
+      subAssign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend );
 
    template< typename MT > inline void subAssign( const DenseMatrix<MT,!SO>&  rhs );
    template< typename MT > inline void subAssign( const SparseMatrix<MT,SO>&  rhs );
@@ -416,7 +426,8 @@ inline DynamicMatrix<Type,SO>::DynamicMatrix()
 
 
 //*************************************************************************************************
-/*!\brief Constructor for a matrix of size \f$ m \times n \f$. No element initialization is performed!
+/*!\brief Constructor for a matrix of size \f$ m \times n \f$. No element initialization is
+//        performed!
 //
 // \param m The number of rows of the matrix.
 // \param n The number of columns of the matrix.
@@ -1433,7 +1444,7 @@ inline typename DynamicMatrix<Type,SO>::IntrinsicType
 
 
 //*************************************************************************************************
-/*!\brief Default implementation of the assignment of a row-major dense matrix.
+/*!\brief Implementation of the assignment of a row-major dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be assigned.
 // \return void
@@ -1442,20 +1453,54 @@ inline typename DynamicMatrix<Type,SO>::IntrinsicType
 // optimized evaluation of expression templates. Calling this function explicitly might result
 // in erroneous results and/or in compilation errors. Instead of using this function use the
 // assignment operator.
+//
+// In case the number of elements of the matrix is equal or higher than the
+// SMP_DMATASSIGN_THRESHOLD, the assignment is executed in parallel (see \ref smp).
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+template< typename MT >  // Type of the right-hand side dense matrix
+inline void DynamicMatrix<Type,SO>::assign( const DenseMatrix<MT,SO>& rhs )
+{
+   BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+
+   if( m_*n_ < SMP_DMATASSIGN_THRESHOLD )
+      assign( ~rhs, 0UL, m_ );
+   else
+      smpFor( m_, 1UL, AssignTask<DynamicMatrix,MT>( *this, ~rhs ) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Default implementation of the assignment of a range of rows of a row-major
+//        dense matrix.
+//
+// \param rhs The right-hand side dense matrix to be assigned.
+// \param ibegin The index of the first row of the range.
+// \param iend The index one past the last row of the range.
+// \return void
+//
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates. Calling this function explicitly might result
+// in erroneous results and/or in compilation errors. Instead of using this function use the
+// assignment operator.
 */
 template< typename Type  // Data type of the matrix
         , bool SO >      // Storage order
 template< typename MT >  // Type of the right-hand side dense matrix
 inline typename DisableIf< typename DynamicMatrix<Type,SO>::BLAZE_TEMPLATE VectorizedAssign<MT> >::Type
-   DynamicMatrix<Type,SO>::assign( const DenseMatrix<MT,SO>& rhs )
+   DynamicMatrix<Type,SO>::assign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= m_, "Invalid range" );
 
    BLAZE_INTERNAL_ASSERT( ( n_ - ( n_ % 2UL ) ) == ( n_ & size_t(-2) ), "Invalid end calculation" );
    const size_t end( n_ & size_t(-2) );
 
-   for( size_t i=0UL; i<m_; ++i ) {
+   for( size_t i=ibegin; i<iend; ++i ) {
       for( size_t j=0UL; j<end; j+=2UL ) {
          v_[i*nn_+j    ] = (~rhs)(i,j    );
          v_[i*nn_+j+1UL] = (~rhs)(i,j+1UL);
@@ -1469,9 +1514,12 @@ inline typename DisableIf< typename DynamicMatrix<Type,SO>::BLAZE_TEMPLATE Vecto
 
 
 //*************************************************************************************************
-/*!\brief Intrinsic optimized implementation of the assignment of a row-major dense matrix.
+/*!\brief Intrinsic optimized implementation of the assignment of a range of rows of a row-major
+//        dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be assigned.
+// \param ibegin The index of the first row of the range.
+// \param iend The index one past the last row of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -1483,16 +1531,17 @@ template< typename Type  // Data type of the matrix
         , bool SO >      // Storage order
 template< typename MT >  // Type of the right-hand side dense matrix
 inline typename EnableIf< typename DynamicMatrix<Type,SO>::BLAZE_TEMPLATE VectorizedAssign<MT> >::Type
-   DynamicMatrix<Type,SO>::assign( const DenseMatrix<MT,SO>& rhs )
+   DynamicMatrix<Type,SO>::assign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= m_, "Invalid range" );
 
    BLAZE_CONSTRAINT_MUST_BE_VECTORIZABLE_TYPE( Type );
 
    if( m_*n_ > ( cacheSize / ( sizeof(Type) * 3UL ) ) && !(~rhs).isAliased( this ) )
    {
-      for( size_t i=0UL; i<m_; ++i )
+      for( size_t i=ibegin; i<iend; ++i )
          for( size_t j=0UL; j<n_; j+=IT::size )
             stream( &v_[i*nn_+j], (~rhs).get(i,j) );
    }
@@ -1501,7 +1550,7 @@ inline typename EnableIf< typename DynamicMatrix<Type,SO>::BLAZE_TEMPLATE Vector
       BLAZE_INTERNAL_ASSERT( ( n_ - ( n_ % (IT::size*4UL) ) ) == ( n_ & size_t(-IT::size*4) ), "Invalid end calculation" );
       const size_t end( n_ & size_t(-IT::size*4) );
 
-      for( size_t i=0UL; i<m_; ++i ) {
+      for( size_t i=ibegin; i<iend; ++i ) {
          for( size_t j=0UL; j<end; j+=IT::size*4UL ) {
             store( &v_[i*nn_+j             ], (~rhs).get(i,j             ) );
             store( &v_[i*nn_+j+IT::size    ], (~rhs).get(i,j+IT::size    ) );
@@ -1610,9 +1659,42 @@ inline void DynamicMatrix<Type,SO>::assign( const SparseMatrix<MT,!SO>& rhs )
 
 
 //*************************************************************************************************
-/*!\brief Default implementation of the addition assignment of a row-major dense matrix.
+/*!\brief Implementation of the addition assignment of a row-major dense matrix.
+//
+// \param rhs The right-hand side dense matrix to be added.
+// \return void
+//
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates. Calling this function explicitly might result
+// in erroneous results and/or in compilation errors. Instead of using this function use the
+// assignment operator.
+//
+// In case the number of elements of the matrix is equal or higher than the
+// SMP_DMATASSIGN_THRESHOLD, the addition assignment is executed in parallel (see \ref smp).
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+template< typename MT >  // Type of the right-hand side dense matrix
+inline void DynamicMatrix<Type,SO>::addAssign( const DenseMatrix<MT,SO>& rhs )
+{
+   BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+
+   if( m_*n_ < SMP_DMATASSIGN_THRESHOLD )
+      addAssign( ~rhs, 0UL, m_ );
+   else
+      smpFor( m_, 1UL, AddAssignTask<DynamicMatrix,MT>( *this, ~rhs ) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Default implementation of the addition assignment of a range of rows of a row-major
+//        dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be added.
+// \param ibegin The index of the first row of the range.
+// \param iend The index one past the last row of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -1624,15 +1706,16 @@ template< typename Type  // Data type of the matrix
         , bool SO >      // Storage order
 template< typename MT >  // Type of the right-hand side dense matrix
 inline typename DisableIf< typename DynamicMatrix<Type,SO>::BLAZE_TEMPLATE VectorizedAddAssign<MT> >::Type
-   DynamicMatrix<Type,SO>::addAssign( const DenseMatrix<MT,SO>& rhs )
+   DynamicMatrix<Type,SO>::addAssign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= m_, "Invalid range" );
 
    BLAZE_INTERNAL_ASSERT( ( n_ - ( n_ % 2UL ) ) == ( n_ & size_t(-2) ), "Invalid end calculation" );
    const size_t end( n_ & size_t(-2) );
 
-   for( size_t i=0UL; i<m_; ++i ) {
+   for( size_t i=ibegin; i<iend; ++i ) {
       for( size_t j=0UL; j<end; j+=2UL ) {
          v_[i*nn_+j    ] += (~rhs)(i,j    );
          v_[i*nn_+j+1UL] += (~rhs)(i,j+1UL);
@@ -1646,9 +1729,12 @@ inline typename DisableIf< typename DynamicMatrix<Type,SO>::BLAZE_TEMPLATE Vecto
 
 
 //*************************************************************************************************
-/*!\brief Intrinsic optimized implementation of the addition assignment of a row-major dense matrix.
+/*!\brief Intrinsic optimized implementation of the addition assignment of a range of rows of a
+//        row-major dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be added.
+// \param ibegin The index of the first row of the range.
+// \param iend The index one past the last row of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -1660,17 +1746,18 @@ template< typename Type  // Data type of the matrix
         , bool SO >      // Storage order
 template< typename MT >  // Type of the right-hand side dense matrix
 inline typename EnableIf< typename DynamicMatrix<Type,SO>::BLAZE_TEMPLATE VectorizedAddAssign<MT> >::Type
-   DynamicMatrix<Type,SO>::addAssign( const DenseMatrix<MT,SO>& rhs )
+   DynamicMatrix<Type,SO>::addAssign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= m_, "Invalid range" );
 
    BLAZE_CONSTRAINT_MUST_BE_VECTORIZABLE_TYPE( Type );
 
    BLAZE_INTERNAL_ASSERT( ( n_ - ( n_ % (IT::size*4UL) ) ) == ( n_ & size_t(-IT::size*4) ), "Invalid end calculation" );
    const size_t end( n_ & size_t(-IT::size*4) );
 
-   for( size_t i=0UL; i<m_; ++i ) {
+   for( size_t i=ibegin; i<iend; ++i ) {
       for( size_t j=0UL; j<end; j+=IT::size*4UL ) {
          store( &v_[i*nn_+j             ], load( &v_[i*nn_+j             ] ) + (~rhs).get(i,j             ) );
          store( &v_[i*nn_+j+IT::size    ], load( &v_[i*nn_+j+IT::size    ] ) + (~rhs).get(i,j+IT::size    ) );
@@ -1778,7 +1865,7 @@ inline void DynamicMatrix<Type,SO>::addAssign( const SparseMatrix<MT,!SO>& rhs )
 
 
 //*************************************************************************************************
-/*!\brief Default implementation of the subtraction assignment of a row-major dense matrix.
+/*!\brief Implementation of the subtraction assignment of a row-major dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be subtracted.
 // \return void
@@ -1787,20 +1874,54 @@ inline void DynamicMatrix<Type,SO>::addAssign( const SparseMatrix<MT,!SO>& rhs )
 // optimized evaluation of expression templates. Calling this function explicitly might result
 // in erroneous results and/or in compilation errors. Instead of using this function use the
 // assignment operator.
+//
+// In case the number of elements of the matrix is equal or higher than the
+// SMP_DMATASSIGN_THRESHOLD, the subtraction assignment is executed in parallel (see \ref smp).
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+template< typename MT >  // Type of the right-hand side dense matrix
+inline void DynamicMatrix<Type,SO>::subAssign( const DenseMatrix<MT,SO>& rhs )
+{
+   BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+
+   if( m_*n_ < SMP_DMATASSIGN_THRESHOLD )
+      subAssign( ~rhs, 0UL, m_ );
+   else
+      smpFor( m_, 1UL, SubAssignTask<DynamicMatrix,MT>( *this, ~rhs ) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Default implementation of the subtraction assignment of a range of rows of a row-major
+//        dense matrix.
+//
+// \param rhs The right-hand side dense matrix to be subtracted.
+// \param ibegin The index of the first row of the range.
+// \param iend The index one past the last row of the range.
+// \return void
+//
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates. Calling this function explicitly might result
+// in erroneous results and/or in compilation errors. Instead of using this function use the
+// assignment operator.
 */
 template< typename Type  // Data type of the matrix
         , bool SO >      // Storage order
 template< typename MT >  // Type of the right-hand side dense matrix
 inline typename DisableIf< typename DynamicMatrix<Type,SO>::BLAZE_TEMPLATE VectorizedSubAssign<MT> >::Type
-   DynamicMatrix<Type,SO>::subAssign( const DenseMatrix<MT,SO>& rhs )
+   DynamicMatrix<Type,SO>::subAssign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= m_, "Invalid range" );
 
    BLAZE_INTERNAL_ASSERT( ( n_ - ( n_ % 2UL ) ) == ( n_ & size_t(-2) ), "Invalid end calculation" );
    const size_t end( n_ & size_t(-2) );
 
-   for( size_t i=0UL; i<m_; ++i ) {
+   for( size_t i=ibegin; i<iend; ++i ) {
       for( size_t j=0UL; j<end; j+=2UL ) {
          v_[i*nn_+j    ] -= (~rhs)(i,j    );
          v_[i*nn_+j+1UL] -= (~rhs)(i,j+1UL);
@@ -1814,9 +1935,12 @@ inline typename DisableIf< typename DynamicMatrix<Type,SO>::BLAZE_TEMPLATE Vecto
 
 
 //*************************************************************************************************
-/*!\brief Intrinsic optimized implementation of the subtraction assignment of a row-major dense matrix.
+/*!\brief Intrinsic optimized implementation of the subtraction assignment of a range of rows of a
+//        row-major dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be subtracted.
+// \param ibegin The index of the first row of the range.
+// \param iend The index one past the last row of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -1828,17 +1952,18 @@ template< typename Type  // Data type of the matrix
         , bool SO >      // Storage order
 template< typename MT >  // Type of the right-hand side dense matrix
 inline typename EnableIf< typename DynamicMatrix<Type,SO>::BLAZE_TEMPLATE VectorizedSubAssign<MT> >::Type
-   DynamicMatrix<Type,SO>::subAssign( const DenseMatrix<MT,SO>& rhs )
+   DynamicMatrix<Type,SO>::subAssign( const DenseMatrix<MT,SO>& rhs, size_t ibegin, size_t iend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= m_, "Invalid range" );
 
    BLAZE_CONSTRAINT_MUST_BE_VECTORIZABLE_TYPE( Type );
 
    BLAZE_INTERNAL_ASSERT( ( n_ - ( n_ % (IT::size*4UL) ) ) == ( n_ & size_t(-IT::size*4) ), "Invalid end calculation" );
    const size_t end( n_ & size_t(-IT::size*4) );
 
-   for( size_t i=0UL; i<m_; ++i ) {
+   for( size_t i=ibegin; i<iend; ++i ) {
       for( size_t j=0UL; j<end; j+=IT::size*4UL ) {
          store( &v_[i*nn_+j             ], load( &v_[i*nn_+j             ] ) - (~rhs).get(i,j             ) );
          store( &v_[i*nn_+j+IT::size    ], load( &v_[i*nn_+j+IT::size    ] ) - (~rhs).get(i,j+IT::size    ) );
@@ -2113,37 +2238,43 @@ class DynamicMatrix<Type,true> : public DenseMatrix< DynamicMatrix<Type,true>, t
    template< typename Other > inline bool          isAliased( const Other* alias ) const;
                               inline IntrinsicType get      ( size_t i, size_t j ) const;
 
+   template< typename MT > inline void assign( const DenseMatrix<MT,true>& rhs );
+
    template< typename MT >
    inline typename DisableIf< VectorizedAssign<MT> >::Type
-      assign( const DenseMatrix<MT,true>& rhs );
+      assign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend );
 
    template< typename MT >
    inline typename EnableIf< VectorizedAssign<MT> >::Type
-      assign( const DenseMatrix<MT,true>& rhs );
+      assign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend );
 
    template< typename MT > inline void assign( const DenseMatrix<MT,false>&  rhs );
    template< typename MT > inline void assign( const SparseMatrix<MT,true>&  rhs );
    template< typename MT > inline void assign( const SparseMatrix<MT,false>& rhs );
 
+   template< typename MT > inline void addAssign( const DenseMatrix<MT,true>& rhs );
+
    template< typename MT >
    inline typename DisableIf< VectorizedAddAssign<MT> >::Type
-      addAssign( const DenseMatrix<MT,true>& rhs );
+      addAssign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend );
 
    template< typename MT >
    inline typename EnableIf< VectorizedAddAssign<MT> >::Type
-      addAssign( const DenseMatrix<MT,true>& rhs );
+      addAssign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend );
 
    template< typename MT > inline void addAssign( const DenseMatrix<MT,false>&  rhs );
    template< typename MT > inline void addAssign( const SparseMatrix<MT,true>&  rhs );
    template< typename MT > inline void addAssign( const SparseMatrix<MT,false>& rhs );
 
+   template< typename MT > inline void subAssign( const DenseMatrix<MT,true>& rhs );
+
    template< typename MT >
    inline typename DisableIf< VectorizedSubAssign<MT> >::Type
-      subAssign ( const DenseMatrix<MT,true>& rhs );
+      subAssign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend );
 
    template< typename MT >
    inline typename EnableIf< VectorizedSubAssign<MT> >::Type
-      subAssign ( const DenseMatrix<MT,true>& rhs );
+      subAssign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend );
 
    template< typename MT > inline void subAssign( const DenseMatrix<MT,false>&  rhs );
    template< typename MT > inline void subAssign( const SparseMatrix<MT,true>&  rhs );
@@ -2216,7 +2347,8 @@ inline DynamicMatrix<Type,true>::DynamicMatrix()
 
 //*************************************************************************************************
 /*! \cond BLAZE_INTERNAL */
-/*!\brief Constructor for a matrix of size \f$ m \times n \f$. No element initialization is performed!
+/*!\brief Constructor for a matrix of size \f$ m \times n \f$. No element initialization is
+//        performed!
 //
 // \param m The number of rows of the matrix.
 // \param n The number of columns of the matrix.
@@ -3274,7 +3406,7 @@ inline typename DynamicMatrix<Type,true>::IntrinsicType
 
 //*************************************************************************************************
 /*! \cond BLAZE_INTERNAL */
-/*!\brief Default implementation of the assignment of a column-major dense matrix.
+/*!\brief Implementation of the assignment of a column-major dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be assigned.
 // \return void
@@ -3283,19 +3415,54 @@ inline typename DynamicMatrix<Type,true>::IntrinsicType
 // optimized evaluation of expression templates. Calling this function explicitly might result
 // in erroneous results and/or in compilation errors. Instead of using this function use the
 // assignment operator.
+//
+// In case the number of elements of the matrix is equal or higher than the
+// SMP_DMATASSIGN_THRESHOLD, the assignment is executed in parallel (see \ref smp).
+*/
+template< typename Type >  // Data type of the matrix
+template< typename MT >    // Type of the right-hand side dense matrix
+inline void DynamicMatrix<Type,true>::assign( const DenseMatrix<MT,true>& rhs )
+{
+   BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+
+   if( m_*n_ < SMP_DMATASSIGN_THRESHOLD )
+      assign( ~rhs, 0UL, n_ );
+   else
+      smpFor( n_, 1UL, AssignTask<DynamicMatrix,MT>( *this, ~rhs ) );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Default implementation of the assignment of a range of columns of a column-major
+//        dense matrix.
+//
+// \param rhs The right-hand side dense matrix to be assigned.
+// \param jbegin The index of the first column of the range.
+// \param jend The index one past the last column of the range.
+// \return void
+//
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates. Calling this function explicitly might result
+// in erroneous results and/or in compilation errors. Instead of using this function use the
+// assignment operator.
 */
 template< typename Type >  // Data type of the matrix
 template< typename MT >    // Type of the right-hand side dense matrix
 inline typename DisableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE VectorizedAssign<MT> >::Type
-   DynamicMatrix<Type,true>::assign( const DenseMatrix<MT,true>& rhs )
+   DynamicMatrix<Type,true>::assign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( jbegin <= jend && jend <= n_, "Invalid range" );
 
    BLAZE_INTERNAL_ASSERT( ( m_ - ( m_ % 2UL ) ) == ( m_ & size_t(-2) ), "Invalid end calculation" );
    const size_t end( m_ & size_t(-2) );
 
-   for( size_t j=0UL; j<n_; ++j ) {
+   for( size_t j=jbegin; j<jend; ++j ) {
       for( size_t i=0UL; i<end; i+=2UL ) {
          v_[i    +j*mm_] = (~rhs)(i    ,j);
          v_[i+1UL+j*mm_] = (~rhs)(i+1UL,j);
@@ -3311,9 +3478,12 @@ inline typename DisableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE Vec
 
 //*************************************************************************************************
 /*! \cond BLAZE_INTERNAL */
-/*!\brief Intrinsic optimized implementation of the assignment of a column-major dense matrix.
+/*!\brief Intrinsic optimized implementation of the assignment of a range of columns of a
+//        column-major dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be assigned.
+// \param jbegin The index of the first column of the range.
+// \param jend The index one past the last column of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -3324,16 +3494,17 @@ inline typename DisableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE Vec
 template< typename Type >  // Data type of the matrix
 template< typename MT >    // Type of the right-hand side dense matrix
 inline typename EnableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE VectorizedAssign<MT> >::Type
-   DynamicMatrix<Type,true>::assign( const DenseMatrix<MT,true>& rhs )
+   DynamicMatrix<Type,true>::assign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( jbegin <= jend && jend <= n_, "Invalid range" );
 
    BLAZE_CONSTRAINT_MUST_BE_VECTORIZABLE_TYPE( Type );
 
    if( m_*n_ > ( cacheSize / ( sizeof(Type) * 3UL ) ) && !(~rhs).isAliased( this ) )
    {
-      for( size_t j=0UL; j<n_; ++j )
+      for( size_t j=jbegin; j<jend; ++j )
          for( size_t i=0UL; i<m_; i+=IT::size )
             stream( &v_[i+j*mm_], (~rhs).get(i,j) );
    }
@@ -3342,7 +3513,7 @@ inline typename EnableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE Vect
       BLAZE_INTERNAL_ASSERT( ( m_ - ( m_ % (IT::size*4UL) ) ) == ( m_ & size_t(-IT::size*4) ), "Invalid end calculation" );
       const size_t end( m_ & size_t(-IT::size*4) );
 
-      for( size_t j=0UL; j<n_; ++j ) {
+      for( size_t j=jbegin; j<jend; ++j ) {
          for( size_t i=0UL; i<end; i+=IT::size*4UL ) {
             store( &v_[i+j*mm_             ], (~rhs).get(i             ,j) );
             store( &v_[i+j*mm_+IT::size    ], (~rhs).get(i+IT::size    ,j) );
@@ -3450,7 +3621,7 @@ inline void DynamicMatrix<Type,true>::assign( const SparseMatrix<MT,false>& rhs
 
 //*************************************************************************************************
 /*! \cond BLAZE_INTERNAL */
-/*!\brief Default implementation of the addition assignment of a column-major dense matrix.
+/*!\brief Implementation of the addition assignment of a column-major dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be added.
 // \return void
@@ -3459,19 +3630,54 @@ inline void DynamicMatrix<Type,true>::assign( const SparseMatrix<MT,false>& rhs
 // optimized evaluation of expression templates. Calling this function explicitly might result
 // in erroneous results and/or in compilation errors. Instead of using this function use the
 // assignment operator.
+//
+// In case the number of elements of the matrix is equal or higher than the
+// SMP_DMATASSIGN_THRESHOLD, the addition assignment is executed in parallel (see \ref smp).
+*/
+template< typename Type >  // Data type of the matrix
+template< typename MT >    // Type of the right-hand side dense matrix
+inline void DynamicMatrix<Type,true>::addAssign( const DenseMatrix<MT,true>& rhs )
+{
+   BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+
+   if( m_*n_ < SMP_DMATASSIGN_THRESHOLD )
+      addAssign( ~rhs, 0UL, n_ );
+   else
+      smpFor( n_, 1UL, AddAssignTask<DynamicMatrix,MT>( *this, ~rhs ) );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Default implementation of the addition assignment of a range of columns of a column-major
+//        dense matrix.
+//
+// \param rhs The right-hand side dense matrix to be added.
+// \param jbegin The index of the first column of the range.
+// \param jend The index one past the last column of the range.
+// \return void
+//
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates. Calling this function explicitly might result
+// in erroneous results and/or in compilation errors. Instead of using this function use the
+// assignment operator.
 */
 template< typename Type >  // Data type of the matrix
 template< typename MT >    // Type of the right-hand side dense matrix
 inline typename DisableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE VectorizedAddAssign<MT> >::Type
-   DynamicMatrix<Type,true>::addAssign( const DenseMatrix<MT,true>& rhs )
+   DynamicMatrix<Type,true>::addAssign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( jbegin <= jend && jend <= n_, "Invalid range" );
 
    BLAZE_INTERNAL_ASSERT( ( m_ - ( m_ % 2UL ) ) == ( m_ & size_t(-2) ), "Invalid end calculation" );
    const size_t end( m_ & size_t(-2) );
 
-   for( size_t j=0UL; j<n_; ++j ) {
+   for( size_t j=jbegin; j<jend; ++j ) {
       for( size_t i=0UL; i<end; i+=2UL ) {
          v_[i    +j*mm_] += (~rhs)(i    ,j);
          v_[i+1UL+j*mm_] += (~rhs)(i+1UL,j);
@@ -3487,9 +3693,12 @@ inline typename DisableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE Vec
 
 //*************************************************************************************************
 /*! \cond BLAZE_INTERNAL */
-/*!\brief Intrinsic optimizd implementation of the addition assignment of a column-major dense matrix.
+/*!\brief Intrinsic optimized implementation of the addition assignment of a range of columns of a
+//        column-major dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be added.
+// \param jbegin The index of the first column of the range.
+// \param jend The index one past the last column of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -3500,17 +3709,18 @@ inline typename DisableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE Vec
 template< typename Type >  // Data type of the matrix
 template< typename MT >    // Type of the right-hand side dense matrix
 inline typename EnableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE VectorizedAddAssign<MT> >::Type
-   DynamicMatrix<Type,true>::addAssign( const DenseMatrix<MT,true>& rhs )
+   DynamicMatrix<Type,true>::addAssign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( jbegin <= jend && jend <= n_, "Invalid range" );
 
    BLAZE_CONSTRAINT_MUST_BE_VECTORIZABLE_TYPE( Type );
 
    BLAZE_INTERNAL_ASSERT( ( m_ - ( m_ % (IT::size*4UL) ) ) == ( m_ & size_t(-IT::size*4) ), "Invalid end calculation" );
    const size_t end( m_ & size_t(-IT::size*4) );
 
-   for( size_t j=0UL; j<n_; ++j ) {
+   for( size_t j=jbegin; j<jend; ++j ) {
       for( size_t i=0UL; i<end; i+=IT::size*4UL ) {
          store( &v_[i+j*mm_             ], load( &v_[i+j*mm_             ] ) + (~rhs).get(i             ,j) );
          store( &v_[i+j*mm_+IT::size    ], load( &v_[i+j*mm_+IT::size    ] ) + (~rhs).get(i+IT::size    ,j) );
@@ -3617,7 +3827,7 @@ inline void DynamicMatrix<Type,true>::addAssign( const SparseMatrix<MT,false>& r
 
 //*************************************************************************************************
 /*! \cond BLAZE_INTERNAL */
-/*!\brief Default implementation of the subtraction assignment of a column-major dense matrix.
+/*!\brief Implementation of the subtraction assignment of a column-major dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be subtracted.
 // \return void
@@ -3626,19 +3836,54 @@ inline void DynamicMatrix<Type,true>::addAssign( const SparseMatrix<MT,false>& r
 // optimized evaluation of expression templates. Calling this function explicitly might result
 // in erroneous results and/or in compilation errors. Instead of using this function use the
 // assignment operator.
+//
+// In case the number of elements of the matrix is equal or higher than the
+// SMP_DMATASSIGN_THRESHOLD, the subtraction assignment is executed in parallel (see \ref smp).
+*/
+template< typename Type >  // Data type of the matrix
+template< typename MT >    // Type of the right-hand side dense matrix
+inline void DynamicMatrix<Type,true>::subAssign( const DenseMatrix<MT,true>& rhs )
+{
+   BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+
+   if( m_*n_ < SMP_DMATASSIGN_THRESHOLD )
+      subAssign( ~rhs, 0UL, n_ );
+   else
+      smpFor( n_, 1UL, SubAssignTask<DynamicMatrix,MT>( *this, ~rhs ) );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Default implementation of the subtraction assignment of a range of columns of a
+//        column-major dense matrix.
+//
+// \param rhs The right-hand side dense matrix to be subtracted.
+// \param jbegin The index of the first column of the range.
+// \param jend The index one past the last column of the range.
+// \return void
+//
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates. Calling this function explicitly might result
+// in erroneous results and/or in compilation errors. Instead of using this function use the
+// assignment operator.
 */
 template< typename Type >  // Data type of the matrix
 template< typename MT >    // Type of the right-hand side dense matrix
 inline typename DisableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE VectorizedSubAssign<MT> >::Type
-   DynamicMatrix<Type,true>::subAssign( const DenseMatrix<MT,true>& rhs )
+   DynamicMatrix<Type,true>::subAssign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( jbegin <= jend && jend <= n_, "Invalid range" );
 
    BLAZE_INTERNAL_ASSERT( ( m_ - ( m_ % 2UL ) ) == ( m_ & size_t(-2) ), "Invalid end calculation" );
    const size_t end( m_ & size_t(-2) );
 
-   for( size_t j=0UL; j<n_; ++j ) {
+   for( size_t j=jbegin; j<jend; ++j ) {
       for( size_t i=0UL; i<end; i+=2UL ) {
          v_[i  +j*mm_] -= (~rhs)(i  ,j);
          v_[i+1+j*mm_] -= (~rhs)(i+1,j);
@@ -3654,10 +3899,12 @@ inline typename DisableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE Vec
 
 //*************************************************************************************************
 /*! \cond BLAZE_INTERNAL */
-/*!\brief Intrinsic optimized implementation of the subtraction assignment of a column-major
-//        dense matrix.
+/*!\brief Intrinsic optimized implementation of the subtraction assignment of a range of columns of
+//        a column-major dense matrix.
 //
 // \param rhs The right-hand side dense matrix to be subtracted.
+// \param jbegin The index of the first column of the range.
+// \param jend The index one past the last column of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -3668,17 +3915,18 @@ inline typename DisableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE Vec
 template< typename Type >  // Data type of the matrix
 template< typename MT >    // Type of the right-hand side dense matrix
 inline typename EnableIf< typename DynamicMatrix<Type,true>::BLAZE_TEMPLATE VectorizedSubAssign<MT> >::Type
-   DynamicMatrix<Type,true>::subAssign( const DenseMatrix<MT,true>& rhs )
+   DynamicMatrix<Type,true>::subAssign( const DenseMatrix<MT,true>& rhs, size_t jbegin, size_t jend )
 {
    BLAZE_INTERNAL_ASSERT( m_ == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( n_ == (~rhs).columns(), "Invalid number of columns" );
+   BLAZE_INTERNAL_ASSERT( jbegin <= jend && jend <= n_, "Invalid range" );
 
    BLAZE_CONSTRAINT_MUST_BE_VECTORIZABLE_TYPE( Type );
 
    BLAZE_INTERNAL_ASSERT( ( m_ - ( m_ % (IT::size*4UL) ) ) == ( m_ & size_t(-IT::size*4) ), "Invalid end calculation" );
    const size_t end( m_ & size_t(-IT::size*4) );
 
-   for( size_t j=0UL; j<n_; ++j ) {
+   for( size_t j=jbegin; j<jend; ++j ) {
       for( size_t i=0UL; i<end; i+=IT::size*4UL ) {
          store( &v_[i+j*mm_             ], load( &v_[i+j*mm_             ] ) - (~rhs).get(i             ,j) );
          store( &v_[i+j*mm_+IT::size    ], load( &v_[i+j*mm_+IT::size    ] ) - (~rhs).get(i+IT::size    ,j) );
@@ -3804,6 +4052,12 @@ inline void reset( DynamicMatrix<Type,SO>& m );
 template< typename Type, bool SO >
 inline void clear( DynamicMatrix<Type,SO>& m );
 
+template< typename Type, bool SO >
+inline void randomize( DynamicMatrix<Type,SO>& m );
+
+template< typename Type, bool SO >
+inline void randomize( DynamicMatrix<Type,SO>& m, Type min, Type max );
+
 template< typename Type, bool SO >
 inline bool isDefault( const DynamicMatrix<Type,SO>& m );
 
@@ -3872,6 +4126,65 @@ inline void clear( DynamicMatrix<Type,SO>& m )
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Initialization of the given dense matrix with random values.
+// \ingroup dynamic_matrix
+//
+// \param m The dense matrix to be initialized.
+// \return void
+//
+// This function initializes all elements of the given dense matrix with random values in the
+// range \f$ [0..1) \f$. For more details see the randomize() function with explicit bounds.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline void randomize( DynamicMatrix<Type,SO>& m )
+{
+   randomize( m, Type(0), Type(1) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Initialization of the given dense matrix with random values in the given range.
+// \ingroup dynamic_matrix
+//
+// \param m The dense matrix to be initialized.
+// \param min The smallest possible random value.
+// \param max The upper bound of the random values.
+// \return void
+//
+// This function initializes all elements of the given dense matrix with random values in the
+// range \f$ [min..max) \f$. The values are taken from the random number stream of the calling
+// thread (see the splitStream() function) row by row (in case of a row-major matrix) or column
+// by column (in case of a column-major matrix) and are generated several at a time by means of
+// vectorized operations. The padding elements of the matrix are not modified. In case the total
+// number of elements is equal or higher than the SMP_RANDOMIZE_THRESHOLD, the values are
+// generated in parallel. Independent of the number of threads, the matrix receives the same
+// values. This function can only be used for floating point element types. The attempt to use
+// it with any other element type results in a compilation error.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline void randomize( DynamicMatrix<Type,SO>& m, Type min, Type max )
+{
+   BLAZE_CONSTRAINT_MUST_BE_FLOATING_POINT_TYPE( Type );
+   BLAZE_USER_ASSERT( min <= max, "Invalid min/max value pair" );
+
+   const size_t outer ( ( SO )?( m.columns() ):( m.rows()    ) );
+   const size_t length( ( SO )?( m.rows()    ):( m.columns() ) );
+
+   const DenseRandomizeTask<Type> task( m.data(), length, m.spacing(),
+                                        splitStream<Type>( outer*length ), min, max );
+
+   if( outer*length < SMP_RANDOMIZE_THRESHOLD )
+      task( 0UL, outer );
+   else
+      smpFor( outer, 1UL, task );
+}
+//*************************************************************************************************
+
+
 //*************************************************************************************************
 /*!\brief Returns whether the given dense matrix is in default state.
 // \ingroup dynamic_matrix
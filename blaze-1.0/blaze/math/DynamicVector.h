@@ -41,6 +41,8 @@
 #include <blaze/math/shims/IsDefault.h>
 #include <blaze/math/shims/IsNaN.h>
 #include <blaze/math/shims/Reset.h>
+#include <blaze/math/smp/Randomize.h>
+#include <blaze/math/smp/ThreadBackend.h>
 #include <blaze/math/Types.h>
 #include <blaze/math/typetraits/CanAlias.h>
 #include <blaze/math/typetraits/IsResizable.h>
@@ -48,6 +50,7 @@
 #include <blaze/system/CacheSize.h>
 #include <blaze/system/Precision.h>
 #include <blaze/system/Restrict.h>
+#include <blaze/system/Thresholds.h>
 #include <blaze/system/TransposeFlag.h>
 #include <blaze/util/Assert.h>
 #include <blaze/util/constraints/Builtin.h>
@@ -324,33 +327,39 @@ class DynamicVector : public DenseVector< DynamicVector<Type,TF>, TF >
    template< typename Other > inline bool          isAliased( const Other* alias ) const;
                               inline IntrinsicType get      ( size_t index ) const;
 
+   template< typename VT > inline void assign( const DenseVector<VT,TF>& rhs );
+
    template< typename VT >
    inline typename DisableIf< VectorizedAssign<VT> >::Type
-      assign( const DenseVector<VT,TF>& rhs );
+      assign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end );
 
    template< typename VT >
    inline typename EnableIf< VectorizedAssign<VT> >::Type
-      assign( const DenseVector<VT,TF>& rhs );
+      assign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end );
 
    template< typename VT > inline void assign( const SparseVector<VT,TF>& rhs );
 
+   template< typename VT > inline void addAssign( const DenseVector<VT,TF>& rhs );
+
    template< typename VT >
    inline typename DisableIf< VectorizedAddAssign<VT> >::Type
-      addAssign( const DenseVector<VT,TF>& rhs );
+      addAssign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end );
 
    template< typename VT >
    inline typename EnableIf< VectorizedAddAssign<VT> >::Type
-      addAssign( const DenseVector<VT,TF>& rhs );
+      addAssign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end );
 
    template< typename VT > inline void addAssign( const SparseVector<VT,TF>& rhs );
 
+   template< typename VT > inline void subAssign( const DenseVector<VT,TF>& rhs );
+
    template< typename VT >
    inline typename DisableIf< VectorizedSubAssign<VT> >::Type
-      subAssign( const DenseVector<VT,TF>& rhs );
+      subAssign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end );
 
    template< typename VT >
    inline typename EnableIf< VectorizedSubAssign<VT> >::Type
-      subAssign( const DenseVector<VT,TF>& rhs );
+      subAssign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end );
 
    template< typename VT > inline void subAssign( const SparseVector<VT,TF>& rhs );
 
@@ -1461,9 +1470,40 @@ inline typename DynamicVector<Type,TF>::IntrinsicType
 
 
 //*************************************************************************************************
-/*!\brief Default implementation of the assignment of a dense vector.
+/*!\brief Implementation of the assignment of a dense vector.
+//
+// \param rhs The right-hand side dense vector to be assigned.
+// \return void
+//
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates. Calling this function explicitly might result
+// in erroneous results and/or in compilation errors. Instead of using this function use the
+// assignment operator.
+//
+// In case the size of the vector is equal or higher than the SMP_DVECASSIGN_THRESHOLD, the
+// assignment is executed in parallel (see \ref smp).
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+template< typename VT >  // Type of the right-hand side dense vector
+inline void DynamicVector<Type,TF>::assign( const DenseVector<VT,TF>& rhs )
+{
+   BLAZE_INTERNAL_ASSERT( size_ == (~rhs).size(), "Invalid vector sizes" );
+
+   if( size_ < SMP_DVECASSIGN_THRESHOLD )
+      assign( ~rhs, 0UL, size_ );
+   else
+      smpFor( size_, IT::size, AssignTask<DynamicVector,VT>( *this, ~rhs ) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Default implementation of the assignment of a range of a dense vector.
 //
 // \param rhs The right-hand side dense vector to be assigned.
+// \param begin The index of the first element of the range.
+// \param end The index one past the last element of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -1475,25 +1515,28 @@ template< typename Type  // Data type of the vector
         , bool TF >      // Transpose flag
 template< typename VT >  // Type of the right-hand side dense vector
 inline typename DisableIf< typename DynamicVector<Type,TF>::BLAZE_TEMPLATE VectorizedAssign<VT> >::Type
-   DynamicVector<Type,TF>::assign( const DenseVector<VT,TF>& rhs )
+   DynamicVector<Type,TF>::assign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end )
 {
    BLAZE_INTERNAL_ASSERT( size_ == (~rhs).size(), "Invalid vector sizes" );
+   BLAZE_INTERNAL_ASSERT( begin <= end && end <= size_, "Invalid range" );
 
-   const size_t end( (~rhs).size() & size_t(-2) );
-   for( size_t i=0UL; i<end; i+=2UL ) {
+   const size_t iend( begin + ( ( end - begin ) & size_t(-2) ) );
+   for( size_t i=begin; i<iend; i+=2UL ) {
       v_[i    ] = (~rhs)[i    ];
       v_[i+1UL] = (~rhs)[i+1UL];
    }
-   if( end < (~rhs).size() )
-      v_[end] = (~rhs)[end];
+   if( iend < end )
+      v_[iend] = (~rhs)[iend];
 }
 //*************************************************************************************************
 
 
 //*************************************************************************************************
-/*!\brief Intrinsic optimized implementation of the assignment of a dense vector.
+/*!\brief Intrinsic optimized implementation of the assignment of a range of a dense vector.
 //
 // \param rhs The right-hand side dense vector to be assigned.
+// \param begin The index of the first element of the range.
+// \param end The index one past the last element of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -1505,30 +1548,31 @@ template< typename Type  // Data type of the vector
         , bool TF >      // Transpose flag
 template< typename VT >  // Type of the right-hand side dense vector
 inline typename EnableIf< typename DynamicVector<Type,TF>::BLAZE_TEMPLATE VectorizedAssign<VT> >::Type
-   DynamicVector<Type,TF>::assign( const DenseVector<VT,TF>& rhs )
+   DynamicVector<Type,TF>::assign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end )
 {
    BLAZE_INTERNAL_ASSERT( size_ == (~rhs).size(), "Invalid vector sizes" );
+   BLAZE_INTERNAL_ASSERT( begin <= end && end <= size_, "Invalid range" );
+   BLAZE_INTERNAL_ASSERT( begin % IT::size == 0UL, "Invalid range" );
 
    BLAZE_CONSTRAINT_MUST_BE_VECTORIZABLE_TYPE( Type );
 
    if( size_ > ( cacheSize/( sizeof(Type) * 3UL ) ) && !(~rhs).isAliased( this ) )
    {
-      for( size_t i=0UL; i<size_; i+=IT::size ) {
+      for( size_t i=begin; i<end; i+=IT::size ) {
          stream( v_+i, (~rhs).get(i) );
       }
    }
    else
    {
-      BLAZE_INTERNAL_ASSERT( ( size_ - ( size_ % (IT::size*4UL) ) ) == ( size_ & size_t(-IT::size*4) ), "Invalid end calculation" );
-      const size_t end( size_ & size_t(-IT::size*4) );
+      const size_t iend( begin + ( ( end - begin ) & size_t(-IT::size*4) ) );
 
-      for( size_t i=0UL; i<end; i+=IT::size*4UL ) {
+      for( size_t i=begin; i<iend; i+=IT::size*4UL ) {
          store( v_+i             , (~rhs).get(i             ) );
          store( v_+i+IT::size    , (~rhs).get(i+IT::size    ) );
          store( v_+i+IT::size*2UL, (~rhs).get(i+IT::size*2UL) );
          store( v_+i+IT::size*3UL, (~rhs).get(i+IT::size*3UL) );
       }
-      for( size_t i=end; i<size_; i+=IT::size ) {
+      for( size_t i=iend; i<end; i+=IT::size ) {
          store( v_+i, (~rhs).get(i) );
       }
    }
@@ -1563,9 +1607,40 @@ inline void DynamicVector<Type,TF>::assign( const SparseVector<VT,TF>& rhs )
 
 
 //*************************************************************************************************
-/*!\brief Default implementation of the addition assignment of a dense vector.
+/*!\brief Implementation of the addition assignment of a dense vector.
+//
+// \param rhs The right-hand side dense vector to be added.
+// \return void
+//
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates. Calling this function explicitly might result
+// in erroneous results and/or in compilation errors. Instead of using this function use the
+// assignment operator.
+//
+// In case the size of the vector is equal or higher than the SMP_DVECASSIGN_THRESHOLD, the
+// addition assignment is executed in parallel (see \ref smp).
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+template< typename VT >  // Type of the right-hand side dense vector
+inline void DynamicVector<Type,TF>::addAssign( const DenseVector<VT,TF>& rhs )
+{
+   BLAZE_INTERNAL_ASSERT( size_ == (~rhs).size(), "Invalid vector sizes" );
+
+   if( size_ < SMP_DVECASSIGN_THRESHOLD )
+      addAssign( ~rhs, 0UL, size_ );
+   else
+      smpFor( size_, IT::size, AddAssignTask<DynamicVector,VT>( *this, ~rhs ) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Default implementation of the addition assignment of a range of a dense vector.
 //
 // \param rhs The right-hand side dense vector to be added.
+// \param begin The index of the first element of the range.
+// \param end The index one past the last element of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -1577,25 +1652,29 @@ template< typename Type  // Data type of the vector
         , bool TF >      // Transpose flag
 template< typename VT >  // Type of the right-hand side dense vector
 inline typename DisableIf< typename DynamicVector<Type,TF>::BLAZE_TEMPLATE VectorizedAddAssign<VT> >::Type
-   DynamicVector<Type,TF>::addAssign( const DenseVector<VT,TF>& rhs )
+   DynamicVector<Type,TF>::addAssign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end )
 {
    BLAZE_INTERNAL_ASSERT( size_ == (~rhs).size(), "Invalid vector sizes" );
+   BLAZE_INTERNAL_ASSERT( begin <= end && end <= size_, "Invalid range" );
 
-   const size_t end( (~rhs).size() & size_t(-2) );
-   for( size_t i=0UL; i<end; i+=2UL ) {
+   const size_t iend( begin + ( ( end - begin ) & size_t(-2) ) );
+   for( size_t i=begin; i<iend; i+=2UL ) {
       v_[i    ] += (~rhs)[i    ];
       v_[i+1UL] += (~rhs)[i+1UL];
    }
-   if( end < (~rhs).size() )
-      v_[end] += (~rhs)[end];
+   if( iend < end )
+      v_[iend] += (~rhs)[iend];
 }
 //*************************************************************************************************
 
 
 //*************************************************************************************************
-/*!\brief Intrinsic optimized implementation of the addition assignment of a dense vector.
+/*!\brief Intrinsic optimized implementation of the addition assignment of a range of a dense
+//        vector.
 //
 // \param rhs The right-hand side dense vector to be added.
+// \param begin The index of the first element of the range.
+// \param end The index one past the last element of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -1607,22 +1686,23 @@ template< typename Type  // Data type of the vector
         , bool TF >      // Transpose flag
 template< typename VT >  // Type of the right-hand side dense vector
 inline typename EnableIf< typename DynamicVector<Type,TF>::BLAZE_TEMPLATE VectorizedAddAssign<VT> >::Type
-   DynamicVector<Type,TF>::addAssign( const DenseVector<VT,TF>& rhs )
+   DynamicVector<Type,TF>::addAssign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end )
 {
    BLAZE_INTERNAL_ASSERT( size_ == (~rhs).size(), "Invalid vector sizes" );
+   BLAZE_INTERNAL_ASSERT( begin <= end && end <= size_, "Invalid range" );
+   BLAZE_INTERNAL_ASSERT( begin % IT::size == 0UL, "Invalid range" );
 
    BLAZE_CONSTRAINT_MUST_BE_VECTORIZABLE_TYPE( Type );
 
-   BLAZE_INTERNAL_ASSERT( ( size_ - ( size_ % (IT::size*4UL) ) ) == ( size_ & size_t(-IT::size*4) ), "Invalid end calculation" );
-   const size_t end( size_ & size_t(-IT::size*4) );
+   const size_t iend( begin + ( ( end - begin ) & size_t(-IT::size*4) ) );
 
-   for( size_t i=0UL; i<end; i+=IT::size*4UL ) {
+   for( size_t i=begin; i<iend; i+=IT::size*4UL ) {
       store( v_+i             , load(v_+i             ) + (~rhs).get(i             ) );
       store( v_+i+IT::size    , load(v_+i+IT::size    ) + (~rhs).get(i+IT::size    ) );
       store( v_+i+IT::size*2UL, load(v_+i+IT::size*2UL) + (~rhs).get(i+IT::size*2UL) );
       store( v_+i+IT::size*3UL, load(v_+i+IT::size*3UL) + (~rhs).get(i+IT::size*3UL) );
    }
-   for( size_t i=end; i<size_; i+=IT::size ) {
+   for( size_t i=iend; i<end; i+=IT::size ) {
       store( v_+i, load(v_+i) + (~rhs).get(i) );
    }
 }
@@ -1656,9 +1736,40 @@ inline void DynamicVector<Type,TF>::addAssign( const SparseVector<VT,TF>& rhs )
 
 
 //*************************************************************************************************
-/*!\brief Default implementation of the subtraction assignment of a dense vector.
+/*!\brief Implementation of the subtraction assignment of a dense vector.
+//
+// \param rhs The right-hand side dense vector to be subtracted.
+// \return void
+//
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates. Calling this function explicitly might result
+// in erroneous results and/or in compilation errors. Instead of using this function use the
+// assignment operator.
+//
+// In case the size of the vector is equal or higher than the SMP_DVECASSIGN_THRESHOLD, the
+// subtraction assignment is executed in parallel (see \ref smp).
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+template< typename VT >  // Type of the right-hand side dense vector
+inline void DynamicVector<Type,TF>::subAssign( const DenseVector<VT,TF>& rhs )
+{
+   BLAZE_INTERNAL_ASSERT( size_ == (~rhs).size(), "Invalid vector sizes" );
+
+   if( size_ < SMP_DVECASSIGN_THRESHOLD )
+      subAssign( ~rhs, 0UL, size_ );
+   else
+      smpFor( size_, IT::size, SubAssignTask<DynamicVector,VT>( *this, ~rhs ) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Default implementation of the subtraction assignment of a range of a dense vector.
 //
 // \param rhs The right-hand side dense vector to be subtracted.
+// \param begin The index of the first element of the range.
+// \param end The index one past the last element of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -1670,25 +1781,29 @@ template< typename Type  // Data type of the vector
         , bool TF >      // Transpose flag
 template< typename VT >  // Type of the right-hand side dense vector
 inline typename DisableIf< typename DynamicVector<Type,TF>::BLAZE_TEMPLATE VectorizedSubAssign<VT> >::Type
-   DynamicVector<Type,TF>::subAssign( const DenseVector<VT,TF>& rhs )
+   DynamicVector<Type,TF>::subAssign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end )
 {
    BLAZE_INTERNAL_ASSERT( size_ == (~rhs).size(), "Invalid vector sizes" );
+   BLAZE_INTERNAL_ASSERT( begin <= end && end <= size_, "Invalid range" );
 
-   const size_t end( (~rhs).size() & size_t(-2) );
-   for( size_t i=0UL; i<end; i+=2UL ) {
+   const size_t iend( begin + ( ( end - begin ) & size_t(-2) ) );
+   for( size_t i=begin; i<iend; i+=2UL ) {
       v_[i    ] -= (~rhs)[i    ];
       v_[i+1UL] -= (~rhs)[i+1UL];
    }
-   if( end < (~rhs).size() )
-      v_[end] -= (~rhs)[end];
+   if( iend < end )
+      v_[iend] -= (~rhs)[iend];
 }
 //*************************************************************************************************
 
 
 //*************************************************************************************************
-/*!\brief Intrinsic optimized implementation of the subtraction assignment of a dense vector.
+/*!\brief Intrinsic optimized implementation of the subtraction assignment of a range of a dense
+//        vector.
 //
 // \param rhs The right-hand side dense vector to be subtracted.
+// \param begin The index of the first element of the range.
+// \param end The index one past the last element of the range.
 // \return void
 //
 // This function must \b NOT be called explicitly! It is used internally for the performance
@@ -1700,22 +1815,23 @@ template< typename Type  // Data type of the vector
         , bool TF >      // Transpose flag
 template< typename VT >  // Type of the right-hand side dense vector
 inline typename EnableIf< typename DynamicVector<Type,TF>::BLAZE_TEMPLATE VectorizedSubAssign<VT> >::Type
-   DynamicVector<Type,TF>::subAssign( const DenseVector<VT,TF>& rhs )
+   DynamicVector<Type,TF>::subAssign( const DenseVector<VT,TF>& rhs, size_t begin, size_t end )
 {
    BLAZE_INTERNAL_ASSERT( size_ == (~rhs).size(), "Invalid vector sizes" );
+   BLAZE_INTERNAL_ASSERT( begin <= end && end <= size_, "Invalid range" );
+   BLAZE_INTERNAL_ASSERT( begin % IT::size == 0UL, "Invalid range" );
 
    BLAZE_CONSTRAINT_MUST_BE_VECTORIZABLE_TYPE( Type );
 
-   BLAZE_INTERNAL_ASSERT( ( size_ - ( size_ % (IT::size*4UL) ) ) == ( size_ & size_t(-IT::size*4) ), "Invalid end calculation" );
-   const size_t end( size_ & size_t(-IT::size*4) );
+   const size_t iend( begin + ( ( end - begin ) & size_t(-IT::size*4) ) );
 
-   for( size_t i=0UL; i<end; i+=IT::size*4UL ) {
+   for( size_t i=begin; i<iend; i+=IT::size*4UL ) {
       store( v_+i             , load(v_+i             ) - (~rhs).get(i             ) );
       store( v_+i+IT::size    , load(v_+i+IT::size    ) - (~rhs).get(i+IT::size    ) );
       store( v_+i+IT::size*2UL, load(v_+i+IT::size*2UL) - (~rhs).get(i+IT::size*2UL) );
       store( v_+i+IT::size*3UL, load(v_+i+IT::size*3UL) - (~rhs).get(i+IT::size*3UL) );
    }
-   for( size_t i=end; i<size_; i+=IT::size ) {
+   for( size_t i=iend; i<end; i+=IT::size ) {
       store( v_+i, load(v_+i) - (~rhs).get(i) );
    }
 }
@@ -1863,6 +1979,12 @@ inline void reset( DynamicVector<Type,TF>& v );
 template< typename Type, bool TF >
 inline void clear( DynamicVector<Type,TF>& v );
 
+template< typename Type, bool TF >
+inline void randomize( DynamicVector<Type,TF>& v );
+
+template< typename Type, bool TF >
+inline void randomize( DynamicVector<Type,TF>& v, Type min, Type max );
+
 template< typename Type, bool TF >
 inline bool isnan( const DynamicVector<Type,TF>& v );
 
@@ -1911,6 +2033,61 @@ inline void clear( DynamicVector<Type,TF>& v )
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Initialization of the given dynamic vector with random values.
+// \ingroup dense_vector_N
+//
+// \param v The dynamic vector to be initialized.
+// \return void
+//
+// This function initializes all elements of the given dynamic vector with random values in the
+// range \f$ [0..1) \f$. For more details see the randomize() function with explicit bounds.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline void randomize( DynamicVector<Type,TF>& v )
+{
+   randomize( v, Type(0), Type(1) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Initialization of the given dynamic vector with random values in the given range.
+// \ingroup dense_vector_N
+//
+// \param v The dynamic vector to be initialized.
+// \param min The smallest possible random value.
+// \param max The upper bound of the random values.
+// \return void
+//
+// This function initializes all elements of the given dynamic vector with random values in the
+// range \f$ [min..max) \f$. The values are taken from the random number stream of the calling
+// thread (see the splitStream() function) and are generated several at a time by means of
+// vectorized operations. In case the size of the vector is equal or higher than the
+// SMP_RANDOMIZE_THRESHOLD, the values are generated in parallel. Independent of the number of
+// threads, the vector receives the same values. This function can only be used for floating
+// point element types. The attempt to use it with any other element type results in a
+// compilation error.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline void randomize( DynamicVector<Type,TF>& v, Type min, Type max )
+{
+   BLAZE_CONSTRAINT_MUST_BE_FLOATING_POINT_TYPE( Type );
+   BLAZE_USER_ASSERT( min <= max, "Invalid min/max value pair" );
+
+   const size_t n( v.size() );
+   const DenseRandomizeTask<Type> task( v.data(), 1UL, 1UL, splitStream<Type>( n ), min, max );
+
+   if( n < SMP_RANDOMIZE_THRESHOLD )
+      task( 0UL, n );
+   else
+      smpFor( n, IntrinsicTrait<Type>::size, task );
+}
+//*************************************************************************************************
+
+
 //*************************************************************************************************
 /*!\brief Checks the given dynamic vector for not-a-number elements.
 // \ingroup dense_vector_N
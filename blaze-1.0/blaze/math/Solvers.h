@@ -27,9 +27,12 @@
 // Includes
 //*************************************************************************************************
 
+#include <blaze/math/solvers/BlockJacobiPreconditioner.h>
 #include <blaze/math/solvers/CG.h>
 #include <blaze/math/solvers/CPG.h>
 #include <blaze/math/solvers/GaussianElimination.h>
+#include <blaze/math/solvers/IC0Preconditioner.h>
+#include <blaze/math/solvers/JacobiPreconditioner.h>
 #include <blaze/math/solvers/Lemke.h>
 #include <blaze/math/solvers/PGS.h>
 
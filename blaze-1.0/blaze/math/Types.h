@@ -33,6 +33,7 @@ namespace blaze {
 
 template< typename, bool > class CompressedMatrix;
 template< typename, bool > class CompressedVector;
+template< typename > class CSRMatrix;
 template< typename, bool > class DynamicVector;
 template< typename, bool > class DynamicMatrix;
 template< typename > class Quaternion;
@@ -0,0 +1,381 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/dense/Gemm.h
+//  \brief Header file for the blocked dense matrix/dense matrix multiplication kernel
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_DENSE_GEMM_H_
+#define _BLAZE_MATH_DENSE_GEMM_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/Intrinsics.h>
+#include <blaze/math/shims/IsDefault.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/math/typetraits/IsRowMajorMatrix.h>
+#include <blaze/system/CacheSize.h>
+#include <blaze/system/Restrict.h>
+#include <blaze/system/Thresholds.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Memory.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS GEMMKERNEL
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Implementation of the blocked dense matrix/dense matrix multiplication.
+// \ingroup dense_matrix
+//
+// The GemmKernel class implements the packed, cache-blocked matrix multiplication scheme of
+// high performance BLAS libraries for all element types with intrinsic addition and
+// multiplication. The multiplication is split into blocks of \a KC columns of \a A and rows of
+// \a B: each \a KC x \a NC panel of \a B is packed into a contiguous, aligned buffer sized for
+// the cache, and each \a MC x \a KC panel of \a A into a buffer sized for a half of the L2 cache.
+// The packed panels are traversed by a register-tiled micro-kernel, which computes a \a MR x
+// \a NR tile of the result in intrinsic registers. Due to the packing, the kernel only accesses
+// the operands via their function call operator and can be used for any storage order.
+*/
+template< typename Type >  // Element type of the matrices
+struct GemmKernel
+{
+   //**Type definitions****************************************************************************
+   typedef IntrinsicTrait<Type>         IT;             //!< Intrinsic trait for the element type.
+   typedef typename IT::Type            IntrinsicType;  //!< Intrinsic type of the elements.
+   //**********************************************************************************************
+
+   //**Blocking parameters*************************************************************************
+   enum { MR = 4UL };                   //!< Number of rows of the register tile.
+   enum { NR = IT::size * 2UL };        //!< Number of columns of the register tile.
+   enum { KC = 256UL };                 //!< Depth of the packed panels.
+
+   //! Number of rows of the packed panel of the left-hand side operand.
+   enum { MC = ( ( 131072UL / ( KC * sizeof(Type) ) ) / MR ) * MR };
+
+   //! Number of columns of the packed panel of the right-hand side operand.
+   enum { NC = ( ( cacheSize / ( 2UL * KC * sizeof(Type) ) ) / NR ) * NR };
+   //**********************************************************************************************
+
+   //**Packing functions***************************************************************************
+   /*!\brief Packing of a \a mc x \a kc panel of the left-hand side operand.
+   //
+   // \param A The left-hand side operand.
+   // \param ic The first row of the panel.
+   // \param pc The first column of the panel.
+   // \param mc The number of rows of the panel.
+   // \param kc The number of columns of the panel.
+   // \param buffer The target buffer of \f$ \lceil mc/MR \rceil \cdot MR \cdot kc \f$ elements.
+   // \return void
+   //
+   // The panel is stored as consecutive slices of \a MR rows, each of them column by column.
+   // The rows beyond the end of the panel are padded with zeros.
+   */
+   template< typename MT >  // Type of the left-hand side operand
+   static void packLhs( const MT& A, size_t ic, size_t pc, size_t mc, size_t kc, Type* buffer )
+   {
+      for( size_t ir=0UL; ir<mc; ir+=MR ) {
+         const size_t mr( std::min<size_t>( MR, mc-ir ) );
+         Type* BLAZE_RESTRICT slice( buffer + ir*kc );
+         if( IsRowMajorMatrix<MT>::value ) {
+            for( size_t r=0UL; r<mr; ++r )
+               for( size_t k=0UL; k<kc; ++k )
+                  slice[k*MR+r] = A(ic+ir+r,pc+k);
+         }
+         else {
+            for( size_t k=0UL; k<kc; ++k )
+               for( size_t r=0UL; r<mr; ++r )
+                  slice[k*MR+r] = A(ic+ir+r,pc+k);
+         }
+         for( size_t r=mr; r<MR; ++r )
+            for( size_t k=0UL; k<kc; ++k )
+               slice[k*MR+r] = Type();
+      }
+   }
+
+   /*!\brief Packing of a \a kc x \a nc panel of the right-hand side operand.
+   //
+   // \param B The right-hand side operand.
+   // \param pc The first row of the panel.
+   // \param jc The first column of the panel.
+   // \param kc The number of rows of the panel.
+   // \param nc The number of columns of the panel.
+   // \param buffer The target buffer of \f$ kc \cdot \lceil nc/NR \rceil \cdot NR \f$ elements.
+   // \return void
+   //
+   // The panel is stored as consecutive slices of \a NR columns, each of them row by row.
+   // The columns beyond the end of the panel are padded with zeros.
+   */
+   template< typename MT >  // Type of the right-hand side operand
+   static void packRhs( const MT& B, size_t pc, size_t jc, size_t kc, size_t nc, Type* buffer )
+   {
+      for( size_t jr=0UL; jr<nc; jr+=NR ) {
+         const size_t nr( std::min<size_t>( NR, nc-jr ) );
+         Type* BLAZE_RESTRICT slice( buffer + jr*kc );
+         if( IsRowMajorMatrix<MT>::value ) {
+            for( size_t k=0UL; k<kc; ++k )
+               for( size_t c=0UL; c<nr; ++c )
+                  slice[k*NR+c] = B(pc+k,jc+jr+c);
+         }
+         else {
+            for( size_t c=0UL; c<nr; ++c )
+               for( size_t k=0UL; k<kc; ++k )
+                  slice[k*NR+c] = B(pc+k,jc+jr+c);
+         }
+         for( size_t k=0UL; k<kc; ++k )
+            for( size_t c=nr; c<NR; ++c )
+               slice[k*NR+c] = Type();
+      }
+   }
+   //**********************************************************************************************
+
+   //**Micro-kernel********************************************************************************
+   /*!\brief Computation of a \a MR x \a NR tile from a slice of both packed panels.
+   //
+   // \param kc The depth of the slices.
+   // \param a The slice of the packed left-hand side panel.
+   // \param b The slice of the packed right-hand side panel.
+   // \param tile The aligned target tile of \a MR x \a NR elements, stored row by row.
+   // \return void
+   */
+   static void micro( size_t kc, const Type* BLAZE_RESTRICT a, const Type* BLAZE_RESTRICT b, Type* tile )
+   {
+      IntrinsicType xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7, xmm8;
+
+      for( size_t k=0UL; k<kc; ++k ) {
+         const IntrinsicType b1( load( b          ) );
+         const IntrinsicType b2( load( b+IT::size ) );
+         const IntrinsicType a1( set( a[0] ) );
+         const IntrinsicType a2( set( a[1] ) );
+         const IntrinsicType a3( set( a[2] ) );
+         const IntrinsicType a4( set( a[3] ) );
+         xmm1 = xmm1 + a1 * b1;
+         xmm2 = xmm2 + a1 * b2;
+         xmm3 = xmm3 + a2 * b1;
+         xmm4 = xmm4 + a2 * b2;
+         xmm5 = xmm5 + a3 * b1;
+         xmm6 = xmm6 + a3 * b2;
+         xmm7 = xmm7 + a4 * b1;
+         xmm8 = xmm8 + a4 * b2;
+         a += MR;
+         b += NR;
+      }
+
+      store( tile                    , xmm1 );
+      store( tile+IT::size           , xmm2 );
+      store( tile+NR                 , xmm3 );
+      store( tile+NR+IT::size        , xmm4 );
+      store( tile+NR*2UL             , xmm5 );
+      store( tile+NR*2UL+IT::size    , xmm6 );
+      store( tile+NR*3UL             , xmm7 );
+      store( tile+NR*3UL+IT::size    , xmm8 );
+   }
+   //**********************************************************************************************
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  GEMM FUNCTION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Blocked dense matrix/dense matrix multiplication for a block of the target matrix.
+// \ingroup dense_matrix
+//
+// \param C The target left-hand side dense matrix.
+// \param A The left-hand side multiplication operand.
+// \param B The right-hand side multiplication operand.
+// \param alpha The scaling factor of the product.
+// \param beta The scaling factor of the target matrix.
+// \param ibegin The first row of the block.
+// \param iend The end of the row range of the block.
+// \param jbegin The first column of the block.
+// \param jend The end of the column range of the block.
+// \return void
+//
+// This function computes the rows \f$ [ibegin..iend) \f$ and columns \f$ [jbegin..jend) \f$
+// of \f$ C=\alpha A*B+\beta C \f$ for operands with at least one column of \a A. All packing
+// buffers are local to the function call, i.e. disjoint blocks can be computed concurrently.
+*/
+template< typename MT1  // Type of the target dense matrix
+        , typename MT2  // Type of the left-hand side matrix operand
+        , typename MT3  // Type of the right-hand side matrix operand
+        , typename ST1  // Type of the scaling factor of the product
+        , typename ST2 > // Type of the scaling factor of the target matrix
+void gemmBlock( MT1& C, const MT2& A, const MT3& B, ST1 alpha, ST2 beta,
+                size_t ibegin, size_t iend, size_t jbegin, size_t jend )
+{
+   typedef typename MT1::ElementType  ET;
+   typedef GemmKernel<ET>             Kernel;
+
+   BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= C.rows()   , "Invalid row range"    );
+   BLAZE_INTERNAL_ASSERT( jbegin <= jend && jend <= C.columns(), "Invalid column range" );
+   BLAZE_INTERNAL_ASSERT( A.columns() > 0UL, "Invalid number of columns" );
+
+   const size_t M( iend - ibegin );
+   const size_t N( jend - jbegin );
+   const size_t K( A.columns() );
+
+   if( M == 0UL || N == 0UL ) return;
+
+   const bool overwrite( isDefault( beta ) );
+
+   const size_t mcmax( std::min<size_t>( Kernel::MC, ( ( M + Kernel::MR - 1UL ) / Kernel::MR ) * Kernel::MR ) );
+   const size_t ncmax( std::min<size_t>( Kernel::NC, ( ( N + Kernel::NR - 1UL ) / Kernel::NR ) * Kernel::NR ) );
+   const size_t kcmax( std::min<size_t>( Kernel::KC, K ) );
+
+   ET* packedA( allocate<ET>( mcmax*kcmax ) );
+   ET* packedB( allocate<ET>( kcmax*ncmax ) );
+   ET* tile   ( allocate<ET>( Kernel::MR*Kernel::NR ) );
+
+   for( size_t jc=jbegin; jc<jend; jc+=Kernel::NC )
+   {
+      const size_t nc( std::min<size_t>( Kernel::NC, jend-jc ) );
+
+      for( size_t pc=0UL; pc<K; pc+=Kernel::KC )
+      {
+         const size_t kc( std::min<size_t>( Kernel::KC, K-pc ) );
+         const bool first( pc == 0UL );
+
+         Kernel::packRhs( B, pc, jc, kc, nc, packedB );
+
+         for( size_t ic=ibegin; ic<iend; ic+=Kernel::MC )
+         {
+            const size_t mc( std::min<size_t>( Kernel::MC, iend-ic ) );
+
+            Kernel::packLhs( A, ic, pc, mc, kc, packedA );
+
+            for( size_t jr=0UL; jr<nc; jr+=Kernel::NR ) {
+               const size_t nr( std::min<size_t>( Kernel::NR, nc-jr ) );
+               for( size_t ir=0UL; ir<mc; ir+=Kernel::MR )
+               {
+                  const size_t mr( std::min<size_t>( Kernel::MR, mc-ir ) );
+
+                  Kernel::micro( kc, packedA+ir*kc, packedB+jr*kc, tile );
+
+                  for( size_t r=0UL; r<mr; ++r ) {
+                     for( size_t c=0UL; c<nr; ++c ) {
+                        ET& value( C(ic+ir+r,jc+jr+c) );
+                        if( !first )
+                           value += alpha * tile[r*Kernel::NR+c];
+                        else if( overwrite )
+                           value = alpha * tile[r*Kernel::NR+c];
+                        else
+                           value = beta * value + alpha * tile[r*Kernel::NR+c];
+                     }
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   deallocate( packedA );
+   deallocate( packedB );
+   deallocate( tile );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Blocked dense matrix/dense matrix multiplication (\f$ C=\alpha A*B+\beta C \f$).
+// \ingroup dense_matrix
+//
+// \param C The target left-hand side dense matrix.
+// \param A The left-hand side multiplication operand.
+// \param B The right-hand side multiplication operand.
+// \param alpha The scaling factor of the product.
+// \param beta The scaling factor of the target matrix.
+// \return void
+//
+// This function is the native counterpart of the BLAS gemm() function for all element types
+// with intrinsic addition and multiplication (see GemmKernel). It is used by the dense matrix
+// multiplication expressions for large matrices in case no BLAS kernel is available. In case
+// \a beta is zero, the initial values of \a C are not read. In case the number of elements of
+// \a C exceeds the SMP_DMATDMATMULT_THRESHOLD, the larger dimension of \a C is partitioned
+// into one block per thread and the blocks are computed in parallel (see \ref smp).
+*/
+template< typename MT1  // Type of the target dense matrix
+        , bool SO       // Storage order of the target dense matrix
+        , typename MT2  // Type of the left-hand side matrix operand
+        , typename MT3  // Type of the right-hand side matrix operand
+        , typename ST1  // Type of the scaling factor of the product
+        , typename ST2 > // Type of the scaling factor of the target matrix
+void gemm( DenseMatrix<MT1,SO>& C, const MT2& A, const MT3& B, ST1 alpha, ST2 beta )
+{
+   typedef typename MT1::ElementType  ET;
+   typedef GemmKernel<ET>             Kernel;
+
+   BLAZE_INTERNAL_ASSERT( A.columns() == B.rows()      , "Invalid matrix sizes"      );
+   BLAZE_INTERNAL_ASSERT( A.rows()    == (~C).rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( B.columns() == (~C).columns(), "Invalid number of columns" );
+
+   const size_t M( A.rows()    );
+   const size_t N( B.columns() );
+   const size_t K( A.columns() );
+
+   if( K == 0UL ) {
+      const bool overwrite( isDefault( beta ) );
+      for( size_t i=0UL; i<M; ++i )
+         for( size_t j=0UL; j<N; ++j )
+            (~C)(i,j) = ( overwrite )?( ET() ):( beta * (~C)(i,j) );
+      return;
+   }
+
+   if( M*N < SMP_DMATDMATMULT_THRESHOLD ) {
+      gemmBlock( ~C, A, B, alpha, beta, 0UL, M, 0UL, N );
+   }
+   else if( M >= N ) {
+      smpFor( M, Kernel::MR, boost::bind( &gemmBlock<MT1,MT2,MT3,ST1,ST2>, boost::ref( ~C ),
+                                          boost::cref( A ), boost::cref( B ), alpha, beta,
+                                          _1, _2, 0UL, N ) );
+   }
+   else {
+      smpFor( N, Kernel::NR, boost::bind( &gemmBlock<MT1,MT2,MT3,ST1,ST2>, boost::ref( ~C ),
+                                          boost::cref( A ), boost::cref( B ), alpha, beta,
+                                          0UL, M, _1, _2 ) );
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -34,6 +34,7 @@
 #include <blaze/math/constraints/SparseVector.h>
 #include <blaze/math/constraints/StorageOrder.h>
 #include <blaze/math/constraints/TransposeFlag.h>
+#include <blaze/math/dense/Gemm.h>
 #include <blaze/math/Expression.h>
 #include <blaze/math/expressions/DenseMatrix.h>
 #include <blaze/math/expressions/DenseVector.h>
@@ -606,7 +607,7 @@ class DMatDMatMultExpr : public DenseMatrix< DMatDMatMultExpr<MT1,MT2>, false >
    // \param B The right-hand side multiplication operand.
    // \return void
    //
-   // This function relays to the default implementation of the assignment of a dense matrix-
+   // This function relays to the blocked implementation of the assignment of a dense matrix-
    // dense matrix multiplication expression to a dense matrix.
    */
    template< typename MT3    // Type of the left-hand side target matrix
@@ -614,12 +615,60 @@ class DMatDMatMultExpr : public DenseMatrix< DMatDMatMultExpr<MT1,MT2>, false >
            , typename MT5 >  // Type of the right-hand side matrix operand
    static inline typename EnableIf< UseDefaultKernel<MT3,MT4,MT5> >::Type
       selectBlasAssignKernel( MT3& C, const MT4& A, const MT5& B )
+   {
+      selectBlockedAssignKernel( C, A, B );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Blocked assignment to dense matrices********************************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Blocked assignment of a dense matrix-dense matrix multiplication (\f$ C=A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \return void
+   //
+   // This function relays to the default implementation in case the element types of the
+   // operands are not suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5 >  // Type of the right-hand side matrix operand
+   static inline typename DisableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5> >::Type
+      selectBlockedAssignKernel( MT3& C, const MT4& A, const MT5& B )
    {
       selectDefaultAssignKernel( C, A, B );
    }
    /*! \endcond */
    //**********************************************************************************************
 
+   //**Vectorized blocked assignment to dense matrices*********************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Vectorized blocked assignment of a dense matrix-dense matrix multiplication (\f$ C=A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \return void
+   //
+   // This function relays to the packed, cache-blocked gemm() kernel in case the element types
+   // of the operands are suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5 >  // Type of the right-hand side matrix operand
+   static inline typename EnableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5> >::Type
+      selectBlockedAssignKernel( MT3& C, const MT4& A, const MT5& B )
+   {
+      gemm( C, A, B, ElementType(1), ElementType(0) );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
    //**BLAS-based assignment to dense matrices (single precision)**********************************
 #if BLAZE_BLAS_MODE
    /*! \cond BLAZE_INTERNAL */
@@ -1146,7 +1195,7 @@ class DMatDMatMultExpr : public DenseMatrix< DMatDMatMultExpr<MT1,MT2>, false >
    // \param B The right-hand side multiplication operand.
    // \return void
    //
-   // This function relays to the default implementation of the addition assignment of a dense
+   // This function relays to the blocked implementation of the addition assignment of a dense
    // matrix-dense matrix multiplication expression to a dense matrix.
    */
    template< typename MT3    // Type of the left-hand side target matrix
@@ -1154,12 +1203,62 @@ class DMatDMatMultExpr : public DenseMatrix< DMatDMatMultExpr<MT1,MT2>, false >
            , typename MT5 >  // Type of the right-hand side matrix operand
    static inline typename EnableIf< UseDefaultKernel<MT3,MT4,MT5> >::Type
       selectBlasAddAssignKernel( MT3& C, const MT4& A, const MT5& B )
+   {
+      selectBlockedAddAssignKernel( C, A, B );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Blocked addition assignment to dense matrices***********************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Blocked addition assignment of a dense matrix-dense matrix multiplication
+   //        (\f$ C+=A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \return void
+   //
+   // This function relays to the default implementation in case the element types of the
+   // operands are not suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5 >  // Type of the right-hand side matrix operand
+   static inline typename DisableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5> >::Type
+      selectBlockedAddAssignKernel( MT3& C, const MT4& A, const MT5& B )
    {
       selectDefaultAddAssignKernel( C, A, B );
    }
    /*! \endcond */
    //**********************************************************************************************
 
+   //**Vectorized blocked addition assignment to dense matrices************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Vectorized blocked addition assignment of a dense matrix-dense matrix multiplication
+   //        (\f$ C+=A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \return void
+   //
+   // This function relays to the packed, cache-blocked gemm() kernel in case the element types
+   // of the operands are suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5 >  // Type of the right-hand side matrix operand
+   static inline typename EnableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5> >::Type
+      selectBlockedAddAssignKernel( MT3& C, const MT4& A, const MT5& B )
+   {
+      gemm( C, A, B, ElementType(1), ElementType(1) );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
    //**BLAS-based addition assignment to dense matrices (single precision)*************************
 #if BLAZE_BLAS_MODE
    /*! \cond BLAZE_INTERNAL */
@@ -1656,7 +1755,7 @@ class DMatDMatMultExpr : public DenseMatrix< DMatDMatMultExpr<MT1,MT2>, false >
    // \param B The right-hand side multiplication operand.
    // \return void
    //
-   // This function relays to the default implementation of the subtraction assignment of a dense
+   // This function relays to the blocked implementation of the subtraction assignment of a dense
    // matrix-dense matrix multiplication expression to a dense matrix.
    */
    template< typename MT3    // Type of the left-hand side target matrix
@@ -1664,12 +1763,62 @@ class DMatDMatMultExpr : public DenseMatrix< DMatDMatMultExpr<MT1,MT2>, false >
            , typename MT5 >  // Type of the right-hand side matrix operand
    static inline typename EnableIf< UseDefaultKernel<MT3,MT4,MT5> >::Type
       selectBlasSubAssignKernel( MT3& C, const MT4& A, const MT5& B )
+   {
+      selectBlockedSubAssignKernel( C, A, B );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Blocked subtraction assignment to dense matrices********************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Blocked subtraction assignment of a dense matrix-dense matrix multiplication
+   //        (\f$ C-=A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \return void
+   //
+   // This function relays to the default implementation in case the element types of the
+   // operands are not suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5 >  // Type of the right-hand side matrix operand
+   static inline typename DisableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5> >::Type
+      selectBlockedSubAssignKernel( MT3& C, const MT4& A, const MT5& B )
    {
       selectDefaultSubAssignKernel( C, A, B );
    }
    /*! \endcond */
    //**********************************************************************************************
 
+   //**Vectorized blocked subtraction assignment to dense matrices*********************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Vectorized blocked subtraction assignment of a dense matrix-dense matrix multiplication
+   //        (\f$ C-=A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \return void
+   //
+   // This function relays to the packed, cache-blocked gemm() kernel in case the element types
+   // of the operands are suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5 >  // Type of the right-hand side matrix operand
+   static inline typename EnableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5> >::Type
+      selectBlockedSubAssignKernel( MT3& C, const MT4& A, const MT5& B )
+   {
+      gemm( C, A, B, ElementType(-1), ElementType(1) );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
    //**BLAS-based subraction assignment to dense matrices (single precision)***********************
 #if BLAZE_BLAS_MODE
    /*! \cond BLAZE_INTERNAL */
@@ -2399,7 +2548,7 @@ class DMatScalarMultExpr< DMatDMatMultExpr<MT1,MT2>, ST, false >
    // \param scalar The scaling factor.
    // \return void
    //
-   // This function relays to the default implementation of the assignment of a scaled dense
+   // This function relays to the blocked implementation of the assignment of a scaled dense
    // matrix-dense matrix multiplication expression to a dense matrix.
    */
    template< typename MT3    // Type of the left-hand side target matrix
@@ -2408,11 +2557,61 @@ class DMatScalarMultExpr< DMatDMatMultExpr<MT1,MT2>, ST, false >
            , typename ST2 >  // Type of the scalar value
    static inline typename EnableIf< UseDefaultKernel<MT3,MT4,MT5,ST2> >::Type
       selectBlasAssignKernel( MT3& C, const MT4& A, const MT5& B, ST2 scalar )
+   {
+      selectBlockedAssignKernel( C, A, B, scalar );
+   }
+   //**********************************************************************************************
+
+   //**Blocked assignment to dense matrices********************************************************
+   /*!\brief Blocked assignment of a scaled dense matrix-dense matrix multiplication
+   //        (\f$ C=s*A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \param scalar The scaling factor.
+   // \return void
+   //
+   // This function relays to the default implementation in case the element types of the
+   // operands are not suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5    // Type of the right-hand side matrix operand
+           , typename ST2 >  // Type of the scalar value
+   static inline typename DisableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5,ST2> >::Type
+      selectBlockedAssignKernel( MT3& C, const MT4& A, const MT5& B, ST2 scalar )
    {
       selectDefaultAssignKernel( C, A, B, scalar );
    }
    //**********************************************************************************************
 
+   //**Vectorized blocked assignment to dense matrices*********************************************
+   /*!\brief Vectorized blocked assignment of a scaled dense matrix-dense matrix multiplication
+   //        (\f$ C=s*A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \param scalar The scaling factor.
+   // \return void
+   //
+   // This function relays to the packed, cache-blocked gemm() kernel in case the element types
+   // of the operands are suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5    // Type of the right-hand side matrix operand
+           , typename ST2 >  // Type of the scalar value
+   static inline typename EnableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5,ST2> >::Type
+      selectBlockedAssignKernel( MT3& C, const MT4& A, const MT5& B, ST2 scalar )
+   {
+      gemm( C, A, B, scalar, ElementType(0) );
+   }
+   //**********************************************************************************************
+
    //**BLAS-based assignment to dense matrices (single precision)**********************************
 #if BLAZE_BLAS_MODE
    /*!\brief BLAS-based assignment of a scaled dense matrix-dense matrix multiplication for
@@ -2904,7 +3103,7 @@ class DMatScalarMultExpr< DMatDMatMultExpr<MT1,MT2>, ST, false >
    // \param scalar The scaling factor.
    // \return void
    //
-   // This function relays to the default implementation of the addition assignment of a scaled
+   // This function relays to the blocked implementation of the addition assignment of a scaled
    // dense matrix-dense matrix multiplication expression to a dense matrix.
    */
    template< typename MT3    // Type of the left-hand side target matrix
@@ -2913,11 +3112,61 @@ class DMatScalarMultExpr< DMatDMatMultExpr<MT1,MT2>, ST, false >
            , typename ST2 >  // Type of the scalar value
    static inline typename EnableIf< UseDefaultKernel<MT3,MT4,MT5,ST2> >::Type
       selectBlasAddAssignKernel( MT3& C, const MT4& A, const MT5& B, ST2 scalar )
+   {
+      selectBlockedAddAssignKernel( C, A, B, scalar );
+   }
+   //**********************************************************************************************
+
+   //**Blocked addition assignment to dense matrices***********************************************
+   /*!\brief Blocked addition assignment of a scaled dense matrix-dense matrix multiplication
+   //        (\f$ C+=s*A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \param scalar The scaling factor.
+   // \return void
+   //
+   // This function relays to the default implementation in case the element types of the
+   // operands are not suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5    // Type of the right-hand side matrix operand
+           , typename ST2 >  // Type of the scalar value
+   static inline typename DisableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5,ST2> >::Type
+      selectBlockedAddAssignKernel( MT3& C, const MT4& A, const MT5& B, ST2 scalar )
    {
       selectDefaultAddAssignKernel( C, A, B, scalar );
    }
    //**********************************************************************************************
 
+   //**Vectorized blocked addition assignment to dense matrices************************************
+   /*!\brief Vectorized blocked addition assignment of a scaled dense matrix-dense matrix multiplication
+   //        (\f$ C+=s*A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \param scalar The scaling factor.
+   // \return void
+   //
+   // This function relays to the packed, cache-blocked gemm() kernel in case the element types
+   // of the operands are suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5    // Type of the right-hand side matrix operand
+           , typename ST2 >  // Type of the scalar value
+   static inline typename EnableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5,ST2> >::Type
+      selectBlockedAddAssignKernel( MT3& C, const MT4& A, const MT5& B, ST2 scalar )
+   {
+      gemm( C, A, B, scalar, ElementType(1) );
+   }
+   //**********************************************************************************************
+
    //**BLAS-based addition assignment to dense matrices (single precision)*************************
 #if BLAZE_BLAS_MODE
    /*!\brief BLAS-based addition assignment of a scaled dense matrix-dense matrix multiplication
@@ -3381,7 +3630,7 @@ class DMatScalarMultExpr< DMatDMatMultExpr<MT1,MT2>, ST, false >
    // \param scalar The scaling factor.
    // \return void
    //
-   // This function relays to the default implementation of the subtraction assignment of a scaled
+   // This function relays to the blocked implementation of the subtraction assignment of a scaled
    // dense matrix-dense matrix multiplication expression to a dense matrix.
    */
    template< typename MT3    // Type of the left-hand side target matrix
@@ -3390,11 +3639,61 @@ class DMatScalarMultExpr< DMatDMatMultExpr<MT1,MT2>, ST, false >
            , typename ST2 >  // Type of the scalar value
    static inline typename EnableIf< UseDefaultKernel<MT3,MT4,MT5,ST2> >::Type
       selectBlasSubAssignKernel( MT3& C, const MT4& A, const MT5& B, ST2 scalar )
+   {
+      selectBlockedSubAssignKernel( C, A, B, scalar );
+   }
+   //**********************************************************************************************
+
+   //**Blocked subtraction assignment to dense matrices********************************************
+   /*!\brief Blocked subtraction assignment of a scaled dense matrix-dense matrix multiplication
+   //        (\f$ C-=s*A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \param scalar The scaling factor.
+   // \return void
+   //
+   // This function relays to the default implementation in case the element types of the
+   // operands are not suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5    // Type of the right-hand side matrix operand
+           , typename ST2 >  // Type of the scalar value
+   static inline typename DisableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5,ST2> >::Type
+      selectBlockedSubAssignKernel( MT3& C, const MT4& A, const MT5& B, ST2 scalar )
    {
       selectDefaultSubAssignKernel( C, A, B, scalar );
    }
    //**********************************************************************************************
 
+   //**Vectorized blocked subtraction assignment to dense matrices*********************************
+   /*!\brief Vectorized blocked subtraction assignment of a scaled dense matrix-dense matrix multiplication
+   //        (\f$ C-=s*A*B \f$).
+   // \ingroup dense_matrix
+   //
+   // \param C The target left-hand side dense matrix.
+   // \param A The left-hand side multiplication operand.
+   // \param B The right-hand side multiplication operand.
+   // \param scalar The scaling factor.
+   // \return void
+   //
+   // This function relays to the packed, cache-blocked gemm() kernel in case the element types
+   // of the operands are suited for a vectorized computation.
+   */
+   template< typename MT3    // Type of the left-hand side target matrix
+           , typename MT4    // Type of the left-hand side matrix operand
+           , typename MT5    // Type of the right-hand side matrix operand
+           , typename ST2 >  // Type of the scalar value
+   static inline typename EnableIf< UseVectorizedDefaultKernel<MT3,MT4,MT5,ST2> >::Type
+      selectBlockedSubAssignKernel( MT3& C, const MT4& A, const MT5& B, ST2 scalar )
+   {
+      gemm( C, A, B, -scalar, ElementType(1) );
+   }
+   //**********************************************************************************************
+
    //**BLAS-based subraction assignment to dense matrices (single precision)***********************
 #if BLAZE_BLAS_MODE
    /*!\brief BLAS-based subraction assignment of a scaled dense matrix-dense matrix multiplication
@@ -28,7 +28,9 @@
 //*************************************************************************************************
 
 #include <stdexcept>
+#include <boost/bind.hpp>
 #include <boost/cast.hpp>
+#include <boost/ref.hpp>
 #include <blaze/math/constraints/DenseMatrix.h>
 #include <blaze/math/constraints/DenseVector.h>
 #include <blaze/math/constraints/StorageOrder.h>
@@ -39,6 +41,7 @@
 #include <blaze/math/Intrinsics.h>
 #include <blaze/math/MathTrait.h>
 #include <blaze/math/shims/Reset.h>
+#include <blaze/math/smp/ThreadBackend.h>
 #include <blaze/math/traits/MultExprTrait.h>
 #include <blaze/math/typetraits/CanAlias.h>
 #include <blaze/math/typetraits/IsBlasCompatible.h>
@@ -397,6 +400,9 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
    //
    // This function implements the vectorized default assignment kernel for the dense matrix-
    // dense vector multiplication.
+   //
+   // In case the number of matrix elements exceeds the SMP_DMATDVECMULT_THRESHOLD, the rows
+   // of the target vector are evaluated in parallel (see \ref smp).
    */
    template< typename VT1    // Type of the left-hand side target vector
            , typename MT1    // Type of the left-hand side matrix operand
@@ -404,14 +410,48 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
    static inline typename EnableIf< UseVectorizedDefaultKernel<VT1,MT1,VT2> >::Type
       selectDefaultAssignKernel( VT1& y, const MT1& A, const VT2& x )
    {
+      if( A.rows() * A.columns() < SMP_DMATDVECMULT_THRESHOLD )
+         defaultAssignKernel( y, A, x, 0UL, A.rows() );
+      else
+         smpFor( A.rows(), 8UL,
+                 boost::bind( &This::template defaultAssignKernel<VT1,MT1,VT2>,
+                              boost::ref( y ), boost::cref( A ), boost::cref( x ), _1, _2 ) );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Vectorized default assignment to dense vectors (row range)**********************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Vectorized default assignment of a range of rows of a dense matrix-dense vector
+   //        multiplication (\f$ \vec{y}=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side dense matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the vectorized default assignment kernel for the rows
+   // \f$ [ibegin..iend) \f$ of the dense matrix-dense vector multiplication. The range is evaluated
+   // sequentially.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void
+      defaultAssignKernel( VT1& y, const MT1& A, const VT2& x, size_t ibegin, size_t iend )
+   {
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
       typedef IntrinsicTrait<ElementType>  IT;
 
-      const size_t M( A.rows()    );
       const size_t N( A.columns() );
 
-      size_t i( 0UL );
+      size_t i( ibegin );
 
-      for( ; (i+8UL) <= M; i+=8UL ) {
+      for( ; (i+8UL) <= iend; i+=8UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7, xmm8;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -433,7 +473,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i+6UL] = sum( xmm7 );
          y[i+7UL] = sum( xmm8 );
       }
-      for( ; (i+4UL) <= M; i+=4UL ) {
+      for( ; (i+4UL) <= iend; i+=4UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -447,7 +487,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i+2UL] = sum( xmm3 );
          y[i+3UL] = sum( xmm4 );
       }
-      for( ; (i+3UL) <= M; i+=3UL ) {
+      for( ; (i+3UL) <= iend; i+=3UL ) {
          IntrinsicType xmm1, xmm2, xmm3;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -459,7 +499,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i+1UL] = sum( xmm2 );
          y[i+2UL] = sum( xmm3 );
       }
-      for( ; (i+2UL) <= M; i+=2UL ) {
+      for( ; (i+2UL) <= iend; i+=2UL ) {
          IntrinsicType xmm1, xmm2;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -469,7 +509,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i    ] = sum( xmm1 );
          y[i+1UL] = sum( xmm2 );
       }
-      if( i < M ) {
+      if( i < iend ) {
          IntrinsicType xmm1;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             xmm1 = xmm1 + A.get(i,j) * x.get(j);
@@ -770,6 +810,9 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
    //
    // This function implements the vectorized default addition assignment kernel for the dense
    // matrix-dense vector multiplication.
+   //
+   // In case the number of matrix elements exceeds the SMP_DMATDVECMULT_THRESHOLD, the rows
+   // of the target vector are evaluated in parallel (see \ref smp).
    */
    template< typename VT1    // Type of the left-hand side target vector
            , typename MT1    // Type of the left-hand side matrix operand
@@ -777,14 +820,48 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
    static inline typename EnableIf< UseVectorizedDefaultKernel<VT1,MT1,VT2> >::Type
       selectDefaultAddAssignKernel( VT1& y, const MT1& A, const VT2& x )
    {
+      if( A.rows() * A.columns() < SMP_DMATDVECMULT_THRESHOLD )
+         defaultAddAssignKernel( y, A, x, 0UL, A.rows() );
+      else
+         smpFor( A.rows(), 8UL,
+                 boost::bind( &This::template defaultAddAssignKernel<VT1,MT1,VT2>,
+                              boost::ref( y ), boost::cref( A ), boost::cref( x ), _1, _2 ) );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Vectorized default addition assignment to dense vectors (row range)*************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Vectorized default addition assignment of a range of rows of a dense matrix-dense
+   //        vector multiplication (\f$ \vec{y}+=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side dense matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the vectorized default addition assignment kernel for the rows
+   // \f$ [ibegin..iend) \f$ of the dense matrix-dense vector multiplication. The range is evaluated
+   // sequentially.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void
+      defaultAddAssignKernel( VT1& y, const MT1& A, const VT2& x, size_t ibegin, size_t iend )
+   {
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
       typedef IntrinsicTrait<ElementType>  IT;
 
-      const size_t M( A.rows()    );
       const size_t N( A.columns() );
 
-      size_t i( 0UL );
+      size_t i( ibegin );
 
-      for( ; (i+8UL) <= M; i+=8UL ) {
+      for( ; (i+8UL) <= iend; i+=8UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7, xmm8;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -806,7 +883,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i+6UL] += sum( xmm7 );
          y[i+7UL] += sum( xmm8 );
       }
-      for( ; (i+4UL) <= M; i+=4UL ) {
+      for( ; (i+4UL) <= iend; i+=4UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -820,7 +897,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i+2UL] += sum( xmm3 );
          y[i+3UL] += sum( xmm4 );
       }
-      for( ; (i+3UL) <= M; i+=3UL ) {
+      for( ; (i+3UL) <= iend; i+=3UL ) {
          IntrinsicType xmm1, xmm2, xmm3;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -832,7 +909,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i+1UL] += sum( xmm2 );
          y[i+2UL] += sum( xmm3 );
       }
-      for( ; (i+2UL) <= M; i+=2UL ) {
+      for( ; (i+2UL) <= iend; i+=2UL ) {
          IntrinsicType xmm1, xmm2;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -842,7 +919,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i    ] += sum( xmm1 );
          y[i+1UL] += sum( xmm2 );
       }
-      if( i < M ) {
+      if( i < iend ) {
          IntrinsicType xmm1;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             xmm1 = xmm1 + A.get(i,j) * x.get(j);
@@ -1120,6 +1197,9 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
    //
    // This function implements the vectorized default subtraction assignment kernel for the dense
    // matrix-dense vector multiplication.
+   //
+   // In case the number of matrix elements exceeds the SMP_DMATDVECMULT_THRESHOLD, the rows
+   // of the target vector are evaluated in parallel (see \ref smp).
    */
    template< typename VT1    // Type of the left-hand side target vector
            , typename MT1    // Type of the left-hand side matrix operand
@@ -1127,14 +1207,48 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
    static inline typename EnableIf< UseVectorizedDefaultKernel<VT1,MT1,VT2> >::Type
       selectDefaultSubAssignKernel( VT1& y, const MT1& A, const VT2& x )
    {
+      if( A.rows() * A.columns() < SMP_DMATDVECMULT_THRESHOLD )
+         defaultSubAssignKernel( y, A, x, 0UL, A.rows() );
+      else
+         smpFor( A.rows(), 8UL,
+                 boost::bind( &This::template defaultSubAssignKernel<VT1,MT1,VT2>,
+                              boost::ref( y ), boost::cref( A ), boost::cref( x ), _1, _2 ) );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Vectorized default subtraction assignment to dense vectors (row range)**********************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Vectorized default subtraction assignment of a range of rows of a dense matrix-dense
+   //        vector multiplication (\f$ \vec{y}-=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side dense matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the vectorized default subtraction assignment kernel for the rows
+   // \f$ [ibegin..iend) \f$ of the dense matrix-dense vector multiplication. The range is evaluated
+   // sequentially.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void
+      defaultSubAssignKernel( VT1& y, const MT1& A, const VT2& x, size_t ibegin, size_t iend )
+   {
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
       typedef IntrinsicTrait<ElementType>  IT;
 
-      const size_t M( A.rows()    );
       const size_t N( A.columns() );
 
-      size_t i( 0UL );
+      size_t i( ibegin );
 
-      for( ; (i+8UL) <= M; i+=8UL ) {
+      for( ; (i+8UL) <= iend; i+=8UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7, xmm8;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -1156,7 +1270,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i+6UL] -= sum( xmm7 );
          y[i+7UL] -= sum( xmm8 );
       }
-      for( ; (i+4UL) <= M; i+=4UL ) {
+      for( ; (i+4UL) <= iend; i+=4UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -1170,7 +1284,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i+2UL] -= sum( xmm3 );
          y[i+3UL] -= sum( xmm4 );
       }
-      for( ; (i+3UL) <= M; i+=3UL ) {
+      for( ; (i+3UL) <= iend; i+=3UL ) {
          IntrinsicType xmm1, xmm2, xmm3;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -1182,7 +1296,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i+1UL] -= sum( xmm2 );
          y[i+2UL] -= sum( xmm3 );
       }
-      for( ; (i+2UL) <= M; i+=2UL ) {
+      for( ; (i+2UL) <= iend; i+=2UL ) {
          IntrinsicType xmm1, xmm2;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -1192,7 +1306,7 @@ class DMatDVecMultExpr : public DenseVector< DMatDVecMultExpr<MT,VT>, false >
          y[i    ] -= sum( xmm1 );
          y[i+1UL] -= sum( xmm2 );
       }
-      if( i < M ) {
+      if( i < iend ) {
          IntrinsicType xmm1;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             xmm1 = xmm1 + A.get(i,j) * x.get(j);
@@ -1747,6 +1861,9 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
    //
    // This function implements the vectorized default assignment kernel for the scaled dense
    // matrix-dense vector multiplication.
+   //
+   // In case the number of matrix elements exceeds the SMP_DMATDVECMULT_THRESHOLD, the rows
+   // of the target vector are evaluated in parallel (see \ref smp).
    */
    template< typename VT1    // Type of the left-hand side target vector
            , typename MT1    // Type of the left-hand side matrix operand
@@ -1755,14 +1872,50 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
    static inline typename EnableIf< UseVectorizedDefaultKernel<VT1,MT1,VT2,ST2> >::Type
       selectDefaultAssignKernel( VT1& y, const MT1& A, const VT2& x, ST2 scalar )
    {
+      if( A.rows() * A.columns() < SMP_DMATDVECMULT_THRESHOLD )
+         defaultAssignKernel( y, A, x, scalar, 0UL, A.rows() );
+      else
+         smpFor( A.rows(), 8UL,
+                 boost::bind( &This::template defaultAssignKernel<VT1,MT1,VT2,ST2>,
+                              boost::ref( y ), boost::cref( A ), boost::cref( x ),
+                              scalar, _1, _2 ) );
+   }
+   //**********************************************************************************************
+
+   //**Vectorized default assignment to dense vectors (row range)**********************************
+   /*!\brief Vectorized default assignment of a range of rows of a scaled dense matrix-dense vector
+   //        multiplication (\f$ \vec{y}=s*A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side dense matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param scalar The scaling factor.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the vectorized default assignment kernel for the rows
+   // \f$ [ibegin..iend) \f$ of the scaled dense matrix-dense vector multiplication. The range is
+   // evaluated sequentially.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2    // Type of the right-hand side vector operand
+           , typename ST2 >  // Type of the scalar value
+   static inline void
+      defaultAssignKernel( VT1& y, const MT1& A, const VT2& x, ST2 scalar,
+                           size_t ibegin, size_t iend )
+   {
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
       typedef IntrinsicTrait<ElementType>  IT;
 
-      const size_t M( A.rows()    );
       const size_t N( A.columns() );
 
-      size_t i( 0UL );
+      size_t i( ibegin );
 
-      for( ; (i+8UL) <= M; i+=8UL ) {
+      for( ; (i+8UL) <= iend; i+=8UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7, xmm8;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -1784,7 +1937,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i+6UL] = sum( xmm7 ) * scalar;
          y[i+7UL] = sum( xmm8 ) * scalar;
       }
-      for( ; (i+4UL) <= M; i+=4UL ) {
+      for( ; (i+4UL) <= iend; i+=4UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -1798,7 +1951,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i+2UL] = sum( xmm3 ) * scalar;
          y[i+3UL] = sum( xmm4 ) * scalar;
       }
-      for( ; (i+3UL) <= M; i+=3UL ) {
+      for( ; (i+3UL) <= iend; i+=3UL ) {
          IntrinsicType xmm1, xmm2, xmm3;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -1810,7 +1963,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i+1UL] = sum( xmm2 ) * scalar;
          y[i+2UL] = sum( xmm3 ) * scalar;
       }
-      for( ; (i+2UL) <= M; i+=2UL ) {
+      for( ; (i+2UL) <= iend; i+=2UL ) {
          IntrinsicType xmm1, xmm2;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -1820,7 +1973,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i    ] = sum( xmm1 ) * scalar;
          y[i+1UL] = sum( xmm2 ) * scalar;
       }
-      if( i < M ) {
+      if( i < iend ) {
          IntrinsicType xmm1;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             xmm1 = xmm1 + A.get(i,j) * x.get(j);
@@ -2122,6 +2275,9 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
    //
    // This function implements the vectorized default addition assignment kernel for the scaled
    // dense matrix-dense vector multiplication.
+   //
+   // In case the number of matrix elements exceeds the SMP_DMATDVECMULT_THRESHOLD, the rows
+   // of the target vector are evaluated in parallel (see \ref smp).
    */
    template< typename VT1    // Type of the left-hand side target vector
            , typename MT1    // Type of the left-hand side matrix operand
@@ -2130,14 +2286,50 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
    static inline typename EnableIf< UseVectorizedDefaultKernel<VT1,MT1,VT2,ST2> >::Type
       selectDefaultAddAssignKernel( VT1& y, const MT1& A, const VT2& x, ST2 scalar )
    {
+      if( A.rows() * A.columns() < SMP_DMATDVECMULT_THRESHOLD )
+         defaultAddAssignKernel( y, A, x, scalar, 0UL, A.rows() );
+      else
+         smpFor( A.rows(), 8UL,
+                 boost::bind( &This::template defaultAddAssignKernel<VT1,MT1,VT2,ST2>,
+                              boost::ref( y ), boost::cref( A ), boost::cref( x ),
+                              scalar, _1, _2 ) );
+   }
+   //**********************************************************************************************
+
+   //**Vectorized default addition assignment to dense vectors (row range)*************************
+   /*!\brief Vectorized default addition assignment of a range of rows of a scaled dense
+   //        matrix-dense vector multiplication (\f$ \vec{y}+=s*A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side dense matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param scalar The scaling factor.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the vectorized default addition assignment kernel for the rows
+   // \f$ [ibegin..iend) \f$ of the scaled dense matrix-dense vector multiplication. The range is
+   // evaluated sequentially.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2    // Type of the right-hand side vector operand
+           , typename ST2 >  // Type of the scalar value
+   static inline void
+      defaultAddAssignKernel( VT1& y, const MT1& A, const VT2& x, ST2 scalar,
+                              size_t ibegin, size_t iend )
+   {
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
       typedef IntrinsicTrait<ElementType>  IT;
 
-      const size_t M( A.rows()    );
       const size_t N( A.columns() );
 
-      size_t i( 0UL );
+      size_t i( ibegin );
 
-      for( ; (i+8UL) <= M; i+=8UL ) {
+      for( ; (i+8UL) <= iend; i+=8UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7, xmm8;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -2159,7 +2351,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i+6UL] += sum( xmm7 ) * scalar;
          y[i+7UL] += sum( xmm8 ) * scalar;
       }
-      for( ; (i+4UL) <= M; i+=4UL ) {
+      for( ; (i+4UL) <= iend; i+=4UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -2173,7 +2365,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i+2UL] += sum( xmm3 ) * scalar;
          y[i+3UL] += sum( xmm4 ) * scalar;
       }
-      for( ; (i+3UL) <= M; i+=3UL ) {
+      for( ; (i+3UL) <= iend; i+=3UL ) {
          IntrinsicType xmm1, xmm2, xmm3;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -2185,7 +2377,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i+1UL] += sum( xmm2 ) * scalar;
          y[i+2UL] += sum( xmm3 ) * scalar;
       }
-      for( ; (i+2UL) <= M; i+=2UL ) {
+      for( ; (i+2UL) <= iend; i+=2UL ) {
          IntrinsicType xmm1, xmm2;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -2195,7 +2387,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i    ] += sum( xmm1 ) * scalar;
          y[i+1UL] += sum( xmm2 ) * scalar;
       }
-      if( i < M ) {
+      if( i < iend ) {
          IntrinsicType xmm1;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             xmm1 = xmm1 + A.get(i,j) * x.get(j);
@@ -2476,6 +2668,9 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
    //
    // This function implements the vectorized default subtraction assignment kernel for the
    // scaled dense matrix-dense vector multiplication.
+   //
+   // In case the number of matrix elements exceeds the SMP_DMATDVECMULT_THRESHOLD, the rows
+   // of the target vector are evaluated in parallel (see \ref smp).
    */
    template< typename VT1    // Type of the left-hand side target vector
            , typename MT1    // Type of the left-hand side matrix operand
@@ -2484,14 +2679,50 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
    static inline typename EnableIf< UseVectorizedDefaultKernel<VT1,MT1,VT2,ST2> >::Type
       selectDefaultSubAssignKernel( VT1& y, const MT1& A, const VT2& x, ST2 scalar )
    {
+      if( A.rows() * A.columns() < SMP_DMATDVECMULT_THRESHOLD )
+         defaultSubAssignKernel( y, A, x, scalar, 0UL, A.rows() );
+      else
+         smpFor( A.rows(), 8UL,
+                 boost::bind( &This::template defaultSubAssignKernel<VT1,MT1,VT2,ST2>,
+                              boost::ref( y ), boost::cref( A ), boost::cref( x ),
+                              scalar, _1, _2 ) );
+   }
+   //**********************************************************************************************
+
+   //**Vectorized default subtraction assignment to dense vectors (row range)**********************
+   /*!\brief Vectorized default subtraction assignment of a range of rows of a scaled dense
+   //        matrix-dense vector multiplication (\f$ \vec{y}-=s*A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side dense matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param scalar The scaling factor.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the vectorized default subtraction assignment kernel for the rows
+   // \f$ [ibegin..iend) \f$ of the scaled dense matrix-dense vector multiplication. The range is
+   // evaluated sequentially.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2    // Type of the right-hand side vector operand
+           , typename ST2 >  // Type of the scalar value
+   static inline void
+      defaultSubAssignKernel( VT1& y, const MT1& A, const VT2& x, ST2 scalar,
+                              size_t ibegin, size_t iend )
+   {
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
       typedef IntrinsicTrait<ElementType>  IT;
 
-      const size_t M( A.rows()    );
       const size_t N( A.columns() );
 
-      size_t i( 0UL );
+      size_t i( ibegin );
 
-      for( ; (i+8UL) <= M; i+=8UL ) {
+      for( ; (i+8UL) <= iend; i+=8UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7, xmm8;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -2513,7 +2744,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i+6UL] -= sum( xmm7 ) * scalar;
          y[i+7UL] -= sum( xmm8 ) * scalar;
       }
-      for( ; (i+4UL) <= M; i+=4UL ) {
+      for( ; (i+4UL) <= iend; i+=4UL ) {
          IntrinsicType xmm1, xmm2, xmm3, xmm4;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -2527,7 +2758,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i+2UL] -= sum( xmm3 ) * scalar;
          y[i+3UL] -= sum( xmm4 ) * scalar;
       }
-      for( ; (i+3UL) <= M; i+=3UL ) {
+      for( ; (i+3UL) <= iend; i+=3UL ) {
          IntrinsicType xmm1, xmm2, xmm3;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -2539,7 +2770,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i+1UL] -= sum( xmm2 ) * scalar;
          y[i+2UL] -= sum( xmm3 ) * scalar;
       }
-      for( ; (i+2UL) <= M; i+=2UL ) {
+      for( ; (i+2UL) <= iend; i+=2UL ) {
          IntrinsicType xmm1, xmm2;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             const IntrinsicType x1( x.get(j) );
@@ -2549,7 +2780,7 @@ class DVecScalarMultExpr< DMatDVecMultExpr<MT,VT>, ST, false >
          y[i    ] -= sum( xmm1 ) * scalar;
          y[i+1UL] -= sum( xmm2 ) * scalar;
       }
-      if( i < M ) {
+      if( i < iend ) {
          IntrinsicType xmm1;
          for( size_t j=0UL; j<N; j+=IT::size ) {
             xmm1 = xmm1 + A.get(i,j) * x.get(j);
@@ -28,6 +28,9 @@
 //*************************************************************************************************
 
 #include <stdexcept>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
 #include <boost/type_traits/remove_reference.hpp>
 #include <blaze/math/constraints/DenseVector.h>
 #include <blaze/math/constraints/SparseMatrix.h>
@@ -36,19 +39,29 @@
 #include <blaze/math/Expression.h>
 #include <blaze/math/expressions/DenseVector.h>
 #include <blaze/math/expressions/Forward.h>
+#include <blaze/math/Intrinsics.h>
 #include <blaze/math/MathTrait.h>
 #include <blaze/math/shims/Reset.h>
+#include <blaze/math/smp/Partition.h>
+#include <blaze/math/smp/ThreadBackend.h>
 #include <blaze/math/traits/MultExprTrait.h>
 #include <blaze/math/typetraits/CanAlias.h>
+#include <blaze/math/typetraits/IsCSRMatrix.h>
 #include <blaze/math/typetraits/IsExpression.h>
 #include <blaze/math/typetraits/IsMatMatMultExpr.h>
+#include <blaze/system/CacheSize.h>
+#include <blaze/system/Prefetch.h>
+#include <blaze/system/Thresholds.h>
 #include <blaze/util/Assert.h>
 #include <blaze/util/constraints/Reference.h>
 #include <blaze/util/DisableIf.h>
 #include <blaze/util/EnableIf.h>
 #include <blaze/util/SelectType.h>
 #include <blaze/util/Types.h>
+#include <blaze/util/typetraits/IsDouble.h>
+#include <blaze/util/typetraits/IsFloat.h>
 #include <blaze/util/typetraits/IsReference.h>
+#include <blaze/util/typetraits/IsSame.h>
 
 
 namespace blaze {
@@ -100,6 +113,22 @@ class SMatDVecMultExpr : public DenseVector< SMatDVecMultExpr<MT,VT>, false >
    /*! \endcond */
    //**********************************************************************************************
 
+   //**********************************************************************************************
+   /*! \cond BLAZE_INTERNAL */
+   //! Helper structure for the explicit application of the SFINAE principle.
+   /*! In case the matrix type is a CSRMatrix, the vector type provides contiguous storage and
+       both operands have the same single or double precision element type, the nested \value
+       will be set to 1 and the vectorized gather kernels will be used, otherwise it will be 0. */
+   template< typename T1, typename T2 >
+   struct UseGatherKernel {
+      enum { value = IsCSRMatrix<T1>::value && !IsExpression<T2>::value &&
+                     IsSame<typename T1::ElementType,typename T2::ElementType>::value &&
+                     ( IsFloat<typename T1::ElementType>::value ||
+                       IsDouble<typename T1::ElementType>::value ) };
+   };
+   /*! \endcond */
+   //**********************************************************************************************
+
  public:
    //**Type definitions****************************************************************************
    typedef SMatDVecMultExpr<MT,VT>                This;           //!< Type of this SMatDVecMultExpr instance.
@@ -279,20 +308,16 @@ class SMatDVecMultExpr : public DenseVector< SMatDVecMultExpr<MT,VT>, false >
    // \param rhs The right-hand side multiplication expression to be assigned.
    // \return void
    //
-   // This function implements the performance optimized assignment of a sparse matrix-dense
-   // vector multiplication expression to a dense vector. Due to the explicit application of
-   // the SFINAE principle, this operator can only be selected by the compiler in case either
-   // the left-hand side matrix operand requires an intermediate evaluation or the right-hand
-   // side vector operand is a compound expression.
+   // This function implements the performance optimized assignment of a sparse matrix-dense vector
+   // multiplication expression to a dense vector. In case the number of rows of the sparse matrix
+   // exceeds the SMP_SMATDVECMULT_THRESHOLD, the rows are partitioned into blocks of approximately
+   // equal number of non-zero elements and the blocks are evaluated in parallel (see \ref smp).
    */
    template< typename VT1 >  // Type of the target dense vector
-   friend inline typename EnableIf< UseAssign<VT1> >::Type
-      assign( DenseVector<VT1,false>& lhs, const SMatDVecMultExpr& rhs )
+   friend inline void assign( DenseVector<VT1,false>& lhs, const SMatDVecMultExpr& rhs )
    {
       BLAZE_INTERNAL_ASSERT( (~lhs).size() == rhs.size(), "Invalid vector sizes" );
 
-      typedef typename boost::remove_reference<LT>::type::ConstIterator  ConstIterator;
-
       if( rhs.mat_.columns() == 0UL ) {
          reset( ~lhs );
          return;
@@ -306,7 +331,173 @@ class SMatDVecMultExpr : public DenseVector< SMatDVecMultExpr<MT,VT>, false >
       BLAZE_INTERNAL_ASSERT( x.size()    == rhs.vec_.size()   , "Invalid vector size"       );
       BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).size()     , "Invalid vector size"       );
 
-      (~lhs).assign( A * x );
+      if( A.rows() < SMP_SMATDVECMULT_THRESHOLD )
+         SMatDVecMultExpr::assignKernel( ~lhs, A, x, 0UL, A.rows() );
+      else
+         SMatDVecMultExpr::smpAssignKernel( ~lhs, A, x );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Default assignment to dense vectors (row range)*********************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Default assignment of a range of rows of a sparse matrix-dense vector multiplication
+   //        (\f$ \vec{y}=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the default assignment kernel for the rows \f$ [ibegin..iend) \f$ of
+   // the sparse matrix-dense vector multiplication. The elements of \a x that are indexed by the
+   // upcoming non-zero elements of a row are prefetched (see the prefetchDistance setting).
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline typename DisableIf< UseGatherKernel<MT1,VT2> >::Type
+      assignKernel( VT1& y, const MT1& A, const VT2& x, size_t ibegin, size_t iend )
+   {
+      typedef typename MT1::ConstIterator  ConstIterator;
+
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
+      for( size_t i=ibegin; i<iend; ++i )
+      {
+         const ConstIterator end( A.end(i) );
+         ConstIterator element( A.begin(i) );
+         ConstIterator ahead( element );
+
+         for( size_t k=0UL; k<prefetchDistance && ahead!=end; ++k, ++ahead )
+            prefetch( &x[ahead->index()] );
+
+         if( element == end ) {
+            reset( y[i] );
+            continue;
+         }
+
+         ElementType tmp( element->value() * x[element->index()] );
+
+         for( ++element; element!=end; ++element ) {
+            if( ahead != end ) {
+               prefetch( &x[ahead->index()] );
+               ++ahead;
+            }
+            tmp += element->value() * x[element->index()];
+         }
+
+         y[i] = tmp;
+      }
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Vectorized assignment to dense vectors (row range)******************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Vectorized assignment of a range of rows of a CSR matrix-dense vector multiplication
+   //        (\f$ \vec{y}=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side CSR matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the vectorized assignment kernel for the rows \f$ [ibegin..iend) \f$
+   // of a CSR matrix-dense vector multiplication (see the gatherRow() function).
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline typename EnableIf< UseGatherKernel<MT1,VT2> >::Type
+      assignKernel( VT1& y, const MT1& A, const VT2& x, size_t ibegin, size_t iend )
+   {
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
+      for( size_t i=ibegin; i<iend; ++i )
+         y[i] = gatherRow( A, &x[0], i );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Vectorized row product**********************************************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Vectorized computation of the scalar product of a row of a CSR matrix and a dense
+   //        vector.
+   // \ingroup dense_vector
+   //
+   // \param A The left-hand side CSR matrix operand.
+   // \param x Pointer to the first element of the right-hand side dense vector operand.
+   // \param i The index of the row.
+   // \return The scalar product of row \a i of \a A and \a x.
+   //
+   // The values of the row are loaded directly from the value array of the CSR matrix and the
+   // according elements of the vector are gathered via the column indices of the row (see the
+   // gather() intrinsic). The remaining elements of the row are handled by a scalar loop.
+   */
+   template< typename MT1 >  // Type of the left-hand side matrix operand
+   static inline ElementType gatherRow( const MT1& A, const ElementType* x, size_t i )
+   {
+      typedef IntrinsicTrait<ElementType>  IT;
+      typedef typename IT::Type            IntrinsicType;
+      typedef typename MT1::IndexType      IndexType;
+
+      const IndexType*   const indices( A.indices() );
+      const ElementType* const values ( A.values()  );
+
+      const size_t kbegin( A.offsets()[i] );
+      const size_t kend  ( A.offsets()[i+1UL] );
+      const size_t kpos  ( kbegin + ( ( kend - kbegin ) & size_t(-IT::size) ) );
+
+      size_t k( kbegin );
+      ElementType tmp = ElementType();
+
+      if( kbegin != kpos ) {
+         IntrinsicType xmm;
+         for( ; k<kpos; k+=IT::size )
+            xmm = xmm + loadu( values+k ) * gather( x, indices+k );
+         tmp = sum( xmm );
+      }
+
+      for( ; k<kend; ++k )
+         tmp += values[k] * x[indices[k]];
+
+      return tmp;
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Parallel assignment to dense vectors********************************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Parallel assignment of a sparse matrix-dense vector multiplication
+   //        (\f$ \vec{y}=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \return void
+   //
+   // This function partitions the rows of \a A into one block of approximately equal number of
+   // non-zero elements per thread (see partitionNonZeros()) and evaluates the blocks in parallel.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void smpAssignKernel( VT1& y, const MT1& A, const VT2& x )
+   {
+      std::vector<size_t> bounds;
+      partitionNonZeros( A, getNumThreads(), bounds );
+
+      smpForPartitions( bounds, boost::bind( &This::template assignKernel<VT1,MT1,VT2>,
+                                             boost::ref( y ), boost::cref( A ), boost::cref( x ),
+                                             _1, _2 ) );
    }
    /*! \endcond */
    //**********************************************************************************************
@@ -351,20 +542,17 @@ class SMatDVecMultExpr : public DenseVector< SMatDVecMultExpr<MT,VT>, false >
    // \param rhs The right-hand side multiplication expression to be added.
    // \return void
    //
-   // This function implements the performance optimized addition assignment of a sparse matrix-
-   // dense vector multiplication expression to a dense vector. Due to the explicit application
-   // of the SFINAE principle, this operator can only be selected by the compiler in case either
-   // the left-hand side matrix operand requires an intermediate evaluation or the right-hand
-   // side vector operand is a compound expression.
+   // This function implements the performance optimized addition assignment of a sparse
+   // matrix-dense vector multiplication expression to a dense vector. In case the number of rows of
+   // the sparse matrix exceeds the SMP_SMATDVECMULT_THRESHOLD, the rows are partitioned into blocks
+   // of approximately equal number of non-zero elements and the blocks are evaluated in parallel
+   // (see \ref smp).
    */
    template< typename VT1 >  // Type of the target dense vector
-   friend inline typename EnableIf< UseAssign<VT1> >::Type
-      addAssign( DenseVector<VT1,false>& lhs, const SMatDVecMultExpr& rhs )
+   friend inline void addAssign( DenseVector<VT1,false>& lhs, const SMatDVecMultExpr& rhs )
    {
       BLAZE_INTERNAL_ASSERT( (~lhs).size() == rhs.size(), "Invalid vector sizes" );
 
-      typedef typename boost::remove_reference<LT>::type::ConstIterator  ConstIterator;
-
       if( rhs.mat_.columns() == 0UL ) {
          return;
       }
@@ -377,7 +565,125 @@ class SMatDVecMultExpr : public DenseVector< SMatDVecMultExpr<MT,VT>, false >
       BLAZE_INTERNAL_ASSERT( x.size()    == rhs.vec_.size()   , "Invalid vector size"       );
       BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).size()     , "Invalid vector size"       );
 
-      (~lhs).addAssign( A * x );
+      if( A.rows() < SMP_SMATDVECMULT_THRESHOLD )
+         SMatDVecMultExpr::addAssignKernel( ~lhs, A, x, 0UL, A.rows() );
+      else
+         SMatDVecMultExpr::smpAddAssignKernel( ~lhs, A, x );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Default addition assignment to dense vectors (row range)************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Default addition assignment of a range of rows of a sparse matrix-dense vector
+   //        multiplication (\f$ \vec{y}+=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the default addition assignment kernel for the rows
+   // \f$ [ibegin..iend) \f$ of the sparse matrix-dense vector multiplication. The elements of \a x
+   // that are indexed by the upcoming non-zero elements of a row are prefetched (see the
+   // prefetchDistance setting).
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline typename DisableIf< UseGatherKernel<MT1,VT2> >::Type
+      addAssignKernel( VT1& y, const MT1& A, const VT2& x, size_t ibegin, size_t iend )
+   {
+      typedef typename MT1::ConstIterator  ConstIterator;
+
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
+      for( size_t i=ibegin; i<iend; ++i )
+      {
+         const ConstIterator end( A.end(i) );
+         ConstIterator element( A.begin(i) );
+         ConstIterator ahead( element );
+
+         for( size_t k=0UL; k<prefetchDistance && ahead!=end; ++k, ++ahead )
+            prefetch( &x[ahead->index()] );
+
+         if( element == end ) continue;
+
+         ElementType tmp( element->value() * x[element->index()] );
+
+         for( ++element; element!=end; ++element ) {
+            if( ahead != end ) {
+               prefetch( &x[ahead->index()] );
+               ++ahead;
+            }
+            tmp += element->value() * x[element->index()];
+         }
+
+         y[i] += tmp;
+      }
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Vectorized addition assignment to dense vectors (row range)*********************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Vectorized addition assignment of a range of rows of a CSR matrix-dense vector
+   //        multiplication (\f$ \vec{y}+=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side CSR matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the vectorized addition assignment kernel for the rows
+   // \f$ [ibegin..iend) \f$ of a CSR matrix-dense vector multiplication (see the gatherRow()
+   // function).
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline typename EnableIf< UseGatherKernel<MT1,VT2> >::Type
+      addAssignKernel( VT1& y, const MT1& A, const VT2& x, size_t ibegin, size_t iend )
+   {
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
+      for( size_t i=ibegin; i<iend; ++i )
+         y[i] += gatherRow( A, &x[0], i );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Parallel addition assignment to dense vectors***********************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Parallel addition assignment of a sparse matrix-dense vector multiplication
+   //        (\f$ \vec{y}+=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \return void
+   //
+   // This function partitions the rows of \a A into one block of approximately equal number of
+   // non-zero elements per thread (see partitionNonZeros()) and evaluates the blocks in parallel.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void smpAddAssignKernel( VT1& y, const MT1& A, const VT2& x )
+   {
+      std::vector<size_t> bounds;
+      partitionNonZeros( A, getNumThreads(), bounds );
+
+      smpForPartitions( bounds, boost::bind( &This::template addAssignKernel<VT1,MT1,VT2>,
+                                             boost::ref( y ), boost::cref( A ), boost::cref( x ),
+                                             _1, _2 ) );
    }
    /*! \endcond */
    //**********************************************************************************************
@@ -395,20 +701,17 @@ class SMatDVecMultExpr : public DenseVector< SMatDVecMultExpr<MT,VT>, false >
    // \param rhs The right-hand side multiplication expression to be subtracted.
    // \return void
    //
-   // This function implements the performance optimized subtraction assignment of a sparse matrix-
-   // dense vector multiplication expression to a dense vector. Due to the explicit application
-   // of the SFINAE principle, this operator can only be selected by the compiler in case either
-   // the left-hand side matrix operand requires an intermediate evaluation or the right-hand
-   // side vector operand is a compound expression.
+   // This function implements the performance optimized subtraction assignment of a sparse
+   // matrix-dense vector multiplication expression to a dense vector. In case the number of rows of
+   // the sparse matrix exceeds the SMP_SMATDVECMULT_THRESHOLD, the rows are partitioned into blocks
+   // of approximately equal number of non-zero elements and the blocks are evaluated in parallel
+   // (see \ref smp).
    */
    template< typename VT1 >  // Type of the target dense vector
-   friend inline typename EnableIf< UseAssign<VT1> >::Type
-      subAssign( DenseVector<VT1,false>& lhs, const SMatDVecMultExpr& rhs )
+   friend inline void subAssign( DenseVector<VT1,false>& lhs, const SMatDVecMultExpr& rhs )
    {
       BLAZE_INTERNAL_ASSERT( (~lhs).size() == rhs.size(), "Invalid vector sizes" );
 
-      typedef typename boost::remove_reference<LT>::type::ConstIterator  ConstIterator;
-
       if( rhs.mat_.columns() == 0UL ) {
          return;
       }
@@ -421,7 +724,125 @@ class SMatDVecMultExpr : public DenseVector< SMatDVecMultExpr<MT,VT>, false >
       BLAZE_INTERNAL_ASSERT( x.size()    == rhs.vec_.size()   , "Invalid vector size"       );
       BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).size()     , "Invalid vector size"       );
 
-      (~lhs).subAssign( A * x );
+      if( A.rows() < SMP_SMATDVECMULT_THRESHOLD )
+         SMatDVecMultExpr::subAssignKernel( ~lhs, A, x, 0UL, A.rows() );
+      else
+         SMatDVecMultExpr::smpSubAssignKernel( ~lhs, A, x );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Default subtraction assignment to dense vectors (row range)*********************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Default subtraction assignment of a range of rows of a sparse matrix-dense vector
+   //        multiplication (\f$ \vec{y}-=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the default subtraction assignment kernel for the rows
+   // \f$ [ibegin..iend) \f$ of the sparse matrix-dense vector multiplication. The elements of \a x
+   // that are indexed by the upcoming non-zero elements of a row are prefetched (see the
+   // prefetchDistance setting).
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline typename DisableIf< UseGatherKernel<MT1,VT2> >::Type
+      subAssignKernel( VT1& y, const MT1& A, const VT2& x, size_t ibegin, size_t iend )
+   {
+      typedef typename MT1::ConstIterator  ConstIterator;
+
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
+      for( size_t i=ibegin; i<iend; ++i )
+      {
+         const ConstIterator end( A.end(i) );
+         ConstIterator element( A.begin(i) );
+         ConstIterator ahead( element );
+
+         for( size_t k=0UL; k<prefetchDistance && ahead!=end; ++k, ++ahead )
+            prefetch( &x[ahead->index()] );
+
+         if( element == end ) continue;
+
+         ElementType tmp( element->value() * x[element->index()] );
+
+         for( ++element; element!=end; ++element ) {
+            if( ahead != end ) {
+               prefetch( &x[ahead->index()] );
+               ++ahead;
+            }
+            tmp += element->value() * x[element->index()];
+         }
+
+         y[i] -= tmp;
+      }
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Vectorized subtraction assignment to dense vectors (row range)******************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Vectorized subtraction assignment of a range of rows of a CSR matrix-dense vector
+   //        multiplication (\f$ \vec{y}-=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side CSR matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param ibegin The first row of the range.
+   // \param iend The end of the row range.
+   // \return void
+   //
+   // This function implements the vectorized subtraction assignment kernel for the rows
+   // \f$ [ibegin..iend) \f$ of a CSR matrix-dense vector multiplication (see the gatherRow()
+   // function).
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline typename EnableIf< UseGatherKernel<MT1,VT2> >::Type
+      subAssignKernel( VT1& y, const MT1& A, const VT2& x, size_t ibegin, size_t iend )
+   {
+      BLAZE_INTERNAL_ASSERT( ibegin <= iend && iend <= A.rows(), "Invalid row range" );
+
+      for( size_t i=ibegin; i<iend; ++i )
+         y[i] -= gatherRow( A, &x[0], i );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Parallel subtraction assignment to dense vectors********************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Parallel subtraction assignment of a sparse matrix-dense vector multiplication
+   //        (\f$ \vec{y}-=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \return void
+   //
+   // This function partitions the rows of \a A into one block of approximately equal number of
+   // non-zero elements per thread (see partitionNonZeros()) and evaluates the blocks in parallel.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void smpSubAssignKernel( VT1& y, const MT1& A, const VT2& x )
+   {
+      std::vector<size_t> bounds;
+      partitionNonZeros( A, getNumThreads(), bounds );
+
+      smpForPartitions( bounds, boost::bind( &This::template subAssignKernel<VT1,MT1,VT2>,
+                                             boost::ref( y ), boost::cref( A ), boost::cref( x ),
+                                             _1, _2 ) );
    }
    /*! \endcond */
    //**********************************************************************************************
@@ -34,14 +34,12 @@
 #include <blaze/math/constraints/SparseVector.h>
 #include <blaze/math/constraints/StorageOrder.h>
 #include <blaze/math/constraints/TransposeFlag.h>
-#include <blaze/math/DynamicVector.h>
 #include <blaze/math/Expression.h>
 #include <blaze/math/expressions/Forward.h>
 #include <blaze/math/expressions/SparseMatrix.h>
-#include <blaze/math/Infinity.h>
 #include <blaze/math/MathTrait.h>
 #include <blaze/math/shims/IsDefault.h>
-#include <blaze/math/shims/Reset.h>
+#include <blaze/math/sparse/SpGemm.h>
 #include <blaze/math/traits/SMatDVecMultTrait.h>
 #include <blaze/math/traits/SMatSVecMultTrait.h>
 #include <blaze/math/traits/TDVecSMatMultTrait.h>
@@ -54,7 +52,6 @@
 #include <blaze/util/EnableIf.h>
 #include <blaze/util/SelectType.h>
 #include <blaze/util/Types.h>
-#include <blaze/util/typetraits/IsBuiltin.h>
 #include <blaze/util/typetraits/IsReference.h>
 
 
@@ -363,7 +360,10 @@ class SMatSMatMultExpr : public SparseMatrix< SMatSMatMultExpr<MT1,MT2>, false >
    // \return void
    //
    // This function implements the performance optimized assignment of a sparse matrix-sparse
-   // matrix multiplication expression to a row-major sparse matrix.
+   // matrix multiplication expression to a row-major sparse matrix. The rows of the result are
+   // computed by a two-phase (symbolic/numeric) Gustavson multiplication, which presizes each row
+   // to its exact number of non-zero elements. In case the number of rows exceeds the
+   // SMP_SMATSMATMULT_THRESHOLD, the rows are computed in parallel (see spgemm()).
    */
    template< typename MT >  // Type of the target sparse matrix
    friend inline void assign( SparseMatrix<MT,false>& lhs, const SMatSMatMultExpr& rhs )
@@ -371,9 +371,6 @@ class SMatSMatMultExpr : public SparseMatrix< SMatSMatMultExpr<MT1,MT2>, false >
       BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
       BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-      typedef typename boost::remove_reference<CT1>::type::ConstIterator  LeftIterator;
-      typedef typename boost::remove_reference<CT2>::type::ConstIterator  RightIterator;
-
       CT1 A( rhs.lhs_ );  // Evaluation of the left-hand side sparse matrix operand
       CT2 B( rhs.rhs_ );  // Evaluation of the right-hand side sparse matrix operand
 
@@ -384,62 +381,7 @@ class SMatSMatMultExpr : public SparseMatrix< SMatSMatMultExpr<MT1,MT2>, false >
       BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).rows()     , "Invalid number of rows"    );
       BLAZE_INTERNAL_ASSERT( B.columns() == (~lhs).columns()  , "Invalid number of columns" );
 
-      // (Over-)Estimating the number of non-zero entries in the resulting matrix
-      size_t nonzeros( 0UL );
-
-      for( size_t i=0UL; i<(~lhs).rows(); ++i ) {
-         const LeftIterator lend( A.end(i) );
-         for( LeftIterator lelem=A.begin(i); lelem!=lend; ++lelem ) {
-            nonzeros += B.nonZeros( lelem->index() );
-         }
-      }
-
-      (~lhs).reserve( nonzeros );
-      nonzeros = 0UL;
-
-      // Performing the matrix-matrix multiplication
-      DynamicVector<ElementType> tmp( (~lhs).columns() );
-      size_t minIndex( inf ), maxIndex( 0UL );
-
-      if( IsBuiltin<ElementType>::value )
-         tmp.reset();
-
-      for( size_t i=0UL; i<(~lhs).rows(); ++i )
-      {
-         const LeftIterator lend( A.end(i) );
-         for( LeftIterator lelem=A.begin(i); lelem!=lend; ++lelem )
-         {
-            const RightIterator rend( B.end( lelem->index() ) );
-            for( RightIterator relem=B.begin( lelem->index() ); relem!=rend; ++relem )
-            {
-               if( isDefault( tmp[relem->index()] ) ) {
-                  if( relem->index() < minIndex ) minIndex = relem->index();
-                  if( relem->index() > maxIndex ) maxIndex = relem->index();
-                  ++nonzeros;
-                  tmp[relem->index()] = lelem->value() * relem->value();
-               }
-               else {
-                  tmp[relem->index()] += lelem->value() * relem->value();
-               }
-            }
-         }
-
-         if( nonzeros > 0UL )
-         {
-            for( size_t j=minIndex; j<=maxIndex; ++j ) {
-               if( !isDefault( tmp[j] ) ) {
-                  (~lhs).append( i, j, tmp[j] );
-                  reset( tmp[j] );
-               }
-            }
-
-            nonzeros = 0UL;
-            minIndex = inf;
-            maxIndex = 0UL;
-         }
-
-         (~lhs).finalize( i );
-      }
+      spgemm( ~lhs, A, B );
    }
    /*! \endcond */
    //**********************************************************************************************
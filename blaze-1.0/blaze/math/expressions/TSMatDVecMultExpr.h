@@ -27,7 +27,11 @@
 // Includes
 //*************************************************************************************************
 
+#include <algorithm>
 #include <stdexcept>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
 #include <boost/type_traits/remove_reference.hpp>
 #include <blaze/math/constraints/DenseVector.h>
 #include <blaze/math/constraints/SparseMatrix.h>
@@ -36,17 +40,24 @@
 #include <blaze/math/Expression.h>
 #include <blaze/math/expressions/DenseVector.h>
 #include <blaze/math/expressions/Forward.h>
+#include <blaze/math/Intrinsics.h>
 #include <blaze/math/MathTrait.h>
 #include <blaze/math/shims/IsDefault.h>
 #include <blaze/math/shims/Reset.h>
+#include <blaze/math/smp/Partition.h>
+#include <blaze/math/smp/ThreadBackend.h>
 #include <blaze/math/typetraits/CanAlias.h>
 #include <blaze/math/typetraits/IsExpression.h>
 #include <blaze/math/typetraits/IsMatMatMultExpr.h>
 #include <blaze/math/typetraits/IsResizable.h>
+#include <blaze/system/CacheSize.h>
+#include <blaze/system/Prefetch.h>
+#include <blaze/system/Thresholds.h>
 #include <blaze/util/Assert.h>
 #include <blaze/util/constraints/Reference.h>
 #include <blaze/util/DisableIf.h>
 #include <blaze/util/EnableIf.h>
+#include <blaze/util/Memory.h>
 #include <blaze/util/SelectType.h>
 #include <blaze/util/Types.h>
 #include <blaze/util/typetraits/IsReference.h>
@@ -257,9 +268,12 @@ class TSMatDVecMultExpr : public DenseVector< TSMatDVecMultExpr<MT,VT>, false >
    // \param rhs The right-hand side multiplication expression to be assigned.
    // \return void
    //
-   // This function implements the performance optimized assignment of a transpose sparse matrix-
-   // dense vector multiplication expression to a dense vector. This assign function is used in
-   // case the element type of the target vector is not resizable.
+   // This function implements the performance optimized assignment of a transpose sparse
+   // matrix-dense vector multiplication expression to a dense vector. This assign function is used
+   // in case the element type of the target vector is not resizable. In case the number of columns
+   // of the sparse matrix exceeds the SMP_TSMATDVECMULT_THRESHOLD, the columns are partitioned into
+   // blocks of approximately equal number of non-zero elements, which are accumulated in parallel
+   // into thread-local vectors (see \ref smp).
    */
    template< typename VT1 >  // Type of the target dense vector
    friend inline typename DisableIf< IsResizable<typename VT1::ElementType> >::Type
@@ -267,11 +281,10 @@ class TSMatDVecMultExpr : public DenseVector< TSMatDVecMultExpr<MT,VT>, false >
    {
       BLAZE_INTERNAL_ASSERT( (~lhs).size() == rhs.size(), "Invalid vector sizes" );
 
-      typedef typename boost::remove_reference<LT>::type::ConstIterator  ConstIterator;
-
-      reset( ~lhs );
-
-      if( rhs.mat_.columns() == 0UL ) return;
+      if( rhs.mat_.columns() == 0UL ) {
+         reset( ~lhs );
+         return;
+      }
 
       LT A( rhs.mat_ );  // Evaluation of the left-hand side sparse matrix operand
       RT x( rhs.vec_ );  // Evaluation of the right-hand side dense vector operand
@@ -281,14 +294,86 @@ class TSMatDVecMultExpr : public DenseVector< TSMatDVecMultExpr<MT,VT>, false >
       BLAZE_INTERNAL_ASSERT( x.size()    == rhs.vec_.size()   , "Invalid vector size"       );
       BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).size()     , "Invalid vector size"       );
 
-      for( size_t j=0UL; j<A.columns(); ++j )
-      {
-         ConstIterator element( A.begin(j) );
-         const ConstIterator end( A.end(j) );
+      if( IsResizable<ElementType>::value || A.columns() < SMP_TSMATDVECMULT_THRESHOLD ) {
+         reset( ~lhs );
+         TSMatDVecMultExpr::addAssignKernel( ~lhs, A, x, 0UL, A.columns() );
+      }
+      else {
+         TSMatDVecMultExpr::smpAssignKernel( ~lhs, A, x );
+      }
+   }
+   /*! \endcond */
+   //**********************************************************************************************
 
-         for( ; element!=end; ++element ) {
-            (~lhs)[element->index()] += element->value() * x[j];
-         }
+   //**Parallel assignment to dense vectors********************************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Parallel assignment of a transpose sparse matrix-dense vector multiplication
+   //        (\f$ \vec{y}=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \return void
+   //
+   // This function partitions the columns of \a A into one block of approximately equal number of
+   // non-zero elements per thread (see partitionNonZeros()). Each block is accumulated into a
+   // separate thread-local vector, which avoids any write conflicts between the threads. Afterwards
+   // the thread-local vectors are reduced in parallel into the target vector.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void smpAssignKernel( VT1& y, const MT1& A, const VT2& x )
+   {
+      const size_t threads( getNumThreads() );
+
+      if( threads == 1UL ) {
+         reset( y );
+         addAssignKernel( y, A, x, 0UL, A.columns() );
+         return;
+      }
+
+      std::vector<size_t> bounds;
+      partitionNonZeros( A, threads, bounds );
+
+      const size_t parts( bounds.size() - 1UL );
+      const size_t M( A.rows() );
+
+      const AlignedArray<ElementType> buffer( parts*M );
+
+      smpFor( parts, 1UL, boost::bind( &This::template partialKernel<MT1,VT2>, buffer.get(), M,
+                                       boost::cref( bounds ), boost::cref( A ),
+                                       boost::cref( x ), _1, _2 ) );
+
+      smpFor( M, 64UL, boost::bind( &This::template reduceAssignKernel<VT1>, boost::ref( y ),
+                                    buffer.get(), M, parts, _1, _2 ) );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Reduction assignment to dense vectors*******************************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Reduction assignment of a range of thread-local vectors to a dense vector.
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param buffer The thread-local vectors.
+   // \param M The size of each thread-local vector.
+   // \param parts The number of thread-local vectors.
+   // \param begin The first element of the range.
+   // \param end The end of the element range.
+   // \return void
+   */
+   template< typename VT1 >  // Type of the left-hand side target vector
+   static inline void reduceAssignKernel( VT1& y, const ElementType* buffer, size_t M,
+                                          size_t parts, size_t begin, size_t end )
+   {
+      for( size_t i=begin; i<end; ++i ) {
+         ElementType tmp( buffer[i] );
+         for( size_t p=1UL; p<parts; ++p )
+            tmp += buffer[p*M+i];
+         y[i] = tmp;
       }
    }
    /*! \endcond */
@@ -330,19 +415,17 @@ class TSMatDVecMultExpr : public DenseVector< TSMatDVecMultExpr<MT,VT>, false >
    // \param rhs The right-hand side multiplication expression to be added.
    // \return void
    //
-   // This function implements the performance optimized addition assignment of a sparse matrix-
-   // dense vector multiplication expression to a dense vector. Due to the explicit application
-   // of the SFINAE principle, this operator can only be selected by the compiler in case either
-   // the left-hand side matrix operand requires an intermediate evaluation or the right-hand
-   // side vector operand is a compound expression.
+   // This function implements the performance optimized addition assignment of a transpose sparse
+   // matrix-dense vector multiplication expression to a dense vector. In case the number of columns
+   // of the sparse matrix exceeds the SMP_TSMATDVECMULT_THRESHOLD, the columns are partitioned into
+   // blocks of approximately equal number of non-zero elements, which are accumulated in parallel
+   // into thread-local vectors (see \ref smp).
    */
    template< typename VT1 >  // Type of the target dense vector
    friend inline void addAssign( DenseVector<VT1,false>& lhs, const TSMatDVecMultExpr& rhs )
    {
       BLAZE_INTERNAL_ASSERT( (~lhs).size() == rhs.size(), "Invalid vector sizes" );
 
-      typedef typename boost::remove_reference<LT>::type::ConstIterator  ConstIterator;
-
       if( rhs.mat_.columns() == 0UL ) return;
 
       LT A( rhs.mat_ );  // Evaluation of the left-hand side sparse matrix operand
@@ -353,19 +436,168 @@ class TSMatDVecMultExpr : public DenseVector< TSMatDVecMultExpr<MT,VT>, false >
       BLAZE_INTERNAL_ASSERT( x.size()    == rhs.vec_.size()   , "Invalid vector size"       );
       BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).size()     , "Invalid vector size"       );
 
-      for( size_t j=0UL; j<A.columns(); ++j )
+      if( IsResizable<ElementType>::value || A.columns() < SMP_TSMATDVECMULT_THRESHOLD ) {
+         TSMatDVecMultExpr::addAssignKernel( ~lhs, A, x, 0UL, A.columns() );
+      }
+      else {
+         TSMatDVecMultExpr::smpAddAssignKernel( ~lhs, A, x );
+      }
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Default addition assignment to dense vectors (column range)*********************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Default addition assignment of a range of columns of a transpose sparse matrix-dense
+   //        vector multiplication (\f$ \vec{y}+=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param jbegin The first column of the range.
+   // \param jend The end of the column range.
+   // \return void
+   //
+   // This function implements the default addition assignment kernel for the columns
+   // \f$ [jbegin..jend) \f$ of the transpose sparse matrix-dense vector multiplication. The
+   // elements of \a y that are indexed by the upcoming non-zero elements of a column are prefetched
+   // (see the prefetchDistance setting). The target \a y may also be a plain array.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void
+      addAssignKernel( VT1& y, const MT1& A, const VT2& x, size_t jbegin, size_t jend )
+   {
+      typedef typename MT1::ConstIterator  ConstIterator;
+
+      BLAZE_INTERNAL_ASSERT( jbegin <= jend && jend <= A.columns(), "Invalid column range" );
+
+      for( size_t j=jbegin; j<jend; ++j )
       {
-         ConstIterator element( A.begin(j) );
          const ConstIterator end( A.end(j) );
+         ConstIterator element( A.begin(j) );
+         ConstIterator ahead( element );
+
+         for( size_t k=0UL; k<prefetchDistance && ahead!=end; ++k, ++ahead )
+            prefetch( &y[ahead->index()] );
 
          for( ; element!=end; ++element ) {
-            (~lhs)[element->index()] += element->value() * x[j];
+            if( ahead != end ) {
+               prefetch( &y[ahead->index()] );
+               ++ahead;
+            }
+            y[element->index()] += element->value() * x[j];
          }
       }
    }
    /*! \endcond */
    //**********************************************************************************************
 
+   //**Parallel addition assignment to dense vectors***********************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Parallel addition assignment of a transpose sparse matrix-dense vector multiplication
+   //        (\f$ \vec{y}+=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \return void
+   //
+   // This function partitions the columns of \a A into one block of approximately equal number of
+   // non-zero elements per thread (see partitionNonZeros()). Each block is accumulated into a
+   // separate thread-local vector, which avoids any write conflicts between the threads. Afterwards
+   // the thread-local vectors are reduced in parallel into the target vector.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void smpAddAssignKernel( VT1& y, const MT1& A, const VT2& x )
+   {
+      const size_t threads( getNumThreads() );
+
+      if( threads == 1UL ) {
+         addAssignKernel( y, A, x, 0UL, A.columns() );
+         return;
+      }
+
+      std::vector<size_t> bounds;
+      partitionNonZeros( A, threads, bounds );
+
+      const size_t parts( bounds.size() - 1UL );
+      const size_t M( A.rows() );
+
+      const AlignedArray<ElementType> buffer( parts*M );
+
+      smpFor( parts, 1UL, boost::bind( &This::template partialKernel<MT1,VT2>, buffer.get(), M,
+                                       boost::cref( bounds ), boost::cref( A ),
+                                       boost::cref( x ), _1, _2 ) );
+
+      smpFor( M, 64UL, boost::bind( &This::template reduceAddAssignKernel<VT1>, boost::ref( y ),
+                                    buffer.get(), M, parts, _1, _2 ) );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Reduction addition assignment to dense vectors**********************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Reduction addition assignment of a range of thread-local vectors to a dense vector.
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param buffer The thread-local vectors.
+   // \param M The size of each thread-local vector.
+   // \param parts The number of thread-local vectors.
+   // \param begin The first element of the range.
+   // \param end The end of the element range.
+   // \return void
+   */
+   template< typename VT1 >  // Type of the left-hand side target vector
+   static inline void reduceAddAssignKernel( VT1& y, const ElementType* buffer, size_t M,
+                                             size_t parts, size_t begin, size_t end )
+   {
+      for( size_t i=begin; i<end; ++i ) {
+         ElementType tmp( buffer[i] );
+         for( size_t p=1UL; p<parts; ++p )
+            tmp += buffer[p*M+i];
+         y[i] += tmp;
+      }
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Partial accumulation to thread-local vectors************************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Accumulation of a range of column partitions of a transpose sparse matrix-dense vector
+   //        multiplication into thread-local vectors.
+   // \ingroup dense_vector
+   //
+   // \param buffer The thread-local vectors.
+   // \param M The size of each thread-local vector.
+   // \param bounds The column partition bounds.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param begin The first partition of the range.
+   // \param end The end of the partition range.
+   // \return void
+   */
+   template< typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void partialKernel( ElementType* buffer, size_t M,
+                                     const std::vector<size_t>& bounds, const MT1& A,
+                                     const VT2& x, size_t begin, size_t end )
+   {
+      for( size_t p=begin; p<end; ++p ) {
+         ElementType* y( buffer + p*M );
+         std::fill( y, y+M, ElementType() );
+         addAssignKernel( y, A, x, bounds[p], bounds[p+1UL] );
+      }
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
    //**Addition assignment to sparse vectors*******************************************************
    // No special implementation for the addition assignment to sparse vectors.
    //**********************************************************************************************
@@ -379,19 +611,17 @@ class TSMatDVecMultExpr : public DenseVector< TSMatDVecMultExpr<MT,VT>, false >
    // \param rhs The right-hand side multiplication expression to be subtracted.
    // \return void
    //
-   // This function implements the performance optimized subtraction assignment of a sparse matrix-
-   // dense vector multiplication expression to a dense vector. Due to the explicit application
-   // of the SFINAE principle, this operator can only be selected by the compiler in case either
-   // the left-hand side matrix operand requires an intermediate evaluation or the right-hand
-   // side vector operand is a compound expression.
+   // This function implements the performance optimized subtraction assignment of a transpose
+   // sparse matrix-dense vector multiplication expression to a dense vector. In case the number of
+   // columns of the sparse matrix exceeds the SMP_TSMATDVECMULT_THRESHOLD, the columns are
+   // partitioned into blocks of approximately equal number of non-zero elements, which are
+   // accumulated in parallel into thread-local vectors (see \ref smp).
    */
    template< typename VT1 >  // Type of the target dense vector
    friend inline void subAssign( DenseVector<VT1,false>& lhs, const TSMatDVecMultExpr& rhs )
    {
       BLAZE_INTERNAL_ASSERT( (~lhs).size() == rhs.size(), "Invalid vector sizes" );
 
-      typedef typename boost::remove_reference<LT>::type::ConstIterator  ConstIterator;
-
       if( rhs.mat_.columns() == 0UL ) return;
 
       LT A( rhs.mat_ );  // Evaluation of the left-hand side sparse matrix operand
@@ -402,19 +632,138 @@ class TSMatDVecMultExpr : public DenseVector< TSMatDVecMultExpr<MT,VT>, false >
       BLAZE_INTERNAL_ASSERT( x.size()    == rhs.vec_.size()   , "Invalid vector size"       );
       BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).size()     , "Invalid vector size"       );
 
-      for( size_t j=0UL; j<A.columns(); ++j )
+      if( IsResizable<ElementType>::value || A.columns() < SMP_TSMATDVECMULT_THRESHOLD ) {
+         TSMatDVecMultExpr::subAssignKernel( ~lhs, A, x, 0UL, A.columns() );
+      }
+      else {
+         TSMatDVecMultExpr::smpSubAssignKernel( ~lhs, A, x );
+      }
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Default subtraction assignment to dense vectors (column range)******************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Default subtraction assignment of a range of columns of a transpose sparse matrix-dense
+   //        vector multiplication (\f$ \vec{y}-=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \param jbegin The first column of the range.
+   // \param jend The end of the column range.
+   // \return void
+   //
+   // This function implements the default subtraction assignment kernel for the columns
+   // \f$ [jbegin..jend) \f$ of the transpose sparse matrix-dense vector multiplication. The
+   // elements of \a y that are indexed by the upcoming non-zero elements of a column are prefetched
+   // (see the prefetchDistance setting). The target \a y may also be a plain array.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void
+      subAssignKernel( VT1& y, const MT1& A, const VT2& x, size_t jbegin, size_t jend )
+   {
+      typedef typename MT1::ConstIterator  ConstIterator;
+
+      BLAZE_INTERNAL_ASSERT( jbegin <= jend && jend <= A.columns(), "Invalid column range" );
+
+      for( size_t j=jbegin; j<jend; ++j )
       {
-         ConstIterator element( A.begin(j) );
          const ConstIterator end( A.end(j) );
+         ConstIterator element( A.begin(j) );
+         ConstIterator ahead( element );
+
+         for( size_t k=0UL; k<prefetchDistance && ahead!=end; ++k, ++ahead )
+            prefetch( &y[ahead->index()] );
 
          for( ; element!=end; ++element ) {
-            (~lhs)[element->index()] -= element->value() * x[j];
+            if( ahead != end ) {
+               prefetch( &y[ahead->index()] );
+               ++ahead;
+            }
+            y[element->index()] -= element->value() * x[j];
          }
       }
    }
    /*! \endcond */
    //**********************************************************************************************
 
+   //**Parallel subtraction assignment to dense vectors********************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Parallel subtraction assignment of a transpose sparse matrix-dense vector
+   //        multiplication (\f$ \vec{y}-=A*\vec{x} \f$).
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param A The left-hand side sparse matrix operand.
+   // \param x The right-hand side dense vector operand.
+   // \return void
+   //
+   // This function partitions the columns of \a A into one block of approximately equal number of
+   // non-zero elements per thread (see partitionNonZeros()). Each block is accumulated into a
+   // separate thread-local vector, which avoids any write conflicts between the threads. Afterwards
+   // the thread-local vectors are reduced in parallel into the target vector.
+   */
+   template< typename VT1    // Type of the left-hand side target vector
+           , typename MT1    // Type of the left-hand side matrix operand
+           , typename VT2 >  // Type of the right-hand side vector operand
+   static inline void smpSubAssignKernel( VT1& y, const MT1& A, const VT2& x )
+   {
+      const size_t threads( getNumThreads() );
+
+      if( threads == 1UL ) {
+         subAssignKernel( y, A, x, 0UL, A.columns() );
+         return;
+      }
+
+      std::vector<size_t> bounds;
+      partitionNonZeros( A, threads, bounds );
+
+      const size_t parts( bounds.size() - 1UL );
+      const size_t M( A.rows() );
+
+      const AlignedArray<ElementType> buffer( parts*M );
+
+      smpFor( parts, 1UL, boost::bind( &This::template partialKernel<MT1,VT2>, buffer.get(), M,
+                                       boost::cref( bounds ), boost::cref( A ),
+                                       boost::cref( x ), _1, _2 ) );
+
+      smpFor( M, 64UL, boost::bind( &This::template reduceSubAssignKernel<VT1>, boost::ref( y ),
+                                    buffer.get(), M, parts, _1, _2 ) );
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Reduction subtraction assignment to dense vectors*******************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief Reduction subtraction assignment of a range of thread-local vectors to a dense vector.
+   // \ingroup dense_vector
+   //
+   // \param y The target left-hand side dense vector.
+   // \param buffer The thread-local vectors.
+   // \param M The size of each thread-local vector.
+   // \param parts The number of thread-local vectors.
+   // \param begin The first element of the range.
+   // \param end The end of the element range.
+   // \return void
+   */
+   template< typename VT1 >  // Type of the left-hand side target vector
+   static inline void reduceSubAssignKernel( VT1& y, const ElementType* buffer, size_t M,
+                                             size_t parts, size_t begin, size_t end )
+   {
+      for( size_t i=begin; i<end; ++i ) {
+         ElementType tmp( buffer[i] );
+         for( size_t p=1UL; p<parts; ++p )
+            tmp += buffer[p*M+i];
+         y[i] -= tmp;
+      }
+   }
+   /*! \endcond */
+   //**********************************************************************************************
+
    //**Subtraction assignment to sparse vectors****************************************************
    // No special implementation for the subtraction assignment to sparse vectors.
    //**********************************************************************************************
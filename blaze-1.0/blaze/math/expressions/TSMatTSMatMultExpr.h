@@ -34,14 +34,12 @@
 #include <blaze/math/constraints/SparseVector.h>
 #include <blaze/math/constraints/StorageOrder.h>
 #include <blaze/math/constraints/TransposeFlag.h>
-#include <blaze/math/DynamicVector.h>
 #include <blaze/math/Expression.h>
 #include <blaze/math/expressions/Forward.h>
 #include <blaze/math/expressions/SparseMatrix.h>
-#include <blaze/math/Infinity.h>
 #include <blaze/math/MathTrait.h>
 #include <blaze/math/shims/IsDefault.h>
-#include <blaze/math/shims/Reset.h>
+#include <blaze/math/sparse/SpGemm.h>
 #include <blaze/math/traits/TSMatDVecMultTrait.h>
 #include <blaze/math/traits/TSMatSVecMultTrait.h>
 #include <blaze/math/traits/TDVecTSMatMultTrait.h>
@@ -54,7 +52,6 @@
 #include <blaze/util/EnableIf.h>
 #include <blaze/util/SelectType.h>
 #include <blaze/util/Types.h>
-#include <blaze/util/typetraits/IsBuiltin.h>
 #include <blaze/util/typetraits/IsReference.h>
 
 
@@ -395,7 +392,11 @@ class TSMatTSMatMultExpr : public SparseMatrix< TSMatTSMatMultExpr<MT1,MT2>, tru
    // \return void
    //
    // This function implements the performance optimized assignment of a transpose sparse matrix-
-   // transpose sparse matrix multiplication expression to a column-major sparse matrix.
+   // transpose sparse matrix multiplication expression to a column-major sparse matrix. The
+   // columns of the result are computed by a two-phase (symbolic/numeric) Gustavson multiplication,
+   // which presizes each column to its exact number of non-zero elements. In case the number of
+   // columns exceeds the SMP_SMATSMATMULT_THRESHOLD, the columns are computed in parallel (see
+   // spgemm()).
    */
    template< typename MT >  // Type of the target sparse matrix
    friend inline void assign( SparseMatrix<MT,true>& lhs, const TSMatTSMatMultExpr& rhs )
@@ -403,9 +404,6 @@ class TSMatTSMatMultExpr : public SparseMatrix< TSMatTSMatMultExpr<MT1,MT2>, tru
       BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
       BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-      typedef typename boost::remove_reference<CT1>::type::ConstIterator  LeftIterator;
-      typedef typename boost::remove_reference<CT2>::type::ConstIterator  RightIterator;
-
       CT1 A( rhs.lhs_ );  // Evaluation of the left-hand side sparse matrix operand
       CT2 B( rhs.rhs_ );  // Evaluation of the right-hand side sparse matrix operand
 
@@ -416,62 +414,7 @@ class TSMatTSMatMultExpr : public SparseMatrix< TSMatTSMatMultExpr<MT1,MT2>, tru
       BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).rows()     , "Invalid number of rows"    );
       BLAZE_INTERNAL_ASSERT( B.columns() == (~lhs).columns()  , "Invalid number of columns" );
 
-      // (Over-)Estimating the number of non-zero entries in the resulting matrix
-      size_t nonzeros( 0UL );
-
-      for( size_t j=0UL; j<(~lhs).columns(); ++j ) {
-         const RightIterator rend( B.end(j) );
-         for( RightIterator relem=B.begin(j); relem!=rend; ++relem ) {
-            nonzeros += A.nonZeros( relem->index() );
-         }
-      }
-
-      (~lhs).reserve( nonzeros );
-      nonzeros = 0UL;
-
-      // Performing the matrix-matrix multiplication
-      DynamicVector<ElementType> tmp( (~lhs).rows() );
-      size_t minIndex( inf ), maxIndex( 0UL );
-
-      if( IsBuiltin<ElementType>::value )
-         tmp.reset();
-
-      for( size_t j=0UL; j<(~lhs).columns(); ++j )
-      {
-         const RightIterator rend( B.end(j) );
-         for( RightIterator relem=B.begin(j); relem!=rend; ++relem )
-         {
-            const LeftIterator lend( A.end( relem->index() ) );
-            for( LeftIterator lelem=A.begin( relem->index() ); lelem!=lend; ++lelem )
-            {
-               if( isDefault( tmp[lelem->index()] ) ) {
-                  if( lelem->index() < minIndex ) minIndex = lelem->index();
-                  if( lelem->index() > maxIndex ) maxIndex = lelem->index();
-                  ++nonzeros;
-                  tmp[lelem->index()] = lelem->value() * relem->value();
-               }
-               else {
-                  tmp[lelem->index()] += lelem->value() * relem->value();
-               }
-            }
-         }
-
-         if( nonzeros > 0UL )
-         {
-            for( size_t i=minIndex; i<=maxIndex; ++i ) {
-               if( !isDefault( tmp[i] ) ) {
-                  (~lhs).append( i, j, tmp[i] );
-                  reset( tmp[i] );
-               }
-            }
-
-            nonzeros = 0UL;
-            minIndex = inf;
-            maxIndex = 0UL;
-         }
-
-         (~lhs).finalize( j );
-      }
+      spgemm( ~lhs, A, B );
    }
    /*! \endcond */
    //**********************************************************************************************
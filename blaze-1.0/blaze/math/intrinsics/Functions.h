@@ -199,6 +199,111 @@ inline sse_double_t load( const double* address )
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Loads a vector of 'float' values from an unaligned address.
+// \ingroup intrinsics
+//
+// \param address The first 'float' value to be loaded.
+// \return The loaded vector of 'float' values.
+*/
+inline sse_float_t loadu( const float* address )
+{
+#if BLAZE_AVX_MODE
+   return _mm256_loadu_ps( address );
+#elif BLAZE_SSE_MODE
+   return _mm_loadu_ps( address );
+#else
+   return *address;
+#endif
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Loads a vector of 'double' values from an unaligned address.
+// \ingroup intrinsics
+//
+// \param address The first 'double' value to be loaded.
+// \return The loaded vector of 'double' values.
+*/
+inline sse_double_t loadu( const double* address )
+{
+#if BLAZE_AVX_MODE
+   return _mm256_loadu_pd( address );
+#elif BLAZE_SSE2_MODE
+   return _mm_loadu_pd( address );
+#else
+   return *address;
+#endif
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  GATHER FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Loads a vector of indirectly addressed 'float' values.
+// \ingroup intrinsics
+//
+// \param base The base address of the 'float' values.
+// \param indices The indices of the values to be loaded relative to \a base.
+// \return The loaded vector of 'float' values.
+//
+// This function loads the values \f$ base[indices[0]], base[indices[1]], \ldots \f$ into a
+// single intrinsic vector. In case AVX2 is available, the values are loaded via a single gather
+// instruction. The \a indices array is not required to be aligned.
+*/
+inline sse_float_t gather( const float* base, const int* indices )
+{
+#if BLAZE_AVX2_MODE
+   const __m256i tmp( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( indices ) ) );
+   return _mm256_i32gather_ps( base, tmp, 4 );
+#elif BLAZE_AVX_MODE
+   return _mm256_set_ps( base[indices[7]], base[indices[6]], base[indices[5]], base[indices[4]],
+                         base[indices[3]], base[indices[2]], base[indices[1]], base[indices[0]] );
+#elif BLAZE_SSE_MODE
+   return _mm_set_ps( base[indices[3]], base[indices[2]], base[indices[1]], base[indices[0]] );
+#else
+   return base[indices[0]];
+#endif
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Loads a vector of indirectly addressed 'double' values.
+// \ingroup intrinsics
+//
+// \param base The base address of the 'double' values.
+// \param indices The indices of the values to be loaded relative to \a base.
+// \return The loaded vector of 'double' values.
+//
+// This function loads the values \f$ base[indices[0]], base[indices[1]], \ldots \f$ into a
+// single intrinsic vector. In case AVX2 is available, the values are loaded via a single gather
+// instruction. The \a indices array is not required to be aligned.
+*/
+inline sse_double_t gather( const double* base, const int* indices )
+{
+#if BLAZE_AVX2_MODE
+   const __m128i tmp( _mm_loadu_si128( reinterpret_cast<const __m128i*>( indices ) ) );
+   return _mm256_i32gather_pd( base, tmp, 8 );
+#elif BLAZE_AVX_MODE
+   return _mm256_set_pd( base[indices[3]], base[indices[2]], base[indices[1]], base[indices[0]] );
+#elif BLAZE_SSE2_MODE
+   return _mm_set_pd( base[indices[1]], base[indices[0]] );
+#else
+   return base[indices[0]];
+#endif
+}
+//*************************************************************************************************
+
+
 
 
 //=================================================================================================
@@ -669,6 +774,38 @@ inline void stream( double* address, sse_double_t value )
 
 
 
+//=================================================================================================
+//
+//  PREFETCH FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Prefetching of the cache line containing the given address.
+// \ingroup intrinsics
+//
+// \param address The address to be prefetched.
+// \return void
+//
+// This function hints the processor to load the cache line containing the given address into
+// all levels of the cache hierarchy. The function has no effect on the program semantics and
+// is a no-op in case no SSE support is available. The given address is not required to be
+// aligned and is never dereferenced.
+*/
+template< typename Type >  // Data type of the prefetched value
+inline void prefetch( const Type* address )
+{
+#if BLAZE_SSE_MODE
+   _mm_prefetch( reinterpret_cast<const char*>( address ), _MM_HINT_T0 );
+#else
+   static_cast<void>( address );
+#endif
+}
+//*************************************************************************************************
+
+
+
+
 //=================================================================================================
 //
 //  INTRINSIC SETZERO FUNCTIONS
@@ -1305,8 +1442,7 @@ inline float sum( sse_float_t a )
 #if BLAZE_AVX_MODE
    const sse_float_t b( _mm256_hadd_ps( a.value, a.value ) );
    const sse_float_t c( _mm256_hadd_ps( b.value, b.value ) );
-   const sse_float_t d( _mm256_hadd_ps( c.value, c.value ) );
-   return d.values[0];
+   return c.values[0] + c.values[4];
 #elif BLAZE_SSE3_MODE
    const sse_float_t b( _mm_hadd_ps( a.value, a.value ) );
    const sse_float_t c( _mm_hadd_ps( b.value, b.value ) );
@@ -1331,8 +1467,7 @@ inline double sum( sse_double_t a )
 {
 #if BLAZE_AVX_MODE
    const sse_double_t b( _mm256_hadd_pd( a.value, a.value ) );
-   const sse_double_t c( _mm256_hadd_pd( b.value, b.value ) );
-   return c.values[0];
+   return b.values[0] + b.values[2];
 #elif BLAZE_SSE3_MODE
    const sse_double_t b( _mm_hadd_pd( a.value, a.value ) );
    return b.values[0];
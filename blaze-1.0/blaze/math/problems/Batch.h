@@ -0,0 +1,450 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/problems/Batch.h
+//  \brief Data structure for batches of small linear systems and complementarity problems
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_PROBLEMS_BATCH_H_
+#define _BLAZE_MATH_PROBLEMS_BATCH_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <blaze/math/Functions.h>
+#include <blaze/math/problems/LCP.h>
+#include <blaze/math/problems/LSE.h>
+#include <blaze/system/Precision.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief A data structure for batches of small, independent problems.
+// \ingroup math
+//
+// The Batch class stores a large number of small, independent problems of type \a P (LSE or
+// LCP) in packed arrays: the dense, row-major system matrices of all problems are stored
+// consecutively in a single array, and so are the right-hand side vectors and the vectors of
+// unknowns. Therefore adding a problem to a batch does not require any individual memory
+// allocation, and the problems can be solved by a single call to a batched solver (see for
+// instance GaussianElimination, Lemke and PGS):
+
+   \code
+   blaze::Batch<blaze::LCP> batch;
+
+   for( size_t k=0; k<islands; ++k ) {
+      const size_t p( batch.add( n ) );  // Adding an LCP of size n
+      real* A( batch.A( p ) );           // The row-major n x n system matrix
+      real* b( batch.b( p ) );           // The right-hand side vector
+      // ... Setup of the LCP
+   }
+
+   blaze::PGS pgs;
+   pgs.solve( batch );
+   \endcode
+
+// The problems of a batch follow the formulation of the according single problem type, i.e.
+// \f$ A \cdot x + b = 0 \f$ for linear systems of equations and \f$ A \cdot x + b \geq 0
+// \quad\perp\quad x \geq 0 \f$ for linear complementarity problems.
+*/
+template< typename P >  // Type of the problems
+struct Batch
+{
+ public:
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   inline size_t      problems()                          const;
+   inline size_t      size    ( size_t k )                const;
+   inline size_t      add     ( size_t n );
+   inline void        reserve ( size_t problems, size_t n );
+   inline void        clear   ();
+   inline real*       A       ( size_t k );
+   inline const real* A       ( size_t k )                const;
+   inline real*       b       ( size_t k );
+   inline const real* b       ( size_t k )                const;
+   inline real*       x       ( size_t k );
+   inline const real* x       ( size_t k )                const;
+   inline real        residual( size_t k, size_t index )  const;
+   inline real        residual( size_t k )                const;
+   inline real        residual()                          const;
+   inline void        group   ( size_t lanes, std::vector<size_t>& order,
+                                std::vector<size_t>& bounds ) const;
+   //@}
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   /*!\name Member variables */
+   //@{
+   std::vector<size_t> sizes_;     //!< The sizes of the problems.
+   std::vector<size_t> matrices_;  //!< The offsets of the system matrices within \a A_.
+   std::vector<size_t> vectors_;   //!< The offsets of the vectors within \a b_ and \a x_.
+   std::vector<real>   A_;         //!< The packed row-major system matrices \f$ A \f$.
+   std::vector<real>   b_;         //!< The packed right-hand side vectors \f$ b \f$.
+   std::vector<real>   x_;         //!< The packed vectors of unknowns \f$ x \f$.
+   //@}
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the number of problems in the batch.
+//
+// \return The number of problems.
+*/
+template< typename P >  // Type of the problems
+inline size_t Batch<P>::problems() const
+{
+   return sizes_.size();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the size of the specified problem.
+//
+// \param k The index of the problem \f$[0..problems)\f$.
+// \return The number of unknowns of the problem.
+*/
+template< typename P >  // Type of the problems
+inline size_t Batch<P>::size( size_t k ) const
+{
+   BLAZE_USER_ASSERT( k < sizes_.size(), "Invalid problem index" );
+   return sizes_[k];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Adds a new problem of the given size to the batch.
+//
+// \param n The number of unknowns of the new problem.
+// \return The index of the new problem.
+//
+// This function appends a problem of size \a n to the batch. The system matrix, the right-hand
+// side vector and the vector of unknowns of the new problem are initialized to zero. Note that
+// adding a problem may invalidate all pointers previously returned by the A(), b() and x()
+// functions.
+*/
+template< typename P >  // Type of the problems
+inline size_t Batch<P>::add( size_t n )
+{
+   BLAZE_USER_ASSERT( n > 0, "Invalid problem size" );
+
+   sizes_.push_back( n );
+   matrices_.push_back( A_.size() );
+   vectors_.push_back( b_.size() );
+
+   A_.resize( A_.size() + n*n, real(0) );
+   b_.resize( b_.size() + n, real(0) );
+   x_.resize( x_.size() + n, real(0) );
+
+   return sizes_.size() - 1;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Setting the minimum capacity of the batch.
+//
+// \param problems The expected number of problems.
+// \param n The expected average size of the problems.
+// \return void
+*/
+template< typename P >  // Type of the problems
+inline void Batch<P>::reserve( size_t problems, size_t n )
+{
+   sizes_.reserve( problems );
+   matrices_.reserve( problems );
+   vectors_.reserve( problems );
+   A_.reserve( problems*n*n );
+   b_.reserve( problems*n );
+   x_.reserve( problems*n );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Removes all problems from the batch.
+//
+// \return void
+//
+// This function removes all problems, but retains the capacity of the batch, i.e. refilling
+// the batch with problems of similar size does not require any memory allocation.
+*/
+template< typename P >  // Type of the problems
+inline void Batch<P>::clear()
+{
+   sizes_.clear();
+   matrices_.clear();
+   vectors_.clear();
+   A_.clear();
+   b_.clear();
+   x_.clear();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a pointer to the row-major system matrix of the specified problem.
+//
+// \param k The index of the problem \f$[0..problems)\f$.
+// \return Pointer to the first element of the \f$ n \times n \f$ system matrix.
+*/
+template< typename P >  // Type of the problems
+inline real* Batch<P>::A( size_t k )
+{
+   BLAZE_USER_ASSERT( k < sizes_.size(), "Invalid problem index" );
+   return &A_[0] + matrices_[k];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a pointer to the row-major system matrix of the specified problem.
+//
+// \param k The index of the problem \f$[0..problems)\f$.
+// \return Pointer to the first element of the \f$ n \times n \f$ system matrix.
+*/
+template< typename P >  // Type of the problems
+inline const real* Batch<P>::A( size_t k ) const
+{
+   BLAZE_USER_ASSERT( k < sizes_.size(), "Invalid problem index" );
+   return &A_[0] + matrices_[k];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a pointer to the right-hand side vector of the specified problem.
+//
+// \param k The index of the problem \f$[0..problems)\f$.
+// \return Pointer to the first element of the right-hand side vector.
+*/
+template< typename P >  // Type of the problems
+inline real* Batch<P>::b( size_t k )
+{
+   BLAZE_USER_ASSERT( k < sizes_.size(), "Invalid problem index" );
+   return &b_[0] + vectors_[k];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a pointer to the right-hand side vector of the specified problem.
+//
+// \param k The index of the problem \f$[0..problems)\f$.
+// \return Pointer to the first element of the right-hand side vector.
+*/
+template< typename P >  // Type of the problems
+inline const real* Batch<P>::b( size_t k ) const
+{
+   BLAZE_USER_ASSERT( k < sizes_.size(), "Invalid problem index" );
+   return &b_[0] + vectors_[k];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a pointer to the vector of unknowns of the specified problem.
+//
+// \param k The index of the problem \f$[0..problems)\f$.
+// \return Pointer to the first element of the vector of unknowns.
+*/
+template< typename P >  // Type of the problems
+inline real* Batch<P>::x( size_t k )
+{
+   BLAZE_USER_ASSERT( k < sizes_.size(), "Invalid problem index" );
+   return &x_[0] + vectors_[k];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a pointer to the vector of unknowns of the specified problem.
+//
+// \param k The index of the problem \f$[0..problems)\f$.
+// \return Pointer to the first element of the vector of unknowns.
+*/
+template< typename P >  // Type of the problems
+inline const real* Batch<P>::x( size_t k ) const
+{
+   BLAZE_USER_ASSERT( k < sizes_.size(), "Invalid problem index" );
+   return &x_[0] + vectors_[k];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Calculates the residual of an unknown of a linear system of equations.
+//
+// \param k The index of the problem \f$[0..problems)\f$.
+// \param index The index of the unknown \f$[0..size(k))\f$.
+// \return The residual \f$ (A \cdot x + b)_{index} \f$.
+*/
+template<>
+inline real Batch<LSE>::residual( size_t k, size_t index ) const
+{
+   const size_t n( sizes_[k] );
+   const real* const a ( A( k ) + index*n );
+   const real* const xk( x( k ) );
+
+   real r( b( k )[index] );
+   for( size_t j=0; j<n; ++j )
+      r += a[j] * xk[j];
+
+   return r;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Calculates the residual of an unknown of a linear complementarity problem.
+//
+// \param k The index of the problem \f$[0..problems)\f$.
+// \param index The index of the unknown \f$[0..size(k))\f$.
+// \return The residual \f$ \min( x_{index}, (A \cdot x + b)_{index} ) \f$.
+*/
+template<>
+inline real Batch<LCP>::residual( size_t k, size_t index ) const
+{
+   const size_t n( sizes_[k] );
+   const real* const a ( A( k ) + index*n );
+   const real* const xk( x( k ) );
+
+   real r( b( k )[index] );
+   for( size_t j=0; j<n; ++j )
+      r += a[j] * xk[j];
+
+   return min( xk[index], r );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Calculates the maximum norm of the residual of the specified problem.
+//
+// \param k The index of the problem \f$[0..problems)\f$.
+// \return The maximum norm of the residual of the problem.
+*/
+template< typename P >  // Type of the problems
+inline real Batch<P>::residual( size_t k ) const
+{
+   real rmax( 0 );
+
+   for( size_t i=0; i<sizes_[k]; ++i )
+      rmax = max( rmax, std::fabs( residual( k, i ) ) );
+
+   return rmax;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Calculates the maximum norm of the residuals of all problems of the batch.
+//
+// \return The maximum norm of the residuals of all problems.
+*/
+template< typename P >  // Type of the problems
+inline real Batch<P>::residual() const
+{
+   real rmax( 0 );
+
+   for( size_t k=0; k<sizes_.size(); ++k )
+      rmax = max( rmax, residual( k ) );
+
+   return rmax;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Groups the problems of the batch by size.
+//
+// \param lanes The maximum number of problems per group.
+// \param order The resulting order of the problems.
+// \param bounds The resulting bounds of the groups within \a order.
+// \return void
+//
+// This function sorts the problems by size and subsequently groups consecutive problems of the
+// same size into groups of exactly \a lanes problems. The remaining problems of each size form
+// groups of a single problem. Group \a g consists of the problems
+// \f$ order[bounds[g]..bounds[g+1]) \f$. The groups are used by the batched solvers to solve
+// problems of the same size simultaneously (one problem per SIMD lane).
+*/
+template< typename P >  // Type of the problems
+inline void Batch<P>::group( size_t lanes, std::vector<size_t>& order,
+                             std::vector<size_t>& bounds ) const
+{
+   BLAZE_INTERNAL_ASSERT( lanes > 0, "Invalid number of lanes" );
+
+   const size_t N( sizes_.size() );
+
+   std::vector< std::pair<size_t,size_t> > keys( N );
+   for( size_t k=0; k<N; ++k )
+      keys[k] = std::make_pair( sizes_[k], k );
+
+   std::sort( keys.begin(), keys.end() );
+
+   order.resize( N );
+   for( size_t k=0; k<N; ++k )
+      order[k] = keys[k].second;
+
+   bounds.clear();
+   bounds.push_back( 0 );
+
+   for( size_t k=0; k<N; )
+   {
+      size_t end( k );
+      while( end < N && keys[end].first == keys[k].first )
+         ++end;
+
+      for( ; k+lanes<=end; k+=lanes )
+         bounds.push_back( k+lanes );
+      for( ; k<end; ++k )
+         bounds.push_back( k+1 );
+   }
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
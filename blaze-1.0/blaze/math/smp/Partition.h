@@ -0,0 +1,310 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/smp/Partition.h
+//  \brief Header file for the workload balanced partitioning of sparse matrices
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_SMP_PARTITION_H_
+#define _BLAZE_MATH_SMP_PARTITION_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <vector>
+#include <blaze/math/expressions/SparseMatrix.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/math/Types.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  PARTITIONING FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Partitioning of the rows/columns of a sparse matrix into blocks of equal workload.
+// \ingroup smp
+//
+// \param sm The sparse matrix to be partitioned.
+// \param parts The number of partitions \f$[1..\infty)\f$.
+// \param bounds The resulting \a parts+1 partition bounds.
+// \return void
+//
+// This function partitions the rows (in case of a row-major matrix) or the columns (in case of
+// a column-major matrix) of the given sparse matrix into \a parts contiguous blocks with an
+// approximately equal workload, where the workload of a row/column is estimated by its number
+// of non-zero elements plus one. Partition \a p consists of the rows/columns
+// \f$ [bounds[p]..bounds[p+1]) \f$. The function scans the number of non-zero elements of all
+// rows/columns.
+*/
+template< typename MT  // Type of the sparse matrix
+        , bool SO >    // Storage order
+void partitionNonZeros( const SparseMatrix<MT,SO>& sm, size_t parts, std::vector<size_t>& bounds )
+{
+   BLAZE_INTERNAL_ASSERT( parts > 0UL, "Invalid number of partitions" );
+
+   const size_t n( ( SO )?( (~sm).columns() ):( (~sm).rows() ) );
+
+   size_t total( n );
+   for( size_t i=0UL; i<n; ++i )
+      total += (~sm).nonZeros( i );
+
+   bounds.resize( parts+1UL );
+   bounds[0UL] = 0UL;
+
+   size_t p( 1UL );
+   size_t work( 0UL );
+
+   for( size_t i=0UL; i<n && p<parts; ++i ) {
+      work += (~sm).nonZeros( i ) + 1UL;
+      while( p < parts && work*parts >= total*p )
+         bounds[p++] = i+1UL;
+   }
+
+   for( ; p<=parts; ++p )
+      bounds[p] = n;
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Partitioning of the rows/columns of a compressed matrix into blocks of equal workload.
+// \ingroup smp
+//
+// \param sm The compressed matrix to be partitioned.
+// \param parts The number of partitions \f$[1..\infty)\f$.
+// \param bounds The resulting \a parts+1 partition bounds.
+// \return void
+//
+// This overload of the partitionNonZeros() function exploits the contiguous storage of the
+// rows/columns of a CompressedMatrix: the offset of the first element of a row/column within
+// the storage directly yields the accumulated workload of all preceding rows/columns. Therefore
+// the partition bounds are determined by binary search in \f$ O(parts \cdot \log n) \f$ time.
+// Note that the workload estimate includes the reserved, but unused capacity of the rows/columns.
+*/
+template< typename Type  // Data type of the compressed matrix
+        , bool SO >      // Storage order
+void partitionNonZeros( const CompressedMatrix<Type,SO>& sm, size_t parts,
+                        std::vector<size_t>& bounds )
+{
+   BLAZE_INTERNAL_ASSERT( parts > 0UL, "Invalid number of partitions" );
+
+   const size_t n( ( SO )?( sm.columns() ):( sm.rows() ) );
+
+   bounds.resize( parts+1UL );
+   bounds[0UL] = 0UL;
+
+   if( n == 0UL ) {
+      for( size_t p=1UL; p<=parts; ++p )
+         bounds[p] = 0UL;
+      return;
+   }
+
+   const size_t total( n + ( sm.end(n-1UL) - sm.begin(0UL) ) );
+
+   for( size_t p=1UL; p<parts; ++p )
+   {
+      const size_t target( ( total * p ) / parts );
+
+      size_t low ( bounds[p-1UL] );
+      size_t high( n );
+
+      while( low < high ) {
+         const size_t mid( low + ( high - low ) / 2UL );
+         if( mid + static_cast<size_t>( sm.begin(mid) - sm.begin(0UL) ) < target )
+            low = mid + 1UL;
+         else
+            high = mid;
+      }
+
+      bounds[p] = low;
+   }
+
+   bounds[parts] = n;
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Partitioning of the rows of a CSR matrix into blocks of equal workload.
+// \ingroup smp
+//
+// \param sm The CSR matrix to be partitioned.
+// \param parts The number of partitions \f$[1..\infty)\f$.
+// \param bounds The resulting \a parts+1 partition bounds.
+// \return void
+//
+// This overload of the partitionNonZeros() function determines the partition bounds by binary
+// search within the row offsets of the CSRMatrix in \f$ O(parts \cdot \log n) \f$ time.
+*/
+template< typename Type >  // Data type of the CSR matrix
+void partitionNonZeros( const CSRMatrix<Type>& sm, size_t parts, std::vector<size_t>& bounds )
+{
+   BLAZE_INTERNAL_ASSERT( parts > 0UL, "Invalid number of partitions" );
+
+   const size_t n( sm.rows() );
+
+   bounds.resize( parts+1UL );
+   bounds[0UL] = 0UL;
+
+   const size_t total( n + sm.nonZeros() );
+
+   for( size_t p=1UL; p<parts; ++p )
+   {
+      const size_t target( ( total * p ) / parts );
+
+      size_t low ( bounds[p-1UL] );
+      size_t high( n );
+
+      while( low < high ) {
+         const size_t mid( low + ( high - low ) / 2UL );
+         if( mid + static_cast<size_t>( sm.offsets()[mid] ) < target )
+            low = mid + 1UL;
+         else
+            high = mid;
+      }
+
+      bounds[p] = low;
+   }
+
+   bounds[parts] = n;
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Partitioning of a range of rows/columns with given workload into blocks of equal workload.
+// \ingroup smp
+//
+// \param work The workload of each row/column.
+// \param parts The number of partitions \f$[1..\infty)\f$.
+// \param bounds The resulting \a parts+1 partition bounds.
+// \return void
+//
+// This function partitions the rows/columns \f$ [0..work.size()) \f$ into \a parts contiguous
+// blocks with an approximately equal workload, where the workload of row/column \a i is given
+// by \a work[i] plus one. In contrast to partitionNonZeros(), which estimates the workload by
+// the number of non-zero elements, this function can be used for operations with a workload
+// that is not proportional to the number of non-zero elements (as for instance the sparse
+// matrix/sparse matrix multiplication).
+*/
+inline void partitionWork( const std::vector<size_t>& work, size_t parts,
+                           std::vector<size_t>& bounds )
+{
+   BLAZE_INTERNAL_ASSERT( parts > 0UL, "Invalid number of partitions" );
+
+   const size_t n( work.size() );
+
+   size_t total( n );
+   for( size_t i=0UL; i<n; ++i )
+      total += work[i];
+
+   bounds.resize( parts+1UL );
+   bounds[0UL] = 0UL;
+
+   size_t p( 1UL );
+   size_t sum( 0UL );
+
+   for( size_t i=0UL; i<n && p<parts; ++i ) {
+      sum += work[i] + 1UL;
+      while( p < parts && sum*parts >= total*p )
+         bounds[p++] = i+1UL;
+   }
+
+   for( ; p<=parts; ++p )
+      bounds[p] = n;
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  PARTITION TASKS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Range task for the parallel execution of a task on a set of partitions.
+// \ingroup smp
+//
+// The PartitionTask class maps a range of partitions to the according range of rows/columns
+// and calls the given range task for the resulting range.
+*/
+template< typename Task >  // Type of the range task
+struct PartitionTask
+{
+   typedef void  result_type;  //!< Result type of the task.
+
+   inline PartitionTask( const std::vector<size_t>& bounds, Task task )
+      : bounds_( &bounds ), task_( task ) {}
+
+   inline void operator()( size_t begin, size_t end ) const {
+      task_( (*bounds_)[begin], (*bounds_)[end] );
+   }
+
+   const std::vector<size_t>* bounds_;  //!< The partition bounds.
+   Task task_;                          //!< The range task.
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Parallel execution of a task on the given partitions.
+// \ingroup smp
+//
+// \param bounds The \a parts+1 partition bounds.
+// \param task The task to be executed on the rows/columns of the partitions.
+// \return void
+//
+// This function executes the given range task for all partitions defined by \a bounds (see
+// partitionNonZeros()). In case the number of partitions matches the number of threads, each
+// thread executes exactly one partition.
+*/
+template< typename Task >  // Type of the range task
+void smpForPartitions( const std::vector<size_t>& bounds, Task task )
+{
+   BLAZE_INTERNAL_ASSERT( bounds.size() > 1UL, "Invalid partition bounds" );
+
+   smpFor( bounds.size()-1UL, 1UL, PartitionTask<Task>( bounds, task ) );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
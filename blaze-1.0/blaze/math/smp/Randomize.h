@@ -0,0 +1,132 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/smp/Randomize.h
+//  \brief Header file for the parallel random initialization of vectors and matrices
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_SMP_RANDOMIZE_H_
+#define _BLAZE_MATH_SMP_RANDOMIZE_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <vector>
+#include <blaze/util/Random.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  RANDOM INITIALIZATION TASKS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Range task for the parallel random initialization of a dense vector or matrix.
+// \ingroup smp
+//
+// The DenseRandomizeTask class fills a range of rows/columns of a dense matrix with random
+// values, where each row/column consists of \a length elements and two consecutive rows/columns
+// are \a spacing elements apart. A dense vector is treated as a matrix with a single element
+// per row. Row/column \a i is filled with the values \f$ [i \cdot length..(i+1) \cdot length) \f$
+// of the given random number generator, which makes the result independent of the partitioning.
+*/
+template< typename Type >  // Data type of the elements
+struct DenseRandomizeTask
+{
+   typedef void  result_type;  //!< Result type of the task.
+
+   inline DenseRandomizeTask( Type* data, size_t length, size_t spacing,
+                              const RNG& rng, Type min, Type max )
+      : data_( data ), length_( length ), spacing_( spacing ), rng_( rng ), min_( min ), max_( max ) {}
+
+   inline void operator()( size_t begin, size_t end ) const {
+      RNG rng( rng_ );
+      rng.skip<Type>( begin*length_ );
+      if( length_ == spacing_ )
+         rng.fill( data_+begin*spacing_, ( end-begin )*length_, min_, max_ );
+      else for( size_t i=begin; i<end; ++i )
+         rng.fill( data_+i*spacing_, length_, min_, max_ );
+   }
+
+   Type*  data_;     //!< The first element of the target.
+   size_t length_;   //!< The number of elements per row/column.
+   size_t spacing_;  //!< The spacing between the beginning of two rows/columns.
+   RNG    rng_;      //!< The random number generator for the values of the target.
+   Type   min_;      //!< The smallest possible random value.
+   Type   max_;      //!< The upper bound of the random values.
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Range task for the parallel random initialization of a sparse matrix.
+// \ingroup smp
+//
+// The SparseRandomizeTask class assigns random values to the non-zero elements of a range of
+// rows (in case of a row-major matrix) or columns (in case of a column-major matrix) of a sparse
+// matrix. The non-zero elements are numbered consecutively over all rows/columns and non-zero
+// element \a k is assigned the \a k-th value of the given random number generator, which makes
+// the result independent of the partitioning.
+*/
+template< typename MT >  // Type of the sparse matrix
+struct SparseRandomizeTask
+{
+   typedef void                     result_type;  //!< Result type of the task.
+   typedef typename MT::ElementType ET;           //!< Element type of the sparse matrix.
+
+   inline SparseRandomizeTask( MT& sm, const RNG& rng, ET min, ET max )
+      : sm_( &sm ), rng_( rng ), min_( min ), max_( max ) {}
+
+   inline void operator()( size_t begin, size_t end ) const {
+      size_t offset( 0UL );
+      for( size_t i=0UL; i<begin; ++i )
+         offset += sm_->nonZeros( i );
+
+      RNG rng( rng_ );
+      rng.skip<ET>( offset );
+
+      std::vector<ET> values;
+      for( size_t i=begin; i<end; ++i ) {
+         values.resize( sm_->nonZeros( i ) );
+         if( values.empty() ) continue;
+         rng.fill( &values[0], values.size(), min_, max_ );
+         typename std::vector<ET>::const_iterator value( values.begin() );
+         for( typename MT::Iterator element=sm_->begin( i ); element!=sm_->end( i ); ++element, ++value )
+            element->value() = *value;
+      }
+   }
+
+   MT* sm_;   //!< The target sparse matrix.
+   RNG rng_;  //!< The random number generator for the values of the target.
+   ET  min_;  //!< The smallest possible random value.
+   ET  max_;  //!< The upper bound of the random values.
+};
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -0,0 +1,266 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/smp/ThreadBackend.h
+//  \brief Header file for the shared memory parallelization of the Blaze library
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_SMP_THREADBACKEND_H_
+#define _BLAZE_MATH_SMP_THREADBACKEND_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Null.h>
+#include <blaze/util/ThreadPool.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  THREAD SETUP FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\defgroup smp Shared memory parallelization
+// \ingroup math
+//
+// The Blaze library evaluates the assignment of large dense vector and matrix expressions in
+// parallel. The work is partitioned into contiguous ranges of elements, rows or columns, which
+// are executed concurrently by the calling thread and the threads of a global ThreadPool. The
+// parallel evaluation is only used in case the size of the target exceeds the according SMP
+// threshold (see the <em>./blaze/config/Thresholds.h</em> configuration file). Smaller
+// assignments and all assignments issued while the global thread pool is already busy (as for
+// instance the assignments within a parallel section or the assignments of another thread of
+// the application) are executed sequentially.
+//
+// The total number of threads participating in a parallel assignment is by default given by the
+// \c BLAZE_NUM_THREADS environment variable or, in case the variable is not set, by the number
+// of hardware threads of the system. It can be adjusted at runtime via the setNumThreads()
+// function:
+
+   \code
+   blaze::setNumThreads( 4 );  // Using four threads for all following parallel assignments
+   blaze::setNumThreads( 1 );  // Switching to a purely sequential execution
+   \endcode
+*/
+/*!\name Thread setup functions */
+//@{
+size_t getNumThreads();
+void   setNumThreads( size_t number );
+//@}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  THREAD BACKEND FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+namespace smp {
+
+ThreadPool* acquireThreadPool();
+void        releaseThreadPool();
+
+} // namespace smp
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+namespace smp {
+
+/*!\brief Scope guard of an acquired global thread pool.
+// \ingroup smp
+//
+// The destructor of the ThreadPoolGuard waits for the completion of all tasks scheduled on the
+// thread pool and releases the pool afterwards. This guarantees that no scheduled task outlives
+// the objects it refers to and that the pool is released even if an exception is thrown while
+// the pool is active.
+*/
+class ThreadPoolGuard
+{
+ public:
+   explicit inline ThreadPoolGuard( ThreadPool* pool ) : pool_( pool ) {}
+
+   inline ~ThreadPoolGuard() {
+      pool_->wait();
+      releaseThreadPool();
+   }
+
+ private:
+   ThreadPoolGuard( const ThreadPoolGuard& );
+   ThreadPoolGuard& operator=( const ThreadPoolGuard& );
+
+   ThreadPool* pool_;  //!< The acquired global thread pool.
+};
+
+} // namespace smp
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Parallel execution of a task on the index range \f$ [0..n) \f$.
+// \ingroup smp
+//
+// \param n The total size of the index range.
+// \param granularity The granularity of the partitioning.
+// \param task The task to be executed on the partitions of the index range.
+// \return void
+//
+// This function partitions the index range \f$ [0..n) \f$ into one contiguous partition per
+// thread and calls \a task( begin, end ) for each partition. The first index of every partition
+// is a multiple of \a granularity. The calling thread executes the first partition itself and
+// blocks until all remaining partitions have been executed by the global thread pool. In case
+// the global thread pool is not available, the complete range is executed by the calling thread.
+// The given task must be copyable. The tasks executed by the thread pool must not throw. In case
+// the partition of the calling thread throws an exception, the function waits for the completion
+// of all remaining partitions and releases the thread pool before the exception is propagated.
+*/
+template< typename Task >  // Type of the range task
+void smpFor( size_t n, size_t granularity, Task task )
+{
+   BLAZE_INTERNAL_ASSERT( granularity > 0UL, "Invalid granularity" );
+
+   ThreadPool* pool( NULL );
+
+   if( n > granularity )
+      pool = smp::acquireThreadPool();
+
+   if( pool == NULL ) {
+      task( 0UL, n );
+      return;
+   }
+
+   const smp::ThreadPoolGuard guard( pool );
+
+   const size_t threads( pool->size() + 1UL );
+   const size_t parts  ( ( n - 1UL ) / threads + 1UL );
+   const size_t chunk  ( ( ( parts - 1UL ) / granularity + 1UL ) * granularity );
+
+   for( size_t begin=chunk; begin<n; begin+=chunk ) {
+      pool->schedule( boost::bind( task, begin, std::min( begin+chunk, n ) ) );
+   }
+
+   task( 0UL, std::min( chunk, n ) );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  ASSIGNMENT TASKS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Range task for the parallel assignment of a dense vector or matrix.
+// \ingroup smp
+//
+// The AssignTask class calls the ranged assign() function of the target vector or matrix for
+// the given range, i.e. the range of elements of a vector or the range of rows/columns of a
+// row-major/column-major matrix.
+*/
+template< typename T1    // Type of the left-hand side target
+        , typename T2 >  // Type of the right-hand side operand
+struct AssignTask
+{
+   typedef void  result_type;  //!< Result type of the task.
+
+   inline AssignTask( T1& lhs, const T2& rhs ) : lhs_( &lhs ), rhs_( &rhs ) {}
+
+   inline void operator()( size_t begin, size_t end ) const {
+      lhs_->assign( *rhs_, begin, end );
+   }
+
+   T1*       lhs_;  //!< The left-hand side target.
+   const T2* rhs_;  //!< The right-hand side operand.
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Range task for the parallel addition assignment of a dense vector or matrix.
+// \ingroup smp
+*/
+template< typename T1    // Type of the left-hand side target
+        , typename T2 >  // Type of the right-hand side operand
+struct AddAssignTask
+{
+   typedef void  result_type;  //!< Result type of the task.
+
+   inline AddAssignTask( T1& lhs, const T2& rhs ) : lhs_( &lhs ), rhs_( &rhs ) {}
+
+   inline void operator()( size_t begin, size_t end ) const {
+      lhs_->addAssign( *rhs_, begin, end );
+   }
+
+   T1*       lhs_;  //!< The left-hand side target.
+   const T2* rhs_;  //!< The right-hand side operand.
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Range task for the parallel subtraction assignment of a dense vector or matrix.
+// \ingroup smp
+*/
+template< typename T1    // Type of the left-hand side target
+        , typename T2 >  // Type of the right-hand side operand
+struct SubAssignTask
+{
+   typedef void  result_type;  //!< Result type of the task.
+
+   inline SubAssignTask( T1& lhs, const T2& rhs ) : lhs_( &lhs ), rhs_( &rhs ) {}
+
+   inline void operator()( size_t begin, size_t end ) const {
+      lhs_->subAssign( *rhs_, begin, end );
+   }
+
+   T1*       lhs_;  //!< The left-hand side target.
+   const T2* rhs_;  //!< The right-hand side operand.
+};
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
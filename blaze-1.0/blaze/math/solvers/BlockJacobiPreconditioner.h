@@ -0,0 +1,117 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/solvers/BlockJacobiPreconditioner.h
+//  \brief Header file for the block Jacobi preconditioner
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_SOLVERS_BLOCKJACOBIPRECONDITIONER_H_
+#define _BLAZE_MATH_SOLVERS_BLOCKJACOBIPRECONDITIONER_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <vector>
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/DynamicVector.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Implementation of the block Jacobi preconditioner for 3x3 nodal blocks.
+// \ingroup preconditioners
+//
+// The BlockJacobiPreconditioner approximates the inverse of the system matrix \f$ A \f$ by the
+// inverse of its block diagonal, where each block consists of the three rows and columns of a
+// single node (as for instance the three displacements of a node in a finite element system of
+// linear elasticity). The inverse blocks are computed once during the setup of the preconditioner
+// and stored consecutively in row-major order, such that the application of the preconditioner
+// is a streaming sequence of 3x3 matrix/vector multiplications. Large vectors are processed in
+// parallel (see \ref smp). Note that the size of the system matrix has to be a multiple of 3.
+*/
+class BlockJacobiPreconditioner
+{
+public:
+   //**Constructors********************************************************************************
+   /*!\name Constructors */
+   //@{
+   explicit BlockJacobiPreconditioner();
+   explicit BlockJacobiPreconditioner( const CMatMxN& A );
+   //@}
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   inline size_t size () const;
+          void   setup( const CMatMxN& A );
+          real   apply( const VecN& r, VecN& z );
+   //@}
+   //**********************************************************************************************
+
+private:
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   void applyKernel( const VecN& r, VecN& z, size_t parts, size_t pbegin, size_t pend );
+   //@}
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   /*!\name Member variables */
+   //@{
+   size_t size_;                        //!< The number of rows/columns of the system matrix.
+   std::vector<real> inv_;              //!< The inverse 3x3 diagonal blocks of the system matrix.
+   std::vector<real> partial_;          //!< The partial inner products of the parts.
+   //@}
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the size of the preconditioner.
+//
+// \return The number of rows/columns of the preconditioned system matrix.
+*/
+inline size_t BlockJacobiPreconditioner::size() const
+{
+   return size_;
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
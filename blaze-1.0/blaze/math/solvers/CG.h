@@ -27,10 +27,13 @@
 // Includes
 //*************************************************************************************************
 
+#include <stdexcept>
+#include <vector>
 #include <blaze/math/CompressedMatrix.h>
 #include <blaze/math/DynamicVector.h>
 #include <blaze/math/problems/LSE.h>
 #include <blaze/math/solvers/Solver.h>
+#include <blaze/util/Types.h>
 
 
 namespace blaze {
@@ -42,11 +45,31 @@ namespace blaze {
 //=================================================================================================
 
 //*************************************************************************************************
-/*!\brief A conjugate gradient solver.
+/*!\brief A (preconditioned) conjugate gradient solver.
 // \ingroup lse_solvers
 //
-// TODO: description
-// TODO: Problem formulation: \f$ A \cdot x + b = 0 \f$ !!
+// The CG class solves symmetric positive definite linear systems of the form
+// \f$ A \cdot x + b = 0 \f$ by means of the conjugate gradient method. Optionally, the solver
+// uses a preconditioner (see \ref preconditioners), which is passed to the solve() function:
+
+   \code
+   blaze::LSE lse;
+   // ... Setup of the linear system
+
+   blaze::CG cg;
+   blaze::JacobiPreconditioner pc( lse.A_ );
+   cg.solve( lse, pc );
+   \endcode
+
+// Each iteration of the solver consists of a sparse matrix/dense vector multiplication fused
+// with the computation of the according inner product, a fused update of the solution and the
+// residual that computes the convergence criterion and the squared norm of the residual on the
+// fly, the application of the preconditioner and the update of the search direction. Thus all
+// vectors are traversed a minimum number of times. In case the size of the system reaches the
+// SMP_SMATDVECMULT_THRESHOLD, all of these steps are executed in parallel (see \ref smp). For
+// this purpose, the rows of the system matrix are partitioned into blocks of approximately
+// equal number of non-zero elements. The partial inner products of the blocks are summed up in
+// a fixed order, i.e. the results for a given number of threads are reproducible.
 */
 class CG : public Solver
 {
@@ -61,18 +84,38 @@ public:
    //**Solver functions****************************************************************************
    /*!\name Solver functions */
    //@{
-   bool solve( LSE& lse );
-   bool solve( const CMatMxN& A, const VecN& b, VecN& x );
+                           bool solve( LSE& lse );
+                           bool solve( const CMatMxN& A, const VecN& b, VecN& x );
+   template< typename PC > bool solve( LSE& lse, PC& pc );
+   template< typename PC > bool solve( const CMatMxN& A, const VecN& b, VecN& x, PC& pc );
    //@}
    //**********************************************************************************************
 
 private:
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   void setup    ( const CMatMxN& A, const VecN& b, VecN& x );
+   real multiply ( const CMatMxN& A );
+   real update   ( VecN& x, real alpha, real& norm );
+   void direction( const VecN& z, real beta );
+   void report   ( bool converged, size_t it ) const;
+
+   void multiplyKernel ( const CMatMxN& A, size_t pbegin, size_t pend );
+   void updateKernel   ( VecN& x, real alpha, size_t pbegin, size_t pend );
+   void directionKernel( const VecN& z, real beta, size_t pbegin, size_t pend );
+   //@}
+   //**********************************************************************************************
+
    //**Member variables****************************************************************************
    /*!\name Member variables */
    //@{
-   VecN r_;  //!< TODO
-   VecN d_;  //!< TODO
-   VecN h_;  //!< TODO
+   VecN r_;  //!< The residual \f$ r = A \cdot x + b \f$.
+   VecN d_;  //!< The search direction.
+   VecN h_;  //!< The product of the system matrix and the search direction.
+   VecN z_;  //!< The preconditioned residual.
+   std::vector<size_t> bounds_;   //!< The bounds of the row blocks of the system matrix.
+   std::vector<real>   partial_;  //!< The partial results of the reductions of the row blocks.
    //@}
    //**********************************************************************************************
 };
@@ -88,19 +131,113 @@ private:
 //=================================================================================================
 
 //*************************************************************************************************
-/*!\brief TODO
+/*!\brief Solves the given linear system of equations.
 //
-// \param lse TODO
-// \return TODO
+// \param lse The linear system of equations to be solved.
+// \return Returns \a true if the solution is sufficiently accurate, otherwise it returns \a false.
+// \exception std::invalid_argument System matrix is not square.
+// \exception std::invalid_argument System matrix is not symmetric.
+// \exception std::invalid_argument Invalid right-hand side vector size.
 //
-// TODO: description
-// TODO: Problem formulation: \f$ A \cdot x + b = 0 \f$ !!
+// This function solves the linear system \f$ A \cdot x + b = 0 \f$ by means of the unpreconditioned
+// conjugate gradient method, starting from \f$ x = 0 \f$.
 */
 inline bool CG::solve( LSE& lse ) {
    return solve( lse.A_, lse.b_, lse.x_ );
 }
 //*************************************************************************************************
 
+
+//*************************************************************************************************
+/*!\brief Solves the given linear system of equations by means of the given preconditioner.
+//
+// \param lse The linear system of equations to be solved.
+// \param pc The preconditioner for the system matrix of the linear system.
+// \return Returns \a true if the solution is sufficiently accurate, otherwise it returns \a false.
+// \exception std::invalid_argument System matrix is not square.
+// \exception std::invalid_argument System matrix is not symmetric.
+// \exception std::invalid_argument Invalid right-hand side vector size.
+// \exception std::invalid_argument Invalid preconditioner size.
+//
+// This function solves the linear system \f$ A \cdot x + b = 0 \f$ by means of the preconditioned
+// conjugate gradient method, starting from \f$ x = 0 \f$.
+*/
+template< typename PC >  // Type of the preconditioner
+inline bool CG::solve( LSE& lse, PC& pc ) {
+   return solve( lse.A_, lse.b_, lse.x_, pc );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Solves the linear system \f$ A \cdot x + b = 0 \f$ by means of the given preconditioner.
+//
+// \param A The symmetric positive definite system matrix.
+// \param b The right-hand side vector.
+// \param x The resulting vector of unknowns.
+// \param pc The preconditioner for the system matrix \a A.
+// \return Returns \a true if the solution is sufficiently accurate, otherwise it returns \a false.
+// \exception std::invalid_argument System matrix is not square.
+// \exception std::invalid_argument System matrix is not symmetric.
+// \exception std::invalid_argument Invalid right-hand side vector size.
+// \exception std::invalid_argument Invalid preconditioner size.
+//
+// This function solves the given linear system by means of the preconditioned conjugate
+// gradient method, starting from \f$ x = 0 \f$. The preconditioner has to be set up for the
+// given system matrix and has to provide the following interface:
+
+   \code
+   size_t size() const;                    // The size of the preconditioner
+   real apply( const VecN& r, VecN& z );  // Computes z = M^{-1} r, returns r^T z
+   \endcode
+
+// Since the application of the preconditioner may use internal buffers of the preconditioner,
+// the preconditioner is passed as non-const reference.
+
+// The solution process stops as soon as the maximum norm of the residual drops below the
+// threshold of the solver or the maximum number of iterations is reached.
+*/
+template< typename PC >  // Type of the preconditioner
+bool CG::solve( const CMatMxN& A, const VecN& b, VecN& x, PC& pc )
+{
+   if( pc.size() != b.size() )
+      throw std::invalid_argument( "Invalid preconditioner size" );
+
+   setup( A, b, x );
+
+   bool converged( lastPrecision_ < threshold_ );
+   real norm;
+
+   real delta( pc.apply( r_, z_ ) );
+   direction( z_, real(0) );
+
+   // Performing the CG iterations
+   size_t it( 0 );
+
+   for( ; !converged && it<maxIterations_; ++it )
+   {
+      const real alpha( delta / multiply( A ) );
+
+      lastPrecision_ = update( x, alpha, norm );
+
+      if( lastPrecision_ < threshold_ ) {
+         converged = true;
+         break;
+      }
+
+      const real beta( pc.apply( r_, z_ ) );
+      direction( z_, beta / delta );
+      delta = beta;
+   }
+
+   report( converged, it );
+
+   lastIterations_ = it;
+
+   return converged;
+}
+//*************************************************************************************************
+
 } // namespace blaze
 
 #endif
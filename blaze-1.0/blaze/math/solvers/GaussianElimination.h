@@ -30,6 +30,7 @@
 #include <blaze/math/CompressedMatrix.h>
 #include <blaze/math/DynamicMatrix.h>
 #include <blaze/math/DynamicVector.h>
+#include <blaze/math/problems/Batch.h>
 #include <blaze/math/problems/LSE.h>
 #include <blaze/math/solvers/Solver.h>
 
@@ -64,6 +65,7 @@ class GaussianElimination : public Solver
    //@{
    inline bool solve( LSE& lse );
           bool solve( const CMatMxN& A, const VecN& b, VecN& x );
+          bool solve( Batch<LSE>& batch );
    //@}
    //**********************************************************************************************
 
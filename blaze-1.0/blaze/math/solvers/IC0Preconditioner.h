@@ -0,0 +1,115 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/solvers/IC0Preconditioner.h
+//  \brief Header file for the incomplete Cholesky preconditioner
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_SOLVERS_IC0PRECONDITIONER_H_
+#define _BLAZE_MATH_SOLVERS_IC0PRECONDITIONER_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/DynamicVector.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Implementation of the incomplete Cholesky preconditioner without fill-in (IC(0)).
+// \ingroup preconditioners
+//
+// The IC0Preconditioner approximates the symmetric positive definite system matrix \f$ A \f$ by
+// the product \f$ L \cdot L^T \f$, where the lower triangular factor \f$ L \f$ has the same
+// sparsity pattern as the lower triangular part of \f$ A \f$. The factor is computed once during
+// the setup of the preconditioner. The application of the preconditioner consists of a forward
+// and a backward substitution, which are inherently sequential. Therefore, in contrast to the
+// JacobiPreconditioner and the BlockJacobiPreconditioner, the IC(0) preconditioner is not
+// executed in parallel, but in return typically requires significantly fewer CG iterations.
+*/
+class IC0Preconditioner
+{
+public:
+   //**Constructors********************************************************************************
+   /*!\name Constructors */
+   //@{
+   explicit IC0Preconditioner();
+   explicit IC0Preconditioner( const CMatMxN& A );
+   //@}
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   inline size_t size () const;
+          void   setup( const CMatMxN& A );
+          real   apply( const VecN& r, VecN& z ) const;
+   //@}
+   //**********************************************************************************************
+
+private:
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   real dot( size_t i, size_t j ) const;
+   //@}
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   /*!\name Member variables */
+   //@{
+   CMatMxN L_;  //!< The strictly lower triangular part of the incomplete Cholesky factor.
+   VecN inv_;   //!< The inverse diagonal elements of the incomplete Cholesky factor.
+   //@}
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the size of the preconditioner.
+//
+// \return The number of rows/columns of the preconditioned system matrix.
+*/
+inline size_t IC0Preconditioner::size() const
+{
+   return inv_.size();
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -0,0 +1,114 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/solvers/JacobiPreconditioner.h
+//  \brief Header file for the Jacobi preconditioner
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_SOLVERS_JACOBIPRECONDITIONER_H_
+#define _BLAZE_MATH_SOLVERS_JACOBIPRECONDITIONER_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <vector>
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/DynamicVector.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Implementation of the Jacobi (diagonal) preconditioner.
+// \ingroup preconditioners
+//
+// The JacobiPreconditioner approximates the inverse of the system matrix \f$ A \f$ by the
+// inverse of its diagonal \f$ D \f$, i.e. the application of the preconditioner computes
+// \f$ z = D^{-1} r \f$. The inverse diagonal elements are computed once during the setup of
+// the preconditioner, such that its application requires a single multiplication per element.
+// Large vectors are processed in parallel (see \ref smp).
+*/
+class JacobiPreconditioner
+{
+public:
+   //**Constructors********************************************************************************
+   /*!\name Constructors */
+   //@{
+   explicit JacobiPreconditioner();
+   explicit JacobiPreconditioner( const CMatMxN& A );
+   //@}
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   inline size_t size () const;
+          void   setup( const CMatMxN& A );
+          real   apply( const VecN& r, VecN& z );
+   //@}
+   //**********************************************************************************************
+
+private:
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   void applyKernel( const VecN& r, VecN& z, size_t parts, size_t pbegin, size_t pend );
+   //@}
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   /*!\name Member variables */
+   //@{
+   VecN inv_;                           //!< The inverse diagonal elements of the system matrix.
+   std::vector<real> partial_;          //!< The partial inner products of the parts.
+   //@}
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the size of the preconditioner.
+//
+// \return The number of rows/columns of the preconditioned system matrix.
+*/
+inline size_t JacobiPreconditioner::size() const
+{
+   return inv_.size();
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -28,8 +28,9 @@
 //*************************************************************************************************
 
 #include <iosfwd>
-#include <blaze/math/DynamicMatrix.h>
+#include <vector>
 #include <blaze/math/DynamicVector.h>
+#include <blaze/math/problems/Batch.h>
 #include <blaze/math/problems/LCP.h>
 #include <blaze/math/solvers/Solver.h>
 #include <blaze/system/Precision.h>
@@ -65,6 +66,7 @@ class Lemke : public Solver
    //@{
    bool solve( LCP& lcp );
    bool solve( LCP& lcp, const VecN& d );
+   bool solve( Batch<LCP>& batch );
    //@}
    //**********************************************************************************************
 
@@ -81,19 +83,16 @@ class Lemke : public Solver
    //@{
    bool isComponentwiseNonnegative( const VecN& v ) const;
    bool isComponentwisePositive   ( const VecN& v ) const;
-   bool isLexicographicallyLess   ( size_t i1, real f1, size_t i2, real f2 ) const;
-   bool isLexicographicallyGreater( size_t i1, real f1, size_t i2, real f2 ) const;
-   void pivot                     ( size_t block, size_t drive );
    //@}
    //**********************************************************************************************
 
    //**Member variables****************************************************************************
    /*!\name Member variables */
    //@{
-   DynamicVector<ptrdiff_t> basics_;     //!< TODO
-   DynamicVector<ptrdiff_t> nonbasics_;  //!< TODO
-   MatMxN                   M_;          //!< TODO
-   MatMxN                   Q_;          //!< TODO
+   std::vector<ptrdiff_t> basics_;     //!< The basic variables of the tableau.
+   std::vector<ptrdiff_t> nonbasics_;  //!< The nonbasic variables of the tableau.
+   std::vector<real>      M_;          //!< The row-major matrix \f$ M' = [d; M] \f$ of the tableau.
+   std::vector<real>      Q_;          //!< The row-major matrix \f$ Q' = [q; Q] \f$ of the tableau.
    //@}
    //**********************************************************************************************
 };
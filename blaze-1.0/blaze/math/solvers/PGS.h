@@ -28,12 +28,19 @@
 //*************************************************************************************************
 
 #include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
 #include <blaze/math/CompressedMatrix.h>
 #include <blaze/math/DynamicVector.h>
+#include <blaze/math/problems/Batch.h>
 #include <blaze/math/problems/BoxLCP.h>
 #include <blaze/math/problems/ContactLCP.h>
 #include <blaze/math/problems/LCP.h>
+#include <blaze/math/smp/ThreadBackend.h>
 #include <blaze/math/solvers/Solver.h>
+#include <blaze/system/Thresholds.h>
 #include <blaze/util/Assert.h>
 #include <blaze/util/ColorMacros.h>
 #include <blaze/util/logging/DebugSection.h>
@@ -52,9 +59,28 @@ namespace blaze {
 /*!\brief A projected Gauss-Seidel Solver for (box) LCPs.
 // \ingroup complementarity_solvers
 //
-// TODO: description of the PGS solver
-// TODO: capabilities of the PGS solver (which LCP problems, etc)
-// TODO: known issues of the PGS solver
+// The PGS class iteratively solves (box) LCPs by means of projected Gauss-Seidel sweeps, which
+// update the unknowns one after another and project each unknown on its feasible range. For
+// contact LCPs (see ContactLCP), the three unknowns of a contact are updated together and the
+// friction forces are projected on the friction cone of the updated normal force.
+//
+// In case the number of unknowns of a contact LCP reaches the SMP_PGS_THRESHOLD, the sweeps are
+// executed in parallel: the contacts are colored based on the sparsity pattern of the system
+// matrix such that no two contacts of the same color are coupled. The colors are processed one
+// after another, but all contacts of a single color are updated concurrently. Since the coloring
+// does not depend on the number of threads, the result of the solver is the same for any number
+// of threads. Note however that the order of the updates differs from the natural order of the
+// contacts.
+//
+// Optionally, the solver can be switched to a fully parallel projected Jacobi mode (see the
+// setJacobi() function), in which all unknowns are updated based on the unknowns of the previous
+// sweep. Since the Jacobi mode usually requires underrelaxation in order to converge, a
+// relaxation parameter can be specified via the setRelaxation() function. The relaxation
+// parameter is also applied to the Gauss-Seidel sweeps (successive over-relaxation).
+//
+// Additionally, the PGS solver is able to solve a large number of small, independent LCPs at
+// once (see the Batch class). In this case, LCPs of the same size are solved simultaneously by
+// means of SIMD instructions and the LCPs are distributed to all available threads.
 */
 class PGS : public Solver
 {
@@ -66,10 +92,27 @@ class PGS : public Solver
    //@}
    //**********************************************************************************************
 
+   //**Get functions*******************************************************************************
+   /*!\name Get functions */
+   //@{
+   inline bool isJacobi     () const;
+   inline real getRelaxation() const;
+   //@}
+   //**********************************************************************************************
+
+   //**Set functions*******************************************************************************
+   /*!\name Set functions */
+   //@{
+   inline void setJacobi    ( bool jacobi );
+   inline void setRelaxation( real relaxation );
+   //@}
+   //**********************************************************************************************
+
    //**Utility functions***************************************************************************
    /*!\name Utility functions */
    //@{
    template< typename CP > bool solve( CP& cp );
+                           bool solve( Batch<LCP>& batch );
    //@}
    //**********************************************************************************************
 
@@ -77,16 +120,40 @@ class PGS : public Solver
    //**Utility functions***************************************************************************
    /*!\name Utility functions */
    //@{
-   template< typename CP > inline real sweep( CP& cp ) const;
+   template< typename CP > inline void color( const CP& cp );
+                                  void color( const ContactLCP& cp );
+
+   template< typename CP > inline real sweep( CP& cp );
+
+   template< typename CP >
+   void jacobiKernel( CP& cp, size_t parts, size_t pbegin, size_t pend );
+
+   void colorKernel( ContactLCP& cp, size_t begin, size_t end,
+                     size_t parts, size_t pbegin, size_t pend );
+   void contactKernel( ContactLCP& cp, size_t parts, size_t pbegin, size_t pend );
+
+   void batchKernel( Batch<LCP>& batch, const std::vector<size_t>& order,
+                     const std::vector<size_t>& bounds, real* precision, size_t* iterations,
+                     size_t begin, size_t end ) const;
+
+   inline real updateContact( ContactLCP& cp, size_t i );
+   inline real relaxContact ( ContactLCP& cp, size_t i );
    //@}
    //**********************************************************************************************
 
    //**Member variables****************************************************************************
    /*!\name Member variables */
    //@{
-   VecN diagonal_;  //!< Vector for the diagonal entries of the LCP matrix.
-                    /*!< For performance reasons, the vector contains the inverse of the
-                         diagonal elements. */
+   VecN diagonal_;    //!< Vector for the diagonal entries of the LCP matrix.
+                      /*!< For performance reasons, the vector contains the inverse of the
+                           diagonal elements. */
+   VecN xold_;        //!< The unknowns of the previous sweep (Jacobi mode only).
+   bool jacobi_;      //!< Flag for the projected Jacobi mode.
+   real relaxation_;  //!< The relaxation parameter.
+
+   std::vector<size_t> offsets_;   //!< The offsets of the colors within the contact list.
+   std::vector<size_t> contacts_;  //!< The list of contacts sorted by color.
+   std::vector<real>   partial_;   //!< The partial maximum residuals of the parts of a sweep.
    //@}
    //**********************************************************************************************
 };
@@ -95,6 +162,83 @@ class PGS : public Solver
 
 
 
+//=================================================================================================
+//
+//  GET FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns whether the solver is in projected Jacobi mode.
+//
+// \return \a true in case the solver performs projected Jacobi sweeps, \a false if not.
+*/
+inline bool PGS::isJacobi() const
+{
+   return jacobi_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the relaxation parameter of the solver.
+//
+// \return The relaxation parameter.
+*/
+inline real PGS::getRelaxation() const
+{
+   return relaxation_;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  SET FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Switches the solver between projected Gauss-Seidel and projected Jacobi sweeps.
+//
+// \param jacobi \a true for projected Jacobi sweeps, \a false for projected Gauss-Seidel sweeps.
+// \return void
+//
+// In the projected Jacobi mode, all unknowns are updated in parallel based on the unknowns of
+// the previous sweep. In contrast to the Gauss-Seidel sweeps, the Jacobi sweeps converge only
+// for a sufficiently small relaxation parameter (see setRelaxation()).
+*/
+inline void PGS::setJacobi( bool jacobi )
+{
+   jacobi_ = jacobi;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Sets the relaxation parameter of the solver.
+//
+// \param relaxation The relaxation parameter \f$ (0..2) \f$.
+// \return void
+// \exception std::invalid_argument Invalid relaxation parameter.
+//
+// The relaxation parameter scales the update of each unknown before its projection. The default
+// value of 1 corresponds to the unrelaxed projected Gauss-Seidel or Jacobi method.
+*/
+inline void PGS::setRelaxation( real relaxation )
+{
+   if( !( relaxation > real(0) && relaxation < real(2) ) )
+      throw std::invalid_argument( "Invalid relaxation parameter" );
+
+   relaxation_ = relaxation;
+}
+//*************************************************************************************************
+
+
+
+
 //=================================================================================================
 //
 //  UTILITY FUNCTIONS
@@ -107,7 +251,9 @@ class PGS : public Solver
 // \param cp The complementarity problem to solve.
 // \return Returns \a true if the solution is sufficiently accurate, otherwise it returns \a false.
 //
-// TODO
+// This function performs projected Gauss-Seidel (or Jacobi) sweeps until the maximum change of
+// the unknowns during a sweep drops below the threshold of the solver or the maximum number of
+// iterations is reached.
 */
 template< typename CP >  // Type of the complementarity problem
 bool PGS::solve( CP& cp )
@@ -126,6 +272,9 @@ bool PGS::solve( CP& cp )
       diagonal_[i] = real(1) / tmp;
    }
 
+   // Coloring the unknowns for the parallel Gauss-Seidel sweeps
+   color( cp );
+
    // Projecting the initial solution to a feasible region
    for( size_t i=0; i<n; ++i ) {
       cp.project( i );
@@ -160,15 +309,35 @@ bool PGS::solve( CP& cp )
 
 
 //*************************************************************************************************
-/*!\brief TODO
+/*!\brief Colors the unknowns of the given complementarity problem.
+//
+// \param cp The complementarity problem to be colored.
+// \return void
+//
+// The Gauss-Seidel sweeps of general (box) LCPs are executed in the natural order of the
+// unknowns. Therefore this function does not compute a coloring.
+*/
+template< typename CP >  // Type of the complementarity problem
+inline void PGS::color( const CP& /*cp*/ )
+{
+   offsets_.clear();
+   contacts_.clear();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Performs a single sweep over all unknowns of the given complementarity problem.
 //
 // \param cp The complementarity problem to solve.
-// \return TODO
+// \return The maximum change of an unknown during the sweep.
 //
-// TODO
+// In Gauss-Seidel mode, the unknowns are updated sequentially in their natural order. In Jacobi
+// mode, all unknowns are updated based on the unknowns of the previous sweep; in case the number
+// of unknowns reaches the SMP_PGS_THRESHOLD, the Jacobi sweep is executed in parallel.
 */
 template< typename CP >  // Type of the complementarity problem
-inline real PGS::sweep( CP& cp ) const
+inline real PGS::sweep( CP& cp )
 {
    real maxResidual( 0 ), xold( 0 );
    const size_t n( cp.size() );
@@ -177,13 +346,29 @@ inline real PGS::sweep( CP& cp ) const
    const VecN&    b( cp.b_ );
    VecN& x( cp.x_ );
 
+   if( jacobi_ )
+   {
+      const size_t parts( ( n < SMP_PGS_THRESHOLD )?( 1UL ):( getNumThreads() ) );
+
+      xold_ = x;
+      partial_.resize( parts );
+
+      smpFor( parts, 1UL, boost::bind( &PGS::template jacobiKernel<CP>, this, boost::ref( cp ),
+                                       parts, _1, _2 ) );
+
+      for( size_t p=0; p<parts; ++p )
+         maxResidual = max( maxResidual, partial_[p] );
+
+      return maxResidual;
+   }
+
    for( size_t i=0; i<n; ++i )
    {
       const real residual( - b[i] - ( A * x )[i] );
 
       // Updating and projecting the unknown
       xold = x[i];
-      x[i] += diagonal_[i] * residual;
+      x[i] += relaxation_ * diagonal_[i] * residual;
       cp.project( i );
       maxResidual = max( maxResidual, std::fabs( xold - x[i] ) );
    }
@@ -194,47 +379,181 @@ inline real PGS::sweep( CP& cp ) const
 
 
 //*************************************************************************************************
-/*!\brief TODO
+/*!\brief Performs a parallel sweep over the contacts of the given contact LCP.
 //
-// \param cp The complementarity problem to solve.
-// \return TODO
+// \param cp The contact LCP to solve.
+// \return The maximum change of an unknown during the sweep.
 //
-// TODO: specialization for contact LCPs
-// TODO: more infos
+// In Gauss-Seidel mode, the contacts are updated color by color, where all contacts of a single
+// color are updated in parallel. In case no coloring has been computed (i.e. in case the number
+// of unknowns is below the SMP_PGS_THRESHOLD), the contacts are updated sequentially in their
+// natural order. In Jacobi mode, all contacts are updated in parallel based on the unknowns of
+// the previous sweep.
 */
 template<>
-inline real PGS::sweep( ContactLCP& cp ) const
+inline real PGS::sweep( ContactLCP& cp )
 {
    const size_t N( cp.size() / 3 );
-   real rmax( 0 ), residual, flimit, aux;
-   size_t j;
+   const size_t threads( ( cp.size() < SMP_PGS_THRESHOLD )?( 1UL ):( getNumThreads() ) );
+   real rmax( 0 );
+
+   if( jacobi_ )
+   {
+      xold_ = cp.x_;
+      partial_.resize( threads );
+
+      smpFor( threads, 1UL, boost::bind( &PGS::contactKernel, this, boost::ref( cp ),
+                                         threads, _1, _2 ) );
+
+      for( size_t p=0; p<threads; ++p )
+         rmax = max( rmax, partial_[p] );
+   }
+   else if( offsets_.empty() )
+   {
+      for( size_t i=0; i<N; ++i )
+         rmax = max( rmax, updateContact( cp, i ) );
+   }
+   else
+   {
+      for( size_t c=1; c<offsets_.size(); ++c )
+      {
+         const size_t begin( offsets_[c-1] );
+         const size_t end  ( offsets_[c]   );
+         const size_t parts( min( threads, ( end - begin + 63 ) / 64 ) );
+
+         partial_.resize( parts );
+
+         smpFor( parts, 1UL, boost::bind( &PGS::colorKernel, this, boost::ref( cp ),
+                                          begin, end, parts, _1, _2 ) );
+
+         for( size_t p=0; p<parts; ++p )
+            rmax = max( rmax, partial_[p] );
+      }
+   }
+
+   return rmax;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Kernel for the parallel projected Jacobi sweep over a range of parts.
+//
+// \param cp The complementarity problem to solve.
+// \param parts The total number of parts.
+// \param pbegin The first part to be processed.
+// \param pend One past the last part to be processed.
+// \return void
+*/
+template< typename CP >  // Type of the complementarity problem
+void PGS::jacobiKernel( CP& cp, size_t parts, size_t pbegin, size_t pend )
+{
+   const size_t n( cp.size() );
 
    const CMatMxN& A( cp.A_ );
-   const VecN&  b( cp.b_ );
+   const VecN&    b( cp.b_ );
    VecN& x( cp.x_ );
 
-   for( size_t i=0; i<N; ++i )
+   for( size_t p=pbegin; p<pend; ++p )
    {
-      j = i * 3;
-      residual = -b[j] - ( A * x )[j];
-      aux = max( 0, x[j] + diagonal_[j] * residual );
-      rmax = max( rmax, std::fabs( x[j] - aux ) );
-      x[j] = aux;
-
-      flimit = cp.cof_[i] * x[j];
-
-      ++j;
-      residual = -b[j] - ( A * x )[j];
-      aux = max( -flimit, min( flimit, x[j] + diagonal_[j] * residual ) );
-      rmax = max( rmax, std::fabs( x[j] - aux ) );
-      x[j] = aux;
-
-      ++j;
-      residual = -b[j] - ( A * x )[j];
-      aux = max( -flimit, min( flimit, x[j] + diagonal_[j] * residual ) );
-      rmax = max( rmax, std::fabs( x[j] - aux ) );
-      x[j] = aux;
+      const size_t iend( ( ( p+1 ) * n ) / parts );
+      real maxResidual( 0 );
+
+      for( size_t i=( p*n )/parts; i<iend; ++i ) {
+         const real residual( - b[i] - ( A * xold_ )[i] );
+         x[i] = xold_[i] + relaxation_ * diagonal_[i] * residual;
+         cp.project( i );
+         maxResidual = max( maxResidual, std::fabs( xold_[i] - x[i] ) );
+      }
+
+      partial_[p] = maxResidual;
    }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Performs a projected Gauss-Seidel update of a single contact.
+//
+// \param cp The contact LCP to solve.
+// \param i The index of the contact \f$[0..N)\f$.
+// \return The maximum change of the unknowns of the contact.
+//
+// This function updates the normal force of the given contact and subsequently the two friction
+// forces, which are projected on the friction cone of the updated normal force. All residuals
+// are computed based on the current unknowns.
+*/
+inline real PGS::updateContact( ContactLCP& cp, size_t i )
+{
+   real rmax( 0 ), residual, flimit, aux;
+   size_t j( i * 3 );
+
+   const CMatMxN& A( cp.A_ );
+   const VecN&  b( cp.b_ );
+   VecN& x( cp.x_ );
+
+   residual = -b[j] - ( A * x )[j];
+   aux = max( 0, x[j] + relaxation_ * diagonal_[j] * residual );
+   rmax = max( rmax, std::fabs( x[j] - aux ) );
+   x[j] = aux;
+
+   flimit = cp.cof_[i] * x[j];
+
+   ++j;
+   residual = -b[j] - ( A * x )[j];
+   aux = max( -flimit, min( flimit, x[j] + relaxation_ * diagonal_[j] * residual ) );
+   rmax = max( rmax, std::fabs( x[j] - aux ) );
+   x[j] = aux;
+
+   ++j;
+   residual = -b[j] - ( A * x )[j];
+   aux = max( -flimit, min( flimit, x[j] + relaxation_ * diagonal_[j] * residual ) );
+   rmax = max( rmax, std::fabs( x[j] - aux ) );
+   x[j] = aux;
+
+   return rmax;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Performs a projected Jacobi update of a single contact.
+//
+// \param cp The contact LCP to solve.
+// \param i The index of the contact \f$[0..N)\f$.
+// \return The maximum change of the unknowns of the contact.
+//
+// This function updates the normal force and the two friction forces of the given contact based
+// on the unknowns of the previous sweep. The friction forces are projected on the friction cone
+// of the updated normal force.
+*/
+inline real PGS::relaxContact( ContactLCP& cp, size_t i )
+{
+   real rmax( 0 ), residual, flimit, aux;
+   size_t j( i * 3 );
+
+   const CMatMxN& A( cp.A_ );
+   const VecN&  b( cp.b_ );
+   VecN& x( cp.x_ );
+
+   residual = -b[j] - ( A * xold_ )[j];
+   aux = max( 0, xold_[j] + relaxation_ * diagonal_[j] * residual );
+   rmax = max( rmax, std::fabs( xold_[j] - aux ) );
+   x[j] = aux;
+
+   flimit = cp.cof_[i] * x[j];
+
+   ++j;
+   residual = -b[j] - ( A * xold_ )[j];
+   aux = max( -flimit, min( flimit, xold_[j] + relaxation_ * diagonal_[j] * residual ) );
+   rmax = max( rmax, std::fabs( xold_[j] - aux ) );
+   x[j] = aux;
+
+   ++j;
+   residual = -b[j] - ( A * xold_ )[j];
+   aux = max( -flimit, min( flimit, xold_[j] + relaxation_ * diagonal_[j] * residual ) );
+   rmax = max( rmax, std::fabs( xold_[j] - aux ) );
+   x[j] = aux;
 
    return rmax;
 }
@@ -55,6 +55,25 @@ namespace solvers {}
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\defgroup preconditioners Preconditioners
+// \ingroup lse_solvers
+//
+// Preconditioners improve the convergence of iterative linear system solvers as for instance
+// the CG solver by approximating the inverse of the system matrix. Blaze provides the following
+// preconditioners:
+//
+//  - JacobiPreconditioner: the inverse of the diagonal of the system matrix
+//  - BlockJacobiPreconditioner: the inverse of the 3x3 nodal diagonal blocks of the system matrix
+//  - IC0Preconditioner: the incomplete Cholesky factorization without fill-in
+//
+// All preconditioners are set up for a specific system matrix and compute the preconditioned
+// residual \f$ z = M^{-1} r \f$ together with the inner product \f$ r^T z \f$ via their apply()
+// function.
+*/
+//*************************************************************************************************
+
+
 //*************************************************************************************************
 /*!\defgroup complementarity_solvers Complementarity System Solvers
 // \ingroup solvers
@@ -31,9 +31,12 @@ namespace blaze {
 //
 //=================================================================================================
 
+class BlockJacobiPreconditioner;
 class CG;
 class CPG;
 class GaussianElimination;
+class IC0Preconditioner;
+class JacobiPreconditioner;
 class Lemke;
 class PGS;
 
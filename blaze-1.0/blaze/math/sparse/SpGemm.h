@@ -0,0 +1,567 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/sparse/SpGemm.h
+//  \brief Header file for the parallel sparse matrix/sparse matrix multiplication kernel
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_SPARSE_SPGEMM_H_
+#define _BLAZE_MATH_SPARSE_SPGEMM_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <algorithm>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <blaze/math/expressions/SparseMatrix.h>
+#include <blaze/math/Infinity.h>
+#include <blaze/math/shims/IsDefault.h>
+#include <blaze/math/smp/Partition.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/math/Types.h>
+#include <blaze/system/Thresholds.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS SPGEMMACCUMULATOR
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Sparse accumulator for a single row/column of a sparse matrix multiplication.
+// \ingroup sparse_matrix
+//
+// The SpGemmAccumulator class accumulates the partial products of a single row (row-major) or
+// column (column-major) of a sparse matrix multiplication. For each row/column the accumulator
+// switches between two modes depending on the number of partial products of the row/column:
+// In case the number of partial products is small in comparison to the size of the row/column,
+// the products are accumulated in a small, cache resident hash table with linear probing.
+// Otherwise they are accumulated in a dense array of the size of the row/column, which is
+// allocated on first use and in which the accumulated indices are marked with the current
+// row/column. Each thread uses its own accumulator.
+*/
+template< typename Type >  // Data type of the accumulated elements
+class SpGemmAccumulator
+{
+ public:
+   //**Accumulator parameters**********************************************************************
+   //! Minimum ratio between the size of a row/column and its partial products for the hash mode.
+   enum { hashRatio = 32UL };
+   //**********************************************************************************************
+
+   //**Constructor*********************************************************************************
+   /*!\brief The constructor of the SpGemmAccumulator class.
+   //
+   // \param n The size of the accumulated rows/columns.
+   */
+   explicit inline SpGemmAccumulator( size_t n )
+      : n_     ( n )      // The size of the accumulated rows/columns
+      , hash_  ( false )  // Flag for the hash mode
+      , row_   ( 0UL )    // The current row/column marker of the dense mode
+      , count_ ( 0UL )    // The number of accumulated indices of the dense mode
+      , min_   ( inf )    // The smallest accumulated index of the dense mode
+      , max_   ( 0UL )    // The largest accumulated index of the dense mode
+      , mask_  ( 0UL )    // The bit mask of the hash table
+      , marker_()         // The row/column markers of the dense mode
+      , dense_ ()         // The accumulated values of the dense mode
+      , keys_  ()         // The indices of the hash table
+      , values_()         // The accumulated values of the hash table
+      , indices_()        // The accumulated indices of the hash mode
+   {}
+   //**********************************************************************************************
+
+   //**Init function*******************************************************************************
+   /*!\brief Resetting the accumulator for the next row/column.
+   //
+   // \param flops The number of partial products of the next row/column.
+   // \return void
+   */
+   inline void init( size_t flops ) {
+      hash_ = ( flops * hashRatio < n_ );
+
+      if( hash_ ) {
+         size_t capacity( 16UL );
+         while( capacity < 2UL*flops ) capacity *= 2UL;
+         if( keys_.size() < capacity ) {
+            keys_.resize( capacity );
+            values_.resize( capacity );
+         }
+         std::fill( keys_.begin(), keys_.begin()+capacity, size_t( inf ) );
+         mask_ = capacity - 1UL;
+         indices_.clear();
+      }
+      else {
+         if( marker_.empty() ) {
+            marker_.resize( n_, 0UL );
+            dense_.resize( n_ );
+         }
+         ++row_;
+         count_ = 0UL;
+         min_   = inf;
+         max_   = 0UL;
+      }
+   }
+   //**********************************************************************************************
+
+   //**Insert function*****************************************************************************
+   /*!\brief Adding an index to the structure of the current row/column.
+   //
+   // \param j The index of the partial product.
+   // \return void
+   */
+   inline void insert( size_t j ) {
+      if( hash_ ) {
+         const size_t s( probe( j ) );
+         if( keys_[s] != j ) {
+            keys_[s] = j;
+            indices_.push_back( j );
+         }
+      }
+      else if( marker_[j] != row_ ) {
+         marker_[j] = row_;
+         ++count_;
+      }
+   }
+   //**********************************************************************************************
+
+   //**Add function********************************************************************************
+   /*!\brief Adding a partial product to the current row/column.
+   //
+   // \param j The index of the partial product.
+   // \param value The value of the partial product.
+   // \return void
+   */
+   template< typename VT >  // Type of the partial product
+   inline void add( size_t j, const VT& value ) {
+      if( hash_ ) {
+         const size_t s( probe( j ) );
+         if( keys_[s] != j ) {
+            keys_[s] = j;
+            values_[s] = value;
+            indices_.push_back( j );
+         }
+         else values_[s] += value;
+      }
+      else if( marker_[j] != row_ ) {
+         marker_[j] = row_;
+         dense_[j] = value;
+         if( j < min_ ) min_ = j;
+         if( j > max_ ) max_ = j;
+      }
+      else dense_[j] += value;
+   }
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\brief Returns the number of accumulated elements of the current row/column.
+   //
+   // \return The number of accumulated elements.
+   //
+   // This function is only available for rows/columns that have been set up via insert().
+   */
+   inline size_t nonZeros() const {
+      return ( hash_ )?( indices_.size() ):( count_ );
+   }
+   //**********************************************************************************************
+
+   //**Store function******************************************************************************
+   /*!\brief Appending the accumulated elements to a row/column of the given compressed matrix.
+   //
+   // \param C The target compressed matrix.
+   // \param i The index of the row (row-major) or column (column-major) of \a C.
+   // \return void
+   //
+   // This function appends all accumulated elements that are not equal to the default value
+   // (e.g. due to cancellation) to row/column \a i of \a C in ascending order of their indices.
+   // In the hash mode the accumulated indices are sorted, in the dense mode the dense array is
+   // scanned between the smallest and the largest accumulated index. Due to the choice of the
+   // mode, the scanned range never exceeds \a hashRatio times the number of partial products.
+   */
+   template< bool SO >  // Storage order of the target matrix
+   inline void store( CompressedMatrix<Type,SO>& C, size_t i ) {
+      if( hash_ ) {
+         std::sort( indices_.begin(), indices_.end() );
+         for( std::vector<size_t>::const_iterator j=indices_.begin(); j!=indices_.end(); ++j ) {
+            const Type& value( values_[probe( *j )] );
+            if( isDefault( value ) ) continue;
+            if( SO ) C.append( *j, i, value );
+            else     C.append( i, *j, value );
+         }
+      }
+      else if( min_ <= max_ ) {
+         for( size_t j=min_; j<=max_; ++j ) {
+            if( marker_[j] != row_ || isDefault( dense_[j] ) ) continue;
+            if( SO ) C.append( j, i, dense_[j] );
+            else     C.append( i, j, dense_[j] );
+         }
+      }
+   }
+   //**********************************************************************************************
+
+ private:
+   //**Utility functions***************************************************************************
+   /*!\brief Returns the hash table slot of the given index or the first empty slot.
+   //
+   // \param j The index to be searched.
+   // \return The slot of the index.
+   */
+   inline size_t probe( size_t j ) const {
+      size_t s( ( j * 2654435761UL ) & mask_ );
+      while( keys_[s] != j && keys_[s] != size_t( inf ) )
+         s = ( s + 1UL ) & mask_;
+      return s;
+   }
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   size_t n_;                      //!< The size of the accumulated rows/columns.
+   bool   hash_;                   //!< Flag for the hash mode.
+   size_t row_;                    //!< The current row/column marker of the dense mode.
+   size_t count_;                  //!< The number of accumulated indices of the dense mode.
+   size_t min_;                    //!< The smallest accumulated index of the dense mode.
+   size_t max_;                    //!< The largest accumulated index of the dense mode.
+   size_t mask_;                   //!< The bit mask of the hash table.
+   std::vector<size_t> marker_;    //!< The row/column markers of the dense mode.
+   std::vector<Type>   dense_;     //!< The accumulated values of the dense mode.
+   std::vector<size_t> keys_;      //!< The indices of the hash table.
+   std::vector<Type>   values_;    //!< The accumulated values of the hash table.
+   std::vector<size_t> indices_;   //!< The accumulated indices of the hash mode.
+   //**********************************************************************************************
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CLASS SPGEMMKERNEL
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Implementation of the two-phase sparse matrix/sparse matrix multiplication.
+// \ingroup sparse_matrix
+//
+// The SpGemmKernel class implements the row-wise (Gustavson) multiplication of two sparse
+// matrices into a compressed matrix with storage order \a SO. For a row-major target matrix,
+// each row \a i of the result is computed as linear combination of the rows of \a B selected
+// by the non-zero elements of row \a i of \a A. For a column-major target matrix, each column
+// \a j is computed as linear combination of the columns of \a A selected by the non-zero
+// elements of column \a j of \a B. In the following, the matrix that selects (\a A for a
+// row-major and \a B for a column-major target) is called the outer operand \a X, the other
+// one the inner operand \a Y.
+//
+// The multiplication is split into a symbolic phase, which determines the exact number of
+// non-zero elements of each row/column of the result, and a numeric phase, which computes the
+// values into a compressed matrix that is presized accordingly. Both phases are partitioned
+// into blocks of rows/columns of approximately equal number of partial products and evaluated
+// in parallel, where each thread uses its own SpGemmAccumulator.
+*/
+template< typename Type  // Data type of the target matrix
+        , bool SO >      // Storage order of the target matrix
+struct SpGemmKernel
+{
+   //**Work function*******************************************************************************
+   /*!\brief Computes the number of partial products of a range of rows/columns.
+   //
+   // \param X The outer operand.
+   // \param Y The inner operand.
+   // \param flops The resulting number of partial products of each row/column.
+   // \param begin The first row/column of the range.
+   // \param end The end of the row/column range.
+   // \return void
+   */
+   template< typename MX    // Type of the outer operand
+           , typename MY >  // Type of the inner operand
+   static void work( const MX& X, const MY& Y, std::vector<size_t>& flops,
+                     size_t begin, size_t end )
+   {
+      typedef typename MX::ConstIterator  Iterator;
+
+      for( size_t i=begin; i<end; ++i ) {
+         size_t count( 0UL );
+         const Iterator xend( X.end(i) );
+         for( Iterator x=X.begin(i); x!=xend; ++x )
+            count += Y.nonZeros( x->index() );
+         flops[i] = count;
+      }
+   }
+   //**********************************************************************************************
+
+   //**Symbolic function***************************************************************************
+   /*!\brief Computes the number of non-zero elements of a range of rows/columns of the result.
+   //
+   // \param X The outer operand.
+   // \param Y The inner operand.
+   // \param n The size of the rows/columns of the result.
+   // \param flops The number of partial products of each row/column.
+   // \param nonzeros The resulting number of non-zero elements of each row/column.
+   // \param begin The first row/column of the range.
+   // \param end The end of the row/column range.
+   // \return void
+   */
+   template< typename MX    // Type of the outer operand
+           , typename MY >  // Type of the inner operand
+   static void symbolic( const MX& X, const MY& Y, size_t n, const std::vector<size_t>& flops,
+                         std::vector<size_t>& nonzeros, size_t begin, size_t end )
+   {
+      typedef typename MX::ConstIterator  XIterator;
+      typedef typename MY::ConstIterator  YIterator;
+
+      SpGemmAccumulator<Type> acc( n );
+
+      for( size_t i=begin; i<end; ++i )
+      {
+         acc.init( flops[i] );
+
+         const XIterator xend( X.end(i) );
+         for( XIterator x=X.begin(i); x!=xend; ++x ) {
+            const YIterator yend( Y.end( x->index() ) );
+            for( YIterator y=Y.begin( x->index() ); y!=yend; ++y )
+               acc.insert( y->index() );
+         }
+
+         nonzeros[i] = acc.nonZeros();
+      }
+   }
+   //**********************************************************************************************
+
+   //**Numeric function****************************************************************************
+   /*!\brief Computes the values of a range of rows/columns of the result.
+   //
+   // \param C The presized target matrix.
+   // \param X The outer operand.
+   // \param Y The inner operand.
+   // \param flops The number of partial products of each row/column.
+   // \param begin The first row/column of the range.
+   // \param end The end of the row/column range.
+   // \return void
+   //
+   // Accumulated elements that evaluate to the default value (e.g. due to cancellation) are not
+   // stored in the target matrix.
+   */
+   template< typename MX    // Type of the outer operand
+           , typename MY >  // Type of the inner operand
+   static void numeric( CompressedMatrix<Type,SO>& C, const MX& X, const MY& Y,
+                        const std::vector<size_t>& flops, size_t begin, size_t end )
+   {
+      typedef typename MX::ConstIterator  XIterator;
+      typedef typename MY::ConstIterator  YIterator;
+
+      SpGemmAccumulator<Type> acc( ( SO )?( C.rows() ):( C.columns() ) );
+
+      for( size_t i=begin; i<end; ++i )
+      {
+         acc.init( flops[i] );
+
+         const XIterator xend( X.end(i) );
+         for( XIterator x=X.begin(i); x!=xend; ++x ) {
+            const YIterator yend( Y.end( x->index() ) );
+            for( YIterator y=Y.begin( x->index() ); y!=yend; ++y ) {
+               if( SO )
+                  acc.add( y->index(), y->value() * x->value() );
+               else
+                  acc.add( y->index(), x->value() * y->value() );
+            }
+         }
+
+         acc.store( C, i );
+      }
+   }
+   //**********************************************************************************************
+
+   //**Compute function****************************************************************************
+   /*!\brief Computes the product of the given operands into the given compressed matrix.
+   //
+   // \param C The target matrix, already sized to the result.
+   // \param X The outer operand.
+   // \param Y The inner operand.
+   // \return void
+   */
+   template< typename MX    // Type of the outer operand
+           , typename MY >  // Type of the inner operand
+   static void compute( CompressedMatrix<Type,SO>& C, const MX& X, const MY& Y )
+   {
+      const size_t m( ( SO )?( C.columns() ):( C.rows() ) );
+      const size_t n( ( SO )?( C.rows() ):( C.columns() ) );
+
+      std::vector<size_t> flops( m ), nonzeros( m );
+
+      if( m < SMP_SMATSMATMULT_THRESHOLD )
+      {
+         work( X, Y, flops, 0UL, m );
+         symbolic( X, Y, n, flops, nonzeros, 0UL, m );
+
+         CompressedMatrix<Type,SO> tmp( C.rows(), C.columns(), nonzeros );
+         numeric( tmp, X, Y, flops, 0UL, m );
+         C.swap( tmp );
+      }
+      else
+      {
+         smpFor( m, 256UL, boost::bind( &SpGemmKernel::template work<MX,MY>, boost::cref( X ),
+                                        boost::cref( Y ), boost::ref( flops ), _1, _2 ) );
+
+         std::vector<size_t> bounds;
+         partitionWork( flops, getNumThreads(), bounds );
+
+         smpForPartitions( bounds, boost::bind( &SpGemmKernel::template symbolic<MX,MY>,
+                                                boost::cref( X ), boost::cref( Y ), n,
+                                                boost::cref( flops ), boost::ref( nonzeros ),
+                                                _1, _2 ) );
+
+         CompressedMatrix<Type,SO> tmp( C.rows(), C.columns(), nonzeros );
+
+         smpForPartitions( bounds, boost::bind( &SpGemmKernel::template numeric<MX,MY>,
+                                                boost::ref( tmp ), boost::cref( X ),
+                                                boost::cref( Y ), boost::cref( flops ),
+                                                _1, _2 ) );
+         C.swap( tmp );
+      }
+   }
+   //**********************************************************************************************
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  SPGEMM FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Sparse matrix/sparse matrix multiplication into a row-major compressed matrix.
+// \ingroup sparse_matrix
+//
+// \param C The target compressed matrix, already sized to the result.
+// \param A The row-major left-hand side multiplication operand.
+// \param B The row-major right-hand side multiplication operand.
+// \return void
+//
+// This function replaces the content of \a C by the product \f$ A*B \f$. The rows of the
+// result are computed by a two-phase Gustavson multiplication (see SpGemmKernel), which presizes
+// each row of \a C to its exact number of non-zero elements. In case the number of rows of \a C
+// reaches the SMP_SMATSMATMULT_THRESHOLD, the rows are partitioned into blocks of approximately
+// equal number of partial products and the blocks are computed in parallel (see \ref smp).
+*/
+template< typename Type  // Data type of the target matrix
+        , typename MT1   // Type of the left-hand side matrix operand
+        , typename MT2 > // Type of the right-hand side matrix operand
+void spgemm( CompressedMatrix<Type,false>& C, const MT1& A, const MT2& B )
+{
+   BLAZE_INTERNAL_ASSERT( A.columns() == B.rows()   , "Invalid matrix sizes"      );
+   BLAZE_INTERNAL_ASSERT( A.rows()    == C.rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( B.columns() == C.columns(), "Invalid number of columns" );
+
+   SpGemmKernel<Type,false>::compute( C, A, B );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Sparse matrix/sparse matrix multiplication into a column-major compressed matrix.
+// \ingroup sparse_matrix
+//
+// \param C The target compressed matrix, already sized to the result.
+// \param A The column-major left-hand side multiplication operand.
+// \param B The column-major right-hand side multiplication operand.
+// \return void
+//
+// This function replaces the content of \a C by the product \f$ A*B \f$. The columns of the
+// result are computed by a two-phase Gustavson multiplication (see SpGemmKernel), which presizes
+// each column of \a C to its exact number of non-zero elements. In case the number of columns
+// of \a C reaches the SMP_SMATSMATMULT_THRESHOLD, the columns are partitioned into blocks of
+// approximately equal number of partial products and the blocks are computed in parallel.
+*/
+template< typename Type  // Data type of the target matrix
+        , typename MT1   // Type of the left-hand side matrix operand
+        , typename MT2 > // Type of the right-hand side matrix operand
+void spgemm( CompressedMatrix<Type,true>& C, const MT1& A, const MT2& B )
+{
+   BLAZE_INTERNAL_ASSERT( A.columns() == B.rows()   , "Invalid matrix sizes"      );
+   BLAZE_INTERNAL_ASSERT( A.rows()    == C.rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( B.columns() == C.columns(), "Invalid number of columns" );
+
+   SpGemmKernel<Type,true>::compute( C, B, A );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Sparse matrix/sparse matrix multiplication into a general sparse matrix.
+// \ingroup sparse_matrix
+//
+// \param C The empty target sparse matrix, already sized to the result.
+// \param A The left-hand side multiplication operand with storage order \a SO.
+// \param B The right-hand side multiplication operand with storage order \a SO.
+// \return void
+//
+// This function computes the product \f$ A*B \f$ into a temporary compressed matrix and appends
+// the resulting elements to the given sparse matrix.
+*/
+template< typename MT   // Type of the target sparse matrix
+        , bool SO       // Storage order of the target sparse matrix
+        , typename MT1  // Type of the left-hand side matrix operand
+        , typename MT2 > // Type of the right-hand side matrix operand
+void spgemm( SparseMatrix<MT,SO>& C, const MT1& A, const MT2& B )
+{
+   typedef CompressedMatrix<typename MT::ElementType,SO>  Tmp;
+   typedef typename Tmp::ConstIterator                    ConstIterator;
+
+   Tmp tmp( (~C).rows(), (~C).columns() );
+   spgemm( tmp, A, B );
+
+   const size_t m( ( SO )?( tmp.columns() ):( tmp.rows() ) );
+
+   (~C).reserve( tmp.nonZeros() );
+
+   for( size_t i=0UL; i<m; ++i ) {
+      const ConstIterator end( tmp.end(i) );
+      for( ConstIterator element=tmp.begin(i); element!=end; ++element ) {
+         if( SO ) (~C).append( element->index(), i, element->value() );
+         else     (~C).append( i, element->index(), element->value() );
+      }
+      (~C).finalize( i );
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -0,0 +1,77 @@
+//=================================================================================================
+/*!
+//  \file blaze/math/typetraits/IsCSRMatrix.h
+//  \brief Header file for the IsCSRMatrix type trait
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_MATH_TYPETRAITS_ISCSRMATRIX_H_
+#define _BLAZE_MATH_TYPETRAITS_ISCSRMATRIX_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/util/FalseType.h>
+#include <blaze/util/TrueType.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Compile time check for sparse matrices with structure-of-arrays (CSR) storage.
+// \ingroup math_type_traits
+//
+// This type trait tests whether the given data type is a sparse matrix type that stores its
+// values, column indices and row offsets in separate arrays (see the CSRMatrix class template).
+// In case the data type has CSR storage, the \a value member enumeration is set to 1, the nested
+// type definition \a Type is \a TrueType, and the class derives from \a TrueType. Otherwise
+// \a value is set to 0, \a Type is \a FalseType, and the class derives from \a FalseType.
+// Examples:
+
+   \code
+   blaze::IsCSRMatrix< CSRMatrix<double> >::value                 // Evaluates to 1
+   blaze::IsCSRMatrix< const CSRMatrix<float> >::Type             // Results in TrueType
+   blaze::IsCSRMatrix< volatile CSRMatrix<int> >                  // Is derived from TrueType
+   blaze::IsCSRMatrix< CompressedMatrix<double,false> >::value    // Evaluates to 0
+   blaze::IsCSRMatrix< const DynamicMatrix<double,false> >::Type  // Results in FalseType
+   blaze::IsCSRMatrix< volatile int >                             // Is derived from FalseType
+   \endcode
+*/
+template< typename T >
+struct IsCSRMatrix : public FalseType
+{
+ public:
+   //**********************************************************************************************
+   /*! \cond BLAZE_INTERNAL */
+   enum { value = 0 };
+   typedef FalseType  Type;
+   /*! \endcond */
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
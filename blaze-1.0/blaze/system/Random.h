@@ -27,7 +27,7 @@
 // Includes
 //*************************************************************************************************
 
-#include <boost/random/mersenne_twister.hpp>
+#include <blaze/util/Philox.h>
 
 
 
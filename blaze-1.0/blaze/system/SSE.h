@@ -131,6 +131,23 @@
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Compilation switch for the AVX2 mode.
+// \ingroup system
+//
+// This compilation switch enables/disables the AVX2 mode. In case the AVX2 mode is enabled
+// (i.e. in case AVX2 functionality is available) the Blaze library uses the AVX2 gather
+// instructions for the indirect loads of the sparse matrix/dense vector multiplications.
+// In case the AVX2 mode is disabled, the indirect loads are performed element-wise.
+*/
+#if defined(__AVX2__)
+#  define BLAZE_AVX2_MODE 1
+#else
+#  define BLAZE_AVX2_MODE 0
+#endif
+//*************************************************************************************************
+
+
 
 
 //=================================================================================================
@@ -0,0 +1,64 @@
+//=================================================================================================
+/*!
+//  \file blaze/system/ThreadLocal.h
+//  \brief System settings for thread-local storage
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_SYSTEM_THREADLOCAL_H_
+#define _BLAZE_SYSTEM_THREADLOCAL_H_
+
+
+//=================================================================================================
+//
+//  THREAD-LOCAL STORAGE
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\def BLAZE_THREAD_LOCAL
+// \brief Platform dependent storage class specifier for thread-local variables.
+// \ingroup system
+//
+// The BLAZE_THREAD_LOCAL macro expands to the compiler-specific storage class specifier for
+// thread-local variables of POD type. In case the compiler does not provide thread-local
+// storage, the macro is not defined and the thread-local data has to be accessed via the
+// (considerably slower) boost::thread_specific_ptr class.
+*/
+
+// Intel compiler
+#if defined(__INTEL_COMPILER) || defined(__ICL) || defined(__ICC) || defined(__ECC)
+#  if defined(_WIN32)
+#    define BLAZE_THREAD_LOCAL __declspec(thread)
+#  else
+#    define BLAZE_THREAD_LOCAL __thread
+#  endif
+
+// GNU compiler
+#elif defined(__GNUC__)
+#  define BLAZE_THREAD_LOCAL __thread
+
+// Microsoft visual studio
+#elif defined(_MSC_VER)
+#  define BLAZE_THREAD_LOCAL __declspec(thread)
+
+#endif
+/*! \endcond */
+//*************************************************************************************************
+
+#endif
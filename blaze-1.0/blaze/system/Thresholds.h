@@ -62,6 +62,18 @@ BLAZE_STATIC_ASSERT( blaze::DMATTDMATMULT_THRESHOLD  > 0UL );
 BLAZE_STATIC_ASSERT( blaze::TDMATDMATMULT_THRESHOLD  > 0UL );
 BLAZE_STATIC_ASSERT( blaze::TDMATTDMATMULT_THRESHOLD > 0UL );
 
+BLAZE_STATIC_ASSERT( blaze::SMP_DVECASSIGN_THRESHOLD    > 0UL );
+BLAZE_STATIC_ASSERT( blaze::SMP_DMATASSIGN_THRESHOLD    > 0UL );
+BLAZE_STATIC_ASSERT( blaze::SMP_DMATDVECMULT_THRESHOLD  > 0UL );
+BLAZE_STATIC_ASSERT( blaze::SMP_DMATDMATMULT_THRESHOLD  > 0UL );
+BLAZE_STATIC_ASSERT( blaze::SMP_SMATDVECMULT_THRESHOLD  > 0UL );
+BLAZE_STATIC_ASSERT( blaze::SMP_TSMATDVECMULT_THRESHOLD > 0UL );
+BLAZE_STATIC_ASSERT( blaze::SMP_SMATSMATMULT_THRESHOLD  > 0UL );
+BLAZE_STATIC_ASSERT( blaze::SMP_ASSEMBLY_THRESHOLD      > 0UL );
+BLAZE_STATIC_ASSERT( blaze::SMP_PGS_THRESHOLD           > 0UL );
+BLAZE_STATIC_ASSERT( blaze::SMP_BATCH_THRESHOLD         > 0UL );
+BLAZE_STATIC_ASSERT( blaze::SMP_RANDOMIZE_THRESHOLD     > 0UL );
+
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -33,6 +33,7 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <blaze/util/AlignmentTrait.h>
+#include <blaze/util/NonCopyable.h>
 #include <blaze/util/Null.h>
 #include <blaze/util/Types.h>
 #include <blaze/util/typetraits/IsBuiltin.h>
@@ -108,6 +109,50 @@ void deallocate( T* address )
 }
 //*************************************************************************************************
 
+
+
+
+//=================================================================================================
+//
+//  CLASS ALIGNEDARRAY
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!rief Scoped aligned array.
+//
+// The AlignedArray class template owns an array allocated via the allocate() function and
+// releases it via the deallocate() function as soon as it goes out of scope, for instance in
+// case an exception is thrown while the array is in use:
+
+   \code
+   AlignedArray<double> buffer( 100UL );  // Guaranteed to be 16-byte aligned
+   double* dp = buffer.get();
+   \endcode
+*/
+template< typename T >  // Type of the array elements
+class AlignedArray : private NonCopyable
+{
+ public:
+   //**Constructor*********************************************************************************
+   explicit inline AlignedArray( size_t size ) : ptr_( allocate<T>( size ) ) {}
+   //**********************************************************************************************
+
+   //**Destructor**********************************************************************************
+   inline ~AlignedArray() { deallocate( ptr_ ); }
+   //**********************************************************************************************
+
+   //**Access function*****************************************************************************
+   inline T* get() const { return ptr_; }  //!< Returns a pointer to the first array element.
+   //**********************************************************************************************
+
+ private:
+   //**Member variables****************************************************************************
+   T* ptr_;  //!< The first element of the aligned array.
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
 } // namespace blaze
 
 #endif
@@ -0,0 +1,585 @@
+//=================================================================================================
+/*!
+//  \file blaze/util/Philox.h
+//  \brief Header file for the Philox counter-based random number generator
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_UTIL_PHILOX_H_
+#define _BLAZE_UTIL_PHILOX_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/util/Assert.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  UNIFORM FLOATING POINT CONVERSION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Conversion of random 32-bit words to uniformly distributed floating point values.
+// \ingroup random
+//
+// The PhiloxUniform class template defines the number of 32-bit random words consumed for a
+// single floating point value of type \a T (\a draws) and the conversion of these words into
+// a value in the range \f$ [0..1) \f$. Float values use the 24 upper bits of a single word,
+// double and long double values use 53 bits of two words. The class template is only defined
+// for floating point data types.
+*/
+template< typename T >  // Floating point data type
+struct PhiloxUniform;
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Specialization of the PhiloxUniform class template for float values.
+// \ingroup random
+*/
+template<>
+struct PhiloxUniform<float>
+{
+   enum { draws = 1 };
+
+   static inline float convert( const uint32_t* w ) {
+      return static_cast<float>( static_cast<int32_t>( w[0] >> 8 ) ) * ( 1.0F / 16777216.0F );
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Specialization of the PhiloxUniform class template for double values.
+// \ingroup random
+*/
+template<>
+struct PhiloxUniform<double>
+{
+   enum { draws = 2 };
+
+   static inline double convert( const uint32_t* w ) {
+      return ( static_cast<double>( static_cast<int32_t>( w[0] >> 5 ) ) * 67108864.0 +
+               static_cast<double>( static_cast<int32_t>( w[1] >> 6 ) ) ) * ( 1.0 / 9007199254740992.0 );
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Specialization of the PhiloxUniform class template for long double values.
+// \ingroup random
+*/
+template<>
+struct PhiloxUniform<long double>
+{
+   enum { draws = 2 };
+
+   static inline long double convert( const uint32_t* w ) {
+      return PhiloxUniform<double>::convert( w );
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Counter-based Philox4x32-10 random number generator.
+// \ingroup random
+//
+// The Philox class implements the Philox4x32-10 random number generator by Salmon, Moraes,
+// Dror and Shaw ("Parallel random numbers: as easy as 1, 2, 3", SC'11). In contrast to the
+// classic generators the random numbers are not computed from an internal state, but directly
+// from a 128-bit counter and a 64-bit key by means of ten rounds of multiplications and XORs.
+// The key consists of the seed and the number of the stream, the counter is the index of the
+// block of four 32-bit random numbers within the stream. Therefore Philox provides \f$ 2^{32}
+// \f$ independent streams per seed and it is possible to jump to an arbitrary position of a
+// stream in constant time:
+
+   \code
+   blaze::Philox rng( 12345U, 3U );  // Stream 3 of seed 12345
+
+   blaze::uint32_t a = rng();  // Random number 0 of stream 3
+   rng.seek( 1000000U );       // Jumping to random number 1000000
+   blaze::uint32_t b = rng();  // Random number 1000000 of stream 3
+   \endcode
+
+// This is the foundation of a deterministic parallel random number generation: every thread
+// can generate exactly the random numbers of its part of a data structure, independent of the
+// number of threads. Additionally, the generation of several blocks at a time is vectorized by
+// the compiler, which makes the fill() functions considerably faster than the generation of
+// single random numbers.
+//
+// The Philox class satisfies the requirements of the uniform random number generator concept
+// of the boost library and can therefore be used with all boost distributions.
+*/
+class Philox
+{
+ public:
+   //**Type definitions****************************************************************************
+   typedef uint32_t  result_type;  //!< Type of the generated random numbers.
+   //**********************************************************************************************
+
+   //**Constructors********************************************************************************
+   /*!\name Constructors */
+   //@{
+   explicit inline Philox( uint32_t seed=5489U, uint32_t stream=0U );
+   // No explicitly declared copy constructor.
+   //@}
+   //**********************************************************************************************
+
+   //**Generation functions************************************************************************
+   /*!\name Generation functions */
+   //@{
+                          inline result_type operator()();
+                          inline float       uniform( float       min, float       max );
+                          inline double      uniform( double      min, double      max );
+                          inline long double uniform( long double min, long double max );
+   template< typename T > inline void        fill   ( T* first, size_t n, T min, T max );
+   //@}
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+                          inline result_type min     () const;
+                          inline result_type max     () const;
+                          inline uint32_t    getSeed  () const;
+                          inline uint32_t    getStream() const;
+                          inline uint64_t    position () const;
+                          inline void        seed     ( uint32_t seed );
+                          inline void        seek     ( uint64_t position );
+                          inline void        discard  ( uint64_t n );
+   template< typename T > inline void        skip     ( uint64_t n );
+   template< typename T > inline Philox      split    ( uint64_t n );
+   //@}
+   //**********************************************************************************************
+
+ private:
+   //**Constants***********************************************************************************
+   enum { blocks = 32UL };  //!< The number of blocks generated at a time.
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   template< size_t B >
+   static inline void generate( uint64_t block, uint32_t k0, uint32_t k1, uint32_t* words );
+   //@}
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   /*!\name Member variables */
+   //@{
+   uint32_t key_[2];              //!< The key of the generator (seed and stream).
+   uint64_t position_;            //!< The position of the next random number within the stream.
+   uint64_t cached_;              //!< The index of the currently cached group of blocks.
+   uint32_t buffer_[4UL*blocks];  //!< The cached random numbers of the current group of blocks.
+   //@}
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CONSTRUCTOR
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief The constructor for the Philox class.
+//
+// \param seed The seed of the random number generator.
+// \param stream The number of the random number stream.
+*/
+inline Philox::Philox( uint32_t seed, uint32_t stream )
+   : position_( 0U             )  // The position of the next random number within the stream
+   , cached_  ( ~uint64_t( 0U ) )  // The index of the currently cached group of blocks
+{
+   key_[0] = seed;
+   key_[1] = stream;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  GENERATION FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Generates the next random number of the stream.
+//
+// \return The generated random number in the range \f$ [0..2^{32}-1] \f$.
+//
+// The random numbers are generated and cached several blocks at a time, such that the Philox
+// rounds are vectorized also for the generation of single random numbers.
+*/
+inline Philox::result_type Philox::operator()()
+{
+   const uint64_t group( position_ / ( 4UL*blocks ) );
+
+   if( group != cached_ ) {
+      generate<blocks>( group*blocks, key_[0], key_[1], buffer_ );
+      cached_ = group;
+   }
+
+   return buffer_[(position_++) % ( 4UL*blocks )];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Generates a uniformly distributed float value.
+//
+// \param min The smallest possible random value.
+// \param max The upper bound of the random values.
+// \return The generated random value in the range \f$ [min..max) \f$.
+//
+// The function consumes a single random number of the stream.
+*/
+inline float Philox::uniform( float min, float max )
+{
+   const uint32_t w( (*this)() );
+   return min + ( max - min ) * PhiloxUniform<float>::convert( &w );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Generates a uniformly distributed double value.
+//
+// \param min The smallest possible random value.
+// \param max The upper bound of the random values.
+// \return The generated random value in the range \f$ [min..max) \f$.
+//
+// The function consumes two random numbers of the stream.
+*/
+inline double Philox::uniform( double min, double max )
+{
+   uint32_t w[2];
+   w[0] = (*this)();
+   w[1] = (*this)();
+   return min + ( max - min ) * PhiloxUniform<double>::convert( w );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Generates a uniformly distributed long double value.
+//
+// \param min The smallest possible random value.
+// \param max The upper bound of the random values.
+// \return The generated random value in the range \f$ [min..max) \f$.
+//
+// The function consumes two random numbers of the stream.
+*/
+inline long double Philox::uniform( long double min, long double max )
+{
+   uint32_t w[2];
+   w[0] = (*this)();
+   w[1] = (*this)();
+   return min + ( max - min ) * PhiloxUniform<long double>::convert( w );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Fills the given range with uniformly distributed floating point values.
+//
+// \param first Pointer to the first element of the range.
+// \param n The number of elements of the range.
+// \param min The smallest possible random value.
+// \param max The upper bound of the random values.
+// \return void
+//
+// This function fills the given range with random values in the range \f$ [min..max) \f$. The
+// result is identical to \a n consecutive calls of the uniform() function, but the random
+// numbers are generated several blocks at a time, which enables the compiler to vectorize the
+// Philox rounds and the conversion to floating point values. This function can only be used
+// for floating point data types. The attempt to use it with any other data type results in a
+// compilation error.
+*/
+template< typename T >  // Floating point data type
+inline void Philox::fill( T* first, size_t n, T min, T max )
+{
+   typedef PhiloxUniform<T>  U;
+
+   enum { values = 4UL * blocks / U::draws };
+
+   BLAZE_INTERNAL_ASSERT( min <= max, "Invalid min/max value pair" );
+
+   // Advancing to the beginning of the next block
+   for( ; n != 0UL && ( position_ & 3U ); --n )
+      *first++ = uniform( min, max );
+
+   if( ( position_ & 3U ) == 0U )
+   {
+      const T scale( max - min );
+      uint32_t words[4UL*blocks];
+
+      for( ; n >= values; n -= values ) {
+         generate<blocks>( position_ >> 2, key_[0], key_[1], words );
+         for( size_t j=0UL; j<values; ++j )
+            first[j] = min + scale * U::convert( words + j*U::draws );
+         position_ += 4UL*blocks;
+         first     += values;
+      }
+   }
+
+   for( ; n != 0UL; --n )
+      *first++ = uniform( min, max );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the smallest possible random number.
+//
+// \return The smallest possible random number.
+*/
+inline Philox::result_type Philox::min() const
+{
+   return 0U;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the largest possible random number.
+//
+// \return The largest possible random number.
+*/
+inline Philox::result_type Philox::max() const
+{
+   return 0xFFFFFFFFU;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the seed of the random number generator.
+//
+// \return The seed of the random number generator.
+*/
+inline uint32_t Philox::getSeed() const
+{
+   return key_[0];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the number of the random number stream.
+//
+// \return The number of the random number stream.
+*/
+inline uint32_t Philox::getStream() const
+{
+   return key_[1];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the position of the next random number within the stream.
+//
+// \return The number of random numbers generated since the beginning of the stream.
+*/
+inline uint64_t Philox::position() const
+{
+   return position_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Setting the seed of the random number generator.
+//
+// \param seed The new seed of the random number generator.
+// \return void
+//
+// This function sets the seed of the random number generator and restarts the stream from
+// the beginning. The number of the stream is not changed.
+*/
+inline void Philox::seed( uint32_t seed )
+{
+   key_[0]   = seed;
+   position_ = 0U;
+   cached_   = ~uint64_t( 0U );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Jumping to the given position of the stream.
+//
+// \param position The position of the next random number within the stream.
+// \return void
+*/
+inline void Philox::seek( uint64_t position )
+{
+   position_ = position;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Skipping the given number of random numbers.
+//
+// \param n The number of random numbers to be skipped.
+// \return void
+*/
+inline void Philox::discard( uint64_t n )
+{
+   position_ += n;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Skipping the random numbers for the given number of floating point values.
+//
+// \param n The number of floating point values of type \a T to be skipped.
+// \return void
+//
+// This function skips exactly the random numbers consumed by \a n calls of the uniform()
+// function for the floating point data type \a T.
+*/
+template< typename T >  // Floating point data type
+inline void Philox::skip( uint64_t n )
+{
+   position_ += n * PhiloxUniform<T>::draws;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Splitting off the random numbers for the given number of floating point values.
+//
+// \param n The number of floating point values of type \a T.
+// \return A generator positioned at the first random number of the split off part.
+//
+// This function splits off the random numbers for \a n floating point values of type \a T from
+// the stream and advances the generator past them. The returned generator is positioned at the
+// beginning of the next block of random numbers, such that the split off part can be filled by
+// several threads (see the fill() and skip() functions) with fully vectorized blocks.
+*/
+template< typename T >  // Floating point data type
+inline Philox Philox::split( uint64_t n )
+{
+   Philox rng( *this );
+   rng.position_ = ( position_ + 3U ) & ~uint64_t( 3U );
+   position_ = rng.position_ + n * PhiloxUniform<T>::draws;
+   return rng;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computation of \a B consecutive blocks of random numbers.
+//
+// \param block The index of the first block.
+// \param k0 The first word of the key.
+// \param k1 The second word of the key.
+// \param words The resulting \f$ 4 \cdot B \f$ random numbers in stream order.
+// \return void
+//
+// This function performs the ten Philox4x32 rounds for the counters \f$ (block+b,0) \f$ of
+// all \a B blocks simultaneously. All innermost loops run over the blocks, which enables the
+// compiler to vectorize the 32-bit multiplications.
+*/
+template< size_t B >  // Number of blocks
+inline void Philox::generate( uint64_t block, uint32_t k0, uint32_t k1, uint32_t* words )
+{
+   const uint32_t M0( 0xD2511F53U );
+   const uint32_t M1( 0xCD9E8D57U );
+
+   uint32_t c0[B], c1[B], c2[B], c3[B];
+
+   for( size_t b=0UL; b<B; ++b ) {
+      const uint64_t counter( block + b );
+      c0[b] = static_cast<uint32_t>( counter );
+      c1[b] = static_cast<uint32_t>( counter >> 32 );
+      c2[b] = 0U;
+      c3[b] = 0U;
+   }
+
+   for( size_t round=0UL; round<10UL; ++round )
+   {
+      for( size_t b=0UL; b<B; ++b ) {
+         const uint64_t p0( static_cast<uint64_t>( M0 ) * c0[b] );
+         const uint64_t p1( static_cast<uint64_t>( M1 ) * c2[b] );
+         const uint32_t tmp( c1[b] );
+         c0[b] = static_cast<uint32_t>( p1 >> 32 ) ^ tmp   ^ k0;
+         c1[b] = static_cast<uint32_t>( p1 );
+         c2[b] = static_cast<uint32_t>( p0 >> 32 ) ^ c3[b] ^ k1;
+         c3[b] = static_cast<uint32_t>( p0 );
+      }
+
+      k0 += 0x9E3779B9U;
+      k1 += 0xBB67AE85U;
+   }
+
+   for( size_t b=0UL; b<B; ++b ) {
+      words[4UL*b    ] = c0[b];
+      words[4UL*b+1UL] = c1[b];
+      words[4UL*b+2UL] = c2[b];
+      words[4UL*b+3UL] = c3[b];
+   }
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -30,11 +30,14 @@
 #include <ctime>
 #include <limits>
 #include <boost/random/uniform_int.hpp>
-#include <boost/random/uniform_real.hpp>
 #include <boost/random/uniform_smallint.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
 #include <blaze/system/Random.h>
+#include <blaze/system/ThreadLocal.h>
 #include <blaze/util/Assert.h>
 #include <blaze/util/NonCreatable.h>
+#include <blaze/util/Null.h>
 #include <blaze/util/Types.h>
 
 
@@ -45,13 +48,14 @@ namespace blaze {
 // \ingroup util
 //
 // The random number module provides the functionality to generate pseudo-random numbers within
-// the Blaze library. In order to create series of random numbers, the following four functions
+// the Blaze library. In order to create series of random numbers, the following five functions
 // are provided:
 //
 // - blaze::rand<T>();
 // - blaze::rand<T>( T min, T max );
 // - blaze::getSeed();
 // - blaze::setSeed( uint32_t seed );
+// - blaze::splitStream<T>( size_t n );
 //
 // The templated rand() functions are capable of generate random numbers for both built-in integer
 // and floating point data types. The following example demonstrates the random number generation:
@@ -72,27 +76,72 @@ namespace blaze {
 // \b Note: In order to reproduce certain series of random numbers, the seed of the random number
 // generator has to be set explicitly via the setSeed() function. Otherwise a random seed is used
 // for the random number generation.
+//
+// The random number functions can be used by several threads at the same time. Every thread
+// generates its random numbers from its own stream of the random number generator (see the
+// Philox class description). The streams are numbered in the order of the first use of a
+// random number function within a thread, i.e. in a single-threaded program all random numbers
+// stem from stream 0. In order to fill large data structures with random numbers, the stream of
+// the calling thread can be split via the splitStream() function. The resulting generator can
+// be used by several threads to generate their part of the random numbers in a deterministic
+// way, independent of the number of threads. This is for instance used by the randomize()
+// functions of the DynamicVector, DynamicMatrix and CompressedMatrix class templates:
+
+   \code
+   setSeed( 12345 );
+
+   blaze::DynamicMatrix<double> A( 1000UL, 1000UL );
+   randomize( A );  // Parallel initialization with random values in the range [0..1)
+   \endcode
 */
 /*!\brief Random number generator.
 // \ingroup random
 //
-// The Random class encapsulates the initialization of the given random number generator with
-// a pseudo-random seed obtained by the std::time() function. Currently, the mersenne-twister
-// mt19937 as provided by the boost library is used per default. For more information see the
-// class description of the boost library:
-//
-//   http://www.boost.org/doc/libs/1_35_0/libs/random/random-generators.html#mersenne_twister\n
-//   http://www.boost.org/doc/libs/1_35_0/boost/random/mersenne_twister.hpp
+// The Random class encapsulates the random number streams of all threads. The random number
+// generator of a thread is created on the first use of a random number function within the
+// thread and is initialized with the current seed and the next free stream number. The seed
+// is initially obtained by the std::time() function. Currently, the counter-based Philox4x32-10
+// generator is used per default (see the Philox class description).
 */
 template< typename Type >  // Type of the random number generator
 class Random : private NonCreatable
 {
  private:
+   //**Type definitions****************************************************************************
+   /*! \cond BLAZE_INTERNAL */
+   /*!\brief The random number stream of a single thread.
+   */
+   struct Stream
+   {
+      inline Stream( uint32_t seed, uint32_t stream, uint32_t epoch )
+         : rng_  ( seed, stream )  // The random number generator of the thread
+         , epoch_( epoch        )  // The seed epoch of the random number generator
+      {}
+
+      Type     rng_;    //!< The random number generator of the thread.
+      uint32_t epoch_;  //!< The seed epoch of the random number generator.
+   };
+   /*! \endcond */
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   static inline Type& rng();
+   //@}
+   //**********************************************************************************************
+
    //**Member variables****************************************************************************
    /*!\name Member variables */
    //@{
-   static uint32_t seed_;  //!< The current seed for the variate generator.
-   static Type     rng_;   //!< The mersenne twister variate generator.
+   static uint32_t                          seed_;     //!< The current seed for the variate generator.
+   static uint32_t                          epoch_;    //!< The number of seed changes.
+   static uint32_t                          streams_;  //!< The number of created streams.
+   static boost::mutex                      mutex_;    //!< Synchronization mutex for the creation of streams.
+   static boost::thread_specific_ptr<Stream> stream_;  //!< The random number stream of the calling thread.
+#if defined(BLAZE_THREAD_LOCAL)
+   static BLAZE_THREAD_LOCAL Stream*         cache_;   //!< Fast access to the stream of the calling thread.
+#endif
    //@}
    //**********************************************************************************************
 
@@ -102,6 +151,7 @@ class Random : private NonCreatable
    template< typename T > friend T        rand( T min, T max );
                           friend uint32_t getSeed();
                           friend void     setSeed( uint32_t seed );
+   template< typename T > friend RNG      splitStream( size_t n );
    /*! \endcond */
    //**********************************************************************************************
 };
@@ -116,8 +166,65 @@ class Random : private NonCreatable
 //
 //=================================================================================================
 
-template< typename Type > uint32_t Random<Type>::seed_( static_cast<uint32_t>( std::time(0) ) );
-template< typename Type > Type     Random<Type>::rng_ ( seed_ );
+template< typename Type > uint32_t     Random<Type>::seed_   ( static_cast<uint32_t>( std::time(0) ) );
+template< typename Type > uint32_t     Random<Type>::epoch_  ( 0U );
+template< typename Type > uint32_t     Random<Type>::streams_( 0U );
+template< typename Type > boost::mutex Random<Type>::mutex_;
+
+template< typename Type >
+boost::thread_specific_ptr<typename Random<Type>::Stream> Random<Type>::stream_;
+
+#if defined(BLAZE_THREAD_LOCAL)
+template< typename Type >
+BLAZE_THREAD_LOCAL typename Random<Type>::Stream* Random<Type>::cache_( 0 );
+#endif
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the random number generator of the calling thread.
+//
+// \return Reference to the random number generator of the calling thread.
+//
+// On the first call within a thread, this function creates the random number generator of the
+// thread with the current seed and the next free stream number. In case the seed has been
+// changed via the setSeed() function since the last call within the thread, the generator is
+// restarted with the new seed. The stream is owned by a boost::thread_specific_ptr, which
+// destroys it at the end of the thread. If available, the stream is accessed via a thread-local
+// pointer, which avoids the comparatively expensive lookup of the boost::thread_specific_ptr.
+*/
+template< typename Type >  // Type of the random number generator
+inline Type& Random<Type>::rng()
+{
+#if defined(BLAZE_THREAD_LOCAL)
+   Stream* stream( cache_ );
+#else
+   Stream* stream( stream_.get() );
+#endif
+
+   if( stream == NULL ) {
+      boost::mutex::scoped_lock lock( mutex_ );
+      stream = new Stream( seed_, streams_++, epoch_ );
+      stream_.reset( stream );
+#if defined(BLAZE_THREAD_LOCAL)
+      cache_ = stream;
+#endif
+   }
+   else if( stream->epoch_ != epoch_ ) {
+      stream->rng_.seed( seed_ );
+      stream->epoch_ = epoch_;
+   }
+
+   return stream->rng_;
+}
+//*************************************************************************************************
 
 
 
@@ -134,6 +241,7 @@ template< typename Type > Type     Random<Type>::rng_ ( seed_ );
 template< typename T > inline T    rand();
 template< typename T > inline T    rand( T min, T max );
                        inline void setSeed( uint32_t seed );
+template< typename T > inline RNG  splitStream( size_t n );
 //@}
 //*************************************************************************************************
 
@@ -153,7 +261,7 @@ template< typename T >
 inline T rand()
 {
    boost::uniform_int<T> dist( 0, std::numeric_limits<T>::max() );
-   return dist( Random<RNG>::rng_ );
+   return dist( Random<RNG>::rng() );
 }
 //*************************************************************************************************
 
@@ -170,8 +278,7 @@ inline T rand()
 template<>
 inline float rand<float>()
 {
-   boost::uniform_real<float> dist( 0.0F, 1.0F );
-   return dist( Random<RNG>::rng_ );
+   return Random<RNG>::rng().uniform( 0.0F, 1.0F );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -189,8 +296,7 @@ inline float rand<float>()
 template<>
 inline double rand<double>()
 {
-   boost::uniform_real<double> dist( 0.0, 1.0 );
-   return dist( Random<RNG>::rng_ );
+   return Random<RNG>::rng().uniform( 0.0, 1.0 );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -208,8 +314,7 @@ inline double rand<double>()
 template<>
 inline long double rand<long double>()
 {
-   boost::uniform_real<long double> dist( 0.0L, 1.0L );
-   return dist( Random<RNG>::rng_ );
+   return Random<RNG>::rng().uniform( 0.0L, 1.0L );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -233,7 +338,7 @@ inline T rand( T min, T max )
 {
    BLAZE_INTERNAL_ASSERT( min <= max, "Invalid min/max value pair" );
    boost::uniform_smallint<T> dist( min, max );
-   return dist( Random<RNG>::rng_ );
+   return dist( Random<RNG>::rng() );
 }
 //*************************************************************************************************
 
@@ -256,8 +361,7 @@ template<>
 inline float rand<float>( float min, float max )
 {
    BLAZE_INTERNAL_ASSERT( min <= max, "Invalid min/max value pair" );
-   boost::uniform_real<float> dist( min, max );
-   return dist( Random<RNG>::rng_ );
+   return Random<RNG>::rng().uniform( min, max );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -281,8 +385,7 @@ template<>
 inline double rand<double>( double min, double max )
 {
    BLAZE_INTERNAL_ASSERT( min <= max, "Invalid min/max values" );
-   boost::uniform_real<double> dist( min, max );
-   return dist( Random<RNG>::rng_ );
+   return Random<RNG>::rng().uniform( min, max );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -306,8 +409,7 @@ template<>
 inline long double rand<long double>( long double min, long double max )
 {
    BLAZE_INTERNAL_ASSERT( min <= max, "Invalid min/max values" );
-   boost::uniform_real<long double> dist( min, max );
-   return dist( Random<RNG>::rng_ );
+   return Random<RNG>::rng().uniform( min, max );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -334,12 +436,47 @@ inline uint32_t getSeed()
 // \return void
 //
 // This function can be used to set the seed for the random number generation in order to
-// create a reproducible series of random numbers.
+// create a reproducible series of random numbers. The random number streams of all threads
+// are restarted with the new seed. Note that this function must not be called while other
+// threads generate random numbers.
 */
 inline void setSeed( uint32_t seed )
 {
    Random<RNG>::seed_ = seed;
-   Random<RNG>::rng_.seed( seed );
+   ++Random<RNG>::epoch_;
+   Random<RNG>::rng();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Splitting off random numbers from the random number stream of the calling thread.
+// \ingroup random
+//
+// \param n The number of floating point values of type \a T.
+// \return A random number generator for the \a n floating point values.
+//
+// This function splits off the random numbers for \a n floating point values of type \a T from
+// the random number stream of the calling thread. The returned generator can be copied and used
+// by several threads in order to generate their part of the values in a deterministic way:
+
+   \code
+   const blaze::RNG rng( blaze::splitStream<double>( n ) );
+
+   // Generating the values in the range [begin..end) within a single thread
+   blaze::RNG local( rng );
+   local.skip<double>( begin );
+   local.fill( values+begin, end-begin, 0.0, 1.0 );
+   \endcode
+
+// The generated values are independent of the partitioning of the \a n values. This function
+// can only be used for floating point data types. The attempt to use it with any other data
+// type results in a compilation error.
+*/
+template< typename T >  // Floating point data type
+inline RNG splitStream( size_t n )
+{
+   return Random<RNG>::rng().template split<T>( n );
 }
 //*************************************************************************************************
 
@@ -35,6 +35,8 @@ const bool runArmadillo ( true );  // Armadillo benchmark tests
 const bool runMTL       ( true );  // MTL benchmark tests
 const bool runEigen     ( true );  // Eigen benchmark tests
 
+const bool runScaling   ( false );  // Thread scaling runs of the parallel Blaze kernels
+
 const size_t reps     ( 3     );  // Configuration of the number of benchmark repetitions
 const double runtime  ( 2.0   );  // Target runtime for a benchmark measurement
 const double maxtime  ( 600.0 );  // Maximum runtime of a single benchmark measurement [s]
@@ -117,6 +117,12 @@ struct Benchmarks
                             is available for a particular benchmark, the kernel is included in the
                             benchmark tests. In case the runEigen flag is set to \a false, the
                             Eigen kernel will be skipped.*/
+   bool runScaling;    //!< Flag value for the thread scaling runs of the Blaze kernels.
+                       /*!< In case the runScaling flag is set to \a true and in case the Blaze
+                            kernel of a particular benchmark is evaluated in parallel, the Blaze
+                            kernel is additionally run for an increasing number of threads. In
+                            case the runScaling flag is set to \a false, the scaling runs will be
+                            skipped.*/
    //@}
    //**********************************************************************************************
 };
@@ -145,6 +151,7 @@ inline Benchmarks::Benchmarks()
    , runArmadillo( blazemark::runArmadillo )  // Flag value for the Armadillo benchmark kernels
    , runMTL      ( blazemark::runMTL       )  // Flag value for the MTL benchmark kernels
    , runEigen    ( blazemark::runEigen     )  // Flag value for the Eigen benchmark kernels
+   , runScaling  ( blazemark::runScaling   )  // Flag value for the thread scaling runs
 {}
 //*************************************************************************************************
 
@@ -198,6 +205,8 @@ inline Benchmarks::Benchmarks()
 //   - \a -eigen: Activates the Eigen kernels.
 //   - \a -no-eigen: Deactives the Eigen kernels.
 //   - \a -only-eigen: Activates the Eigen kernels and deactivates all other.
+//   - \a -scaling: Activates the thread scaling runs of the parallel Blaze kernels.
+//   - \a -no-scaling: Deactivates the thread scaling runs of the parallel Blaze kernels.
 */
 inline void parseCommandLineArguments( int argc, char** argv, Benchmarks& benchmarks )
 {
@@ -383,6 +392,12 @@ inline void parseCommandLineArguments( int argc, char** argv, Benchmarks& benchm
          benchmarks.runMTL       = false;
          benchmarks.runEigen     = true;
       }
+      else if( std::strcmp( argv[i], "-scaling" ) == 0 ) {
+         benchmarks.runScaling = true;
+      }
+      else if( std::strcmp( argv[i], "-no-scaling" ) == 0 ) {
+         benchmarks.runScaling = false;
+      }
    }
 }
 //*************************************************************************************************
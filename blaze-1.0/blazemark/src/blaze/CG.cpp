@@ -28,6 +28,7 @@
 #include <vector>
 #include <blaze/math/CompressedMatrix.h>
 #include <blaze/math/DynamicVector.h>
+#include <blaze/math/solvers/CG.h>
 #include <blaze/util/Random.h>
 #include <blaze/util/Timing.h>
 #include <blazemark/blaze/CG.h>
@@ -53,14 +54,14 @@ namespace blaze {
 // \param iterations The number of iterations to perform.
 // \return Minimum runtime of the kernel function.
 //
-// This kernel function implements the conjugate gradient method by means of the Blaze
-// functionality.
+// This kernel function solves the linear system by means of the Blaze conjugate gradient
+// solver (see blaze::CG), which fuses the vector operations of each iteration with the
+// according reductions and executes all steps in parallel for large systems. In order to
+// perform the given number of iterations, the precision threshold of the solver is set to 0.
 */
 double cg( size_t N, size_t steps, size_t iterations )
 {
-   using ::blazemark::real;
-   using ::blaze::columnVector;
-   using ::blaze::rowMajor;
+   using ::blaze::real;
 
    ::blaze::setSeed( seed );
 
@@ -74,11 +75,14 @@ double cg( size_t N, size_t steps, size_t iterations )
       }
    }
 
-   ::blaze::CompressedMatrix<real,rowMajor> A( NN, NN, nnz );
-   ::blaze::DynamicVector<real,columnVector> x( NN ), b( NN ), r( NN ), d( NN ), h( NN ), init( NN );
-   real alpha, beta, delta;
+   ::blaze::CMatMxN A( NN, NN, nnz );
+   ::blaze::VecN x( NN ), b( NN );
+   ::blaze::CG solver;
    ::blaze::timing::WcTimer timer;
 
+   solver.setMaxIterations( iterations );
+   solver.setThreshold( real(0) );
+
    for( size_t i=0UL; i<N; ++i ) {
       for( size_t j=0UL; j<N; ++j ) {
          if( i > 0UL   ) A.append( i*N+j, (i-1UL)*N+j, -1.0 );  // Top neighbor
@@ -90,34 +94,18 @@ double cg( size_t N, size_t steps, size_t iterations )
    }
 
    for( size_t i=0UL; i<NN; ++i ) {
-      b[i]    = real(0);
-      init[i] = ::blaze::rand<real>();
+      b[i] = ::blaze::rand<real>();
    }
 
    for( size_t rep=0UL; rep<reps; ++rep )
    {
       timer.start();
-      for( size_t step=0UL; step<steps; ++step )
-      {
-         x = init;
-         r = A * x - b;
-         delta = trans(r) * r;
-         d = -r;
-
-         for( size_t iteration=0UL; iteration<iterations; ++iteration )
-         {
-            h = A * d;
-            alpha = delta / ( trans(d) * h );
-            x += alpha * d;
-            r += alpha * h;
-            beta = trans(r) * r;
-            d = ( beta / delta ) * d - r;
-            delta = beta;
-         }
+      for( size_t step=0UL; step<steps; ++step ) {
+         solver.solve( A, b, x );
       }
       timer.end();
 
-      if( x.size() != NN )
+      if( x.size() != NN || solver.getLastIterations() != iterations )
          std::cerr << " Line " << __LINE__ << ": ERROR detected!!!\n";
 
       if( timer.last() > maxtime )
@@ -66,17 +66,11 @@ double complex2( size_t N, size_t steps )
    ::blaze::DynamicVector<real,columnVector> a( N ), b( N ), c( N ), d( N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t j=0UL; j<N; ++j ) {
-      for( size_t i=0UL; i<N; ++i ) {
-         A(i,j) = ::blaze::rand<real>();
-      }
-   }
+   ::blaze::randomize( A );
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-      b[i] = ::blaze::rand<real>();
-      c[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
+   ::blaze::randomize( b );
+   ::blaze::randomize( c );
 
    d = A * ( a + b + c );
 
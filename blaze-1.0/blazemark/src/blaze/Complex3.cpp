@@ -66,17 +66,11 @@ double complex3( size_t N, size_t steps )
    ::blaze::DynamicVector<real,columnVector> a( N ), b( N ), c( N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t j=0UL; j<N; ++j ) {
-      for( size_t i=0UL; i<N; ++i ) {
-         A(i,j) = ::blaze::rand<real>();
-         B(i,j) = ::blaze::rand<real>();
-      }
-   }
+   ::blaze::randomize( A );
+   ::blaze::randomize( B );
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-      b[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
+   ::blaze::randomize( b );
 
    c = A * B * ( a + b );
 
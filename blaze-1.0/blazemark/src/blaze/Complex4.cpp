@@ -66,15 +66,9 @@ double complex4( size_t N, size_t steps )
    ::blaze::DynamicVector<real,columnVector> a( N ), b( N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t j=0UL; j<N; ++j ) {
-      for( size_t i=0UL; i<N; ++i ) {
-         A(i,j) = ::blaze::rand<real>();
-      }
-   }
+   ::blaze::randomize( A );
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
 
    b = real(0);
 
@@ -63,12 +63,8 @@ double complex8( size_t N, size_t steps )
    ::blaze::DynamicMatrix<real,columnMajor> A( N, N ), B( N, N ), C( N, N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t j=0UL; j<N; ++j ) {
-      for( size_t i=0UL; i<N; ++i ) {
-         A(i,j) = ::blaze::rand<real>();
-         B(i,j) = ::blaze::rand<real>();
-      }
-   }
+   ::blaze::randomize( A );
+   ::blaze::randomize( B );
 
    C = real(0);
 
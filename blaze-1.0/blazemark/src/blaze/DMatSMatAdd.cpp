@@ -67,11 +67,7 @@ double dmatsmatadd( size_t N, size_t F, size_t steps )
    ::blaze::CompressedMatrix<real,rowMajor> B( N, N, N*F );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      for( size_t j=0UL; j<N; ++j ) {
-         A(i,j) = ::blaze::rand<real>();
-      }
-   }
+   ::blaze::randomize( A );
 
    for( size_t i=0UL; i<N; ++i ) {
       B.reserve( i, F );
@@ -70,11 +70,7 @@ double dmatsvecmult( size_t N, size_t F, size_t steps )
    ::blaze::DynamicVector<real,columnVector> b( N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      for( size_t j=0UL; j<N; ++j ) {
-         A(i,j) = ::blaze::rand<real>();
-      }
-   }
+   ::blaze::randomize( A );
 
    {
       ::blazemark::Indices indices( N, F );
@@ -65,17 +65,9 @@ double dmattdmatadd( size_t N, size_t steps )
    ::blaze::DynamicMatrix<real,columnMajor> B( N, N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      for( size_t j=0UL; j<N; ++j ) {
-         A(i,j) = ::blaze::rand<real>();
-      }
-   }
+   ::blaze::randomize( A );
 
-   for( size_t j=0UL; j<N; ++j ) {
-      for( size_t i=0UL; i<N; ++i ) {
-         B(i,j) = ::blaze::rand<real>();
-      }
-   }
+   ::blaze::randomize( B );
 
    C = A + B;
 
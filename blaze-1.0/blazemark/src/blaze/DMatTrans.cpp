@@ -62,11 +62,7 @@ double dmattrans( size_t N, size_t steps )
    ::blaze::DynamicMatrix<real,rowMajor> A( N, N ), B( N, N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      for( size_t j=0UL; j<N; ++j ) {
-         A(i,j) = ::blaze::rand<real>();
-      }
-   }
+   ::blaze::randomize( A );
 
    B = trans( A );
 
@@ -63,10 +63,8 @@ double dvecdvecmult( size_t N, size_t steps )
    ::blaze::DynamicVector<real,columnVector> a( N ), b( N ), c( N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-      b[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
+   ::blaze::randomize( b );
 
    c = a * b;
 
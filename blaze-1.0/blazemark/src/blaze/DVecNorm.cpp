@@ -63,9 +63,7 @@ double dvecnorm( size_t N, size_t steps )
    real scalar( 0 );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
 
    for( size_t rep=0UL; rep<reps; ++rep )
    {
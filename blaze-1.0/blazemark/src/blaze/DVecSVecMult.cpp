@@ -68,9 +68,7 @@ double dvecsvecmult( size_t N, size_t F, size_t steps )
    ::blaze::CompressedVector<real,columnVector> b( N ), c( N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
 
    {
       ::blazemark::Indices indices( N, F );
@@ -63,9 +63,7 @@ double dvecscalarmult( size_t N, size_t steps )
    ::blaze::DynamicVector<real,columnVector> a( N ), b( N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
 
    b = a * real(2.2);
 
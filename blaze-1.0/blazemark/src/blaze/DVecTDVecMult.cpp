@@ -68,10 +68,8 @@ double dvectdvecmult( size_t N, size_t steps )
    ::blaze::DynamicMatrix<real,rowMajor> A( N, N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-      b[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
+   ::blaze::randomize( b );
 
    A = a * b;
 
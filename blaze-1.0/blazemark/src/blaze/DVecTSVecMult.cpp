@@ -71,9 +71,7 @@ double dvectsvecmult( size_t N, size_t F, size_t steps )
    ::blaze::CompressedMatrix<real,rowMajor> A( N, N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
 
    {
       ::blazemark::Indices indices( N, F );
@@ -76,9 +76,7 @@ double smatdvecmult( size_t N, size_t F, size_t steps )
       }
    }
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
 
    b = A * a;
 
@@ -74,9 +74,7 @@ double svecdvecmult( size_t N, size_t F, size_t steps )
       }
    }
 
-   for( size_t i=0UL; i<N; ++i ) {
-      b[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( b );
 
    c = a * b;
 
@@ -78,9 +78,7 @@ double svectdvecmult( size_t N, size_t F, size_t steps )
       }
    }
 
-   for( size_t i=0UL; i<N; ++i ) {
-      b[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( b );
 
    A = a * b;
 
@@ -69,11 +69,7 @@ double tdmatsmatadd( size_t N, size_t F, size_t steps )
    ::blaze::DynamicMatrix<real,rowMajor> C( N, N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t j=0UL; j<N; ++j ) {
-      for( size_t i=0UL; i<N; ++i ) {
-         A(i,j) = ::blaze::rand<real>();
-      }
-   }
+   ::blaze::randomize( A );
 
    for( size_t i=0UL; i<N; ++i ) {
       B.reserve( i, F );
@@ -66,10 +66,8 @@ double tdvecdvecmult( size_t N, size_t steps )
    real scalar( 0 );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-      b[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
+   ::blaze::randomize( b );
 
    for( size_t rep=0UL; rep<reps; ++rep )
    {
@@ -68,9 +68,7 @@ double tdvecsmatmult( size_t N, size_t F, size_t steps )
    ::blaze::DynamicVector<real,rowVector> a( N ), b( N );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
 
    for( size_t i=0UL; i<N; ++i ) {
       A.reserve( i, F );
@@ -69,9 +69,7 @@ double tdvecsvecmult( size_t N, size_t F, size_t steps )
    real scalar( 0 );
    ::blaze::timing::WcTimer timer;
 
-   for( size_t i=0UL; i<N; ++i ) {
-      a[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( a );
 
    {
       ::blazemark::Indices indices( N, F );
@@ -75,11 +75,7 @@ double tsmattdmatadd( size_t N, size_t F, size_t steps )
       }
    }
 
-   for( size_t j=0UL; j<N; ++j ) {
-      for( size_t i=0UL; i<N; ++i ) {
-         B(i,j) = ::blaze::rand<real>();
-      }
-   }
+   ::blaze::randomize( B );
 
    C = A + B;
 
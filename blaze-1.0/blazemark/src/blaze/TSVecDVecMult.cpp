@@ -76,9 +76,7 @@ double tsvecdvecmult( size_t N, size_t F, size_t steps )
       }
    }
 
-   for( size_t i=0UL; i<N; ++i ) {
-      b[i] = ::blaze::rand<real>();
-   }
+   ::blaze::randomize( b );
 
    for( size_t rep=0UL; rep<reps; ++rep )
    {
@@ -33,6 +33,7 @@
 #include <blaze/math/CompressedMatrix.h>
 #include <blaze/math/DynamicVector.h>
 #include <blaze/math/Functions.h>
+#include <blaze/math/smp/ThreadBackend.h>
 #include <blaze/util/Random.h>
 #include <blaze/util/Timing.h>
 #include <blazemark/blaze/CG.h>
@@ -196,6 +197,25 @@ void cg( std::vector<SolverRun>& runs, Benchmarks benchmarks )
       }
    }
 
+   if( benchmarks.runBlaze && benchmarks.runScaling ) {
+      const size_t maxThreads( ::blaze::getNumThreads() );
+      for( size_t threads=1UL; ; threads=std::min( 2UL*threads, maxThreads ) ) {
+         ::blaze::setNumThreads( threads );
+         std::cout << "   Blaze, " << threads << " threads [MFlop/s]:\n";
+         for( std::vector<SolverRun>::iterator run=runs.begin(); run!=runs.end(); ++run ) {
+            const size_t N         ( run->getSize()  );
+            const size_t steps     ( run->getSteps() );
+            const size_t iterations( run->getIterations() );
+            const double time( blazemark::blaze::cg( N, steps, iterations ) );
+            const double mflops( ( ( 13UL*N*N - 8UL*N - 1UL ) * steps +
+                                   ( 19UL*N*N - 8UL*N ) * steps * iterations ) / time / 1E6 );
+            std::cout << "     " << std::setw(12) << N << mflops << std::endl;
+         }
+         if( threads == maxThreads ) break;
+      }
+      ::blaze::setNumThreads( maxThreads );
+   }
+
    if( benchmarks.runBoost ) {
       std::cout << "   Boost uBLAS [MFlop/s]:\n";
       for( std::vector<SolverRun>::iterator run=runs.begin(); run!=runs.end(); ++run ) {
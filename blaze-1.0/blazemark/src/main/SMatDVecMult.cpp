@@ -34,6 +34,7 @@
 #include <blaze/math/DynamicVector.h>
 #include <blaze/math/Functions.h>
 #include <blaze/math/Infinity.h>
+#include <blaze/math/smp/ThreadBackend.h>
 #include <blaze/util/Timing.h>
 #include <blazemark/blaze/SMatDVecMult.h>
 #include <blazemark/boost/SMatDVecMult.h>
@@ -188,6 +189,29 @@ void smatdvecmult( std::vector<SparseRun>& runs, Benchmarks benchmarks )
       }
    }
 
+   if( benchmarks.runBlaze && benchmarks.runScaling ) {
+      const size_t maxThreads( ::blaze::getNumThreads() );
+      for( size_t threads=1UL; ; threads=std::min( 2UL*threads, maxThreads ) ) {
+         ::blaze::setNumThreads( threads );
+         std::vector<SparseRun>::iterator run=runs.begin();
+         while( run != runs.end() ) {
+            const float fill( run->getFillingDegree() );
+            std::cout << "   Blaze, " << threads << " threads (" << fill << "% filled) [MFlop/s]:\n";
+            for( ; run!=runs.end(); ++run ) {
+               if( run->getFillingDegree() != fill ) break;
+               const size_t N    ( run->getSize()     );
+               const size_t F    ( run->getNonZeros() );
+               const size_t steps( run->getSteps()    );
+               const double time ( blazemark::blaze::smatdvecmult( N, F, steps ) );
+               const double mflops( ( 2UL*N*F - N ) * steps / time / 1E6 );
+               std::cout << "     " << std::setw(12) << N << mflops << std::endl;
+            }
+         }
+         if( threads == maxThreads ) break;
+      }
+      ::blaze::setNumThreads( maxThreads );
+   }
+
    if( benchmarks.runBoost ) {
       std::vector<SparseRun>::iterator run=runs.begin();
       while( run != runs.end() ) {
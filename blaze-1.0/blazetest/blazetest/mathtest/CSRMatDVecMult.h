@@ -0,0 +1,433 @@
+//=================================================================================================
+/*!
+//  \file blazetest/mathtest/CSRMatDVecMult.h
+//  \brief Header file for the CSR matrix/dense vector multiplication math test
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_MATHTEST_CSRMATDVECMULT_H_
+#define _BLAZETEST_MATHTEST_CSRMATDVECMULT_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/CSRMatrix.h>
+#include <blaze/math/DynamicVector.h>
+#include <blazetest/system/MathTest.h>
+#include <blazetest/util/Creator.h>
+#include <blazetest/util/Utility.h>
+
+
+namespace blazetest {
+
+namespace mathtest {
+
+namespace csrmatdvecmult {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Auxiliary class template for the CSR matrix/dense vector multiplication math test.
+//
+// The CSRMatDVecMult class template represents one particular multiplication test between a
+// CSRMatrix and a dense vector with element type \a T. The results of the CSRMatrix are compared
+// to the results of a CompressedMatrix with the same non-zero elements. The CSRMatrix is used
+// both with internally managed memory and with external buffers.
+*/
+template< typename T >  // Element type of the matrix and vector
+class CSRMatDVecMult
+{
+ private:
+   //**Type definitions****************************************************************************
+   typedef blaze::CompressedMatrix<T,false>  MT;   //!< Reference matrix type
+   typedef blaze::CSRMatrix<T>               CMT;  //!< CSR matrix type
+   typedef blaze::DynamicVector<T,false>     VT;   //!< Dense vector type
+   typedef typename CMT::IndexType           IT;   //!< Index type of the CSR matrix
+   //**********************************************************************************************
+
+ public:
+   //**Constructors********************************************************************************
+   /*!\name Constructors */
+   //@{
+   explicit CSRMatDVecMult( const Creator<MT>& creator1, const Creator<VT>& creator2 );
+   // No explicitly declared copy constructor.
+   //@}
+   //**********************************************************************************************
+
+   //**Destructor**********************************************************************************
+   // No explicitly declared destructor.
+   //**********************************************************************************************
+
+ private:
+   //**Test functions******************************************************************************
+   /*!\name Test functions */
+   //@{
+   void testBasicOperation();
+   void testExternalBuffers();
+   void testIndexRange();
+   //@}
+   //**********************************************************************************************
+
+   //**Error detection functions*******************************************************************
+   /*!\name Error detection functions */
+   //@{
+   void checkResults();
+   //@}
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   /*!\name Member variables */
+   //@{
+   MT          reflhs_;  //!< The reference left-hand side compressed matrix.
+   CMT         lhs_;     //!< The left-hand side CSR matrix.
+   VT          rhs_;     //!< The right-hand side dense vector.
+   VT          res_;     //!< The result of the CSR matrix/dense vector multiplication.
+   VT          refres_;  //!< The reference result.
+   std::string test_;    //!< Label of the currently performed test.
+   //@}
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CONSTRUCTORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Constructor for the CSRMatDVecMult class template.
+//
+// \param creator1 The creator for the reference compressed matrix.
+// \param creator2 The creator for the right-hand side dense vector.
+// \exception std::runtime_error Operation error detected.
+*/
+template< typename T >  // Element type of the matrix and vector
+CSRMatDVecMult<T>::CSRMatDVecMult( const Creator<MT>& creator1, const Creator<VT>& creator2 )
+   : reflhs_( creator1() )  // The reference left-hand side compressed matrix
+   , lhs_   ( reflhs_ )     // The left-hand side CSR matrix
+   , rhs_   ( creator2() )  // The right-hand side dense vector
+   , res_   ()              // The result of the CSR matrix/dense vector multiplication
+   , refres_()              // The reference result
+   , test_  ()              // Label of the currently performed test
+{
+   testBasicOperation();
+   testExternalBuffers();
+   testIndexRange();
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  TEST FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Testing the plain CSR matrix/dense vector multiplication.
+//
+// \return void
+// \exception std::runtime_error Multiplication error detected.
+//
+// This function tests the plain multiplication with plain assignment, addition assignment,
+// and subtraction assignment. In case any error resulting from the multiplication or the
+// subsequent assignment is detected, a \a std::runtime_error exception is thrown.
+*/
+template< typename T >  // Element type of the matrix and vector
+void CSRMatDVecMult<T>::testBasicOperation()
+{
+   // Multiplication with the given matrix and vector
+   {
+      test_ = "Multiplication with the given matrix and vector";
+
+      res_    = lhs_ * rhs_;
+      refres_ = reflhs_ * rhs_;
+
+      checkResults();
+   }
+
+   // Multiplication with addition assignment
+   {
+      test_ = "Multiplication with addition assignment";
+
+      const VT init( reflhs_ * rhs_ + reflhs_ * rhs_ );
+
+      res_     = init;
+      refres_  = init;
+      res_    += lhs_ * rhs_;
+      refres_ += reflhs_ * rhs_;
+
+      checkResults();
+   }
+
+   // Multiplication with subtraction assignment
+   {
+      test_ = "Multiplication with subtraction assignment";
+
+      const VT init( reflhs_ * rhs_ + reflhs_ * rhs_ );
+
+      res_     = init;
+      refres_  = init;
+      res_    -= lhs_ * rhs_;
+      refres_ -= reflhs_ * rhs_;
+
+      checkResults();
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Testing the CSR matrix/dense vector multiplication on external buffers.
+//
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// This function tests a CSRMatrix that refers to external CSR buffers. The matrix has to operate
+// directly on the buffers, has to copy the buffers to internally managed memory before any
+// reallocation, and must not release the buffers. In case any error is detected, a
+// \a std::runtime_error exception is thrown.
+*/
+template< typename T >  // Element type of the matrix and vector
+void CSRMatDVecMult<T>::testExternalBuffers()
+{
+   const size_t m  ( lhs_.rows() );
+   const size_t nnz( lhs_.nonZeros() );
+
+   // Copies of the CSR arrays (with at least one element to provide valid buffer addresses)
+   std::vector<IT> offsets( lhs_.offsets(), lhs_.offsets()+m+1UL );
+   std::vector<IT> indices( nnz+1UL );
+   std::vector<T>  values ( nnz+1UL );
+   std::copy( lhs_.indices(), lhs_.indices()+nnz, indices.begin() );
+   std::copy( lhs_.values() , lhs_.values() +nnz, values.begin()  );
+
+   {
+      CMT ext( m, lhs_.columns(), &offsets[0], &indices[0], &values[0] );
+
+      // Multiplication with a matrix referring to external buffers
+      test_ = "Multiplication with a matrix referring to external buffers";
+
+      res_    = ext * rhs_;
+      refres_ = reflhs_ * rhs_;
+
+      checkResults();
+
+      // Modification of the values via the matrix
+      if( nnz > 0UL ) {
+         *ext.values() = T( 3 ) * values[0];
+
+         if( ext.values() != &values[0] || values[0] != *ext.values() ) {
+            std::ostringstream oss;
+            oss << " Test : Modification of the external values\n"
+                << " Error: The matrix does not operate on the external buffers\n"
+                << " Details:\n"
+                << "   Element type:\n"
+                << "     " << typeid( T ).name() << "\n";
+            throw std::runtime_error( oss.str() );
+         }
+
+         values[0] = lhs_.values()[0];
+      }
+
+      // Reallocation of the matrix
+      ext.reserve( nnz + 16UL );
+
+      if( ext.offsets() == &offsets[0] || ext.indices() == &indices[0] || ext.values() == &values[0] ) {
+         std::ostringstream oss;
+         oss << " Test : Reallocation of a matrix referring to external buffers\n"
+             << " Error: The matrix still refers to the external buffers\n"
+             << " Details:\n"
+             << "   Element type:\n"
+             << "     " << typeid( T ).name() << "\n";
+         throw std::runtime_error( oss.str() );
+      }
+
+      ext.reset();
+
+      test_ = "Multiplication with a reallocated matrix";
+
+      res_    = ext * rhs_;
+      refres_ = 0;
+
+      checkResults();
+   }
+
+   // The external buffers have to be unchanged after the destruction of the matrix
+   {
+      CMT ext( m, lhs_.columns(), &offsets[0], &indices[0], &values[0] );
+
+      test_ = "Multiplication with the external buffers after the destruction of a matrix";
+
+      res_    = ext * rhs_;
+      refres_ = reflhs_ * rhs_;
+
+      checkResults();
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Testing the range check of the 32-bit indices.
+//
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// This function tests that the creation of a CSRMatrix whose column indices or number of
+// non-zero elements exceed the range of the 32-bit indices results in a \a std::invalid_argument
+// exception. In case no exception is thrown, a \a std::runtime_error exception is thrown.
+*/
+template< typename T >  // Element type of the matrix and vector
+void CSRMatDVecMult<T>::testIndexRange()
+{
+   const size_t outOfRange( static_cast<size_t>( std::numeric_limits<IT>::max() ) + 1UL );
+
+   try {
+      CMT tmp( 1UL, outOfRange );
+
+      std::ostringstream oss;
+      oss << " Test : Construction with an out-of-range number of columns\n"
+          << " Error: No exception thrown\n"
+          << " Details:\n"
+          << "   Number of columns = " << outOfRange << "\n";
+      throw std::runtime_error( oss.str() );
+   }
+   catch( std::invalid_argument& ) {}
+
+   try {
+      CMT tmp( 1UL, 1UL );
+      tmp.reserve( outOfRange );
+
+      std::ostringstream oss;
+      oss << " Test : Reservation of an out-of-range number of non-zero elements\n"
+          << " Error: No exception thrown\n"
+          << " Details:\n"
+          << "   Number of non-zero elements = " << outOfRange << "\n";
+      throw std::runtime_error( oss.str() );
+   }
+   catch( std::invalid_argument& ) {}
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  ERROR DETECTION FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Checking and comparing the computed results.
+//
+// \return void
+// \exception std::runtime_error Incorrect result detected.
+//
+// This function is called after each test case to check and compare the computed results.
+// In case an error is detected, a \a std::runtime_error exception is thrown.
+*/
+template< typename T >  // Element type of the matrix and vector
+void CSRMatDVecMult<T>::checkResults()
+{
+   if( !isEqual( res_, refres_ ) ) {
+      std::ostringstream oss;
+      oss.precision( 20 );
+      oss << " Test : " << test_ << "\n"
+          << " Error: Incorrect dense result vector detected\n"
+          << " Details:\n"
+          << "   Element type:\n"
+          << "     " << typeid( T ).name() << "\n"
+          << "   Left-hand side CSR matrix:\n" << reflhs_ << "\n"
+          << "   Result:\n" << res_ << "\n"
+          << "   Expected result:\n" << refres_ << "\n";
+      throw std::runtime_error( oss.str() );
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  GLOBAL TEST FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Testing the CSR matrix/dense vector multiplication for a specific element type.
+//
+// \param creator1 The creator for the reference compressed matrix.
+// \param creator2 The creator for the right-hand side dense vector.
+// \return void
+*/
+template< typename T >  // Element type of the matrix and vector
+void runTest( const Creator< blaze::CompressedMatrix<T,false> >& creator1,
+              const Creator< blaze::DynamicVector<T,false> >& creator2 )
+{
+   for( size_t rep=0; rep<repetitions; ++rep ) {
+      CSRMatDVecMult<T>( creator1, creator2 );
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  MACRO DEFINITIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Macro for the execution of a CSR matrix/dense vector multiplication test case.
+*/
+#define RUN_CSRMATDVECMULT_TEST( C1, C2 ) \
+   blazetest::mathtest::csrmatdvecmult::runTest( C1, C2 )
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace csrmatdvecmult
+
+} // namespace mathtest
+
+} // namespace blazetest
+
+#endif
@@ -0,0 +1,299 @@
+//=================================================================================================
+/*!
+//  \file src/mathtest/compressedmatrix/Assembly.cpp
+//  \brief Source file for the CompressedMatrix triplet assembly math test
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include <blaze/math/AssemblyPattern.h>
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/math/typetraits/IsColumnMajorMatrix.h>
+#include <blaze/system/Thresholds.h>
+#include <blaze/util/Random.h>
+
+
+namespace {
+
+//=================================================================================================
+//
+//  AUXILIARY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Comparison of an assembled matrix with the expected matrix.
+//
+// \param test Label of the performed test.
+// \param A The assembled matrix.
+// \param ref The expected matrix.
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// Both the non-zero elements and the values have to match exactly, since the triplets of each
+// matrix element are summed up in the order of the triplet list.
+*/
+template< typename MT >  // Type of the compressed matrix
+void checkMatrix( const std::string& test, const MT& A, const MT& ref )
+{
+   typedef typename MT::ConstIterator  ConstIterator;
+
+   const size_t outer( ( blaze::IsColumnMajorMatrix<MT>::value )?( A.columns() ):( A.rows() ) );
+
+   bool equal( A.rows() == ref.rows() && A.columns() == ref.columns() &&
+               A.nonZeros() == ref.nonZeros() );
+
+   for( size_t i=0UL; equal && i<outer; ++i )
+   {
+      if( A.nonZeros( i ) != ref.nonZeros( i ) ) {
+         equal = false;
+         break;
+      }
+
+      for( ConstIterator a=A.begin(i), r=ref.begin(i); a!=A.end(i); ++a, ++r ) {
+         if( a->index() != r->index() || a->value() != r->value() ) {
+            equal = false;
+            break;
+         }
+      }
+   }
+
+   if( !equal ) {
+      std::ostringstream oss;
+      oss.precision( 20 );
+      oss << " Test : " << test << "\n"
+          << " Error: Incorrect assembled matrix detected\n"
+          << " Details:\n"
+          << "   Matrix type:\n"
+          << "     " << typeid( MT ).name() << "\n"
+          << "   Number of threads = " << blaze::getNumThreads() << "\n"
+          << "   Result:\n" << A << "\n"
+          << "   Expected result:\n" << ref << "\n";
+      throw std::runtime_error( oss.str() );
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  TEST FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Test of the assembly and the refill of a compressed matrix from triplets.
+//
+// \param m The number of rows of the matrix.
+// \param n The number of columns of the matrix.
+// \param triplets The number of triplets.
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// The triplets are drawn from a small number of matrix elements, such that most matrix elements
+// are hit by several (duplicate) triplets.
+*/
+template< typename MT >  // Type of the compressed matrix
+void testAssembly( size_t m, size_t n, size_t triplets )
+{
+   typedef typename MT::ConstIterator  ConstIterator;
+
+   const bool   SO   ( blaze::IsColumnMajorMatrix<MT>::value );
+   const size_t outer( ( SO )?( n ):( m ) );
+   const size_t inner( ( SO )?( m ):( n ) );
+
+   std::vector<size_t> rows( triplets ), columns( triplets );
+   std::vector<double> values( triplets );
+
+   for( size_t k=0UL; k<triplets; ++k ) {
+      rows[k]    = blaze::rand<size_t>( 0UL, m-1UL );
+      columns[k] = blaze::rand<size_t>( 0UL, n-1UL );
+      values[k]  = blaze::rand<int>( 1, 9 ) * 0.25;
+   }
+
+   MT ref( m, n );
+   for( size_t k=0UL; k<triplets; ++k )
+      ref( rows[k], columns[k] ) += values[k];
+
+   // Assembly of the matrix
+   MT A( m, n );
+   blaze::AssemblyPattern pattern;
+   blaze::assemble( A, rows.begin(), columns.begin(), values.begin(), triplets, pattern );
+   checkMatrix( "Assembly with duplicate triplets", A, ref );
+
+   if( pattern.triplets() != triplets || pattern.nonZeros() != ref.nonZeros() ||
+       A.capacity() != A.nonZeros() ) {
+      std::ostringstream oss;
+      oss << " Test : Assembly pattern\n"
+          << " Error: Invalid pattern size\n"
+          << " Details:\n"
+          << "   Number of triplets = " << pattern.triplets() << " (expected " << triplets << ")\n"
+          << "   Number of non-zeros = " << pattern.nonZeros() << " (expected " << ref.nonZeros() << ")\n"
+          << "   Capacity of the matrix = " << A.capacity() << " (expected " << A.nonZeros() << ")\n";
+      throw std::runtime_error( oss.str() );
+   }
+
+   // Refill of the matrix with new values
+   for( size_t k=0UL; k<triplets; ++k )
+      values[k] = blaze::rand<int>( 1, 9 ) * 0.5;
+
+   ref.reset();
+   for( size_t k=0UL; k<triplets; ++k )
+      ref( rows[k], columns[k] ) += values[k];
+
+   blaze::refill( A, values.begin(), pattern );
+   checkMatrix( "Refill with new triplet values", A, ref );
+
+   // Refill of a matrix with a different pattern with the same number of non-zero elements
+   for( size_t i=0UL; i<outer; ++i )
+   {
+      if( A.nonZeros( i ) == 0UL || A.nonZeros( i ) == inner )
+         continue;
+
+      // Moving the first non-zero element of row/column i to the first free index
+      size_t free( 0UL );
+      for( ConstIterator element=A.begin(i); element!=A.end(i) && element->index()==free; ++element )
+         ++free;
+
+      MT B( m, n );
+      for( size_t l=0UL; l<outer; ++l ) {
+         for( ConstIterator element=A.begin(l); element!=A.end(l); ++element ) {
+            const size_t index( ( l == i && element == A.begin(l) )?( free ):( element->index() ) );
+            if( SO ) B( index, l ) = element->value();
+            else     B( l, index ) = element->value();
+         }
+      }
+
+      const MT C( B );
+
+      try {
+         blaze::refill( B, values.begin(), pattern );
+
+         std::ostringstream oss;
+         oss << " Test : Refill of a matrix with a different sparsity pattern\n"
+             << " Error: No exception thrown\n";
+         throw std::runtime_error( oss.str() );
+      }
+      catch( std::invalid_argument& ) {}
+
+      checkMatrix( "Unchanged matrix after a failed refill", B, C );
+      break;
+   }
+
+   // Assembly with an out-of-range triplet index
+   {
+      const MT B( A );
+
+      rows[triplets/2UL] = m;
+
+      try {
+         blaze::assemble( A, rows.begin(), columns.begin(), values.begin(), triplets, pattern );
+
+         std::ostringstream oss;
+         oss << " Test : Assembly with an out-of-range row index\n"
+             << " Error: No exception thrown\n";
+         throw std::runtime_error( oss.str() );
+      }
+      catch( std::invalid_argument& ) {}
+
+      checkMatrix( "Unchanged matrix after a failed assembly", A, B );
+
+      if( pattern.triplets() != 0UL || pattern.nonZeros() != 0UL ) {
+         throw std::runtime_error( " Test : Assembly with an out-of-range row index\n"
+                                   " Error: The pattern has not been cleared\n" );
+      }
+
+      rows[triplets/2UL] = 0UL;
+      columns[triplets/2UL] = n;
+
+      try {
+         blaze::assemble( A, rows.begin(), columns.begin(), values.begin(), triplets );
+
+         std::ostringstream oss;
+         oss << " Test : Assembly with an out-of-range column index\n"
+             << " Error: No exception thrown\n";
+         throw std::runtime_error( oss.str() );
+      }
+      catch( std::invalid_argument& ) {}
+
+      checkMatrix( "Unchanged matrix after a failed assembly", A, B );
+   }
+}
+//*************************************************************************************************
+
+} // namespace
+
+
+
+
+//=================================================================================================
+//
+//  MAIN FUNCTION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+int main()
+{
+   std::cout << "   Running 'Assembly'..." << std::endl;
+
+   typedef blaze::CompressedMatrix<double,blaze::rowMajor>     MCa;
+   typedef blaze::CompressedMatrix<double,blaze::columnMajor>  MCb;
+
+   try
+   {
+      for( size_t threads=1UL; threads<=4UL; threads*=2UL )
+      {
+         blaze::setNumThreads( threads );
+
+         // Running tests with small matrices
+         for( size_t i=1UL; i<=6UL; ++i ) {
+            for( size_t j=1UL; j<=6UL; ++j ) {
+               testAssembly<MCa>( i, j, 3UL*i*j );
+               testAssembly<MCb>( i, j, 3UL*i*j );
+            }
+         }
+
+         // Running tests above the SMP threshold
+         const size_t triplets( blaze::SMP_ASSEMBLY_THRESHOLD + 17UL );
+         testAssembly<MCa>( 1031UL, 517UL, triplets );
+         testAssembly<MCb>( 1031UL, 517UL, triplets );
+      }
+   }
+   catch( std::exception& ex ) {
+      std::cerr << "\n\n ERROR DETECTED during compressed matrix assembly:\n"
+                << ex.what() << "\n";
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
+//*************************************************************************************************
@@ -73,6 +73,8 @@ int main()
       RUN_DMATDMATMULT_TEST( CMDa(  64UL,  64UL ), CMDa(  64UL,  64UL ) );
       RUN_DMATDMATMULT_TEST( CMDa( 128UL,  64UL ), CMDa(  64UL,  32UL ) );
       RUN_DMATDMATMULT_TEST( CMDa( 128UL,  64UL ), CMDa(  64UL, 128UL ) );
+      RUN_DMATDMATMULT_TEST( CMDa( 131UL, 257UL ), CMDa( 257UL,  97UL ) );
+      RUN_DMATDMATMULT_TEST( CMDa(  67UL, 300UL ), CMDa( 300UL, 129UL ) );
    }
    catch( std::exception& ex ) {
       std::cerr << "\n\n ERROR DETECTED during dense matrix/dense matrix multiplication:\n"
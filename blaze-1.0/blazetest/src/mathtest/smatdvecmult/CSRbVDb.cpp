@@ -0,0 +1,83 @@
+//=================================================================================================
+/*!
+//  \file src/mathtest/smatdvecmult/CSRbVDb.cpp
+//  \brief Source file for the CSRbVDb sparse matrix/dense vector multiplication math test
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <cstdlib>
+#include <iostream>
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/DynamicVector.h>
+#include <blazetest/mathtest/CSRMatDVecMult.h>
+#include <blazetest/system/MathTest.h>
+#include <blazetest/util/Creator.h>
+
+
+//=================================================================================================
+//
+//  MAIN FUNCTION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+int main()
+{
+   std::cout << "   Running 'CSRbVDb'..." << std::endl;
+
+   using blazetest::mathtest::TypeB;
+
+   try
+   {
+      // Matrix type definitions
+      typedef blaze::CompressedMatrix<TypeB>  MCb;
+      typedef blaze::DynamicVector<TypeB>     VDb;
+
+      // Creator type definitions
+      typedef blazetest::Creator<MCb>  CMCb;
+      typedef blazetest::Creator<VDb>  CVDb;
+
+      // Running tests with small matrices and vectors
+      for( size_t i=0UL; i<=6UL; ++i ) {
+         for( size_t j=0UL; j<=6UL; ++j ) {
+            for( size_t k=0UL; k<=i*j; ++k ) {
+               RUN_CSRMATDVECMULT_TEST( CMCb( j, i, k ), CVDb( i ) );
+            }
+         }
+      }
+
+      // Running tests with large matrices and vectors
+      RUN_CSRMATDVECMULT_TEST( CMCb(  67UL, 127UL, 13UL ), CVDb( 127UL ) );
+      RUN_CSRMATDVECMULT_TEST( CMCb( 127UL,  67UL,  7UL ), CVDb(  67UL ) );
+      RUN_CSRMATDVECMULT_TEST( CMCb(  64UL, 128UL, 16UL ), CVDb( 128UL ) );
+      RUN_CSRMATDVECMULT_TEST( CMCb( 128UL,  64UL,  8UL ), CVDb(  64UL ) );
+      RUN_CSRMATDVECMULT_TEST( CMCb( 513UL, 1031UL, 4099UL ), CVDb( 1031UL ) );
+   }
+   catch( std::exception& ex ) {
+      std::cerr << "\n\n ERROR DETECTED during CSR matrix/dense vector multiplication:\n"
+                << ex.what() << "\n";
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
+//*************************************************************************************************
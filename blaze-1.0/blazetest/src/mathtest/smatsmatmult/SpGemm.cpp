@@ -0,0 +1,304 @@
+//=================================================================================================
+/*!
+//  \file src/mathtest/smatsmatmult/SpGemm.cpp
+//  \brief Source file for the two-phase sparse matrix/sparse matrix multiplication math test
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/DynamicMatrix.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/math/sparse/SpGemm.h>
+#include <blaze/system/Thresholds.h>
+
+
+namespace {
+
+//=================================================================================================
+//
+//  TYPE DEFINITIONS
+//
+//=================================================================================================
+
+typedef blaze::CompressedMatrix<int,blaze::rowMajor>     MCa;  //!< Row-major test matrix type.
+typedef blaze::CompressedMatrix<int,blaze::columnMajor>  MCb;  //!< Column-major test matrix type.
+
+//! Minimum ratio between the size of a row/column and its partial products for the hash mode.
+const size_t hashRatio( blaze::SpGemmAccumulator<int>::hashRatio );
+
+
+
+
+//=================================================================================================
+//
+//  AUXILIARY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Creating a row-major test operand.
+//
+// \param m The number of rows of the operand.
+// \param n The number of columns of the operand.
+// \param nonzeros The number of non-zero elements of every \a stride-th row.
+// \param stride The stride of the rows with \a nonzeros non-zero elements.
+// \return The test operand.
+//
+// All rows except every \a stride-th row contain two non-zero elements. The non-zero elements
+// of each row are evenly spread and the values are small integers, such that the products are
+// computed exactly.
+*/
+MCa createOperand( size_t m, size_t n, size_t nonzeros, size_t stride )
+{
+   MCa A( m, n );
+
+   for( size_t i=0UL; i<m; ++i ) {
+      const size_t count( ( i % stride == 0UL )?( nonzeros ):( 2UL ) );
+      for( size_t l=0UL; l<count; ++l ) {
+         const int value( int( ( i*7UL + l*3UL ) % 9UL ) - 4 );
+         A( i, ( i + l*( n/count ) ) % n ) = ( value != 0 )?( value ):( 5 );
+      }
+   }
+
+   return A;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Creating two row-major test operands whose product contains cancelled elements.
+//
+// \param m The number of rows of the left-hand side operand.
+// \param n The number of columns of the right-hand side operand.
+// \param A The resulting \f$ m \times 2m \f$ left-hand side operand.
+// \param B The resulting \f$ 2m \times n \f$ right-hand side operand.
+// \return void
+//
+// Each row \a i of the product \f$ A*B \f$ is the sum of the rows \f$ 2i \f$ and \f$ 2i+1 \f$
+// of \a B, which contain opposite values in column \f$ i \bmod n \f$. Additionally, in every
+// third row of the product all elements cancel, i.e. the row is empty.
+*/
+void createCancellation( size_t m, size_t n, MCa& A, MCa& B )
+{
+   A.resize( m, 2UL*m, false );
+   B.resize( 2UL*m, n, false );
+   A.reset();
+   B.reset();
+
+   for( size_t i=0UL; i<m; ++i )
+   {
+      const size_t j1( i % n ), j2( ( i+1UL ) % n ), j3( ( i+2UL ) % n );
+
+      A( i, 2UL*i     ) = 1;
+      A( i, 2UL*i+1UL ) = 1;
+
+      B( 2UL*i    , j1 ) =  3;
+      B( 2UL*i    , j2 ) =  1;
+      B( 2UL*i+1UL, j1 ) = -3;
+
+      if( i % 3UL == 0UL )
+         B( 2UL*i+1UL, j2 ) = -1;
+      else
+         B( 2UL*i+1UL, j3 ) =  2;
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  TEST FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Comparison of a sparse matrix multiplication with a reference result.
+//
+// \param test Label of the performed test.
+// \param A The left-hand side operand.
+// \param B The right-hand side operand.
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// The result has to match the reference result exactly. Additionally, the result must not
+// contain any explicitly stored zero elements (e.g. due to cancellation).
+*/
+template< typename MT >  // Type of the operands
+void checkProduct( const std::string& test, const MT& A, const MT& B )
+{
+   MT C( A.rows(), B.columns() );
+   C = A * B;
+
+   // Computing the reference result
+   const MCa Ar( A ), Br( B ), Cr( C );
+
+   blaze::DynamicMatrix<int> ref( A.rows(), B.columns(), 0 );
+   for( size_t i=0UL; i<Ar.rows(); ++i ) {
+      for( MCa::ConstIterator a=Ar.begin(i); a!=Ar.end(i); ++a ) {
+         for( MCa::ConstIterator b=Br.begin( a->index() ); b!=Br.end( a->index() ); ++b )
+            ref( i, b->index() ) += a->value() * b->value();
+      }
+   }
+
+   size_t nonzeros( 0UL );
+   for( size_t i=0UL; i<ref.rows(); ++i ) {
+      for( size_t j=0UL; j<ref.columns(); ++j ) {
+         if( ref(i,j) != 0 ) ++nonzeros;
+      }
+   }
+
+   // Comparing the result
+   bool equal( Cr.rows() == ref.rows() && Cr.columns() == ref.columns() &&
+               Cr.nonZeros() == nonzeros );
+
+   for( size_t i=0UL; equal && i<Cr.rows(); ++i ) {
+      for( MCa::ConstIterator c=Cr.begin(i); c!=Cr.end(i); ++c ) {
+         if( c->value() == 0 || c->value() != ref( i, c->index() ) ) {
+            equal = false;
+            break;
+         }
+      }
+   }
+
+   if( !equal ) {
+      std::ostringstream oss;
+      oss << " Test : " << test << "\n"
+          << " Error: Incorrect sparse matrix multiplication result detected\n"
+          << " Details:\n"
+          << "   Matrix type:\n"
+          << "     " << typeid( MT ).name() << "\n"
+          << "   Number of threads = " << blaze::getNumThreads() << "\n"
+          << "   Result: " << Cr.rows() << "x" << Cr.columns() << " with " << Cr.nonZeros()
+          << " non-zero elements\n"
+          << "   Expected result: " << ref.rows() << "x" << ref.columns() << " with " << nonzeros
+          << " non-zero elements\n";
+      throw std::runtime_error( oss.str() );
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Test of the row-major and column-major multiplication of the given operands.
+//
+// \param test Label of the performed test.
+// \param A The row-major left-hand side operand.
+// \param B The row-major right-hand side operand.
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// The column-major product is computed as \f$ B^T * A^T \f$, such that each column of the
+// column-major result is accumulated from the same partial products as the according row of
+// the row-major result.
+*/
+void testProduct( const std::string& test, const MCa& A, const MCa& B )
+{
+   checkProduct( test + " (row-major)", A, B );
+
+   const MCb At( trans( A ) ), Bt( trans( B ) );
+   checkProduct( test + " (column-major)", Bt, At );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Test of the sparse matrix multiplication in both modes of the sparse accumulator.
+//
+// \param m The number of rows/columns of the result to be accumulated.
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// Each row/column of the result is accumulated in a hash table in case the number of partial
+// products times the \a hashRatio is smaller than the size of the row/column, and in a dense
+// array otherwise.
+*/
+void testMultiplication( size_t m )
+{
+   // Hash mode: 4 partial products per row and 64*hashRatio columns
+   testProduct( "Hash accumulation",
+                createOperand( m, m, 2UL, 1UL ), createOperand( m, 64UL*hashRatio, 2UL, 1UL ) );
+
+   // Dense mode: 4 partial products per row and hashRatio columns
+   testProduct( "Dense accumulation",
+                createOperand( m, m, 2UL, 1UL ), createOperand( m, hashRatio, 2UL, 1UL ) );
+
+   // Mixed mode: 16 partial products in every 5th row, 4 otherwise, and 16*hashRatio columns
+   testProduct( "Mixed accumulation",
+                createOperand( m, m, 8UL, 5UL ), createOperand( m, 16UL*hashRatio, 2UL, 1UL ) );
+
+   // Cancellation to exact zero in both modes
+   MCa A, B;
+
+   createCancellation( m, 64UL*hashRatio, A, B );
+   testProduct( "Cancellation in the hash accumulation", A, B );
+
+   createCancellation( m, hashRatio, A, B );
+   testProduct( "Cancellation in the dense accumulation", A, B );
+}
+//*************************************************************************************************
+
+} // namespace
+
+
+
+
+//=================================================================================================
+//
+//  MAIN FUNCTION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+int main()
+{
+   std::cout << "   Running 'SpGemm'..." << std::endl;
+
+   try
+   {
+      for( size_t threads=1UL; threads<=4UL; threads*=2UL )
+      {
+         blaze::setNumThreads( threads );
+
+         // Running tests below the SMP threshold
+         testMultiplication( 37UL );
+
+         // Running tests above the SMP threshold
+         testMultiplication( blaze::SMP_SMATSMATMULT_THRESHOLD + 37UL );
+      }
+   }
+   catch( std::exception& ex ) {
+      std::cerr << "\n\n ERROR DETECTED during two-phase sparse matrix/sparse matrix multiplication:\n"
+                << ex.what() << "\n";
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
+//*************************************************************************************************
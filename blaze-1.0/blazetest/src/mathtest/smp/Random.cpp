@@ -0,0 +1,259 @@
+//=================================================================================================
+/*!
+//  \file src/mathtest/smp/Random.cpp
+//  \brief Source file for the parallel random number generation math test
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/DynamicMatrix.h>
+#include <blaze/math/DynamicVector.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/system/Thresholds.h>
+#include <blaze/util/Philox.h>
+#include <blaze/util/Random.h>
+
+
+namespace {
+
+//=================================================================================================
+//
+//  AUXILIARY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Randomizing the given vector or matrix with the given number of threads.
+//
+// \param target The vector or matrix to be randomized.
+// \param threads The number of threads.
+// \return void
+//
+// The seed of the random number generator is reset before the randomization, such that the
+// calling thread always uses the same random number stream.
+*/
+template< typename T >  // Type of the vector or matrix
+void randomize( T& target, size_t threads )
+{
+   blaze::setNumThreads( threads );
+   blaze::setSeed( 12345U );
+   blaze::randomize( target, -1.0, 1.0 );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Comparison of a randomized vector or matrix with the sequentially randomized result.
+//
+// \param test Label of the performed test.
+// \param result The result of the parallel randomization.
+// \param ref The result of the sequential randomization.
+// \param threads The number of threads of the parallel randomization.
+// \return void
+// \exception std::runtime_error Error detected.
+*/
+template< typename T >  // Type of the vector or matrix
+void checkResult( const std::string& test, const T& result, const T& ref, size_t threads )
+{
+   if( !( result == ref ) ) {
+      std::ostringstream oss;
+      oss << " Test : " << test << "\n"
+          << " Error: The result depends on the number of threads\n"
+          << " Details:\n"
+          << "   Type:\n"
+          << "     " << typeid( T ).name() << "\n"
+          << "   Number of threads = " << threads << "\n";
+      throw std::runtime_error( oss.str() );
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  TEST FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Test of the Philox4x32-10 random number generator with a known answer.
+//
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// The first block of stream 0 of seed 0 corresponds to the counter 0 and the key 0, for which
+// the reference implementation of Philox4x32-10 (Random123) computes the given random numbers.
+*/
+void testPhilox()
+{
+   const blaze::uint32_t expected[4] = { 0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U };
+
+   blaze::Philox rng( 0U, 0U );
+
+   for( size_t i=0UL; i<4UL; ++i )
+   {
+      const blaze::uint32_t value( rng() );
+
+      if( value != expected[i] ) {
+         std::ostringstream oss;
+         oss << std::hex;
+         oss << " Test : Philox4x32-10 known answer\n"
+             << " Error: Incorrect random number detected\n"
+             << " Details:\n"
+             << "   Index = " << i << "\n"
+             << "   Result = " << value << "\n"
+             << "   Expected result = " << expected[i] << "\n";
+         throw std::runtime_error( oss.str() );
+      }
+   }
+
+   // Jumping back to the first block
+   rng.seek( 0U );
+
+   if( rng() != expected[0] ) {
+      throw std::runtime_error( " Test : Philox4x32-10 known answer after a seek\n"
+                                " Error: Incorrect random number detected\n" );
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Test of the parallel randomization of large vectors and matrices.
+//
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// The randomize() functions have to assign the same values independent of the number of
+// threads. The number of columns of the dense matrices is chosen such that the rows/columns
+// contain padding elements.
+*/
+void testRandomize()
+{
+   typedef blaze::DynamicVector<double>                         VT;
+   typedef blaze::DynamicMatrix<double,blaze::rowMajor>         MTa;
+   typedef blaze::DynamicMatrix<double,blaze::columnMajor>      MTb;
+   typedef blaze::CompressedMatrix<double,blaze::rowMajor>      MCa;
+   typedef blaze::CompressedMatrix<double,blaze::columnMajor>   MCb;
+
+   const size_t N( 97UL );
+   const size_t M( blaze::SMP_RANDOMIZE_THRESHOLD / N + 13UL );
+   const size_t S( blaze::SMP_RANDOMIZE_THRESHOLD / 7UL + 13UL );
+
+   // Setup of the sparsity pattern of the compressed matrices (7 non-zeros per row/column)
+   MCa A( S, N, S*7UL );
+   MCb B( N, S, S*7UL );
+
+   for( size_t i=0UL; i<S; ++i ) {
+      for( size_t j=i%3UL; j<N; j+=14UL ) {
+         A.append( i, j, 1.0 );
+         B.append( j, i, 1.0 );
+      }
+      A.finalize( i );
+      B.finalize( i );
+   }
+
+   if( A.nonZeros() < blaze::SMP_RANDOMIZE_THRESHOLD ) {
+      throw std::runtime_error( " Test : Setup of the compressed matrices\n"
+                                " Error: Invalid number of non-zero elements\n" );
+   }
+
+   // Sequential randomization
+   VT  v( M*N );
+   MTa C( M, N );
+   MTb D( N, M );
+   MCa E( A );
+   MCb F( B );
+
+   randomize( v, 1UL );
+   randomize( C, 1UL );
+   randomize( D, 1UL );
+   randomize( E, 1UL );
+   randomize( F, 1UL );
+
+   if( v[0UL] == 0.0 || E == A || F == B ) {
+      throw std::runtime_error( " Test : Sequential randomization\n"
+                                " Error: The values have not been randomized\n" );
+   }
+
+   // Parallel randomization
+   for( size_t threads=2UL; threads<=4UL; ++threads )
+   {
+      VT  v2( M*N );
+      MTa C2( M, N );
+      MTb D2( N, M );
+      MCa E2( A );
+      MCb F2( B );
+
+      randomize( v2, threads );
+      randomize( C2, threads );
+      randomize( D2, threads );
+      randomize( E2, threads );
+      randomize( F2, threads );
+
+      checkResult( "Parallel randomization of a dense vector", v2, v, threads );
+      checkResult( "Parallel randomization of a row-major dense matrix", C2, C, threads );
+      checkResult( "Parallel randomization of a column-major dense matrix", D2, D, threads );
+      checkResult( "Parallel randomization of a row-major sparse matrix", E2, E, threads );
+      checkResult( "Parallel randomization of a column-major sparse matrix", F2, F, threads );
+   }
+}
+//*************************************************************************************************
+
+} // namespace
+
+
+
+
+//=================================================================================================
+//
+//  MAIN FUNCTION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+int main()
+{
+   std::cout << "   Running 'Random'..." << std::endl;
+
+   try
+   {
+      testPhilox();
+      testRandomize();
+   }
+   catch( std::exception& ex ) {
+      std::cerr << "\n\n ERROR DETECTED during parallel random number generation:\n"
+                << ex.what() << "\n";
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
+//*************************************************************************************************
@@ -0,0 +1,177 @@
+//=================================================================================================
+/*!
+//  \file src/mathtest/smp/SMatDVecMult.cpp
+//  \brief Source file for the parallel sparse matrix/dense vector multiplication math test
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <blaze/math/CompressedMatrix.h>
+#include <blaze/math/DynamicVector.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/system/Thresholds.h>
+
+
+namespace {
+
+//=================================================================================================
+//
+//  TEST FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Comparison of the result of a parallel multiplication with the expected result.
+//
+// \param test Label of the performed test.
+// \param result The result vector.
+// \param expected The expected result vector.
+// \return void
+// \exception std::runtime_error Error detected.
+*/
+void checkResult( const std::string& test, const blaze::DynamicVector<int>& result,
+                  const blaze::DynamicVector<int>& expected )
+{
+   for( size_t i=0UL; i<expected.size(); ++i ) {
+      if( result[i] != expected[i] ) {
+         std::ostringstream oss;
+         oss << " Test : " << test << "\n"
+             << " Error: Incorrect result detected\n"
+             << " Details:\n"
+             << "   Size    = " << expected.size() << "\n"
+             << "   Index   = " << i << "\n"
+             << "   Result  = " << result[i] << "\n"
+             << "   Expected result = " << expected[i] << "\n";
+         throw std::runtime_error( oss.str() );
+      }
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Test of the parallel sparse matrix/dense vector multiplications.
+//
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// The test matrix exceeds both the SMP_SMATDVECMULT_THRESHOLD and the SMP_TSMATDVECMULT_THRESHOLD.
+// Every 17th row holds considerably more non-zero elements than the remaining rows, such that a
+// partitioning into blocks of equal number of non-zero elements differs from a partitioning into
+// blocks of equal number of rows/columns.
+*/
+void testMultiplication()
+{
+   const size_t N( std::max( blaze::SMP_SMATDVECMULT_THRESHOLD,
+                             blaze::SMP_TSMATDVECMULT_THRESHOLD ) + 37UL );
+
+   blaze::CompressedMatrix<int,blaze::rowMajor> A( N, N );
+   A.reserve( 10UL*N );
+
+   for( size_t i=0UL; i<N; ++i ) {
+      const size_t nonzeros( ( i % 17UL == 0UL )?( 60UL ):( 3UL ) );
+      const size_t stride  ( N / nonzeros );
+      for( size_t k=0UL; k<nonzeros; ++k ) {
+         A.append( i, k*stride + i%stride, int( ( i+k ) % 11UL ) - 5 );
+      }
+      A.finalize( i );
+   }
+
+   const blaze::CompressedMatrix<int,blaze::columnMajor> B( A );
+
+   blaze::DynamicVector<int> x( N );
+   for( size_t j=0UL; j<N; ++j )
+      x[j] = int( j % 7UL ) - 3;
+
+   blaze::DynamicVector<int> ref( N, 0 );
+   for( size_t i=0UL; i<N; ++i ) {
+      for( blaze::CompressedMatrix<int,blaze::rowMajor>::ConstIterator element=A.begin(i); element!=A.end(i); ++element )
+         ref[i] += element->value() * x[element->index()];
+   }
+
+   const blaze::DynamicVector<int> init( 2*ref + x );
+
+   blaze::DynamicVector<int> y( N );
+
+   // Row-major sparse matrix/dense vector multiplication
+   y = A * x;
+   checkResult( "Parallel row-major assignment", y, ref );
+
+   y = init;
+   y += A * x;
+   checkResult( "Parallel row-major addition assignment", y, init + ref );
+
+   y = init;
+   y -= A * x;
+   checkResult( "Parallel row-major subtraction assignment", y, init - ref );
+
+   // Column-major sparse matrix/dense vector multiplication
+   y = B * x;
+   checkResult( "Parallel column-major assignment", y, ref );
+
+   y = init;
+   y += B * x;
+   checkResult( "Parallel column-major addition assignment", y, init + ref );
+
+   y = init;
+   y -= B * x;
+   checkResult( "Parallel column-major subtraction assignment", y, init - ref );
+}
+//*************************************************************************************************
+
+} // namespace
+
+
+
+
+//=================================================================================================
+//
+//  MAIN FUNCTION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+int main()
+{
+   std::cout << "   Running 'SMatDVecMult'..." << std::endl;
+
+   try
+   {
+      for( size_t threads=1UL; threads<=4UL; ++threads ) {
+         blaze::setNumThreads( threads );
+         testMultiplication();
+      }
+   }
+   catch( std::exception& ex ) {
+      std::cerr << "\n\n ERROR DETECTED during parallel sparse matrix/dense vector multiplication:\n"
+                << ex.what() << "\n";
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
+//*************************************************************************************************
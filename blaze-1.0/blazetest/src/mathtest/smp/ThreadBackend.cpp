@@ -0,0 +1,234 @@
+//=================================================================================================
+/*!
+//  \file src/mathtest/smp/ThreadBackend.cpp
+//  \brief Source file for the shared memory parallelization math test
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <blaze/math/DynamicMatrix.h>
+#include <blaze/math/DynamicVector.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/system/Thresholds.h>
+#include <blaze/util/Random.h>
+
+
+namespace {
+
+//=================================================================================================
+//
+//  AUXILIARY TASKS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Range task counting the executions of each index, throwing in the first partition.
+*/
+struct ThrowingTask
+{
+   typedef void  result_type;  //!< Result type of the task.
+
+   explicit ThrowingTask( std::vector<size_t>& counts ) : counts_( &counts ) {}
+
+   void operator()( size_t begin, size_t end ) const {
+      for( size_t i=begin; i<end; ++i )
+         ++(*counts_)[i];
+      if( begin == 0UL )
+         throw std::runtime_error( "Partition failure" );
+   }
+
+   std::vector<size_t>* counts_;  //!< The execution count of each index.
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  TEST FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Test of the parallel assignment of large dense vectors.
+//
+// \return void
+// \exception std::runtime_error Error detected.
+*/
+void testDenseVectorAssignment()
+{
+   const size_t N( blaze::SMP_DVECASSIGN_THRESHOLD + 123UL );
+
+   blaze::DynamicVector<double> a( N ), b( N ), c( N );
+   blaze::randomize( b );
+   blaze::randomize( c );
+
+   a = b + c;
+   a += b;
+   a -= c;
+
+   for( size_t i=0UL; i<N; ++i ) {
+      if( a[i] != ( b[i] + c[i] ) + b[i] - c[i] ) {
+         std::ostringstream oss;
+         oss << " Test : Parallel dense vector assignment\n"
+             << " Error: Incorrect result detected\n"
+             << " Details:\n"
+             << "   Size    = " << N << "\n"
+             << "   Index   = " << i << "\n"
+             << "   Result  = " << a[i] << "\n"
+             << "   Expected result = " << ( b[i] + c[i] ) + b[i] - c[i] << "\n";
+         throw std::runtime_error( oss.str() );
+      }
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Test of the parallel assignment of large dense matrices.
+//
+// \return void
+// \exception std::runtime_error Error detected.
+*/
+void testDenseMatrixAssignment()
+{
+   const size_t N( 97UL );
+   const size_t M( blaze::SMP_DMATASSIGN_THRESHOLD / N + 1UL );
+
+   blaze::DynamicMatrix<double> A( M, N ), B( M, N ), C( M, N );
+   blaze::randomize( B );
+   blaze::randomize( C );
+
+   A = B + C;
+   A += B;
+   A -= C;
+
+   for( size_t i=0UL; i<M; ++i ) {
+      for( size_t j=0UL; j<N; ++j ) {
+         if( A(i,j) != ( B(i,j) + C(i,j) ) + B(i,j) - C(i,j) ) {
+            std::ostringstream oss;
+            oss << " Test : Parallel dense matrix assignment\n"
+                << " Error: Incorrect result detected\n"
+                << " Details:\n"
+                << "   Size    = " << M << "x" << N << "\n"
+                << "   Element = (" << i << "," << j << ")\n"
+                << "   Result  = " << A(i,j) << "\n"
+                << "   Expected result = " << ( B(i,j) + C(i,j) ) + B(i,j) - C(i,j) << "\n";
+            throw std::runtime_error( oss.str() );
+         }
+      }
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Test of a parallel loop whose partition of the calling thread throws an exception.
+//
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// The exception has to be propagated to the caller after all partitions have been executed and
+// the global thread pool has to be available for the following parallel operations.
+*/
+void testThrowingTask()
+{
+   const size_t N( 1000UL );
+
+   std::vector<size_t> counts( N, 0UL );
+
+   bool thrown( false );
+   try {
+      blaze::smpFor( N, 1UL, ThrowingTask( counts ) );
+   }
+   catch( std::runtime_error& ) {
+      thrown = true;
+   }
+
+   if( !thrown ) {
+      throw std::runtime_error( " Test : Throwing parallel task\n"
+                                " Error: The exception has not been propagated\n" );
+   }
+
+   for( size_t i=0UL; i<N; ++i ) {
+      if( counts[i] != 1UL ) {
+         std::ostringstream oss;
+         oss << " Test : Throwing parallel task\n"
+             << " Error: Incomplete execution of the remaining partitions\n"
+             << " Details:\n"
+             << "   Index = " << i << "\n"
+             << "   Executions = " << counts[i] << "\n";
+         throw std::runtime_error( oss.str() );
+      }
+   }
+
+   blaze::ThreadPool* pool( blaze::smp::acquireThreadPool() );
+
+   if( pool == NULL ) {
+      throw std::runtime_error( " Test : Throwing parallel task\n"
+                                " Error: The thread pool has not been released\n" );
+   }
+
+   blaze::smp::releaseThreadPool();
+
+   testDenseVectorAssignment();
+}
+//*************************************************************************************************
+
+} // namespace
+
+
+
+
+//=================================================================================================
+//
+//  MAIN FUNCTION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+int main()
+{
+   std::cout << "   Running 'ThreadBackend'..." << std::endl;
+
+   try
+   {
+      blaze::setNumThreads( 4UL );
+
+      testDenseVectorAssignment();
+      testDenseMatrixAssignment();
+      testThrowingTask();
+   }
+   catch( std::exception& ex ) {
+      std::cerr << "\n\n ERROR DETECTED during shared memory parallelization:\n"
+                << ex.what() << "\n";
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
+//*************************************************************************************************
@@ -0,0 +1,313 @@
+//=================================================================================================
+/*!
+//  \file src/mathtest/solvers/Batch.cpp
+//  \brief Source file for the batched solver math test
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <blaze/math/problems/Batch.h>
+#include <blaze/math/problems/LCP.h>
+#include <blaze/math/problems/LSE.h>
+#include <blaze/math/Solvers.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/system/Thresholds.h>
+
+
+namespace {
+
+//=================================================================================================
+//
+//  AUXILIARY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Setting up a batch of small problems of different sizes.
+//
+// \param batch The resulting batch of problems.
+// \param problems The number of problems.
+// \return void
+//
+// The sizes of the problems cycle through 1 to 8. The system matrices are symmetric and strictly
+// diagonally dominant with a positive diagonal, i.e. they are positive definite and every linear
+// system of equations as well as every LCP has a unique solution. The right-hand side vectors
+// contain both positive and negative values.
+*/
+template< typename P >  // Type of the problems
+void setupBatch( blaze::Batch<P>& batch, size_t problems )
+{
+   using blaze::real;
+
+   batch.clear();
+
+   for( size_t k=0UL; k<problems; ++k )
+   {
+      const size_t n( 1UL + k % 8UL );
+      const size_t p( batch.add( n ) );
+
+      real* A( batch.A( p ) );
+      real* b( batch.b( p ) );
+
+      for( size_t i=0UL; i<n; ++i ) {
+         for( size_t j=0UL; j<n; ++j )
+            A[i*n+j] = ( i == j )?( real( n+1UL ) ):( real(0.5) * std::sin( real( k+i+j ) ) );
+         b[i] = std::cos( real( 3UL*k + 5UL*i ) );
+      }
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Checking the residual of a solved batch.
+//
+// \param test Label of the performed test.
+// \param batch The solved batch of problems.
+// \param tolerance The maximum admissible residual.
+// \return void
+// \exception std::runtime_error Error detected.
+*/
+template< typename P >  // Type of the problems
+void checkResidual( const std::string& test, const blaze::Batch<P>& batch, blaze::real tolerance )
+{
+   if( !( batch.residual() < tolerance ) ) {
+      std::ostringstream oss;
+      oss << " Test : " << test << "\n"
+          << " Error: Inaccurate solution detected\n"
+          << " Details:\n"
+          << "   Number of problems = " << batch.problems() << "\n"
+          << "   Number of threads = " << blaze::getNumThreads() << "\n"
+          << "   Maximum residual = " << batch.residual() << "\n"
+          << "   Tolerance = " << tolerance << "\n";
+      throw std::runtime_error( oss.str() );
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Comparison of the solutions of two batches of LCPs.
+//
+// \param test Label of the performed test.
+// \param batch The batch with the computed solutions.
+// \param ref The batch with the reference solutions.
+// \param tolerance The maximum admissible difference of the unknowns.
+// \return void
+// \exception std::runtime_error Error detected.
+*/
+void checkSolution( const std::string& test, const blaze::Batch<blaze::LCP>& batch,
+                    const blaze::Batch<blaze::LCP>& ref, blaze::real tolerance )
+{
+   for( size_t k=0UL; k<ref.problems(); ++k ) {
+      for( size_t i=0UL; i<ref.size( k ); ++i ) {
+         if( !( std::fabs( batch.x( k )[i] - ref.x( k )[i] ) <= tolerance ) ) {
+            std::ostringstream oss;
+            oss.precision( 20 );
+            oss << " Test : " << test << "\n"
+                << " Error: Incorrect solution detected\n"
+                << " Details:\n"
+                << "   Number of threads = " << blaze::getNumThreads() << "\n"
+                << "   Problem = " << k << " (size " << ref.size( k ) << ")\n"
+                << "   Index = " << i << "\n"
+                << "   Result = " << batch.x( k )[i] << "\n"
+                << "   Expected result = " << ref.x( k )[i] << "\n";
+            throw std::runtime_error( oss.str() );
+         }
+      }
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  TEST FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Test of the batched Gaussian elimination.
+//
+// \param problems The number of linear systems of equations.
+// \return void
+// \exception std::runtime_error Error detected.
+*/
+void testGaussianElimination( size_t problems )
+{
+   blaze::Batch<blaze::LSE> batch;
+   setupBatch( batch, problems );
+
+   blaze::GaussianElimination solver;
+
+   if( !solver.solve( batch ) ) {
+      throw std::runtime_error( " Test : Batched Gaussian elimination\n"
+                                " Error: The linear systems of equations have not been solved\n" );
+   }
+
+   checkResidual( "Batched Gaussian elimination", batch, blaze::real(1E-14) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Test of the batched Lemke and PGS solvers.
+//
+// \param problems The number of LCPs.
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// Since the LCPs have a unique solution, the exact solutions computed by the Lemke solver and the
+// iterative solutions computed by the PGS solver have to agree within the accuracy of the PGS
+// solver. Additionally, the batched Lemke solver has to compute exactly the same solutions as
+// the Lemke solver for single LCPs.
+*/
+void testLCP( size_t problems )
+{
+   using blaze::real;
+
+   // Batched Lemke solver
+   blaze::Batch<blaze::LCP> lemke;
+   setupBatch( lemke, problems );
+
+   blaze::Lemke solver;
+
+   if( !solver.solve( lemke ) || solver.getLastIterations() != 1UL ) {
+      std::ostringstream oss;
+      oss << " Test : Batched Lemke solver\n"
+          << " Error: The LCPs have not been solved on the first try\n"
+          << " Details:\n"
+          << "   Number of tries = " << solver.getLastIterations() << "\n"
+          << "   Last precision = " << solver.getLastPrecision() << "\n";
+      throw std::runtime_error( oss.str() );
+   }
+
+   checkResidual( "Batched Lemke solver", lemke, real(1E-14) );
+
+   // Lemke solver for single LCPs
+   blaze::Batch<blaze::LCP> single;
+   setupBatch( single, problems );
+
+   for( size_t k=0UL; k<problems; ++k )
+   {
+      const size_t n( single.size( k ) );
+
+      blaze::LCP lcp;
+      lcp.A_.resize( n, n, false );
+      lcp.A_.reset();
+      lcp.A_.reserve( n*n );
+      lcp.b_.resize( n, false );
+      lcp.x_.resize( n, false );
+
+      for( size_t i=0UL; i<n; ++i ) {
+         for( size_t j=0UL; j<n; ++j )
+            lcp.A_.append( i, j, single.A( k )[i*n+j] );
+         lcp.A_.finalize( i );
+         lcp.b_[i] = single.b( k )[i];
+      }
+
+      reset( lcp.x_ );
+
+      if( !solver.solve( lcp ) ) {
+         std::ostringstream oss;
+         oss << " Test : Lemke solver\n"
+             << " Error: The LCP has not been solved\n"
+             << " Details:\n"
+             << "   Problem = " << k << " (size " << n << ")\n"
+             << "   Last precision = " << solver.getLastPrecision() << "\n";
+         throw std::runtime_error( oss.str() );
+      }
+
+      for( size_t i=0UL; i<n; ++i )
+         single.x( k )[i] = lcp.x_[i];
+   }
+
+   checkSolution( "Batched vs. single Lemke solver", lemke, single, real(0) );
+
+   // Batched PGS solver
+   blaze::Batch<blaze::LCP> pgs;
+   setupBatch( pgs, problems );
+
+   blaze::PGS iterative;
+   iterative.setThreshold( real(1E-13) );
+
+   if( !iterative.solve( pgs ) ) {
+      std::ostringstream oss;
+      oss << " Test : Batched PGS solver\n"
+          << " Error: The LCPs have not been solved\n"
+          << " Details:\n"
+          << "   Number of iterations = " << iterative.getLastIterations() << "\n"
+          << "   Last precision = " << iterative.getLastPrecision() << "\n";
+      throw std::runtime_error( oss.str() );
+   }
+
+   checkSolution( "Batched PGS vs. Lemke solver", pgs, lemke, real(1E-11) );
+}
+//*************************************************************************************************
+
+} // namespace
+
+
+
+
+//=================================================================================================
+//
+//  MAIN FUNCTION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+int main()
+{
+   std::cout << "   Running 'Batch'..." << std::endl;
+
+   try
+   {
+      for( size_t threads=1UL; threads<=4UL; threads*=2UL )
+      {
+         blaze::setNumThreads( threads );
+
+         // Running tests below the SMP threshold
+         testGaussianElimination( 37UL );
+         testLCP( 37UL );
+
+         // Running tests above the SMP threshold
+         testGaussianElimination( blaze::SMP_BATCH_THRESHOLD/2UL + 37UL );
+         testLCP( blaze::SMP_BATCH_THRESHOLD/2UL + 37UL );
+      }
+   }
+   catch( std::exception& ex ) {
+      std::cerr << "\n\n ERROR DETECTED during batched solvers:\n"
+                << ex.what() << "\n";
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
+//*************************************************************************************************
@@ -0,0 +1,197 @@
+//=================================================================================================
+/*!
+//  \file src/mathtest/solvers/CG.cpp
+//  \brief Source file for the preconditioned conjugate gradient solver math test
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <blaze/math/Solvers.h>
+
+
+namespace {
+
+//=================================================================================================
+//
+//  TEST FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Test of a single preconditioned CG solve.
+//
+// \param test Label of the performed test.
+// \param A The system matrix.
+// \param b The right-hand side vector.
+// \param pc The preconditioner for the system matrix.
+// \param iterations The expected number of iterations.
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// The solve is repeated with the same preconditioner in order to verify that the application
+// of the preconditioner does not depend on a previous solve.
+*/
+template< typename PC >  // Type of the preconditioner
+void testSolve( const std::string& test, const blaze::CMatMxN& A, const blaze::VecN& b,
+                PC& pc, size_t iterations )
+{
+   using blaze::real;
+
+   blaze::CG solver;
+   solver.setThreshold( real(3E-7) );
+
+   for( size_t rep=0UL; rep<2UL; ++rep )
+   {
+      blaze::VecN x( b.size() );
+
+      if( !solver.solve( A, b, x, pc ) || solver.getLastIterations() != iterations ) {
+         std::ostringstream oss;
+         oss << " Test : " << test << "\n"
+             << " Error: Invalid number of iterations\n"
+             << " Details:\n"
+             << "   Repetition = " << rep << "\n"
+             << "   Number of iterations = " << solver.getLastIterations()
+             << " (expected " << iterations << ")\n"
+             << "   Last precision = " << solver.getLastPrecision() << "\n";
+         throw std::runtime_error( oss.str() );
+      }
+
+      const blaze::VecN r( A * x + b );
+      real precision( 0 );
+      for( size_t i=0UL; i<r.size(); ++i )
+         precision = std::max( precision, std::fabs( r[i] ) );
+
+      if( precision >= solver.getThreshold() ) {
+         std::ostringstream oss;
+         oss << " Test : " << test << "\n"
+             << " Error: Inaccurate solution detected\n"
+             << " Details:\n"
+             << "   Maximum residual = " << precision << "\n"
+             << "   Threshold = " << solver.getThreshold() << "\n";
+         throw std::runtime_error( oss.str() );
+      }
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Test of the CG solver with the different preconditioners.
+//
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// The test solves the 5-point discretization of the Laplace operator on a 30x30 grid with
+// the right-hand side \f$ b_i = \sin(i) \f$. Since the diagonal of the system matrix is
+// constant, the Jacobi preconditioner requires the same number of iterations as the
+// unpreconditioned solver.
+*/
+void testLaplace()
+{
+   using blaze::real;
+
+   const size_t N( 30UL );
+   const size_t NN( N*N );
+
+   blaze::CMatMxN A( NN, NN, 5UL*NN );
+
+   for( size_t i=0UL; i<N; ++i ) {
+      for( size_t j=0UL; j<N; ++j ) {
+         const size_t row( i*N+j );
+         if( i > 0UL   ) A.append( row, row-N  , real(-1) );  // Top neighbor
+         if( j > 0UL   ) A.append( row, row-1UL, real(-1) );  // Left neighbor
+         A.append( row, row, real(4) );
+         if( j < N-1UL ) A.append( row, row+1UL, real(-1) );  // Right neighbor
+         if( i < N-1UL ) A.append( row, row+N  , real(-1) );  // Bottom neighbor
+         A.finalize( row );
+      }
+   }
+
+   blaze::VecN b( NN );
+   for( size_t i=0UL; i<NN; ++i )
+      b[i] = std::sin( real(i) );
+
+   // Unpreconditioned solve
+   {
+      blaze::CG solver;
+      solver.setThreshold( real(3E-7) );
+
+      blaze::VecN x( NN );
+
+      if( !solver.solve( A, b, x ) || solver.getLastIterations() != 64UL ) {
+         std::ostringstream oss;
+         oss << " Test : Unpreconditioned CG\n"
+             << " Error: Invalid number of iterations\n"
+             << " Details:\n"
+             << "   Number of iterations = " << solver.getLastIterations() << " (expected 64)\n"
+             << "   Last precision = " << solver.getLastPrecision() << "\n";
+         throw std::runtime_error( oss.str() );
+      }
+   }
+
+   // Preconditioned solves
+   blaze::JacobiPreconditioner jacobi( A );
+   testSolve( "Jacobi preconditioned CG", A, b, jacobi, 64UL );
+
+   blaze::BlockJacobiPreconditioner blockJacobi( A );
+   testSolve( "Block Jacobi preconditioned CG", A, b, blockJacobi, 54UL );
+
+   blaze::IC0Preconditioner ic0( A );
+   testSolve( "IC(0) preconditioned CG", A, b, ic0, 20UL );
+}
+//*************************************************************************************************
+
+} // namespace
+
+
+
+
+//=================================================================================================
+//
+//  MAIN FUNCTION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+int main()
+{
+   std::cout << "   Running 'CG'..." << std::endl;
+
+   try
+   {
+      testLaplace();
+   }
+   catch( std::exception& ex ) {
+      std::cerr << "\n\n ERROR DETECTED during conjugate gradient solver:\n"
+                << ex.what() << "\n";
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
+//*************************************************************************************************
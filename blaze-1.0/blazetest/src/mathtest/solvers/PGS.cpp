@@ -0,0 +1,282 @@
+//=================================================================================================
+/*!
+//  \file src/mathtest/solvers/PGS.cpp
+//  \brief Source file for the projected Gauss-Seidel solver math test
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <blaze/math/problems/ContactLCP.h>
+#include <blaze/math/Solvers.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/system/Thresholds.h>
+
+
+namespace {
+
+//=================================================================================================
+//
+//  AUXILIARY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Setting up a contact LCP consisting of independent blocks of contacts.
+//
+// \param cp The resulting contact LCP.
+// \param blocks The number of independent blocks.
+// \param contacts The number of contacts per block.
+// \return void
+//
+// Within each block, every contact is coupled to its successor in both directions. Additionally,
+// the normal force of each contact is coupled to the normal force of the third next contact
+// in one direction only, i.e. the sparsity pattern of the system matrix is not symmetric. The
+// system matrix is strictly diagonally dominant and thus the LCP has a unique solution.
+*/
+void setupProblem( blaze::ContactLCP& cp, size_t blocks, size_t contacts )
+{
+   using blaze::real;
+
+   const size_t N( blocks*contacts );
+
+   cp.A_.resize( 3UL*N, 3UL*N, false );
+   cp.A_.reset();
+   cp.A_.reserve( 3UL*N*4UL );
+   cp.b_.resize( 3UL*N, false );
+   cp.x_.resize( 3UL*N, false );
+   cp.cof_.resize( N, false );
+
+   for( size_t i=0UL; i<N; ++i )
+   {
+      const size_t k( i % contacts );
+
+      for( size_t a=0UL; a<3UL; ++a )
+      {
+         const size_t row( 3UL*i+a );
+
+         if( k > 0UL )
+            cp.A_.append( row, row-3UL, real(-1) );
+         cp.A_.append( row, row, real(6) );
+         if( k+1UL < contacts )
+            cp.A_.append( row, row+3UL, real(-1) );
+         if( a == 0UL && k+3UL < contacts )
+            cp.A_.append( row, row+9UL, real(-0.5) );
+
+         cp.A_.finalize( row );
+      }
+
+      cp.b_[3UL*i    ] = -real(1) - real( k % 5UL ) * real(0.1);
+      cp.b_[3UL*i+1UL] =  real( int( k % 7UL ) - 3 ) * real(0.1);
+      cp.b_[3UL*i+2UL] =  real( int( k % 3UL ) - 1 ) * real(0.2);
+      cp.cof_[i] = real(0.5);
+   }
+
+   reset( cp.x_ );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Solving the given contact LCP by means of the given solver.
+//
+// \param test Label of the performed test.
+// \param solver The projected Gauss-Seidel solver.
+// \param cp The contact LCP to be solved.
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// Since the solver stops as soon as the maximum change of the unknowns drops below its threshold,
+// the residual of the solution is only required to be below a hundredfold of the threshold.
+*/
+void solve( const std::string& test, blaze::PGS& solver, blaze::ContactLCP& cp )
+{
+   if( !solver.solve( cp ) || cp.residual() >= blaze::real(100)*solver.getThreshold() ) {
+      std::ostringstream oss;
+      oss << " Test : " << test << "\n"
+          << " Error: The contact LCP has not been solved\n"
+          << " Details:\n"
+          << "   Number of unknowns = " << cp.size() << "\n"
+          << "   Number of threads = " << blaze::getNumThreads() << "\n"
+          << "   Number of iterations = " << solver.getLastIterations() << "\n"
+          << "   Residual = " << cp.residual() << "\n";
+      throw std::runtime_error( oss.str() );
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Comparison of two solutions of a contact LCP.
+//
+// \param test Label of the performed test.
+// \param x The computed solution.
+// \param ref The reference solution.
+// \param tolerance The maximum admissible difference of the unknowns.
+// \return void
+// \exception std::runtime_error Error detected.
+*/
+void checkSolution( const std::string& test, const blaze::VecN& x, const blaze::VecN& ref,
+                    blaze::real tolerance )
+{
+   for( size_t i=0UL; i<ref.size(); ++i ) {
+      if( !( std::fabs( x[i] - ref[i] ) <= tolerance ) ) {
+         std::ostringstream oss;
+         oss.precision( 20 );
+         oss << " Test : " << test << "\n"
+             << " Error: Incorrect solution detected\n"
+             << " Details:\n"
+             << "   Number of threads = " << blaze::getNumThreads() << "\n"
+             << "   Index = " << i << "\n"
+             << "   Result = " << x[i] << "\n"
+             << "   Expected result = " << ref[i] << "\n";
+         throw std::runtime_error( oss.str() );
+      }
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  TEST FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Test of the colored and the projected Jacobi sweeps of the PGS solver.
+//
+// \return void
+// \exception std::runtime_error Error detected.
+//
+// The test problem consists of three independent blocks of contacts. Each block is smaller than
+// the SMP_PGS_THRESHOLD and is solved by sequential sweeps in the natural order of the contacts,
+// whereas the complete problem exceeds the threshold and is solved by colored sweeps. Both
+// solutions have to agree within the accuracy of the solver. Additionally, the colored and the
+// projected Jacobi sweeps have to compute the same result for any number of threads.
+*/
+void testSweeps()
+{
+   using blaze::real;
+
+   const size_t blocks  ( 3UL );
+   const size_t contacts( blaze::SMP_PGS_THRESHOLD / 9UL + 7UL );
+   const size_t n       ( 3UL*contacts );
+   const real   tolerance( 1E-7 );
+
+   blaze::PGS solver;
+   solver.setThreshold( real(1E-10) );
+
+   // Sequential sweeps of the independent blocks
+   blaze::ContactLCP block;
+   setupProblem( block, 1UL, contacts );
+
+   if( block.size() >= blaze::SMP_PGS_THRESHOLD || blocks*block.size() < blaze::SMP_PGS_THRESHOLD ) {
+      throw std::runtime_error( " Test : Setup of the contact LCPs\n"
+                                " Error: Invalid problem sizes\n" );
+   }
+
+   blaze::setNumThreads( 1UL );
+   solve( "Sequential sweeps", solver, block );
+
+   blaze::VecN ref( blocks*n );
+   for( size_t b=0UL; b<blocks; ++b ) {
+      for( size_t i=0UL; i<n; ++i )
+         ref[b*n+i] = block.x_[i];
+   }
+
+   // Colored sweeps of the complete problem
+   blaze::ContactLCP cp;
+   blaze::VecN colored;
+
+   for( size_t threads=1UL; threads<=4UL; ++threads )
+   {
+      blaze::setNumThreads( threads );
+
+      setupProblem( cp, blocks, contacts );
+      solve( "Colored sweeps", solver, cp );
+      checkSolution( "Colored vs. sequential sweeps", cp.x_, ref, tolerance );
+
+      if( threads == 1UL )
+         colored = cp.x_;
+      else
+         checkSolution( "Colored sweeps with different numbers of threads", cp.x_, colored, real(0) );
+   }
+
+   // Projected Jacobi sweeps of the complete problem
+   solver.setJacobi( true );
+   solver.setRelaxation( real(0.5) );
+
+   blaze::VecN jacobi;
+
+   for( size_t threads=1UL; threads<=4UL; ++threads )
+   {
+      blaze::setNumThreads( threads );
+
+      setupProblem( cp, blocks, contacts );
+      solve( "Projected Jacobi sweeps", solver, cp );
+      checkSolution( "Projected Jacobi vs. sequential sweeps", cp.x_, ref, tolerance );
+
+      if( threads == 1UL )
+         jacobi = cp.x_;
+      else
+         checkSolution( "Projected Jacobi sweeps with different numbers of threads", cp.x_, jacobi, real(0) );
+   }
+}
+//*************************************************************************************************
+
+} // namespace
+
+
+
+
+//=================================================================================================
+//
+//  MAIN FUNCTION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+int main()
+{
+   std::cout << "   Running 'PGS'..." << std::endl;
+
+   try
+   {
+      testSweeps();
+   }
+   catch( std::exception& ex ) {
+      std::cerr << "\n\n ERROR DETECTED during projected Gauss-Seidel solver:\n"
+                << ex.what() << "\n";
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
+//*************************************************************************************************
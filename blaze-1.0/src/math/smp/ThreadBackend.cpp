@@ -0,0 +1,221 @@
+//=================================================================================================
+/*!
+//  \file src/math/smp/ThreadBackend.cpp
+//  \brief Source file for the shared memory parallelization of the Blaze library
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//=================================================================================================
+
+
+//*************************************************************************************************
+// Platform/compiler-specific includes
+//*************************************************************************************************
+
+#include <blaze/system/WarningDisable.h>
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <cstdlib>
+#include <stdexcept>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <blaze/math/smp/ThreadBackend.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  GLOBAL THREAD BACKEND
+//
+//=================================================================================================
+
+namespace {
+
+//*************************************************************************************************
+/*!\brief Returns the initial number of threads of the parallel assignments.
+//
+// \return The number of threads specified by the \c BLAZE_NUM_THREADS environment variable.
+//
+// In case the \c BLAZE_NUM_THREADS environment variable is not set or does not specify a valid
+// number of threads, the function returns the number of hardware threads of the system.
+*/
+size_t initialNumThreads()
+{
+   const char* env( std::getenv( "BLAZE_NUM_THREADS" ) );
+
+   if( env != NULL ) {
+      const long number( std::strtol( env, NULL, 10 ) );
+      if( number > 0L ) return static_cast<size_t>( number );
+   }
+
+   const size_t hardware( boost::thread::hardware_concurrency() );
+   return ( hardware > 0UL )?( hardware ):( 1UL );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief The global thread backend of the parallel assignments.
+//
+// The thread pool of the backend is created on first use. It contains one thread less than the
+// total number of threads, since the calling thread executes one partition of every parallel
+// assignment itself. The \a section mutex is held for the duration of a parallel assignment.
+*/
+struct Backend
+{
+   Backend() : threads( initialNumThreads() ), pool(), mutex(), section() {}
+
+   size_t threads;                      //!< The total number of threads.
+   boost::scoped_ptr<ThreadPool> pool;  //!< The global thread pool.
+   boost::mutex mutex;                  //!< Synchronization mutex for the thread setup.
+   boost::mutex section;                //!< Mutex of the currently active parallel assignment.
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the global thread backend.
+//
+// \return Reference to the global thread backend.
+*/
+Backend& theBackend()
+{
+   static Backend backend;
+   return backend;
+}
+//*************************************************************************************************
+
+} // namespace
+
+
+
+
+//=================================================================================================
+//
+//  THREAD SETUP FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the total number of threads used for the parallel assignments.
+// \ingroup smp
+//
+// \return The total number of threads, including the calling thread.
+*/
+size_t getNumThreads()
+{
+   Backend& backend( theBackend() );
+   boost::mutex::scoped_lock lock( backend.mutex );
+   return backend.threads;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Sets the total number of threads used for the parallel assignments.
+// \ingroup smp
+//
+// \param number The total number of threads \f$[1..\infty)\f$, including the calling thread.
+// \return void
+// \exception std::invalid_argument Invalid number of threads.
+//
+// This function waits for the completion of a currently active parallel assignment before
+// adapting the size of the global thread pool. A total of one thread results in a sequential
+// execution of all assignments.
+*/
+void setNumThreads( size_t number )
+{
+   if( number == 0UL )
+      throw std::invalid_argument( "Invalid number of threads" );
+
+   Backend& backend( theBackend() );
+
+   boost::mutex::scoped_lock section( backend.section );
+   boost::mutex::scoped_lock lock( backend.mutex );
+
+   backend.threads = number;
+
+   if( number == 1UL )
+      backend.pool.reset();
+   else if( backend.pool )
+      backend.pool->resize( number-1UL );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  THREAD BACKEND FUNCTIONS
+//
+//=================================================================================================
+
+namespace smp {
+
+//*************************************************************************************************
+/*!\brief Acquires the global thread pool for a parallel assignment.
+// \ingroup smp
+//
+// \return Handle to the global thread pool, \a NULL in case the assignment is sequential.
+//
+// In case the global thread pool is available, the calling thread is granted exclusive access
+// to the pool until the releaseThreadPool() function is called. In case only a single thread
+// is configured or in case another parallel assignment is currently active (for instance in
+// case of an assignment within a task of the global thread pool), the function returns \a NULL.
+*/
+ThreadPool* acquireThreadPool()
+{
+   Backend& backend( theBackend() );
+
+   if( !backend.section.try_lock() )
+      return NULL;
+
+   boost::mutex::scoped_lock lock( backend.mutex );
+
+   if( backend.threads == 1UL ) {
+      backend.section.unlock();
+      return NULL;
+   }
+
+   if( !backend.pool )
+      backend.pool.reset( new ThreadPool( backend.threads-1UL ) );
+
+   return backend.pool.get();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Releases the global thread pool after a parallel assignment.
+// \ingroup smp
+//
+// \return void
+*/
+void releaseThreadPool()
+{
+   theBackend().section.unlock();
+}
+//*************************************************************************************************
+
+} // namespace smp
+
+} // namespace blaze
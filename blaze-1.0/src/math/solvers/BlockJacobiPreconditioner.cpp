@@ -0,0 +1,222 @@
+//*************************************************************************************************
+/*!
+//  \file src/math/solvers/BlockJacobiPreconditioner.cpp
+//  \brief Source file for the block Jacobi preconditioner
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <stdexcept>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <blaze/math/shims/IsDefault.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/math/solvers/BlockJacobiPreconditioner.h>
+#include <blaze/system/Thresholds.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CONSTRUCTORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief The default constructor for the BlockJacobiPreconditioner class.
+//
+// The default constructor creates an empty preconditioner. Before it can be used, it has to be
+// set up for a specific system matrix via the setup() function.
+*/
+BlockJacobiPreconditioner::BlockJacobiPreconditioner()
+   : size_   ( 0UL )  // The number of rows/columns of the system matrix
+   , inv_    ()       // The inverse 3x3 diagonal blocks of the system matrix
+   , partial_()       // The partial inner products of the parts
+{}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Creates a block Jacobi preconditioner for the given system matrix.
+//
+// \param A The square system matrix.
+// \exception std::invalid_argument System matrix is not square.
+// \exception std::invalid_argument Invalid system matrix size.
+// \exception std::invalid_argument Singular diagonal block.
+*/
+BlockJacobiPreconditioner::BlockJacobiPreconditioner( const CMatMxN& A )
+   : size_   ( 0UL )  // The number of rows/columns of the system matrix
+   , inv_    ()       // The inverse 3x3 diagonal blocks of the system matrix
+   , partial_()       // The partial inner products of the parts
+{
+   setup( A );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Sets up the preconditioner for the given system matrix.
+//
+// \param A The square system matrix.
+// \return void
+// \exception std::invalid_argument System matrix is not square.
+// \exception std::invalid_argument Invalid system matrix size.
+// \exception std::invalid_argument Singular diagonal block.
+//
+// This function extracts the 3x3 diagonal blocks of the given system matrix and inverts them
+// by means of their cofactors. In case the number of rows of the system matrix is not a
+// multiple of 3, a \a std::invalid_argument exception is thrown.
+*/
+void BlockJacobiPreconditioner::setup( const CMatMxN& A )
+{
+   typedef CMatMxN::ConstIterator  ConstIterator;
+
+   if( A.rows() != A.columns() )
+      throw std::invalid_argument( "System matrix is not square" );
+
+   if( A.rows() % 3UL != 0UL )
+      throw std::invalid_argument( "Invalid system matrix size" );
+
+   size_ = A.rows();
+   inv_.resize( 3UL*size_ );
+
+   for( size_t b=0UL; b<size_; b+=3UL )
+   {
+      real a[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+      // Extracting the diagonal block
+      for( size_t i=0UL; i<3UL; ++i ) {
+         const ConstIterator end( A.end(b+i) );
+         for( ConstIterator element=A.begin(b+i); element!=end; ++element ) {
+            if( element->index() >= b && element->index() < b+3UL )
+               a[i*3UL+element->index()-b] = element->value();
+         }
+      }
+
+      // Inverting the diagonal block
+      const real c0( a[4]*a[8] - a[5]*a[7] );
+      const real c1( a[5]*a[6] - a[3]*a[8] );
+      const real c2( a[3]*a[7] - a[4]*a[6] );
+      const real det( a[0]*c0 + a[1]*c1 + a[2]*c2 );
+
+      if( isDefault( det ) )
+         throw std::invalid_argument( "Singular diagonal block" );
+
+      const real idet( real(1) / det );
+      real* const inv( &inv_[3UL*b] );
+
+      inv[0] = c0 * idet;
+      inv[1] = ( a[2]*a[7] - a[1]*a[8] ) * idet;
+      inv[2] = ( a[1]*a[5] - a[2]*a[4] ) * idet;
+      inv[3] = c1 * idet;
+      inv[4] = ( a[0]*a[8] - a[2]*a[6] ) * idet;
+      inv[5] = ( a[2]*a[3] - a[0]*a[5] ) * idet;
+      inv[6] = c2 * idet;
+      inv[7] = ( a[1]*a[6] - a[0]*a[7] ) * idet;
+      inv[8] = ( a[0]*a[4] - a[1]*a[3] ) * idet;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Applies the preconditioner to the given residual.
+//
+// \param r The residual vector.
+// \param z The resulting preconditioned residual.
+// \return The inner product \f$ r^T z \f$.
+//
+// This function computes the preconditioned residual and the according inner product in a
+// single sweep. In case the size of the vectors reaches the SMP_DVECASSIGN_THRESHOLD, the
+// vectors are processed in parallel.
+*/
+real BlockJacobiPreconditioner::apply( const VecN& r, VecN& z )
+{
+   BLAZE_USER_ASSERT( r.size() == size_, "Invalid residual vector size" );
+
+   const size_t parts( ( size_ < SMP_DVECASSIGN_THRESHOLD )?( 1UL ):( getNumThreads() ) );
+
+   z.resize( size_, false );
+   partial_.resize( parts );
+
+   smpFor( parts, 1UL, boost::bind( &BlockJacobiPreconditioner::applyKernel, this,
+                                    boost::cref( r ), boost::ref( z ), parts, _1, _2 ) );
+
+   real rz( 0 );
+   for( size_t p=0UL; p<parts; ++p )
+      rz += partial_[p];
+
+   return rz;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Kernel for the application of the preconditioner to a range of parts.
+//
+// \param r The residual vector.
+// \param z The resulting preconditioned residual.
+// \param parts The total number of parts.
+// \param pbegin The first part to be processed.
+// \param pend One past the last part to be processed.
+// \return void
+*/
+void BlockJacobiPreconditioner::applyKernel( const VecN& r, VecN& z, size_t parts,
+                                             size_t pbegin, size_t pend )
+{
+   const size_t blocks( size_ / 3UL );
+
+   for( size_t p=pbegin; p<pend; ++p )
+   {
+      const size_t bend( ( ( p+1UL ) * blocks ) / parts );
+      real rz( 0 );
+
+      for( size_t b=( p*blocks )/parts; b<bend; ++b )
+      {
+         const real* const inv( &inv_[9UL*b] );
+         const size_t i( 3UL*b );
+
+         const real r0( r[i] ), r1( r[i+1UL] ), r2( r[i+2UL] );
+
+         z[i    ] = inv[0]*r0 + inv[1]*r1 + inv[2]*r2;
+         z[i+1UL] = inv[3]*r0 + inv[4]*r1 + inv[5]*r2;
+         z[i+2UL] = inv[6]*r0 + inv[7]*r1 + inv[8]*r2;
+
+         rz += r0*z[i] + r1*z[i+1UL] + r2*z[i+2UL];
+      }
+
+      partial_[p] = rz;
+   }
+}
+//*************************************************************************************************
+
+} // namespace blaze
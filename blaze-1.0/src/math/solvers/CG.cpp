@@ -26,8 +26,16 @@
 
 #include <cmath>
 #include <stdexcept>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
 #include <blaze/math/Functions.h>
+#include <blaze/math/smp/Partition.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/math/solvers/BlockJacobiPreconditioner.h>
 #include <blaze/math/solvers/CG.h>
+#include <blaze/math/solvers/IC0Preconditioner.h>
+#include <blaze/math/solvers/JacobiPreconditioner.h>
+#include <blaze/system/Thresholds.h>
 #include <blaze/util/Assert.h>
 #include <blaze/util/ColorMacros.h>
 #include <blaze/util/logging/DebugSection.h>
@@ -46,9 +54,12 @@ namespace blaze {
 /*!\brief The default constructor for the conjugate gradient solver.
 */
 CG::CG()
-   : r_()  // TODO
-   , d_()  // TODO
-   , h_()  // TODO
+   : r_()        // The residual
+   , d_()        // The search direction
+   , h_()        // The product of the system matrix and the search direction
+   , z_()        // The preconditioned residual
+   , bounds_()   // The bounds of the row blocks of the system matrix
+   , partial_()  // The partial results of the reductions of the row blocks
 {}
 //*************************************************************************************************
 
@@ -62,24 +73,102 @@ CG::CG()
 //=================================================================================================
 
 //*************************************************************************************************
-/*!\brief TODO
+/*!\brief Solves the linear system \f$ A \cdot x + b = 0 \f$.
 //
-// \param A TODO
-// \param b TODO
-// \param x TODO
-// \return void
+// \param A The symmetric positive definite system matrix.
+// \param b The right-hand side vector.
+// \param x The resulting vector of unknowns.
+// \return Returns \a true if the solution is sufficiently accurate, otherwise it returns \a false.
 // \exception std::invalid_argument System matrix is not square.
 // \exception std::invalid_argument System matrix is not symmetric.
 // \exception std::invalid_argument Invalid right-hand side vector size.
 //
-// TODO: description
-// TODO: Problem formulation: \f$ A \cdot x + b = 0 \f$ !!
+// This function solves the given linear system by means of the unpreconditioned conjugate
+// gradient method, starting from \f$ x = 0 \f$. The solution process stops as soon as the
+// maximum norm of the residual drops below the threshold of the solver or the maximum number
+// of iterations is reached.
 */
 bool CG::solve( const CMatMxN& A, const VecN& b, VecN& x )
+{
+   setup( A, b, x );
+
+   bool converged( lastPrecision_ < threshold_ );
+   real norm;
+
+   real delta( trans(r_) * r_ );
+   direction( r_, real(0) );
+
+   // Performing the CG iterations
+   size_t it( 0 );
+
+   for( ; !converged && it<maxIterations_; ++it )
+   {
+      const real alpha( delta / multiply( A ) );
+
+      lastPrecision_ = update( x, alpha, norm );
+
+      if( lastPrecision_ < threshold_ ) {
+         converged = true;
+         break;
+      }
+
+      direction( r_, norm / delta );
+      delta = norm;
+   }
+
+   report( converged, it );
+
+   lastIterations_ = it;
+
+   return converged;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+#if !defined(_MSC_VER)
+template bool CG::solve<JacobiPreconditioner>( LSE&, JacobiPreconditioner& );
+template bool CG::solve<BlockJacobiPreconditioner>( LSE&, BlockJacobiPreconditioner& );
+template bool CG::solve<IC0Preconditioner>( LSE&, IC0Preconditioner& );
+template bool CG::solve<JacobiPreconditioner>( const CMatMxN&, const VecN&, VecN&,
+                                               JacobiPreconditioner& );
+template bool CG::solve<BlockJacobiPreconditioner>( const CMatMxN&, const VecN&, VecN&,
+                                                    BlockJacobiPreconditioner& );
+template bool CG::solve<IC0Preconditioner>( const CMatMxN&, const VecN&, VecN&,
+                                            IC0Preconditioner& );
+#endif
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Prepares the solution of the given linear system.
+//
+// \param A The symmetric positive definite system matrix.
+// \param b The right-hand side vector.
+// \param x The vector of unknowns.
+// \return void
+// \exception std::invalid_argument System matrix is not square.
+// \exception std::invalid_argument System matrix is not symmetric.
+// \exception std::invalid_argument Invalid right-hand side vector size.
+//
+// This function checks the given linear system, allocates the helper data, initializes the
+// vector of unknowns and the residual and partitions the rows of the system matrix into blocks
+// of equal workload. In case the size of the system is smaller than the
+// SMP_SMATDVECMULT_THRESHOLD, all rows form a single block.
+*/
+void CG::setup( const CMatMxN& A, const VecN& b, VecN& x )
 {
    const size_t n( b.size() );
-   bool converged( false );
-   real alpha, beta, delta;
 
    if( A.rows() != A.columns() )
       throw std::invalid_argument( "System matrix is not square" );
@@ -94,66 +183,198 @@ bool CG::solve( const CMatMxN& A, const VecN& b, VecN& x )
    r_.resize( n, false );
    d_.resize( n, false );
    h_.resize( n, false );
+   z_.resize( n, false );
 
-   // Preparing the vector of unknowns
+   // Preparing the vector of unknowns and the search direction
    x.resize( n, false );
    x.reset();
+   d_.reset();
 
-   // Computing the initial residual
-   r_ = A * x + b;
+   // Computing the initial residual r = A*0 + b
+   r_ = b;
 
-   // Initial convergence test
    lastPrecision_ = 0;
    for( size_t i=0; i<n; ++i ) {
       lastPrecision_ = max( lastPrecision_, std::fabs( r_[i] ) );
    }
 
-   if( lastPrecision_ < threshold_ )
-      converged = true;
+   // Partitioning the rows of the system matrix
+   const size_t parts( ( n < SMP_SMATDVECMULT_THRESHOLD )?( 1UL ):( getNumThreads() ) );
 
-   delta = trans(r_) * r_;
+   partitionNonZeros( A, parts, bounds_ );
+   partial_.resize( 2UL*parts );
+}
+//*************************************************************************************************
 
-   d_ = -r_;
 
-   // Performing the CG iterations
-   size_t it( 0 );
+//*************************************************************************************************
+/*!\brief Computes \f$ h = A \cdot d \f$ and the inner product \f$ d^T h \f$.
+//
+// \param A The system matrix.
+// \return The inner product \f$ d^T h \f$.
+*/
+real CG::multiply( const CMatMxN& A )
+{
+   const size_t parts( bounds_.size() - 1UL );
 
-   for( ; !converged && it<maxIterations_; ++it )
-   {
-      h_ = A * d_;
+   smpFor( parts, 1UL, boost::bind( &CG::multiplyKernel, this, boost::cref( A ), _1, _2 ) );
 
-      alpha = delta / ( trans(d_) * h_ );
+   real dh( 0 );
+   for( size_t p=0UL; p<parts; ++p )
+      dh += partial_[p];
 
-      x  += alpha * d_;
-      r_ += alpha * h_;
+   return dh;
+}
+//*************************************************************************************************
 
-      lastPrecision_ = 0;
-      for( size_t i=0; i<n; ++i ) {
-         lastPrecision_ = max( lastPrecision_, std::fabs( r_[i] ) );
-      }
 
-      if( lastPrecision_ < threshold_ ) {
-         converged = true;
-         break;
-      }
+//*************************************************************************************************
+/*!\brief Updates the vector of unknowns and the residual.
+//
+// \param x The vector of unknowns.
+// \param alpha The step length.
+// \param norm The resulting squared Euclidean norm of the updated residual.
+// \return The maximum norm of the updated residual.
+//
+// This function computes \f$ x = x + \alpha d \f$ and \f$ r = r + \alpha h \f$ in a single sweep
+// and at the same time computes both the maximum norm and the squared Euclidean norm of the
+// updated residual.
+*/
+real CG::update( VecN& x, real alpha, real& norm )
+{
+   const size_t parts( bounds_.size() - 1UL );
 
-      beta = trans(r_) * r_;
+   smpFor( parts, 1UL, boost::bind( &CG::updateKernel, this, boost::ref( x ), alpha, _1, _2 ) );
 
-      d_ = ( beta / delta ) * d_ - r_;
+   real precision( 0 );
+   norm = real( 0 );
 
-      delta = beta;
+   for( size_t p=0UL; p<parts; ++p ) {
+      precision = max( precision, partial_[2UL*p] );
+      norm += partial_[2UL*p+1UL];
    }
 
+   return precision;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Updates the search direction.
+//
+// \param z The (preconditioned) residual.
+// \param beta The scaling factor of the previous search direction.
+// \return void
+//
+// This function computes the new search direction \f$ d = \beta d - z \f$.
+*/
+void CG::direction( const VecN& z, real beta )
+{
+   const size_t parts( bounds_.size() - 1UL );
+
+   smpFor( parts, 1UL, boost::bind( &CG::directionKernel, this, boost::cref( z ), beta, _1, _2 ) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Reports the result of the solution process.
+//
+// \param converged \a true in case the solution process converged, \a false if not.
+// \param it The number of performed iterations.
+// \return void
+*/
+void CG::report( bool converged, size_t it ) const
+{
    BLAZE_LOG_DEBUG_SECTION( log ) {
       if( converged )
          log << "      Solved the linear system in " << it << " CG iterations.";
       else
          log << BLAZE_YELLOW << "      WARNING: Did not solve the linear system within accuracy. (" << lastPrecision_ << ")" << BLAZE_OLDCOLOR;
    }
+}
+//*************************************************************************************************
 
-   lastIterations_ = it;
 
-   return converged;
+//*************************************************************************************************
+/*!\brief Kernel for the fused sparse matrix/dense vector multiplication of a range of blocks.
+//
+// \param A The system matrix.
+// \param pbegin The first row block to be processed.
+// \param pend One past the last row block to be processed.
+// \return void
+*/
+void CG::multiplyKernel( const CMatMxN& A, size_t pbegin, size_t pend )
+{
+   typedef CMatMxN::ConstIterator  ConstIterator;
+
+   for( size_t p=pbegin; p<pend; ++p )
+   {
+      real dh( 0 );
+
+      for( size_t i=bounds_[p]; i<bounds_[p+1UL]; ++i )
+      {
+         const ConstIterator end( A.end(i) );
+         real h( 0 );
+
+         for( ConstIterator element=A.begin(i); element!=end; ++element )
+            h += element->value() * d_[element->index()];
+
+         h_[i] = h;
+         dh += d_[i] * h;
+      }
+
+      partial_[p] = dh;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Kernel for the fused update of the unknowns and the residual of a range of blocks.
+//
+// \param x The vector of unknowns.
+// \param alpha The step length.
+// \param pbegin The first row block to be processed.
+// \param pend One past the last row block to be processed.
+// \return void
+*/
+void CG::updateKernel( VecN& x, real alpha, size_t pbegin, size_t pend )
+{
+   for( size_t p=pbegin; p<pend; ++p )
+   {
+      real precision( 0 ), norm( 0 );
+
+      for( size_t i=bounds_[p]; i<bounds_[p+1UL]; ++i ) {
+         x[i] += alpha * d_[i];
+         const real r( r_[i] + alpha * h_[i] );
+         r_[i] = r;
+         precision = max( precision, std::fabs( r ) );
+         norm += r * r;
+      }
+
+      partial_[2UL*p    ] = precision;
+      partial_[2UL*p+1UL] = norm;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Kernel for the update of the search direction of a range of blocks.
+//
+// \param z The (preconditioned) residual.
+// \param beta The scaling factor of the previous search direction.
+// \param pbegin The first row block to be processed.
+// \param pend One past the last row block to be processed.
+// \return void
+*/
+void CG::directionKernel( const VecN& z, real beta, size_t pbegin, size_t pend )
+{
+   for( size_t p=pbegin; p<pend; ++p ) {
+      for( size_t i=bounds_[p]; i<bounds_[p+1UL]; ++i )
+         d_[i] = beta * d_[i] - z[i];
+   }
 }
 //*************************************************************************************************
 
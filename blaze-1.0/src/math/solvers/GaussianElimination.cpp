@@ -27,10 +27,17 @@
 #include <algorithm>
 #include <cmath>
 #include <stdexcept>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
 #include <blaze/math/Accuracy.h>
+#include <blaze/math/intrinsics/IntrinsicTrait.h>
 #include <blaze/math/shims/IsDefault.h>
 #include <blaze/math/shims/Reset.h>
+#include <blaze/math/smp/Partition.h>
+#include <blaze/math/smp/ThreadBackend.h>
 #include <blaze/math/solvers/GaussianElimination.h>
+#include <blaze/system/Thresholds.h>
 #include <blaze/util/Assert.h>
 #include <blaze/util/ColorMacros.h>
 #include <blaze/util/logging/DebugSection.h>
@@ -39,6 +46,188 @@
 
 namespace blaze {
 
+//=================================================================================================
+//
+//  BATCHED GAUSSIAN ELIMINATION
+//
+//=================================================================================================
+
+namespace {
+
+//*************************************************************************************************
+/*!\brief The number of linear systems of the same size that are solved simultaneously.
+//
+// The linear systems are processed in groups of two SIMD vectors, which keeps two independent
+// chains of floating point operations in flight.
+*/
+const size_t lanes( 2UL * IntrinsicTrait<real>::size );
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Gaussian elimination of \a L interleaved linear systems of the same size.
+//
+// \param n The size of the linear systems.
+// \param a The interleaved \f$ n \times n \f$ system matrices.
+// \param r The interleaved negated right-hand side vectors.
+// \param x The resulting interleaved vectors of unknowns.
+// \return The maximum inaccuracy of the \a L solutions.
+//
+// This function solves \a L linear systems of the same size simultaneously. Element \f$ (i,j) \f$
+// of the system matrix of system \a l is stored in \f$ a[(i*n+j)*L+l] \f$, element \a i of the
+// vectors of system \a l in \f$ r[i*L+l] \f$ and \f$ x[i*L+l] \f$. Therefore all innermost loops
+// run over the \a L systems and are executed by means of SIMD instructions. The pivot search
+// and the row swaps are performed individually for each system.
+*/
+template< size_t L >  // Number of interleaved linear systems
+real eliminate( size_t n, real* a, real* r, real* x )
+{
+   real precision( 0 );
+
+   for( size_t j=0; j<n; ++j )
+   {
+      // Partial search for pivot
+      size_t pivot[L];
+      real   pmax [L];
+
+      for( size_t l=0; l<L; ++l ) {
+         pivot[l] = j;
+         pmax [l] = std::fabs( a[(j*n+j)*L+l] );
+      }
+
+      for( size_t i=j+1; i<n; ++i ) {
+         for( size_t l=0; l<L; ++l ) {
+            if( std::fabs( a[(i*n+j)*L+l] ) > pmax[l] ) {
+               pivot[l] = i;
+               pmax [l] = std::fabs( a[(i*n+j)*L+l] );
+            }
+         }
+      }
+
+      // Swapping rows such the pivot lies on the diagonal
+      for( size_t l=0; l<L; ++l ) {
+         if( pivot[l] == j ) continue;
+         for( size_t k=j; k<n; ++k )
+            std::swap( a[(j*n+k)*L+l], a[(pivot[l]*n+k)*L+l] );
+         std::swap( r[j*L+l], r[pivot[l]*L+l] );
+      }
+
+      // Eliminating the column below the diagonal
+      real inv[L];
+
+      for( size_t l=0; l<L; ++l )
+         inv[l] = ( isDefault( a[(j*n+j)*L+l] ) )?( real(0) ):( real(1) / a[(j*n+j)*L+l] );
+
+      for( size_t i=j+1; i<n; ++i )
+      {
+         real f[L];
+
+         for( size_t l=0; l<L; ++l ) {
+            f[l] = a[(i*n+j)*L+l] * inv[l];
+            reset( a[(i*n+j)*L+l] );
+         }
+
+         for( size_t k=j+1; k<n; ++k ) {
+            for( size_t l=0; l<L; ++l )
+               a[(i*n+k)*L+l] -= a[(j*n+k)*L+l] * f[l];
+         }
+
+         for( size_t l=0; l<L; ++l )
+            r[i*L+l] -= r[j*L+l] * f[l];
+      }
+   }
+
+   // Performing the backward substitution
+   for( size_t i=n-1; i<n; --i )
+   {
+      real rhs[L];
+
+      for( size_t l=0; l<L; ++l )
+         rhs[l] = r[i*L+l];
+
+      for( size_t k=i+1; k<n; ++k ) {
+         for( size_t l=0; l<L; ++l )
+            rhs[l] -= x[k*L+l] * a[(i*n+k)*L+l];
+      }
+
+      for( size_t l=0; l<L; ++l ) {
+         if( std::fabs( a[(i*n+i)*L+l] ) > accuracy ) {
+            x[i*L+l] = rhs[l] / a[(i*n+i)*L+l];
+         }
+         else {
+            // This will introduce errors in the solution
+            reset( x[i*L+l] );
+            precision = max( precision, std::fabs( rhs[l] ) );
+         }
+      }
+   }
+
+   return precision;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Solves a range of groups of linear systems of a batch.
+//
+// \param batch The batch of linear systems.
+// \param order The order of the linear systems (see Batch::group()).
+// \param bounds The bounds of the groups of linear systems (see Batch::group()).
+// \param precision The resulting maximum inaccuracy of each group.
+// \param begin The first group to be solved.
+// \param end One past the last group to be solved.
+// \return void
+//
+// This function solves the groups \f$ [begin..end) \f$ of the given batch. Groups of \a lanes
+// linear systems of the same size are solved simultaneously, all other linear systems are
+// solved individually. The helper data is allocated once for all groups.
+*/
+void batchKernel( Batch<LSE>& batch, const std::vector<size_t>& order,
+                  const std::vector<size_t>& bounds, real* precision, size_t begin, size_t end )
+{
+   if( begin == end ) return;
+
+   const size_t nmax( batch.size( order[bounds[end]-1] ) );
+
+   std::vector<real> a( nmax*nmax*lanes ), r( nmax*lanes ), x( nmax*lanes );
+
+   for( size_t g=begin; g<end; ++g )
+   {
+      const size_t first( bounds[g] );
+      const size_t count( bounds[g+1] - first );
+      const size_t n    ( batch.size( order[first] ) );
+
+      // Interleaving the linear systems of the group
+      for( size_t l=0; l<count; ++l ) {
+         const real* const A( batch.A( order[first+l] ) );
+         const real* const b( batch.b( order[first+l] ) );
+         for( size_t i=0; i<n*n; ++i )
+            a[i*count+l] = A[i];
+         for( size_t i=0; i<n; ++i )
+            r[i*count+l] = -b[i];
+      }
+
+      // Solving the linear systems of the group
+      if( count == lanes )
+         precision[g] = eliminate<lanes>( n, &a[0], &r[0], &x[0] );
+      else
+         precision[g] = eliminate<1>( n, &a[0], &r[0], &x[0] );
+
+      // Storing the solutions
+      for( size_t l=0; l<count; ++l ) {
+         real* const xk( batch.x( order[first+l] ) );
+         for( size_t i=0; i<n; ++i )
+            xk[i] = x[i*count+l];
+      }
+   }
+}
+//*************************************************************************************************
+
+} // namespace
+
+
+
+
 //=================================================================================================
 //
 //  CONSTRUCTOR
@@ -177,4 +366,60 @@ bool GaussianElimination::solve( const CMatMxN& A, const VecN& b, VecN& x )
 }
 //*************************************************************************************************
 
+//*************************************************************************************************
+/*!\brief Solves all linear systems of the given batch.
+//
+// \param batch The batch of linear systems \f$ A_k \cdot x_k + b_k = 0 \f$.
+// \return Returns \a true if all solutions are sufficiently accurate, otherwise it returns \a false.
+//
+// This function solves all linear systems of the given batch by means of Gaussian elimination
+// with partial pivoting. The linear systems are grouped by size, and linear systems of the same
+// size are solved simultaneously by means of SIMD instructions (one linear system per SIMD lane).
+// In case the total number of unknowns reaches the SMP_BATCH_THRESHOLD, the groups are solved
+// in parallel, where each thread receives approximately the same number of operations. The
+// precision of the solver corresponds to the maximum inaccuracy of all solutions.
+*/
+bool GaussianElimination::solve( Batch<LSE>& batch )
+{
+   lastPrecision_  = real(0);
+   lastIterations_ = 1;
+
+   if( batch.problems() == 0 )
+      return true;
+
+   std::vector<size_t> order, bounds, parts;
+   batch.group( lanes, order, bounds );
+
+   const size_t groups( bounds.size() - 1 );
+
+   // Distributing the groups to the threads
+   std::vector<size_t> work( groups );
+   for( size_t g=0; g<groups; ++g ) {
+      const size_t n( batch.size( order[bounds[g]] ) );
+      work[g] = ( bounds[g+1] - bounds[g] ) * n*n*n;
+   }
+
+   const size_t threads( ( batch.x_.size() < SMP_BATCH_THRESHOLD )?( 1 ):( getNumThreads() ) );
+   partitionWork( work, threads, parts );
+
+   // Solving the linear systems
+   std::vector<real> precision( groups, real(0) );
+
+   smpForPartitions( parts, boost::bind( batchKernel, boost::ref( batch ), boost::cref( order ),
+                                         boost::cref( bounds ), &precision[0], _1, _2 ) );
+
+   for( size_t g=0; g<groups; ++g )
+      lastPrecision_ = max( lastPrecision_, precision[g] );
+
+   BLAZE_LOG_DEBUG_SECTION( log ) {
+      if( lastPrecision_ < threshold_ )
+         log << "      Solved " << batch.problems() << " linear systems using Gaussian elimination.";
+      else
+         log << BLAZE_YELLOW << "      WARNING: Did not solve all linear systems within accuracy. (" << lastPrecision_ << ")" << BLAZE_OLDCOLOR;
+   }
+
+   return lastPrecision_ < threshold_;
+}
+//*************************************************************************************************
+
 } // namespace blaze
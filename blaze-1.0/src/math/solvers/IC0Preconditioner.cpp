@@ -0,0 +1,221 @@
+//*************************************************************************************************
+/*!
+//  \file src/math/solvers/IC0Preconditioner.cpp
+//  \brief Source file for the incomplete Cholesky preconditioner
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <blaze/math/solvers/IC0Preconditioner.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CONSTRUCTORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief The default constructor for the IC0Preconditioner class.
+//
+// The default constructor creates an empty preconditioner. Before it can be used, it has to be
+// set up for a specific system matrix via the setup() function.
+*/
+IC0Preconditioner::IC0Preconditioner()
+   : L_  ()  // The strictly lower triangular part of the incomplete Cholesky factor
+   , inv_()  // The inverse diagonal elements of the incomplete Cholesky factor
+{}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Creates an incomplete Cholesky preconditioner for the given system matrix.
+//
+// \param A The symmetric positive definite system matrix.
+// \exception std::invalid_argument System matrix is not square.
+// \exception std::invalid_argument Incomplete Cholesky factorization failed.
+*/
+IC0Preconditioner::IC0Preconditioner( const CMatMxN& A )
+   : L_  ()  // The strictly lower triangular part of the incomplete Cholesky factor
+   , inv_()  // The inverse diagonal elements of the incomplete Cholesky factor
+{
+   setup( A );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Sets up the preconditioner for the given system matrix.
+//
+// \param A The symmetric positive definite system matrix.
+// \return void
+// \exception std::invalid_argument System matrix is not square.
+// \exception std::invalid_argument Incomplete Cholesky factorization failed.
+//
+// This function computes the incomplete Cholesky factor of the given system matrix row by row.
+// Only the lower triangular part of the system matrix is accessed, i.e. the system matrix is
+// assumed to be symmetric. In case a non-positive pivot is encountered (for instance due to a
+// missing diagonal element or in case the system matrix is not positive definite), a
+// \a std::invalid_argument exception is thrown.
+*/
+void IC0Preconditioner::setup( const CMatMxN& A )
+{
+   typedef CMatMxN::ConstIterator  ConstIterator;
+
+   if( A.rows() != A.columns() )
+      throw std::invalid_argument( "System matrix is not square" );
+
+   const size_t n( A.rows() );
+
+   // Determining the number of non-zero elements per row of the strictly lower part
+   std::vector<size_t> nonzeros( n, 0UL );
+
+   for( size_t i=0UL; i<n; ++i ) {
+      const ConstIterator end( A.end(i) );
+      for( ConstIterator element=A.begin(i); element!=end && element->index()<i; ++element )
+         ++nonzeros[i];
+   }
+
+   CMatMxN L( n, n, nonzeros );
+   L_.swap( L );
+   inv_.resize( n, false );
+
+   // Computing the incomplete Cholesky factor
+   for( size_t i=0UL; i<n; ++i )
+   {
+      const ConstIterator end( A.end(i) );
+      ConstIterator element( A.begin(i) );
+
+      for( ; element!=end && element->index()<i; ++element ) {
+         const size_t j( element->index() );
+         L_.append( i, j, ( element->value() - dot( i, j ) ) * inv_[j] );
+      }
+
+      const real pivot( ( element!=end && element->index()==i )?( element->value() ):( real(0) ) );
+      const real d( pivot - dot( i, i ) );
+
+      if( !( d > real(0) ) )
+         throw std::invalid_argument( "Incomplete Cholesky factorization failed" );
+
+      inv_[i] = real(1) / std::sqrt( d );
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Applies the preconditioner to the given residual.
+//
+// \param r The residual vector.
+// \param z The resulting preconditioned residual \f$ z = (L \cdot L^T)^{-1} r \f$.
+// \return The inner product \f$ r^T z \f$.
+//
+// This function computes the preconditioned residual by a forward substitution with the
+// incomplete Cholesky factor and a backward substitution with its transpose. The inner product
+// \f$ r^T z \f$ is computed on the fly during the backward substitution.
+*/
+real IC0Preconditioner::apply( const VecN& r, VecN& z ) const
+{
+   typedef CMatMxN::ConstIterator  ConstIterator;
+
+   BLAZE_USER_ASSERT( r.size() == inv_.size(), "Invalid residual vector size" );
+
+   const size_t n( inv_.size() );
+
+   z.resize( n, false );
+
+   // Forward substitution L y = r
+   for( size_t i=0UL; i<n; ++i ) {
+      real y( r[i] );
+      const ConstIterator end( L_.end(i) );
+      for( ConstIterator element=L_.begin(i); element!=end; ++element )
+         y -= element->value() * z[element->index()];
+      z[i] = y * inv_[i];
+   }
+
+   // Backward substitution L^T z = y
+   real rz( 0 );
+
+   for( size_t i=n; i>0UL; --i ) {
+      const real zi( z[i-1UL] * inv_[i-1UL] );
+      z[i-1UL] = zi;
+      rz += r[i-1UL] * zi;
+      const ConstIterator end( L_.end(i-1UL) );
+      for( ConstIterator element=L_.begin(i-1UL); element!=end; ++element )
+         z[element->index()] -= element->value() * zi;
+   }
+
+   return rz;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the inner product of two rows of the incomplete Cholesky factor.
+//
+// \param i The index of the current row \f$[0..N)\f$.
+// \param j The index of the second row \f$[0..i]\f$.
+// \return The inner product of the elements of both rows left of column \a j.
+//
+// This function is used during the factorization: row \a i only contains the elements that
+// have already been computed, i.e. all elements left of column \a j.
+*/
+real IC0Preconditioner::dot( size_t i, size_t j ) const
+{
+   typedef CMatMxN::ConstIterator  ConstIterator;
+
+   ConstIterator a( L_.begin(i) );
+   ConstIterator b( L_.begin(j) );
+   const ConstIterator aend( L_.end(i) );
+   const ConstIterator bend( L_.end(j) );
+
+   real sum( 0 );
+
+   while( a != aend && b != bend ) {
+      if( a->index() < b->index() ) ++a;
+      else if( b->index() < a->index() ) ++b;
+      else {
+         sum += a->value() * b->value();
+         ++a;
+         ++b;
+      }
+   }
+
+   return sum;
+}
+//*************************************************************************************************
+
+} // namespace blaze
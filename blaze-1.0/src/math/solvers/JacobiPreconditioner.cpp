@@ -0,0 +1,177 @@
+//*************************************************************************************************
+/*!
+//  \file src/math/solvers/JacobiPreconditioner.cpp
+//  \brief Source file for the Jacobi preconditioner
+//
+//  Copyright (C) 2011 Klaus Iglberger - All Rights Reserved
+//
+//  This file is part of the Blaze library. This library is free software; you can redistribute
+//  it and/or modify it under the terms of the GNU General Public License as published by the
+//  Free Software Foundation; either version 3, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//  See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with a special
+//  exception for linking and compiling against the Blaze library, the so-called "runtime
+//  exception"; see the file COPYING. If not, see http://www.gnu.org/licenses/.
+*/
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <stdexcept>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <blaze/math/shims/IsDefault.h>
+#include <blaze/math/smp/ThreadBackend.h>
+#include <blaze/math/solvers/JacobiPreconditioner.h>
+#include <blaze/system/Thresholds.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Types.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CONSTRUCTORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief The default constructor for the JacobiPreconditioner class.
+//
+// The default constructor creates an empty preconditioner. Before it can be used, it has to be
+// set up for a specific system matrix via the setup() function.
+*/
+JacobiPreconditioner::JacobiPreconditioner()
+   : inv_()      // The inverse diagonal elements of the system matrix
+   , partial_()  // The partial inner products of the parts
+{}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Creates a Jacobi preconditioner for the given system matrix.
+//
+// \param A The square system matrix.
+// \exception std::invalid_argument System matrix is not square.
+// \exception std::invalid_argument Zero diagonal element.
+*/
+JacobiPreconditioner::JacobiPreconditioner( const CMatMxN& A )
+   : inv_()      // The inverse diagonal elements of the system matrix
+   , partial_()  // The partial inner products of the parts
+{
+   setup( A );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Sets up the preconditioner for the given system matrix.
+//
+// \param A The square system matrix.
+// \return void
+// \exception std::invalid_argument System matrix is not square.
+// \exception std::invalid_argument Zero diagonal element.
+*/
+void JacobiPreconditioner::setup( const CMatMxN& A )
+{
+   typedef CMatMxN::ConstIterator  ConstIterator;
+
+   if( A.rows() != A.columns() )
+      throw std::invalid_argument( "System matrix is not square" );
+
+   const size_t n( A.rows() );
+
+   inv_.resize( n, false );
+
+   for( size_t i=0UL; i<n; ++i )
+   {
+      const ConstIterator element( A.find( i, i ) );
+
+      if( element == A.end(i) || isDefault( element->value() ) )
+         throw std::invalid_argument( "Zero diagonal element" );
+
+      inv_[i] = real(1) / element->value();
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Applies the preconditioner to the given residual.
+//
+// \param r The residual vector.
+// \param z The resulting preconditioned residual \f$ z = D^{-1} r \f$.
+// \return The inner product \f$ r^T z \f$.
+//
+// This function computes the preconditioned residual and the according inner product in a
+// single sweep. In case the size of the vectors reaches the SMP_DVECASSIGN_THRESHOLD, the
+// vectors are processed in parallel.
+*/
+real JacobiPreconditioner::apply( const VecN& r, VecN& z )
+{
+   BLAZE_USER_ASSERT( r.size() == inv_.size(), "Invalid residual vector size" );
+
+   const size_t parts( ( inv_.size() < SMP_DVECASSIGN_THRESHOLD )?( 1UL ):( getNumThreads() ) );
+
+   z.resize( inv_.size(), false );
+   partial_.resize( parts );
+
+   smpFor( parts, 1UL, boost::bind( &JacobiPreconditioner::applyKernel, this, boost::cref( r ),
+                                    boost::ref( z ), parts, _1, _2 ) );
+
+   real rz( 0 );
+   for( size_t p=0UL; p<parts; ++p )
+      rz += partial_[p];
+
+   return rz;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Kernel for the application of the preconditioner to a range of parts.
+//
+// \param r The residual vector.
+// \param z The resulting preconditioned residual.
+// \param parts The total number of parts.
+// \param pbegin The first part to be processed.
+// \param pend One past the last part to be processed.
+// \return void
+*/
+void JacobiPreconditioner::applyKernel( const VecN& r, VecN& z, size_t parts,
+                                        size_t pbegin, size_t pend )
+{
+   const size_t n( inv_.size() );
+
+   for( size_t p=pbegin; p<pend; ++p )
+   {
+      const size_t iend( ( ( p+1UL ) * n ) / parts );
+      real rz( 0 );
+
+      for( size_t i=( p*n )/parts; i<iend; ++i ) {
+         z[i] = inv_[i] * r[i];
+         rz += r[i] * z[i];
+      }
+
+      partial_[p] = rz;
+   }
+}
+//*************************************************************************************************
+
+} // namespace blaze
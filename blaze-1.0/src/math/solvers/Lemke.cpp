@@ -26,11 +26,18 @@
 
 #include <algorithm>
 #include <ostream>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/format.hpp>
+#include <boost/ref.hpp>
 #include <blaze/math/Accuracy.h>
 #include <blaze/math/CompressedMatrix.h>
-#include <blaze/math/Infinity.h>
+#include <blaze/math/Functions.h>
+#include <blaze/math/smp/Partition.h>
+#include <blaze/math/smp/ThreadBackend.h>
 #include <blaze/math/solvers/Lemke.h>
+#include <blaze/system/Thresholds.h>
 #include <blaze/util/Assert.h>
 #include <blaze/util/ColorMacros.h>
 #include <blaze/util/logging/DebugSection.h>
@@ -41,329 +48,439 @@ namespace blaze {
 
 //=================================================================================================
 //
-//  CONSTRUCTOR
+//  BATCHED LEMKE ALGORITHM
 //
 //=================================================================================================
 
+namespace {
+
 //*************************************************************************************************
-/*!\brief Default constructor for the Lemke class.
+/*!\brief Returns an element of the cover vector for a retry of a batched LCP.
+//
+// \param k The index of the LCP within the batch.
+// \param t The index of the try.
+// \param i The index of the element.
+// \return The element of the cover vector in the range \f$ [0.1..9.91) \f$.
+//
+// In contrast to the global random number generator, the cover vector of a retry only depends
+// on the LCP, the try and the element, which makes the batched solution independent of the
+// number of threads and of the order in which the LCPs are solved.
 */
-Lemke::Lemke()
-   : Solver()      // Initialization of the base class
-   , basics_()     // TODO
-   , nonbasics_()  // TODO
-   , M_()          // TODO
-   , Q_()          // TODO
-{}
-//*************************************************************************************************
+inline real cover( size_t k, size_t t, size_t i )
+{
+   boost::uint32_t h( static_cast<boost::uint32_t>( k*0x9E3779B9UL + t*0x85EBCA6BUL + i ) );
 
+   h ^= h >> 16;
+   h *= 0x7FEB352DU;
+   h ^= h >> 15;
+   h *= 0x846CA68BU;
+   h ^= h >> 16;
 
+   return real(0.1) + real(9.81) * ( real( h ) / real( 4294967296.0 ) );
+}
+//*************************************************************************************************
 
 
-//=================================================================================================
+//*************************************************************************************************
+/*!\brief Lexicographic comparison of two scaled rows of the tableau.
 //
-//  SOLVER FUNCTIONS
+// \param Q The row-major \f$ n \times (n+1) \f$ matrix \f$ Q' = [q; Q] \f$.
+// \param cols The number of columns of \a Q.
+// \param i1 The first row.
+// \param f1 The scaling factor of the first row.
+// \param i2 The second row.
+// \param f2 The scaling factor of the second row.
+// \return \a true if the first scaled row is lexicographically less than the second, \a false if not.
+*/
+inline bool isLexicographicallyLess( const real* Q, size_t cols, size_t i1, real f1, size_t i2, real f2 )
+{
+   for( size_t j=0; j<cols; ++j )
+   {
+      if( Q[i1*cols+j] * f1 < Q[i2*cols+j] * f2 - real(accuracy) )
+         return true;
+      else if( Q[i1*cols+j] * f1 > Q[i2*cols+j] * f2 + real(accuracy) )
+         return false;
+   }
+
+   return false;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Lexicographic comparison of two scaled rows of the tableau.
 //
-//=================================================================================================
+// \param Q The row-major \f$ n \times (n+1) \f$ matrix \f$ Q' = [q; Q] \f$.
+// \param cols The number of columns of \a Q.
+// \param i1 The first row.
+// \param f1 The scaling factor of the first row.
+// \param i2 The second row.
+// \param f2 The scaling factor of the second row.
+// \return \a true if the first scaled row is lexicographically greater than the second, \a false if not.
+*/
+inline bool isLexicographicallyGreater( const real* Q, size_t cols, size_t i1, real f1, size_t i2, real f2 )
+{
+   for( size_t j=0; j<cols; ++j )
+   {
+      if( Q[i1*cols+j] * f1 > Q[i2*cols+j] * f2 + real(accuracy) )
+         return true;
+      else if( Q[i1*cols+j] * f1 < Q[i2*cols+j] * f2 - real(accuracy) )
+         return false;
+   }
 
+   return false;
+}
 //*************************************************************************************************
-/*!\brief TODO
+
+
+//*************************************************************************************************
+/*!\brief Pivot step on the tableau of a batched LCP.
 //
-// \param lcp TODO
+// \param n The size of the LCP.
+// \param M The row-major \f$ n \times (n+1) \f$ matrix \f$ M' = [d; M] \f$.
+// \param Q The row-major \f$ n \times (n+1) \f$ matrix \f$ Q' = [q; Q] \f$.
+// \param basics The basic variables.
+// \param nonbasics The nonbasic variables.
+// \param r The row of the blocking variable.
+// \param s The column of the driving variable.
 // \return void
-//
-// TODO
 */
-bool Lemke::solve( LCP& lcp )
+void pivot( size_t n, real* M, real* Q, ptrdiff_t* basics, ptrdiff_t* nonbasics, size_t r, size_t s )
 {
-   bool converged( false );
-   VecN coverVector( lcp.size(), 1 );
+   const size_t cols( n+1 );
+   const real invPivot( real(1) / M[r*cols+s] );
 
-   size_t it( 0 );
-   for( ; !converged && it<maxIterations_; ++it )
+   for( size_t i=0; i<n; ++i )
    {
-      bool solved( solve( lcp, coverVector ) );
-
-      lastPrecision_ = lcp.residual();
+      if( i == r ) continue;
 
-      if( lastPrecision_ < threshold_ )
-      {
-         BLAZE_LOG_DEBUG_SECTION( log ) {
-            if( !solved )
-               log << BLAZE_YELLOW << "      WARNING: The LCP was only solved approximately." << BLAZE_OLDCOLOR;
-         }
+      const real factor( M[i*cols+s] * invPivot );
 
-         converged = true;
+      for( size_t j=0; j<cols; ++j ) {
+         Q[i*cols+j] -= Q[r*cols+j] * factor;
       }
-      else
-      {
-         BLAZE_LOG_DEBUG_SECTION( log ) {
-            if( solved )
-               log << BLAZE_YELLOW << "      WARNING: The LCP was supposedly solved but not accurately enough (" << lastPrecision_ << ")." << BLAZE_OLDCOLOR;
-            else
-               log << BLAZE_YELLOW << "      WARNING: The LCP was NOT solved." << BLAZE_OLDCOLOR;
-         }
 
-         // Retrying with a different randomly chosen cover vector
-         for( size_t i=0; i<coverVector.size(); ++i )
-            coverVector[i] = rand<real>( 0.1, 9.91 );
+      for( size_t j=0; j<cols; ++j )
+      {
+         if( j == s ) continue;
+         M[i*cols+j] -= M[i*cols+s] * ( M[r*cols+j] * invPivot );
       }
+
+      M[i*cols+s] = factor;
    }
 
-   BLAZE_LOG_DEBUG_SECTION( log ) {
-      if( converged && it == 1 )
-         log << "      Solved the LCP on first try.";
-      else if( converged && it > 1 )
-         log << BLAZE_YELLOW << "      WARNING: Solved the LCP in " << it << " tries." << BLAZE_OLDCOLOR;
-      else
-         log << BLAZE_YELLOW << "      WARNING: Did not solve the LCP within accuracy. (" << lastPrecision_ << ")" << BLAZE_OLDCOLOR;
+   for( size_t j=0; j<cols; ++j ) {
+      Q[r*cols+j] = -Q[r*cols+j] * invPivot;
    }
 
-   lastIterations_ = it;
+   for( size_t j=0; j<cols; ++j )
+   {
+      if( j == s )
+         M[r*cols+j] = invPivot;
+      else
+         M[r*cols+j] = -M[r*cols+j] * invPivot;
+   }
 
-   return converged;
+   // Swap the blocking and driving variables
+   std::swap( basics[r], nonbasics[s] );
 }
 //*************************************************************************************************
 
 
 //*************************************************************************************************
-/*!\brief TODO
+/*!\brief Lemke's algorithm on the tableau of an LCP.
 //
-// \param lcp TODO
-// \param d TODO
-// \return TODO
+// \param n The size of the LCP.
+// \param d The cover vector.
+// \param x The resulting vector of unknowns.
+// \param M The row-major \f$ n \times (n+1) \f$ matrix \f$ M' = [d; M] \f$ of the augmented LCP.
+// \param Q The row-major \f$ n \times (n+1) \f$ matrix \f$ Q' = [q; Q] \f$.
+// \param basics Helper array for the \a n basic variables.
+// \param nonbasics Helper array for the \a n+1 nonbasic variables.
+// \return \a true if the LCP was solved, \a false if not.
 //
-// TODO
+// This function performs the pivot steps of Lemke's algorithm on the given tableau, where \a Q
+// has to contain the right-hand side vector and an identity matrix and \a M has to contain the
+// cover vector and the system matrix of the LCP. It works on raw arrays instead of the members
+// of a Lemke solver, such that it is used both by the Lemke::solve() function and by several
+// threads solving independent LCPs of a batch at the same time.
 */
-bool Lemke::solve( LCP& lcp, const VecN& d )
+bool lemke( size_t n, const real* d, real* x, real* M, real* Q,
+            ptrdiff_t* basics, ptrdiff_t* nonbasics )
 {
-   const size_t n( lcp.size() );
-
-   const CMatMxN& A( lcp.A_ );
-   const VecN&    b( lcp.b_ );
-
-   basics_.resize( n, false );
-   nonbasics_.resize( n+1, false );
-   M_.resize( n, n+1, false );
-   Q_.resize( n, n+1, false );
-
-   // Merging q into Q' = [q; Q]
-   for( size_t i=0; i<n; ++i )
-   {
-      Q_(i,0) = b[i];
-
-      // Constructing a lexicographically positive identity matrix Q
-      for( size_t j=1; j<Q_.columns(); ++j ) {
-         if( j == i+1 )
-            Q_(i,j) = 1;
-         else
-            Q_(i,j) = 0;
-      }
-   }
-
-   // Preparing the augmented LCP with M' = [d; M]
-   M_ = real( 0 );
-   for( size_t i=0; i<n; ++i ) {
-      M_(i,0) = d[i];
-
-      for( CMatMxN::ConstIterator element=A.begin(i); element!=A.end(i); ++element ) {
-         M_(i,element->index()+1) = element->value();
-      }
-   }
+   const size_t cols( n+1 );
 
    // Annotating the tableau
-   nonbasics_[0] = 0;
+   nonbasics[0] = 0;
    for( size_t i=1; i<=n; ++i ) {
-      basics_[i-1]  = -static_cast<ptrdiff_t>(i);
-      nonbasics_[i] =  static_cast<ptrdiff_t>(i);
+      basics[i-1]  = -static_cast<ptrdiff_t>(i);
+      nonbasics[i] =  static_cast<ptrdiff_t>(i);
    }
 
-   // Printing the annotated tableau
-   //BLAZE_LOG_DEBUG_SECTION( log ) {
-   //   printTableau( log );
-   //}
-
    // Determination of the lexicographically smallest blocking variable for the initial pivot step
-   size_t r = inf;
+   size_t r( n );
 
    for( size_t i=0; i<n; ++i ) {
-      if( Q_(i,0) < -accuracy ) {  // < 0
+      if( Q[i*cols] < -accuracy ) {  // < 0
          r = i;
          break;
       }
    }
 
    // We are finished if q >= 0 since z = 0 solves the LCP
-   if( r == inf ) {
-      lcp.x_ = real( 0 );
+   if( r == n ) {
+      std::fill( x, x+n, real(0) );
       return true;
    }
 
    for( size_t i=r+1; i<n; ++i ) {
-      if( Q_(i,0) > -accuracy ) {  // >= 0
-         BLAZE_INTERNAL_ASSERT( d[i] > -accuracy, "Negative value found" );  // >= 0
+      if( Q[i*cols] > -accuracy )  // >= 0
          continue;
-      }
 
       BLAZE_INTERNAL_ASSERT( d[i] > real( 0 ), "Non-positive value found" );
-      if( isLexicographicallyGreater( i, real(-1)/d[i], r, real(-1)/d[r]) )
+      if( isLexicographicallyGreater( Q, cols, i, real(-1)/d[i], r, real(-1)/d[r] ) )
          r = i;
    }
 
-   size_t s = 0;
-   size_t pivot_steps = 0;
+   size_t s( 0 );
+   size_t pivotSteps( 0 );
 
    while( true )
    {
-      // Perform pivot step
-      pivot( r, s );
-
-      // Printing the annotated tableau
-      //BLAZE_LOG_DEBUG_SECTION( log ) {
-      //   printTableau( log );
-      //}
+      pivot( n, M, Q, basics, nonbasics, r, s );
 
       // Finish if z0 blocked the driving variable
-      if( nonbasics_[s] == 0 ) {
-         lcp.x_ = real( 0 );
+      if( nonbasics[s] == 0 ) {
+         std::fill( x, x+n, real(0) );
          for( size_t i=0; i<n; ++i ) {
-            if( basics_[i] > 0 )
-               lcp.x_[basics_[i]-1] = Q_(i,0);
+            if( basics[i] > 0 )
+               x[basics[i]-1] = Q[i*cols];
          }
-
          return true;
       }
 
       // Find complement which will be driven next
-      ptrdiff_t variable = -nonbasics_[s];
-      s = inf;
+      const ptrdiff_t variable( -nonbasics[s] );
+      s = cols;
       for( size_t i=0; i<=n; ++i ) {
-         if( nonbasics_[i] == variable ) {
+         if( nonbasics[i] == variable ) {
             s = i;
             break;
          }
       }
 
-      BLAZE_INTERNAL_ASSERT( s != inf, "No complement found" );
-
-      BLAZE_LOG_DEBUG_SECTION( log ) {
-         if( nonbasics_[s] < 0 )
-            log << "         w" << -nonbasics_[s] << " is new driving variable in column " << s;
-         else
-            log << "         z" <<  nonbasics_[s] << " is new driving variable in column " << s;
-      }
+      BLAZE_INTERNAL_ASSERT( s != cols, "No complement found" );
 
       // Determination of the lexicographically smallest blocking variable
-      r = inf;
+      r = n;
       for( size_t i=0; i<n; ++i ) {
-         if( M_(i,s) < -accuracy ) {  // < 0
+         if( M[i*cols+s] < -accuracy ) {  // < 0
             r = i;
             break;
          }
       }
 
-      if( r == inf ) {
+      if( r == n ) {
          // Driving variable is unblocked
-         lcp.x_ = real( 0 );
+         std::fill( x, x+n, real(0) );
          for( size_t i=0; i<n; ++i ) {
-            if( basics_[i] > 0 )
-               lcp.x_[basics_[i]-1] = Q_(i,0);
+            if( basics[i] > 0 )
+               x[basics[i]-1] = Q[i*cols];
          }
-
          return false;
       }
 
       for( size_t i=r+1; i<n; ++i ) {
-         if( M_(i,s) > -accuracy )  // >= 0
+         if( M[i*cols+s] > -accuracy )  // >= 0
             continue;
 
-         if( isLexicographicallyLess( i, real( -1 )/M_(i,s), r, real( -1 )/M_(r,s) ) )
+         if( isLexicographicallyLess( Q, cols, i, real(-1)/M[i*cols+s], r, real(-1)/M[r*cols+s] ) )
             r = i;
       }
 
-      ++pivot_steps;
-
-      if( pivot_steps > 10*n ) {
-         BLAZE_LOG_DEBUG_SECTION( log ) {
-            log << BLAZE_YELLOW << "      WARNING: The LCP could not be solved with 10n pivot steps." << BLAZE_OLDCOLOR;
-         }
+      if( ++pivotSteps > 10*n )
          return false;
-      }
    }
-
-   return false;
 }
 //*************************************************************************************************
 
 
-
-
-//=================================================================================================
-//
-//  UTILITY FUNCTIONS
-//
-//=================================================================================================
-
 //*************************************************************************************************
-/*!\brief TODO
+/*!\brief Lemke's algorithm for a single LCP of a batch.
 //
-// \param v TODO
-// \return TODO
-//
-// TODO < 0
+// \param n The size of the LCP.
+// \param A The row-major \f$ n \times n \f$ system matrix.
+// \param b The right-hand side vector.
+// \param d The cover vector.
+// \param x The vector of unknowns.
+// \param M Helper array for the \f$ n \times (n+1) \f$ matrix \f$ M' = [d; M] \f$.
+// \param Q Helper array for the \f$ n \times (n+1) \f$ matrix \f$ Q' = [q; Q] \f$.
+// \param basics Helper array for the \a n basic variables.
+// \param nonbasics Helper array for the \a n+1 nonbasic variables.
+// \return \a true if the LCP was solved, \a false if not.
 */
-bool Lemke::isComponentwiseNonnegative( const VecN& v ) const
+bool lemke( size_t n, const real* A, const real* b, const real* d, real* x,
+            real* M, real* Q, ptrdiff_t* basics, ptrdiff_t* nonbasics )
 {
-   for( size_t i=0; i<v.size(); ++i ) {
-      if( v[i] < -accuracy )  // < 0
-         return false;
+   const size_t cols( n+1 );
+
+   // Merging q into Q' = [q; Q] and preparing the augmented LCP with M' = [d; M]
+   for( size_t i=0; i<n; ++i )
+   {
+      Q[i*cols] = b[i];
+      M[i*cols] = d[i];
+
+      for( size_t j=1; j<cols; ++j ) {
+         Q[i*cols+j] = ( j == i+1 )?( real(1) ):( real(0) );
+         M[i*cols+j] = A[i*n+j-1];
+      }
    }
-   return true;
+
+   return lemke( n, d, x, M, Q, basics, nonbasics );
 }
 //*************************************************************************************************
 
 
 //*************************************************************************************************
-/*!\brief TODO
+/*!\brief Solves a range of LCPs of a batch.
 //
-// \param v TODO
-// \return TODO
-//
-// TODO <= 0
+// \param batch The batch of LCPs.
+// \param maxTries The maximum number of tries per LCP.
+// \param threshold The precision threshold for the solution.
+// \param precision The resulting residual of each LCP.
+// \param tries The resulting number of tries of each LCP.
+// \param begin The first LCP to be solved.
+// \param end One past the last LCP to be solved.
+// \return void
 */
-bool Lemke::isComponentwisePositive( const VecN& v ) const
+void batchKernel( Batch<LCP>& batch, size_t maxTries, real threshold, real* precision,
+                  size_t* tries, size_t begin, size_t end )
 {
-   for( size_t i=0; i<v.size(); ++i ) {
-      if( v[i] < accuracy )  // <= 0
-         return false;
+   size_t nmax( 0 );
+   for( size_t k=begin; k<end; ++k )
+      nmax = max( nmax, batch.size( k ) );
+
+   if( nmax == 0 ) return;
+
+   std::vector<real>      M( nmax*(nmax+1) ), Q( nmax*(nmax+1) ), d( nmax );
+   std::vector<ptrdiff_t> basics( nmax ), nonbasics( nmax+1 );
+
+   for( size_t k=begin; k<end; ++k )
+   {
+      const size_t n( batch.size( k ) );
+
+      std::fill( d.begin(), d.begin()+n, real(1) );
+
+      size_t t( 0 );
+      while( t < maxTries )
+      {
+         lemke( n, batch.A( k ), batch.b( k ), &d[0], batch.x( k ),
+                &M[0], &Q[0], &basics[0], &nonbasics[0] );
+
+         ++t;
+
+         precision[k] = batch.residual( k );
+         if( precision[k] < threshold )
+            break;
+
+         // Retrying with a different pseudo-random cover vector
+         for( size_t i=0; i<n; ++i )
+            d[i] = cover( k, t, i );
+      }
+
+      tries[k] = t;
    }
-   return true;
 }
 //*************************************************************************************************
 
+} // namespace
+
+
+
+
+//=================================================================================================
+//
+//  CONSTRUCTOR
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Default constructor for the Lemke class.
+*/
+Lemke::Lemke()
+   : Solver()      // Initialization of the base class
+   , basics_()     // TODO
+   , nonbasics_()  // TODO
+   , M_()          // TODO
+   , Q_()          // TODO
+{}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  SOLVER FUNCTIONS
+//
+//=================================================================================================
 
 //*************************************************************************************************
 /*!\brief TODO
 //
-// \param i1 TODO
-// \param f1 TODO
-// \param i2 TODO
-// \param f2 TODO
-// \return TODO
+// \param lcp TODO
+// \return void
 //
 // TODO
 */
-bool Lemke::isLexicographicallyLess( size_t i1, real f1, size_t i2, real f2 ) const
+bool Lemke::solve( LCP& lcp )
 {
-   for( size_t j=0; j<Q_.columns(); ++j )
+   bool converged( false );
+   VecN coverVector( lcp.size(), 1 );
+
+   size_t it( 0 );
+   for( ; !converged && it<maxIterations_; ++it )
    {
-      if( Q_(i1,j) * f1 < Q_(i2,j) * f2 - real(accuracy) )
-         return true;
-      else if( Q_(i1,j) * f1 > Q_(i2,j) * f2 + real(accuracy) )
-         return false;
+      bool solved( solve( lcp, coverVector ) );
+
+      lastPrecision_ = lcp.residual();
+
+      if( lastPrecision_ < threshold_ )
+      {
+         BLAZE_LOG_DEBUG_SECTION( log ) {
+            if( !solved )
+               log << BLAZE_YELLOW << "      WARNING: The LCP was only solved approximately." << BLAZE_OLDCOLOR;
+         }
+
+         converged = true;
+      }
+      else
+      {
+         BLAZE_LOG_DEBUG_SECTION( log ) {
+            if( solved )
+               log << BLAZE_YELLOW << "      WARNING: The LCP was supposedly solved but not accurately enough (" << lastPrecision_ << ")." << BLAZE_OLDCOLOR;
+            else
+               log << BLAZE_YELLOW << "      WARNING: The LCP was NOT solved." << BLAZE_OLDCOLOR;
+         }
+
+         // Retrying with a different randomly chosen cover vector
+         for( size_t i=0; i<coverVector.size(); ++i )
+            coverVector[i] = rand<real>( 0.1, 9.91 );
+      }
    }
 
-   return false;
+   BLAZE_LOG_DEBUG_SECTION( log ) {
+      if( converged && it == 1 )
+         log << "      Solved the LCP on first try.";
+      else if( converged && it > 1 )
+         log << BLAZE_YELLOW << "      WARNING: Solved the LCP in " << it << " tries." << BLAZE_OLDCOLOR;
+      else
+         log << BLAZE_YELLOW << "      WARNING: Did not solve the LCP within accuracy. (" << lastPrecision_ << ")" << BLAZE_OLDCOLOR;
+   }
+
+   lastIterations_ = it;
+
+   return converged;
 }
 //*************************************************************************************************
 
@@ -371,88 +488,149 @@ bool Lemke::isLexicographicallyLess( size_t i1, real f1, size_t i2, real f2 ) co
 //*************************************************************************************************
 /*!\brief TODO
 //
-// \param i1 TODO
-// \param f1 TODO
-// \param i2 TODO
-// \param f2 TODO
+// \param lcp TODO
+// \param d TODO
 // \return TODO
 //
 // TODO
 */
-bool Lemke::isLexicographicallyGreater( size_t i1, real f1, size_t i2, real f2 ) const
+bool Lemke::solve( LCP& lcp, const VecN& d )
 {
-   for( size_t j = 0; j < Q_.columns(); ++j )
+   const size_t n( lcp.size() );
+   const size_t cols( n+1 );
+
+   const CMatMxN& A( lcp.A_ );
+   const VecN&    b( lcp.b_ );
+
+   if( n == 0 )
+      return true;
+
+   basics_.resize( n );
+   nonbasics_.resize( cols );
+   M_.assign( n*cols, real(0) );
+   Q_.assign( n*cols, real(0) );
+
+   // Merging q into Q' = [q; Q] and preparing the augmented LCP with M' = [d; M]
+   for( size_t i=0; i<n; ++i )
    {
-      if( Q_(i1,j) * f1 > Q_(i2,j) * f2 + real(accuracy) )
-         return true;
-      else if( Q_(i1,j) * f1 < Q_(i2,j) * f2 - real(accuracy) )
-         return false;
+      Q_[i*cols    ] = b[i];
+      Q_[i*cols+i+1] = real(1);
+      M_[i*cols    ] = d[i];
+
+      for( CMatMxN::ConstIterator element=A.begin(i); element!=A.end(i); ++element )
+         M_[i*cols+element->index()+1] = element->value();
    }
 
-   return false;
+   return lemke( n, d.data(), lcp.x_.data(), &M_[0], &Q_[0], &basics_[0], &nonbasics_[0] );
 }
 //*************************************************************************************************
 
 
+
+
 //*************************************************************************************************
-/*!\brief TODO
+/*!\brief Solves all LCPs of the given batch.
 //
-// \param block TODO
-// \param drive TODO
-// \return void
+// \param batch The batch of LCPs.
+// \return Returns \a true if all LCPs have been solved sufficiently accurate, otherwise it returns \a false.
 //
-// TODO
+// This function solves all LCPs of the given batch by means of Lemke's algorithm. In case an
+// LCP is not solved on first try, up to \a maxIterations_ tries are performed with different
+// pseudo-random cover vectors. These only depend on the index of the LCP and the try, such that
+// the result is independent of the number of threads. In case the total number of unknowns
+// reaches the SMP_BATCH_THRESHOLD, the LCPs are solved in parallel, whereat each thread works
+// on its own tableau. After the solution process, the precision of the solver corresponds to
+// the maximum residual of any LCP and the number of iterations corresponds to the maximum
+// number of tries of any LCP.
 */
-void Lemke::pivot( size_t block, size_t drive )
+bool Lemke::solve( Batch<LCP>& batch )
 {
-   using boost::format;
+   lastPrecision_  = real(0);
+   lastIterations_ = 0;
 
-   size_t r( block );
-   size_t s( drive );
+   const size_t problems( batch.problems() );
 
-   BLAZE_INTERNAL_ASSERT( r < basics_.size() && s <= basics_.size(), "Invalid preconditions for pivot step" );
+   if( problems == 0 )
+      return true;
 
-   BLAZE_LOG_DEBUG_SECTION( log ) {
-      log << "         pivot step <"
-          << ( basics_[r] < 0 ? "w" : "z" )
-          << ( basics_[r] < 0 ? -basics_[r] : basics_[r] ) << ", "
-          << ( nonbasics_[s] < 0 ? "w" : "z" )
-          << ( nonbasics_[s] < 0 ? -nonbasics_[s] : nonbasics_[s] ) << ">\n";
+   // Distributing the LCPs to the threads
+   std::vector<size_t> work( problems ), parts;
+   for( size_t k=0; k<problems; ++k ) {
+      const size_t n( batch.size( k ) );
+      work[k] = n*n*n;
    }
 
-   real invPivot = real( 1 ) / M_(r,s);
+   const size_t threads( ( batch.x_.size() < SMP_BATCH_THRESHOLD )?( 1 ):( getNumThreads() ) );
+   partitionWork( work, threads, parts );
 
-   for( size_t i=0; i<M_.rows(); ++i )
-   {
-      if( i == r ) continue;
+   // Solving the LCPs
+   std::vector<real>   precision( problems, real(0) );
+   std::vector<size_t> tries    ( problems, 0 );
 
-      for( size_t j=0; j<Q_.columns(); ++j ) {
-         Q_(i,j) -= Q_(r,j) * M_(i,s) * invPivot;
-      }
-
-      for( size_t j=0; j<M_.columns(); ++j )
-      {
-         if( j == s ) continue;
-         M_(i,j) -= M_(i,s) * ( M_(r,j) * invPivot );
-      }
+   smpForPartitions( parts, boost::bind( batchKernel, boost::ref( batch ), maxIterations_,
+                                         threshold_, &precision[0], &tries[0], _1, _2 ) );
 
-      M_(i,s) *= invPivot;
+   for( size_t k=0; k<problems; ++k ) {
+      lastPrecision_  = max( lastPrecision_ , precision[k] );
+      lastIterations_ = max( lastIterations_, tries[k]     );
    }
 
-   for( size_t j=0; j<Q_.columns(); ++j ) {
-      Q_(r,j) = -Q_(r,j) * invPivot;
-   }
+   const bool converged( lastPrecision_ < threshold_ );
 
-   for( size_t j=0; j<M_.columns(); ++j )
-   {
-      if( j == s )
-         M_(r,j) = invPivot;
+   BLAZE_LOG_DEBUG_SECTION( log ) {
+      if( converged )
+         log << "      Solved " << problems << " LCPs in at most " << lastIterations_ << " tries.";
       else
-         M_(r,j) = -M_(r,j) * invPivot;
+         log << BLAZE_YELLOW << "      WARNING: Did not solve all LCPs within accuracy. (" << lastPrecision_ << ")" << BLAZE_OLDCOLOR;
    }
 
-   // Swap the blocking and driving variables
-   std::swap( basics_[r], nonbasics_[s] );
+   return converged;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief TODO
+//
+// \param v TODO
+// \return TODO
+//
+// TODO < 0
+*/
+bool Lemke::isComponentwiseNonnegative( const VecN& v ) const
+{
+   for( size_t i=0; i<v.size(); ++i ) {
+      if( v[i] < -accuracy )  // < 0
+         return false;
+   }
+   return true;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief TODO
+//
+// \param v TODO
+// \return TODO
+//
+// TODO <= 0
+*/
+bool Lemke::isComponentwisePositive( const VecN& v ) const
+{
+   for( size_t i=0; i<v.size(); ++i ) {
+      if( v[i] < accuracy )  // <= 0
+         return false;
+   }
+   return true;
 }
 //*************************************************************************************************
 
@@ -469,17 +647,18 @@ void Lemke::printTableau( std::ostream& os ) const
    using boost::format;
 
    const size_t n( basics_.size() );
+   const size_t cols( n+1 );
 
    // Printing the header
    os << "      ";
-   for( size_t j=0; j<Q_.columns(); ++j ) {
+   for( size_t j=0; j<cols; ++j ) {
       if( j == 0 )
          os << format( " %-7d " ) % 1;
       else
          os << format( " x%-6d " ) % j;
    }
    os << "  ";
-   for( size_t j=0; j<M_.columns(); ++j ) {
+   for( size_t j=0; j<cols; ++j ) {
       if( nonbasics_[j] < 0 )
          os << format( " w%-6d " ) % -nonbasics_[j];
       else
@@ -489,11 +668,11 @@ void Lemke::printTableau( std::ostream& os ) const
 
    // Printing the table border
    os << "     +-";
-   for( size_t j=0; j<Q_.columns(); ++j ) {
+   for( size_t j=0; j<cols; ++j ) {
       os << "---------";
    }
    os << "+-";
-   for( size_t j=0; j<M_.columns(); ++j ) {
+   for( size_t j=0; j<cols; ++j ) {
       os << "---------";
    }
    os << "+\n";
@@ -504,23 +683,23 @@ void Lemke::printTableau( std::ostream& os ) const
       else
          os << format( " z%-2d | " ) % basics_[i];
 
-      for( size_t j=0; j<Q_.columns(); ++j ) {
-         os << format( "%-8.2d " ) % Q_(i, j);
+      for( size_t j=0; j<cols; ++j ) {
+         os << format( "%-8.2d " ) % Q_[i*cols+j];
       }
       os << "| ";
 
-      for( size_t j=0; j<M_.columns(); ++j ) {
-         os << format( "%-8.2d " ) % M_(i, j);
+      for( size_t j=0; j<cols; ++j ) {
+         os << format( "%-8.2d " ) % M_[i*cols+j];
       }
       os << "|\n";
    }
 
    os << "     +-";
-   for( size_t j=0; j<Q_.columns(); ++j ) {
+   for( size_t j=0; j<cols; ++j ) {
       os << "---------";
    }
    os << "+-";
-   for( size_t j=0; j<M_.columns(); ++j ) {
+   for( size_t j=0; j<cols; ++j ) {
       os << "---------";
    }
    os << "+\n\n";
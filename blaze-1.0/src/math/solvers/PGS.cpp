@@ -24,11 +24,116 @@
 // Includes
 //*************************************************************************************************
 
+#include <vector>
+#include <blaze/math/intrinsics/IntrinsicTrait.h>
+#include <blaze/math/smp/Partition.h>
 #include <blaze/math/solvers/PGS.h>
+#include <blaze/util/Types.h>
 
 
 namespace blaze {
 
+//=================================================================================================
+//
+//  BATCHED PROJECTED GAUSS-SEIDEL
+//
+//=================================================================================================
+
+namespace {
+
+//*************************************************************************************************
+/*!\brief The number of LCPs of the same size that are solved simultaneously.
+//
+// The LCPs are processed in groups of two SIMD vectors, which keeps two independent chains of
+// floating point operations in flight.
+*/
+const size_t lanes( 2UL * IntrinsicTrait<real>::size );
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Projected Gauss-Seidel sweeps for \a L interleaved LCPs of the same size.
+//
+// \param n The size of the LCPs.
+// \param a The interleaved \f$ n \times n \f$ system matrices.
+// \param b The interleaved right-hand side vectors.
+// \param x The interleaved vectors of unknowns.
+// \param d Helper array for the interleaved inverse diagonal elements.
+// \param maxIterations The maximum number of sweeps.
+// \param threshold The precision threshold for the solution.
+// \param relaxation The relaxation parameter.
+// \param precision The resulting maximum change of an unknown during the last sweep.
+// \return The number of performed sweeps.
+//
+// This function solves \a L LCPs of the same size simultaneously. Element \f$ (i,j) \f$ of the
+// system matrix of LCP \a l is stored in \f$ a[(i*n+j)*L+l] \f$, element \a i of the vectors of
+// LCP \a l in \f$ b[i*L+l] \f$ and \f$ x[i*L+l] \f$. Therefore all innermost loops run over the
+// \a L LCPs and are executed by means of SIMD instructions. The sweeps are performed until all
+// \a L LCPs have converged or the maximum number of sweeps is reached.
+*/
+template< size_t L >  // Number of interleaved LCPs
+size_t sweeps( size_t n, const real* a, const real* b, real* x, real* d, size_t maxIterations,
+               real threshold, real relaxation, real& precision )
+{
+   // Precomputing the inverse diagonal elements and projecting the initial solution
+   for( size_t i=0; i<n; ++i ) {
+      for( size_t l=0; l<L; ++l ) {
+         BLAZE_INTERNAL_ASSERT( a[(i*n+i)*L+l] != real(0), "Invalid diagonal element in the LCP matrix" );
+         d[i*L+l] = real(1) / a[(i*n+i)*L+l];
+         x[i*L+l] = max( real(0), x[i*L+l] );
+      }
+   }
+
+   precision = real(0);
+
+   size_t it( 0 );
+
+   while( it < maxIterations )
+   {
+      real rmax[L];
+
+      for( size_t l=0; l<L; ++l )
+         rmax[l] = real(0);
+
+      for( size_t i=0; i<n; ++i )
+      {
+         real residual[L];
+
+         for( size_t l=0; l<L; ++l )
+            residual[l] = -b[i*L+l];
+
+         for( size_t j=0; j<n; ++j ) {
+            for( size_t l=0; l<L; ++l )
+               residual[l] -= a[(i*n+j)*L+l] * x[j*L+l];
+         }
+
+         // Updating and projecting the unknowns
+         for( size_t l=0; l<L; ++l ) {
+            const real xi( max( real(0), x[i*L+l] + relaxation * d[i*L+l] * residual[l] ) );
+            rmax[l] = max( rmax[l], std::fabs( x[i*L+l] - xi ) );
+            x[i*L+l] = xi;
+         }
+      }
+
+      ++it;
+
+      precision = real(0);
+      for( size_t l=0; l<L; ++l )
+         precision = max( precision, rmax[l] );
+
+      if( precision < threshold )
+         break;
+   }
+
+   return it;
+}
+//*************************************************************************************************
+
+} // namespace
+
+
+
+
 //=================================================================================================
 //
 //  CONSTRUCTOR
@@ -39,13 +144,311 @@ namespace blaze {
 /*!\brief The default constructor for the PGS class.
 */
 PGS::PGS()
-   : diagonal_()  // Vector for the diagonal entries of the LCP matrix
+   : diagonal_  ()         // Vector for the diagonal entries of the LCP matrix
+   , xold_      ()         // The unknowns of the previous sweep
+   , jacobi_    ( false )  // Flag for the projected Jacobi mode
+   , relaxation_( 1 )      // The relaxation parameter
+   , offsets_   ()         // The offsets of the colors within the contact list
+   , contacts_  ()         // The list of contacts sorted by color
+   , partial_   ()         // The partial maximum residuals of the parts of a sweep
 {}
 //*************************************************************************************************
 
 
 
 
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Solves all LCPs of the given batch.
+//
+// \param batch The batch of LCPs.
+// \return Returns \a true if all LCPs have been solved sufficiently accurate, otherwise it returns \a false.
+//
+// This function solves all LCPs of the given batch by means of projected Gauss-Seidel sweeps,
+// starting from the given unknowns. The LCPs are grouped by size, and LCPs of the same size are
+// solved simultaneously by means of SIMD instructions (one LCP per SIMD lane). In case the
+// total number of unknowns reaches the SMP_BATCH_THRESHOLD, the groups are solved in parallel.
+// After the solution process, the precision of the solver corresponds to the maximum change
+// of an unknown during the last sweep of any LCP and the number of iterations corresponds to
+// the maximum number of sweeps of any LCP. Note that the Jacobi mode is not applied to batches.
+*/
+bool PGS::solve( Batch<LCP>& batch )
+{
+   lastPrecision_  = real(0);
+   lastIterations_ = 0;
+
+   if( batch.problems() == 0 )
+      return true;
+
+   std::vector<size_t> order, bounds, parts;
+   batch.group( lanes, order, bounds );
+
+   const size_t groups( bounds.size() - 1 );
+
+   // Distributing the groups to the threads
+   std::vector<size_t> work( groups );
+   for( size_t g=0; g<groups; ++g ) {
+      const size_t n( batch.size( order[bounds[g]] ) );
+      work[g] = ( bounds[g+1] - bounds[g] ) * n*n;
+   }
+
+   const size_t threads( ( batch.x_.size() < SMP_BATCH_THRESHOLD )?( 1 ):( getNumThreads() ) );
+   partitionWork( work, threads, parts );
+
+   // Solving the LCPs
+   std::vector<real>   precision ( groups, real(0) );
+   std::vector<size_t> iterations( groups, 0 );
+
+   smpForPartitions( parts, boost::bind( &PGS::batchKernel, this, boost::ref( batch ),
+                                         boost::cref( order ), boost::cref( bounds ),
+                                         &precision[0], &iterations[0], _1, _2 ) );
+
+   for( size_t g=0; g<groups; ++g ) {
+      lastPrecision_  = max( lastPrecision_ , precision[g]  );
+      lastIterations_ = max( lastIterations_, iterations[g] );
+   }
+
+   const bool converged( lastPrecision_ < threshold_ );
+
+   BLAZE_LOG_DEBUG_SECTION( log ) {
+      if( converged )
+         log << "      Solved " << batch.problems() << " complementarity problems in at most " << lastIterations_ << " PGS iterations.";
+      else
+         log << BLAZE_YELLOW << "      WARNING: Did not solve all complementarity problems within accuracy. (" << lastPrecision_ << ")" << BLAZE_OLDCOLOR;
+   }
+
+   return converged;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Colors the contacts of the given contact LCP.
+//
+// \param cp The contact LCP to be colored.
+// \return void
+//
+// This function computes a greedy coloring of the contact graph, in which two contacts are
+// adjacent in case the system matrix couples any of their unknowns. Since the sparsity pattern
+// of the system matrix is not required to be symmetric, a coupling in either direction (i.e. a
+// non-zero element in the rows of the first or of the second contact) makes the two contacts
+// adjacent. Each contact is assigned the smallest color that is not used by any of its already
+// colored neighbors. Subsequently
+// the contacts are sorted by color, where the contacts of a single color retain their natural
+// order. In case the number of unknowns is below the SMP_PGS_THRESHOLD, no coloring is computed
+// and the contacts are updated in their natural order.
+*/
+void PGS::color( const ContactLCP& cp )
+{
+   typedef CMatMxN::ConstIterator  ConstIterator;
+
+   offsets_.clear();
+   contacts_.clear();
+
+   if( cp.size() < SMP_PGS_THRESHOLD )
+      return;
+
+   const size_t N( cp.size() / 3 );
+   const CMatMxN& A( cp.A_ );
+
+   // Setting up the symmetric adjacency lists of the contact graph
+   std::vector<size_t> degrees( N+1, 0 );
+
+   for( size_t i=0; i<N; ++i ) {
+      for( size_t j=i*3; j<i*3+3; ++j ) {
+         const ConstIterator end( A.end(j) );
+         for( ConstIterator element=A.begin(j); element!=end; ++element ) {
+            const size_t k( element->index() / 3 );
+            if( k != i ) {
+               ++degrees[i+1];
+               ++degrees[k+1];
+            }
+         }
+      }
+   }
+
+   for( size_t i=1; i<=N; ++i )
+      degrees[i] += degrees[i-1];
+
+   std::vector<size_t> neighbors( degrees[N] );
+   std::vector<size_t> slots( degrees.begin(), degrees.end()-1 );
+
+   for( size_t i=0; i<N; ++i ) {
+      for( size_t j=i*3; j<i*3+3; ++j ) {
+         const ConstIterator end( A.end(j) );
+         for( ConstIterator element=A.begin(j); element!=end; ++element ) {
+            const size_t k( element->index() / 3 );
+            if( k != i ) {
+               neighbors[slots[i]++] = k;
+               neighbors[slots[k]++] = i;
+            }
+         }
+      }
+   }
+
+   std::vector<size_t> colors( N );
+   std::vector<size_t> used;
+
+   // Greedy coloring of the contact graph
+   for( size_t i=0; i<N; ++i )
+   {
+      for( size_t n=degrees[i]; n<degrees[i+1]; ++n ) {
+         const size_t k( neighbors[n] );
+         if( k < i ) used[colors[k]] = i+1;
+      }
+
+      size_t c( 0 );
+      while( c < used.size() && used[c] == i+1 )
+         ++c;
+
+      if( c == used.size() )
+         used.push_back( 0 );
+
+      colors[i] = c;
+   }
+
+   // Sorting the contacts by color
+   offsets_.resize( used.size()+1, 0 );
+
+   for( size_t i=0; i<N; ++i )
+      ++offsets_[colors[i]+1];
+
+   for( size_t c=1; c<offsets_.size(); ++c )
+      offsets_[c] += offsets_[c-1];
+
+   std::vector<size_t> pos( offsets_.begin(), offsets_.end()-1 );
+   contacts_.resize( N );
+
+   for( size_t i=0; i<N; ++i )
+      contacts_[pos[colors[i]]++] = i;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Kernel for the parallel projected Gauss-Seidel update of the contacts of a color.
+//
+// \param cp The contact LCP to solve.
+// \param begin The index of the first contact of the color within the contact list.
+// \param end One past the index of the last contact of the color within the contact list.
+// \param parts The total number of parts.
+// \param pbegin The first part to be processed.
+// \param pend One past the last part to be processed.
+// \return void
+*/
+void PGS::colorKernel( ContactLCP& cp, size_t begin, size_t end,
+                       size_t parts, size_t pbegin, size_t pend )
+{
+   const size_t count( end - begin );
+
+   for( size_t p=pbegin; p<pend; ++p )
+   {
+      const size_t kend( begin + ( ( p+1 ) * count ) / parts );
+      real rmax( 0 );
+
+      for( size_t k=begin+( p*count )/parts; k<kend; ++k )
+         rmax = max( rmax, updateContact( cp, contacts_[k] ) );
+
+      partial_[p] = rmax;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Kernel for the parallel projected Jacobi update of the contacts.
+//
+// \param cp The contact LCP to solve.
+// \param parts The total number of parts.
+// \param pbegin The first part to be processed.
+// \param pend One past the last part to be processed.
+// \return void
+*/
+void PGS::contactKernel( ContactLCP& cp, size_t parts, size_t pbegin, size_t pend )
+{
+   const size_t N( cp.size() / 3 );
+
+   for( size_t p=pbegin; p<pend; ++p )
+   {
+      const size_t iend( ( ( p+1 ) * N ) / parts );
+      real rmax( 0 );
+
+      for( size_t i=( p*N )/parts; i<iend; ++i )
+         rmax = max( rmax, relaxContact( cp, i ) );
+
+      partial_[p] = rmax;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Solves a range of groups of LCPs of a batch.
+//
+// \param batch The batch of LCPs.
+// \param order The order of the LCPs (see Batch::group()).
+// \param bounds The bounds of the groups of LCPs (see Batch::group()).
+// \param precision The resulting precision of each group.
+// \param iterations The resulting number of sweeps of each group.
+// \param begin The first group to be solved.
+// \param end One past the last group to be solved.
+// \return void
+*/
+void PGS::batchKernel( Batch<LCP>& batch, const std::vector<size_t>& order,
+                       const std::vector<size_t>& bounds, real* precision, size_t* iterations,
+                       size_t begin, size_t end ) const
+{
+   if( begin == end ) return;
+
+   const size_t nmax( batch.size( order[bounds[end]-1] ) );
+
+   std::vector<real> a( nmax*nmax*lanes ), b( nmax*lanes ), x( nmax*lanes ), d( nmax*lanes );
+
+   for( size_t g=begin; g<end; ++g )
+   {
+      const size_t first( bounds[g] );
+      const size_t count( bounds[g+1] - first );
+      const size_t n    ( batch.size( order[first] ) );
+
+      // Interleaving the LCPs of the group
+      for( size_t l=0; l<count; ++l ) {
+         const real* const Ak( batch.A( order[first+l] ) );
+         const real* const bk( batch.b( order[first+l] ) );
+         const real* const xk( batch.x( order[first+l] ) );
+         for( size_t i=0; i<n*n; ++i )
+            a[i*count+l] = Ak[i];
+         for( size_t i=0; i<n; ++i ) {
+            b[i*count+l] = bk[i];
+            x[i*count+l] = xk[i];
+         }
+      }
+
+      // Solving the LCPs of the group
+      if( count == lanes )
+         iterations[g] = sweeps<lanes>( n, &a[0], &b[0], &x[0], &d[0], maxIterations_,
+                                        threshold_, relaxation_, precision[g] );
+      else
+         iterations[g] = sweeps<1>( n, &a[0], &b[0], &x[0], &d[0], maxIterations_,
+                                    threshold_, relaxation_, precision[g] );
+
+      // Storing the solutions
+      for( size_t l=0; l<count; ++l ) {
+         real* const xk( batch.x( order[first+l] ) );
+         for( size_t i=0; i<n; ++i )
+            xk[i] = x[i*count+l];
+      }
+   }
+}
+//*************************************************************************************************
+
+
+
+
 //=================================================================================================
 //
 //  EXPLICIT TEMPLATE INSTANTIATIONS
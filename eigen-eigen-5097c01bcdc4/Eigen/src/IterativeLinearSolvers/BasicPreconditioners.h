@@ -12,6 +12,31 @@
 
 namespace Eigen { 
 
+namespace internal {
+
+// inverts the diagonal entries of mat, the missing ones being set to zero. Matrix-free operators, which have no
+// inner iterators, specialize it.
+template<typename MatType>
+struct diagonal_preconditioner_inverse
+{
+  template<typename Vector>
+  static void run(const MatType& mat, Vector& invdiag)
+  {
+    typedef typename Vector::Scalar Scalar;
+    for(int j=0; j<mat.outerSize(); ++j)
+    {
+      typename MatType::InnerIterator it(mat,j);
+      while(it && it.index()!=j) ++it;
+      if(it && it.index()==j)
+        invdiag(j) = Scalar(1)/it.value();
+      else
+        invdiag(j) = 0;
+    }
+  }
+};
+
+}
+
 /** \ingroup IterativeLinearSolvers_Module
   * \brief A preconditioner based on the digonal entries
   *
@@ -61,15 +86,7 @@ class DiagonalPreconditioner
     DiagonalPreconditioner& factorize(const MatType& mat)
     {
       m_invdiag.resize(mat.cols());
-      for(int j=0; j<mat.outerSize(); ++j)
-      {
-        typename MatType::InnerIterator it(mat,j);
-        while(it && it.index()!=j) ++it;
-        if(it && it.index()==j)
-          m_invdiag(j) = Scalar(1)/it.value();
-        else
-          m_invdiag(j) = 0;
-      }
+      internal::diagonal_preconditioner_inverse<MatType>::run(mat, m_invdiag);
       m_isInitialized = true;
       return *this;
     }
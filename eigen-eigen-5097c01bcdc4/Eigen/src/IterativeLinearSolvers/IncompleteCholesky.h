@@ -0,0 +1,411 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_INCOMPLETE_CHOLESKY_H
+#define EIGEN_INCOMPLETE_CHOLESKY_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Maps the coefficient (r,c) of a square matrix to the coefficient of a row-major factor F: the whole matrix is
+  * used if \a UpLo is zero, otherwise only its \a UpLo triangular part, the upper part being stored transposed in
+  * the lower triangular factor. \returns false if the coefficient is not used. */
+template<int UpLo, typename Index, typename Scalar>
+inline bool incomplete_factor_map(Index& r, Index& c, Scalar& v)
+{
+  using std::swap;
+  if(UpLo==Lower)
+    return r>=c;
+  if(UpLo==Upper)
+  {
+    if(r>c)
+      return false;
+    swap(r,c);
+    v = internal::conj(v);
+  }
+  return true;
+}
+
+/** \internal
+  * Builds the row-major pattern of the coefficients of \a mat mapped by incomplete_factor_map<UpLo>(), with the
+  * diagonal coefficients always stored, and sets their values to zero. */
+template<int UpLo, typename MatrixType, typename FactorType>
+void incomplete_factor_pattern(const MatrixType& mat, FactorType& factor)
+{
+  typedef typename FactorType::Index Index;
+  typedef typename FactorType::Scalar Scalar;
+  eigen_assert(mat.rows()==mat.cols() && "the incomplete factorizations require a square matrix");
+  const Index n = mat.rows();
+
+  // count the coefficients of each row, the missing diagonal coefficients being added
+  Matrix<Index,Dynamic,1> count = Matrix<Index,Dynamic,1>::Ones(n);
+  for(Index j=0; j<mat.outerSize(); ++j)
+    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+    {
+      Index r = it.row(), c = it.col();
+      typename MatrixType::Scalar v = it.value();
+      if(r!=c && incomplete_factor_map<UpLo>(r,c,v))
+        ++count[r];
+    }
+
+  factor.resize(n,n);
+  factor.resizeNonZeros(count.sum());
+  Index* outer = factor.outerIndexPtr();
+  Index* inner = factor.innerIndexPtr();
+  outer[0] = 0;
+  for(Index i=0; i<n; ++i)
+  {
+    outer[i+1] = outer[i] + count[i];
+    inner[outer[i]] = i;
+    count[i] = outer[i]+1;
+  }
+  for(Index j=0; j<mat.outerSize(); ++j)
+    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+    {
+      Index r = it.row(), c = it.col();
+      typename MatrixType::Scalar v = it.value();
+      if(r!=c && incomplete_factor_map<UpLo>(r,c,v))
+        inner[count[r]++] = c;
+    }
+  for(Index i=0; i<n; ++i)
+    std::sort(inner+outer[i], inner+outer[i+1]);
+  Map<Matrix<Scalar,Dynamic,1> >(factor.valuePtr(), factor.nonZeros()).setZero();
+}
+
+/** \internal
+  * Copies the values of \a mat mapped by incomplete_factor_map<UpLo>() into the fixed pattern of \a factor, whose
+  * other coefficients are set to zero. The outer vectors of \a mat are copied in parallel: each coefficient has its
+  * own position in the factor.
+  * \returns false if the pattern of \a factor does not contain the one of \a mat, i.e., if the pattern of the
+  * matrix has changed since the analysis. The values of \a factor are then meaningless. */
+template<int UpLo, typename MatrixType, typename FactorType>
+bool incomplete_factor_refill(const MatrixType& mat, FactorType& factor)
+{
+  typedef typename FactorType::Index Index;
+  typedef typename FactorType::Scalar Scalar;
+  if(mat.rows()!=factor.rows() || mat.cols()!=factor.cols())
+    return false;
+  const Index* outer = factor.outerIndexPtr();
+  const Index* inner = factor.innerIndexPtr();
+  Scalar* values = factor.valuePtr();
+  Map<Matrix<Scalar,Dynamic,1> >(values, factor.nonZeros()).setZero();
+
+  const Index outerSize = mat.outerSize();
+  const Index threads = sparse_product_threads<Index>(outerSize, factor.nonZeros());
+  EIGEN_UNUSED_VARIABLE(threads);
+  bool ok = true;
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel for schedule(static) num_threads(threads) if(threads>1) reduction(&&:ok)
+#endif
+  for(Index j=0; j<outerSize; ++j)
+    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+    {
+      Index r = it.row(), c = it.col();
+      Scalar v = it.value();
+      if(incomplete_factor_map<UpLo>(r,c,v))
+      {
+        const Index* p = std::lower_bound(inner+outer[r], inner+outer[r+1], c);
+        if(p==inner+outer[r+1] || *p!=c)
+        {
+          ok = false;
+          break;
+        }
+        values[p-inner] = v;
+      }
+    }
+  return ok;
+}
+
+/** \internal
+  * Factorizes the rows of a row-major factor one after the other, or level by level following the schedule \a s
+  * of its lower triangular part, the rows of each level being factorized concurrently. The functor \a rowFactor
+  * is called as rowFactor(i, pos), where pos is a per thread workspace of size n filled with -1, which must be
+  * restored by the functor. */
+template<typename Index, typename RowFactor>
+void incomplete_factor_rows(const sparse_level_schedule<Index>& s, Index n, const RowFactor& rowFactor)
+{
+  if(!s.enabled)
+  {
+    Matrix<Index,Dynamic,1> pos = Matrix<Index,Dynamic,1>::Constant(n, -1);
+    for(Index i=0; i<n; ++i)
+      rowFactor(i, pos.data());
+    return;
+  }
+  const Index nlevels = s.levels();
+#ifdef EIGEN_HAS_OPENMP
+  Index threads = nbThreads();
+  #pragma omp parallel num_threads(threads) if(threads>1)
+#endif
+  {
+    Matrix<Index,Dynamic,1> pos = Matrix<Index,Dynamic,1>::Constant(n, -1);
+    for(Index l=0; l<nlevels; ++l)
+    {
+      const Index begin = s.levelPtr[l], end = s.levelPtr[l+1];
+#ifdef EIGEN_HAS_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for(Index k=begin; k<end; ++k)
+        rowFactor(s.rows[k], pos.data());
+    }
+  }
+}
+
+/** \internal Computes the row \a i of the incomplete Cholesky factor L, stored row-major with sorted rows. */
+template<typename FactorType>
+struct incomplete_cholesky_row
+{
+  typedef typename FactorType::Index Index;
+  typedef typename FactorType::Scalar Scalar;
+  typedef typename FactorType::RealScalar RealScalar;
+
+  incomplete_cholesky_row(FactorType& L)
+    : outer(L.outerIndexPtr()), inner(L.innerIndexPtr()), values(L.valuePtr()) {}
+
+  void operator()(Index i, Index* pos) const
+  {
+    const Index diag = outer[i+1]-1;
+    for(Index p=outer[i]; p<diag; ++p)
+      pos[inner[p]] = p;
+    RealScalar d = internal::real(values[diag]);
+    for(Index p=outer[i]; p<diag; ++p)
+    {
+      // L(i,k) = (A(i,k) - sum_{j<k} L(i,j) conj(L(k,j))) / L(k,k)
+      const Index k = inner[p];
+      const Index kdiag = outer[k+1]-1;
+      Scalar s = values[p];
+      for(Index q=outer[k]; q<kdiag; ++q)
+      {
+        const Index pj = pos[inner[q]];
+        if(pj>=0)
+          s -= values[pj] * internal::conj(values[q]);
+      }
+      s /= internal::real(values[kdiag]);
+      values[p] = s;
+      d -= internal::abs2(s);
+    }
+    for(Index p=outer[i]; p<diag; ++p)
+      pos[inner[p]] = -1;
+    // a non positive pivot is kept as is, and reported by the caller
+    values[diag] = d>RealScalar(0) ? Scalar(std::sqrt(d)) : Scalar(d);
+  }
+
+  const Index* outer;
+  const Index* inner;
+  Scalar* values;
+};
+
+} // end namespace internal
+
+/** \ingroup IterativeLinearSolvers_Module
+  * \brief Incomplete Cholesky factorization with zero fill-in, IC(0)
+  *
+  * This preconditioner computes a lower triangular factor L, having the pattern of the lower triangular part of
+  * the selfadjoint matrix A, such that L L^* matches A on this pattern. It is meant to be used with
+  * ConjugateGradient:
+  * \code
+  * ConjugateGradient<SparseMatrix<double>, Lower, IncompleteCholesky<double> > cg;
+  * x = cg.compute(A).solve(b);
+  * \endcode
+  *
+  * \tparam _Scalar the type of the scalar
+  * \tparam _UpLo the triangular part of the matrix which is used, Lower or Upper. It must be the one used by the solver.
+  *
+  * The symbolic analysis, i.e., the pattern of L and the level schedule of its rows, is computed once by
+  * analyzePattern(), and reused by each factorize() of a matrix having the same pattern. The rows of a level only
+  * depend on the rows of the previous levels: they are factorized concurrently by the OpenMP threads, and the
+  * triangular solves applying the preconditioner are level scheduled as well (see SparseTriangularLevelSolver).
+  * The parallelism thus depends on the ordering of the matrix: the natural ordering of a mesh, or a nested
+  * dissection ordering, yield wide levels, while a banded ordering such as RCM yields sequential factorizations.
+  *
+  * The incomplete factorization of a symmetric positive definite matrix may break down on a non positive pivot. In
+  * that case the factorization is restarted on A + shift diag(A), the shift starting at initialShift() and being
+  * doubled until it succeeds.
+  *
+  * \sa IncompleteLUK, IncompleteLUT, ConjugateGradient
+  */
+template<typename _Scalar, int _UpLo = Lower>
+class IncompleteCholesky : internal::noncopyable
+{
+    typedef _Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef SparseMatrix<Scalar,RowMajor> FactorType;
+    typedef typename FactorType::Index Index;
+
+  public:
+    typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+    enum { UpLo = _UpLo };
+
+    IncompleteCholesky()
+      : m_initialShift(RealScalar(1e-3)), m_shift(0), m_analysisIsOk(false), m_factorizationIsOk(false),
+        m_isInitialized(false), m_levelsOk(false)
+    {}
+
+    template<typename MatType>
+    IncompleteCholesky(const MatType& mat)
+      : m_initialShift(RealScalar(1e-3)), m_shift(0), m_analysisIsOk(false), m_factorizationIsOk(false),
+        m_isInitialized(false), m_levelsOk(false)
+    {
+      compute(mat);
+    }
+
+    Index rows() const { return m_L.rows(); }
+    Index cols() const { return m_L.cols(); }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if computation was succesful,
+      *          \c NumericalIssue if no positive shift allowed to complete the factorization,
+      *          \c InvalidInput if the pattern of the matrix differs from the one given to analyzePattern().
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "IncompleteCholesky is not initialized.");
+      return m_info;
+    }
+
+    /** Computes the pattern of the factor and the level schedules of its rows from the pattern of \a mat */
+    template<typename MatType>
+    IncompleteCholesky& analyzePattern(const MatType& mat)
+    {
+      internal::incomplete_factor_pattern<UpLo>(mat, m_L);
+      internal::sparse_level_schedule_analyze<Index>(m_L.rows(), m_L.outerIndexPtr(), m_L.innerIndexPtr(), true, true,
+                                                     m_levels.minLevelWidth(), m_schedule);
+      m_levels.analyzePattern(m_L, true);
+      m_analysisIsOk = true;
+      m_factorizationIsOk = false;
+      return *this;
+    }
+
+    /** Computes the incomplete factor of \a mat, which must have the pattern given to analyzePattern(),
+      * otherwise info() returns \c InvalidInput */
+    template<typename MatType>
+    IncompleteCholesky& factorize(const MatType& mat)
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      const Index n = m_L.rows();
+      m_shift = 0;
+      m_info = NumericalIssue;
+      m_isInitialized = true;
+      for(int attempt=0; attempt<32; ++attempt)
+      {
+        if(!internal::incomplete_factor_refill<UpLo>(mat, m_L))
+        {
+          m_info = InvalidInput;
+          m_factorizationIsOk = false;
+          return *this;
+        }
+        if(m_shift>RealScalar(0))
+          for(Index i=0; i<n; ++i)
+          {
+            Scalar& d = m_L.valuePtr()[m_L.outerIndexPtr()[i+1]-1];
+            d += m_shift * (d==Scalar(0) ? RealScalar(1) : internal::abs(d));
+          }
+        internal::incomplete_factor_rows(m_schedule, n, internal::incomplete_cholesky_row<FactorType>(m_L));
+        bool ok = true;
+        for(Index i=0; i<n && ok; ++i)
+          ok = internal::real(m_L.valuePtr()[m_L.outerIndexPtr()[i+1]-1]) > RealScalar(0);
+        if(ok)
+        {
+          m_info = Success;
+          break;
+        }
+        m_shift = m_shift==RealScalar(0) ? m_initialShift : RealScalar(2)*m_shift;
+      }
+      m_levelsOk = nbThreads()>1;
+      m_factorizationIsOk = true;
+      m_isInitialized = true;
+      return *this;
+    }
+
+    /** Computes the incomplete Cholesky factorization of \a mat */
+    template<typename MatType>
+    IncompleteCholesky& compute(const MatType& mat)
+    {
+      analyzePattern(mat);
+      return factorize(mat);
+    }
+
+    /** Sets the first diagonal shift tried when the factorization breaks down (default is 1e-3) */
+    IncompleteCholesky& setInitialShift(RealScalar shift)
+    {
+      m_initialShift = shift;
+      return *this;
+    }
+
+    /** \returns the first diagonal shift tried when the factorization breaks down */
+    RealScalar initialShift() const { return m_initialShift; }
+
+    /** \returns the relative diagonal shift used by the last factorization, zero if it did not break down */
+    RealScalar shift() const { return m_shift; }
+
+    /** \returns the lower triangular factor L, stored row-major */
+    const FactorType& matrixL() const
+    {
+      eigen_assert(m_factorizationIsOk && "IncompleteCholesky is not initialized.");
+      return m_L;
+    }
+
+    template<typename Rhs, typename Dest>
+    void _solve(const Rhs& b, Dest& x) const
+    {
+      x = b;
+      if(m_levelsOk)
+      {
+        m_levels.template solveInPlace<Lower>(m_L, x);
+        m_levels.template adjointSolveInPlace<Lower>(m_L, x);
+      }
+      else
+      {
+        m_L.template triangularView<Lower>().solveInPlace(x);
+        m_L.adjoint().template triangularView<Upper>().solveInPlace(x);
+      }
+    }
+
+    template<typename Rhs> inline const internal::solve_retval<IncompleteCholesky, Rhs>
+    solve(const MatrixBase<Rhs>& b) const
+    {
+      eigen_assert(m_isInitialized && "IncompleteCholesky is not initialized.");
+      eigen_assert(cols()==b.rows()
+                && "IncompleteCholesky::solve(): invalid number of rows of the right hand side matrix b");
+      return internal::solve_retval<IncompleteCholesky, Rhs>(*this, b.derived());
+    }
+
+  protected:
+    FactorType m_L;
+    RealScalar m_initialShift;
+    RealScalar m_shift;
+    bool m_analysisIsOk;
+    bool m_factorizationIsOk;
+    bool m_isInitialized;
+    ComputationInfo m_info;
+    internal::sparse_level_schedule<Index> m_schedule;      // level schedule of the factorization
+    SparseTriangularLevelSolver<FactorType,Lower> m_levels;  // level schedules of the solves with L and L^*
+    bool m_levelsOk;
+};
+
+namespace internal {
+
+template<typename _Scalar, int _UpLo, typename Rhs>
+struct solve_retval<IncompleteCholesky<_Scalar,_UpLo>, Rhs>
+  : solve_retval_base<IncompleteCholesky<_Scalar,_UpLo>, Rhs>
+{
+  typedef IncompleteCholesky<_Scalar,_UpLo> Dec;
+  EIGEN_MAKE_SOLVE_HELPERS(Dec,Rhs)
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    dec()._solve(rhs(),dst);
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_INCOMPLETE_CHOLESKY_H
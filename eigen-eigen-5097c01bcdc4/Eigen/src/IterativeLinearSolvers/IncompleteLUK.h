@@ -0,0 +1,320 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_INCOMPLETE_LUK_H
+#define EIGEN_INCOMPLETE_LUK_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Symbolic ILU(k): computes the pattern of the factors of the row-major pattern \a factor, whose rows are sorted
+  * and hold their diagonal coefficient, keeping the fill-ins whose level is at most \a fillLevel. The level of the
+  * coefficients of the matrix is zero, and the fill-in created by the elimination of L(i,k) with U(k,j) has the
+  * level lev(i,k) + lev(k,j) + 1. The rows are built one after the other as sorted linked lists. */
+template<typename FactorType>
+void incomplete_luk_symbolic(FactorType& factor, int fillLevel)
+{
+  typedef typename FactorType::Index Index;
+  typedef typename FactorType::Scalar Scalar;
+  const Index n = factor.rows();
+  const Index* outer = factor.outerIndexPtr();
+  const Index* inner = factor.innerIndexPtr();
+
+  std::vector<Index> rowPtr(n+1), cols, levels;
+  std::vector<Index> diag(n);
+  cols.reserve(factor.nonZeros()*2);
+  levels.reserve(factor.nonZeros()*2);
+  Matrix<Index,Dynamic,1> next(n+1), lev = Matrix<Index,Dynamic,1>::Constant(n, -1);
+  const Index end = n;          // end of the lists
+  rowPtr[0] = 0;
+  for(Index i=0; i<n; ++i)
+  {
+    // the list of the row i starts with the pattern of the matrix
+    Index head = end, last = end;
+    for(Index p=outer[i]; p<outer[i+1]; ++p)
+    {
+      Index j = inner[p];
+      lev[j] = 0;
+      next[j] = end;
+      if(last==end) head = j;
+      else          next[last] = j;
+      last = j;
+    }
+    // eliminate the columns k<i in increasing order, the new fill-ins being inserted after k
+    for(Index k=head; k<i; k=next[k])
+    {
+      Index prev = k;
+      for(Index q=diag[k]+1; q<rowPtr[k+1]; ++q)
+      {
+        const Index j = cols[q];
+        const Index l = lev[k] + levels[q] + 1;
+        if(l>fillLevel)
+          continue;
+        if(lev[j]>=0)
+        {
+          lev[j] = (std::min)(lev[j], l);
+          continue;
+        }
+        // the columns of the row k are increasing: the search starts after the previous insertion
+        while(next[prev]<j) prev = next[prev];
+        next[j] = next[prev];
+        next[prev] = j;
+        lev[j] = l;
+        prev = j;
+      }
+    }
+    for(Index j=head; j!=end; j=next[j])
+    {
+      if(j==i) diag[i] = Index(cols.size());
+      cols.push_back(j);
+      levels.push_back(lev[j]);
+      lev[j] = -1;
+    }
+    rowPtr[i+1] = Index(cols.size());
+  }
+
+  factor.resizeNonZeros(Index(cols.size()));
+  std::copy(rowPtr.begin(), rowPtr.end(), factor.outerIndexPtr());
+  std::copy(cols.begin(), cols.end(), factor.innerIndexPtr());
+  Map<Matrix<Scalar,Dynamic,1> >(factor.valuePtr(), factor.nonZeros()).setZero();
+}
+
+/** \internal Computes the row \a i of the incomplete factors L and U, stored together row-major with sorted rows,
+  * the unit diagonal of L being implicit. The positions of the diagonal coefficients are given by \a diag. */
+template<typename FactorType>
+struct incomplete_lu_row
+{
+  typedef typename FactorType::Index Index;
+  typedef typename FactorType::Scalar Scalar;
+
+  incomplete_lu_row(FactorType& lu, const Index* diag)
+    : outer(lu.outerIndexPtr()), inner(lu.innerIndexPtr()), values(lu.valuePtr()), diag(diag) {}
+
+  void operator()(Index i, Index* pos) const
+  {
+    for(Index p=outer[i]; p<outer[i+1]; ++p)
+      pos[inner[p]] = p;
+    for(Index p=outer[i]; p<diag[i]; ++p)
+    {
+      // L(i,k) = A(i,k) / U(k,k), and the row k of U is eliminated from the row i, restricted to its pattern
+      const Index k = inner[p];
+      const Scalar l = values[p] / values[diag[k]];
+      values[p] = l;
+      for(Index q=diag[k]+1; q<outer[k+1]; ++q)
+      {
+        const Index pj = pos[inner[q]];
+        if(pj>=0)
+          values[pj] -= l * values[q];
+      }
+    }
+    for(Index p=outer[i]; p<outer[i+1]; ++p)
+      pos[inner[p]] = -1;
+  }
+
+  const Index* outer;
+  const Index* inner;
+  Scalar* values;
+  const Index* diag;
+};
+
+} // end namespace internal
+
+/** \ingroup IterativeLinearSolvers_Module
+  * \brief Incomplete LU factorization with level of fill, ILU(k)
+  *
+  * This preconditioner computes the factors L and U of A restricted to a static pattern: the pattern of A, plus
+  * the fill-ins of level at most fillLevel(). ILU(0) thus keeps the pattern of A, and each level adds the fill-ins
+  * created by the elimination of the previous ones. It is meant to be used with BiCGSTAB:
+  * \code
+  * BiCGSTAB<SparseMatrix<double>, IncompleteLUK<double> > solver;
+  * solver.preconditioner().setFillLevel(1);
+  * x = solver.compute(A).solve(b);
+  * \endcode
+  *
+  * Unlike IncompleteLUT, whose pattern depends on the values, the pattern of the factors only depends on the one
+  * of A. It is computed once by analyzePattern(), together with the level schedule of the rows, and reused by each
+  * factorize() of a matrix having the same pattern. The rows of a level only depend on the rows of the previous
+  * levels: they are factorized concurrently by the OpenMP threads, and the triangular solves applying the
+  * preconditioner are level scheduled as well (see SparseTriangularLevelSolver). The parallelism thus depends on the
+  * ordering of the matrix, and decreases with the level of fill.
+  *
+  * No pivoting is done: the factorization fails with \c NumericalIssue on a zero pivot.
+  *
+  * \sa IncompleteCholesky, IncompleteLUT, BiCGSTAB
+  */
+template<typename _Scalar>
+class IncompleteLUK : internal::noncopyable
+{
+    typedef _Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef SparseMatrix<Scalar,RowMajor> FactorType;
+    typedef typename FactorType::Index Index;
+
+  public:
+    typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+
+    IncompleteLUK()
+      : m_fillLevel(0), m_analysisIsOk(false), m_factorizationIsOk(false), m_isInitialized(false), m_levelsOk(false)
+    {}
+
+    template<typename MatType>
+    IncompleteLUK(const MatType& mat, int fillLevel = 0)
+      : m_fillLevel(fillLevel), m_analysisIsOk(false), m_factorizationIsOk(false), m_isInitialized(false), m_levelsOk(false)
+    {
+      compute(mat);
+    }
+
+    Index rows() const { return m_lu.rows(); }
+    Index cols() const { return m_lu.cols(); }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if computation was succesful,
+      *          \c NumericalIssue if a zero pivot has been met,
+      *          \c InvalidInput if the pattern of the matrix differs from the one given to analyzePattern().
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "IncompleteLUK is not initialized.");
+      return m_info;
+    }
+
+    /** Sets the maximal level of the fill-ins kept in the factors (default is 0). It must be set before analyzePattern(). */
+    IncompleteLUK& setFillLevel(int fillLevel)
+    {
+      m_fillLevel = fillLevel;
+      return *this;
+    }
+
+    /** \returns the maximal level of the fill-ins kept in the factors */
+    int fillLevel() const { return m_fillLevel; }
+
+    /** Computes the pattern of the factors and the level schedules of their rows from the pattern of \a mat */
+    template<typename MatType>
+    IncompleteLUK& analyzePattern(const MatType& mat)
+    {
+      internal::incomplete_factor_pattern<0>(mat, m_lu);
+      if(m_fillLevel>0)
+        internal::incomplete_luk_symbolic(m_lu, m_fillLevel);
+      const Index n = m_lu.rows();
+      internal::sparse_level_schedule_analyze<Index>(n, m_lu.outerIndexPtr(), m_lu.innerIndexPtr(), true, true,
+                                                     m_lowerLevels.minLevelWidth(), m_schedule);
+      m_diag.resize(n);
+      for(Index i=0; i<n; ++i)
+        m_diag[i] = Index(std::lower_bound(m_lu.innerIndexPtr()+m_lu.outerIndexPtr()[i],
+                                           m_lu.innerIndexPtr()+m_lu.outerIndexPtr()[i+1], i) - m_lu.innerIndexPtr());
+      m_lowerLevels.analyzePattern(m_lu);
+      m_upperLevels.analyzePattern(m_lu);
+      m_analysisIsOk = true;
+      m_factorizationIsOk = false;
+      return *this;
+    }
+
+    /** Computes the incomplete factors of \a mat, which must have the pattern given to analyzePattern(),
+      * otherwise info() returns \c InvalidInput */
+    template<typename MatType>
+    IncompleteLUK& factorize(const MatType& mat)
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      const Index n = m_lu.rows();
+      m_isInitialized = true;
+      if(!internal::incomplete_factor_refill<0>(mat, m_lu))
+      {
+        m_info = InvalidInput;
+        m_factorizationIsOk = false;
+        return *this;
+      }
+      internal::incomplete_factor_rows(m_schedule, n, internal::incomplete_lu_row<FactorType>(m_lu, m_diag.data()));
+      m_info = Success;
+      for(Index i=0; i<n; ++i)
+        if(!(internal::abs(m_lu.valuePtr()[m_diag[i]]) > RealScalar(0)))
+        {
+          m_info = NumericalIssue;
+          break;
+        }
+      m_levelsOk = nbThreads()>1;
+      m_factorizationIsOk = true;
+      m_isInitialized = true;
+      return *this;
+    }
+
+    /** Computes the incomplete LU factorization of \a mat */
+    template<typename MatType>
+    IncompleteLUK& compute(const MatType& mat)
+    {
+      analyzePattern(mat);
+      return factorize(mat);
+    }
+
+    /** \returns the factors L and U, stored together row-major, the unit diagonal of L being implicit */
+    const FactorType& matrixLU() const
+    {
+      eigen_assert(m_factorizationIsOk && "IncompleteLUK is not initialized.");
+      return m_lu;
+    }
+
+    template<typename Rhs, typename Dest>
+    void _solve(const Rhs& b, Dest& x) const
+    {
+      x = b;
+      if(m_levelsOk)
+      {
+        m_lowerLevels.template solveInPlace<UnitLower>(m_lu, x);
+        m_upperLevels.template solveInPlace<Upper>(m_lu, x);
+      }
+      else
+      {
+        m_lu.template triangularView<UnitLower>().solveInPlace(x);
+        m_lu.template triangularView<Upper>().solveInPlace(x);
+      }
+    }
+
+    template<typename Rhs> inline const internal::solve_retval<IncompleteLUK, Rhs>
+    solve(const MatrixBase<Rhs>& b) const
+    {
+      eigen_assert(m_isInitialized && "IncompleteLUK is not initialized.");
+      eigen_assert(cols()==b.rows()
+                && "IncompleteLUK::solve(): invalid number of rows of the right hand side matrix b");
+      return internal::solve_retval<IncompleteLUK, Rhs>(*this, b.derived());
+    }
+
+  protected:
+    FactorType m_lu;
+    int m_fillLevel;
+    bool m_analysisIsOk;
+    bool m_factorizationIsOk;
+    bool m_isInitialized;
+    ComputationInfo m_info;
+    Matrix<Index,Dynamic,1> m_diag;                          // positions of the diagonal coefficients
+    internal::sparse_level_schedule<Index> m_schedule;      // level schedule of the factorization
+    SparseTriangularLevelSolver<FactorType,Lower> m_lowerLevels;  // level schedules of the solves with L and U
+    SparseTriangularLevelSolver<FactorType,Upper> m_upperLevels;
+    bool m_levelsOk;
+};
+
+namespace internal {
+
+template<typename _Scalar, typename Rhs>
+struct solve_retval<IncompleteLUK<_Scalar>, Rhs>
+  : solve_retval_base<IncompleteLUK<_Scalar>, Rhs>
+{
+  typedef IncompleteLUK<_Scalar> Dec;
+  EIGEN_MAKE_SOLVE_HELPERS(Dec,Rhs)
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    dec()._solve(rhs(),dst);
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_INCOMPLETE_LUK_H
@@ -55,13 +55,13 @@ class IncompleteLUT : internal::noncopyable
     
     IncompleteLUT()
       : m_droptol(NumTraits<Scalar>::dummy_precision()), m_fillfactor(10),
-        m_analysisIsOk(false), m_factorizationIsOk(false), m_isInitialized(false)
+        m_analysisIsOk(false), m_factorizationIsOk(false), m_isInitialized(false), m_levelsOk(false)
     {}
     
     template<typename MatrixType>
     IncompleteLUT(const MatrixType& mat, RealScalar droptol=NumTraits<Scalar>::dummy_precision(), int fillfactor = 10)
       : m_droptol(droptol),m_fillfactor(fillfactor),
-        m_analysisIsOk(false),m_factorizationIsOk(false),m_isInitialized(false)
+        m_analysisIsOk(false),m_factorizationIsOk(false),m_isInitialized(false),m_levelsOk(false)
     {
       eigen_assert(fillfactor != 0);
       compute(mat); 
@@ -110,8 +110,16 @@ class IncompleteLUT : internal::noncopyable
     void _solve(const Rhs& b, Dest& x) const
     {
       x = m_Pinv * b;  
-      x = m_lu.template triangularView<UnitLower>().solve(x);
-      x = m_lu.template triangularView<Upper>().solve(x);
+      if(m_levelsOk)
+      {
+        m_lowerLevels.template solveInPlace<UnitLower>(m_lu, x);
+        m_upperLevels.template solveInPlace<Upper>(m_lu, x);
+      }
+      else
+      {
+        x = m_lu.template triangularView<UnitLower>().solve(x);
+        x = m_lu.template triangularView<Upper>().solve(x);
+      }
       x = m_P * x; 
     }
 
@@ -149,6 +157,9 @@ protected:
     ComputationInfo m_info;
     PermutationMatrix<Dynamic,Dynamic,Index> m_P;     // Fill-reducing permutation
     PermutationMatrix<Dynamic,Dynamic,Index> m_Pinv;  // Inverse permutation
+    SparseTriangularLevelSolver<FactorType,Lower> m_lowerLevels;  // level schedules of the factors for multithreaded solves
+    SparseTriangularLevelSolver<FactorType,Upper> m_upperLevels;
+    bool m_levelsOk;
 };
 
 /**
@@ -439,6 +450,14 @@ void IncompleteLUT<Scalar>::factorize(const _MatrixType& amat)
   m_lu.finalize();
   m_lu.makeCompressed();
 
+  // the pattern of the factors depends on the values, the level schedules are recomputed at each factorization
+  m_levelsOk = nbThreads()>1;
+  if(m_levelsOk)
+  {
+    m_lowerLevels.analyzePattern(m_lu);
+    m_upperLevels.analyzePattern(m_lu);
+  }
+
   m_factorizationIsOk = true;
   m_info = Success;
 }
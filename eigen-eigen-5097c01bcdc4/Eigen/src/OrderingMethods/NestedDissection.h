@@ -0,0 +1,509 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSE_NESTED_DISSECTION_H
+#define EIGEN_SPARSE_NESTED_DISSECTION_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Weighted undirected graph in compressed adjacency form, as used by the multilevel bisection.
+  * The adjacency lists do not contain self loops. */
+template<typename Index>
+struct nd_graph
+{
+  std::vector<Index> xadj;    // adjacency list of the vertex v is adjncy[xadj[v]:xadj[v+1]]
+  std::vector<Index> adjncy;
+  std::vector<Index> adjwgt;  // edge weights
+  std::vector<Index> vwgt;    // vertex weights
+  Index tvwgt;                // total vertex weight
+  Index size() const { return Index(xadj.size())-1; }
+};
+
+/** \internal small deterministic pseudo random generator, \returns a value in [0,range) */
+template<typename Index>
+inline Index nd_rand(unsigned int& state, Index range)
+{
+  state = state * 1103515245u + 12345u;
+  return Index((state >> 8) % static_cast<unsigned int>(range));
+}
+
+/** \internal
+  * Coarsens \a g by a heavy edge matching visited in random order.
+  * On exit \a cmap[v] is the vertex of \a cg which the vertex \a v of \a g has been collapsed into. */
+template<typename Index>
+void nd_coarsen(const nd_graph<Index>& g, nd_graph<Index>& cg, std::vector<Index>& cmap, unsigned int& state)
+{
+  const Index n = g.size();
+  std::vector<Index> match(n, -1), visit(n), rep;
+  cmap.resize(n);
+  rep.reserve(n);
+  for(Index v = 0; v < n; ++v) visit[v] = v;
+  for(Index v = n-1; v > 0; --v) std::swap(visit[v], visit[nd_rand(state, v+1)]);
+
+  Index cn = 0;
+  for(Index k = 0; k < n; ++k)
+  {
+    Index v = visit[k];
+    if(match[v] != -1) continue;
+    Index best = v, bestw = -1;
+    for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+    {
+      Index u = g.adjncy[p];
+      if(match[u] == -1 && g.adjwgt[p] > bestw)
+      {
+        best = u;
+        bestw = g.adjwgt[p];
+      }
+    }
+    match[v] = best;
+    match[best] = v;
+    cmap[v] = cmap[best] = cn++;
+    rep.push_back(v);
+  }
+
+  // merge the adjacency lists of the matched pairs
+  cg.xadj.assign(cn+1, 0);
+  cg.vwgt.resize(cn);
+  cg.adjncy.clear();
+  cg.adjwgt.clear();
+  cg.adjncy.reserve(g.adjncy.size());
+  cg.adjwgt.reserve(g.adjncy.size());
+  cg.tvwgt = g.tvwgt;
+  std::vector<Index> htable(cn, -1);
+  for(Index c = 0; c < cn; ++c)
+  {
+    Index v = rep[c], u = match[v];
+    Index start = Index(cg.adjncy.size());
+    cg.vwgt[c] = g.vwgt[v] + (u != v ? g.vwgt[u] : 0);
+    for(Index w = v, pass = 0; pass < 2; w = u, ++pass)
+    {
+      if(pass == 1 && u == v) break;
+      for(Index p = g.xadj[w]; p < g.xadj[w+1]; ++p)
+      {
+        Index cx = cmap[g.adjncy[p]];
+        if(cx == c) continue;
+        if(htable[cx] == -1)
+        {
+          htable[cx] = Index(cg.adjncy.size());
+          cg.adjncy.push_back(cx);
+          cg.adjwgt.push_back(g.adjwgt[p]);
+        }
+        else
+          cg.adjwgt[htable[cx]] += g.adjwgt[p];
+      }
+    }
+    for(Index p = start; p < Index(cg.adjncy.size()); ++p)
+      htable[cg.adjncy[p]] = -1;
+    cg.xadj[c+1] = Index(cg.adjncy.size());
+  }
+}
+
+/** \internal
+  * Computes an initial bisection of \a g by growing the part 0 from \a seed in breadth first order
+  * until it holds half of the total vertex weight. */
+template<typename Index>
+void nd_grow_bisection(const nd_graph<Index>& g, Index seed, std::vector<Index>& where)
+{
+  const Index n = g.size();
+  where.assign(n, 1);
+  std::vector<Index> queue;
+  std::vector<bool> visited(n, false);
+  queue.reserve(n);
+  Index head = 0, scan = 0, weight0 = 0, target = g.tvwgt/2;
+  queue.push_back(seed);
+  visited[seed] = true;
+  while(weight0 < target)
+  {
+    if(head == Index(queue.size()))
+    {
+      // the component is exhausted, jump to the next one
+      while(scan < n && visited[scan]) ++scan;
+      if(scan == n) break;
+      queue.push_back(scan);
+      visited[scan] = true;
+    }
+    Index v = queue[head++];
+    where[v] = 0;
+    weight0 += g.vwgt[v];
+    for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+    {
+      Index u = g.adjncy[p];
+      if(!visited[u])
+      {
+        visited[u] = true;
+        queue.push_back(u);
+      }
+    }
+  }
+}
+
+/** \internal moves the vertex \a v to the other part and updates the internal/external degrees */
+template<typename Index>
+inline void nd_move(const nd_graph<Index>& g, Index v, std::vector<Index>& where, std::vector<Index>& id,
+                    std::vector<Index>& ed, Index* pwgts, Index& cut)
+{
+  Index from = where[v];
+  cut -= ed[v] - id[v];
+  pwgts[from] -= g.vwgt[v];
+  pwgts[1-from] += g.vwgt[v];
+  where[v] = 1-from;
+  std::swap(id[v], ed[v]);
+  for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+  {
+    Index u = g.adjncy[p], w = g.adjwgt[p];
+    if(where[u] == from) { id[u] -= w; ed[u] += w; }
+    else                 { id[u] += w; ed[u] -= w; }
+  }
+}
+
+/** \internal
+  * Fiduccia-Mattheyses refinement of the bisection \a where of \a g.
+  * Each pass greedily moves boundary vertices with the largest gains, respecting the balance constraint,
+  * and rolls back to the best state encountered.
+  * \returns the edge cut of the refined bisection */
+template<typename Index>
+Index nd_refine(const nd_graph<Index>& g, std::vector<Index>& where, Index maxPasses = 8)
+{
+  typedef std::pair<Index,Index> GainEntry;
+  const Index n = g.size();
+  std::vector<Index> id(n, 0), ed(n, 0);
+  Index pwgts[2] = {0, 0};
+  Index cut = 0, maxvwgt = 0;
+  for(Index v = 0; v < n; ++v)
+  {
+    pwgts[where[v]] += g.vwgt[v];
+    maxvwgt = (std::max)(maxvwgt, g.vwgt[v]);
+    for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+    {
+      if(where[g.adjncy[p]] == where[v]) id[v] += g.adjwgt[p];
+      else                               ed[v] += g.adjwgt[p];
+    }
+    cut += ed[v];
+  }
+  cut /= 2;
+  const Index maxw = g.tvwgt/2 + (std::max)(g.tvwgt/32, maxvwgt);
+  const Index moveLimit = (std::min)(n, (std::max)(Index(16), n/64));
+
+  std::vector<char> locked(n);
+  std::vector<Index> moves;
+  moves.reserve(n);
+  for(Index pass = 0; pass < maxPasses; ++pass)
+  {
+    std::priority_queue<GainEntry> heaps[2];
+    std::fill(locked.begin(), locked.end(), 0);
+    moves.clear();
+    for(Index v = 0; v < n; ++v)
+      if(ed[v] > 0)
+        heaps[where[v]].push(GainEntry(ed[v]-id[v], v));
+
+    Index bestCut = cut, bestMoves = 0;
+    Index bestOver = (std::max)(Index(0), (std::max)(pwgts[0], pwgts[1]) - maxw);
+    Index bestImb = std::abs(pwgts[0]-pwgts[1]);
+    for(;;)
+    {
+      // discard stale entries
+      for(Index s = 0; s < 2; ++s)
+        while(!heaps[s].empty())
+        {
+          const GainEntry& e = heaps[s].top();
+          if(locked[e.second] || where[e.second] != s || e.first != ed[e.second]-id[e.second])
+            heaps[s].pop();
+          else
+            break;
+        }
+      bool ok0 = !heaps[0].empty() && pwgts[1] + g.vwgt[heaps[0].top().second] <= maxw;
+      bool ok1 = !heaps[1].empty() && pwgts[0] + g.vwgt[heaps[1].top().second] <= maxw;
+      if(!ok0 && !ok1) break;
+      Index from;
+      if(ok0 && ok1)
+      {
+        Index g0 = heaps[0].top().first, g1 = heaps[1].top().first;
+        from = g0 > g1 ? 0 : g1 > g0 ? 1 : (pwgts[0] >= pwgts[1] ? 0 : 1);
+      }
+      else
+        from = ok0 ? 0 : 1;
+
+      Index v = heaps[from].top().second;
+      heaps[from].pop();
+      nd_move(g, v, where, id, ed, pwgts, cut);
+      locked[v] = 1;
+      moves.push_back(v);
+      for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+      {
+        Index u = g.adjncy[p];
+        if(!locked[u] && ed[u] > 0)
+          heaps[where[u]].push(GainEntry(ed[u]-id[u], u));
+      }
+
+      Index over = (std::max)(Index(0), (std::max)(pwgts[0], pwgts[1]) - maxw);
+      Index imb = std::abs(pwgts[0]-pwgts[1]);
+      if(over < bestOver || (over == bestOver && (cut < bestCut || (cut == bestCut && imb < bestImb))))
+      {
+        bestCut = cut;
+        bestOver = over;
+        bestImb = imb;
+        bestMoves = Index(moves.size());
+      }
+      else if(Index(moves.size()) - bestMoves > moveLimit)
+        break;
+    }
+
+    // roll back to the best state of this pass
+    for(Index k = Index(moves.size())-1; k >= bestMoves; --k)
+      nd_move(g, moves[k], where, id, ed, pwgts, cut);
+    if(bestMoves == 0)
+      break;
+  }
+  return cut;
+}
+
+/** \internal
+  * Multilevel bisection of \a g: the graph is coarsened by heavy edge matchings, the coarsest graph is
+  * bisected by several greedy growings, and the best bisection is projected back and refined at each level. */
+template<typename Index>
+void nd_bisect(const nd_graph<Index>& g, std::vector<Index>& where, unsigned int& state)
+{
+  const Index coarsenTo = 100;
+  const Index nbTries = 4;
+  std::deque<nd_graph<Index> > levels;
+  std::deque<std::vector<Index> > cmaps;
+  const nd_graph<Index>* cur = &g;
+  while(cur->size() > coarsenTo)
+  {
+    levels.push_back(nd_graph<Index>());
+    cmaps.push_back(std::vector<Index>());
+    nd_coarsen(*cur, levels.back(), cmaps.back(), state);
+    bool stalled = levels.back().size() > (9*cur->size())/10;
+    cur = &levels.back();
+    if(stalled) break;
+  }
+
+  // initial bisection of the coarsest graph
+  const Index cn = cur->size();
+  std::vector<Index> trial;
+  Index bestCut = -1;
+  for(Index t = 0; t < nbTries; ++t)
+  {
+    Index seed = nd_rand(state, cn);
+    if(t == 0)
+    {
+      // start from the last vertex reached by a breadth first search, i.e., a peripheral vertex
+      std::vector<Index> queue(1, seed);
+      std::vector<bool> visited(cn, false);
+      visited[seed] = true;
+      for(size_t h = 0; h < queue.size(); ++h)
+        for(Index p = cur->xadj[queue[h]]; p < cur->xadj[queue[h]+1]; ++p)
+          if(!visited[cur->adjncy[p]])
+          {
+            visited[cur->adjncy[p]] = true;
+            queue.push_back(cur->adjncy[p]);
+          }
+      seed = queue.back();
+    }
+    nd_grow_bisection(*cur, seed, trial);
+    Index cut = nd_refine(*cur, trial);
+    if(bestCut < 0 || cut < bestCut)
+    {
+      bestCut = cut;
+      where = trial;
+    }
+  }
+
+  // uncoarsening
+  for(Index l = Index(levels.size())-1; l >= 0; --l)
+  {
+    const nd_graph<Index>& fine = l == 0 ? g : levels[l-1];
+    const std::vector<Index>& cmap = cmaps[l];
+    trial.resize(fine.size());
+    for(Index v = 0; v < fine.size(); ++v)
+      trial[v] = where[cmap[v]];
+    where.swap(trial);
+    nd_refine(fine, where);
+  }
+}
+
+/** \internal
+  * Turns the edge separator defined by the bisection \a where of \a g into a vertex separator.
+  * The separator vertices are flagged with the value 2 in \a where.
+  * The cut edges are covered greedily by the vertices having the largest number of cut edges, and the
+  * redundant separator vertices are finally moved back to their part. */
+template<typename Index>
+void nd_vertex_separator(const nd_graph<Index>& g, std::vector<Index>& where)
+{
+  const Index n = g.size();
+  std::vector<std::pair<Index,Index> > candidates;
+  for(Index v = 0; v < n; ++v)
+  {
+    Index count = 0;
+    for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+      if(where[g.adjncy[p]] != where[v]) ++count;
+    if(count > 0)
+      candidates.push_back(std::make_pair(-count, v));
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  std::vector<Index> side(where);
+  for(size_t k = 0; k < candidates.size(); ++k)
+  {
+    Index v = candidates[k].second;
+    for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+      if(where[g.adjncy[p]] == 1-side[v])
+      {
+        where[v] = 2;
+        break;
+      }
+  }
+  for(size_t k = candidates.size(); k-- > 0;)
+  {
+    Index v = candidates[k].second;
+    if(where[v] != 2) continue;
+    bool needed = false;
+    for(Index p = g.xadj[v]; p < g.xadj[v+1] && !needed; ++p)
+      needed = (where[g.adjncy[p]] == 1-side[v]);
+    if(!needed)
+      where[v] = side[v];
+  }
+}
+
+/** \internal
+  * Orders the \a m vertices \a verts of a leaf of the dissection tree by the approximate minimum degree algorithm.
+  * \a local must map every vertex of \a verts to its position in \a verts, and -1 otherwise. */
+template<typename Index>
+void nd_order_leaf(const Index* xadj, const Index* adjncy, Index* verts, Index m, const Index* local)
+{
+  if(m <= 2) return;
+  SparseMatrix<Index,ColMajor,Index> C(m,m);
+  Index nnz = 0;
+  for(Index k = 0; k < m; ++k)
+    for(Index p = xadj[verts[k]]; p < xadj[verts[k]+1]; ++p)
+      if(local[adjncy[p]] >= 0) ++nnz;
+  C.resizeNonZeros(nnz);
+  Index* Cp = C.outerIndexPtr();
+  Index* Ci = C.innerIndexPtr();
+  nnz = 0;
+  for(Index k = 0; k < m; ++k)
+  {
+    Cp[k] = nnz;
+    for(Index p = xadj[verts[k]]; p < xadj[verts[k]+1]; ++p)
+      if(local[adjncy[p]] >= 0) Ci[nnz++] = local[adjncy[p]];
+  }
+  Cp[m] = nnz;
+  if(nnz == 0) return;
+
+  PermutationMatrix<Dynamic,Dynamic,Index> perm;
+  minimum_degree_ordering(C, perm);
+  std::vector<Index> tmp(verts, verts+m);
+  for(Index k = 0; k < m; ++k)
+    verts[k] = tmp[perm.indices()[k]];
+}
+
+/** \internal
+  * Nested dissection ordering of the graph of \a n vertices given by the adjacency lists \a xadj and \a adjncy
+  * (without self loops). The graph is recursively split by vertex separators computed by multilevel bisection,
+  * the separators being numbered after the two parts they split, and the subgraphs having at most
+  * \a leafSize vertices are ordered by the approximate minimum degree algorithm.
+  * On exit \a order[k] is the vertex ordered at the position k. */
+template<typename Index>
+void nested_dissection(Index n, const Index* xadj, const Index* adjncy, Index leafSize, Index* order)
+{
+  for(Index v = 0; v < n; ++v) order[v] = v;
+  std::vector<Index> local(n, -1), where;
+  std::vector<std::pair<Index,Index> > tasks;
+  tasks.push_back(std::make_pair(Index(0), n));
+  unsigned int state = 12345u;
+  nd_graph<Index> g;
+  while(!tasks.empty())
+  {
+    Index begin = tasks.back().first, end = tasks.back().second;
+    tasks.pop_back();
+    Index m = end - begin;
+    Index* verts = order + begin;
+    for(Index k = 0; k < m; ++k) local[verts[k]] = k;
+
+    bool isLeaf = m <= leafSize;
+    if(!isLeaf)
+    {
+      // extract the subgraph induced by verts
+      g.xadj.resize(m+1);
+      g.adjncy.clear();
+      g.vwgt.assign(m, 1);
+      g.tvwgt = m;
+      g.xadj[0] = 0;
+      for(Index k = 0; k < m; ++k)
+      {
+        for(Index p = xadj[verts[k]]; p < xadj[verts[k]+1]; ++p)
+          if(local[adjncy[p]] >= 0) g.adjncy.push_back(local[adjncy[p]]);
+        g.xadj[k+1] = Index(g.adjncy.size());
+      }
+      g.adjwgt.assign(g.adjncy.size(), 1);
+      isLeaf = g.adjncy.empty();
+    }
+    if(!isLeaf)
+    {
+      nd_bisect(g, where, state);
+      nd_vertex_separator(g, where);
+      Index counts[3] = {0, 0, 0};
+      for(Index k = 0; k < m; ++k) ++counts[where[k]];
+      if(counts[0] == 0 || counts[1] == 0)
+        isLeaf = true;
+      else
+      {
+        // reorder verts as [part 0 | part 1 | separator]
+        std::vector<Index> tmp(verts, verts+m);
+        Index pos[3] = {0, counts[0], counts[0]+counts[1]};
+        for(Index k = 0; k < m; ++k)
+          verts[pos[where[k]]++] = tmp[k];
+        for(Index k = 0; k < m; ++k) local[verts[k]] = -1;
+        tasks.push_back(std::make_pair(begin, begin+counts[0]));
+        tasks.push_back(std::make_pair(begin+counts[0], begin+counts[0]+counts[1]));
+        continue;
+      }
+    }
+    nd_order_leaf(xadj, adjncy, verts, m, &local[0]);
+    for(Index k = 0; k < m; ++k) local[verts[k]] = -1;
+  }
+}
+
+/** \internal
+  * Nested dissection ordering algorithm.
+  * \returns the permutation P reducing the fill-in of the input matrix \a C, such that P.indices()[k] is the
+  * index of the original row/column ordered at the position k.
+  * The input matrix \a C must be a selfadjoint compressed column major SparseMatrix object.
+  * Both the upper and lower parts have to be stored, but the diagonal entries are optional. */
+template<typename Scalar, typename Index>
+void nested_dissection_ordering(const SparseMatrix<Scalar,ColMajor,Index>& C, PermutationMatrix<Dynamic,Dynamic,Index>& perm,
+                                Index leafSize)
+{
+  eigen_assert(C.isCompressed() && "nested_dissection_ordering requires a compressed matrix");
+  const Index n = C.cols();
+  perm.resize(n);
+  if(n == 0) return;
+
+  // drop the diagonal entries
+  std::vector<Index> xadj(n+1), adjncy;
+  adjncy.reserve(C.nonZeros());
+  const Index* Cp = C.outerIndexPtr();
+  const Index* Ci = C.innerIndexPtr();
+  xadj[0] = 0;
+  for(Index j = 0; j < n; ++j)
+  {
+    for(Index p = Cp[j]; p < Cp[j+1]; ++p)
+      if(Ci[p] != j) adjncy.push_back(Ci[p]);
+    xadj[j+1] = Index(adjncy.size());
+  }
+  nested_dissection(n, &xadj[0], adjncy.empty() ? (const Index*)0 : &adjncy[0], (std::max)(leafSize, Index(3)),
+                    perm.indices().data());
+}
+
+} // namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSE_NESTED_DISSECTION_H
@@ -0,0 +1,178 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_ORDERING_H
+#define EIGEN_ORDERING_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Computes the symmetric pattern A^T+A of the square matrix \a mat, with both the upper and lower parts stored.
+  * The values of \a symmat are meaningless. */
+template<typename MatrixType, typename Scalar, typename Index>
+void ordering_helper_at_plus_a(const MatrixType& mat, SparseMatrix<Scalar,ColMajor,Index>& symmat)
+{
+  eigen_assert(mat.rows()==mat.cols() && "the ordering methods require a square matrix");
+  SparseMatrix<Scalar,ColMajor,Index> A(mat), At;
+  for(Index j = 0; j < A.outerSize(); ++j)
+    for(typename SparseMatrix<Scalar,ColMajor,Index>::InnerIterator it(A,j); it; ++it)
+      it.valueRef() = Scalar(1);
+  At = A.transpose();
+  symmat = A + At;
+}
+
+} // end namespace internal
+
+/** \ingroup OrderingMethods_Module
+  * \class AMDOrdering
+  *
+  * Functor computing the \em approximate \em minimum \em degree ordering.
+  * This is the default ordering of the sparse Cholesky factorizations, it is a good all-round choice.
+  *
+  * As all the ordering functors of this module, it computes a permutation \c perm of the rows and columns of a
+  * square matrix \c A such that \c perm.indices()[k] is the index of the row/column of \c A eliminated at the
+  * step \c k. The pattern of A^T+A is used for general matrices, while selfadjoint views are used as is.
+  *
+  * \sa class NaturalOrdering, class RCMOrdering, class NestedDissectionOrdering
+  */
+template<typename Index>
+class AMDOrdering
+{
+  public:
+    typedef PermutationMatrix<Dynamic, Dynamic, Index> PermutationType;
+
+    /** Computes the permutation \a perm of the square matrix \a mat */
+    template<typename MatrixType>
+    void operator()(const MatrixType& mat, PermutationType& perm)
+    {
+      SparseMatrix<typename MatrixType::Scalar,ColMajor,Index> symm;
+      internal::ordering_helper_at_plus_a(mat, symm);
+      internal::minimum_degree_ordering(symm, perm);
+    }
+
+    /** Computes the permutation \a perm of the selfadjoint matrix \a mat */
+    template<typename SrcType, unsigned int SrcUpLo>
+    void operator()(const SparseSelfAdjointView<SrcType,SrcUpLo>& mat, PermutationType& perm)
+    {
+      SparseMatrix<typename SrcType::Scalar,ColMajor,Index> C;
+      C = mat;
+      internal::minimum_degree_ordering(C, perm);
+    }
+};
+
+/** \ingroup OrderingMethods_Module
+  * \class NaturalOrdering
+  *
+  * Functor keeping the natural ordering of the matrix, i.e., it returns an empty permutation standing for the identity.
+  * It is useful when the matrix has already been ordered by the user.
+  *
+  * \sa class AMDOrdering
+  */
+template<typename Index>
+class NaturalOrdering
+{
+  public:
+    typedef PermutationMatrix<Dynamic, Dynamic, Index> PermutationType;
+
+    /** Sets \a perm to the empty permutation */
+    template<typename MatrixType>
+    void operator()(const MatrixType& /*mat*/, PermutationType& perm)
+    {
+      perm.resize(0);
+    }
+};
+
+/** \ingroup OrderingMethods_Module
+  * \class RCMOrdering
+  *
+  * Functor computing the \em reverse \em Cuthill-McKee ordering.
+  * It reduces the bandwidth and the profile of the matrix, which makes it well suited to banded and skyline
+  * storages as well as to cache friendly sparse matrix products. It usually yields more fill-in than
+  * AMDOrdering and NestedDissectionOrdering for direct factorizations.
+  *
+  * \sa class AMDOrdering, class NestedDissectionOrdering
+  */
+template<typename Index>
+class RCMOrdering
+{
+  public:
+    typedef PermutationMatrix<Dynamic, Dynamic, Index> PermutationType;
+
+    /** Computes the permutation \a perm of the square matrix \a mat */
+    template<typename MatrixType>
+    void operator()(const MatrixType& mat, PermutationType& perm)
+    {
+      SparseMatrix<typename MatrixType::Scalar,ColMajor,Index> symm;
+      internal::ordering_helper_at_plus_a(mat, symm);
+      internal::rcm_ordering(symm, perm);
+    }
+
+    /** Computes the permutation \a perm of the selfadjoint matrix \a mat */
+    template<typename SrcType, unsigned int SrcUpLo>
+    void operator()(const SparseSelfAdjointView<SrcType,SrcUpLo>& mat, PermutationType& perm)
+    {
+      SparseMatrix<typename SrcType::Scalar,ColMajor,Index> C;
+      C = mat;
+      internal::rcm_ordering(C, perm);
+    }
+};
+
+/** \ingroup OrderingMethods_Module
+  * \class NestedDissectionOrdering
+  *
+  * Functor computing a \em nested \em dissection ordering.
+  * The graph of the matrix is recursively split in two parts by small vertex separators which are numbered last.
+  * The separators are computed by a multilevel scheme: heavy edge matching coarsening, greedy graph growing
+  * bisection of the coarsest graph and Fiduccia-Mattheyses refinement during the uncoarsening. The subgraphs
+  * smaller than leafSize() are ordered by the approximate minimum degree algorithm.
+  *
+  * Compared to AMDOrdering, it is more expensive but yields much less fill-in on large 2D and 3D meshes, and a
+  * well balanced elimination tree which exposes parallelism to the factorization.
+  *
+  * \sa class AMDOrdering, class RCMOrdering
+  */
+template<typename Index>
+class NestedDissectionOrdering
+{
+  public:
+    typedef PermutationMatrix<Dynamic, Dynamic, Index> PermutationType;
+
+    NestedDissectionOrdering(Index leafSize = 128) : m_leafSize(leafSize) {}
+
+    /** Sets the size below which the subgraphs are ordered by the minimum degree algorithm (default is 128) */
+    void setLeafSize(Index leafSize) { m_leafSize = leafSize; }
+
+    /** \returns the size below which the subgraphs are ordered by the minimum degree algorithm */
+    Index leafSize() const { return m_leafSize; }
+
+    /** Computes the permutation \a perm of the square matrix \a mat */
+    template<typename MatrixType>
+    void operator()(const MatrixType& mat, PermutationType& perm)
+    {
+      SparseMatrix<typename MatrixType::Scalar,ColMajor,Index> symm;
+      internal::ordering_helper_at_plus_a(mat, symm);
+      internal::nested_dissection_ordering(symm, perm, m_leafSize);
+    }
+
+    /** Computes the permutation \a perm of the selfadjoint matrix \a mat */
+    template<typename SrcType, unsigned int SrcUpLo>
+    void operator()(const SparseSelfAdjointView<SrcType,SrcUpLo>& mat, PermutationType& perm)
+    {
+      SparseMatrix<typename SrcType::Scalar,ColMajor,Index> C;
+      C = mat;
+      internal::nested_dissection_ordering(C, perm, m_leafSize);
+    }
+
+  protected:
+    Index m_leafSize;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_ORDERING_H
@@ -0,0 +1,159 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSE_RCM_H
+#define EIGEN_SPARSE_RCM_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Builds the rooted level structure of the connected component of \a root by a breadth first search.
+  * The visited nodes are written to \a ls in level order and tagged with \a stamp in \a tags.
+  * Nodes already tagged with \a stamp or flagged in \a done are ignored.
+  * \returns the number of levels, \a size receives the number of nodes of the component and
+  * \a lastLevel the position in \a ls of the first node of the last level. */
+template<typename Index>
+Index rcm_level_structure(Index root, const Index* Cp, const Index* Ci, const bool* done,
+                          Index* tags, Index stamp, Index* ls, Index& size, Index& lastLevel)
+{
+  Index head = 0, tail = 0, nlevels = 0;
+  ls[tail++] = root;
+  tags[root] = stamp;
+  while(head < tail)
+  {
+    // process one complete level
+    Index levelEnd = tail;
+    lastLevel = head;
+    ++nlevels;
+    for(; head < levelEnd; ++head)
+    {
+      Index j = ls[head];
+      for(Index p = Cp[j]; p < Cp[j+1]; ++p)
+      {
+        Index i = Ci[p];
+        if(tags[i] == stamp || done[i]) continue;
+        tags[i] = stamp;
+        ls[tail++] = i;
+      }
+    }
+  }
+  size = tail;
+  return nlevels;
+}
+
+/** \internal
+  * Reverse Cuthill-McKee ordering algorithm.
+  * \returns the permutation P reducing the bandwidth and the profile of the input matrix \a C, such that
+  * P.indices()[k] is the index of the original row/column ordered at the position k.
+  * The input matrix \a C must be a selfadjoint compressed column major SparseMatrix object.
+  * Both the upper and lower parts have to be stored, but the diagonal entries are optional.
+  *
+  * Each connected component is processed from a pseudo-peripheral node found with the
+  * algorithm of George and Liu, and the neighbors of a node are numbered by increasing degree. */
+template<typename Scalar, typename Index>
+void rcm_ordering(const SparseMatrix<Scalar,ColMajor,Index>& C, PermutationMatrix<Dynamic,Dynamic,Index>& perm)
+{
+  const Index n = C.cols();
+  perm.resize(n);
+  if(n==0) return;
+
+  const Index* Cp = C.outerIndexPtr();
+  const Index* Ci = C.innerIndexPtr();
+  eigen_assert(C.isCompressed() && "rcm_ordering requires a compressed matrix");
+
+  Matrix<Index,Dynamic,1> work(4*n);
+  Index* degree = work.data();      // number of off-diagonal entries
+  Index* tags   = degree + n;       // stamps of the level structure searches
+  Index* ls     = tags + n;         // current level structure
+  Index* bydeg  = ls + n;           // nodes sorted by increasing degree
+  Matrix<bool,Dynamic,1> done(n);
+  done.setZero();
+
+  for(Index j = 0; j < n; ++j)
+  {
+    degree[j] = 0;
+    tags[j] = -1;
+    for(Index p = Cp[j]; p < Cp[j+1]; ++p)
+      if(Ci[p] != j) ++degree[j];
+  }
+
+  // counting sort of the nodes by degree
+  {
+    Matrix<Index,Dynamic,1> count(n+1);
+    count.setZero();
+    for(Index j = 0; j < n; ++j) ++count[degree[j]];
+    Index sum = 0;
+    for(Index d = 0; d <= n; ++d) { Index c = count[d]; count[d] = sum; sum += c; }
+    for(Index j = 0; j < n; ++j) bydeg[count[degree[j]]++] = j;
+  }
+
+  Index* order = perm.indices().data();
+  Index stamp = 0, k = 0;
+  std::vector<Index> children;
+  for(Index s = 0; s < n; ++s)
+  {
+    Index root = bydeg[s];
+    if(done[root]) continue;
+
+    // find a pseudo-peripheral node of the component of root
+    Index size, lastLevel;
+    Index ecc = rcm_level_structure(root, Cp, Ci, done.data(), tags, stamp++, ls, size, lastLevel);
+    for(;;)
+    {
+      Index x = ls[lastLevel];
+      for(Index q = lastLevel+1; q < size; ++q)
+        if(degree[ls[q]] < degree[x]) x = ls[q];
+      Index xlast;
+      Index xecc = rcm_level_structure(x, Cp, Ci, done.data(), tags, stamp++, ls, size, xlast);
+      if(xecc <= ecc)
+        break;
+      root = x;
+      ecc = xecc;
+      lastLevel = xlast;
+    }
+
+    // Cuthill-McKee numbering of the component
+    Index head = k;
+    order[k++] = root;
+    done[root] = true;
+    while(head < k)
+    {
+      Index j = order[head++];
+      children.clear();
+      for(Index p = Cp[j]; p < Cp[j+1]; ++p)
+      {
+        Index i = Ci[p];
+        if(done[i]) continue;
+        done[i] = true;
+        children.push_back(i);
+      }
+      // insertion sort by degree, the lists are short
+      for(size_t a = 1; a < children.size(); ++a)
+      {
+        Index c = children[a];
+        size_t b = a;
+        for(; b > 0 && degree[children[b-1]] > degree[c]; --b)
+          children[b] = children[b-1];
+        children[b] = c;
+      }
+      for(size_t a = 0; a < children.size(); ++a)
+        order[k++] = children[a];
+    }
+  }
+
+  // reverse the ordering
+  for(Index i = 0, j = n-1; i < j; ++i, --j)
+    std::swap(order[i], order[j]);
+}
+
+} // namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSE_RCM_H
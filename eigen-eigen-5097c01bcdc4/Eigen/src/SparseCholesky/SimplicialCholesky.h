@@ -70,6 +70,8 @@ enum SimplicialCholeskyMode {
   * \tparam _MatrixType the type of the sparse matrix A, it must be a SparseMatrix<>
   * \tparam _UpLo the triangular part that will be used for the computations. It can be Lower
   *               or Upper. Default is Lower.
+  * \tparam _Ordering the fill-in reducing ordering functor, see the OrderingMethods module.
+  *                   Default is AMDOrdering.
   *
   */
 template<typename Derived>
@@ -77,6 +79,7 @@ class SimplicialCholeskyBase : internal::noncopyable
 {
   public:
     typedef typename internal::traits<Derived>::MatrixType MatrixType;
+    typedef typename internal::traits<Derived>::OrderingType OrderingType;
     enum { UpLo = internal::traits<Derived>::UpLo };
     typedef typename MatrixType::Scalar Scalar;
     typedef typename MatrixType::RealScalar RealScalar;
@@ -88,11 +91,11 @@ class SimplicialCholeskyBase : internal::noncopyable
 
     /** Default constructor */
     SimplicialCholeskyBase()
-      : m_info(Success), m_isInitialized(false), m_shiftOffset(0), m_shiftScale(1)
+      : m_info(Success), m_isInitialized(false), m_levelsOk(false), m_shiftOffset(0), m_shiftScale(1)
     {}
 
     SimplicialCholeskyBase(const MatrixType& matrix)
-      : m_info(Success), m_isInitialized(false), m_shiftOffset(0), m_shiftScale(1)
+      : m_info(Success), m_isInitialized(false), m_levelsOk(false), m_shiftOffset(0), m_shiftScale(1)
     {
       derived().compute(matrix);
     }
@@ -110,6 +113,8 @@ class SimplicialCholeskyBase : internal::noncopyable
     /** \brief Reports whether previous computation was successful.
       *
       * \returns \c Success if computation was succesful,
+      *          \c InvalidInput if the pattern of the matrix given to factorize() differs from
+      *          the one given to analyzePattern(),
       *          \c NumericalIssue if the matrix.appears to be negative.
       */
     ComputationInfo info() const
@@ -172,6 +177,34 @@ class SimplicialCholeskyBase : internal::noncopyable
       return derived();
     }
 
+    /** \returns a reference to the fill-in reducing ordering functor used by the next call
+      * to analyzePattern() or compute(). This allows to tune its parameters, e.g.:
+      * \code
+      * SimplicialLDLT<SparseMatrix<double>, Lower, NestedDissectionOrdering<int> > ldlt;
+      * ldlt.orderingMethod().setLeafSize(64);
+      * ldlt.compute(A);
+      * \endcode
+      *
+      * \sa setOrderingMethod()
+      */
+    OrderingType& orderingMethod() { return m_ordering; }
+
+    /** \returns a const reference to the fill-in reducing ordering functor. */
+    const OrderingType& orderingMethod() const { return m_ordering; }
+
+    /** Replaces the fill-in reducing ordering functor used by the next call to analyzePattern()
+      * or compute() by a copy of \a ordering.
+      *
+      * \returns a reference to \c *this.
+      *
+      * \sa orderingMethod()
+      */
+    Derived& setOrderingMethod(const OrderingType& ordering)
+    {
+      m_ordering = ordering;
+      return derived();
+    }
+
 #ifndef EIGEN_PARSED_BY_DOXYGEN
     /** \internal */
     template<typename Stream>
@@ -184,6 +217,9 @@ class SimplicialCholeskyBase : internal::noncopyable
       s << "  nonzeros: " << ((total+=m_nonZerosPerCol.size() * sizeof(int)) >> 20) << "Mb" << "\n";
       s << "  perm:     " << ((total+=m_P.size() * sizeof(int)) >> 20) << "Mb" << "\n";
       s << "  perm^-1:  " << ((total+=m_Pinv.size() * sizeof(int)) >> 20) << "Mb" << "\n";
+      s << "  PAP^-1:   " << ((total+=(m_ap.cols()+1) * sizeof(int) + m_ap.nonZeros()*(sizeof(int)+sizeof(Scalar))) >> 20) << "Mb" << "\n";
+      s << "  map:      " << ((total+=m_apMap.size() * sizeof(int)) >> 20) << "Mb" << "\n";
+      s << "  work:     " << ((total+=m_workValues.size() * sizeof(Scalar) + m_workIndices.size() * sizeof(int)) >> 20) << "Mb" << "\n";
       s << "  TOTAL:    " << (total>> 20) << "Mb" << "\n";
     }
 
@@ -202,14 +238,32 @@ class SimplicialCholeskyBase : internal::noncopyable
       else
         dest = b;
 
-      if(m_matrix.nonZeros()>0) // otherwise L==I
-        derived().matrixL().solveInPlace(dest);
+      if(m_levelsOk)
+      {
+        // level scheduled parallel solves
+        if(m_diag.size()>0)
+        {
+          m_levels.template solveInPlace<UnitLower>(m_matrix, dest);
+          dest = m_diag.asDiagonal().inverse() * dest;
+          m_levels.template adjointSolveInPlace<UnitLower>(m_matrix, dest);
+        }
+        else
+        {
+          m_levels.template solveInPlace<Lower>(m_matrix, dest);
+          m_levels.template adjointSolveInPlace<Lower>(m_matrix, dest);
+        }
+      }
+      else
+      {
+        if(m_matrix.nonZeros()>0) // otherwise L==I
+          derived().matrixL().solveInPlace(dest);
 
-      if(m_diag.size()>0)
-        dest = m_diag.asDiagonal().inverse() * dest;
+        if(m_diag.size()>0)
+          dest = m_diag.asDiagonal().inverse() * dest;
 
-      if (m_matrix.nonZeros()>0) // otherwise U==I
-        derived().matrixU().solveInPlace(dest);
+        if (m_matrix.nonZeros()>0) // otherwise U==I
+          derived().matrixU().solveInPlace(dest);
+      }
 
       if(m_P.size()>0)
         dest = m_Pinv * dest;
@@ -244,22 +298,26 @@ class SimplicialCholeskyBase : internal::noncopyable
     template<bool DoLDLT>
     void compute(const MatrixType& matrix)
     {
-      eigen_assert(matrix.rows()==matrix.cols());
-      Index size = matrix.cols();
-      CholMatrixType ap(size,size);
-      ordering(matrix, ap);
-      analyzePattern_preordered(ap, DoLDLT);
-      factorize_preordered<DoLDLT>(ap);
+      analyzePattern(matrix, DoLDLT);
+      factorize_preordered<DoLDLT>(m_ap);
     }
     
+    /** Performs the numerical factorization of \a a reusing the symbolic plan computed by analyzePattern():
+      * the coefficients of \a a are scattered into the preallocated permuted matrix through the cached
+      * value map, and the factor L is computed in place. No memory is allocated.
+      * If the pattern of \a a differs from the analyzed one, info() returns \c InvalidInput. */
     template<bool DoLDLT>
     void factorize(const MatrixType& a)
     {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
       eigen_assert(a.rows()==a.cols());
-      int size = a.cols();
-      CholMatrixType ap(size,size);
-      ap.template selfadjointView<Upper>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
-      factorize_preordered<DoLDLT>(ap);
+      if(a.rows()!=m_ap.rows() || !permuteValues(a))
+      {
+        m_info = InvalidInput;
+        m_factorizationIsOk = false;
+        return;
+      }
+      factorize_preordered<DoLDLT>(m_ap);
     }
 
     template<bool DoLDLT>
@@ -268,14 +326,13 @@ class SimplicialCholeskyBase : internal::noncopyable
     void analyzePattern(const MatrixType& a, bool doLDLT)
     {
       eigen_assert(a.rows()==a.cols());
-      int size = a.cols();
-      CholMatrixType ap(size,size);
-      ordering(a, ap);
-      analyzePattern_preordered(ap,doLDLT);
+      ordering(a);
+      analyzePattern_preordered(m_ap,doLDLT);
     }
     void analyzePattern_preordered(const CholMatrixType& a, bool doLDLT);
     
-    void ordering(const MatrixType& a, CholMatrixType& ap);
+    void ordering(const MatrixType& a);
+    bool permuteValues(const MatrixType& a);
 
     /** keeps off-diagonal entries; drops diagonal entries */
     struct keep_diag {
@@ -296,20 +353,31 @@ class SimplicialCholeskyBase : internal::noncopyable
     VectorXi m_nonZerosPerCol;
     PermutationMatrix<Dynamic,Dynamic,Index> m_P;     // the permutation
     PermutationMatrix<Dynamic,Dynamic,Index> m_Pinv;  // the inverse permutation
+    OrderingType m_ordering;                          // the fill-in reducing ordering functor
+
+    CholMatrixType m_ap;                              // the upper triangular part of P A P^-1
+    Matrix<Index,Dynamic,1> m_apMap;                  // position in m_ap of each coefficient of the triangular part of A,
+                                                      // -1-pos if it must be conjugated
+    VectorType m_workValues;                          // workspaces of the numerical factorization
+    Matrix<Index,Dynamic,1> m_workIndices;
+
+    SparseTriangularLevelSolver<CholMatrixType,Lower> m_levels; // level schedules of L and L^*, for multithreaded solves
+    bool m_levelsOk;
 
     RealScalar m_shiftOffset;
     RealScalar m_shiftScale;
 };
 
-template<typename _MatrixType, int _UpLo = Lower> class SimplicialLLT;
-template<typename _MatrixType, int _UpLo = Lower> class SimplicialLDLT;
-template<typename _MatrixType, int _UpLo = Lower> class SimplicialCholesky;
+template<typename _MatrixType, int _UpLo = Lower, typename _Ordering = AMDOrdering<typename _MatrixType::Index> > class SimplicialLLT;
+template<typename _MatrixType, int _UpLo = Lower, typename _Ordering = AMDOrdering<typename _MatrixType::Index> > class SimplicialLDLT;
+template<typename _MatrixType, int _UpLo = Lower, typename _Ordering = AMDOrdering<typename _MatrixType::Index> > class SimplicialCholesky;
 
 namespace internal {
 
-template<typename _MatrixType, int _UpLo> struct traits<SimplicialLLT<_MatrixType,_UpLo> >
+template<typename _MatrixType, int _UpLo, typename _Ordering> struct traits<SimplicialLLT<_MatrixType,_UpLo,_Ordering> >
 {
   typedef _MatrixType MatrixType;
+  typedef _Ordering OrderingType;
   enum { UpLo = _UpLo };
   typedef typename MatrixType::Scalar                         Scalar;
   typedef typename MatrixType::Index                          Index;
@@ -320,9 +388,10 @@ template<typename _MatrixType, int _UpLo> struct traits<SimplicialLLT<_MatrixTyp
   static inline MatrixU getU(const MatrixType& m) { return m.adjoint(); }
 };
 
-template<typename _MatrixType,int _UpLo> struct traits<SimplicialLDLT<_MatrixType,_UpLo> >
+template<typename _MatrixType, int _UpLo, typename _Ordering> struct traits<SimplicialLDLT<_MatrixType,_UpLo,_Ordering> >
 {
   typedef _MatrixType MatrixType;
+  typedef _Ordering OrderingType;
   enum { UpLo = _UpLo };
   typedef typename MatrixType::Scalar                             Scalar;
   typedef typename MatrixType::Index                              Index;
@@ -333,9 +402,10 @@ template<typename _MatrixType,int _UpLo> struct traits<SimplicialLDLT<_MatrixTyp
   static inline MatrixU getU(const MatrixType& m) { return m.adjoint(); }
 };
 
-template<typename _MatrixType, int _UpLo> struct traits<SimplicialCholesky<_MatrixType,_UpLo> >
+template<typename _MatrixType, int _UpLo, typename _Ordering> struct traits<SimplicialCholesky<_MatrixType,_UpLo,_Ordering> >
 {
   typedef _MatrixType MatrixType;
+  typedef _Ordering OrderingType;
   enum { UpLo = _UpLo };
 };
 
@@ -355,11 +425,13 @@ template<typename _MatrixType, int _UpLo> struct traits<SimplicialCholesky<_Matr
   * \tparam _MatrixType the type of the sparse matrix A, it must be a SparseMatrix<>
   * \tparam _UpLo the triangular part that will be used for the computations. It can be Lower
   *               or Upper. Default is Lower.
+  * \tparam _Ordering the fill-in reducing ordering functor: AMDOrdering (default), NestedDissectionOrdering,
+  *                   RCMOrdering or NaturalOrdering.
   *
-  * \sa class SimplicialLDLT
+  * \sa class SimplicialLDLT, class AMDOrdering, class NestedDissectionOrdering
   */
-template<typename _MatrixType, int _UpLo>
-    class SimplicialLLT : public SimplicialCholeskyBase<SimplicialLLT<_MatrixType,_UpLo> >
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+    class SimplicialLLT : public SimplicialCholeskyBase<SimplicialLLT<_MatrixType,_UpLo,_Ordering> >
 {
 public:
     typedef _MatrixType MatrixType;
@@ -443,11 +515,13 @@ public:
   * \tparam _MatrixType the type of the sparse matrix A, it must be a SparseMatrix<>
   * \tparam _UpLo the triangular part that will be used for the computations. It can be Lower
   *               or Upper. Default is Lower.
+  * \tparam _Ordering the fill-in reducing ordering functor: AMDOrdering (default), NestedDissectionOrdering,
+  *                   RCMOrdering or NaturalOrdering.
   *
-  * \sa class SimplicialLLT
+  * \sa class SimplicialLLT, class AMDOrdering, class NestedDissectionOrdering
   */
-template<typename _MatrixType, int _UpLo>
-    class SimplicialLDLT : public SimplicialCholeskyBase<SimplicialLDLT<_MatrixType,_UpLo> >
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+    class SimplicialLDLT : public SimplicialCholeskyBase<SimplicialLDLT<_MatrixType,_UpLo,_Ordering> >
 {
 public:
     typedef _MatrixType MatrixType;
@@ -528,8 +602,8 @@ public:
   *
   * \sa class SimplicialLDLT, class SimplicialLLT
   */
-template<typename _MatrixType, int _UpLo>
-    class SimplicialCholesky : public SimplicialCholeskyBase<SimplicialCholesky<_MatrixType,_UpLo> >
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+    class SimplicialCholesky : public SimplicialCholeskyBase<SimplicialCholesky<_MatrixType,_UpLo,_Ordering> >
 {
 public:
     typedef _MatrixType MatrixType;
@@ -541,8 +615,8 @@ public:
     typedef SparseMatrix<Scalar,ColMajor,Index> CholMatrixType;
     typedef Matrix<Scalar,Dynamic,1> VectorType;
     typedef internal::traits<SimplicialCholesky> Traits;
-    typedef internal::traits<SimplicialLDLT<MatrixType,UpLo> > LDLTTraits;
-    typedef internal::traits<SimplicialLLT<MatrixType,UpLo>  > LLTTraits;
+    typedef internal::traits<SimplicialLDLT<MatrixType,UpLo,_Ordering> > LDLTTraits;
+    typedef internal::traits<SimplicialLLT<MatrixType,UpLo,_Ordering>  > LLTTraits;
   public:
     SimplicialCholesky() : Base(), m_LDLT(true) {}
 
@@ -669,28 +743,94 @@ public:
 };
 
 template<typename Derived>
-void SimplicialCholeskyBase<Derived>::ordering(const MatrixType& a, CholMatrixType& ap)
+void SimplicialCholeskyBase<Derived>::ordering(const MatrixType& a)
 {
   eigen_assert(a.rows()==a.cols());
   const Index size = a.rows();
-  // TODO allows to configure the permutation
-  // Note that amd compute the inverse permutation
-  {
-    CholMatrixType C;
-    C = a.template selfadjointView<UpLo>();
-    // remove diagonal entries:
-    // seems not to be needed
-    // C.prune(keep_diag());
-    internal::minimum_degree_ordering(C, m_Pinv);
-  }
+  // Note that the ordering methods compute the inverse permutation
+  m_ordering(a.template selfadjointView<UpLo>(), m_Pinv);
 
   if(m_Pinv.size()>0)
     m_P = m_Pinv.inverse();
   else
     m_P.resize(0);
+  const Index* perm = m_P.size()>0 ? m_P.indices().data() : 0;
+
+  // Build the pattern of the upper triangular part of P A P^-1 as done by twistedBy(),
+  // and record where each coefficient of A goes such that factorize() only has to copy the values.
+  Index nnz = 0;
+  m_ap.resize(size,size);
+  Index* count = m_ap.outerIndexPtr();
+  for(Index j = 0; j < size+1; ++j)
+    count[j] = 0;
+  for(Index j = 0; j < a.outerSize(); ++j)
+    for(typename MatrixType::InnerIterator it(a,j); it; ++it)
+    {
+      Index i = it.row(), k = it.col();
+      if((int(UpLo)==int(Lower) && i<k) || (int(UpLo)==int(Upper) && i>k))
+        continue;
+      Index ip = perm ? perm[i] : i;
+      Index kp = perm ? perm[k] : k;
+      ++count[(std::max)(ip,kp)+1];
+      ++nnz;
+    }
+  for(Index j = 0; j < size; ++j)
+    count[j+1] += count[j];
+  m_ap.resizeNonZeros(nnz);
+  m_apMap.resize(nnz);
+
+  ei_declare_aligned_stack_constructed_variable(Index, pos, size, 0);
+  for(Index j = 0; j < size; ++j)
+    pos[j] = count[j];
+  Index* Api = m_ap.innerIndexPtr();
+  Index q = 0;
+  for(Index j = 0; j < a.outerSize(); ++j)
+    for(typename MatrixType::InnerIterator it(a,j); it; ++it)
+    {
+      Index i = it.row(), k = it.col();
+      if((int(UpLo)==int(Lower) && i<k) || (int(UpLo)==int(Upper) && i>k))
+        continue;
+      Index ip = perm ? perm[i] : i;
+      Index kp = perm ? perm[k] : k;
+      Index p = pos[(std::max)(ip,kp)]++;
+      Api[p] = (std::min)(ip,kp);
+      // A(i,k) is stored at P(ip,kp), its conjugate is stored if the entry moved to the other triangular part
+      m_apMap[q++] = ip<=kp ? p : -1-p;
+    }
+  permuteValues(a);
+}
 
-  ap.resize(size,size);
-  ap.template selfadjointView<Upper>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+/** \internal Copies the values of \a a into m_ap through the cached value map. Every coefficient
+  * is checked against the analyzed pattern: \returns false, leaving m_ap partially filled, if the
+  * pattern of \a a differs from the one given to analyzePattern(). */
+template<typename Derived>
+bool SimplicialCholeskyBase<Derived>::permuteValues(const MatrixType& a)
+{
+  const Index nnz = m_apMap.size();
+  const Index* perm = m_P.size()>0 ? m_P.indices().data() : 0;
+  const Index* Ap = m_ap.outerIndexPtr();
+  const Index* Api = m_ap.innerIndexPtr();
+  Scalar* Apx = m_ap.valuePtr();
+  Index q = 0;
+  for(Index j = 0; j < a.outerSize(); ++j)
+    for(typename MatrixType::InnerIterator it(a,j); it; ++it)
+    {
+      Index i = it.row(), k = it.col();
+      if((int(UpLo)==int(Lower) && i<k) || (int(UpLo)==int(Upper) && i>k))
+        continue;
+      if(q==nnz)
+        return false;
+      Index ip = perm ? perm[i] : i;
+      Index kp = perm ? perm[k] : k;
+      Index p = m_apMap[q++];
+      Index pp = p>=0 ? p : -1-p;
+      Index col = (std::max)(ip,kp);
+      if(pp<Ap[col] || pp>=Ap[col+1] || Api[pp]!=(std::min)(ip,kp) || (p>=0)!=(ip<=kp))
+        return false;
+      if(p>=0) Apx[p] = it.value();
+      else     Apx[pp] = internal::conj(it.value());
+    }
+  return q==nnz;
 }
 
 template<typename Derived>
@@ -734,6 +874,10 @@ void SimplicialCholeskyBase<Derived>::analyzePattern_preordered(const CholMatrix
     Lp[k+1] = Lp[k] + m_nonZerosPerCol[k] + (doLDLT ? 0 : 1);
 
   m_matrix.resizeNonZeros(Lp[size]);
+  m_diag.resize(doLDLT ? size : 0);
+  m_workValues.resize(size);
+  m_workIndices.resize(2*size);
+  m_levelsOk = false;
   
   m_isInitialized     = true;
   m_info              = Success;
@@ -756,9 +900,11 @@ void SimplicialCholeskyBase<Derived>::factorize_preordered(const CholMatrixType&
   Index* Li = m_matrix.innerIndexPtr();
   Scalar* Lx = m_matrix.valuePtr();
 
-  ei_declare_aligned_stack_constructed_variable(Scalar, y, size, 0);
-  ei_declare_aligned_stack_constructed_variable(Index,  pattern, size, 0);
-  ei_declare_aligned_stack_constructed_variable(Index,  tags, size, 0);
+  // the workspaces and the factor have been allocated by analyzePattern_preordered()
+  eigen_assert(m_workValues.size()==size && m_workIndices.size()==2*size);
+  Scalar* y = m_workValues.data();
+  Index* pattern = m_workIndices.data();
+  Index* tags = pattern + size;
   
   bool ok = true;
   m_diag.resize(DoLDLT ? size : 0);
@@ -836,6 +982,14 @@ void SimplicialCholeskyBase<Derived>::factorize_preordered(const CholMatrixType&
 
   m_info = ok ? Success : NumericalIssue;
   m_factorizationIsOk = true;
+
+  // The pattern of L is complete after the first successful factorization, it is analyzed once
+  // for the multithreaded triangular solves.
+  if(ok && !m_levelsOk && nbThreads()>1)
+  {
+    m_levels.analyzePattern(m_matrix, true);
+    m_levelsOk = m_levels.isLevelScheduled() || m_levels.isAdjointLevelScheduled();
+  }
 }
 
 namespace internal {
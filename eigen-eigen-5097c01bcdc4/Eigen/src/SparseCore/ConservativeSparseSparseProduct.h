@@ -14,105 +14,99 @@ namespace Eigen {
 
 namespace internal {
 
+// Two pass product: the first pass counts the nonzeros of each result vector such that the second one can
+// directly fill the compressed storage of res. Both passes are distributed over the result vectors, each thread
+// using its own dense accumulator. If sortedInner is true, the inner indices of each result vector are sorted.
 template<typename Lhs, typename Rhs, typename ResultType>
-static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res)
+static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res, bool sortedInner = false)
 {
   typedef typename remove_all<Lhs>::type::Scalar Scalar;
-  typedef typename remove_all<Lhs>::type::Index Index;
+  typedef typename ResultType::Index Index;
 
   // make sure to call innerSize/outerSize since we fake the storage order.
   Index rows = lhs.innerSize();
   Index cols = rhs.outerSize();
   eigen_assert(lhs.outerSize() == rhs.innerSize());
+  eigen_assert(res.innerSize() == rows && res.outerSize() == cols);
 
-  std::vector<bool> mask(rows,false);
-  Matrix<Scalar,Dynamic,1> values(rows);
-  Matrix<Index,Dynamic,1>  indices(rows);
-
-  // estimate the number of non zero entries
-  // given a rhs column containing Y non zeros, we assume that the respective Y columns
-  // of the lhs differs in average of one non zeros, thus the number of non zeros for
-  // the product of a rhs column with the lhs is X+Y where X is the average number of non zero
-  // per column of the lhs.
-  // Therefore, we have nnz(lhs*rhs) = nnz(lhs) + nnz(rhs)
-  Index estimated_nnz_prod = lhs.nonZeros() + rhs.nonZeros();
-
-  res.setZero();
-  res.reserve(Index(estimated_nnz_prod));
-  // we compute each column of the result, one after the other
-  for (Index j=0; j<cols; ++j)
-  {
+  const Index threads = sparse_product_threads<Index>(cols, lhs.nonZeros() + rhs.nonZeros());
+  EIGEN_UNUSED_VARIABLE(threads);
 
-    res.startVec(j);
-    Index nnz = 0;
-    for (typename Rhs::InnerIterator rhsIt(rhs, j); rhsIt; ++rhsIt)
+  // discard the previous content and make sure res is compressed
+  res.resize(res.rows(), res.cols());
+  Index* outerIndex = res.outerIndexPtr();
+
+  // 1 - symbolic pass: outerIndex[j+1] = number of nonzeros of the j-th result vector
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel num_threads(threads) if(threads>1)
+#endif
+  {
+    Matrix<Index,Dynamic,1> mask = Matrix<Index,Dynamic,1>::Constant(rows,-1);
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp for schedule(dynamic,32)
+#endif
+    for (Index j=0; j<cols; ++j)
     {
-      Scalar y = rhsIt.value();
-      Index k = rhsIt.index();
-      for (typename Lhs::InnerIterator lhsIt(lhs, k); lhsIt; ++lhsIt)
-      {
-        Index i = lhsIt.index();
-        Scalar x = lhsIt.value();
-        if(!mask[i])
+      Index nnz = 0;
+      for (typename Rhs::InnerIterator rhsIt(rhs, j); rhsIt; ++rhsIt)
+        for (typename Lhs::InnerIterator lhsIt(lhs, rhsIt.index()); lhsIt; ++lhsIt)
         {
-          mask[i] = true;
-          values[i] = x * y;
-          indices[nnz] = i;
-          ++nnz;
+          Index i = lhsIt.index();
+          if(mask[i]!=j)
+          {
+            mask[i] = j;
+            ++nnz;
+          }
         }
-        else
-          values[i] += x * y;
-      }
-    }
-
-    // unordered insertion
-    for(int k=0; k<nnz; ++k)
-    {
-      int i = indices[k];
-      res.insertBackByOuterInnerUnordered(j,i) = values[i];
-      mask[i] = false;
+      outerIndex[j+1] = nnz;
     }
+  }
 
-#if 0
-    // alternative ordered insertion code:
-
-    int t200 = rows/(log2(200)*1.39);
-    int t = (rows*100)/139;
-
-    // FIXME reserve nnz non zeros
-    // FIXME implement fast sort algorithms for very small nnz
-    // if the result is sparse enough => use a quick sort
-    // otherwise => loop through the entire vector
-    // In order to avoid to perform an expensive log2 when the
-    // result is clearly very sparse we use a linear bound up to 200.
-    //if((nnz<200 && nnz<t200) || nnz * log2(nnz) < t)
-    //res.startVec(j);
-    if(true)
-    {
-      if(nnz>1) std::sort(indices.data(),indices.data()+nnz);
-      for(int k=0; k<nnz; ++k)
-      {
-        int i = indices[k];
-        res.insertBackByOuterInner(j,i) = values[i];
-        mask[i] = false;
-      }
-    }
-    else
+  outerIndex[0] = 0;
+  for (Index j=0; j<cols; ++j)
+    outerIndex[j+1] += outerIndex[j];
+  if(outerIndex[cols]==0)
+    return;
+  res.resizeNonZeros(outerIndex[cols]);
+  Index* innerIndex = res.innerIndexPtr();
+  typename ResultType::Scalar* resValues = res.valuePtr();
+
+  // 2 - numeric pass
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel num_threads(threads) if(threads>1)
+#endif
+  {
+    Matrix<Index,Dynamic,1> mask = Matrix<Index,Dynamic,1>::Constant(rows,-1);
+    Matrix<Scalar,Dynamic,1> values(rows);
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp for schedule(dynamic,32)
+#endif
+    for (Index j=0; j<cols; ++j)
     {
-      // dense path
-      for(int i=0; i<rows; ++i)
+      Index p = outerIndex[j];
+      for (typename Rhs::InnerIterator rhsIt(rhs, j); rhsIt; ++rhsIt)
       {
-        if(mask[i])
+        Scalar y = rhsIt.value();
+        for (typename Lhs::InnerIterator lhsIt(lhs, rhsIt.index()); lhsIt; ++lhsIt)
         {
-          mask[i] = false;
-          res.insertBackByOuterInner(j,i) = values[i];
+          Index i = lhsIt.index();
+          Scalar x = lhsIt.value();
+          if(mask[i]!=j)
+          {
+            mask[i] = j;
+            values[i] = x * y;
+            innerIndex[p++] = i;
+          }
+          else
+            values[i] += x * y;
         }
       }
+      if(sortedInner)
+        std::sort(innerIndex+outerIndex[j], innerIndex+p);
+      for (Index k=outerIndex[j]; k<p; ++k)
+        resValues[k] = values[innerIndex[k]];
     }
-#endif
-
   }
-  res.finalize();
 }
 
 
@@ -134,13 +128,10 @@ struct conservative_sparse_sparse_product_selector<Lhs,Rhs,ResultType,ColMajor,C
 
   static void run(const Lhs& lhs, const Rhs& rhs, ResultType& res)
   {
-    typedef SparseMatrix<typename ResultType::Scalar,RowMajor> RowMajorMatrix;
     typedef SparseMatrix<typename ResultType::Scalar,ColMajor> ColMajorMatrix;
     ColMajorMatrix resCol(lhs.rows(),rhs.cols());
-    internal::conservative_sparse_sparse_product_impl<Lhs,Rhs,ColMajorMatrix>(lhs, rhs, resCol);
-    // sort the non zeros:
-    RowMajorMatrix resRow(resCol);
-    res = resRow;
+    internal::conservative_sparse_sparse_product_impl<Lhs,Rhs,ColMajorMatrix>(lhs, rhs, resCol, true);
+    res = resCol;
   }
 };
 
@@ -229,12 +220,9 @@ struct conservative_sparse_sparse_product_selector<Lhs,Rhs,ResultType,RowMajor,R
   static void run(const Lhs& lhs, const Rhs& rhs, ResultType& res)
   {
     typedef SparseMatrix<typename ResultType::Scalar,RowMajor> RowMajorMatrix;
-    typedef SparseMatrix<typename ResultType::Scalar,ColMajor> ColMajorMatrix;
     RowMajorMatrix resRow(lhs.rows(),rhs.cols());
-    internal::conservative_sparse_sparse_product_impl<Rhs,Lhs,RowMajorMatrix>(rhs, lhs, resRow);
-    // sort the non zeros:
-    ColMajorMatrix resCol(resRow);
-    res = resCol;
+    internal::conservative_sparse_sparse_product_impl<Rhs,Lhs,RowMajorMatrix>(rhs, lhs, resRow, true);
+    res = resRow;
   }
 };
 
@@ -0,0 +1,146 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSECONVERSION_H
+#define EIGEN_SPARSECONVERSION_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * \returns the number of nonzeros of \a mat when it is cheap to get, and 0 otherwise (e.g., for a coefficient wise
+  * expression). It is only used to decide whether a conversion is worth running in parallel. */
+template<typename T>
+inline DenseIndex sparse_nonzeros_hint(const T&) { return 0; }
+
+template<typename Scalar, int Options, typename Index>
+inline DenseIndex sparse_nonzeros_hint(const SparseMatrix<Scalar,Options,Index>& mat) { return mat.nonZeros(); }
+
+template<typename Scalar, int Options, typename Index>
+inline DenseIndex sparse_nonzeros_hint(const MappedSparseMatrix<Scalar,Options,Index>& mat) { return mat.nonZeros(); }
+
+template<typename MatrixType>
+inline DenseIndex sparse_nonzeros_hint(const Transpose<MatrixType>& mat) { return sparse_nonzeros_hint(mat.nestedExpression()); }
+
+// Visitors of the entries generated by the emitters of sparse_bucket_assign: the first pass counts them per
+// destination vector, the second one writes them at the positions computed from the counts.
+template<typename Index>
+struct sparse_bucket_counter
+{
+  sparse_bucket_counter(Index* count) : m_count(count) {}
+  template<typename Scalar>
+  inline void operator()(Index outer, Index, const Scalar&) { ++m_count[outer]; }
+  Index* m_count;
+};
+
+template<typename Index, typename Scalar>
+struct sparse_bucket_filler
+{
+  sparse_bucket_filler(Index* pos, Index* inner, Scalar* values) : m_pos(pos), m_inner(inner), m_values(values) {}
+  inline void operator()(Index outer, Index inner, const Scalar& value)
+  {
+    Index k = m_pos[outer]++;
+    m_inner[k] = inner;
+    m_values[k] = value;
+  }
+  Index* m_pos;
+  Index* m_inner;
+  Scalar* m_values;
+};
+
+/** \internal
+  * Counting sort filling the compressed storage of \a dest from \a srcOuterSize source vectors. For each source
+  * vector j, emitter(j,visitor) calls visitor(outer,inner,value) once per entry it generates in \a dest, which must
+  * already have its final size. \a work is the number of generated entries, or an estimate of it.
+  *
+  * The source vectors are split into contiguous blocks processed in parallel: each block counts its entries per
+  * destination vector, and then writes them right after those of the previous blocks. The result is thus the one
+  * of the sequential algorithm, whatever the number of threads. Since each block has a counter per destination
+  * vector, the number of blocks is also bounded such that the counters do not outgrow the result.
+  */
+template<typename Emitter, typename DestType>
+void sparse_bucket_assign(const Emitter& emitter, typename DestType::Index srcOuterSize, DestType& dest,
+                          typename DestType::Index work)
+{
+  typedef typename DestType::Index Index;
+  typedef typename DestType::Scalar Scalar;
+  const Index outerSize = dest.outerSize();
+  Index blocks = sparse_product_threads<Index>(srcOuterSize, work);
+  blocks = (std::max)(Index(1), (std::min)(blocks, work/(std::max)(outerSize,Index(1))));
+  EIGEN_UNUSED_VARIABLE(blocks);
+
+  // 1 - count the entries of each block per destination vector
+  Matrix<Index,Dynamic,Dynamic> offsets(outerSize, blocks);
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel for num_threads(blocks) if(blocks>1) schedule(static,1)
+#endif
+  for(Index b=0; b<blocks; ++b)
+  {
+    offsets.col(b).setZero();
+    sparse_bucket_counter<Index> counter(&offsets.coeffRef(0,b));
+    for(Index j=srcOuterSize*b/blocks; j<srcOuterSize*(b+1)/blocks; ++j)
+      emitter(j, counter);
+  }
+
+  // 2 - prefix sum over the destination vectors, and then over the blocks within each of them
+  Index* outerIndex = dest.outerIndexPtr();
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel for num_threads(blocks) if(blocks>1) schedule(static)
+#endif
+  for(Index i=0; i<outerSize; ++i)
+    outerIndex[i+1] = offsets.row(i).sum();
+  outerIndex[0] = 0;
+  for(Index i=0; i<outerSize; ++i)
+    outerIndex[i+1] += outerIndex[i];
+  dest.resizeNonZeros(outerIndex[outerSize]);
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel for num_threads(blocks) if(blocks>1) schedule(static)
+#endif
+  for(Index i=0; i<outerSize; ++i)
+  {
+    Index pos = outerIndex[i];
+    for(Index b=0; b<blocks; ++b)
+    {
+      Index tmp = offsets(i,b);
+      offsets(i,b) = pos;
+      pos += tmp;
+    }
+  }
+
+  // 3 - copy
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel for num_threads(blocks) if(blocks>1) schedule(static,1)
+#endif
+  for(Index b=0; b<blocks; ++b)
+  {
+    sparse_bucket_filler<Index,Scalar> filler(&offsets.coeffRef(0,b), dest.innerIndexPtr(), dest.valuePtr());
+    for(Index j=srcOuterSize*b/blocks; j<srcOuterSize*(b+1)/blocks; ++j)
+      emitter(j, filler);
+  }
+}
+
+// emits the entries of the j-th vector of mat at the transposed position
+template<typename MatrixType>
+struct sparse_transpose_emitter
+{
+  typedef typename MatrixType::Index Index;
+  sparse_transpose_emitter(const MatrixType& mat) : m_mat(mat) {}
+  template<typename Visitor>
+  inline void operator()(Index j, Visitor& visitor) const
+  {
+    for(typename MatrixType::InnerIterator it(m_mat, j); it; ++it)
+      visitor(it.index(), j, it.value());
+  }
+  const MatrixType& m_mat;
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSECONVERSION_H
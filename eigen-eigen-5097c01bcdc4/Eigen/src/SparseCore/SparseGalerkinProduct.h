@@ -0,0 +1,179 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSEGALERKINPRODUCT_H
+#define EIGEN_SPARSEGALERKINPRODUCT_H
+
+namespace Eigen {
+
+namespace internal {
+
+// Computes res = Pt * A * P column by column: the j-th column of A*P is accumulated in a dense workspace, and
+// is directly multiplied by Pt, such that A*P is never stored. P, Pt and A must be column major.
+// As for the sparse product, a symbolic pass computes the structure of res, and the numeric pass fills it in
+// parallel with sorted inner indices.
+template<typename PType, typename PtType, typename AType, typename ResultType>
+void sparse_galerkin_product_impl(const PType& P, const PtType& Pt, const AType& A, ResultType& res)
+{
+  typedef typename ResultType::Scalar Scalar;
+  typedef typename ResultType::Index Index;
+
+  const Index n = P.cols();
+  const Index m = A.rows();
+  eigen_assert(res.rows()==n && res.cols()==n);
+
+  const Index threads = sparse_product_threads<Index>(n, A.nonZeros() + P.nonZeros());
+  EIGEN_UNUSED_VARIABLE(threads);
+
+  res.resize(n, n);
+  Index* outerIndex = res.outerIndexPtr();
+
+  // 1 - symbolic pass
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel num_threads(threads) if(threads>1)
+#endif
+  {
+    Matrix<Index,Dynamic,1> maskAP = Matrix<Index,Dynamic,1>::Constant(m,-1);
+    Matrix<Index,Dynamic,1> maskRes = Matrix<Index,Dynamic,1>::Constant(n,-1);
+    Matrix<Index,Dynamic,1> patternAP(m);
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp for schedule(dynamic,32)
+#endif
+    for(Index j=0; j<n; ++j)
+    {
+      Index nnzAP = 0;
+      for(typename PType::InnerIterator pIt(P, j); pIt; ++pIt)
+        for(typename AType::InnerIterator aIt(A, pIt.index()); aIt; ++aIt)
+        {
+          Index k = aIt.index();
+          if(maskAP[k]!=j)
+          {
+            maskAP[k] = j;
+            patternAP[nnzAP++] = k;
+          }
+        }
+      Index nnz = 0;
+      for(Index q=0; q<nnzAP; ++q)
+        for(typename PtType::InnerIterator ptIt(Pt, patternAP[q]); ptIt; ++ptIt)
+        {
+          Index i = ptIt.index();
+          if(maskRes[i]!=j)
+          {
+            maskRes[i] = j;
+            ++nnz;
+          }
+        }
+      outerIndex[j+1] = nnz;
+    }
+  }
+
+  outerIndex[0] = 0;
+  for(Index j=0; j<n; ++j)
+    outerIndex[j+1] += outerIndex[j];
+  if(outerIndex[n]==0)
+    return;
+  res.resizeNonZeros(outerIndex[n]);
+  Index* innerIndex = res.innerIndexPtr();
+  Scalar* resValues = res.valuePtr();
+
+  // 2 - numeric pass
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel num_threads(threads) if(threads>1)
+#endif
+  {
+    Matrix<Index,Dynamic,1> maskAP = Matrix<Index,Dynamic,1>::Constant(m,-1);
+    Matrix<Index,Dynamic,1> maskRes = Matrix<Index,Dynamic,1>::Constant(n,-1);
+    Matrix<Index,Dynamic,1> patternAP(m);
+    Matrix<Scalar,Dynamic,1> valuesAP(m);
+    Matrix<Scalar,Dynamic,1> values(n);
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp for schedule(dynamic,32)
+#endif
+    for(Index j=0; j<n; ++j)
+    {
+      // column j of A*P
+      Index nnzAP = 0;
+      for(typename PType::InnerIterator pIt(P, j); pIt; ++pIt)
+      {
+        Scalar y = pIt.value();
+        for(typename AType::InnerIterator aIt(A, pIt.index()); aIt; ++aIt)
+        {
+          Index k = aIt.index();
+          if(maskAP[k]!=j)
+          {
+            maskAP[k] = j;
+            valuesAP[k] = aIt.value() * y;
+            patternAP[nnzAP++] = k;
+          }
+          else
+            valuesAP[k] += aIt.value() * y;
+        }
+      }
+      // column j of Pt*(A*P)
+      Index p = outerIndex[j];
+      for(Index q=0; q<nnzAP; ++q)
+      {
+        Scalar y = valuesAP[patternAP[q]];
+        for(typename PtType::InnerIterator ptIt(Pt, patternAP[q]); ptIt; ++ptIt)
+        {
+          Index i = ptIt.index();
+          if(maskRes[i]!=j)
+          {
+            maskRes[i] = j;
+            values[i] = ptIt.value() * y;
+            innerIndex[p++] = i;
+          }
+          else
+            values[i] += ptIt.value() * y;
+        }
+      }
+      std::sort(innerIndex+outerIndex[j], innerIndex+p);
+      for(Index k=outerIndex[j]; k<p; ++k)
+        resValues[k] = values[innerIndex[k]];
+    }
+  }
+}
+
+} // end namespace internal
+
+/** \ingroup SparseCore_Module
+  *
+  * Computes the Galerkin triple product \a res = P^* A P of the sparse matrices \a P and \a A, as needed to build
+  * the coarse operators of algebraic multigrid methods or the projection of \a A onto the subspace spanned by the
+  * columns of \a P. For real scalars, P^* is simply P^T.
+  *
+  * The product is fused: each column of A P is multiplied by P^* as soon as it is computed, so A P is never
+  * stored. The computation is multithreaded when OpenMP is enabled (see nbThreads()), and the inner indices
+  * of \a res are sorted.
+  *
+  * \a A must be a square matrix with as many rows as \a P. The best performance is obtained when \a A and \a P
+  * are column major, otherwise column major copies are created. \a res can be the same object as \a A or \a P.
+  */
+template<typename PDerived, typename ADerived, typename Scalar, int Options, typename Index>
+void galerkinProduct(const SparseMatrixBase<PDerived>& P, const SparseMatrixBase<ADerived>& A,
+                     SparseMatrix<Scalar,Options,Index>& res)
+{
+  typedef SparseMatrix<Scalar,ColMajor,Index> ColMajorMatrix;
+  typedef typename internal::conditional<bool(PDerived::IsRowMajor), ColMajorMatrix, const PDerived&>::type PNested;
+  typedef typename internal::conditional<bool(ADerived::IsRowMajor), ColMajorMatrix, const ADerived&>::type ANested;
+  typedef typename internal::remove_all<PNested>::type PCleaned;
+  typedef typename internal::remove_all<ANested>::type ACleaned;
+
+  eigen_assert(A.rows()==A.cols() && A.rows()==P.rows() && "galerkinProduct: invalid matrix sizes");
+  PNested Pc(P.derived());
+  ANested Ac(A.derived());
+  // the rows of P are the columns of P^*
+  ColMajorMatrix Pt(P.adjoint());
+
+  ColMajorMatrix resCol(P.cols(), P.cols());
+  internal::sparse_galerkin_product_impl<PCleaned,ColMajorMatrix,ACleaned,ColMajorMatrix>(Pc, Pt, Ac, resCol);
+  res = resCol;
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSEGALERKINPRODUCT_H
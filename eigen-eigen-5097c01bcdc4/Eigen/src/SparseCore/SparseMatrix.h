@@ -443,27 +443,30 @@ class SparseMatrix
       if(isCompressed())
         return;
       
-      Index oldStart = m_outerIndex[1];
-      m_outerIndex[1] = m_innerNonZeros[0];
-      for(Index j=1; j<m_outerSize; ++j)
+      // the nonzeros are copied to a new storage of the exact size, which squeeze() would allocate anyway
+      Index* outerIndex = new Index[m_outerSize+1];
+      outerIndex[0] = 0;
+      for(Index j=0; j<m_outerSize; ++j)
+        outerIndex[j+1] = outerIndex[j] + m_innerNonZeros[j];
+      Storage data;
+      data.resize(outerIndex[m_outerSize]);
+
+      const Index threads = internal::sparse_product_threads<Index>(m_outerSize, outerIndex[m_outerSize]);
+      EIGEN_UNUSED_VARIABLE(threads);
+#ifdef EIGEN_HAS_OPENMP
+      #pragma omp parallel for num_threads(threads) if(threads>1) schedule(static)
+#endif
+      for(Index j=0; j<m_outerSize; ++j)
       {
-        Index nextOldStart = m_outerIndex[j+1];
-        std::ptrdiff_t offset = oldStart - m_outerIndex[j];
-        if(offset>0)
-        {
-          for(Index k=0; k<m_innerNonZeros[j]; ++k)
-          {
-            m_data.index(m_outerIndex[j]+k) = m_data.index(oldStart+k);
-            m_data.value(m_outerIndex[j]+k) = m_data.value(oldStart+k);
-          }
-        }
-        m_outerIndex[j+1] = m_outerIndex[j] + m_innerNonZeros[j];
-        oldStart = nextOldStart;
+        const Index start = m_outerIndex[j];
+        std::copy(&m_data.index(start), &m_data.index(start)+m_innerNonZeros[j], &data.index(outerIndex[j]));
+        std::copy(&m_data.value(start), &m_data.value(start)+m_innerNonZeros[j], &data.value(outerIndex[j]));
       }
+      delete[] m_outerIndex;
+      m_outerIndex = outerIndex;
       delete[] m_innerNonZeros;
       m_innerNonZeros = 0;
-      m_data.resize(m_outerIndex[m_outerSize]);
-      m_data.squeeze();
+      m_data.swap(data);
     }
 
     /** Suppresses all nonzeros which are \b much \b smaller \b than \a reference under the tolerence \a epsilon */
@@ -648,37 +651,8 @@ class SparseMatrix
         OtherCopy otherCopy(other.derived());
 
         SparseMatrix dest(other.rows(),other.cols());
-        Eigen::Map<Matrix<Index, Dynamic, 1> > (dest.m_outerIndex,dest.outerSize()).setZero();
-
-        // pass 1
-        // FIXME the above copy could be merged with that pass
-        for (Index j=0; j<otherCopy.outerSize(); ++j)
-          for (typename _OtherCopy::InnerIterator it(otherCopy, j); it; ++it)
-            ++dest.m_outerIndex[it.index()];
-
-        // prefix sum
-        Index count = 0;
-        VectorXi positions(dest.outerSize());
-        for (Index j=0; j<dest.outerSize(); ++j)
-        {
-          Index tmp = dest.m_outerIndex[j];
-          dest.m_outerIndex[j] = count;
-          positions[j] = count;
-          count += tmp;
-        }
-        dest.m_outerIndex[dest.outerSize()] = count;
-        // alloc
-        dest.m_data.resize(count);
-        // pass 2
-        for (Index j=0; j<otherCopy.outerSize(); ++j)
-        {
-          for (typename _OtherCopy::InnerIterator it(otherCopy, j); it; ++it)
-          {
-            Index pos = positions[it.index()]++;
-            dest.m_data.index(pos) = j;
-            dest.m_data.value(pos) = it.value();
-          }
-        }
+        internal::sparse_bucket_assign(internal::sparse_transpose_emitter<_OtherCopy>(otherCopy), otherCopy.outerSize(),
+                                       dest, Index(internal::sparse_nonzeros_hint(otherCopy)));
         this->swap(dest);
         return *this;
       }
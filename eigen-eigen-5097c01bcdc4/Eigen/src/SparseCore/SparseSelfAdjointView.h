@@ -195,8 +195,131 @@ struct traits<SparseSelfAdjointTimeDenseProduct<Lhs,Rhs,UpLo> >
 {
   typedef Dense StorageKind;
 };
+
+/** \internal
+  * Adds alpha times the product of the outer vector \a j of the stored triangle of \a lhs with the column \a c of
+  * \a rhs: the coefficients gathered into res(j,c) are accumulated in a register, and the transposed ones are
+  * scattered into \a scatter, which is either the column \a c of \a res or a per thread partial result. */
+template<int UpLo, typename Lhs, typename Rhs, typename Dest, typename ScatterType>
+inline void sparse_selfadjoint_time_dense_outer(const Lhs& lhs, const Rhs& rhs, Dest& res, ScatterType& scatter,
+                                                typename Lhs::Index j, typename Lhs::Index c,
+                                                const typename Dest::Scalar& alpha)
+{
+  typedef typename Lhs::Index Index;
+  typedef typename Dest::Scalar Scalar;
+  typedef typename Lhs::InnerIterator LhsInnerIterator;
+  enum {
+    LhsIsRowMajor = (Lhs::Flags&RowMajorBit)==RowMajorBit,
+    ProcessFirstHalf =
+             ((UpLo&(Upper|Lower))==(Upper|Lower))
+          || ( (UpLo&Upper) && !LhsIsRowMajor)
+          || ( (UpLo&Lower) && LhsIsRowMajor),
+    ProcessSecondHalf = !ProcessFirstHalf
+  };
+  const Scalar xj = alpha * rhs.coeff(j,c);
+  Scalar tmp(0);
+  LhsInnerIterator i(lhs,j);
+  if (ProcessSecondHalf)
+  {
+    while (i && i.index()<j) ++i;
+    if(i && i.index()==j)
+    {
+      tmp += i.value() * rhs.coeff(j,c);
+      ++i;
+    }
+  }
+  for(; (ProcessFirstHalf ? i && i.index() < j : i) ; ++i)
+  {
+    const Index k = i.index();
+    const Scalar v = i.value();
+    if(LhsIsRowMajor)
+    {
+      tmp += v * rhs.coeff(k,c);
+      scatter.coeffRef(k) += internal::conj(v) * xj;
+    }
+    else
+    {
+      scatter.coeffRef(k) += v * xj;
+      tmp += internal::conj(v) * rhs.coeff(k,c);
+    }
+  }
+  if (ProcessFirstHalf && i && (i.index()==j))
+    tmp += i.value() * rhs.coeff(j,c);
+  res.coeffRef(j,c) += alpha * tmp;
 }
 
+/** \internal
+  * res += alpha * lhs.selfadjointView<UpLo>() * rhs, reading each stored coefficient of the triangle once for both
+  * of its contributions. In parallel, each thread processes a contiguous range of outer vectors: it owns the
+  * gathered coefficients of its range, and scatters the transposed ones into a partial result restricted to the
+  * rows they can reach, the partial results being summed afterwards. */
+template<int UpLo, typename _Lhs, typename _Rhs, typename Dest>
+void sparse_selfadjoint_time_dense_product(const _Lhs& _lhs, const _Rhs& _rhs, Dest& res, const typename Dest::Scalar& alpha)
+{
+  typedef typename remove_all<_Lhs>::type Lhs;
+  typedef typename remove_all<_Rhs>::type Rhs;
+  typedef typename Lhs::Index Index;
+  enum {
+    LhsIsRowMajor = (Lhs::Flags&RowMajorBit)==RowMajorBit,
+    ScatterBefore =
+             ((UpLo&(Upper|Lower))==(Upper|Lower))
+          || ( (UpLo&Upper) && !LhsIsRowMajor)
+          || ( (UpLo&Lower) && LhsIsRowMajor)
+  };
+  const Lhs& lhs = _lhs;
+  const Rhs& rhs = _rhs;
+  const Index n = lhs.outerSize();
+  const Index cols = rhs.cols();
+  const Index threads = sparse_product_threads<Index>(n, lhs.nonZeros()*cols);
+  EIGEN_UNUSED_VARIABLE(threads);
+
+#ifdef EIGEN_HAS_OPENMP
+  if(threads>1)
+  {
+    typedef typename Dest::Scalar Scalar;
+    Matrix<Scalar,Dynamic,Dynamic> partial(n, threads);
+    #pragma omp parallel num_threads(threads)
+    {
+      const Index nt = omp_get_num_threads();
+      const Index t = omp_get_thread_num();
+      const Index begin = n*t/nt, end = n*(t+1)/nt;
+      // the transposed coefficients of the outer vectors [begin,end) are scattered into [0,end) or [begin,n)
+      const Index lo = ScatterBefore ? 0 : begin, hi = ScatterBefore ? end : n;
+      typename Matrix<Scalar,Dynamic,Dynamic>::ColXpr scatter(partial.col(t));
+      for(Index c=0; c<cols; ++c)
+      {
+        scatter.segment(lo, hi-lo).setZero();
+        for(Index j=begin; j<end; ++j)
+          sparse_selfadjoint_time_dense_outer<UpLo>(lhs, rhs, res, scatter, j, c, alpha);
+        #pragma omp barrier
+        #pragma omp for schedule(static)
+        for(Index i=0; i<n; ++i)
+        {
+          Scalar sum(0);
+          for(Index s=0; s<nt; ++s)
+          {
+            const Index sbegin = n*s/nt, send = n*(s+1)/nt;
+            if(ScatterBefore ? i<send : i>=sbegin)
+              sum += partial.coeff(i,s);
+          }
+          res.coeffRef(i,c) += sum;
+        }
+      }
+    }
+    return;
+  }
+#endif
+
+  for(Index c=0; c<cols; ++c)
+  {
+    typename Dest::ColXpr scatter(res.col(c));
+    for(Index j=0; j<n; ++j)
+      sparse_selfadjoint_time_dense_outer<UpLo>(lhs, rhs, res, scatter, j, c, alpha);
+  }
+}
+
+} // end namespace internal
+
 template<typename Lhs, typename Rhs, int UpLo>
 class SparseSelfAdjointTimeDenseProduct
   : public ProductBase<SparseSelfAdjointTimeDenseProduct<Lhs,Rhs,UpLo>, Lhs, Rhs>
@@ -209,42 +332,7 @@ class SparseSelfAdjointTimeDenseProduct
 
     template<typename Dest> void scaleAndAddTo(Dest& dest, Scalar alpha) const
     {
-      // TODO use alpha
-      eigen_assert(alpha==Scalar(1) && "alpha != 1 is not implemented yet, sorry");
-      typedef typename internal::remove_all<Lhs>::type _Lhs;
-      typedef typename internal::remove_all<Rhs>::type _Rhs;
-      typedef typename _Lhs::InnerIterator LhsInnerIterator;
-      enum {
-        LhsIsRowMajor = (_Lhs::Flags&RowMajorBit)==RowMajorBit,
-        ProcessFirstHalf =
-                 ((UpLo&(Upper|Lower))==(Upper|Lower))
-              || ( (UpLo&Upper) && !LhsIsRowMajor)
-              || ( (UpLo&Lower) && LhsIsRowMajor),
-        ProcessSecondHalf = !ProcessFirstHalf
-      };
-      for (Index j=0; j<m_lhs.outerSize(); ++j)
-      {
-        LhsInnerIterator i(m_lhs,j);
-        if (ProcessSecondHalf)
-        {
-          while (i && i.index()<j) ++i;
-          if(i && i.index()==j)
-          {
-            dest.row(j) += i.value() * m_rhs.row(j);
-            ++i;
-          }
-        }
-        for(; (ProcessFirstHalf ? i && i.index() < j : i) ; ++i)
-        {
-          Index a = LhsIsRowMajor ? j : i.index();
-          Index b = LhsIsRowMajor ? i.index() : j;
-          typename Lhs::Scalar v = i.value();
-          dest.row(a) += (v) * m_rhs.row(b);
-          dest.row(b) += internal::conj(v) * m_rhs.row(a);
-        }
-        if (ProcessFirstHalf && i && (i.index()==j))
-          dest.row(j) += i.value() * m_rhs.row(j);
-      }
+      internal::sparse_selfadjoint_time_dense_product<UpLo>(m_lhs, m_rhs, dest, alpha);
     }
 
   private:
@@ -286,153 +374,112 @@ template<typename MatrixType, int UpLo>
 struct traits<SparseSymmetricPermutationProduct<MatrixType,UpLo> > : traits<MatrixType> {
 };
 
-template<int UpLo,typename MatrixType,int DestOrder>
-void permute_symm_to_fullsymm(const MatrixType& mat, SparseMatrix<typename MatrixType::Scalar,DestOrder,typename MatrixType::Index>& _dest, const typename MatrixType::Index* perm)
+// emits the entries of the full symmetric matrix stored in the UpLo part of the j-th vector of mat, permuted by perm
+template<int UpLo,typename MatrixType,bool StorageOrderMatch>
+struct permute_symm_to_fullsymm_emitter
 {
   typedef typename MatrixType::Index Index;
-  typedef typename MatrixType::Scalar Scalar;
-  typedef SparseMatrix<Scalar,DestOrder,Index> Dest;
-  typedef Matrix<Index,Dynamic,1> VectorI;
-  
-  Dest& dest(_dest.derived());
-  enum {
-    StorageOrderMatch = int(Dest::IsRowMajor) == int(MatrixType::IsRowMajor)
-  };
-  
-  Index size = mat.rows();
-  VectorI count;
-  count.resize(size);
-  count.setZero();
-  dest.resize(size,size);
-  for(Index j = 0; j<size; ++j)
-  {
-    Index jp = perm ? perm[j] : j;
-    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
-    {
-      Index i = it.index();
-      Index r = it.row();
-      Index c = it.col();
-      Index ip = perm ? perm[i] : i;
-      if(UpLo==(Upper|Lower))
-        count[StorageOrderMatch ? jp : ip]++;
-      else if(r==c)
-        count[ip]++;
-      else if(( UpLo==Lower && r>c) || ( UpLo==Upper && r<c))
-      {
-        count[ip]++;
-        count[jp]++;
-      }
-    }
-  }
-  Index nnz = count.sum();
-  
-  // reserve space
-  dest.resizeNonZeros(nnz);
-  dest.outerIndexPtr()[0] = 0;
-  for(Index j=0; j<size; ++j)
-    dest.outerIndexPtr()[j+1] = dest.outerIndexPtr()[j] + count[j];
-  for(Index j=0; j<size; ++j)
-    count[j] = dest.outerIndexPtr()[j];
-  
-  // copy data
-  for(Index j = 0; j<size; ++j)
+  permute_symm_to_fullsymm_emitter(const MatrixType& mat, const Index* perm) : m_mat(mat), m_perm(perm) {}
+  template<typename Visitor>
+  inline void operator()(Index j, Visitor& visitor) const
   {
-    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+    Index jp = m_perm ? m_perm[j] : j;
+    for(typename MatrixType::InnerIterator it(m_mat,j); it; ++it)
     {
       Index i = it.index();
       Index r = it.row();
       Index c = it.col();
-      
-      Index jp = perm ? perm[j] : j;
-      Index ip = perm ? perm[i] : i;
+      Index ip = m_perm ? m_perm[i] : i;
       
       if(UpLo==(Upper|Lower))
       {
-        Index k = count[StorageOrderMatch ? jp : ip]++;
-        dest.innerIndexPtr()[k] = StorageOrderMatch ? ip : jp;
-        dest.valuePtr()[k] = it.value();
+        if(StorageOrderMatch)
+          visitor(jp, ip, it.value());
+        else
+          visitor(ip, jp, it.value());
       }
       else if(r==c)
-      {
-        Index k = count[ip]++;
-        dest.innerIndexPtr()[k] = ip;
-        dest.valuePtr()[k] = it.value();
-      }
+        visitor(ip, ip, it.value());
       else if(( (UpLo&Lower)==Lower && r>c) || ( (UpLo&Upper)==Upper && r<c))
       {
+        Index a = ip, b = jp;
         if(!StorageOrderMatch)
-          std::swap(ip,jp);
-        Index k = count[jp]++;
-        dest.innerIndexPtr()[k] = ip;
-        dest.valuePtr()[k] = it.value();
-        k = count[ip]++;
-        dest.innerIndexPtr()[k] = jp;
-        dest.valuePtr()[k] = internal::conj(it.value());
+          std::swap(a,b);
+        visitor(b, a, it.value());
+        visitor(a, b, internal::conj(it.value()));
       }
     }
   }
-}
+  const MatrixType& m_mat;
+  const Index* m_perm;
+};
 
-template<int _SrcUpLo,int _DstUpLo,typename MatrixType,int DstOrder>
-void permute_symm_to_symm(const MatrixType& mat, SparseMatrix<typename MatrixType::Scalar,DstOrder,typename MatrixType::Index>& _dest, const typename MatrixType::Index* perm)
+template<int UpLo,typename MatrixType,int DestOrder>
+void permute_symm_to_fullsymm(const MatrixType& mat, SparseMatrix<typename MatrixType::Scalar,DestOrder,typename MatrixType::Index>& _dest, const typename MatrixType::Index* perm)
 {
   typedef typename MatrixType::Index Index;
   typedef typename MatrixType::Scalar Scalar;
-  SparseMatrix<Scalar,DstOrder,Index>& dest(_dest.derived());
-  typedef Matrix<Index,Dynamic,1> VectorI;
+  typedef SparseMatrix<Scalar,DestOrder,Index> Dest;
+  
+  Dest& dest(_dest.derived());
   enum {
-    SrcOrder = MatrixType::IsRowMajor ? RowMajor : ColMajor,
-    StorageOrderMatch = int(SrcOrder) == int(DstOrder),
-    DstUpLo = DstOrder==RowMajor ? (_DstUpLo==Upper ? Lower : Upper) : _DstUpLo,
-    SrcUpLo = SrcOrder==RowMajor ? (_SrcUpLo==Upper ? Lower : Upper) : _SrcUpLo
+    StorageOrderMatch = int(Dest::IsRowMajor) == int(MatrixType::IsRowMajor)
   };
   
   Index size = mat.rows();
-  VectorI count(size);
-  count.setZero();
   dest.resize(size,size);
-  for(Index j = 0; j<size; ++j)
-  {
-    Index jp = perm ? perm[j] : j;
-    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
-    {
-      Index i = it.index();
-      if((int(SrcUpLo)==int(Lower) && i<j) || (int(SrcUpLo)==int(Upper) && i>j))
-        continue;
-                  
-      Index ip = perm ? perm[i] : i;
-      count[int(DstUpLo)==int(Lower) ? (std::min)(ip,jp) : (std::max)(ip,jp)]++;
-    }
-  }
-  dest.outerIndexPtr()[0] = 0;
-  for(Index j=0; j<size; ++j)
-    dest.outerIndexPtr()[j+1] = dest.outerIndexPtr()[j] + count[j];
-  dest.resizeNonZeros(dest.outerIndexPtr()[size]);
-  for(Index j=0; j<size; ++j)
-    count[j] = dest.outerIndexPtr()[j];
-  
-  for(Index j = 0; j<size; ++j)
+  sparse_bucket_assign(permute_symm_to_fullsymm_emitter<UpLo,MatrixType,StorageOrderMatch>(mat, perm), size, dest,
+                       UpLo==(Upper|Lower) ? mat.nonZeros() : 2*mat.nonZeros());
+}
+
+// emits the entries stored in the SrcUpLo part of the j-th vector of mat to the DstUpLo part of the permuted matrix
+template<int SrcUpLo,int DstUpLo,typename MatrixType,bool StorageOrderMatch>
+struct permute_symm_to_symm_emitter
+{
+  typedef typename MatrixType::Index Index;
+  permute_symm_to_symm_emitter(const MatrixType& mat, const Index* perm) : m_mat(mat), m_perm(perm) {}
+  template<typename Visitor>
+  inline void operator()(Index j, Visitor& visitor) const
   {
-    
-    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+    for(typename MatrixType::InnerIterator it(m_mat,j); it; ++it)
     {
       Index i = it.index();
       if((int(SrcUpLo)==int(Lower) && i<j) || (int(SrcUpLo)==int(Upper) && i>j))
         continue;
-                  
-      Index jp = perm ? perm[j] : j;
-      Index ip = perm? perm[i] : i;
       
-      Index k = count[int(DstUpLo)==int(Lower) ? (std::min)(ip,jp) : (std::max)(ip,jp)]++;
-      dest.innerIndexPtr()[k] = int(DstUpLo)==int(Lower) ? (std::max)(ip,jp) : (std::min)(ip,jp);
+      Index jp = m_perm ? m_perm[j] : j;
+      Index ip = m_perm ? m_perm[i] : i;
+      Index outer = int(DstUpLo)==int(Lower) ? (std::min)(ip,jp) : (std::max)(ip,jp);
+      Index inner = int(DstUpLo)==int(Lower) ? (std::max)(ip,jp) : (std::min)(ip,jp);
       
       if(!StorageOrderMatch) std::swap(ip,jp);
       if( ((int(DstUpLo)==int(Lower) && ip<jp) || (int(DstUpLo)==int(Upper) && ip>jp)))
-        dest.valuePtr()[k] = conj(it.value());
+        visitor(outer, inner, internal::conj(it.value()));
       else
-        dest.valuePtr()[k] = it.value();
+        visitor(outer, inner, it.value());
     }
   }
+  const MatrixType& m_mat;
+  const Index* m_perm;
+};
+
+template<int _SrcUpLo,int _DstUpLo,typename MatrixType,int DstOrder>
+void permute_symm_to_symm(const MatrixType& mat, SparseMatrix<typename MatrixType::Scalar,DstOrder,typename MatrixType::Index>& _dest, const typename MatrixType::Index* perm)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  SparseMatrix<Scalar,DstOrder,Index>& dest(_dest.derived());
+  enum {
+    SrcOrder = MatrixType::IsRowMajor ? RowMajor : ColMajor,
+    StorageOrderMatch = int(SrcOrder) == int(DstOrder),
+    DstUpLo = DstOrder==RowMajor ? (_DstUpLo==Upper ? Lower : Upper) : _DstUpLo,
+    SrcUpLo = SrcOrder==RowMajor ? (_SrcUpLo==Upper ? Lower : Upper) : _SrcUpLo
+  };
+  
+  Index size = mat.rows();
+  dest.resize(size,size);
+  sparse_bucket_assign(permute_symm_to_symm_emitter<SrcUpLo,DstUpLo,MatrixType,StorageOrderMatch>(mat, perm), size, dest,
+                       mat.nonZeros());
 }
 
 }
@@ -0,0 +1,296 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSETRIANGULARLEVELSOLVER_H
+#define EIGEN_SPARSETRIANGULARLEVELSOLVER_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Level set schedule of the rows of a sparse triangular operator T.
+  * The rows of a level only depend on the rows of the previous levels, and can therefore be solved concurrently.
+  * When the rows of T are stored as inner vectors, the storage of the matrix is used as is. Otherwise a row-wise
+  * view (outer, inner, pos) of the stored coefficients is kept: the off-diagonal coefficients of the row i of T are
+  * at the positions pos[outer[i]:outer[i+1]] of the value array, in the columns inner[outer[i]:outer[i+1]]. */
+template<typename Index>
+struct sparse_level_schedule
+{
+  sparse_level_schedule() : enabled(false) {}
+
+  Matrix<Index,Dynamic,1> levelPtr;   // the rows of the level l are rows[levelPtr[l]:levelPtr[l+1]]
+  Matrix<Index,Dynamic,1> rows;
+  Matrix<Index,Dynamic,1> diag;       // position of the diagonal coefficient of each row, -1 if not stored
+  Matrix<Index,Dynamic,1> outer, inner, pos;
+  bool enabled;                       // false if the schedule is too deep to be worth it
+
+  Index levels() const { return levelPtr.size()>0 ? Index(levelPtr.size())-1 : 0; }
+};
+
+/** \internal
+  * Computes the level set schedule of the triangular operator T whose coefficients are stored in the compressed
+  * arrays \a outerPtr and \a innerPtr of size \a n. If \a rowIsOuter is true, the stored coefficient (o,k) is T(o,k),
+  * and T(k,o) otherwise. Only the coefficients of the lower (\a lower==true) or upper triangular part of T are used.
+  * The schedule is enabled if the average number of rows per level is at least \a minLevelWidth. */
+template<typename Index>
+void sparse_level_schedule_analyze(Index n, const Index* outerPtr, const Index* innerPtr, bool rowIsOuter, bool lower,
+                                   Index minLevelWidth, sparse_level_schedule<Index>& s)
+{
+  s.diag.setConstant(n, -1);
+  s.outer.resize(0);
+  s.inner.resize(0);
+  s.pos.resize(0);
+
+  // level[i] = 1 + max level of the rows i depends on. The rows are visited in topological order.
+  Matrix<Index,Dynamic,1> level = Matrix<Index,Dynamic,1>::Zero(n);
+  Index nlevels = 0;
+  for(Index k = 0; k < n; ++k)
+  {
+    Index o = lower ? k : n-1-k;
+    for(Index p = outerPtr[o]; p < outerPtr[o+1]; ++p)
+    {
+      Index i = innerPtr[p];
+      if(i == o)
+        s.diag[o] = p;
+      else if(rowIsOuter && (lower ? i<o : i>o))
+        level[o] = (std::max)(level[o], level[i]+1);      // the row o depends on the row i
+      else if(!rowIsOuter && (lower ? i>o : i<o))
+        level[i] = (std::max)(level[i], level[o]+1);      // the row i depends on the row o
+    }
+    nlevels = (std::max)(nlevels, level[o]+1);
+  }
+
+  s.enabled = n>0 && nlevels*minLevelWidth <= n;
+  if(!s.enabled)
+  {
+    s.levelPtr.resize(0);
+    s.rows.resize(0);
+    return;
+  }
+
+  // bucket the rows per level
+  s.levelPtr.setZero(nlevels+1);
+  s.rows.resize(n);
+  for(Index i = 0; i < n; ++i)
+    ++s.levelPtr[level[i]+1];
+  for(Index l = 0; l < nlevels; ++l)
+    s.levelPtr[l+1] += s.levelPtr[l];
+  {
+    Matrix<Index,Dynamic,1> fill = s.levelPtr.head(nlevels);
+    for(Index i = 0; i < n; ++i)
+      s.rows[fill[level[i]]++] = i;
+  }
+
+  if(!rowIsOuter)
+  {
+    // row-wise view of the strictly triangular part
+    s.outer.setZero(n+1);
+    for(Index o = 0; o < n; ++o)
+      for(Index p = outerPtr[o]; p < outerPtr[o+1]; ++p)
+      {
+        Index i = innerPtr[p];
+        if(lower ? i>o : i<o) ++s.outer[i+1];
+      }
+    for(Index i = 0; i < n; ++i)
+      s.outer[i+1] += s.outer[i];
+    s.inner.resize(s.outer[n]);
+    s.pos.resize(s.outer[n]);
+    Matrix<Index,Dynamic,1> fill = s.outer.head(n);
+    for(Index o = 0; o < n; ++o)
+      for(Index p = outerPtr[o]; p < outerPtr[o+1]; ++p)
+      {
+        Index i = innerPtr[p];
+        if(lower ? i>o : i<o)
+        {
+          Index q = fill[i]++;
+          s.inner[q] = o;
+          s.pos[q] = p;
+        }
+      }
+  }
+}
+
+/** \internal
+  * Solves in place T x = b, or T^* x = b if \a Conj is true, following the level set schedule \a s of the operator.
+  * The levels are processed one after the other, and the rows of each level are distributed over the threads. */
+template<bool Conj, bool UnitDiag, typename Index, typename Scalar, typename Dest>
+void sparse_level_solve(const sparse_level_schedule<Index>& s, bool lower, const Index* outerPtr, const Index* innerPtr,
+                        const Scalar* values, Dest& x)
+{
+  conj_if<Conj> cj;
+  const bool rowIsOuter = s.outer.size()==0;
+  const Index nlevels = s.levels();
+  const Index cols = x.cols();
+#ifdef EIGEN_HAS_OPENMP
+  Index threads = nbThreads();
+  #pragma omp parallel num_threads(threads) if(threads>1)
+#endif
+  {
+    for(Index l = 0; l < nlevels; ++l)
+    {
+      const Index begin = s.levelPtr[l], end = s.levelPtr[l+1];
+#ifdef EIGEN_HAS_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for(Index k = begin; k < end; ++k)
+      {
+        const Index i = s.rows[k];
+        for(Index c = 0; c < cols; ++c)
+        {
+          typename Dest::Scalar tmp = x.coeff(i,c);
+          if(rowIsOuter)
+          {
+            for(Index p = outerPtr[i]; p < outerPtr[i+1]; ++p)
+            {
+              Index j = innerPtr[p];
+              if(lower ? j<i : j>i)
+                tmp -= cj(values[p]) * x.coeff(j,c);
+            }
+          }
+          else
+          {
+            for(Index q = s.outer[i]; q < s.outer[i+1]; ++q)
+              tmp -= cj(values[s.pos[q]]) * x.coeff(s.inner[q],c);
+          }
+          if(!UnitDiag)
+          {
+            eigen_assert(s.diag[i]>=0 && "missing diagonal coefficient");
+            tmp /= cj(values[s.diag[i]]);
+          }
+          x.coeffRef(i,c) = tmp;
+        }
+      }
+    }
+  }
+}
+
+} // end namespace internal
+
+/** \ingroup SparseCore_Module
+  * \class SparseTriangularLevelSolver
+  *
+  * \brief Level scheduled parallel solver for sparse triangular systems
+  *
+  * This class solves T x = b and T^* x = b where T is the \a _UpLo triangular part of a compressed sparse matrix.
+  * The dependency graph of the rows of T is analyzed once per sparsity pattern by analyzePattern(): its rows are
+  * grouped into levels such that the rows of a level only depend on the rows of the previous levels. The solve then
+  * processes the levels one after the other, the rows of each level being solved concurrently by the OpenMP threads.
+  *
+  * The values of the matrix are not stored: they are passed to each solve, such that the analysis can be reused
+  * after a new numerical factorization having the same pattern.
+  *
+  * The level scheduling only pays off when the levels are wide enough. When the average number of rows per level
+  * is lower than minLevelWidth(), the solves fall back to the sequential SparseTriangularView::solveInPlace().
+  *
+  * \tparam _MatrixType the type of the sparse matrix, it must be a SparseMatrix<>
+  * \tparam _UpLo the triangular part of the matrix which is used, Lower or Upper
+  *
+  * \sa SparseTriangularView::solveInPlace()
+  */
+template<typename _MatrixType, int _UpLo>
+class SparseTriangularLevelSolver
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
+    enum {
+      UpLo = _UpLo,
+      IsRowMajor = MatrixType::IsRowMajor
+    };
+
+    SparseTriangularLevelSolver() : m_minLevelWidth(32), m_size(-1), m_hasAdjoint(false) {}
+
+    /** Analyzes the pattern of \a mat, see analyzePattern() */
+    explicit SparseTriangularLevelSolver(const MatrixType& mat, bool withAdjoint = false)
+      : m_minLevelWidth(32), m_size(-1), m_hasAdjoint(false)
+    {
+      analyzePattern(mat, withAdjoint);
+    }
+
+    /** Sets the minimal average number of rows per level below which the solves are sequential (default is 32).
+      * It must be set before calling analyzePattern(). */
+    SparseTriangularLevelSolver& setMinLevelWidth(Index width)
+    {
+      m_minLevelWidth = width;
+      return *this;
+    }
+
+    /** \returns the minimal average number of rows per level of a level scheduled solve */
+    Index minLevelWidth() const { return m_minLevelWidth; }
+
+    /** Computes the level set schedule of the triangular part of \a mat, and the one of its adjoint if \a withAdjoint is true.
+      * The schedules remain valid as long as the pattern of \a mat is unchanged. */
+    void analyzePattern(const MatrixType& mat, bool withAdjoint = false)
+    {
+      eigen_assert(mat.rows()==mat.cols() && mat.isCompressed());
+      m_size = mat.rows();
+      m_hasAdjoint = withAdjoint;
+      const bool lower = int(UpLo)==int(Lower);
+      internal::sparse_level_schedule_analyze<Index>(m_size, mat.outerIndexPtr(), mat.innerIndexPtr(),
+                                                     bool(IsRowMajor), lower, m_minLevelWidth, m_schedule);
+      if(withAdjoint)
+        internal::sparse_level_schedule_analyze<Index>(m_size, mat.outerIndexPtr(), mat.innerIndexPtr(),
+                                                       !bool(IsRowMajor), !lower, m_minLevelWidth, m_adjointSchedule);
+    }
+
+    /** \returns the number of rows of the analyzed matrix, or -1 if analyzePattern() has not been called */
+    Index size() const { return m_size; }
+
+    /** \returns the number of levels of T, or 0 if the solves of T are sequential */
+    Index levels() const { return m_schedule.levels(); }
+
+    /** \returns the number of levels of T^*, or 0 if the solves of T^* are sequential or have not been analyzed */
+    Index adjointLevels() const { return m_adjointSchedule.levels(); }
+
+    /** \returns whether the solves with T are level scheduled */
+    bool isLevelScheduled() const { return m_schedule.enabled; }
+
+    /** \returns whether the solves with T^* are level scheduled */
+    bool isAdjointLevelScheduled() const { return m_hasAdjoint && m_adjointSchedule.enabled; }
+
+    /** Solves in place T x = b where T is the \a Mode triangular view of \a mat.
+      * \a Mode is either \a _UpLo or \a _UpLo|UnitDiag, and \a mat must have the pattern given to analyzePattern(). */
+    template<int Mode, typename Dest>
+    void solveInPlace(const MatrixType& mat, MatrixBase<Dest>& x) const
+    {
+      EIGEN_STATIC_ASSERT(((Mode&(Lower|Upper))==int(UpLo)), THE_MATRIX_OR_EXPRESSION_THAT_YOU_PASSED_DOES_NOT_HAVE_THE_EXPECTED_TYPE);
+      eigen_assert(m_size==mat.rows() && x.rows()==m_size && "SparseTriangularLevelSolver: call analyzePattern() first");
+      if(!m_schedule.enabled)
+        mat.template triangularView<Mode>().solveInPlace(x);
+      else
+        internal::sparse_level_solve<false, (int(Mode)&UnitDiag)!=0>(m_schedule, int(UpLo)==int(Lower),
+                        mat.outerIndexPtr(), mat.innerIndexPtr(), mat.valuePtr(), x.derived());
+    }
+
+    /** Solves in place T^* x = b where T is the \a Mode triangular view of \a mat.
+      * The schedule of T^* must have been computed by analyzePattern(mat,true). */
+    template<int Mode, typename Dest>
+    void adjointSolveInPlace(const MatrixType& mat, MatrixBase<Dest>& x) const
+    {
+      EIGEN_STATIC_ASSERT(((Mode&(Lower|Upper))==int(UpLo)), THE_MATRIX_OR_EXPRESSION_THAT_YOU_PASSED_DOES_NOT_HAVE_THE_EXPECTED_TYPE);
+      enum { AdjointMode = (int(Mode)&UnitDiag) | (int(UpLo)==int(Lower) ? Upper : Lower) };
+      eigen_assert(m_size==mat.rows() && x.rows()==m_size && "SparseTriangularLevelSolver: call analyzePattern() first");
+      if(!isAdjointLevelScheduled())
+        mat.adjoint().template triangularView<AdjointMode>().solveInPlace(x);
+      else
+        internal::sparse_level_solve<true, (int(Mode)&UnitDiag)!=0>(m_adjointSchedule, int(UpLo)!=int(Lower),
+                        mat.outerIndexPtr(), mat.innerIndexPtr(), mat.valuePtr(), x.derived());
+    }
+
+  protected:
+    Index m_minLevelWidth;
+    Index m_size;
+    bool m_hasAdjoint;
+    internal::sparse_level_schedule<Index> m_schedule;
+    internal::sparse_level_schedule<Index> m_adjointSchedule;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSETRIANGULARLEVELSOLVER_H
@@ -91,6 +91,24 @@ template<typename MatrixType,int UpLo> class SparseSymmetricPermutationProduct;
 
 namespace internal {
 
+/** \internal
+  * \returns the number of threads to use for a sparse kernel (product, conversion, ...) with \a outerSize
+  * independent vectors and an estimated amount of \a work. Small kernels, and kernels running within a parallel
+  * region, are sequential. */
+template<typename Index>
+inline Index sparse_product_threads(Index outerSize, Index work)
+{
+#ifdef EIGEN_HAS_OPENMP
+  if(omp_get_num_threads()>1 || work < 20000)
+    return 1;
+  return (std::max)(Index(1), (std::min)(Index(nbThreads()), outerSize/32));
+#else
+  EIGEN_UNUSED_VARIABLE(outerSize);
+  EIGEN_UNUSED_VARIABLE(work);
+  return 1;
+#endif
+}
+
 template<typename T,int Rows,int Cols> struct sparse_eval;
 
 template<typename T> struct eval<T,Sparse>
@@ -0,0 +1,819 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSELU_H
+#define EIGEN_SPARSELU_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Computes a maximum transversal of the square pattern given in compressed column form by \a Ap and \a Ai.
+  * This is the augmenting path algorithm of the CSparse library (cs_maxtrans).
+  * On exit, \a rowOfCol[j] is the row matched to the column \a j, or -1 if the column could not be matched.
+  * \returns the structural rank of the pattern */
+template<typename Index>
+Index sparselu_maxtrans(Index n, const Index* Ap, const Index* Ai, Index* rowOfCol)
+{
+  Matrix<Index,Dynamic,1> work(6*n);
+  Index* jmatch = work.data();  // jmatch[i] is the column matched to the row i
+  Index* cheap  = jmatch + n;
+  Index* w      = cheap + n;
+  Index* js     = w + n;
+  Index* is     = js + n;
+  Index* ps     = is + n;
+  for(Index i = 0; i < n; ++i)
+  {
+    jmatch[i] = -1;
+    cheap[i]  = Ap[i];
+    w[i]      = -1;
+  }
+
+  for(Index k = 0; k < n; ++k)
+  {
+    // depth-first search for an augmenting path starting at the column k
+    bool found = false;
+    Index head = 0, i = -1, p;
+    js[0] = k;
+    while(head >= 0)
+    {
+      Index j = js[head];
+      if(w[j] != k)
+      {
+        // first time j is visited for the k-th path: cheap assignment
+        w[j] = k;
+        for(p = cheap[j]; p < Ap[j+1] && !found; ++p)
+        {
+          i = Ai[p];
+          found = (jmatch[i] == -1);
+        }
+        cheap[j] = p;
+        if(found)
+        {
+          is[head] = i;
+          break;
+        }
+        ps[head] = Ap[j];
+      }
+      for(p = ps[head]; p < Ap[j+1]; ++p)
+      {
+        i = Ai[p];
+        if(w[jmatch[i]] == k) continue;
+        ps[head] = p+1;
+        is[head] = i;
+        js[++head] = jmatch[i];
+        break;
+      }
+      if(p == Ap[j+1]) head--;
+    }
+    if(found)
+      for(p = head; p >= 0; --p)
+        jmatch[is[p]] = js[p];
+  }
+
+  Index rank = 0;
+  for(Index j = 0; j < n; ++j) rowOfCol[j] = -1;
+  for(Index i = 0; i < n; ++i)
+  {
+    if(jmatch[i] >= 0)
+    {
+      rowOfCol[jmatch[i]] = i;
+      ++rank;
+    }
+  }
+  return rank;
+}
+
+/** \internal
+  * Computes the elimination tree \a parent of the selfadjoint pattern \a ap, and if \a lind is not null,
+  * the pattern of the strictly lower part of its Cholesky factor: the rows of the column \a j are
+  * lind[lptr[j]] ... lind[lptr[j+1]-1], sorted by increasing indices.
+  * Only the strictly upper triangular part of \a ap is referenced. */
+template<typename Scalar, typename Index>
+void sparselu_cholesky_pattern(const SparseMatrix<Scalar,ColMajor,Index>& ap, Matrix<Index,Dynamic,1>& parent,
+                               Matrix<Index,Dynamic,1>& lptr, Matrix<Index,Dynamic,1>* lind)
+{
+  typedef SparseMatrix<Scalar,ColMajor,Index> PatternType;
+  const Index n = ap.cols();
+  parent.resize(n);
+  lptr.resize(n+1);
+  Matrix<Index,Dynamic,1> tags(n), counts(n);
+
+  for(Index k = 0; k < n; ++k)
+  {
+    parent[k] = -1;
+    tags[k] = k;
+    counts[k] = 0;
+    for(typename PatternType::InnerIterator it(ap,k); it; ++it)
+    {
+      for(Index i = it.index(); i < k && tags[i] != k; i = parent[i])
+      {
+        if(parent[i] == -1)
+          parent[i] = k;
+        counts[i]++;
+        tags[i] = k;
+      }
+    }
+  }
+
+  lptr[0] = 0;
+  for(Index k = 0; k < n; ++k)
+    lptr[k+1] = lptr[k] + counts[k];
+
+  if(!lind)
+    return;
+
+  lind->resize(lptr[n]);
+  for(Index k = 0; k < n; ++k)
+  {
+    tags[k] = k;
+    counts[k] = lptr[k];
+  }
+  for(Index k = 0; k < n; ++k)
+  {
+    for(typename PatternType::InnerIterator it(ap,k); it; ++it)
+    {
+      for(Index i = it.index(); i < k && tags[i] != k; i = parent[i])
+      {
+        lind->coeffRef(counts[i]++) = k;
+        tags[i] = k;
+      }
+    }
+  }
+}
+
+/** \internal computes a postordering \a post of the forest \a parent */
+template<typename Index>
+void sparselu_postorder(Index n, const Index* parent, Index* post)
+{
+  Matrix<Index,Dynamic,1> work(3*n);
+  Index* head  = work.data();
+  Index* next  = head + n;
+  Index* stack = next + n;
+  for(Index j = 0; j < n; ++j)
+    head[j] = -1;
+  for(Index j = n-1; j >= 0; --j)
+  {
+    if(parent[j] == -1) continue;
+    next[j] = head[parent[j]];
+    head[parent[j]] = j;
+  }
+  Index k = 0;
+  for(Index j = 0; j < n; ++j)
+    if(parent[j] == -1)
+      k = cs_tdfs<Index>(j, k, head, next, post, stack);
+}
+
+/** \internal \returns the signature (+1 or -1) of the permutation \a perm of size \a n */
+template<typename Index>
+int sparselu_permutation_sign(Index n, const Index* perm)
+{
+  std::vector<bool> visited(n, false);
+  int sign = 1;
+  for(Index k = 0; k < n; ++k)
+  {
+    if(visited[k]) continue;
+    Index len = 0;
+    for(Index i = k; !visited[i]; i = perm[i])
+    {
+      visited[i] = true;
+      ++len;
+    }
+    if(len % 2 == 0)
+      sign = -sign;
+  }
+  return sign;
+}
+
+} // end namespace internal
+
+/** \ingroup SparseLU_Module
+  * \class SparseLU
+  * \brief A native supernodal sparse LU factorization with partial pivoting
+  *
+  * This class computes the factorization \f$ P A Q = L U \f$ of a square sparse matrix \a A, where
+  * \a Q is a fill-reducing column permutation, \a P is the row permutation resulting from the partial
+  * pivoting, \a L is unit lower triangular and \a U is upper triangular.
+  * The factorization allows for solving A.X = B where X and B can be either dense or sparse.
+  *
+  * The symbolic analysis performed by analyzePattern() is purely structural and can be reused by any
+  * number of calls to factorize() on matrices sharing the same sparsity pattern:
+  *  - the column permutation \a Q is an approximate minimum degree ordering of \f$ A^T A \f$,
+  *    followed by a postordering of the column elimination tree;
+  *  - a maximum transversal provides a zero-free diagonal for \f$ A Q \f$;
+  *  - the storage of \a L and \a U is allocated once from the pattern of the Cholesky factor of
+  *    \f$ Q^T A^T A Q \f$ which, after George and Ng, contains the factors for any row pivoting sequence.
+  *
+  * The columns of this upper bound are grouped into supernodes. The numerical factorization is left-looking:
+  * each supernodal panel is updated by its descendants and then factorized with partial pivoting through
+  * the dense triangular solve, matrix product, and LU kernels of Eigen. It does not perform any memory allocation.
+  *
+  * \tparam _MatrixType the type of the sparse matrix A, it must be a column-major SparseMatrix<>
+  *
+  * \sa \ref TutorialSparseDirectSolvers, class UmfPackLU, class SuperLU
+  */
+template<typename _MatrixType>
+class SparseLU : internal::noncopyable
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::Index Index;
+    typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+    typedef PermutationMatrix<Dynamic,Dynamic,Index> PermutationType;
+
+  protected:
+    typedef SparseMatrix<RealScalar,ColMajor,Index> PatternType;
+    typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+    typedef Map<DenseMatrix, 0, OuterStride<> > BlockMap;
+    typedef Map<const DenseMatrix, 0, OuterStride<> > ConstBlockMap;
+
+  public:
+
+    /** Default constructor */
+    SparseLU()
+      : m_info(Success), m_isInitialized(false), m_analysisIsOk(false), m_factorizationIsOk(false)
+    {}
+
+    /** Constructs and performs the LU factorization of \a matrix */
+    SparseLU(const MatrixType& matrix)
+      : m_info(Success), m_isInitialized(false), m_analysisIsOk(false), m_factorizationIsOk(false)
+    {
+      compute(matrix);
+    }
+
+    inline Index rows() const { return m_Q.size(); }
+    inline Index cols() const { return m_Q.size(); }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if computation was succesful,
+      *          \c InvalidInput if the matrix is structurally singular or if its pattern
+      *          differs from the one given to analyzePattern(),
+      *          \c NumericalIssue if the matrix is numerically singular.
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "Decomposition is not initialized.");
+      return m_info;
+    }
+
+    /** Computes the sparse LU decomposition of \a matrix */
+    SparseLU& compute(const MatrixType& matrix)
+    {
+      analyzePattern(matrix);
+      if(m_info == Success)
+        factorize(matrix);
+      return *this;
+    }
+
+    void analyzePattern(const MatrixType& matrix);
+
+    void factorize(const MatrixType& matrix);
+
+    /** \returns the solution x of \f$ A x = b \f$ using the current decomposition of A.
+      *
+      * \sa compute()
+      */
+    template<typename Rhs>
+    inline const internal::solve_retval<SparseLU, Rhs> solve(const MatrixBase<Rhs>& b) const
+    {
+      eigen_assert(m_isInitialized && "SparseLU is not initialized.");
+      eigen_assert(rows()==b.rows()
+                && "SparseLU::solve(): invalid number of rows of the right hand side matrix b");
+      return internal::solve_retval<SparseLU, Rhs>(*this, b.derived());
+    }
+
+    /** \returns the solution x of \f$ A x = b \f$ using the current decomposition of A.
+      *
+      * \sa compute()
+      */
+    template<typename Rhs>
+    inline const internal::sparse_solve_retval<SparseLU, Rhs> solve(const SparseMatrixBase<Rhs>& b) const
+    {
+      eigen_assert(m_isInitialized && "SparseLU is not initialized.");
+      eigen_assert(rows()==b.rows()
+                && "SparseLU::solve(): invalid number of rows of the right hand side matrix b");
+      return internal::sparse_solve_retval<SparseLU, Rhs>(*this, b.derived());
+    }
+
+    /** \returns the column permutation Q
+      * \sa rowsPermutation() */
+    const PermutationType& colsPermutation() const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return m_Q;
+    }
+
+    /** \returns the row permutation P resulting from the partial pivoting
+      * \sa colsPermutation() */
+    PermutationType rowsPermutation() const
+    {
+      eigen_assert(m_factorizationIsOk && "SparseLU is not factorized");
+      PermutationType P(m_pivrow.size());
+      for(Index k = 0; k < m_pivrow.size(); ++k)
+        P.indices()[m_pivrow[k]] = k;
+      return P;
+    }
+
+    /** \returns the number of supernodes of the symbolic factorization */
+    Index supernodes() const { return m_xsup.size()>0 ? m_xsup.size()-1 : 0; }
+
+    /** \returns the number of coefficients stored for the factors L and U, including the diagonal.
+      * Since the storage is allocated once by analyzePattern(), this is an upper bound of the actual fill-in. */
+    Index nonZeros() const { return m_values.size(); }
+
+    /** \returns the determinant of the underlying matrix from the current factorization */
+    Scalar determinant() const;
+
+    #ifndef EIGEN_PARSED_BY_DOXYGEN
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const;
+
+    /** \internal */
+    template<typename Rhs, typename DestScalar, int DestOptions, typename DestIndex>
+    void _solve_sparse(const Rhs& b, SparseMatrix<DestScalar,DestOptions,DestIndex> &dest) const
+    {
+      eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state for solving, you must first call either compute() or analyzePattern()/factorize()");
+      eigen_assert(rows()==b.rows());
+
+      // we process the sparse rhs per block of NbColsAtOnce columns temporarily stored into a dense matrix.
+      static const int NbColsAtOnce = 4;
+      int rhsCols = b.cols();
+      int size = b.rows();
+      Eigen::Matrix<DestScalar,Dynamic,Dynamic> tmp(size,rhsCols);
+      for(int k=0; k<rhsCols; k+=NbColsAtOnce)
+      {
+        int actualCols = std::min<int>(rhsCols-k, NbColsAtOnce);
+        tmp.leftCols(actualCols) = b.middleCols(k,actualCols);
+        tmp.leftCols(actualCols) = solve(tmp.leftCols(actualCols));
+        dest.middleCols(k,actualCols) = tmp.leftCols(actualCols).sparseView();
+      }
+    }
+    #endif // EIGEN_PARSED_BY_DOXYGEN
+
+  protected:
+
+    /** \internal \returns the size of the supernode \a s */
+    inline Index supernodeSize(Index s) const { return m_xsup[s+1] - m_xsup[s]; }
+    /** \internal \returns the number of rows of the L panel of the supernode \a s */
+    inline Index panelRows(Index s) const { return m_rowptr[s+1] - m_rowptr[s]; }
+    /** \internal \returns the leading dimension of the block storing U(:,s) on top of the L panel of \a s */
+    inline Index blockStride(Index s) const { return m_urows[s] + panelRows(s); }
+
+    mutable ComputationInfo m_info;
+    bool m_isInitialized;
+    bool m_analysisIsOk;
+    bool m_factorizationIsOk;
+
+    PermutationType m_Q;          // the column permutation
+    IndexVector m_matching;       // row initially assigned to each pivot position (zero-free diagonal)
+
+    // symbolic structure
+    IndexVector m_xsup;           // first column of each supernode
+    IndexVector m_supno;          // supernode of each column
+    IndexVector m_rowptr;         // pivot positions spanned by the L panel of each supernode ...
+    IndexVector m_rowind;         // ... the first ones being the columns of the supernode
+    IndexVector m_updptr;         // supernodes updating each supernode ...
+    IndexVector m_updind;         // ... in topological order
+    IndexVector m_urows;          // number of rows of U(:,s), i.e., total size of the updating supernodes
+    IndexVector m_valptr;         // offset of each supernodal block in m_values
+
+    // numerical factors
+    ScalarVector m_values;        // for each supernode, a (urows+panelRows) x size column-major block
+    IndexVector m_rowid;          // original row of each row of the L panels
+    IndexVector m_pivrow;         // original row pivoted at each step
+
+    // workspace
+    IndexVector m_pos2row;
+    IndexVector m_map;
+    IndexVector m_transpositions;
+    ScalarVector m_work;
+};
+
+/** Performs a symbolic decomposition on the sparcity of \a matrix.
+  *
+  * This function is particularly useful when solving for several problems having the same structure.
+  *
+  * \sa factorize()
+  */
+template<typename MatrixType>
+void SparseLU<MatrixType>::analyzePattern(const MatrixType& a)
+{
+  EIGEN_STATIC_ASSERT((MatrixType::Flags&RowMajorBit)==0,THIS_METHOD_IS_ONLY_FOR_COLUMN_MAJOR_MATRICES);
+  eigen_assert(a.rows()==a.cols() && "SparseLU is only for square matrices");
+  const Index n = a.cols();
+
+  m_isInitialized     = true;
+  m_analysisIsOk      = false;
+  m_factorizationIsOk = false;
+
+  // the pattern of A with unit values, so that no cancellation can occur in A^T A
+  PatternType pat(n,n);
+  {
+    Index nnz = 0;
+    for(Index j = 0; j < n; ++j)
+      for(typename MatrixType::InnerIterator it(a,j); it; ++it)
+        ++nnz;
+    pat.resizeNonZeros(nnz);
+    Index* outer = pat.outerIndexPtr();
+    Index* inner = pat.innerIndexPtr();
+    RealScalar* values = pat.valuePtr();
+    outer[0] = 0;
+    for(Index j = 0; j < n; ++j)
+    {
+      Index p = outer[j];
+      for(typename MatrixType::InnerIterator it(a,j); it; ++it)
+      {
+        inner[p] = it.index();
+        values[p++] = RealScalar(1);
+      }
+      outer[j+1] = p;
+    }
+  }
+
+  // 1 - column ordering: minimum degree on A^T A, followed by a postordering of the column elimination tree
+  PatternType ata;
+  ata = PatternType(pat.transpose()) * pat;
+  PermutationType Q;
+  {
+    PatternType c = ata;
+    internal::minimum_degree_ordering(c, Q);
+  }
+  {
+    PatternType ap(n,n);
+    PermutationType Qinv = Q.inverse();
+    ap.template selfadjointView<Upper>() = ata.template selfadjointView<Lower>().twistedBy(Qinv);
+    IndexVector parent, lptr, post(n);
+    internal::sparselu_cholesky_pattern(ap, parent, lptr, (IndexVector*)0);
+    internal::sparselu_postorder(n, parent.data(), post.data());
+    m_Q.resize(n);
+    for(Index k = 0; k < n; ++k)
+      m_Q.indices()[k] = Q.indices()[post[k]];
+  }
+
+  // 2 - zero-free diagonal: the pivot position k initially holds a row having an entry in the column Q(k)
+  m_matching.resize(n);
+  {
+    IndexVector bp(n+1), bi(pat.nonZeros());
+    bp[0] = 0;
+    for(Index k = 0; k < n; ++k)
+    {
+      Index p = bp[k];
+      for(typename PatternType::InnerIterator it(pat,m_Q.indices()[k]); it; ++it)
+        bi[p++] = it.index();
+      bp[k+1] = p;
+    }
+    if(internal::sparselu_maxtrans(n, bp.data(), bi.data(), m_matching.data()) < n)
+    {
+      m_info = InvalidInput;   // structurally singular
+      return;
+    }
+  }
+
+  // 3 - pattern of the Cholesky factor of Q^T A^T A Q, which bounds the pattern of L^T and U
+  IndexVector parent, lptr, lind;
+  {
+    PatternType ap(n,n);
+    PermutationType Qinv = m_Q.inverse();
+    ap.template selfadjointView<Upper>() = ata.template selfadjointView<Lower>().twistedBy(Qinv);
+    internal::sparselu_cholesky_pattern(ap, parent, lptr, &lind);
+  }
+
+  // 4 - supernodes: chains of the elimination tree sharing the same nested structure
+  m_supno.resize(n);
+  Index nsuper = 0;
+  for(Index j = 0; j < n; ++j)
+  {
+    if(j == 0 || parent[j-1] != j || lptr[j]-lptr[j-1] != lptr[j+1]-lptr[j]+1)
+      ++nsuper;
+    m_supno[j] = nsuper-1;
+  }
+  m_xsup.resize(nsuper+1);
+  m_rowptr.resize(nsuper+1);
+  m_rowptr[0] = 0;
+  for(Index j = n-1; j >= 0; --j)
+    m_xsup[m_supno[j]] = j;
+  m_xsup[nsuper] = n;
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    Index last = m_xsup[s+1]-1;
+    m_rowptr[s+1] = m_rowptr[s] + supernodeSize(s) + (lptr[last+1]-lptr[last]);
+  }
+  m_rowind.resize(m_rowptr[nsuper]);
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    Index p = m_rowptr[s];
+    Index last = m_xsup[s+1]-1;
+    for(Index j = m_xsup[s]; j <= last; ++j)
+      m_rowind[p++] = j;
+    for(Index q = lptr[last]; q < lptr[last+1]; ++q)
+      m_rowind[p++] = lind[q];
+  }
+
+  // 5 - the supernodes updating each supernode, i.e., the rows of U(:,s)
+  IndexVector mark(nsuper);
+  mark.setConstant(-1);
+  m_updptr.setZero(nsuper+1);
+  for(int pass = 0; pass < 2; ++pass)
+  {
+    if(pass == 1)
+    {
+      for(Index s = 0; s < nsuper; ++s)
+        m_updptr[s+1] += m_updptr[s];
+      m_updind.resize(m_updptr[nsuper]);
+      mark.setConstant(-1);
+    }
+    IndexVector fill = m_updptr;
+    for(Index t = 0; t < nsuper; ++t)
+    {
+      for(Index p = m_rowptr[t]+supernodeSize(t); p < m_rowptr[t+1]; ++p)
+      {
+        Index s = m_supno[m_rowind[p]];
+        if(mark[s] == t) continue;
+        mark[s] = t;
+        if(pass == 0) ++m_updptr[s+1];
+        else          m_updind[fill[s]++] = t;
+      }
+    }
+  }
+
+  // 6 - storage
+  m_urows.setZero(nsuper);
+  m_valptr.resize(nsuper+1);
+  m_valptr[0] = 0;
+  Index maxSize = 0, maxWork = 0;
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    Index ns = supernodeSize(s);
+    for(Index q = m_updptr[s]; q < m_updptr[s+1]; ++q)
+    {
+      Index t = m_updind[q];
+      m_urows[s] += supernodeSize(t);
+      maxWork = (std::max)(maxWork, (panelRows(t)-supernodeSize(t)) * ns);
+    }
+    m_valptr[s+1] = m_valptr[s] + blockStride(s) * ns;
+    maxSize = (std::max)(maxSize, ns);
+  }
+
+  m_values.resize(m_valptr[nsuper]);
+  m_rowid.resize(m_rowind.size());
+  m_pivrow.resize(n);
+  m_pos2row.resize(n);
+  m_map.setConstant(n, -1);
+  m_transpositions.resize(maxSize);
+  m_work.resize(maxWork);
+
+  m_info         = Success;
+  m_analysisIsOk = true;
+}
+
+/** Performs a numeric decomposition of \a matrix
+  *
+  * The given matrix must has the same sparcity than the matrix on which the symbolic decomposition has been performed.
+  * Otherwise info() returns \c InvalidInput.
+  *
+  * \sa analyzePattern()
+  */
+template<typename MatrixType>
+void SparseLU<MatrixType>::factorize(const MatrixType& a)
+{
+  eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+  eigen_assert(a.rows()==rows() && a.cols()==cols());
+
+  const Index nsuper = supernodes();
+  const Index* colperm = m_Q.indices().data();
+  Index* map = m_map.data();
+  m_pos2row = m_matching;
+  m_info = Success;
+
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    const Index fst    = m_xsup[s];
+    const Index ns     = supernodeSize(s);
+    const Index nrows  = panelRows(s);
+    const Index urows  = m_urows[s];
+    const Index stride = blockStride(s);
+    const Index* rowind = m_rowind.data() + m_rowptr[s];
+    Index* rowid = m_rowid.data() + m_rowptr[s];
+    BlockMap block(m_values.data() + m_valptr[s], stride, ns, OuterStride<>(stride));
+    block.setZero();
+
+    // local numbering: the rows pivoted by the updating supernodes, then the rows of the panel
+    Index r = 0;
+    for(Index q = m_updptr[s]; q < m_updptr[s+1]; ++q)
+    {
+      Index t = m_updind[q];
+      for(Index k = m_xsup[t]; k < m_xsup[t+1]; ++k)
+        map[m_pivrow[k]] = r++;
+    }
+    for(Index i = 0; i < nrows; ++i)
+    {
+      rowid[i] = m_pos2row[rowind[i]];
+      map[rowid[i]] = r++;
+    }
+
+    // scatter the columns of A; an entry outside the analyzed structure means
+    // that the pattern differs from the one given to analyzePattern()
+    bool patternOk = true;
+    for(Index j = 0; j < ns && patternOk; ++j)
+    {
+      for(typename MatrixType::InnerIterator it(a,colperm[fst+j]); it; ++it)
+      {
+        if(map[it.index()] < 0)
+        {
+          patternOk = false;
+          break;
+        }
+        block.coeffRef(map[it.index()], j) += it.value();
+      }
+    }
+    if(!patternOk)
+    {
+      for(Index q = m_updptr[s]; q < m_updptr[s+1]; ++q)
+      {
+        Index t = m_updind[q];
+        for(Index k = m_xsup[t]; k < m_xsup[t+1]; ++k)
+          map[m_pivrow[k]] = -1;
+      }
+      for(Index i = 0; i < nrows; ++i)
+        map[rowid[i]] = -1;
+      m_info = InvalidInput;
+      m_factorizationIsOk = false;
+      return;
+    }
+
+    // left-looking updates from the descendants, in topological order
+    Index urow = 0;
+    for(Index q = m_updptr[s]; q < m_updptr[s+1]; ++q)
+    {
+      const Index t = m_updind[q];
+      const Index nst = supernodeSize(t);
+      const Index offt = panelRows(t) - nst;
+      const Index* rowidt = m_rowid.data() + m_rowptr[t];
+      ConstBlockMap panel(m_values.data() + m_valptr[t] + m_urows[t], panelRows(t), nst, OuterStride<>(blockStride(t)));
+
+      // U(t,s) = L(t,t)^-1 A(t,s)
+      Block<BlockMap> ublock(block, urow, 0, nst, ns);
+      panel.topRows(nst).template triangularView<UnitLower>().solveInPlace(ublock);
+
+      // A(:,s) -= L(:,t) U(t,s)
+      if(offt > 0)
+      {
+        BlockMap tmp(m_work.data(), offt, ns, OuterStride<>(offt));
+        tmp.noalias() = panel.bottomRows(offt) * ublock;
+        for(Index i = 0; i < offt; ++i)
+        {
+          Index p = map[rowidt[nst+i]];
+          if(p >= 0)
+            block.row(p) -= tmp.row(i);
+        }
+      }
+      urow += nst;
+    }
+
+    // dense LU with partial pivoting of the panel
+    Index nb_transpositions;
+    Index ret = internal::partial_lu_impl<Scalar, ColMajor, Index>::blocked_lu(
+                  nrows, ns, block.data()+urows, stride, m_transpositions.data(), nb_transpositions);
+    if(ret >= 0)
+      m_info = NumericalIssue;
+
+    for(Index k = 0; k < ns; ++k)
+      std::swap(rowid[k], rowid[m_transpositions[k]]);
+    for(Index i = 0; i < nrows; ++i)
+      m_pos2row[rowind[i]] = rowid[i];
+    for(Index k = 0; k < ns; ++k)
+      m_pivrow[fst+k] = rowid[k];
+
+    // reset the local numbering
+    for(Index q = m_updptr[s]; q < m_updptr[s+1]; ++q)
+    {
+      Index t = m_updind[q];
+      for(Index k = m_xsup[t]; k < m_xsup[t+1]; ++k)
+        map[m_pivrow[k]] = -1;
+    }
+    for(Index i = 0; i < nrows; ++i)
+      map[rowid[i]] = -1;
+  }
+
+  m_factorizationIsOk = true;
+}
+
+template<typename MatrixType>
+template<typename Rhs,typename Dest>
+void SparseLU<MatrixType>::_solve(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const
+{
+  eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state for solving, you must first call either compute() or analyzePattern()/factorize()");
+  eigen_assert(rows()==b.rows());
+
+  if(m_info!=Success)
+    return;
+
+  const Index n = rows();
+  const Index nrhs = b.cols();
+  const Index nsuper = supernodes();
+
+  // forward substitution with L, the rows being indexed by the original rows of A
+  DenseMatrix x = b;
+  DenseMatrix g;
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    const Index ns = supernodeSize(s);
+    const Index nrows = panelRows(s);
+    const Index* rowid = m_rowid.data() + m_rowptr[s];
+    ConstBlockMap panel(m_values.data() + m_valptr[s] + m_urows[s], nrows, ns, OuterStride<>(blockStride(s)));
+
+    g.resize(nrows, nrhs);
+    for(Index i = 0; i < nrows; ++i)
+      g.row(i) = x.row(rowid[i]);
+    panel.topRows(ns).template triangularView<UnitLower>().solveInPlace(g.topRows(ns));
+    if(nrows > ns)
+      g.bottomRows(nrows-ns).noalias() -= panel.bottomRows(nrows-ns) * g.topRows(ns);
+    for(Index i = 0; i < nrows; ++i)
+      x.row(rowid[i]) = g.row(i);
+  }
+
+  // backward substitution with U, the rows being indexed by the pivot steps
+  DenseMatrix y(n, nrhs);
+  for(Index k = 0; k < n; ++k)
+    y.row(k) = x.row(m_pivrow[k]);
+  for(Index s = nsuper-1; s >= 0; --s)
+  {
+    const Index fst = m_xsup[s];
+    const Index ns = supernodeSize(s);
+    const Index stride = blockStride(s);
+    const Scalar* data = m_values.data() + m_valptr[s];
+    ConstBlockMap diag(data + m_urows[s], ns, ns, OuterStride<>(stride));
+    diag.template triangularView<Upper>().solveInPlace(y.middleRows(fst, ns));
+
+    Index urow = 0;
+    for(Index q = m_updptr[s]; q < m_updptr[s+1]; ++q)
+    {
+      const Index t = m_updind[q];
+      const Index nst = supernodeSize(t);
+      ConstBlockMap ublock(data + urow, nst, ns, OuterStride<>(stride));
+      y.middleRows(m_xsup[t], nst).noalias() -= ublock * y.middleRows(fst, ns);
+      urow += nst;
+    }
+  }
+
+  dest = m_Q * y;
+}
+
+template<typename MatrixType>
+typename SparseLU<MatrixType>::Scalar SparseLU<MatrixType>::determinant() const
+{
+  eigen_assert(m_factorizationIsOk && "SparseLU is not factorized");
+  const Index n = rows();
+  Scalar det = Scalar(internal::sparselu_permutation_sign(n, m_Q.indices().data())
+                    * internal::sparselu_permutation_sign(n, m_pivrow.data()));
+  for(Index s = 0; s < supernodes(); ++s)
+  {
+    ConstBlockMap diag(m_values.data() + m_valptr[s] + m_urows[s], supernodeSize(s), supernodeSize(s), OuterStride<>(blockStride(s)));
+    det *= diag.diagonal().prod();
+  }
+  return det;
+}
+
+namespace internal {
+
+template<typename _MatrixType, typename Rhs>
+struct solve_retval<SparseLU<_MatrixType>, Rhs>
+  : solve_retval_base<SparseLU<_MatrixType>, Rhs>
+{
+  typedef SparseLU<_MatrixType> Dec;
+  EIGEN_MAKE_SOLVE_HELPERS(Dec,Rhs)
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    dec()._solve(rhs(),dst);
+  }
+};
+
+template<typename _MatrixType, typename Rhs>
+struct sparse_solve_retval<SparseLU<_MatrixType>, Rhs>
+  : sparse_solve_retval_base<SparseLU<_MatrixType>, Rhs>
+{
+  typedef SparseLU<_MatrixType> Dec;
+  EIGEN_MAKE_SPARSE_SOLVE_HELPERS(Dec,Rhs)
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    dec()._solve_sparse(rhs(),dst);
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSELU_H
@@ -1,9 +1,16 @@
 
-// g++ -I.. sparse_lu.cpp -O3 -g0 -I /usr/include/superlu/ -lsuperlu -lgfortran -DSIZE=1000 -DDENSITY=.05 && ./a.out
+// g++ -I.. sparse_lu.cpp -O3 -g0 -DNDEBUG -DSIZE=1000 -DDENSITY=.05 && ./a.out
+// add -DEIGEN_SUPERLU_SUPPORT -I /usr/include/superlu/ -lsuperlu -lblas and/or
+//     -DEIGEN_UMFPACK_SUPPORT -lumfpack -lblas to compare with the external backends
 
-#define EIGEN_SUPERLU_SUPPORT
-#define EIGEN_UMFPACK_SUPPORT
 #include <Eigen/Sparse>
+#include <Eigen/SparseLU>
+#ifdef EIGEN_SUPERLU_SUPPORT
+#include <Eigen/SuperLUSupport>
+#endif
+#ifdef EIGEN_UMFPACK_SUPPORT
+#include <Eigen/UmfPackSupport>
+#endif
 
 #define NOGMM
 #define NOMTL
@@ -42,31 +49,26 @@ typedef Matrix<Scalar,Dynamic,1> VectorX;
 
 #include <Eigen/LU>
 
-template<int Backend>
-void doEigen(const char* name, const EigenSparseMatrix& sm1, const VectorX& b, VectorX& x, int flags = 0)
+template<typename Solver>
+void doEigen(const char* name, const EigenSparseMatrix& sm1, const VectorX& b, VectorX& x)
 {
   std::cout << name << "..." << std::flush;
-  BenchTimer timer; timer.start();
-  SparseLU<EigenSparseMatrix,Backend> lu(sm1, flags);
-  timer.stop();
-  if (lu.succeeded())
-    std::cout << ":\t" << timer.value() << endl;
+  BenchTimer timer;
+  Solver lu;
+  BENCH(lu.analyzePattern(sm1);)
+  std::cout << "\n  analyze:\t" << timer.value() << endl;
+  BENCH(lu.factorize(sm1);)
+  if (lu.info()==Success)
+    std::cout << "  factorize:\t" << timer.value() << endl;
   else
   {
-    std::cout << ":\t FAILED" << endl;
+    std::cout << "  factorize:\t FAILED" << endl;
     return;
   }
 
-  bool ok;
-  timer.reset(); timer.start();
-  ok = lu.solve(b,&x);
-  timer.stop();
-  if (ok)
-    std::cout << "  solve:\t" << timer.value() << endl;
-  else
-    std::cout << "  solve:\t" << " FAILED" << endl;
-
-  //std::cout << x.transpose() << "\n";
+  BENCH(x = lu.solve(b);)
+  std::cout << "  solve:\t" << timer.value() << endl;
+  std::cout << "  residual:\t" << (sm1*x-b).norm()/b.norm() << endl;
 }
 
 int main(int argc, char *argv[])
@@ -86,6 +88,9 @@ int main(int argc, char *argv[])
   {
     EigenSparseMatrix sm1(rows, cols);
     fillMatrix(density, rows, cols, sm1);
+    for (int j=0; j<cols; ++j)
+      sm1.coeffRef(j,j) += Scalar(1);
+    sm1.makeCompressed();
 
     // dense matrices
     #ifdef DENSEMATRIX
@@ -98,31 +103,29 @@ int main(int argc, char *argv[])
 
       BenchTimer timer;
       timer.start();
-      FullPivLU<DenseMatrix> lu(m1);
+      PartialPivLU<DenseMatrix> lu(m1);
       timer.stop();
       std::cout << "Eigen/dense:\t" << timer.value() << endl;
 
       timer.reset();
       timer.start();
-      lu.solve(b,&x);
+      x = lu.solve(b);
       timer.stop();
       std::cout << "  solve:\t" << timer.value() << endl;
-//       std::cout << b.transpose() << "\n";
-//       std::cout << x.transpose() << "\n";
     }
     #endif
 
+    x.setZero();
+    doEigen<SparseLU<EigenSparseMatrix> >("Eigen/SparseLU", sm1, b, x);
+
     #ifdef EIGEN_UMFPACK_SUPPORT
     x.setZero();
-    doEigen<Eigen::UmfPack>("Eigen/UmfPack (auto)", sm1, b, x, 0);
+    doEigen<UmfPackLU<EigenSparseMatrix> >("Eigen/UmfPack", sm1, b, x);
     #endif
 
     #ifdef EIGEN_SUPERLU_SUPPORT
     x.setZero();
-    doEigen<Eigen::SuperLU>("Eigen/SuperLU (nat)", sm1, b, x, Eigen::NaturalOrdering);
-//     doEigen<Eigen::SuperLU>("Eigen/SuperLU (MD AT+A)", sm1, b, x, Eigen::MinimumDegree_AT_PLUS_A);
-//     doEigen<Eigen::SuperLU>("Eigen/SuperLU (MD ATA)", sm1, b, x, Eigen::MinimumDegree_ATA);
-    doEigen<Eigen::SuperLU>("Eigen/SuperLU (COLAMD)", sm1, b, x, Eigen::ColApproxMinimumDegree);
+    doEigen<SuperLU<EigenSparseMatrix> >("Eigen/SuperLU", sm1, b, x);
     #endif
 
   }
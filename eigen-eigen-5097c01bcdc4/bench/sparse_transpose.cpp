@@ -1,6 +1,7 @@
 
 //g++ -O3 -g0 -DNDEBUG  sparse_transpose.cpp -I.. -I/home/gael/Coding/LinearAlgebra/mtl4/ -DDENSITY=0.005 -DSIZE=10000 && ./a.out
 // -DNOGMM -DNOMTL
+// add -fopenmp to run the conversions in parallel
 // -DCSPARSE -I /home/gael/Coding/LinearAlgebra/CSparse/Include/ /home/gael/Coding/LinearAlgebra/CSparse/Lib/libcsparse.a
 
 #ifndef SIZE
@@ -64,6 +65,33 @@ int main(int argc, char *argv[])
       std::cout << "  Eigen:\t" << timer.value() << endl;
     }
 
+    // eigen storage order conversion, symmetric permutation and compression
+    {
+      SparseMatrix<Scalar,RowMajor> rm3(rows,cols);
+      BENCH(for (int k=0; k<REPEAT; ++k) rm3 = sm1;)
+      std::cout << "  Eigen row major:\t" << timer.value() << endl;
+
+      EigenSparseMatrix lower = EigenSparseMatrix(sm1 + EigenSparseMatrix(sm1.transpose())).triangularView<Lower>();
+      PermutationMatrix<Dynamic> perm(rows);
+      perm.setIdentity();
+      std::random_shuffle(perm.indices().data(), perm.indices().data()+rows);
+      BENCH(for (int k=0; k<REPEAT; ++k) sm3 = lower.selfadjointView<Lower>().twistedBy(perm);)
+      std::cout << "  Eigen twistedBy:\t" << timer.value() << endl;
+      BENCH(for (int k=0; k<REPEAT; ++k) sm3.selfadjointView<Upper>() = lower.selfadjointView<Lower>().twistedBy(perm);)
+      std::cout << "  Eigen twistedBy upper:\t" << timer.value() << endl;
+
+      timer.reset();
+      for (int _j=0; _j<NBTRIES; ++_j)
+      {
+        sm3 = sm1;
+        sm3.reserve(VectorXi::Constant(cols,2));
+        timer.start();
+        for (int k=0; k<REPEAT; ++k) sm3.makeCompressed();
+        timer.stop();
+      }
+      std::cout << "  Eigen makeCompressed:\t" << timer.value() << endl;
+    }
+
     // CSparse
     #ifdef CSPARSE
     {
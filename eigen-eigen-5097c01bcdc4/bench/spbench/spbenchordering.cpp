@@ -0,0 +1,138 @@
+
+// Compares the fill-in reducing orderings of the OrderingMethods module through the SimplicialLDLT factorization.
+// For each matrix and each ordering, it reports the time of the ordering and symbolic analysis, the number of
+// nonzeros of the factor L, the fill ratio nnz(L)/nnz(tril(A)) and the time of the numerical factorization.
+//
+// Without any matrix folder, 7-point Laplacians of cubic grids are used:
+//   g++ -O3 -DNDEBUG -I../.. spbenchordering.cpp -o spbenchordering && ./spbenchordering --grid 40
+// With a folder (same layout as for spbenchsolver), only the SPD matrices of the real/ subfolder are used:
+//   ./spbenchordering -d $EIGEN_MATRIXDIR
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <Eigen/SparseCholesky>
+#include <unsupported/Eigen/SparseExtra>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+using namespace std;
+
+#ifndef REPEAT
+#define REPEAT 3
+#endif
+
+typedef SparseMatrix<double,ColMajor> SpMat;
+
+bool get_options(int argc, char **args, string option, string* value=0)
+{
+  for(int idx = 1; idx < argc; ++idx)
+  {
+    if(option.compare(args[idx]) == 0)
+    {
+      if(value && idx+1 < argc) *value = args[idx+1];
+      return true;
+    }
+  }
+  return false;
+}
+
+// 7-point Laplacian of a n x n x n grid, lower triangular part only
+void laplacian_3d(int n, SpMat& A)
+{
+  std::vector<Triplet<double> > triplets;
+  triplets.reserve(4*n*n*n);
+  for(int k=0; k<n; ++k)
+    for(int j=0; j<n; ++j)
+      for(int i=0; i<n; ++i)
+      {
+        int id = i + n*(j + n*k);
+        triplets.push_back(Triplet<double>(id, id, 6));
+        if(i>0) triplets.push_back(Triplet<double>(id, id-1,   -1));
+        if(j>0) triplets.push_back(Triplet<double>(id, id-n,   -1));
+        if(k>0) triplets.push_back(Triplet<double>(id, id-n*n, -1));
+      }
+  A.resize(n*n*n, n*n*n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+}
+
+template<typename Ordering>
+void bench_ordering(const char* name, const SpMat& A, int nnzA)
+{
+  SimplicialLDLT<SpMat, Lower, Ordering> solver;
+  BenchTimer tAnalyze, tFactorize;
+  for(int k=0; k<REPEAT; ++k)
+  {
+    tAnalyze.start();
+    solver.analyzePattern(A);
+    tAnalyze.stop();
+  }
+  for(int k=0; k<REPEAT; ++k)
+  {
+    tFactorize.start();
+    solver.factorize(A);
+    tFactorize.stop();
+  }
+  if(solver.info()!=Success)
+  {
+    cout << "  " << setw(18) << left << name << " FACTORIZATION FAILED\n";
+    return;
+  }
+  int nnzL = solver.matrixL().nestedExpression().nonZeros();
+  cout << "  " << setw(18) << left << name << right
+       << setw(12) << tAnalyze.best()
+       << setw(14) << nnzL
+       << setw(10) << setprecision(3) << double(nnzL+A.cols())/double(nnzA)
+       << setw(12) << setprecision(6) << tFactorize.best() << "\n";
+}
+
+void bench_matrix(const string& matname, const SpMat& A, bool natural)
+{
+  SpMat L = A.triangularView<Lower>();
+  cout << "\n===== " << matname << " : n = " << A.rows() << ", nnz(tril(A)) = " << L.nonZeros() << " =====\n";
+  cout << "  " << setw(18) << left << "ordering" << right
+       << setw(12) << "analyze(s)" << setw(14) << "nnz(L)" << setw(10) << "fill" << setw(12) << "factor(s)" << "\n";
+  bench_ordering<AMDOrdering<int> >("AMD", L, L.nonZeros());
+  bench_ordering<NestedDissectionOrdering<int> >("NestedDissection", L, L.nonZeros());
+  bench_ordering<RCMOrdering<int> >("RCM", L, L.nonZeros());
+  if(natural)
+    bench_ordering<NaturalOrdering<int> >("Natural", L, L.nonZeros());
+}
+
+int main(int argc, char ** args)
+{
+  if(get_options(argc, args, "-h") || get_options(argc, args, "--help"))
+  {
+    cout << " spbenchordering : reports the fill-in and the factorization time of SimplicialLDLT for each ordering\n\n";
+    cout << " -d matrixdir \n    use the SPD matrices of matrixdir/real (see spbenchsolver --help)\n";
+    cout << " --grid n \n    use the 7-point Laplacian of a n^3 grid (default when no folder is given, n=30)\n";
+    cout << " --natural \n    also factorize without any reordering\n";
+    return 0;
+  }
+
+  string matrix_dir, inval;
+  bool natural = get_options(argc, args, "--natural");
+  if(get_options(argc, args, "-d", &matrix_dir))
+  {
+    for(MatrixMarketIterator<double> it(matrix_dir + "/real"); it; ++it)
+    {
+      if(it.sym()!=SPD) continue;
+      bench_matrix(it.matname(), it.matrix(), natural);
+    }
+  }
+  else
+  {
+    int n = 30;
+    if(get_options(argc, args, "--grid", &inval))
+      n = atoi(inval.c_str());
+    SpMat A;
+    laplacian_3d(n, A);
+    std::ostringstream matname;
+    matname << "laplacian " << n << "^3";
+    bench_matrix(matname.str(), A, natural);
+  }
+  return 0;
+}
@@ -20,6 +20,7 @@
 #include <Eigen/IterativeLinearSolvers>
 #include <unsupported/Eigen/IterativeSolvers>
 #include <Eigen/LU>
+#include <Eigen/SparseLU>
 #include <unsupported/Eigen/SparseExtra>
 
 #ifdef EIGEN_CHOLMOD_SUPPORT
@@ -62,7 +63,8 @@
 #define EIGEN_PARDISO_LLT  16
 #define EIGEN_CG  17
 #define EIGEN_CG_PRECOND  18
-#define EIGEN_ALL_SOLVERS  19
+#define EIGEN_SPARSELU  19
+#define EIGEN_ALL_SOLVERS  20
 
 using namespace Eigen;
 using namespace std; 
@@ -118,7 +120,7 @@ void printStatheader(std::ofstream& out)
   out << "<TABLE border=\"1\" >\n ";
   out << "<TR><TH>Matrix <TH> N <TH> NNZ <TH> ";
   if (LUcnt) out << LUlist;
-  out << " <TH >BiCGSTAB <TH >BiCGSTAB+ILUT"<< "<TH >GMRES+ILUT" <<LDLTlist << LLTlist <<  "<TH> CG "<< std::endl;
+  out << " <TH >BiCGSTAB <TH >BiCGSTAB+ILUT"<< "<TH >GMRES+ILUT" <<LDLTlist << LLTlist <<  "<TH> CG " << "<TH> SPARSELU " << std::endl;
 }
 
 
@@ -329,7 +331,13 @@ int SelectSolvers(const SparseMatrix<Scalar>&A, unsigned int sym, Matrix<Scalar,
   }
   #endif
 
-
+  // Native supernodal LU
+  {
+    cout << "\nSolving with SPARSELU ... \n"; 
+    SparseLU<SpMat> solver; 
+    stat[EIGEN_SPARSELU] = call_directsolver(solver, A, b, refX);
+    printStatItem(stat, EIGEN_SPARSELU, best_time_id, best_time_val); 
+  }
   
   //BiCGSTAB
   {
@@ -16,11 +16,15 @@ template<typename T> void test_conjugate_gradient_T()
   ConjugateGradient<SparseMatrix<T>, Upper> cg_colmajor_upper_diag;
   ConjugateGradient<SparseMatrix<T>, Lower, IdentityPreconditioner> cg_colmajor_lower_I;
   ConjugateGradient<SparseMatrix<T>, Upper, IdentityPreconditioner> cg_colmajor_upper_I;
+  ConjugateGradient<SparseMatrix<T>, Lower, IncompleteCholesky<T> > cg_colmajor_lower_ic;
+  ConjugateGradient<SparseMatrix<T>, Upper, IncompleteCholesky<T,Upper> > cg_colmajor_upper_ic;
 
   CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_lower_diag)  );
   CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_upper_diag)  );
   CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_lower_I)     );
   CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_upper_I)     );
+  CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_lower_ic)    );
+  CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_upper_ic)    );
 }
 
 void test_conjugate_gradient()
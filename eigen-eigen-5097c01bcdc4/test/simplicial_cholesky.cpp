@@ -9,6 +9,194 @@
 
 #include "sparse_solver.h"
 
+// 7-point Laplacian of a n x n x n grid
+template<typename T> void laplacian_3d(int n, SparseMatrix<T>& A)
+{
+  std::vector<Triplet<T> > triplets;
+  for(int k=0; k<n; ++k)
+    for(int j=0; j<n; ++j)
+      for(int i=0; i<n; ++i)
+      {
+        int id = i + n*(j + n*k);
+        triplets.push_back(Triplet<T>(id, id, T(6)));
+        if(i>0) triplets.push_back(Triplet<T>(id, id-1,   T(-1)));
+        if(j>0) triplets.push_back(Triplet<T>(id, id-n,   T(-1)));
+        if(k>0) triplets.push_back(Triplet<T>(id, id-n*n, T(-1)));
+      }
+  A.resize(n*n*n, n*n*n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+}
+
+template<typename Ordering, typename T> void check_ordering_permutation(const SparseMatrix<T>& A)
+{
+  PermutationMatrix<Dynamic,Dynamic,int> perm;
+  Ordering ordering;
+  ordering(A.template selfadjointView<Lower>(), perm);
+  VERIFY_IS_EQUAL(perm.size(), A.cols());
+  std::vector<bool> seen(A.cols(), false);
+  for(int k=0; k<perm.size(); ++k)
+  {
+    VERIFY(perm.indices()[k]>=0 && perm.indices()[k]<A.cols());
+    VERIFY(!seen[perm.indices()[k]]);
+    seen[perm.indices()[k]] = true;
+  }
+}
+
+template<typename Solver> int factor_nonzeros(Solver& solver, const typename Solver::MatrixType& A)
+{
+  typedef typename Solver::MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  solver.compute(A);
+  VERIFY(solver.info()==Success);
+  DenseVector ones = DenseVector::Ones(A.cols());
+  DenseVector b = A.template selfadjointView<Lower>() * ones;
+  DenseVector x = solver.solve(b);
+  VERIFY_IS_APPROX(x, ones);
+  return solver.matrixL().nestedExpression().nonZeros();
+}
+
+template<typename T> void test_orderings_T()
+{
+  SparseMatrix<T> A;
+  laplacian_3d(internal::random<int>(8,14), A);
+  // the lower triangular part only is stored
+  A = A.template triangularView<Lower>();
+
+  check_ordering_permutation<AMDOrdering<int> >(A);
+  check_ordering_permutation<RCMOrdering<int> >(A);
+  check_ordering_permutation<NestedDissectionOrdering<int> >(A);
+
+  SimplicialLDLT<SparseMatrix<T>, Lower, NaturalOrdering<int> > ldlt_natural;
+  SimplicialLDLT<SparseMatrix<T>, Lower, RCMOrdering<int> > ldlt_rcm;
+  SimplicialLDLT<SparseMatrix<T>, Lower, NestedDissectionOrdering<int> > ldlt_nd;
+  int nnz_natural = factor_nonzeros(ldlt_natural, A);
+  int nnz_rcm     = factor_nonzeros(ldlt_rcm, A);
+  int nnz_nd      = factor_nonzeros(ldlt_nd, A);
+  VERIFY(nnz_rcm <= nnz_natural);
+  VERIFY(nnz_nd < nnz_rcm);
+
+  // the ordering functor of the solver is the one used by the symbolic analysis
+  for(int leafSize = 8; leafSize <= A.cols(); leafSize *= 8)
+  {
+    PermutationMatrix<Dynamic,Dynamic,int> perm;
+    NestedDissectionOrdering<int> nd(leafSize);
+    nd(A.template selfadjointView<Lower>(), perm);
+
+    ldlt_nd.orderingMethod().setLeafSize(leafSize);
+    VERIFY_IS_EQUAL(ldlt_nd.orderingMethod().leafSize(), leafSize);
+    factor_nonzeros(ldlt_nd, A);
+    VERIFY(ldlt_nd.permutationPinv().indices() == perm.indices());
+
+    ldlt_nd.setOrderingMethod(NestedDissectionOrdering<int>());
+    ldlt_nd.setOrderingMethod(nd);
+    factor_nonzeros(ldlt_nd, A);
+    VERIFY(ldlt_nd.permutationPinv().indices() == perm.indices());
+  }
+}
+
+// refactorizes matrices having the same pattern but different values after a single symbolic analysis
+template<typename Solver> void check_refactorization(Solver& solver)
+{
+  typedef typename Solver::MatrixType Mat;
+  typedef typename Mat::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  const int n = internal::random<int>(4,7);
+  const int size = n*n*n;
+  Mat A(size,size);
+  A.reserve(VectorXi::Constant(size,7));
+  // Hermitian and diagonally dominant 3D grid matrix, stored in the UpLo triangular part
+  for(int refactor=0; refactor<4; ++refactor)
+  {
+    DenseMatrix dA = DenseMatrix::Zero(size,size);
+    for(int k=0; k<n; ++k)
+      for(int j=0; j<n; ++j)
+        for(int i=0; i<n; ++i)
+        {
+          int id = i + n*(j + n*k);
+          int nbs[3] = { i>0 ? id-1 : -1, j>0 ? id-n : -1, k>0 ? id-n*n : -1 };
+          for(int e=0; e<3; ++e)
+          {
+            if(nbs[e]<0) continue;
+            Scalar w = internal::random<Scalar>();
+            dA(id,nbs[e]) = w;
+            dA(nbs[e],id) = internal::conj(w);
+          }
+        }
+    for(int i=0; i<size; ++i)
+      dA(i,i) = dA.col(i).cwiseAbs().sum() + internal::random<RealScalar>(1,2);
+    for(int j=0; j<size; ++j)
+      for(int i=0; i<size; ++i)
+        if(dA(i,j)!=Scalar(0) && ((int(Solver::UpLo)==int(Lower) && i>=j) || (int(Solver::UpLo)==int(Upper) && i<=j)))
+          A.coeffRef(i,j) = dA(i,j);
+    if(refactor==0)
+      solver.analyzePattern(A);
+    else if(refactor==2)
+      A.makeCompressed();
+    solver.factorize(A);
+    VERIFY(solver.info()==Success);
+    DenseVector b = DenseVector::Random(size);
+    DenseVector refX = dA.llt().solve(b);
+    DenseVector x = solver.solve(b);
+    VERIFY_IS_APPROX(x, refX);
+  }
+
+  // a pattern that differs from the analyzed one, with the same number of
+  // nonzeros, is rejected by factorize() and requires a new symbolic analysis
+  {
+    Mat B(size,size);
+    DenseMatrix dB = DenseMatrix::Zero(size,size);
+    for(int i=0; i<size; ++i)
+      dB(i,i) = Scalar(4);
+    for(int i=1; i<size; ++i)
+    {
+      int j = i-1;
+      if(i%2==0 && i>=3)
+        j = i-3;
+      dB(i,j) = Scalar(1);
+      dB(j,i) = Scalar(1);
+    }
+    for(int j=0; j<size; ++j)
+      for(int i=0; i<size; ++i)
+        if(dB(i,j)!=Scalar(0) && ((int(Solver::UpLo)==int(Lower) && i>=j) || (int(Solver::UpLo)==int(Upper) && i<=j)))
+          B.insert(i,j) = dB(i,j);
+    B.makeCompressed();
+    Mat C(size,size);
+    DenseMatrix dC = DenseMatrix::Zero(size,size);
+    for(int i=0; i<size; ++i)
+    {
+      dC(i,i) = Scalar(4);
+      if(i>0)
+        dC(i,i-1) = dC(i-1,i) = Scalar(1);
+    }
+    for(int j=0; j<size; ++j)
+      for(int i=0; i<size; ++i)
+        if(dC(i,j)!=Scalar(0) && ((int(Solver::UpLo)==int(Lower) && i>=j) || (int(Solver::UpLo)==int(Upper) && i<=j)))
+          C.insert(i,j) = dC(i,j);
+    C.makeCompressed();
+    VERIFY_IS_EQUAL(B.nonZeros(), C.nonZeros());
+
+    solver.analyzePattern(B);
+    solver.factorize(B);
+    VERIFY(solver.info()==Success);
+    DenseVector b = DenseVector::Random(size);
+    VERIFY_IS_APPROX(solver.solve(b), DenseVector(dB.llt().solve(b)));
+    solver.factorize(C);
+    VERIFY(solver.info()==InvalidInput);
+    solver.analyzePattern(C);
+    solver.factorize(C);
+    VERIFY(solver.info()==Success);
+    VERIFY_IS_APPROX(solver.solve(b), DenseVector(dC.llt().solve(b)));
+    solver.factorize(B);
+    VERIFY(solver.info()==InvalidInput);
+    solver.compute(B);
+    VERIFY(solver.info()==Success);
+    VERIFY_IS_APPROX(solver.solve(b), DenseVector(dB.llt().solve(b)));
+  }
+}
+
 template<typename T> void test_simplicial_cholesky_T()
 {
   SimplicialCholesky<SparseMatrix<T>, Lower> chol_colmajor_lower;
@@ -17,6 +205,9 @@ template<typename T> void test_simplicial_cholesky_T()
   SimplicialLDLT<SparseMatrix<T>, Upper> llt_colmajor_upper;
   SimplicialLDLT<SparseMatrix<T>, Lower> ldlt_colmajor_lower;
   SimplicialLDLT<SparseMatrix<T>, Upper> ldlt_colmajor_upper;
+  SimplicialLDLT<SparseMatrix<T>, Lower, NaturalOrdering<int> > ldlt_natural;
+  SimplicialLDLT<SparseMatrix<T>, Upper, RCMOrdering<int> > ldlt_rcm;
+  SimplicialLLT<SparseMatrix<T>, Lower, NestedDissectionOrdering<int> > llt_nd;
 
   check_sparse_spd_solving(chol_colmajor_lower);
   check_sparse_spd_solving(chol_colmajor_upper);
@@ -24,7 +215,16 @@ template<typename T> void test_simplicial_cholesky_T()
   check_sparse_spd_solving(llt_colmajor_upper);
   check_sparse_spd_solving(ldlt_colmajor_lower);
   check_sparse_spd_solving(ldlt_colmajor_upper);
+  check_sparse_spd_solving(ldlt_natural);
+  check_sparse_spd_solving(ldlt_rcm);
+  check_sparse_spd_solving(llt_nd);
   
+  check_refactorization(chol_colmajor_lower);
+  check_refactorization(llt_colmajor_upper);
+  check_refactorization(ldlt_colmajor_lower);
+  check_refactorization(ldlt_rcm);
+  check_refactorization(llt_nd);
+
   check_sparse_spd_determinant(chol_colmajor_lower);
   check_sparse_spd_determinant(chol_colmajor_upper);
   check_sparse_spd_determinant(llt_colmajor_lower);
@@ -37,4 +237,5 @@ void test_simplicial_cholesky()
 {
   CALL_SUBTEST_1(test_simplicial_cholesky_T<double>());
   CALL_SUBTEST_2(test_simplicial_cholesky_T<std::complex<double> >());
+  CALL_SUBTEST_3(test_orderings_T<double>());
 }
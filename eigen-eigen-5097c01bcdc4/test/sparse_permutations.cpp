@@ -177,11 +177,71 @@ template<typename Scalar> void sparse_permutations_all(int size)
   CALL_SUBTEST(( sparse_permutations<RowMajor>(SparseMatrix<Scalar, RowMajor>(size,size)) ));
 }
 
+template<typename Scalar> void sparse_permutations_large()
+{
+  typedef SparseMatrix<Scalar> SpMat;
+  typedef SparseMatrix<Scalar,RowMajor> RowSpMat;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  const int n = internal::random<int>(2000,4000);
+  std::vector<Triplet<Scalar> > tA;
+  for(int j=0; j<n; ++j)
+    for(int k=0; k<12; ++k)
+      tA.push_back(Triplet<Scalar>(internal::random<int>(0,n-1), j, internal::random<Scalar>()));
+  SpMat A(n,n);
+  A.setFromTriplets(tA.begin(), tA.end());
+
+  // storage order conversion: the inner indices must be sorted, and independent of the number of threads
+  RowSpMat R = A;
+  VERIFY_IS_EQUAL(R.nonZeros(), A.nonZeros());
+  for(int i=0; i<n; ++i)
+    for(int k=R.outerIndexPtr()[i]+1; k<R.outerIndexPtr()[i+1]; ++k)
+      VERIFY(R.innerIndexPtr()[k-1] < R.innerIndexPtr()[k]);
+  VERIFY_IS_EQUAL((SpMat(R)-A).norm(), RealScalar(0));
+  RowSpMat At = A.adjoint();
+  VERIFY_IS_EQUAL((SpMat(At.adjoint())-A).norm(), RealScalar(0));
+  const int threads = nbThreads();
+  setNbThreads(1);
+  RowSpMat R1 = A;
+  setNbThreads(threads);
+  VERIFY(std::equal(R.innerIndexPtr(), R.innerIndexPtr()+R.nonZeros(), R1.innerIndexPtr()));
+
+  // compression of a matrix filled with room to spare
+  SpMat C(n,n);
+  C.reserve(VectorXi::Constant(n,16));
+  for(int j=0; j<n; ++j)
+    for(typename SpMat::InnerIterator it(A,j); it; ++it)
+      C.insert(it.row(), it.col()) = it.value();
+  VERIFY(!C.isCompressed());
+  C.makeCompressed();
+  VERIFY(C.isCompressed());
+  VERIFY_IS_EQUAL(C.nonZeros(), A.nonZeros());
+  VERIFY_IS_EQUAL((C-A).norm(), RealScalar(0));
+
+  // symmetric permutations, checked against the general permutation product; the permuted inner vectors are not
+  // sorted, so both sides are sorted by a round trip through the other storage order before being compared
+  SpMat S = A + SpMat(A.adjoint());
+  SpMat lowerS = S.template triangularView<Lower>();
+  PermutationMatrix<Dynamic> p(n);
+  p.setIdentity();
+  std::random_shuffle(p.indices().data(), p.indices().data()+n);
+  SpMat pS = p * S, res;
+  RowSpMat ref = pS * p.inverse(), rowRes;
+  res = lowerS.template selfadjointView<Lower>().twistedBy(p);
+  VERIFY_IS_EQUAL((RowSpMat(res)-ref).norm(), RealScalar(0));
+  rowRes = lowerS.template selfadjointView<Lower>().twistedBy(p);
+  VERIFY_IS_EQUAL((RowSpMat(SpMat(rowRes))-ref).norm(), RealScalar(0));
+  res = S.template selfadjointView<Upper|Lower>().twistedBy(p);
+  VERIFY_IS_EQUAL((RowSpMat(res)-ref).norm(), RealScalar(0));
+  res.template selfadjointView<Upper>() = lowerS.template selfadjointView<Lower>().twistedBy(p);
+  VERIFY_IS_EQUAL((RowSpMat(res)-RowSpMat(ref.template triangularView<Upper>())).norm(), RealScalar(0));
+}
+
 void test_sparse_permutations()
 {
   for(int i = 0; i < g_repeat; i++) {
-    int s = Eigen::internal::random<int>(1,50);
-    CALL_SUBTEST_1((  sparse_permutations_all<double>(s) ));
-    CALL_SUBTEST_2((  sparse_permutations_all<std::complex<double> >(s) ));
+    CALL_SUBTEST_1((  sparse_permutations_all<double>(Eigen::internal::random<int>(1,50)) ));
+    CALL_SUBTEST_2((  sparse_permutations_all<std::complex<double> >(Eigen::internal::random<int>(1,50)) ));
+    CALL_SUBTEST_3((  sparse_permutations_large<double>() ));
+    CALL_SUBTEST_3((  sparse_permutations_large<std::complex<double> >() ));
   }
 }
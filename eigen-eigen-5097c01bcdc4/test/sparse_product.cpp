@@ -167,9 +167,96 @@ template<typename SparseMatrixType> void sparse_product()
     VERIFY_IS_APPROX(x=mUp.template selfadjointView<Upper>()*b, refX=refS*b);
     VERIFY_IS_APPROX(x=mLo.template selfadjointView<Lower>()*b, refX=refS*b);
     VERIFY_IS_APPROX(x=mS.template selfadjointView<Upper|Lower>()*b, refX=refS*b);
+    VERIFY_IS_APPROX(x.noalias()+=s1*(mLo.template selfadjointView<Lower>()*b), refX+=s1*(refS*b));
+    VERIFY_IS_APPROX(x.noalias()-=mUp.template selfadjointView<Upper>()*b, refX-=refS*b);
   }
 }
 
+template<typename SparseMatrixType> void sparse_galerkin_product()
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::Index Index;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef SparseMatrix<Scalar,ColMajor,Index> ColMajorMatrix;
+  typedef SparseMatrix<Scalar,RowMajor,Index> RowMajorMatrix;
+
+  const Index rows = internal::random<int>(1,100);
+  const Index cols = internal::random<int>(1,rows);
+  double densityA = (std::max)(8./(rows*rows), 0.01);
+  double densityP = (std::max)(2./(rows*cols), 0.01);
+
+  DenseMatrix refA = DenseMatrix::Zero(rows, rows);
+  DenseMatrix refP = DenseMatrix::Zero(rows, cols);
+  SparseMatrixType A(rows, rows), P(rows, cols), res;
+  initSparse<Scalar>(densityA, refA, A);
+  initSparse<Scalar>(densityP, refP, P);
+  DenseMatrix refRes = refP.adjoint() * refA * refP;
+
+  galerkinProduct(P, A, res);
+  VERIFY_IS_APPROX(DenseMatrix(res), refRes);
+
+  ColMajorMatrix resCol;
+  RowMajorMatrix resRow;
+  galerkinProduct(P, A, resCol);
+  galerkinProduct(RowMajorMatrix(P), A, resRow);
+  VERIFY_IS_APPROX(DenseMatrix(resCol), refRes);
+  VERIFY_IS_APPROX(DenseMatrix(resRow), refRes);
+
+  // the inner indices of the result are sorted
+  for(Index j=0; j<resCol.outerSize(); ++j)
+    for(Index k=resCol.outerIndexPtr()[j]+1; k<resCol.outerIndexPtr()[j+1]; ++k)
+      VERIFY(resCol.innerIndexPtr()[k-1] < resCol.innerIndexPtr()[k]);
+
+  // aliasing
+  if(rows==cols)
+  {
+    SparseMatrixType A2 = A;
+    galerkinProduct(P, A2, A2);
+    VERIFY_IS_APPROX(DenseMatrix(A2), refRes);
+  }
+}
+
+// product of two sparse matrices large enough to be computed in parallel
+template<typename Scalar> void sparse_product_large()
+{
+  typedef SparseMatrix<Scalar> SpMat;
+  typedef SparseMatrix<Scalar,RowMajor> RowSpMat;
+  const int n = internal::random<int>(2000,4000);
+  std::vector<Triplet<Scalar> > tA, tP;
+  for(int j=0; j<n; ++j)
+  {
+    for(int k=0; k<12; ++k)
+      tA.push_back(Triplet<Scalar>(internal::random<int>(0,n-1), j, internal::random<Scalar>()));
+    tP.push_back(Triplet<Scalar>(j, j/3, internal::random<Scalar>()));
+    tP.push_back(Triplet<Scalar>(j, internal::random<int>(0,n/3), internal::random<Scalar>()));
+  }
+  SpMat A(n,n), P(n,n/3+1);
+  A.setFromTriplets(tA.begin(), tA.end());
+  P.setFromTriplets(tP.begin(), tP.end());
+
+  // the pruned product is computed by a different algorithm
+  SpMat AA = A*A, AAref = (A*A).pruned(0,0);
+  VERIFY_IS_APPROX(AA, AAref);
+  RowSpMat AArow = RowSpMat(A)*RowSpMat(A);
+  VERIFY_IS_APPROX(SpMat(AArow), AAref);
+
+  // symmetric products reading a single triangle
+  SpMat S = A + SpMat(A.adjoint());
+  SpMat lowerS = S.template triangularView<Lower>();
+  RowSpMat upperS = RowSpMat(S).template triangularView<Upper>();
+  Matrix<Scalar,Dynamic,Dynamic> X = Matrix<Scalar,Dynamic,Dynamic>::Random(n,2), Y, refY = S*X;
+  VERIFY_IS_APPROX(Y = lowerS.template selfadjointView<Lower>()*X, refY);
+  VERIFY_IS_APPROX(Y = upperS.template selfadjointView<Upper>()*X, refY);
+  VERIFY_IS_APPROX(Y = S.template selfadjointView<Upper|Lower>()*X, refY);
+  Matrix<Scalar,Dynamic,1> y = Matrix<Scalar,Dynamic,1>::Random(n), refy = y;
+  VERIFY_IS_APPROX(y.noalias() += Scalar(2)*(lowerS.template selfadjointView<Lower>()*X.col(0)), refy += Scalar(2)*refY.col(0));
+
+  SpMat AP = A*P, Pt = P.adjoint();
+  SpMat ref = Pt*AP, res;
+  galerkinProduct(P, A, res);
+  VERIFY_IS_APPROX(res, ref);
+}
+
 // New test for Bug in SparseTimeDenseProduct
 template<typename SparseMatrixType, typename DenseMatrixType> void sparse_product_regression_test()
 {
@@ -199,6 +286,9 @@ void test_sparse_product()
     CALL_SUBTEST_1( (sparse_product<SparseMatrix<double,RowMajor> >()) );
     CALL_SUBTEST_2( (sparse_product<SparseMatrix<std::complex<double>, ColMajor > >()) );
     CALL_SUBTEST_2( (sparse_product<SparseMatrix<std::complex<double>, RowMajor > >()) );
+    CALL_SUBTEST_3( (sparse_galerkin_product<SparseMatrix<double,ColMajor> >()) );
+    CALL_SUBTEST_3( (sparse_galerkin_product<SparseMatrix<std::complex<double>,RowMajor> >()) );
+    CALL_SUBTEST_5( (sparse_product_large<double>()) );
     CALL_SUBTEST_4( (sparse_product_regression_test<SparseMatrix<double,RowMajor>, Matrix<double, Dynamic, Dynamic, RowMajor> >()) );
   }
 }
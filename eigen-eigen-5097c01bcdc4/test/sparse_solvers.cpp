@@ -30,6 +30,151 @@ initSPD(double density,
   sparseMat.finalize();
 }
 
+template<typename Scalar, int Options, int UpLo> void sparse_level_solver(int size, int minLevelWidth)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef SparseMatrix<Scalar,Options> SpMat;
+  double density = (std::max)(8./(size*size), 0.01);
+  enum { OtherUpLo = UpLo==Lower ? Upper : Lower };
+
+  // both triangular parts are stored, only the UpLo one must be used
+  SpMat m(size, size);
+  DenseMatrix refMat = DenseMatrix::Zero(size, size);
+  initSparse<Scalar>(density, refMat, m, ForceNonZeroDiag);
+  m.makeCompressed();
+  DenseMatrix b = DenseMatrix::Random(size, internal::random<int>(1,3));
+
+  SparseTriangularLevelSolver<SpMat,UpLo> solver;
+  solver.setMinLevelWidth(minLevelWidth);
+  solver.analyzePattern(m, true);
+  VERIFY(solver.isLevelScheduled() == (solver.levels()>0));
+  if(minLevelWidth<=1)
+    VERIFY(solver.isLevelScheduled() && solver.isAdjointLevelScheduled());
+
+  DenseMatrix x = b;
+  solver.template solveInPlace<UpLo>(m, x);
+  VERIFY_IS_APPROX(x, refMat.template triangularView<UpLo>().solve(b));
+
+  x = b;
+  solver.template solveInPlace<UpLo|UnitDiag>(m, x);
+  VERIFY_IS_APPROX(x, refMat.template triangularView<UpLo|UnitDiag>().solve(b));
+
+  x = b;
+  solver.template adjointSolveInPlace<UpLo>(m, x);
+  VERIFY_IS_APPROX(x, refMat.adjoint().template triangularView<OtherUpLo>().solve(b));
+
+  // the schedule is reused with new values
+  m *= Scalar(2);
+  refMat *= Scalar(2);
+  Matrix<Scalar,Dynamic,1> y = b.col(0);
+  solver.template solveInPlace<UpLo>(m, y);
+  VERIFY_IS_APPROX(y, refMat.template triangularView<UpLo>().solve(b.col(0)));
+}
+
+template<typename Scalar> void incomplete_factorizations(int size)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  typedef SparseMatrix<Scalar> SpMat;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  double density = (std::max)(8./(size*size), 0.01);
+
+  // selfadjoint positive definite matrix, diagonally dominant such that IC(0) does not break down
+  SpMat m(size, size);
+  DenseMatrix refMat = DenseMatrix::Zero(size, size);
+  initSparse<Scalar>(density, refMat, m);
+  SpMat A = m + SpMat(m.adjoint());
+  DenseMatrix refA = A;
+  for(int i=0; i<size; ++i)
+    A.coeffRef(i,i) = refA(i,i) = RealScalar(1) + refA.row(i).cwiseAbs().sum();
+
+  // L L^* matches A on the pattern of its lower triangular part
+  IncompleteCholesky<Scalar> ic(A);
+  VERIFY(ic.info()==Success);
+  VERIFY(ic.shift()==RealScalar(0));
+  DenseMatrix L = DenseMatrix(ic.matrixL()), LLt = L*L.adjoint();
+  for(int j=0; j<size; ++j)
+    for(int i=j; i<size; ++i)
+      if(i==j || refA(i,j)!=Scalar(0))
+        VERIFY_IS_APPROX(LLt(i,j), refA(i,j));
+  DenseVector b = DenseVector::Random(size);
+  VERIFY_IS_APPROX(DenseVector(ic.solve(b)), DenseVector(LLt.llt().solve(b)));
+
+  // only the Upper part is read, and the symbolic analysis is reused for new values
+  IncompleteCholesky<Scalar,Upper> icu;
+  SpMat upperA = A.template triangularView<Upper>();
+  icu.analyzePattern(upperA);
+  icu.factorize(upperA);
+  VERIFY_IS_APPROX(DenseMatrix(icu.matrixL()), L);
+  upperA *= RealScalar(4);
+  icu.factorize(upperA);
+  VERIFY_IS_APPROX(DenseMatrix(icu.matrixL()), RealScalar(2)*L);
+
+  // a coefficient outside of the analyzed pattern is reported
+  if(size>1 && refA(0,size-1)==Scalar(0))
+  {
+    SpMat upperB = upperA;
+    upperB.coeffRef(0,size-1) = Scalar(1);
+    icu.factorize(upperB);
+    VERIFY(icu.info()==InvalidInput);
+    icu.factorize(upperA);
+    VERIFY(icu.info()==Success);
+    VERIFY_IS_APPROX(DenseMatrix(icu.matrixL()), RealScalar(2)*L);
+  }
+
+  // a breakdown is fixed by a diagonal shift
+  SpMat B = A;
+  B.coeffRef(0,0) = -B.coeffRef(0,0);
+  ic.compute(B);
+  VERIFY(ic.info()==Success);
+  VERIFY(ic.shift()>RealScalar(0));
+
+  // ILU(0) of a tridiagonal matrix and ILU(n) of any matrix are exact
+  SpMat T(size, size);
+  for(int i=0; i<size; ++i)
+  {
+    if(i>0) T.insert(i,i-1) = internal::random<Scalar>();
+    T.insert(i,i) = Scalar(4) + internal::random<Scalar>();
+    if(i+1<size) T.insert(i,i+1) = internal::random<Scalar>();
+  }
+  IncompleteLUK<Scalar> ilu(T);
+  VERIFY(ilu.info()==Success);
+  VERIFY_IS_EQUAL(ilu.matrixLU().nonZeros(), T.nonZeros());
+  VERIFY_IS_APPROX(DenseVector(ilu.solve(b)), DenseVector(DenseMatrix(T).lu().solve(b)));
+  if(size>2)
+  {
+    SpMat T2 = T;
+    T2.coeffRef(0,size-1) = Scalar(1);
+    ilu.factorize(T2);
+    VERIFY(ilu.info()==InvalidInput);
+    ilu.factorize(T);
+    VERIFY(ilu.info()==Success);
+    VERIFY_IS_APPROX(DenseVector(ilu.solve(b)), DenseVector(DenseMatrix(T).lu().solve(b)));
+  }
+
+  SpMat G = A;
+  G.coeffRef(0, size-1) += Scalar(1);
+  IncompleteLUK<Scalar> iluk;
+  iluk.setFillLevel(size);
+  iluk.compute(G);
+  VERIFY(iluk.info()==Success);
+  VERIFY_IS_APPROX(DenseVector(iluk.solve(b)), DenseVector(DenseMatrix(G).lu().solve(b)));
+
+  // the levels of fill grow the pattern
+  IncompleteLUK<Scalar> ilu0(G), ilu1(G, 1);
+  VERIFY(ilu0.matrixLU().nonZeros() <= ilu1.matrixLU().nonZeros());
+  VERIFY(ilu1.matrixLU().nonZeros() <= iluk.matrixLU().nonZeros());
+  G *= Scalar(2);
+  ilu1.factorize(G);
+  VERIFY(ilu1.info()==Success);
+
+  // zero pivot
+  SpMat Z(size, size);
+  for(int i=0; i<size; ++i)
+    Z.insert(i,i) = i+1<size ? Scalar(1) : Scalar(0);
+  VERIFY(IncompleteLUK<Scalar>(Z).info()==NumericalIssue);
+}
+
 template<typename Scalar> void sparse_solvers(int rows, int cols)
 {
   double density = (std::max)(8./(rows*cols), 0.01);
@@ -108,5 +253,12 @@ void test_sparse_solvers()
     int s = internal::random<int>(1,300);
     CALL_SUBTEST_2(sparse_solvers<std::complex<double> >(s,s) );
     CALL_SUBTEST_1(sparse_solvers<double>(s,s) );
+    CALL_SUBTEST_3(( sparse_level_solver<double,ColMajor,Lower>(s, 1) ));
+    CALL_SUBTEST_3(( sparse_level_solver<double,RowMajor,Upper>(s, 1) ));
+    CALL_SUBTEST_3(( sparse_level_solver<double,ColMajor,Upper>(s, internal::random<int>(1,64)) ));
+    CALL_SUBTEST_4(( sparse_level_solver<std::complex<double>,RowMajor,Lower>(s, 1) ));
+    CALL_SUBTEST_4(( sparse_level_solver<std::complex<double>,ColMajor,Upper>(s, 1000) ));
+    CALL_SUBTEST_5( incomplete_factorizations<double>(s) );
+    CALL_SUBTEST_5( incomplete_factorizations<std::complex<double> >(internal::random<int>(1,100)) );
   }
 }
@@ -0,0 +1,111 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse_solver.h"
+#include <Eigen/SparseLU>
+
+struct drop_first_col {
+  template<typename Index, typename Scalar>
+  bool operator() (const Index&, const Index& col, const Scalar&) const { return col!=0; }
+};
+
+// Solves a problem whose diagonal has been shuffled away, and refactorizes it
+// with new values through the same symbolic analysis.
+template<typename Solver> void check_sparselu_pivoting_and_refactorization(Solver& solver)
+{
+  typedef typename Solver::MatrixType Mat;
+  typedef typename Mat::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  Mat A;
+  DenseMatrix dA;
+  int size = generate_sparse_square_problem(solver, A, dA);
+
+  // permute the rows so that the diagonal is (mostly) zero
+  PermutationMatrix<Dynamic,Dynamic,typename Mat::Index> P(size);
+  P.setIdentity();
+  for(int i = size-1; i > 0; --i)
+    std::swap(P.indices()[i], P.indices()[internal::random<int>(0,i)]);
+  Mat PA = P * A;
+  DenseMatrix dPA = P * dA;
+  PA.makeCompressed();
+
+  DenseVector b = DenseVector::Random(size);
+  solver.analyzePattern(PA);
+  VERIFY(solver.info() == Success);
+  for(int k = 0; k < 3; ++k)
+  {
+    solver.factorize(PA);
+    VERIFY(solver.info() == Success);
+    DenseVector x = solver.solve(b);
+    VERIFY(x.isApprox(dPA.lu().solve(b), test_precision<Scalar>()));
+
+    // same pattern, new values
+    for(int j = 0; j < size; ++j)
+      for(typename Mat::InnerIterator it(PA,j); it; ++it)
+      {
+        it.valueRef() = internal::random<Scalar>();
+        dPA(it.row(), it.col()) = it.value();
+      }
+    for(int j = 0; j < size; ++j)
+    {
+      PA.coeffRef(P.indices()[j], j) += Scalar(4);
+      dPA(P.indices()[j], j) += Scalar(4);
+    }
+  }
+
+  // a structurally singular matrix is detected by the symbolic analysis
+  if(size > 1)
+  {
+    Mat S = PA;
+    S.prune(drop_first_col());
+    solver.compute(S);
+    VERIFY(solver.info() == InvalidInput);
+  }
+
+  // a pattern that differs from the analyzed one is rejected by factorize(),
+  // and the solver recovers with the analyzed pattern
+  if(size > 1)
+  {
+    Mat D(size, size);
+    for(int j = 0; j < size; ++j)
+      D.insert(j, j) = Scalar(2);
+    D.makeCompressed();
+    Mat F = D;
+    F.insert(size-1, 0) = Scalar(1);
+    F.insert(0, size-1) = Scalar(1);
+    F.makeCompressed();
+
+    solver.analyzePattern(D);
+    VERIFY(solver.info() == Success);
+    solver.factorize(F);
+    VERIFY(solver.info() == InvalidInput);
+    solver.factorize(D);
+    VERIFY(solver.info() == Success);
+    VERIFY(solver.solve(b).isApprox(b / Scalar(2), test_precision<Scalar>()));
+  }
+}
+
+template<typename T> void test_sparselu_T()
+{
+  SparseLU<SparseMatrix<T, ColMajor> > sparselu_colmajor;
+  SparseLU<SparseMatrix<T, ColMajor, long int> > sparselu_colmajor_long;
+
+  check_sparse_square_solving(sparselu_colmajor);
+  check_sparse_square_solving(sparselu_colmajor_long);
+  check_sparse_square_determinant(sparselu_colmajor);
+  check_sparselu_pivoting_and_refactorization(sparselu_colmajor);
+}
+
+void test_sparselu()
+{
+  CALL_SUBTEST_1(test_sparselu_T<float>());
+  CALL_SUBTEST_2(test_sparselu_T<double>());
+  CALL_SUBTEST_3(test_sparselu_T<std::complex<float> >());
+  CALL_SUBTEST_4(test_sparselu_T<std::complex<double> >());
+}
@@ -0,0 +1,236 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_ITERATIVE_REFINEMENT_H
+#define EIGEN_ITERATIVE_REFINEMENT_H
+
+namespace Eigen {
+
+template<typename _MatrixType, typename _InnerSolver> class IterativeRefinement;
+
+namespace internal {
+template<typename _MatrixType, typename _InnerSolver>
+struct traits<IterativeRefinement<_MatrixType,_InnerSolver> >
+{
+  typedef _MatrixType MatrixType;
+  typedef IdentityPreconditioner Preconditioner;
+};
+}
+
+/** \ingroup IterativeSolvers_Module
+  * \brief Iterative refinement of the solutions of an inner iterative solver
+  *
+  * This class solves A x = b by repeatedly solving A d = r for the residual r = b - A x with an inner iterative
+  * solver, and updating x += d. The inner solver works on a copy of A of type \c _InnerSolver::MatrixType, which
+  * can be cheaper than A, typically a MixedPrecisionSparseMatrix storing its coefficients in single precision,
+  * while the residuals are computed with A itself. The final residual thus reaches the accuracy of A, though the
+  * inner iterations only read the low precision copy.
+  *
+  * \tparam _MatrixType the type of the matrix A, which must be fully stored (not only a triangular part)
+  * \tparam _InnerSolver the type of the inner iterative solver, e.g., ConjugateGradient or BiCGSTAB
+  *
+  * \code
+  * SparseMatrix<double> A;
+  * // fill A and b
+  * IterativeRefinement<SparseMatrix<double>, ConjugateGradient<MixedPrecisionSparseMatrix<double,float>, Lower|Upper> > solver(A);
+  * x = solver.solve(b);
+  * \endcode
+  *
+  * The tolerance applies to the relative residual |b - A x| / |b| of the final solution, and maxIterations() bounds
+  * the number of iterations of each inner solve, while iterations() returns their total over the refinement steps.
+  * For a right hand side with several columns, iterations(), refinements() and error() report the largest values
+  * over the columns. The tolerance of the inner solves can be configured through innerSolver(); it defaults to 1e-6,
+  * and should not be much lower than the precision of the inner matrix. The number of refinement steps is bounded
+  * by setMaxRefinements().
+  *
+  * \sa MixedPrecisionSparseMatrix, ConjugateGradient
+  */
+template<typename _MatrixType, typename _InnerSolver>
+class IterativeRefinement : public IterativeSolverBase<IterativeRefinement<_MatrixType,_InnerSolver> >
+{
+  typedef IterativeSolverBase<IterativeRefinement> Base;
+  using Base::mp_matrix;
+  using Base::m_error;
+  using Base::m_iterations;
+  using Base::m_info;
+  using Base::m_isInitialized;
+  using Base::m_analysisIsOk;
+  using Base::m_factorizationIsOk;
+
+public:
+  typedef _MatrixType MatrixType;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef _InnerSolver InnerSolver;
+  typedef typename InnerSolver::MatrixType InnerMatrixType;
+
+public:
+
+  /** Default constructor. */
+  IterativeRefinement() : Base(), m_maxRefinements(20) { init(); }
+
+  /** Initialize the solver with matrix \a A for further \c Ax=b solving.
+    *
+    * \warning this class stores a reference to the matrix A. If \a A is changed this class becomes invalid.
+    * Call compute() to update it with the new matrix A.
+    */
+  IterativeRefinement(const MatrixType& A) : Base(), m_maxRefinements(20)
+  {
+    init();
+    compute(A);
+  }
+
+  ~IterativeRefinement() {}
+
+  /** Copies \a A into the inner matrix, and initializes the inner solver with it. */
+  IterativeRefinement& compute(const MatrixType& A)
+  {
+    mp_matrix = &A;
+    m_innerMatrix = A;
+    m_solver.compute(m_innerMatrix);
+    m_isInitialized = true;
+    m_analysisIsOk = true;
+    m_factorizationIsOk = true;
+    m_info = m_solver.info();
+    return *this;
+  }
+
+  /** \returns a reference to the inner solver, e.g., to set its tolerance or configure its preconditioner */
+  InnerSolver& innerSolver() { return m_solver; }
+  /** \returns a const reference to the inner solver */
+  const InnerSolver& innerSolver() const { return m_solver; }
+
+  /** \returns a const reference to the copy of A used by the inner solver */
+  const InnerMatrixType& innerMatrix() const { return m_innerMatrix; }
+
+  /** \returns the max number of refinement steps */
+  int maxRefinements() const { return m_maxRefinements; }
+
+  /** Sets the max number of refinement steps, i.e., of inner solves (default is 20) */
+  IterativeRefinement& setMaxRefinements(int maxRefinements)
+  {
+    m_maxRefinements = maxRefinements;
+    return *this;
+  }
+
+  /** \returns the number of refinement steps performed during the last solve */
+  int refinements() const
+  {
+    eigen_assert(m_isInitialized && "IterativeRefinement is not initialized.");
+    return m_refinements;
+  }
+
+  /** \returns the solution x of \f$ A x = b \f$ using \a x0 as an initial solution.
+    *
+    * \sa compute()
+    */
+  template<typename Rhs,typename Guess>
+  inline const internal::solve_retval_with_guess<IterativeRefinement, Rhs, Guess>
+  solveWithGuess(const MatrixBase<Rhs>& b, const Guess& x0) const
+  {
+    eigen_assert(m_isInitialized && "IterativeRefinement is not initialized.");
+    eigen_assert(Base::rows()==b.rows()
+              && "IterativeRefinement::solve(): invalid number of rows of the right hand side matrix b");
+    return internal::solve_retval_with_guess
+            <IterativeRefinement, Rhs, Guess>(*this, b.derived(), x0);
+  }
+
+  /** \internal */
+  template<typename Rhs,typename Dest>
+  void _solveWithGuess(const Rhs& b, Dest& x) const
+  {
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+    const MatrixType& A = *mp_matrix;
+    const int maxIters = Base::maxIterations();
+    bool failed = false;
+    ComputationInfo info = Success;
+    m_iterations = 0;
+    m_refinements = 0;
+    m_error = 0;
+
+    VectorType r(A.rows()), d(A.cols());
+    for(Index j=0; j<b.cols(); ++j)
+    {
+      typename Dest::ColXpr xj(x,j);
+      RealScalar bnorm = b.col(j).norm();
+      if(bnorm==RealScalar(0))
+      {
+        xj.setZero();
+        continue;
+      }
+      RealScalar error = RealScalar(0);
+      int iters = 0, steps = 0;
+      for(;;)
+      {
+        r = b.col(j);
+        r.noalias() -= A * xj;
+        error = r.norm() / bnorm;
+        if(error <= Base::m_tolerance || steps >= m_maxRefinements)
+          break;
+        m_solver.setMaxIterations(maxIters);
+        d = m_solver.solve(r);
+        iters += m_solver.iterations();
+        ++steps;
+        if(m_solver.info()==NumericalIssue)
+        {
+          failed = true;
+          break;
+        }
+        xj += d;
+      }
+      if(error > Base::m_tolerance && info==Success)
+        info = NoConvergence;
+      m_iterations = (std::max)(m_iterations, iters);
+      m_refinements = (std::max)(m_refinements, steps);
+      m_error = (std::max)(m_error, error);
+    }
+    m_info = failed ? NumericalIssue : info;
+    m_isInitialized = true;
+  }
+
+  /** \internal */
+  template<typename Rhs,typename Dest>
+  void _solve(const Rhs& b, Dest& x) const
+  {
+    x.setZero();
+    _solveWithGuess(b,x);
+  }
+
+protected:
+  void init()
+  {
+    m_refinements = 0;
+    m_solver.setTolerance(RealScalar(1e-6));
+  }
+
+  InnerMatrixType m_innerMatrix;
+  mutable InnerSolver m_solver;
+  int m_maxRefinements;
+  mutable int m_refinements;
+};
+
+namespace internal {
+
+template<typename _MatrixType, typename _InnerSolver, typename Rhs>
+struct solve_retval<IterativeRefinement<_MatrixType,_InnerSolver>, Rhs>
+  : solve_retval_base<IterativeRefinement<_MatrixType,_InnerSolver>, Rhs>
+{
+  typedef IterativeRefinement<_MatrixType,_InnerSolver> Dec;
+  EIGEN_MAKE_SOLVE_HELPERS(Dec,Rhs)
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    dec()._solve(rhs(),dst);
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_ITERATIVE_REFINEMENT_H
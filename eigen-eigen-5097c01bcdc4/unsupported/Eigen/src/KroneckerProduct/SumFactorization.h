@@ -0,0 +1,405 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SUM_FACTORIZATION_H
+#define EIGEN_SUM_FACTORIZATION_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Number of elements processed at once by the sum factorization kernels: the batches are stored with one element
+  * per row, so that a column of a group of elements fills a few packets, which share the loads of the coefficients
+  * of the 1-D matrices and hide the latency of the multiply-adds. */
+template<typename Scalar>
+struct sum_factorization_lanes
+{
+  enum { value = 4*packet_traits<Scalar>::size };
+};
+
+/** \internal
+  * Contraction of a group of third order tensors with a 1-D matrix M along the direction \a Dir. Each row of the
+  * input stores a tensor of extents N0 x N1 x N2, the first index being the fastest, and the same row of the output
+  * receives the tensor whose \a Dir-th extent is replaced by R = M.rows(). Each output column is thus a linear
+  * combination of input columns, which is vectorized over the rows.
+  */
+template<int Dir, int N0, int N1, int N2, int R>
+struct tensor_contraction
+{
+  enum {
+    M0 = Dir==0 ? R : N0,
+    M1 = Dir==1 ? R : N1,
+    M2 = Dir==2 ? R : N2,
+    Depth = Dir==0 ? N0 : Dir==1 ? N1 : N2,
+    Stride = Dir==0 ? 1 : Dir==1 ? N0 : N0*N1
+  };
+
+  template<bool Add, typename MatrixType, typename In, typename Out>
+  static EIGEN_STRONG_INLINE void run(const MatrixType& M, const In& in, Out& out)
+  {
+    typedef typename Out::Scalar Scalar;
+    typedef Matrix<Scalar,Out::RowsAtCompileTime,1> Column;
+    for(int i2=0; i2<M2; ++i2)
+      for(int i1=0; i1<M1; ++i1)
+        for(int i0=0; i0<M0; ++i0)
+        {
+          const int r = Dir==0 ? i0 : Dir==1 ? i1 : i2;
+          const int first = (Dir==0 ? 0 : i0) + N0*((Dir==1 ? 0 : i1) + N1*(Dir==2 ? 0 : i2));
+          Column acc = M.coeff(r,0) * in.col(first);
+          for(int j=1; j<Depth; ++j)
+            acc += M.coeff(r,j) * in.col(first+j*Stride);
+          if(Add)
+            out.col(i0 + M0*(i1 + M1*i2)) += acc;
+          else
+            out.col(i0 + M0*(i1 + M1*i2)) = acc;
+        }
+  }
+};
+
+template<typename MatA, typename MatB, typename MatC, typename BatchX, typename BatchY>
+void kronecker_product_apply(const MatA& A, const MatB& B, const MatC& C, const BatchX& X, BatchY& Y)
+{
+  typedef typename BatchY::Scalar Scalar;
+  enum {
+    Lanes = sum_factorization_lanes<Scalar>::value,
+    N0 = MatC::ColsAtCompileTime, N1 = MatB::ColsAtCompileTime, N2 = MatA::ColsAtCompileTime,
+    R0 = MatC::RowsAtCompileTime, R1 = MatB::RowsAtCompileTime, R2 = MatA::RowsAtCompileTime
+  };
+  // the work arrays are too large for the stack at high orders
+  Matrix<Scalar,Lanes,Dynamic> x(int(Lanes), N0*N1*N2), t0(int(Lanes), R0*N1*N2), t1(int(Lanes), R0*R1*N2),
+                               y(int(Lanes), R0*R1*R2);
+  const DenseIndex rows = X.rows();
+  for(DenseIndex first=0; first<rows; first+=Lanes)
+  {
+    const DenseIndex count = (std::min)(DenseIndex(Lanes), rows-first);
+    if(count<Lanes)
+      x.setZero();
+    x.topRows(count) = X.middleRows(first, count);
+    tensor_contraction<0,N0,N1,N2,R0>::template run<false>(C, x, t0);
+    tensor_contraction<1,R0,N1,N2,R1>::template run<false>(B, t0, t1);
+    tensor_contraction<2,R0,R1,N2,R2>::template run<false>(A, t1, y);
+    Y.middleRows(first, count) = y.topRows(count);
+  }
+}
+
+} // end namespace internal
+
+/** \ingroup KroneckerProduct_Module
+  *
+  * Applies the Kronecker product of three fixed size matrices to a batch of vectors without forming it: for each
+  * row of \a x, the same row of \a y is set to (a (x) b (x) c) * x.row(i)^T, i.e., y = x * kroneckerProduct(a,
+  * kroneckerProduct(b,c))^T. The product is computed by one contraction per factor, which costs
+  * O(n^4) instead of O(n^6) operations per vector for n x n factors.
+  *
+  * The batches store one vector per row, such that the contractions are vectorized over the rows. Like the
+  * kroneckerProduct() taking a block, the const cast hack allows \a y to be a block expression, e.g.,
+  * \code
+  * kroneckerProductApply(A, B, C, X.topRows(count), Y.topRows(count));
+  * \endcode
+  *
+  * \param a  Fixed size matrix acting on the slowest index of the vectors
+  * \param b  Fixed size matrix
+  * \param c  Fixed size matrix acting on the fastest index of the vectors
+  * \param x  Input batch, with a.cols()*b.cols()*c.cols() columns
+  * \param y  Output batch, with x.rows() rows and a.rows()*b.rows()*c.rows() columns
+  */
+template<typename A, typename B, typename C, typename X, typename Y>
+void kroneckerProductApply(const MatrixBase<A>& a, const MatrixBase<B>& b, const MatrixBase<C>& c,
+                           const MatrixBase<X>& x, MatrixBase<Y> const & y_)
+{
+  EIGEN_STATIC_ASSERT_FIXED_SIZE(A)
+  EIGEN_STATIC_ASSERT_FIXED_SIZE(B)
+  EIGEN_STATIC_ASSERT_FIXED_SIZE(C)
+  MatrixBase<Y>& y = const_cast<MatrixBase<Y>& >(y_);
+  eigen_assert(x.cols()==a.cols()*b.cols()*c.cols() && y.rows()==x.rows() && y.cols()==a.rows()*b.rows()*c.rows());
+  internal::kronecker_product_apply(a.eval(), b.eval(), c.eval(), x.derived(), y.derived());
+}
+
+/** \ingroup KroneckerProduct_Module
+  * \class SumFactorizationKernel
+  *
+  * \brief Matrix-free mass and stiffness matrices of tensor product hexahedral elements
+  *
+  * \tparam _Scalar the scalar type
+  * \tparam _Degree the polynomial degree p of the elements, which have (p+1)^3 degrees of freedom
+  * \tparam _Points the number of quadrature points per direction (default is p+1)
+  * \tparam _Index the type of the element indices
+  *
+  * The basis of the elements is the tensor product of a 1-D basis, given by its values and derivatives at the 1-D
+  * quadrature points and by the quadrature weights. The degree of freedom (i0,i1,i2) of an element has the index
+  * i0 + (p+1)*(i1 + (p+1)*i2), and the same ordering is used for the quadrature points. The interpolation and the
+  * gradients are thus Kronecker products of the 1-D matrices, which are applied by sum factorization: one 1-D
+  * contraction per direction costs O(p) operations per degree of freedom, while a dense element matrix would cost
+  * O(p^3) operations and (p+1)^6 coefficients.
+  *
+  * The matrix of the element e is A_e = m_e M + sum_d k_{d,e} K_d, where M is the reference mass matrix, K_d
+  * the reference stiffness matrix of the derivatives along the direction d, and m_e and k_{d,e} are the
+  * coefficients of the element given by setMassScales() and setStiffnessScales(). For instance, a brick of edges
+  * h0, h1, h2 mapped from the reference element has m_e = h0 h1 h2 and k_{d,e} = h0 h1 h2 / h_d^2.
+  *
+  * This class is a kernel of ElementOperator (see ElementMatrixKernel). The elements are processed by groups of
+  * four packets of \a _Scalar, one element per row. The work arrays take about 10 (_Points)^3 coefficients per
+  * element of a group, i.e., hundreds of kilobytes at high orders: they are allocated on the heap, in a Workspace
+  * that ElementOperator creates once per thread.
+  *
+  * \sa kroneckerProductApply(), ElementOperator
+  */
+template<typename _Scalar, int _Degree, int _Points = _Degree+1, typename _Index = int>
+class SumFactorizationKernel
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef _Index Index;
+    enum {
+      Degree = _Degree,
+      Nodes = _Degree+1,
+      Points = _Points,
+      Size = Nodes*Nodes*Nodes,
+      PointsSize = Points*Points*Points,
+      Lanes = internal::sum_factorization_lanes<Scalar>::value
+    };
+    typedef Matrix<Scalar,Points,Nodes> BasisType;
+    typedef Matrix<Scalar,Points,1> WeightsType;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+    typedef Matrix<Scalar,3,Dynamic> StiffnessScalesType;
+
+    /** Work arrays of apply(), which are allocated by the first call and then reused */
+    struct Workspace
+    {
+      Matrix<Scalar,Lanes,Dynamic> x, a, ad, b, b0, b1, u, g0, g1, g2;
+    };
+
+    SumFactorizationKernel() {}
+
+    /** Sets up the kernel of the 1-D basis whose values and derivatives at the quadrature points are \a values
+      * and \a derivatives (the j-th basis function at the q-th point is values(q,j)), with the quadrature
+      * weights \a weights. */
+    SumFactorizationKernel(const BasisType& values, const BasisType& derivatives, const WeightsType& weights)
+      : m_values(values), m_derivatives(derivatives), m_weights(weights)
+    {
+      for(int q2=0; q2<Points; ++q2)
+        for(int q1=0; q1<Points; ++q1)
+          for(int q0=0; q0<Points; ++q0)
+            m_pointWeights(q0 + Points*(q1 + Points*q2)) = weights(q0)*weights(q1)*weights(q2);
+    }
+
+    /** Sets the mass coefficients m_e of the elements */
+    SumFactorizationKernel& setMassScales(const VectorType& scales)
+    {
+      eigen_assert(m_stiffnessScales.cols()==0 || m_stiffnessScales.cols()==scales.size());
+      m_massScales = scales;
+      return *this;
+    }
+
+    /** Sets the stiffness coefficients k_{d,e} of the elements, the ones of the e-th element being the e-th
+      * column of \a scales */
+    SumFactorizationKernel& setStiffnessScales(const StiffnessScalesType& scales)
+    {
+      eigen_assert(m_massScales.size()==0 || m_massScales.size()==scales.cols());
+      m_stiffnessScales = scales;
+      return *this;
+    }
+
+    /** \returns the number of degrees of freedom of an element, (p+1)^3 */
+    Index size() const { return Size; }
+
+    /** \returns the number of elements */
+    Index elements() const { return m_massScales.size()>0 ? Index(m_massScales.size()) : Index(m_stiffnessScales.cols()); }
+
+    /** \returns the values of the 1-D basis at the quadrature points */
+    const BasisType& values() const { return m_values; }
+
+    /** \returns the derivatives of the 1-D basis at the quadrature points */
+    const BasisType& derivatives() const { return m_derivatives; }
+
+    /** \returns the 1-D quadrature weights */
+    const WeightsType& weights() const { return m_weights; }
+
+    /** Interpolates a batch of elements at the quadrature points: U has the rows of X and (_Points)^3 columns */
+    template<typename BatchX, typename BatchU>
+    void interpolate(const BatchX& X, BatchU& U) const
+    {
+      U.resize(X.rows(), PointsSize);
+      internal::kronecker_product_apply(m_values, m_values, m_values, X, U);
+    }
+
+    /** Computes the derivatives along the three directions of a batch of elements at the quadrature points */
+    template<typename BatchX, typename BatchG>
+    void gradient(const BatchX& X, BatchG& G0, BatchG& G1, BatchG& G2) const
+    {
+      G0.resize(X.rows(), PointsSize);
+      G1.resize(X.rows(), PointsSize);
+      G2.resize(X.rows(), PointsSize);
+      internal::kronecker_product_apply(m_values, m_values, m_derivatives, X, G0);
+      internal::kronecker_product_apply(m_values, m_derivatives, m_values, X, G1);
+      internal::kronecker_product_apply(m_derivatives, m_values, m_values, X, G2);
+    }
+
+    /** Tests a batch of values at the quadrature points against the basis functions, i.e., applies the transpose
+      * of interpolate(). The quadrature weights are not applied. */
+    template<typename BatchU, typename BatchY>
+    void integrate(const BatchU& U, BatchY& Y) const
+    {
+      Y.resize(U.rows(), Size);
+      internal::kronecker_product_apply(m_values.transpose(), m_values.transpose(), m_values.transpose(), U, Y);
+    }
+
+    /** Applies the matrices of a batch of \a count elements, whose indices are given by \a elements: for b<count,
+      * Y.row(b) is the product of the matrix of the element elements[b] with X.row(b). The other rows of \a Y are
+      * left unchanged. */
+    template<typename Batch>
+    void apply(const Index* elements, Index count, const Batch& X, Batch& Y) const
+    {
+      Workspace work;
+      apply(elements, count, X, Y, work);
+    }
+
+    /** Same as apply(elements, count, X, Y), using the work arrays of \a work */
+    template<typename Batch>
+    void apply(const Index* elements, Index count, const Batch& X, Batch& Y, Workspace& work) const
+    {
+      typedef internal::tensor_contraction<0,Nodes,Nodes,Nodes,Points> Forward0;
+      typedef internal::tensor_contraction<1,Points,Nodes,Nodes,Points> Forward1;
+      typedef internal::tensor_contraction<2,Points,Points,Nodes,Points> Forward2;
+      typedef internal::tensor_contraction<2,Points,Points,Points,Nodes> Backward2;
+      typedef internal::tensor_contraction<1,Points,Points,Nodes,Nodes> Backward1;
+      typedef internal::tensor_contraction<0,Points,Nodes,Nodes,Nodes> Backward0;
+      eigen_assert((m_massScales.size()>0 || m_stiffnessScales.cols()>0) && "SumFactorizationKernel: no scales");
+      const bool mass = m_massScales.size()>0, stiffness = m_stiffnessScales.cols()>0;
+
+      Matrix<Scalar,Lanes,Dynamic>& x = work.x;
+      Matrix<Scalar,Lanes,Dynamic>& a = work.a;
+      Matrix<Scalar,Lanes,Dynamic>& ad = work.ad;
+      Matrix<Scalar,Lanes,Dynamic>& b = work.b;
+      Matrix<Scalar,Lanes,Dynamic>& b0 = work.b0;
+      Matrix<Scalar,Lanes,Dynamic>& b1 = work.b1;
+      Matrix<Scalar,Lanes,Dynamic>& u = work.u;
+      Matrix<Scalar,Lanes,Dynamic>& g0 = work.g0;
+      Matrix<Scalar,Lanes,Dynamic>& g1 = work.g1;
+      Matrix<Scalar,Lanes,Dynamic>& g2 = work.g2;
+      x.resize(int(Lanes), Size);
+      a.resize(int(Lanes), Points*Nodes*Nodes);
+      b.resize(int(Lanes), Points*Points*Nodes);
+      if(mass)
+        u.resize(int(Lanes), PointsSize);
+      if(stiffness)
+      {
+        ad.resize(int(Lanes), Points*Nodes*Nodes);
+        b0.resize(int(Lanes), Points*Points*Nodes);
+        b1.resize(int(Lanes), Points*Points*Nodes);
+        g0.resize(int(Lanes), PointsSize);
+        g1.resize(int(Lanes), PointsSize);
+        g2.resize(int(Lanes), PointsSize);
+      }
+      Matrix<Scalar,Lanes,1> scale;
+      Matrix<Scalar,Lanes,3> stiffnessScale;
+      for(Index first=0; first<count; first+=Lanes)
+      {
+        const Index n = (std::min)(Index(Lanes), count-first);
+        x.setZero();
+        scale.setZero();
+        stiffnessScale.setZero();
+        for(Index l=0; l<n; ++l)
+        {
+          x.row(l) = X.row(first+l);
+          if(mass)
+            scale(l) = m_massScales(elements[first+l]);
+          if(stiffness)
+            stiffnessScale.row(l) = m_stiffnessScales.col(elements[first+l]).transpose();
+        }
+
+        // values and derivatives at the quadrature points, sharing the contractions of the first directions
+        Forward0::template run<false>(m_values, x, a);
+        Forward1::template run<false>(m_values, a, b);
+        if(mass)
+          Forward2::template run<false>(m_values, b, u);
+        if(stiffness)
+        {
+          Forward0::template run<false>(m_derivatives, x, ad);
+          Forward1::template run<false>(m_values, ad, b0);
+          Forward1::template run<false>(m_derivatives, a, b1);
+          Forward2::template run<false>(m_values, b0, g0);
+          Forward2::template run<false>(m_values, b1, g1);
+          Forward2::template run<false>(m_derivatives, b, g2);
+        }
+
+        // quadrature weights and coefficients of the elements
+        for(int q=0; q<PointsSize; ++q)
+        {
+          if(mass)
+            u.col(q) = m_pointWeights(q) * u.col(q).cwiseProduct(scale);
+          if(stiffness)
+          {
+            g0.col(q) = m_pointWeights(q) * g0.col(q).cwiseProduct(stiffnessScale.col(0));
+            g1.col(q) = m_pointWeights(q) * g1.col(q).cwiseProduct(stiffnessScale.col(1));
+            g2.col(q) = m_pointWeights(q) * g2.col(q).cwiseProduct(stiffnessScale.col(2));
+          }
+        }
+
+        // transposed contractions, in the reverse order
+        if(mass && stiffness)
+        {
+          Backward2::template run<false>(m_values.transpose(), u, b);
+          Backward2::template run<true>(m_derivatives.transpose(), g2, b);
+        }
+        else if(mass)
+          Backward2::template run<false>(m_values.transpose(), u, b);
+        else
+          Backward2::template run<false>(m_derivatives.transpose(), g2, b);
+        Backward1::template run<false>(m_values.transpose(), b, a);
+        if(stiffness)
+        {
+          Backward2::template run<false>(m_values.transpose(), g0, b0);
+          Backward2::template run<false>(m_values.transpose(), g1, b1);
+          Backward1::template run<true>(m_derivatives.transpose(), b1, a);
+          Backward1::template run<false>(m_values.transpose(), b0, ad);
+        }
+        Backward0::template run<false>(m_values.transpose(), a, x);
+        if(stiffness)
+          Backward0::template run<true>(m_derivatives.transpose(), ad, x);
+
+        for(Index l=0; l<n; ++l)
+          Y.row(first+l) = x.row(l);
+      }
+    }
+
+    /** Sets \a diag to the diagonal of the matrix of the element \a e */
+    template<typename Vector>
+    void diagonal(Index e, Vector& diag) const
+    {
+      // the diagonal of a Kronecker product is the Kronecker product of the diagonals
+      Matrix<Scalar,Nodes,1> m = (m_values.transpose() * m_weights.asDiagonal() * m_values).diagonal();
+      Matrix<Scalar,Nodes,1> k = (m_derivatives.transpose() * m_weights.asDiagonal() * m_derivatives).diagonal();
+      diag.resize(Size);
+      for(int i2=0; i2<Nodes; ++i2)
+        for(int i1=0; i1<Nodes; ++i1)
+          for(int i0=0; i0<Nodes; ++i0)
+          {
+            Scalar d(0);
+            if(m_massScales.size()>0)
+              d += m_massScales(e) * m(i0)*m(i1)*m(i2);
+            if(m_stiffnessScales.cols()>0)
+              d += m_stiffnessScales(0,e) * k(i0)*m(i1)*m(i2)
+                 + m_stiffnessScales(1,e) * m(i0)*k(i1)*m(i2)
+                 + m_stiffnessScales(2,e) * m(i0)*m(i1)*k(i2);
+            diag(i0 + Nodes*(i1 + Nodes*i2)) = d;
+          }
+    }
+
+  protected:
+    BasisType m_values;
+    BasisType m_derivatives;
+    WeightsType m_weights;
+    Matrix<Scalar,PointsSize,1> m_pointWeights;
+    VectorType m_massScales;
+    StiffnessScalesType m_stiffnessScales;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_SUM_FACTORIZATION_H
@@ -0,0 +1,629 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BLOCKSPARSEMATRIX_H
+#define EIGEN_BLOCKSPARSEMATRIX_H
+
+namespace Eigen {
+
+template<typename _Scalar, int _BlockRows, int _BlockCols, typename _Index = int> class BlockSparseMatrix;
+template<typename MatrixType, unsigned int UpLo> class BlockSparseSelfAdjointView;
+template<typename Lhs, typename Rhs, int UpLo> class BlockSparseSelfAdjointTimeDenseProduct;
+
+namespace internal {
+template<typename _Scalar, int _BlockRows, int _BlockCols, typename _Index>
+struct traits<BlockSparseMatrix<_Scalar,_BlockRows,_BlockCols,_Index> >
+{
+  typedef _Scalar Scalar;
+  typedef _Index Index;
+  typedef Sparse StorageKind;
+  typedef MatrixXpr XprKind;
+  enum {
+    RowsAtCompileTime = Dynamic,
+    ColsAtCompileTime = Dynamic,
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = Dynamic,
+    Flags = RowMajorBit | NestByRefBit | LvalueBit,
+    CoeffReadCost = NumTraits<Scalar>::ReadCost,
+    SupportedAccessPatterns = OuterRandomAccessPattern
+  };
+};
+}
+
+/** \ingroup SparseExtra_Module
+  * \class BlockSparseMatrix
+  *
+  * \brief A sparse matrix made of dense blocks of fixed size (block compressed row storage, aka BSR)
+  *
+  * \tparam _Scalar the scalar type, i.e. the type of the coefficients
+  * \tparam _BlockRows the number of rows of the blocks
+  * \tparam _BlockCols the number of columns of the blocks
+  * \tparam _Index the type of the indices
+  *
+  * The matrix is a blockRows() x blockCols() sparse matrix of _BlockRows x _BlockCols dense blocks. The blocks of
+  * each block row are stored one after the other with sorted block column indices, and only one index is stored
+  * per block. Each block is stored in column major order. This is the natural storage of the matrices of
+  * vector valued finite element problems, such as elasticity, where each pair of coupled nodes yields a dense
+  * block: compared to SparseMatrix, the index traffic is divided by _BlockRows*_BlockCols and the products with
+  * dense vectors and matrices are computed block per block by the fixed size kernels of Eigen.
+  *
+  * The typical usage for finite elements is:
+  * \code
+  * BlockSparseMatrix<double,3,3> A(nbNodes, nbNodes);
+  * A.setPatternFromElements(connectivity.data(), nbElements, nodesPerElement);
+  * for(int e=0; e<nbElements; ++e)
+  *   A.addElement(&connectivity[e*nodesPerElement], nodesPerElement, elementMatrix(e));
+  * ConjugateGradient<BlockSparseMatrix<double,3,3> > cg(A);
+  * x = cg.solve(b);
+  * \endcode
+  *
+  * It is a SparseMatrixBase expression whose inner vectors are the scalar rows, so it can be converted to and from
+  * SparseMatrix, and be used by any algorithm based on the generic sparse interface, e.g., the preconditioners of
+  * the IterativeLinearSolvers module. The products with a dense vector or matrix and with its selfadjointView()
+  * are block based, and the former is multithreaded when OpenMP is enabled.
+  *
+  * \sa SparseMatrix
+  */
+template<typename _Scalar, int _BlockRows, int _BlockCols, typename _Index>
+class BlockSparseMatrix
+  : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_BlockRows,_BlockCols,_Index> >
+{
+  public:
+    EIGEN_SPARSE_PUBLIC_INTERFACE(BlockSparseMatrix)
+
+    enum {
+      BlockRows = _BlockRows,
+      BlockCols = _BlockCols,
+      BlockSize = _BlockRows*_BlockCols
+    };
+    typedef Matrix<Scalar,BlockRows,BlockCols> BlockType;
+    typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+
+    class InnerIterator;
+    class ReverseInnerIterator;
+
+    /** Default constructor yielding an empty \c 0 \c x \c 0 matrix */
+    BlockSparseMatrix() : m_blockRows(0), m_blockCols(0), m_outerIndex(IndexVector::Zero(1)) {}
+
+    /** Constructs an empty matrix of \a blockRows x \a blockCols blocks */
+    BlockSparseMatrix(Index blockRows, Index blockCols)
+    {
+      resize(blockRows, blockCols);
+    }
+
+    /** Constructs a block matrix from the sparse matrix \a other
+      * \sa operator=(const SparseMatrixBase<OtherDerived>&) */
+    template<typename OtherDerived>
+    BlockSparseMatrix(const SparseMatrixBase<OtherDerived>& other) : m_blockRows(0), m_blockCols(0)
+    {
+      *this = other.derived();
+    }
+
+    BlockSparseMatrix(const BlockSparseMatrix& other)
+      : Base(), m_blockRows(other.m_blockRows), m_blockCols(other.m_blockCols),
+        m_outerIndex(other.m_outerIndex), m_innerIndex(other.m_innerIndex), m_values(other.m_values)
+    {}
+
+    BlockSparseMatrix& operator=(const BlockSparseMatrix& other)
+    {
+      m_blockRows = other.m_blockRows;
+      m_blockCols = other.m_blockCols;
+      m_outerIndex = other.m_outerIndex;
+      m_innerIndex = other.m_innerIndex;
+      m_values = other.m_values;
+      return *this;
+    }
+
+    /** Copies the sparse matrix \a other. Its sizes must be multiples of the block sizes, and every block containing
+      * at least one stored coefficient of \a other is stored. */
+    template<typename OtherDerived>
+    BlockSparseMatrix& operator=(const SparseMatrixBase<OtherDerived>& other);
+
+    /** Resizes the matrix to \a blockRows x \a blockCols blocks, and removes all the blocks */
+    void resize(Index blockRows, Index blockCols)
+    {
+      m_blockRows = blockRows;
+      m_blockCols = blockCols;
+      m_outerIndex.setZero(blockRows+1);
+      m_innerIndex.resize(0);
+      m_values.resize(0);
+    }
+
+    inline Index rows() const { return m_blockRows * BlockRows; }
+    inline Index cols() const { return m_blockCols * BlockCols; }
+    inline Index innerSize() const { return cols(); }
+    inline Index outerSize() const { return rows(); }
+
+    /** \returns the number of block rows */
+    inline Index blockRows() const { return m_blockRows; }
+    /** \returns the number of block columns */
+    inline Index blockCols() const { return m_blockCols; }
+    /** \returns the number of stored blocks */
+    inline Index nonZeroBlocks() const { return m_outerIndex[m_blockRows]; }
+    /** \returns the number of stored coefficients, i.e., nonZeroBlocks()*BlockRows*BlockCols */
+    inline Index nonZeros() const { return nonZeroBlocks() * BlockSize; }
+
+    /** \returns a pointer to the array of the starting positions of the block rows (size blockRows()+1) */
+    inline const Index* outerIndexPtr() const { return m_outerIndex.data(); }
+    /** \returns a pointer to the array of the block column indices of the stored blocks */
+    inline const Index* innerIndexPtr() const { return m_innerIndex.data(); }
+    /** \returns a pointer to the coefficients of the stored blocks, each block being stored in column major order */
+    inline const Scalar* valuePtr() const { return m_values.data(); }
+    inline Scalar* valuePtr() { return m_values.data(); }
+
+    /** \returns a vector expression of all the stored coefficients, e.g., A.coeffs().setZero() resets the values
+      * while keeping the block pattern. */
+    Map<ScalarVector> coeffs() { return Map<ScalarVector>(m_values.data(), m_values.size()); }
+    const Map<const ScalarVector> coeffs() const { return Map<const ScalarVector>(m_values.data(), m_values.size()); }
+
+    /** \returns the position of the block (\a i, \a j) in the list of the stored blocks, or -1 if it is not stored */
+    Index blockIndex(Index i, Index j) const
+    {
+      eigen_assert(i>=0 && i<m_blockRows && j>=0 && j<m_blockCols);
+      const Index* begin = m_innerIndex.data() + m_outerIndex[i];
+      const Index* end = m_innerIndex.data() + m_outerIndex[i+1];
+      const Index* p = std::lower_bound(begin, end, j);
+      return (p!=end && *p==j) ? Index(p - m_innerIndex.data()) : Index(-1);
+    }
+
+    /** \returns a writable expression of the stored block (\a i, \a j). The block must be present in the pattern. */
+    Map<BlockType> blockRef(Index i, Index j)
+    {
+      Index p = blockIndex(i,j);
+      eigen_assert(p>=0 && "BlockSparseMatrix::blockRef: the block is not in the pattern");
+      return Map<BlockType>(m_values.data() + p*BlockSize);
+    }
+
+    /** \returns the block (\a i, \a j), which is zero if it is not stored */
+    BlockType block(Index i, Index j) const
+    {
+      Index p = blockIndex(i,j);
+      return p>=0 ? BlockType(Map<const BlockType>(m_values.data() + p*BlockSize)) : BlockType(BlockType::Zero());
+    }
+
+    /** Sets the block pattern from a finite element mesh: every pair of nodes of each element yields a block.
+      * The nodes of the element \c e are \a elementNodes[e*nodesPerElement+k] for k < \a nodesPerElement, and
+      * must be lower than both blockRows() and blockCols(). The values are set to zero. */
+    void setPatternFromElements(const Index* elementNodes, Index numElements, Index nodesPerElement);
+
+    /** Adds the element matrix \a Ke, of size (\a numNodes * BlockRows) x (\a numNodes * BlockCols), to the blocks
+      * coupling the \a numNodes nodes \a nodes. All these blocks must be present in the pattern.
+      * \sa setPatternFromElements() */
+    template<typename Derived>
+    void addElement(const Index* nodes, Index numNodes, const MatrixBase<Derived>& Ke)
+    {
+      eigen_assert(Ke.rows()==numNodes*BlockRows && Ke.cols()==numNodes*BlockCols);
+      for(Index a=0; a<numNodes; ++a)
+        for(Index b=0; b<numNodes; ++b)
+          blockRef(nodes[a],nodes[b]) += Ke.template block<BlockRows,BlockCols>(a*BlockRows, b*BlockCols);
+    }
+
+    /** Fills the matrix from the list of scalar triplets [\a begin, \a end), summing the duplicates.
+      * The sizes of the matrix must be set beforehand, e.g., by the constructor or resize().
+      * \sa SparseMatrix::setFromTriplets() */
+    template<typename InputIterator>
+    void setFromTriplets(const InputIterator& begin, const InputIterator& end)
+    {
+      SparseMatrix<Scalar,RowMajor,Index> tmp(rows(), cols());
+      tmp.setFromTriplets(begin, end);
+      *this = tmp;
+    }
+
+    /** \returns an expression of the selfadjoint matrix whose \a UpLo triangular part is the one of \c *this.
+      * Only the blocks of this triangular part are read, and the diagonal blocks must be square. */
+    template<unsigned int UpLo> inline const BlockSparseSelfAdjointView<BlockSparseMatrix, UpLo> selfadjointView() const
+    {
+      return BlockSparseSelfAdjointView<BlockSparseMatrix, UpLo>(*this);
+    }
+
+    void swap(BlockSparseMatrix& other)
+    {
+      std::swap(m_blockRows, other.m_blockRows);
+      std::swap(m_blockCols, other.m_blockCols);
+      m_outerIndex.swap(other.m_outerIndex);
+      m_innerIndex.swap(other.m_innerIndex);
+      m_values.swap(other.m_values);
+    }
+
+  protected:
+    Index m_blockRows;
+    Index m_blockCols;
+    IndexVector m_outerIndex;
+    IndexVector m_innerIndex;
+    ScalarVector m_values;
+};
+
+template<typename Scalar, int _BlockRows, int _BlockCols, typename _Index>
+template<typename OtherDerived>
+BlockSparseMatrix<Scalar,_BlockRows,_BlockCols,_Index>&
+BlockSparseMatrix<Scalar,_BlockRows,_BlockCols,_Index>::operator=(const SparseMatrixBase<OtherDerived>& other)
+{
+  eigen_assert(other.rows()%BlockRows==0 && other.cols()%BlockCols==0
+            && "BlockSparseMatrix: the sizes must be multiples of the block sizes");
+  typedef SparseMatrix<Scalar,RowMajor,Index> RowMajorMatrix;
+  // the copy also protects from aliasing
+  RowMajorMatrix mat(other.derived());
+  const Index nbr = mat.rows()/BlockRows;
+  IndexVector mask = IndexVector::Constant(mat.cols()/BlockCols, -1);
+
+  // count the blocks of each block row
+  IndexVector outerIndex(nbr+1);
+  outerIndex[0] = 0;
+  for(Index i=0; i<nbr; ++i)
+  {
+    Index count = 0;
+    for(Index r=i*BlockRows; r<(i+1)*BlockRows; ++r)
+      for(typename RowMajorMatrix::InnerIterator it(mat,r); it; ++it)
+      {
+        Index j = it.index()/BlockCols;
+        if(mask[j]!=i)
+        {
+          mask[j] = i;
+          ++count;
+        }
+      }
+    outerIndex[i+1] = outerIndex[i] + count;
+  }
+
+  // fill the blocks: the block columns of each block row are gathered, sorted, and the values are scattered
+  IndexVector innerIndex(outerIndex[nbr]);
+  ScalarVector values = ScalarVector::Zero(outerIndex[nbr]*BlockSize);
+  IndexVector position(mask.size());
+  mask.setConstant(-1);
+  for(Index i=0; i<nbr; ++i)
+  {
+    Index p = outerIndex[i];
+    for(Index r=i*BlockRows; r<(i+1)*BlockRows; ++r)
+      for(typename RowMajorMatrix::InnerIterator it(mat,r); it; ++it)
+      {
+        Index j = it.index()/BlockCols;
+        if(mask[j]!=i)
+        {
+          mask[j] = i;
+          innerIndex[p++] = j;
+        }
+      }
+    std::sort(innerIndex.data()+outerIndex[i], innerIndex.data()+p);
+    for(Index k=outerIndex[i]; k<p; ++k)
+      position[innerIndex[k]] = k;
+    for(Index r=i*BlockRows; r<(i+1)*BlockRows; ++r)
+      for(typename RowMajorMatrix::InnerIterator it(mat,r); it; ++it)
+      {
+        Index j = it.index()/BlockCols;
+        values[position[j]*BlockSize + (it.index()%BlockCols)*BlockRows + (r-i*BlockRows)] += it.value();
+      }
+  }
+
+  m_blockRows = nbr;
+  m_blockCols = mat.cols()/BlockCols;
+  m_outerIndex.swap(outerIndex);
+  m_innerIndex.swap(innerIndex);
+  m_values.swap(values);
+  return *this;
+}
+
+template<typename Scalar, int _BlockRows, int _BlockCols, typename _Index>
+void BlockSparseMatrix<Scalar,_BlockRows,_BlockCols,_Index>::setPatternFromElements(const Index* elementNodes,
+                                                                                   Index numElements, Index nodesPerElement)
+{
+  // the node-to-element lists are built first, then every node is connected to the nodes of its elements
+  const Index n = m_blockRows;
+  IndexVector elementPtr = IndexVector::Zero(n+1);
+  for(Index k=0; k<numElements*nodesPerElement; ++k)
+  {
+    eigen_assert(elementNodes[k]>=0 && elementNodes[k]<n && elementNodes[k]<m_blockCols);
+    ++elementPtr[elementNodes[k]+1];
+  }
+  for(Index i=0; i<n; ++i)
+    elementPtr[i+1] += elementPtr[i];
+  IndexVector elements(elementPtr[n]);
+  {
+    IndexVector fill = elementPtr.head(n);
+    for(Index e=0; e<numElements; ++e)
+      for(Index k=0; k<nodesPerElement; ++k)
+        elements[fill[elementNodes[e*nodesPerElement+k]]++] = e;
+  }
+
+  IndexVector mask = IndexVector::Constant(m_blockCols, -1);
+  m_outerIndex.resize(n+1);
+  m_outerIndex[0] = 0;
+  for(int pass=0; pass<2; ++pass)
+  {
+    mask.setConstant(-1);
+    for(Index i=0; i<n; ++i)
+    {
+      Index p = m_outerIndex[i];
+      for(Index q=elementPtr[i]; q<elementPtr[i+1]; ++q)
+      {
+        const Index* nodes = elementNodes + elements[q]*nodesPerElement;
+        for(Index k=0; k<nodesPerElement; ++k)
+          if(mask[nodes[k]]!=i)
+          {
+            mask[nodes[k]] = i;
+            if(pass==1)
+              m_innerIndex[p] = nodes[k];
+            ++p;
+          }
+      }
+      if(pass==0)
+        m_outerIndex[i+1] = p;
+      else
+        std::sort(m_innerIndex.data()+m_outerIndex[i], m_innerIndex.data()+p);
+    }
+    if(pass==0)
+      m_innerIndex.resize(m_outerIndex[n]);
+  }
+  m_values.setZero(m_outerIndex[n]*BlockSize);
+}
+
+/** \class BlockSparseMatrix::InnerIterator
+  * Iterates over the stored coefficients of a scalar row, including the explicit zeros of the blocks. */
+template<typename Scalar, int _BlockRows, int _BlockCols, typename _Index>
+class BlockSparseMatrix<Scalar,_BlockRows,_BlockCols,_Index>::InnerIterator
+{
+  public:
+    InnerIterator(const BlockSparseMatrix& mat, Index outer)
+      : m_values(mat.valuePtr() + outer%BlockRows), m_indices(mat.innerIndexPtr()), m_outer(outer),
+        m_id(mat.outerIndexPtr()[outer/BlockRows]), m_end(mat.outerIndexPtr()[outer/BlockRows+1]), m_c(0)
+    {}
+
+    inline InnerIterator& operator++()
+    {
+      if(++m_c==BlockCols)
+      {
+        m_c = 0;
+        ++m_id;
+      }
+      return *this;
+    }
+
+    inline const Scalar& value() const { return m_values[m_id*BlockSize + m_c*BlockRows]; }
+    inline Scalar& valueRef() { return const_cast<Scalar&>(m_values[m_id*BlockSize + m_c*BlockRows]); }
+
+    inline Index index() const { return m_indices[m_id]*BlockCols + m_c; }
+    inline Index outer() const { return m_outer; }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_id < m_end; }
+
+  protected:
+    const Scalar* m_values;
+    const Index* m_indices;
+    const Index m_outer;
+    Index m_id;
+    const Index m_end;
+    Index m_c;
+};
+
+template<typename Scalar, int _BlockRows, int _BlockCols, typename _Index>
+class BlockSparseMatrix<Scalar,_BlockRows,_BlockCols,_Index>::ReverseInnerIterator
+{
+  public:
+    ReverseInnerIterator(const BlockSparseMatrix& mat, Index outer)
+      : m_values(mat.valuePtr() + outer%BlockRows), m_indices(mat.innerIndexPtr()), m_outer(outer),
+        m_start(mat.outerIndexPtr()[outer/BlockRows]), m_id(mat.outerIndexPtr()[outer/BlockRows+1]), m_c(BlockCols-1)
+    {}
+
+    inline ReverseInnerIterator& operator--()
+    {
+      if(m_c==0)
+      {
+        m_c = BlockCols-1;
+        --m_id;
+      }
+      else
+        --m_c;
+      return *this;
+    }
+
+    inline const Scalar& value() const { return m_values[(m_id-1)*BlockSize + m_c*BlockRows]; }
+    inline Scalar& valueRef() { return const_cast<Scalar&>(m_values[(m_id-1)*BlockSize + m_c*BlockRows]); }
+
+    inline Index index() const { return m_indices[m_id-1]*BlockCols + m_c; }
+    inline Index outer() const { return m_outer; }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_id > m_start; }
+
+  protected:
+    const Scalar* m_values;
+    const Index* m_indices;
+    const Index m_outer;
+    const Index m_start;
+    Index m_id;
+    Index m_c;
+};
+
+namespace internal {
+
+// res += alpha * lhs * rhs, computed block per block. Each block is multiplied by the whole BlockCols x rhs.cols()
+// slice of rhs, and the block rows are distributed over the threads.
+template<typename Lhs, typename Rhs, typename Res>
+void block_sparse_time_dense_product(const Lhs& lhs, const Rhs& rhs, Res& res, typename Res::Scalar alpha)
+{
+  typedef typename Lhs::Scalar Scalar;
+  typedef typename Lhs::Index Index;
+  typedef typename Lhs::BlockType BlockType;
+  enum { BR = Lhs::BlockRows, BC = Lhs::BlockCols };
+
+  const Index* outerIndex = lhs.outerIndexPtr();
+  const Index* innerIndex = lhs.innerIndexPtr();
+  const Scalar* values = lhs.valuePtr();
+  const Index nbr = lhs.blockRows();
+  const Index threads = sparse_product_threads<Index>(nbr, lhs.nonZeros()*rhs.cols());
+
+  if(rhs.cols()==1)
+  {
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(static) num_threads(threads) if(threads>1)
+#endif
+    for(Index i=0; i<nbr; ++i)
+    {
+      Matrix<Scalar,BR,1> acc = Matrix<Scalar,BR,1>::Zero();
+      for(Index p=outerIndex[i]; p<outerIndex[i+1]; ++p)
+        acc.noalias() += Map<const BlockType>(values + p*Lhs::BlockSize) * rhs.col(0).template segment<BC>(innerIndex[p]*BC);
+      res.col(0).template segment<BR>(i*BR) += alpha * acc;
+    }
+  }
+  else
+  {
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel num_threads(threads) if(threads>1)
+#endif
+    {
+      Matrix<Scalar,BR,Dynamic> acc(int(BR), rhs.cols());
+#ifdef EIGEN_HAS_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for(Index i=0; i<nbr; ++i)
+      {
+        acc.setZero();
+        for(Index p=outerIndex[i]; p<outerIndex[i+1]; ++p)
+          acc.noalias() += Map<const BlockType>(values + p*Lhs::BlockSize) * rhs.template middleRows<BC>(innerIndex[p]*BC);
+        res.template middleRows<BR>(i*BR) += alpha * acc;
+      }
+    }
+  }
+}
+
+template<typename Scalar, int BR, int BC, typename Index, typename DenseRhsType, typename DenseResType>
+struct sparse_time_dense_product_impl<BlockSparseMatrix<Scalar,BR,BC,Index>,DenseRhsType,DenseResType,RowMajor,true>
+{
+  static void run(const BlockSparseMatrix<Scalar,BR,BC,Index>& lhs, const DenseRhsType& rhs, DenseResType& res,
+                  typename DenseResType::Scalar alpha)
+  {
+    block_sparse_time_dense_product(lhs, rhs, res, alpha);
+  }
+};
+
+template<typename Scalar, int BR, int BC, typename Index, typename DenseRhsType, typename DenseResType>
+struct sparse_time_dense_product_impl<BlockSparseMatrix<Scalar,BR,BC,Index>,DenseRhsType,DenseResType,RowMajor,false>
+{
+  static void run(const BlockSparseMatrix<Scalar,BR,BC,Index>& lhs, const DenseRhsType& rhs, DenseResType& res,
+                  typename DenseResType::Scalar alpha)
+  {
+    block_sparse_time_dense_product(lhs, rhs, res, alpha);
+  }
+};
+
+template<typename MatrixType, unsigned int UpLo>
+struct traits<BlockSparseSelfAdjointView<MatrixType,UpLo> > : traits<MatrixType> {};
+
+template<typename Lhs, typename Rhs, int UpLo>
+struct traits<BlockSparseSelfAdjointTimeDenseProduct<Lhs,Rhs,UpLo> >
+ : traits<ProductBase<BlockSparseSelfAdjointTimeDenseProduct<Lhs,Rhs,UpLo>, Lhs, Rhs> >
+{
+  typedef Dense StorageKind;
+};
+
+} // end namespace internal
+
+/** \ingroup SparseExtra_Module
+  * \class BlockSparseSelfAdjointView
+  *
+  * Expression of the selfadjoint matrix defined by the \a UpLo triangular part of a BlockSparseMatrix.
+  * It is returned by BlockSparseMatrix::selfadjointView(), and is used by ConjugateGradient.
+  */
+template<typename MatrixType, unsigned int UpLo> class BlockSparseSelfAdjointView
+  : public EigenBase<BlockSparseSelfAdjointView<MatrixType,UpLo> >
+{
+  public:
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
+
+    inline BlockSparseSelfAdjointView(const MatrixType& matrix) : m_matrix(matrix)
+    {
+      EIGEN_STATIC_ASSERT(int(MatrixType::BlockRows)==int(MatrixType::BlockCols), THIS_METHOD_IS_ONLY_FOR_MATRICES_OF_A_SPECIFIC_SIZE);
+      eigen_assert(rows()==cols() && "SelfAdjointView is only for squared matrices");
+    }
+
+    inline Index rows() const { return m_matrix.rows(); }
+    inline Index cols() const { return m_matrix.cols(); }
+
+    /** \returns a reference to the nested matrix */
+    const MatrixType& matrix() const { return m_matrix; }
+
+    /** Efficient block sparse self-adjoint matrix times dense vector/matrix product */
+    template<typename OtherDerived>
+    BlockSparseSelfAdjointTimeDenseProduct<MatrixType,OtherDerived,UpLo>
+    operator*(const MatrixBase<OtherDerived>& rhs) const
+    {
+      return BlockSparseSelfAdjointTimeDenseProduct<MatrixType,OtherDerived,UpLo>(m_matrix, rhs.derived());
+    }
+
+  protected:
+    const MatrixType& m_matrix;
+};
+
+template<typename Lhs, typename Rhs, int UpLo>
+class BlockSparseSelfAdjointTimeDenseProduct
+  : public ProductBase<BlockSparseSelfAdjointTimeDenseProduct<Lhs,Rhs,UpLo>, Lhs, Rhs>
+{
+  public:
+    EIGEN_PRODUCT_PUBLIC_INTERFACE(BlockSparseSelfAdjointTimeDenseProduct)
+
+    BlockSparseSelfAdjointTimeDenseProduct(const Lhs& lhs, const Rhs& rhs) : Base(lhs,rhs)
+    {}
+
+    // Each off-diagonal block B_ij of the UpLo part contributes B_ij x_j to the block row i and B_ij^* x_i to the
+    // block row j. Because of these scattered updates, the product is sequential.
+    template<typename Dest> void scaleAndAddTo(Dest& dest, Scalar alpha) const
+    {
+      typedef typename internal::remove_all<Lhs>::type _Lhs;
+      typedef typename _Lhs::BlockType BlockType;
+      typedef typename _Lhs::Index LhsIndex;
+      enum { BS = _Lhs::BlockRows };
+      const _Lhs& lhs = m_lhs;
+      const LhsIndex* outerIndex = lhs.outerIndexPtr();
+      const LhsIndex* innerIndex = lhs.innerIndexPtr();
+      const Scalar* values = lhs.valuePtr();
+
+      for(Index c=0; c<m_rhs.cols(); ++c)
+      {
+        for(Index i=0; i<lhs.blockRows(); ++i)
+        {
+          Matrix<Scalar,BS,1> xi = alpha * m_rhs.col(c).template segment<BS>(i*BS);
+          Matrix<Scalar,BS,1> acc = Matrix<Scalar,BS,1>::Zero();
+          for(Index p=outerIndex[i]; p<outerIndex[i+1]; ++p)
+          {
+            const Index j = innerIndex[p];
+            Map<const BlockType> b(values + p*_Lhs::BlockSize);
+            if(j==i)
+            {
+              for(Index k=0; k<BS; ++k)
+                for(Index l=0; l<BS; ++l)
+                {
+                  if(k==l)
+                    acc[k] += b(k,k) * xi[k];
+                  else if((UpLo&Lower) ? k>l : k<l)
+                  {
+                    acc[k] += b(k,l) * xi[l];
+                    acc[l] += internal::conj(b(k,l)) * xi[k];
+                  }
+                }
+            }
+            else if((UpLo&Lower) ? j<i : j>i)
+            {
+              acc.noalias() += b * (alpha * m_rhs.col(c).template segment<BS>(j*BS));
+              dest.col(c).template segment<BS>(j*BS) += b.adjoint() * xi;
+            }
+          }
+          dest.col(c).template segment<BS>(i*BS) += acc;
+        }
+      }
+    }
+
+  private:
+    BlockSparseSelfAdjointTimeDenseProduct& operator=(const BlockSparseSelfAdjointTimeDenseProduct&);
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_BLOCKSPARSEMATRIX_H
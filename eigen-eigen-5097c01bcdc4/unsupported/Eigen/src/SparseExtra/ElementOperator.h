@@ -0,0 +1,420 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_ELEMENTOPERATOR_H
+#define EIGEN_ELEMENTOPERATOR_H
+
+namespace Eigen {
+
+template<typename _Kernel> class ElementOperator;
+template<typename Lhs, typename Rhs> class ElementOperatorProduct;
+
+namespace internal {
+template<typename _Kernel>
+struct traits<ElementOperator<_Kernel> >
+{
+  typedef typename _Kernel::Scalar Scalar;
+  typedef typename _Kernel::Index Index;
+  typedef Sparse StorageKind;
+  typedef MatrixXpr XprKind;
+  enum {
+    RowsAtCompileTime = Dynamic,
+    ColsAtCompileTime = Dynamic,
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = Dynamic,
+    Flags = NestByRefBit,
+    CoeffReadCost = NumTraits<Scalar>::ReadCost
+  };
+};
+
+template<typename Lhs, typename Rhs>
+struct traits<ElementOperatorProduct<Lhs,Rhs> >
+ : traits<ProductBase<ElementOperatorProduct<Lhs,Rhs>, Lhs, Rhs> >
+{
+  typedef Dense StorageKind;
+};
+}
+
+/** \ingroup SparseExtra_Module
+  * \class ElementMatrixKernel
+  *
+  * \brief Element kernel of an ElementOperator applying stored dense element matrices
+  *
+  * \tparam _Scalar the scalar type of the element matrices
+  * \tparam _Index the type of the element indices
+  *
+  * The element matrices are either stored for each element, or shared by all the elements up to a scaling factor
+  * per element, e.g., the matrix of a reference element scaled by the Jacobians of a regular mesh. In the latter
+  * case, a batch of elements is applied by a single matrix product.
+  *
+  * This class also documents the interface of the kernels of ElementOperator: the typedefs \c Scalar and
+  * \c Index, the type \c Workspace of the work arrays of apply(), which ElementOperator creates once per
+  * thread, and the size(), apply() and diagonal() member functions.
+  *
+  * \sa ElementOperator
+  */
+template<typename _Scalar, typename _Index = int>
+class ElementMatrixKernel
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef _Index Index;
+    typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+    /** Work arrays of apply(), none for this kernel */
+    struct Workspace {};
+
+    ElementMatrixKernel() {}
+
+    /** Stores the element matrices \a matrices, the one of the e-th element being the e-th square block of
+      * columns: matrices.middleCols(e*size(),size()) */
+    ElementMatrixKernel(const MatrixType& matrices) : m_matrices(matrices)
+    {
+      eigen_assert(matrices.rows()>0 && matrices.cols()%matrices.rows()==0);
+    }
+
+    /** Shares the matrix \a reference between all the elements, the one of the e-th element being
+      * scales(e) * \a reference */
+    ElementMatrixKernel(const MatrixType& reference, const VectorType& scales) : m_matrices(reference), m_scales(scales)
+    {
+      eigen_assert(reference.rows()==reference.cols());
+    }
+
+    /** \returns the number of degrees of freedom of an element */
+    Index size() const { return m_matrices.rows(); }
+
+    /** \returns the number of elements */
+    Index elements() const { return m_scales.size()>0 ? Index(m_scales.size()) : Index(m_matrices.cols()/size()); }
+
+    /** Applies the matrices of a batch of \a count elements, whose indices are given by \a elements: for b<count,
+      * Y.row(b) is the product of the matrix of the element elements[b] with X.row(b). The other rows of \a Y
+      * are left unchanged. */
+    template<typename Batch>
+    void apply(const Index* elements, Index count, const Batch& X, Batch& Y) const
+    {
+      Workspace work;
+      apply(elements, count, X, Y, work);
+    }
+
+    /** Same as apply(elements, count, X, Y), using the work arrays of \a work */
+    template<typename Batch>
+    void apply(const Index* elements, Index count, const Batch& X, Batch& Y, Workspace&) const
+    {
+      const Index k = size();
+      if(m_scales.size()>0)
+      {
+        Y.topRows(count).noalias() = X.topRows(count) * m_matrices.transpose();
+        for(Index b=0; b<count; ++b)
+          Y.row(b) *= m_scales(elements[b]);
+      }
+      else
+      {
+        for(Index b=0; b<count; ++b)
+          Y.row(b).noalias() = X.row(b) * m_matrices.middleCols(elements[b]*k, k).transpose();
+      }
+    }
+
+    /** Sets \a diag to the diagonal of the matrix of the element \a e */
+    template<typename Vector>
+    void diagonal(Index e, Vector& diag) const
+    {
+      if(m_scales.size()>0)
+        diag = m_scales(e) * m_matrices.diagonal();
+      else
+        diag = m_matrices.middleCols(e*size(), size()).diagonal();
+    }
+
+  protected:
+    MatrixType m_matrices;
+    VectorType m_scales;
+};
+
+/** \ingroup SparseExtra_Module
+  * \class ElementOperator
+  *
+  * \brief A matrix-free operator summing the contributions of finite elements
+  *
+  * \tparam _Kernel the type of the element kernel, e.g., ElementMatrixKernel
+  *
+  * This operator represents the matrix assembled from elements, A = sum_e P_e^T A_e P_e, without assembling it.
+  * P_e gathers the degrees of freedom of the e-th element, given by a connectivity table, and the kernel applies
+  * the element matrices A_e, which may be stored or recomputed on the fly. For high order elements, this saves
+  * the memory traffic of the assembled matrix, which is much larger than the one of the element data.
+  *
+  * A product gathers the inputs of a batch of elements, applies the kernel to the whole batch, and adds the
+  * results to the output. The elements are colored such that the elements of a color do not share any degree of
+  * freedom: the batches of a color are scattered in parallel without synchronization when OpenMP is enabled, and
+  * the colors are processed one after the other.
+  *
+  * The operator can be used in place of a SparseMatrix by ConjugateGradient and BiCGSTAB. Since an element
+  * operator has no triangular part, selfadjointView() is the operator itself, which must then be selfadjoint.
+  * The DiagonalPreconditioner uses the diagonal() of the operator:
+  * \code
+  * ElementMatrixKernel<double> kernel(elementMatrices);
+  * ElementOperator<ElementMatrixKernel<double> > A(n, connectivity, kernel);
+  * ConjugateGradient<ElementOperator<ElementMatrixKernel<double> >, Lower|Upper> cg(A);
+  * x = cg.solve(b);
+  * \endcode
+  *
+  * \warning The operator stores a reference to the kernel, which must thus outlive it.
+  *
+  * \sa ElementMatrixKernel, ConjugateGradient, BiCGSTAB
+  */
+template<typename _Kernel>
+class ElementOperator : public EigenBase<ElementOperator<_Kernel> >
+{
+  public:
+    typedef _Kernel Kernel;
+    typedef typename Kernel::Scalar Scalar;
+    typedef typename Kernel::Index Index;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+    typedef Matrix<Scalar,Dynamic,Dynamic> BatchType;
+
+    // required to be the left hand side of a ProductBase
+    typedef const ElementOperator& Nested;
+    typedef Matrix<Scalar,Dynamic,Dynamic> PlainObject;
+    enum {
+      ColsAtCompileTime = Dynamic,
+      MaxColsAtCompileTime = Dynamic,
+      IsVectorAtCompileTime = 0,
+      Flags = internal::traits<ElementOperator>::Flags
+    };
+
+    ElementOperator() : mp_kernel(0), m_size(0), m_batchSize(32) {}
+
+    /** Builds the operator of the elements described by \a connectivity and \a kernel, see compute() */
+    template<typename Derived>
+    ElementOperator(Index size, const MatrixBase<Derived>& connectivity, const Kernel& kernel)
+      : m_batchSize(32)
+    {
+      compute(size, connectivity, kernel);
+    }
+
+    /** Sets up the operator of \a connectivity.cols() elements acting on \a size degrees of freedom, and colors
+      * the elements. The e-th element has kernel.size() degrees of freedom, whose indices are given by the e-th
+      * column of \a connectivity, and its matrix is applied by \a kernel. */
+    template<typename Derived>
+    ElementOperator& compute(Index size, const MatrixBase<Derived>& connectivity, const Kernel& kernel)
+    {
+      eigen_assert(connectivity.rows()==kernel.size() && "ElementOperator: the connectivity does not match the kernel");
+      eigen_assert((connectivity.size()==0 || (connectivity.minCoeff()>=0 && connectivity.maxCoeff()<size))
+                   && "ElementOperator: invalid degree of freedom");
+      mp_kernel = &kernel;
+      m_size = size;
+      const Index k = connectivity.rows();
+      const Index ne = connectivity.cols();
+
+      // elements of each degree of freedom, in compressed form
+      IndexVector start = IndexVector::Zero(size+1), adjacency(k*ne);
+      for(Index e=0; e<ne; ++e)
+        for(Index a=0; a<k; ++a)
+          ++start(connectivity(a,e)+1);
+      for(Index i=0; i<size; ++i)
+        start(i+1) += start(i);
+      IndexVector pos = start.head(size);
+      for(Index e=0; e<ne; ++e)
+        for(Index a=0; a<k; ++a)
+          adjacency(pos(connectivity(a,e))++) = e;
+
+      // greedy coloring: each element gets the smallest color of none of the elements sharing a degree of freedom
+      m_elementColors.setConstant(ne, -1);
+      std::vector<Index> mark;
+      for(Index e=0; e<ne; ++e)
+      {
+        for(Index a=0; a<k; ++a)
+        {
+          const Index i = connectivity(a,e);
+          for(Index p=start(i); p<start(i+1); ++p)
+            if(m_elementColors(adjacency(p))>=0)
+              mark[m_elementColors(adjacency(p))] = e;
+        }
+        Index c = 0;
+        while(c<Index(mark.size()) && mark[c]==e)
+          ++c;
+        if(c==Index(mark.size()))
+          mark.push_back(-1);
+        m_elementColors(e) = c;
+      }
+
+      // sort the elements by color, such that the batches of a color are contiguous
+      const Index colors = mark.size();
+      m_colorStart = IndexVector::Zero(colors+1);
+      for(Index e=0; e<ne; ++e)
+        ++m_colorStart(m_elementColors(e)+1);
+      for(Index c=0; c<colors; ++c)
+        m_colorStart(c+1) += m_colorStart(c);
+      pos = m_colorStart.head(colors);
+      m_elements.resize(ne);
+      m_connectivity.resize(k, ne);
+      for(Index e=0; e<ne; ++e)
+      {
+        const Index q = pos(m_elementColors(e))++;
+        m_elements(q) = e;
+        m_connectivity.col(q) = connectivity.col(e).template cast<Index>();
+      }
+      return *this;
+    }
+
+    inline Index rows() const { return m_size; }
+    inline Index cols() const { return m_size; }
+
+    /** \returns the number of elements */
+    inline Index elements() const { return m_elements.size(); }
+
+    /** \returns the number of colors of the elements */
+    inline Index colors() const { return m_colorStart.size()>0 ? Index(m_colorStart.size()-1) : Index(0); }
+
+    /** \returns the color of each element: two elements sharing a degree of freedom have different colors */
+    const IndexVector& elementColors() const { return m_elementColors; }
+
+    /** \returns a const reference to the kernel */
+    const Kernel& kernel() const { return *mp_kernel; }
+
+    /** \returns the number of elements applied at once by the kernel (default is 32) */
+    Index batchSize() const { return m_batchSize; }
+
+    /** Sets the number of elements applied at once by the kernel */
+    void setBatchSize(Index batchSize)
+    {
+      eigen_assert(batchSize>0);
+      m_batchSize = batchSize;
+    }
+
+    /** \returns the diagonal of the operator, summed from the diagonals of the element matrices */
+    VectorType diagonal() const
+    {
+      const Index k = m_connectivity.rows();
+      const Index threads = internal::sparse_product_threads<Index>(elements(), elements()*k);
+      EIGEN_UNUSED_VARIABLE(threads);
+      VectorType diag = VectorType::Zero(m_size);
+#ifdef EIGEN_HAS_OPENMP
+      #pragma omp parallel num_threads(threads) if(threads>1)
+#endif
+      {
+        VectorType local(k);
+        for(Index c=0; c<colors(); ++c)
+        {
+#ifdef EIGEN_HAS_OPENMP
+          #pragma omp for schedule(static)
+#endif
+          for(Index q=m_colorStart(c); q<m_colorStart(c+1); ++q)
+          {
+            mp_kernel->diagonal(m_elements(q), local);
+            for(Index a=0; a<k; ++a)
+              diag(m_connectivity(a,q)) += local(a);
+          }
+        }
+      }
+      return diag;
+    }
+
+    /** Since the operator has no triangular part, this returns the operator itself, which is assumed selfadjoint.
+      * This allows to use it with ConjugateGradient. */
+    template<unsigned int UpLo> inline const ElementOperator& selfadjointView() const
+    {
+      return *this;
+    }
+
+    template<typename OtherDerived>
+    ElementOperatorProduct<ElementOperator,OtherDerived> operator*(const MatrixBase<OtherDerived>& rhs) const
+    {
+      return ElementOperatorProduct<ElementOperator,OtherDerived>(*this, rhs.derived());
+    }
+
+    /** \internal dest += alpha * (*this) * rhs */
+    template<typename Rhs, typename Dest>
+    void _addProduct(const Rhs& rhs, Dest& dest, Scalar alpha) const
+    {
+      eigen_assert(mp_kernel && "ElementOperator is not initialized.");
+      const Index k = m_connectivity.rows();
+      const Index threads = internal::sparse_product_threads<Index>(elements(), elements()*k*k);
+      EIGEN_UNUSED_VARIABLE(threads);
+      for(Index j=0; j<rhs.cols(); ++j)
+      {
+#ifdef EIGEN_HAS_OPENMP
+        #pragma omp parallel num_threads(threads) if(threads>1)
+#endif
+        {
+          BatchType X(m_batchSize, k), Y(m_batchSize, k);
+          typename Kernel::Workspace work;
+          for(Index c=0; c<colors(); ++c)
+          {
+            const Index begin = m_colorStart(c), end = m_colorStart(c+1);
+            const Index batches = (end-begin+m_batchSize-1)/m_batchSize;
+#ifdef EIGEN_HAS_OPENMP
+            #pragma omp for schedule(static)
+#endif
+            for(Index batch=0; batch<batches; ++batch)
+            {
+              const Index first = begin + batch*m_batchSize;
+              const Index count = (std::min)(m_batchSize, end-first);
+              // gather
+              for(Index b=0; b<count; ++b)
+                for(Index a=0; a<k; ++a)
+                  X(b,a) = rhs.coeff(m_connectivity(a,first+b), j);
+              mp_kernel->apply(m_elements.data()+first, count, X, Y, work);
+              // scatter: the elements of a color do not share any degree of freedom
+              for(Index b=0; b<count; ++b)
+                for(Index a=0; a<k; ++a)
+                  dest.coeffRef(m_connectivity(a,first+b), j) += alpha * Y(b,a);
+            }
+          }
+        }
+      }
+    }
+
+  protected:
+    const Kernel* mp_kernel;
+    Index m_size;
+    Index m_batchSize;
+    Matrix<Index,Dynamic,Dynamic> m_connectivity;   // connectivity of the elements sorted by color
+    IndexVector m_elements;                        // indices of the elements sorted by color
+    IndexVector m_colorStart;                      // the c-th color is [m_colorStart(c), m_colorStart(c+1))
+    IndexVector m_elementColors;
+};
+
+template<typename Lhs, typename Rhs>
+class ElementOperatorProduct
+  : public ProductBase<ElementOperatorProduct<Lhs,Rhs>, Lhs, Rhs>
+{
+  public:
+    EIGEN_PRODUCT_PUBLIC_INTERFACE(ElementOperatorProduct)
+
+    ElementOperatorProduct(const Lhs& lhs, const Rhs& rhs) : Base(lhs,rhs)
+    {}
+
+    template<typename Dest> void scaleAndAddTo(Dest& dest, Scalar alpha) const
+    {
+      m_lhs._addProduct(m_rhs, dest, alpha);
+    }
+
+  private:
+    ElementOperatorProduct& operator=(const ElementOperatorProduct&);
+};
+
+namespace internal {
+
+template<typename Kernel>
+struct diagonal_preconditioner_inverse<ElementOperator<Kernel> >
+{
+  template<typename Vector>
+  static void run(const ElementOperator<Kernel>& op, Vector& invdiag)
+  {
+    invdiag = op.diagonal();
+    for(typename Vector::Index i=0; i<invdiag.size(); ++i)
+      invdiag(i) = invdiag(i)!=typename Vector::Scalar(0) ? typename Vector::Scalar(1)/invdiag(i) : typename Vector::Scalar(0);
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_ELEMENTOPERATOR_H
@@ -0,0 +1,584 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_MAPPED_MATRIX_FILE_H
+#define EIGEN_MAPPED_MATRIX_FILE_H
+
+namespace Eigen {
+
+/** \ingroup SparseExtra_Module
+  * Options of the memory mappings of MappedDenseFile and MappedSparseFile, which can be combined.
+  */
+enum MappedFileOptions {
+  /** The mapping is private: the matrix can be modified, but the changes are not written to the file (default) */
+  MapPrivate = 0,
+  /** The mapping is shared: the changes of the matrix are written to the file, see flush() */
+  MapShared = 0x1,
+  /** Advises the kernel to back the mapping with transparent huge pages, reducing the TLB misses */
+  MapHugePages = 0x2,
+  /** Reads the whole file ahead, such that the first accesses do not fault page per page */
+  MapPrefetch = 0x4,
+  /** Advises the kernel that the matrix will be read sequentially */
+  MapSequential = 0x8
+};
+
+namespace internal {
+
+// A whole file mapped in memory. On systems without mmap, the file is read in a buffer, and the shared mappings
+// and the creation of files are not supported.
+class mapped_file : noncopyable
+{
+  public:
+    mapped_file() : m_data(0), m_size(0), m_isOpen(false), m_isMapped(false) {}
+    ~mapped_file() { close(); }
+
+    bool open(const std::string& filename, int options = MapPrivate)
+    {
+      close();
+#if !defined(_WIN32)
+      int fd = ::open(filename.c_str(), (options&MapShared) ? O_RDWR : O_RDONLY);
+      if(fd<0)
+        return false;
+      struct stat st;
+      if(::fstat(fd, &st)!=0)
+      {
+        ::close(fd);
+        return false;
+      }
+      bool ok = map(fd, std::size_t(st.st_size), options);
+      ::close(fd);
+      return ok;
+#else
+      if(options&MapShared)
+        return false;
+      std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+      if(!in)
+        return false;
+      in.seekg(0, std::ios::end);
+      m_size = std::size_t(in.tellg());
+      in.seekg(0, std::ios::beg);
+      m_buffer.resize(m_size);
+      if(m_size>0 && !in.read(&m_buffer[0], m_size))
+      {
+        close();
+        return false;
+      }
+      m_data = m_size>0 ? &m_buffer[0] : 0;
+      m_isOpen = true;
+      return true;
+#endif
+    }
+
+    // Creates or truncates the file to size zero bytes, and maps it shared.
+    bool create(const std::string& filename, std::size_t size, int options = MapShared)
+    {
+      close();
+#if !defined(_WIN32)
+      int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+      if(fd<0)
+        return false;
+      bool ok = ::ftruncate(fd, off_t(size))==0 && map(fd, size, options | MapShared);
+      ::close(fd);
+      return ok;
+#else
+      EIGEN_UNUSED_VARIABLE(filename);
+      EIGEN_UNUSED_VARIABLE(size);
+      EIGEN_UNUSED_VARIABLE(options);
+      return false;
+#endif
+    }
+
+    // Writes the changes of a shared mapping to the file.
+    bool flush()
+    {
+#if !defined(_WIN32)
+      return !m_isMapped || ::msync(m_data, m_size, MS_SYNC)==0;
+#else
+      return true;
+#endif
+    }
+
+    void close()
+    {
+#if !defined(_WIN32)
+      if(m_isMapped)
+        ::munmap(m_data, m_size);
+#endif
+      std::vector<char>().swap(m_buffer);
+      m_data = 0;
+      m_size = 0;
+      m_isOpen = false;
+      m_isMapped = false;
+    }
+
+    bool isOpen() const { return m_isOpen; }
+    char* data() { return m_data; }
+    const char* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+  protected:
+#if !defined(_WIN32)
+    bool map(int fd, std::size_t size, int options)
+    {
+      m_size = size;
+      if(size>0)
+      {
+        int mapFlags = (options&MapShared) ? MAP_SHARED : MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        if(options&MapPrefetch)
+          mapFlags |= MAP_POPULATE;
+#endif
+        void* data = ::mmap(0, size, PROT_READ|PROT_WRITE, mapFlags, fd, 0);
+        if(data==MAP_FAILED)
+        {
+          m_size = 0;
+          return false;
+        }
+        m_data = static_cast<char*>(data);
+        m_isMapped = true;
+#ifdef MADV_HUGEPAGE
+        if(options&MapHugePages)
+          ::madvise(m_data, m_size, MADV_HUGEPAGE);
+#endif
+        if(options&MapPrefetch)
+          ::madvise(m_data, m_size, MADV_WILLNEED);
+        if(options&MapSequential)
+          ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+      }
+      m_isOpen = true;
+      return true;
+    }
+#endif
+
+    char* m_data;
+    std::size_t m_size;
+    bool m_isOpen;
+    bool m_isMapped;
+    std::vector<char> m_buffer;
+};
+
+// Header of the matrix files. The arrays follow, each of them starting at an offset which is a multiple of the
+// alignment: the coefficients of a dense matrix in its storage order, or the outer indices, the inner indices and
+// the values of the compressed storage of a sparse matrix.
+struct mapped_matrix_header
+{
+  char magic[8];
+  int version;
+  int kind;
+  int scalarSize;
+  int indexSize;
+  int flags;
+  int alignment;
+  long long rows;
+  long long cols;
+  long long nonZeros;
+  long long offsets[3];
+};
+
+enum {
+  MappedMatrixVersion = 1,
+  MappedMatrixAlignment = 64,
+  MappedMatrixDense = 0,
+  MappedMatrixSparse = 1,
+  MappedMatrixRowMajor = 0x1,
+  MappedMatrixComplex = 0x2,
+  MappedMatrixInteger = 0x4
+};
+
+template<typename Scalar>
+inline int mapped_matrix_scalar_flags()
+{
+  return (NumTraits<Scalar>::IsComplex ? int(MappedMatrixComplex) : 0)
+       | (NumTraits<Scalar>::IsInteger ? int(MappedMatrixInteger) : 0);
+}
+
+inline long long mapped_matrix_align(long long offset)
+{
+  return (offset + MappedMatrixAlignment - 1) / MappedMatrixAlignment * MappedMatrixAlignment;
+}
+
+// Initializes the header and the offsets of the arrays, and returns the size of the file.
+template<typename Scalar, typename Index>
+long long mapped_matrix_layout(mapped_matrix_header& header, int kind, bool rowMajor,
+                               long long rows, long long cols, long long nonZeros)
+{
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, "EIGENMAT", 8);
+  header.version = MappedMatrixVersion;
+  header.kind = kind;
+  header.scalarSize = int(sizeof(Scalar));
+  header.indexSize = kind==MappedMatrixSparse ? int(sizeof(Index)) : 0;
+  header.flags = (rowMajor ? int(MappedMatrixRowMajor) : 0) | mapped_matrix_scalar_flags<Scalar>();
+  header.alignment = MappedMatrixAlignment;
+  header.rows = rows;
+  header.cols = cols;
+  if(kind==MappedMatrixDense)
+  {
+    header.nonZeros = rows*cols;
+    header.offsets[0] = mapped_matrix_align(sizeof(header));
+    return header.offsets[0] + header.nonZeros*(long long)sizeof(Scalar);
+  }
+  header.nonZeros = nonZeros;
+  header.offsets[0] = mapped_matrix_align(sizeof(header));
+  header.offsets[1] = mapped_matrix_align(header.offsets[0] + ((rowMajor ? rows : cols)+1)*(long long)sizeof(Index));
+  header.offsets[2] = mapped_matrix_align(header.offsets[1] + nonZeros*(long long)sizeof(Index));
+  return header.offsets[2] + nonZeros*(long long)sizeof(Scalar);
+}
+
+// Checks that the mapped file holds a matrix of the given kind and types, and returns its header.
+// The storage order of vectors does not matter.
+template<typename Scalar, typename Index>
+bool mapped_matrix_check(const mapped_file& file, int kind, bool rowMajor, mapped_matrix_header& header)
+{
+  if(file.size()<sizeof(header))
+    return false;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if(std::memcmp(header.magic, "EIGENMAT", 8)!=0 || header.version!=MappedMatrixVersion || header.kind!=kind
+     || header.scalarSize!=int(sizeof(Scalar))
+     || (kind==MappedMatrixSparse && header.indexSize!=int(sizeof(Index)))
+     || (header.flags&~int(MappedMatrixRowMajor))!=mapped_matrix_scalar_flags<Scalar>()
+     || header.rows<0 || header.cols<0 || header.nonZeros<0
+     || header.alignment<16 || header.alignment%16!=0)
+    return false;
+  const bool fileRowMajor = (header.flags&MappedMatrixRowMajor)!=0;
+  if(fileRowMajor!=rowMajor && (kind==MappedMatrixSparse || (header.rows!=1 && header.cols!=1)))
+    return false;
+  const long long size = (long long)file.size();
+  if(kind==MappedMatrixDense)
+    return header.nonZeros==header.rows*header.cols
+        && header.offsets[0]%header.alignment==0
+        && header.offsets[0] + header.nonZeros*(long long)sizeof(Scalar) <= size;
+  const long long outerSize = rowMajor ? header.rows : header.cols;
+  return header.offsets[0]%header.alignment==0 && header.offsets[1]%header.alignment==0
+      && header.offsets[2]%header.alignment==0
+      && header.offsets[0] + (outerSize+1)*(long long)sizeof(Index) <= size
+      && header.offsets[1] + header.nonZeros*(long long)sizeof(Index) <= size
+      && header.offsets[2] + header.nonZeros*(long long)sizeof(Scalar) <= size;
+}
+
+inline void mapped_matrix_pad(std::ofstream& out, long long& pos, long long offset)
+{
+  static const char zeros[MappedMatrixAlignment] = { 0 };
+  out.write(zeros, std::streamsize(offset-pos));
+  pos = offset;
+}
+
+} // end namespace internal
+
+/** \ingroup SparseExtra_Module
+  * \class MappedDenseFile
+  *
+  * \brief A dense matrix stored in a memory mapped file
+  *
+  * \tparam MatrixType the type of the dense matrix, e.g., MatrixXd
+  *
+  * The file starts with a versioned header holding the sizes, the scalar type and the storage order of the matrix,
+  * followed by its coefficients, aligned on 64 bytes. It is written by saveMappedMatrix() or create(), and open()
+  * maps it in memory and exposes its coefficients as an aligned Map, without any copy nor parsing: opening a large
+  * matrix is immediate, and its pages are only read when they are accessed.
+  * \code
+  * // producer
+  * MappedDenseFile<MatrixXd> out;
+  * out.create("X.mat", n, k);
+  * out.matrix() = computeX();
+  * out.close();
+  * // consumer
+  * MappedDenseFile<MatrixXd> in("X.mat", MapHugePages | MapPrefetch);
+  * VectorXd y = in.matrix() * b;
+  * \endcode
+  *
+  * The options are a combination of MappedFileOptions: by default the mapping is private, such that the matrix
+  * can be modified without altering the file. The scalar type and the storage order of the file must be the ones
+  * of \a MatrixType, otherwise open() fails. The matrix is valid until the file is closed or destroyed.
+  *
+  * \sa MappedSparseFile, saveMappedMatrix()
+  */
+template<typename MatrixType>
+class MappedDenseFile : internal::noncopyable
+{
+  public:
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
+    typedef Map<MatrixType,Aligned> MapType;
+
+    MappedDenseFile() : m_map(0) {}
+
+    explicit MappedDenseFile(const std::string& filename, int options = MapPrivate) : m_map(0)
+    {
+      open(filename, options);
+    }
+
+    ~MappedDenseFile() { close(); }
+
+    /** Maps the file \a filename with the MappedFileOptions \a options.
+      * \returns false if it cannot be read or does not hold a matrix of type \a MatrixType */
+    bool open(const std::string& filename, int options = MapPrivate)
+    {
+      close();
+      internal::mapped_matrix_header header;
+      if(!m_file.open(filename, options)
+         || !internal::mapped_matrix_check<Scalar,Index>(m_file, internal::MappedMatrixDense, IsRowMajor, header)
+         || !validSizes(header.rows, header.cols))
+      {
+        m_file.close();
+        return false;
+      }
+      m_map = new MapType(reinterpret_cast<Scalar*>(m_file.data() + header.offsets[0]), Index(header.rows), Index(header.cols));
+      return true;
+    }
+
+    /** Creates the file \a filename holding a \a rows x \a cols matrix, and maps it shared, such that the
+      * coefficients written in matrix() are stored in the file. The matrix is initialized with zeros. */
+    bool create(const std::string& filename, Index rows, Index cols, int options = MapShared)
+    {
+      close();
+      if(!validSizes(rows, cols))
+        return false;
+      internal::mapped_matrix_header header;
+      long long size = internal::mapped_matrix_layout<Scalar,Index>(header, internal::MappedMatrixDense, IsRowMajor, rows, cols, 0);
+      if(!m_file.create(filename, std::size_t(size), options))
+        return false;
+      std::memcpy(m_file.data(), &header, sizeof(header));
+      m_map = new MapType(reinterpret_cast<Scalar*>(m_file.data() + header.offsets[0]), rows, cols);
+      return true;
+    }
+
+    /** Writes the changes of a shared mapping to the file */
+    bool flush() { return m_file.flush(); }
+
+    /** Unmaps the file, the matrix is no longer valid */
+    void close()
+    {
+      delete m_map;
+      m_map = 0;
+      m_file.close();
+    }
+
+    bool isOpen() const { return m_map!=0; }
+
+    /** \returns the mapped matrix */
+    MapType& matrix()
+    {
+      eigen_assert(isOpen() && "MappedDenseFile is not open.");
+      return *m_map;
+    }
+
+    /** \returns the mapped matrix */
+    const MapType& matrix() const
+    {
+      eigen_assert(isOpen() && "MappedDenseFile is not open.");
+      return *m_map;
+    }
+
+  protected:
+    enum { IsRowMajor = (int(MatrixType::Flags)&RowMajorBit) ? 1 : 0 };
+
+    static bool validSizes(long long rows, long long cols)
+    {
+      return (MatrixType::RowsAtCompileTime==Dynamic || rows==MatrixType::RowsAtCompileTime)
+          && (MatrixType::ColsAtCompileTime==Dynamic || cols==MatrixType::ColsAtCompileTime);
+    }
+
+    internal::mapped_file m_file;
+    MapType* m_map;
+};
+
+/** \ingroup SparseExtra_Module
+  * \class MappedSparseFile
+  *
+  * \brief A compressed sparse matrix stored in a memory mapped file
+  *
+  * The file starts with a versioned header holding the sizes, the scalar and index types and the storage order of
+  * the matrix, followed by the outer indices, the inner indices and the values of its compressed storage, each
+  * array being aligned on 64 bytes. It is written by saveMappedMatrix() or create(), and open() maps it in memory
+  * and exposes its arrays as a MappedSparseMatrix, without any copy nor parsing.
+  * \code
+  * MappedSparseFile<double> A("A.mat", MapPrefetch);
+  * x = solver.compute(A.matrix()).solve(b);
+  * \endcode
+  *
+  * The options are a combination of MappedFileOptions, as for MappedDenseFile. The scalar type, the index type and
+  * the storage order of the file must be the ones of the mapped matrix, otherwise open() fails.
+  *
+  * \sa MappedDenseFile, saveMappedMatrix(), MappedSparseMatrix
+  */
+template<typename _Scalar, int _Options = 0, typename _Index = int>
+class MappedSparseFile : internal::noncopyable
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef _Index Index;
+    typedef MappedSparseMatrix<_Scalar,_Options,_Index> MatrixType;
+
+    MappedSparseFile() : m_matrix(0) {}
+
+    explicit MappedSparseFile(const std::string& filename, int options = MapPrivate) : m_matrix(0)
+    {
+      open(filename, options);
+    }
+
+    ~MappedSparseFile() { close(); }
+
+    /** Maps the file \a filename with the MappedFileOptions \a options.
+      * \returns false if it cannot be read or does not match the matrix type */
+    bool open(const std::string& filename, int options = MapPrivate)
+    {
+      close();
+      internal::mapped_matrix_header header;
+      if(!m_file.open(filename, options)
+         || !internal::mapped_matrix_check<Scalar,Index>(m_file, internal::MappedMatrixSparse, IsRowMajor, header))
+      {
+        m_file.close();
+        return false;
+      }
+      setMatrix(header);
+      return true;
+    }
+
+    /** Creates the file \a filename holding a \a rows x \a cols matrix with \a nnz nonzeros, and maps it shared.
+      * The arrays of the compressed storage are initialized with zeros, and must then be filled through the
+      * outerIndexPtr(), innerIndexPtr() and valuePtr() of matrix(). */
+    bool create(const std::string& filename, Index rows, Index cols, Index nnz, int options = MapShared)
+    {
+      close();
+      internal::mapped_matrix_header header;
+      long long size = internal::mapped_matrix_layout<Scalar,Index>(header, internal::MappedMatrixSparse, IsRowMajor, rows, cols, nnz);
+      if(!m_file.create(filename, std::size_t(size), options))
+        return false;
+      std::memcpy(m_file.data(), &header, sizeof(header));
+      setMatrix(header);
+      return true;
+    }
+
+    /** Writes the changes of a shared mapping to the file */
+    bool flush() { return m_file.flush(); }
+
+    /** Unmaps the file, the matrix is no longer valid */
+    void close()
+    {
+      delete m_matrix;
+      m_matrix = 0;
+      m_file.close();
+    }
+
+    bool isOpen() const { return m_matrix!=0; }
+
+    /** \returns the mapped matrix */
+    MatrixType& matrix()
+    {
+      eigen_assert(isOpen() && "MappedSparseFile is not open.");
+      return *m_matrix;
+    }
+
+    /** \returns the mapped matrix */
+    const MatrixType& matrix() const
+    {
+      eigen_assert(isOpen() && "MappedSparseFile is not open.");
+      return *m_matrix;
+    }
+
+  protected:
+    enum { IsRowMajor = (_Options&RowMajorBit) ? 1 : 0 };
+
+    void setMatrix(const internal::mapped_matrix_header& header)
+    {
+      char* data = m_file.data();
+      m_matrix = new MatrixType(Index(header.rows), Index(header.cols), Index(header.nonZeros),
+                                reinterpret_cast<Index*>(data + header.offsets[0]),
+                                reinterpret_cast<Index*>(data + header.offsets[1]),
+                                reinterpret_cast<Scalar*>(data + header.offsets[2]));
+    }
+
+    internal::mapped_file m_file;
+    MatrixType* m_matrix;
+};
+
+/** Saves the dense matrix \a mat in the file \a filename, in the format of MappedDenseFile.
+  * The coefficients are written in the storage order of \a mat.
+  *
+  * \sa MappedDenseFile
+  */
+template<typename Derived>
+bool saveMappedMatrix(const MatrixBase<Derived>& mat, const std::string& filename)
+{
+  typedef typename Derived::PlainObject PlainObject;
+  typedef typename PlainObject::Scalar Scalar;
+  typedef typename PlainObject::Index Index;
+  std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+  if(!out)
+    return false;
+  // evaluates expressions, and is a simple reference for plain matrices
+  const PlainObject& plain = mat.derived();
+  internal::mapped_matrix_header header;
+  internal::mapped_matrix_layout<Scalar,Index>(header, internal::MappedMatrixDense,
+                                               (int(PlainObject::Flags)&RowMajorBit)!=0, plain.rows(), plain.cols(), 0);
+  long long pos = sizeof(header);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  internal::mapped_matrix_pad(out, pos, header.offsets[0]);
+  out.write(reinterpret_cast<const char*>(plain.data()), std::streamsize(plain.size()*sizeof(Scalar)));
+  out.close();
+  return bool(out);
+}
+
+/** Saves the sparse matrix \a mat in the file \a filename, in the format of MappedSparseFile.
+  * The nonzeros are counted and written by means of the inner iterators, such that any sparse
+  * expression can be saved.
+  *
+  * \sa MappedSparseFile
+  */
+template<typename Derived>
+bool saveMappedMatrix(const SparseMatrixBase<Derived>& mat, const std::string& filename)
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename Derived::Index Index;
+  std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+  if(!out)
+    return false;
+
+  const Derived& m = mat.derived();
+  const Index outerSize = m.outerSize();
+  // the nonzeros are counted with the iterators, since nonZeros() is not available for all expressions
+  std::vector<Index> outerIndex(outerSize+1);
+  outerIndex[0] = 0;
+  for(Index j=0; j<outerSize; ++j)
+  {
+    Index count = 0;
+    for(typename Derived::InnerIterator it(m,j); it; ++it)
+      ++count;
+    outerIndex[j+1] = outerIndex[j] + count;
+  }
+  const Index count = outerIndex[outerSize];
+  internal::mapped_matrix_header header;
+  internal::mapped_matrix_layout<Scalar,Index>(header, internal::MappedMatrixSparse, Derived::IsRowMajor,
+                                               m.rows(), m.cols(), count);
+  long long pos = sizeof(header);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  internal::mapped_matrix_pad(out, pos, header.offsets[0]);
+  out.write(reinterpret_cast<const char*>(&outerIndex[0]), std::streamsize((outerSize+1)*sizeof(Index)));
+  pos += (outerSize+1)*sizeof(Index);
+  internal::mapped_matrix_pad(out, pos, header.offsets[1]);
+  for(Index j=0; j<outerSize; ++j)
+    for(typename Derived::InnerIterator it(m,j); it; ++it)
+    {
+      Index inner = it.index();
+      out.write(reinterpret_cast<const char*>(&inner), sizeof(Index));
+    }
+  pos += count*sizeof(Index);
+  internal::mapped_matrix_pad(out, pos, header.offsets[2]);
+  for(Index j=0; j<outerSize; ++j)
+    for(typename Derived::InnerIterator it(m,j); it; ++it)
+    {
+      Scalar value = it.value();
+      out.write(reinterpret_cast<const char*>(&value), sizeof(Scalar));
+    }
+  out.close();
+  return bool(out);
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_MAPPED_MATRIX_FILE_H
@@ -17,35 +17,6 @@ namespace Eigen {
 
 namespace internal 
 {
-  template <typename Scalar>
-  inline bool GetMarketLine (std::stringstream& line, int& M, int& N, int& i, int& j, Scalar& value)
-  {
-    line >> i >> j >> value;
-    i--;
-    j--;
-    if(i>=0 && j>=0 && i<M && j<N)
-    {
-      return true; 
-    }
-    else
-      return false;
-  }
-  template <typename Scalar>
-  inline bool GetMarketLine (std::stringstream& line, int& M, int& N, int& i, int& j, std::complex<Scalar>& value)
-  {
-    Scalar valR, valI;
-    line >> i >> j >> valR >> valI;
-    i--;
-    j--;
-    if(i>=0 && j>=0 && i<M && j<N)
-    {
-      value = std::complex<Scalar>(valR, valI);
-      return true; 
-    }
-    else
-      return false;
-  }
-
   template <typename RealScalar>
   inline void  GetVectorElt (const std::string& line, RealScalar& val)
   {
@@ -82,26 +53,392 @@ namespace internal
   }
 
   template<typename Scalar>
-  inline void PutMatrixElt(Scalar value, int row, int col, std::ofstream& out)
+  inline void putVectorElt(Scalar value, std::ofstream& out)
   {
-    out << row << " "<< col << " " << value << "\n";
+    out << value << "\n"; 
   }
   template<typename Scalar>
-  inline void PutMatrixElt(std::complex<Scalar> value, int row, int col, std::ofstream& out)
+  inline void putVectorElt(std::complex<Scalar> value, std::ofstream& out)
   {
-    out << row << " " << col << " " << value.real() << " " << value.imag() << "\n";
+    out << value.real() << " " << value.imag()<< "\n"; 
   }
 
+  inline const char* market_skip_blanks(const char* p, const char* end)
+  {
+    while(p<end && (*p==' ' || *p=='\t' || *p=='\r'))
+      ++p;
+    return p;
+  }
+
+  // Parses a decimal integer, and returns a pointer past it, or 0 on failure.
+  template<typename Index>
+  inline const char* market_parse_index(const char* p, const char* end, Index& value)
+  {
+    p = market_skip_blanks(p, end);
+    bool negative = false;
+    if(p<end && (*p=='-' || *p=='+'))
+      negative = *(p++)=='-';
+    if(p>=end || *p<'0' || *p>'9')
+      return 0;
+    Index v = 0;
+    for(; p<end && *p>='0' && *p<='9'; ++p)
+      v = v*10 + Index(*p-'0');
+    value = negative ? -v : v;
+    return p;
+  }
+
+  // Parses a real number, and returns a pointer past it, or 0 on failure.
+  // The range [p,end) must be followed by a character which cannot continue a number, e.g., '\n' or '\0'.
+  template<typename RealScalar>
+  inline const char* market_parse_real(const char* p, const char* end, RealScalar& value)
+  {
+    p = market_skip_blanks(p, end);
+    if(p>=end)
+      return 0;
+    char* last;
+    double v = std::strtod(p, &last);
+    if(last==p)
+      return 0;
+    value = RealScalar(v);
+    return last;
+  }
 
   template<typename Scalar>
-  inline void putVectorElt(Scalar value, std::ofstream& out)
+  inline const char* market_parse_value(const char* p, const char* end, Scalar& value)
   {
-    out << value << "\n"; 
+    return market_parse_real(p, end, value);
+  }
+
+  template<typename RealScalar>
+  inline const char* market_parse_value(const char* p, const char* end, std::complex<RealScalar>& value)
+  {
+    RealScalar valR, valI;
+    if(!(p = market_parse_real(p, end, valR)) || !(p = market_parse_real(p, end, valI)))
+      return 0;
+    value = std::complex<RealScalar>(valR, valI);
+    return p;
   }
+
+  // Parses the banner, the comments and the size line of a matrix market file.
+  // Returns a pointer to the first line of entries, or 0 on failure.
+  template<typename Index>
+  const char* market_parse_header(const char* p, const char* end, bool& pattern, Index& rows, Index& cols, Index& nnz)
+  {
+    static const char banner[] = "%%MatrixMarket";
+    static const char patternField[] = "pattern";
+    pattern = false;
+    while(p<end)
+    {
+      const char* eol = static_cast<const char*>(std::memchr(p, '\n', end-p));
+      if(!eol)
+        eol = end;
+      if(*p=='%')
+      {
+        if(std::size_t(eol-p)>=sizeof(banner)-1 && std::strncmp(p, banner, sizeof(banner)-1)==0)
+          pattern = std::search(p, eol, patternField, patternField+sizeof(patternField)-1)!=eol;
+      }
+      else
+      {
+        // copy the line such that the parsing stops at its end
+        std::string line(p, eol);
+        const char* q = line.c_str();
+        const char* qend = q + line.size();
+        if(market_skip_blanks(q, qend)!=qend)
+        {
+          if((q = market_parse_index(q, qend, rows)) && (q = market_parse_index(q, qend, cols))
+             && (q = market_parse_index(q, qend, nnz)))
+            return eol<end ? eol+1 : end;
+          return 0;
+        }
+      }
+      p = eol+1;
+    }
+    return 0;
+  }
+
+  // The entries parsed by one thread, as outer and inner indices of the destination matrix.
+  template<typename Scalar, typename Index>
+  struct market_chunk
+  {
+    market_chunk() : invalid(0) {}
+    std::vector<Index> outer;
+    std::vector<Index> inner;
+    std::vector<Scalar> values;
+    Index invalid;
+  };
+
+  // Parses the entries of the lines in [begin,end), which is a range of complete lines of a file ending at fileEnd.
+  template<typename Scalar, typename Index>
+  void market_parse_chunk(const char* begin, const char* end, const char* fileEnd, bool pattern, bool rowMajor,
+                          Index rows, Index cols, std::size_t reserveSize, market_chunk<Scalar,Index>& chunk)
+  {
+    chunk.outer.reserve(reserveSize);
+    chunk.inner.reserve(reserveSize);
+    chunk.values.reserve(reserveSize);
+    std::string lastLine;
+    for(const char* p=begin; p<end; )
+    {
+      const char* eol = static_cast<const char*>(std::memchr(p, '\n', end-p));
+      if(!eol)
+        eol = end;
+      const char* q = p;
+      const char* qend = eol;
+      if(eol==fileEnd)
+      {
+        // the last line is not terminated: copy it such that strtod cannot read past the end of the file
+        lastLine.assign(p, eol);
+        q = lastLine.c_str();
+        qend = q + lastLine.size();
+      }
+      q = market_skip_blanks(q, qend);
+      if(q<qend && *q!='%')
+      {
+        Index i(0), j(0);
+        Scalar value(1);
+        if((q = market_parse_index(q, qend, i)) && (q = market_parse_index(q, qend, j))
+           && (pattern || market_parse_value(q, qend, value))
+           && i>=1 && j>=1 && i<=rows && j<=cols)
+        {
+          chunk.outer.push_back(rowMajor ? i-1 : j-1);
+          chunk.inner.push_back(rowMajor ? j-1 : i-1);
+          chunk.values.push_back(value);
+        }
+        else
+          ++chunk.invalid;
+      }
+      p = eol+1;
+    }
+  }
+
+  template<typename Index>
+  struct market_index_less
+  {
+    market_index_less(const Index* index) : m_index(index) {}
+    bool operator()(Index a, Index b) const { return m_index[a] < m_index[b]; }
+    const Index* m_index;
+  };
+
+  // Orders the entries of a chunk by outer index with a stable sort, such that the entries of an outer vector
+  // form a contiguous range and keep the order of the file.
+  template<typename Scalar, typename Index>
+  void market_sort_chunk(market_chunk<Scalar,Index>& chunk)
+  {
+    const std::size_t n = chunk.outer.size();
+    bool sorted = true;
+    for(std::size_t e=1; e<n && sorted; ++e)
+      sorted = chunk.outer[e-1] <= chunk.outer[e];
+    if(sorted)
+      return;
+    std::vector<Index> perm(n);
+    for(std::size_t e=0; e<n; ++e)
+      perm[e] = Index(e);
+    std::stable_sort(perm.begin(), perm.end(), market_index_less<Index>(&chunk.outer[0]));
+    std::vector<Index> tmpIndex(n);
+    for(std::size_t e=0; e<n; ++e)
+      tmpIndex[e] = chunk.outer[perm[e]];
+    chunk.outer.swap(tmpIndex);
+    for(std::size_t e=0; e<n; ++e)
+      tmpIndex[e] = chunk.inner[perm[e]];
+    chunk.inner.swap(tmpIndex);
+    std::vector<Scalar> tmpValues(n);
+    for(std::size_t e=0; e<n; ++e)
+      tmpValues[e] = chunk.values[perm[e]];
+    chunk.values.swap(tmpValues);
+  }
+
+  // Fills the compressed storage of mat with the entries of the chunks, the duplicates being summed as in
+  // SparseMatrix::setFromTriplets(). The chunks are first sorted by outer index, independently. The outer
+  // vectors are then split into blocks, and each thread counts and scatters the entries of its blocks by
+  // visiting the chunks in order, which only requires a binary search per chunk and block. Finally, the
+  // outer vectors are sorted and compacted independently. The workspace is linear in outerSize and in the
+  // number of entries.
+  template<typename Scalar, typename Index, typename SparseMatrixType>
+  void market_chunks_to_compressed(std::vector<market_chunk<Scalar,Index> >& chunks, SparseMatrixType& mat, Index threads)
+  {
+    const Index nchunks = Index(chunks.size());
+    const Index outerSize = mat.outerSize();
+    const Index blockSize = 4096;
+    const Index nblocks = (outerSize+blockSize-1)/blockSize;
+    EIGEN_UNUSED_VARIABLE(threads);
+
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(dynamic,1) num_threads(threads) if(threads>1)
+#endif
+    for(Index t=0; t<nchunks; ++t)
+      market_sort_chunk(chunks[t]);
+
+    // 1 - start[k+1] is the number of entries of the outer vector k, and then start[k] its first position
+    Matrix<Index,Dynamic,1> start = Matrix<Index,Dynamic,1>::Zero(outerSize+1);
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(dynamic,1) num_threads(threads) if(threads>1)
+#endif
+    for(Index b=0; b<nblocks; ++b)
+    {
+      const Index kbegin = b*blockSize, kend = (std::min)(kbegin+blockSize, outerSize);
+      for(Index t=0; t<nchunks; ++t)
+      {
+        const std::vector<Index>& outer = chunks[t].outer;
+        for(typename std::vector<Index>::const_iterator it = std::lower_bound(outer.begin(), outer.end(), kbegin);
+            it!=outer.end() && *it<kend; ++it)
+          ++start[*it+1];
+      }
+    }
+    for(Index k=0; k<outerSize; ++k)
+      start[k+1] += start[k];
+
+    // 2 - scatter, the entries of each outer vector being ordered by chunk and then by line
+    Matrix<Index,Dynamic,1> inner(start[outerSize]);
+    Matrix<Scalar,Dynamic,1> values(start[outerSize]);
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(dynamic,1) num_threads(threads) if(threads>1)
+#endif
+    for(Index b=0; b<nblocks; ++b)
+    {
+      const Index kbegin = b*blockSize, kend = (std::min)(kbegin+blockSize, outerSize);
+      Matrix<Index,Dynamic,1> pos = start.segment(kbegin, kend-kbegin);
+      for(Index t=0; t<nchunks; ++t)
+      {
+        const market_chunk<Scalar,Index>& chunk = chunks[t];
+        std::size_t e = std::lower_bound(chunk.outer.begin(), chunk.outer.end(), kbegin) - chunk.outer.begin();
+        for(; e<chunk.outer.size() && chunk.outer[e]<kend; ++e)
+        {
+          Index& p = pos[chunk.outer[e]-kbegin];
+          inner[p] = chunk.inner[e];
+          values[p] = chunk.values[e];
+          ++p;
+        }
+      }
+    }
+    for(Index t=0; t<nchunks; ++t)
+    {
+      std::vector<Index>().swap(chunks[t].outer);
+      std::vector<Index>().swap(chunks[t].inner);
+      std::vector<Scalar>().swap(chunks[t].values);
+    }
+
+    // 3 - sort each outer vector with a stable sort, such that the duplicates are summed in the file order
+    Matrix<Index,Dynamic,1> sizes(outerSize);
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel num_threads(threads) if(threads>1)
+#endif
+    {
+      std::vector<Index> perm, tmpInner;
+      std::vector<Scalar> tmpValues;
+#ifdef EIGEN_HAS_OPENMP
+      #pragma omp for schedule(dynamic,256)
+#endif
+      for(Index k=0; k<outerSize; ++k)
+      {
+        Index* kInner = inner.data() + start[k];
+        Scalar* kValues = values.data() + start[k];
+        const Index n = start[k+1]-start[k];
+        bool sorted = true;
+        for(Index p=1; p<n && sorted; ++p)
+          sorted = kInner[p-1] < kInner[p];
+        if(!sorted)
+        {
+          perm.resize(n);
+          for(Index p=0; p<n; ++p)
+            perm[p] = p;
+          std::stable_sort(perm.begin(), perm.end(), market_index_less<Index>(kInner));
+          tmpInner.assign(kInner, kInner+n);
+          tmpValues.assign(kValues, kValues+n);
+          Index last = -1;
+          Index count = 0;
+          for(Index p=0; p<n; ++p)
+          {
+            if(tmpInner[perm[p]]==last)
+              kValues[count-1] += tmpValues[perm[p]];
+            else
+            {
+              last = kInner[count] = tmpInner[perm[p]];
+              kValues[count++] = tmpValues[perm[p]];
+            }
+          }
+          sizes[k] = count;
+        }
+        else
+          sizes[k] = n;
+      }
+    }
+
+    // 4 - compact
+    mat.resize(mat.rows(), mat.cols());
+    Index* outerIndex = mat.outerIndexPtr();
+    outerIndex[0] = 0;
+    for(Index k=0; k<outerSize; ++k)
+      outerIndex[k+1] = outerIndex[k] + sizes[k];
+    if(outerIndex[outerSize]==0)
+      return;
+    mat.resizeNonZeros(outerIndex[outerSize]);
+    Index* matInner = mat.innerIndexPtr();
+    Scalar* matValues = mat.valuePtr();
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(static) num_threads(threads) if(threads>1)
+#endif
+    for(Index k=0; k<outerSize; ++k)
+    {
+      std::copy(inner.data()+start[k], inner.data()+start[k]+sizes[k], matInner+outerIndex[k]);
+      std::copy(values.data()+start[k], values.data()+start[k]+sizes[k], matValues+outerIndex[k]);
+    }
+  }
+
+  template<typename Index>
+  inline char* market_put_index(Index value, char* p)
+  {
+    char digits[32];
+    int n = 0;
+    do {
+      digits[n++] = char('0' + value%10);
+      value /= 10;
+    } while(value>0);
+    while(n>0)
+      *(p++) = digits[--n];
+    return p;
+  }
+
+  // Writes a real number with enough digits to be read back exactly.
+  template<typename RealScalar>
+  inline char* market_put_real(const RealScalar& value, char* p)
+  {
+    return p + std::sprintf(p, " %.*e", int(std::numeric_limits<RealScalar>::digits10)+2, double(value));
+  }
+
+  inline char* market_put_real(const long double& value, char* p)
+  {
+    return p + std::sprintf(p, " %.*Le", int(std::numeric_limits<long double>::digits10)+2, value);
+  }
+
   template<typename Scalar>
-  inline void putVectorElt(std::complex<Scalar> value, std::ofstream& out)
+  inline char* market_put_value(const Scalar& value, char* p)
   {
-    out << value.real << " " << value.imag()<< "\n"; 
+    return market_put_real(value, p);
+  }
+
+  template<typename RealScalar>
+  inline char* market_put_value(const std::complex<RealScalar>& value, char* p)
+  {
+    return market_put_real(value.imag(), market_put_real(value.real(), p));
+  }
+
+  // Formats the entries of the outer vectors [begin,end) of mat.
+  template<typename SparseMatrixType>
+  void market_put_entries(const SparseMatrixType& mat, typename SparseMatrixType::Index begin,
+                          typename SparseMatrixType::Index end, std::string& out)
+  {
+    typedef typename SparseMatrixType::Index Index;
+    char line[192];
+    out.clear();
+    for(Index j=begin; j<end; ++j)
+      for(typename SparseMatrixType::InnerIterator it(mat,j); it; ++it)
+      {
+        char* p = market_put_index(it.row()+1, line);
+        *(p++) = ' ';
+        p = market_put_index(it.col()+1, p);
+        p = market_put_value(it.value(), p);
+        *(p++) = '\n';
+        out.append(line, p);
+      }
   }
 
 } // end namepsace internal
@@ -129,62 +466,71 @@ inline bool getMarketHeader(const std::string& filename, int& sym, bool& iscompl
   return true;
 }
   
+/** Loads the matrix market file \a filename into the SparseMatrix \a mat.
+  *
+  * The file is mapped in memory and split in blocks of lines which are parsed in parallel when OpenMP is enabled,
+  * each thread building its own list of entries. The compressed storage of \a mat is then directly filled from
+  * these lists, the duplicated entries being summed as by SparseMatrix::setFromTriplets(). Only the stored entries
+  * are loaded, regardless of the symmetry declared in the header. Pattern files yield ones.
+  *
+  * \returns false if the file cannot be read or if its size line is invalid
+  *
+  * \sa saveMarket(), MappedMarketBinary
+  */
 template<typename SparseMatrixType>
 bool loadMarket(SparseMatrixType& mat, const std::string& filename)
 {
   typedef typename SparseMatrixType::Scalar Scalar;
-  std::ifstream input(filename.c_str(),std::ios::in);
-  if(!input)
+  typedef typename SparseMatrixType::Index Index;
+  typedef internal::market_chunk<Scalar,Index> Chunk;
+
+  internal::mapped_file file;
+  if(!file.open(filename, MapSequential))
     return false;
-  
-  const int maxBuffersize = 2048;
-  char buffer[maxBuffersize];
-  
-  bool readsizes = false;
+  const char* end = file.data() + file.size();
 
-  typedef Triplet<Scalar,int> T;
-  std::vector<T> elements;
-  
-  int M(-1), N(-1), NNZ(-1);
-  int count = 0;
-  while(input.getline(buffer, maxBuffersize))
+  bool pattern;
+  Index M(-1), N(-1), NNZ(-1);
+  const char* data = internal::market_parse_header(file.data(), end, pattern, M, N, NNZ);
+  if(!data || M<0 || N<0 || NNZ<0)
+    return false;
+
+  // split the entries in blocks of complete lines
+  const Index threads = internal::sparse_product_threads<Index>(NNZ, NNZ);
+  const Index nchunks = threads;
+  std::vector<const char*> bounds(nchunks+1);
+  bounds[0] = data;
+  bounds[nchunks] = end;
+  for(Index t=1; t<nchunks; ++t)
   {
-    // skip comments   
-    //NOTE An appropriate test should be done on the header to get the  symmetry
-    if(buffer[0]=='%')
-      continue;
-    
-    std::stringstream line(buffer);
-    
-    if(!readsizes)
-    {
-      line >> M >> N >> NNZ;
-      if(M > 0 && N > 0 && NNZ > 0) 
-      {
-        readsizes = true;
-        std::cout << "sizes: " << M << "," << N << "," << NNZ << "\n";
-        mat.resize(M,N);
-        mat.reserve(NNZ);
-      }
-    }
-    else
-    { 
-      int i(-1), j(-1);
-      Scalar value; 
-      if( internal::GetMarketLine(line, M, N, i, j, value) ) 
-      {
-        ++ count;
-        elements.push_back(T(i,j,value));
-      }
-      else 
-        std::cerr << "Invalid read: " << i << "," << j << "\n";        
-    }
+    const char* p = (std::max)(bounds[t-1], data + (end-data)/nchunks*t);
+    const char* eol = static_cast<const char*>(std::memchr(p, '\n', end-p));
+    bounds[t] = eol ? eol+1 : end;
   }
-  mat.setFromTriplets(elements.begin(), elements.end());
+
+  std::vector<Chunk> chunks(nchunks);
+  const std::size_t reserveSize = std::size_t(NNZ/nchunks + NNZ/(8*nchunks) + 16);
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel for schedule(static,1) num_threads(threads) if(threads>1)
+#endif
+  for(Index t=0; t<nchunks; ++t)
+    internal::market_parse_chunk(bounds[t], bounds[t+1], end, pattern, bool(SparseMatrixType::IsRowMajor),
+                                 M, N, reserveSize, chunks[t]);
+  file.close();
+
+  Index count = 0, invalid = 0;
+  for(Index t=0; t<nchunks; ++t)
+  {
+    count += Index(chunks[t].outer.size());
+    invalid += chunks[t].invalid;
+  }
+  if(invalid>0)
+    std::cerr << "Invalid read: " << invalid << " entries of " << filename << " were skipped\n";
+
+  mat.resize(M,N);
+  internal::market_chunks_to_compressed(chunks, mat, threads);
   if(count!=NNZ)
     std::cerr << count << "!=" << NNZ << "\n";
-  
-  input.close();
   return true;
 }
 
@@ -220,30 +566,49 @@ bool loadMarketVector(VectorType& vec, const std::string& filename)
   return true;
 }
 
+/** Saves the sparse matrix \a mat in the matrix market file \a filename.
+  *
+  * The entries are formatted in parallel by blocks of outer vectors when OpenMP is enabled, and the blocks are
+  * written in order. The values are written with enough digits to be read back exactly.
+  *
+  * \sa loadMarket(), saveMarketBinary()
+  */
 template<typename SparseMatrixType>
 bool saveMarket(const SparseMatrixType& mat, const std::string& filename, int sym = 0)
 {
   typedef typename SparseMatrixType::Scalar Scalar;
-  std::ofstream out(filename.c_str(),std::ios::out);
+  typedef typename SparseMatrixType::Index Index;
+  std::ofstream out(filename.c_str(),std::ios::out | std::ios::binary);
   if(!out)
     return false;
   
-  out.flags(std::ios_base::scientific);
-  out.precision(64);
   std::string header; 
   internal::putMarketHeader<Scalar>(header, sym); 
-  out << header << std::endl; 
+  out << header << "\n";
   out << mat.rows() << " " << mat.cols() << " " << mat.nonZeros() << "\n";
-  int count = 0;
-  for(int j=0; j<mat.outerSize(); ++j)
-    for(typename SparseMatrixType::InnerIterator it(mat,j); it; ++it)
+
+  // the blocks of a round are formatted in parallel, each of them holding about 64k entries
+  const Index outerSize = mat.outerSize();
+  const Index threads = internal::sparse_product_threads<Index>(outerSize, mat.nonZeros());
+  const Index nnzPerOuter = (std::max)(Index(1), Index(mat.nonZeros()/(std::max)(Index(1),outerSize)));
+  const Index blockSize = (std::max)(Index(1), Index(65536/nnzPerOuter));
+  std::vector<std::string> blocks(threads);
+  for(Index round=0; round<outerSize; round+=threads*blockSize)
+  {
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(static,1) num_threads(threads) if(threads>1)
+#endif
+    for(Index t=0; t<threads; ++t)
     {
-	++ count;
-	internal::PutMatrixElt(it.value(), it.row()+1, it.col()+1, out);
-	// out << it.row()+1 << " " << it.col()+1 << " " << it.value() << "\n";
+      Index begin = (std::min)(outerSize, round + t*blockSize);
+      Index end = (std::min)(outerSize, begin + blockSize);
+      internal::market_put_entries(mat, begin, end, blocks[t]);
     }
+    for(Index t=0; t<threads; ++t)
+      out.write(blocks[t].data(), std::streamsize(blocks[t].size()));
+  }
   out.close();
-  return true;
+  return bool(out);
 }
 
 template<typename VectorType>
@@ -268,6 +633,81 @@ bool saveMarketVector (const VectorType& vec, const std::string& filename)
   return true; 
 }
 
+/** Saves the compressed storage of the sparse matrix \a mat in the binary file \a filename.
+  *
+  * The file has the format of MappedSparseFile: a versioned header, followed by the outer indices, the inner
+  * indices and the values, each array being aligned on 64 bytes. It can be mapped back in memory without any copy
+  * by MappedMarketBinary, or loaded by loadMarketBinary(). The layout depends on the scalar and index types and on
+  * the storage order of \a mat, and on the endianness of the machine; it is meant as a cache of the matrix market
+  * files.
+  *
+  * \sa MappedMarketBinary, loadMarketBinary(), saveMarket(), saveMappedMatrix()
+  */
+template<typename SparseMatrixType>
+bool saveMarketBinary(const SparseMatrixType& mat, const std::string& filename)
+{
+  return saveMappedMatrix(mat, filename);
+}
+
+/** \ingroup SparseExtra_Module
+  * \class MappedMarketBinary
+  *
+  * \brief Maps a binary file written by saveMarketBinary() as a MappedSparseMatrix
+  *
+  * This is a MappedSparseFile which is privately mapped by default: the coefficients can be modified, but the
+  * changes are not written to the file. The matrix is valid until the mapping is closed or destroyed.
+  * \code
+  * MappedMarketBinary<double> cache;
+  * if(!cache.open("A.bin"))
+  * {
+  *   SparseMatrix<double> A;
+  *   loadMarket(A, "A.mtx");
+  *   saveMarketBinary(A, "A.bin");
+  *   cache.open("A.bin");
+  * }
+  * x = solver.compute(cache.matrix()).solve(b);
+  * \endcode
+  *
+  * The scalar type, the index type and the storage order must be the ones of the saved matrix, otherwise open()
+  * fails. On systems without mmap, the file is read in memory.
+  *
+  * \sa saveMarketBinary(), loadMarketBinary(), MappedSparseFile
+  */
+template<typename _Scalar, int _Options = 0, typename _Index = int>
+class MappedMarketBinary : public MappedSparseFile<_Scalar,_Options,_Index>
+{
+  public:
+    MappedMarketBinary() {}
+
+    explicit MappedMarketBinary(const std::string& filename, int options = MapPrivate)
+    {
+      this->open(filename, options);
+    }
+};
+
+/** Loads the binary file \a filename written by saveMarketBinary() into \a mat. The file can have been saved from
+  * a matrix of either storage order.
+  *
+  * \sa MappedMarketBinary, saveMarketBinary()
+  */
+template<typename Scalar, int Options, typename Index>
+bool loadMarketBinary(SparseMatrix<Scalar,Options,Index>& mat, const std::string& filename)
+{
+  MappedMarketBinary<Scalar,Options,Index> same;
+  if(same.open(filename))
+  {
+    mat = same.matrix();
+    return true;
+  }
+  MappedMarketBinary<Scalar,int(Options)^int(RowMajorBit),Index> transposed;
+  if(transposed.open(filename))
+  {
+    mat = transposed.matrix();
+    return true;
+  }
+  return false;
+}
+
 } // end namespace Eigen
 
 #endif // EIGEN_SPARSE_MARKET_IO_H
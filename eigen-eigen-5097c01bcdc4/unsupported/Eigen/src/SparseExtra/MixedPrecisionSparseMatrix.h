@@ -0,0 +1,316 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_MIXEDPRECISIONSPARSEMATRIX_H
+#define EIGEN_MIXEDPRECISIONSPARSEMATRIX_H
+
+namespace Eigen {
+
+template<typename _Scalar, typename _StorageScalar = float, typename _Index = int> class MixedPrecisionSparseMatrix;
+template<typename MatrixType, unsigned int UpLo> class MixedPrecisionSelfAdjointView;
+template<typename Lhs, typename Rhs, int UpLo> class MixedPrecisionSelfAdjointTimeDenseProduct;
+
+namespace internal {
+template<typename _Scalar, typename _StorageScalar, typename _Index>
+struct traits<MixedPrecisionSparseMatrix<_Scalar,_StorageScalar,_Index> >
+{
+  typedef _Scalar Scalar;
+  typedef _Index Index;
+  typedef Sparse StorageKind;
+  typedef MatrixXpr XprKind;
+  enum {
+    RowsAtCompileTime = Dynamic,
+    ColsAtCompileTime = Dynamic,
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = Dynamic,
+    Flags = RowMajorBit | NestByRefBit,
+    CoeffReadCost = NumTraits<Scalar>::ReadCost,
+    SupportedAccessPatterns = OuterRandomAccessPattern
+  };
+};
+}
+
+/** \ingroup SparseExtra_Module
+  * \class MixedPrecisionSparseMatrix
+  *
+  * \brief A read-only row major sparse matrix storing its coefficients in a lower precision
+  *
+  * \tparam _Scalar the scalar type of the expressions and of the accumulations, e.g., double
+  * \tparam _StorageScalar the scalar type of the stored coefficients (default is float)
+  * \tparam _Index the type of the indices
+  *
+  * The sparse matrix - vector products are memory bound, and the coefficients make most of the traffic. This
+  * matrix stores them as \a _StorageScalar, which halves their size for float instead of double, while it behaves as a
+  * matrix of \a _Scalar: the coefficients are converted when they are loaded, and the products are accumulated
+  * in \a _Scalar. The products with dense vectors and matrices are multithreaded when OpenMP is enabled.
+  *
+  * The rounding of the coefficients perturbs the matrix by a relative amount of the order of the epsilon of
+  * \a _StorageScalar. This matrix is thus meant for the inner iterations of a Krylov solver, the accuracy of the
+  * final solution being recovered by an IterativeRefinement on the original matrix:
+  * \code
+  * SparseMatrix<double> A;
+  * // ... fill A
+  * typedef MixedPrecisionSparseMatrix<double,float> FloatMatrix;
+  * IterativeRefinement<SparseMatrix<double>, ConjugateGradient<FloatMatrix, Lower|Upper> > solver(A);
+  * x = solver.solve(b);
+  * \endcode
+  *
+  * As for SlicedEllMatrix, selfadjointView<Lower|Upper>() treats the full matrix as selfadjoint and uses the
+  * parallel product, which is the intended use with ConjugateGradient.
+  *
+  * \sa SparseMatrix, IterativeRefinement
+  */
+template<typename _Scalar, typename _StorageScalar, typename _Index>
+class MixedPrecisionSparseMatrix
+  : public SparseMatrixBase<MixedPrecisionSparseMatrix<_Scalar,_StorageScalar,_Index> >
+{
+  public:
+    EIGEN_SPARSE_PUBLIC_INTERFACE(MixedPrecisionSparseMatrix)
+
+    typedef _StorageScalar StorageScalar;
+    typedef SparseMatrix<StorageScalar,RowMajor,Index> StorageMatrix;
+
+    class InnerIterator;
+    class ReverseInnerIterator;
+
+    /** Default constructor yielding an empty \c 0 \c x \c 0 matrix */
+    MixedPrecisionSparseMatrix() {}
+
+    /** Builds a copy of \a other whose coefficients are rounded to \a _StorageScalar */
+    template<typename OtherDerived>
+    MixedPrecisionSparseMatrix(const SparseMatrixBase<OtherDerived>& other)
+    {
+      *this = other.derived();
+    }
+
+    MixedPrecisionSparseMatrix(const MixedPrecisionSparseMatrix& other)
+      : Base(), m_storage(other.m_storage)
+    {}
+
+    MixedPrecisionSparseMatrix& operator=(const MixedPrecisionSparseMatrix& other)
+    {
+      m_storage = other.m_storage;
+      return *this;
+    }
+
+    /** Copies \a other, rounding its coefficients to \a _StorageScalar */
+    template<typename OtherDerived>
+    MixedPrecisionSparseMatrix& operator=(const SparseMatrixBase<OtherDerived>& other)
+    {
+      StorageMatrix tmp(other.derived().template cast<StorageScalar>());
+      tmp.makeCompressed();
+      m_storage.swap(tmp);
+      return *this;
+    }
+
+    inline Index rows() const { return m_storage.rows(); }
+    inline Index cols() const { return m_storage.cols(); }
+    inline Index innerSize() const { return m_storage.innerSize(); }
+    inline Index outerSize() const { return m_storage.outerSize(); }
+    inline Index nonZeros() const { return m_storage.nonZeros(); }
+
+    inline const Index* outerIndexPtr() const { return m_storage.outerIndexPtr(); }
+    inline const Index* innerIndexPtr() const { return m_storage.innerIndexPtr(); }
+    inline const StorageScalar* valuePtr() const { return m_storage.valuePtr(); }
+    inline StorageScalar* valuePtr() { return m_storage.valuePtr(); }
+
+    /** \returns a const reference to the underlying low precision matrix */
+    const StorageMatrix& storage() const { return m_storage; }
+
+    /** \returns an expression of the selfadjoint matrix whose \a UpLo triangular part is the one of \c *this.
+      * If \a UpLo is Lower|Upper, the full matrix is assumed to be selfadjoint and the products are the plain
+      * parallel products. */
+    template<unsigned int UpLo> inline const MixedPrecisionSelfAdjointView<MixedPrecisionSparseMatrix, UpLo> selfadjointView() const
+    {
+      return MixedPrecisionSelfAdjointView<MixedPrecisionSparseMatrix, UpLo>(*this);
+    }
+
+    void swap(MixedPrecisionSparseMatrix& other)
+    {
+      m_storage.swap(other.m_storage);
+    }
+
+  protected:
+    StorageMatrix m_storage;
+};
+
+/** \class MixedPrecisionSparseMatrix::InnerIterator
+  * Iterates over the nonzeros of a row, their values being converted to \a _Scalar. */
+template<typename Scalar, typename _StorageScalar, typename _Index>
+class MixedPrecisionSparseMatrix<Scalar,_StorageScalar,_Index>::InnerIterator
+{
+  public:
+    InnerIterator(const MixedPrecisionSparseMatrix& mat, Index outer)
+      : m_it(mat.m_storage, outer)
+    {}
+
+    inline InnerIterator& operator++() { ++m_it; return *this; }
+
+    inline Scalar value() const { return Scalar(m_it.value()); }
+
+    inline Index index() const { return m_it.index(); }
+    inline Index outer() const { return m_it.outer(); }
+    inline Index row() const { return m_it.row(); }
+    inline Index col() const { return m_it.col(); }
+
+    inline operator bool() const { return m_it; }
+
+  protected:
+    typename StorageMatrix::InnerIterator m_it;
+};
+
+template<typename Scalar, typename _StorageScalar, typename _Index>
+class MixedPrecisionSparseMatrix<Scalar,_StorageScalar,_Index>::ReverseInnerIterator
+{
+  public:
+    ReverseInnerIterator(const MixedPrecisionSparseMatrix& mat, Index outer)
+      : m_it(mat.m_storage, outer)
+    {}
+
+    inline ReverseInnerIterator& operator--() { --m_it; return *this; }
+
+    inline Scalar value() const { return Scalar(m_it.value()); }
+
+    inline Index index() const { return m_it.index(); }
+    inline Index outer() const { return m_it.outer(); }
+    inline Index row() const { return m_it.row(); }
+    inline Index col() const { return m_it.col(); }
+
+    inline operator bool() const { return m_it; }
+
+  protected:
+    typename StorageMatrix::ReverseInnerIterator m_it;
+};
+
+namespace internal {
+
+// res += alpha * lhs * rhs: the rows are distributed over the threads, and each coefficient is converted to the
+// accumulation type when it is loaded.
+template<typename Lhs, typename Rhs, typename Res>
+void mixed_precision_time_dense_product(const Lhs& lhs, const Rhs& rhs, Res& res, typename Res::Scalar alpha)
+{
+  typedef typename Lhs::Scalar Scalar;
+  typedef typename Lhs::StorageScalar StorageScalar;
+  typedef typename Lhs::Index Index;
+
+  const Index* outerIndex = lhs.outerIndexPtr();
+  const Index* innerIndex = lhs.innerIndexPtr();
+  const StorageScalar* values = lhs.valuePtr();
+  const Index n = lhs.rows();
+  const Index threads = sparse_product_threads<Index>(n, lhs.nonZeros());
+  EIGEN_UNUSED_VARIABLE(threads);
+
+  for(Index col=0; col<rhs.cols(); ++col)
+  {
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(static) num_threads(threads) if(threads>1)
+#endif
+    for(Index i=0; i<n; ++i)
+    {
+      Scalar acc(0);
+      for(Index p=outerIndex[i]; p<outerIndex[i+1]; ++p)
+        acc += Scalar(values[p]) * rhs.coeff(innerIndex[p], col);
+      res.coeffRef(i,col) += alpha * acc;
+    }
+  }
+}
+
+template<typename Scalar, typename StorageScalar, typename Index, typename DenseRhsType, typename DenseResType>
+struct sparse_time_dense_product_impl<MixedPrecisionSparseMatrix<Scalar,StorageScalar,Index>,DenseRhsType,DenseResType,RowMajor,true>
+{
+  static void run(const MixedPrecisionSparseMatrix<Scalar,StorageScalar,Index>& lhs, const DenseRhsType& rhs, DenseResType& res,
+                  typename DenseResType::Scalar alpha)
+  {
+    mixed_precision_time_dense_product(lhs, rhs, res, alpha);
+  }
+};
+
+template<typename Scalar, typename StorageScalar, typename Index, typename DenseRhsType, typename DenseResType>
+struct sparse_time_dense_product_impl<MixedPrecisionSparseMatrix<Scalar,StorageScalar,Index>,DenseRhsType,DenseResType,RowMajor,false>
+{
+  static void run(const MixedPrecisionSparseMatrix<Scalar,StorageScalar,Index>& lhs, const DenseRhsType& rhs, DenseResType& res,
+                  typename DenseResType::Scalar alpha)
+  {
+    mixed_precision_time_dense_product(lhs, rhs, res, alpha);
+  }
+};
+
+template<typename MatrixType, unsigned int UpLo>
+struct traits<MixedPrecisionSelfAdjointView<MatrixType,UpLo> > : traits<MatrixType> {};
+
+template<typename Lhs, typename Rhs, int UpLo>
+struct traits<MixedPrecisionSelfAdjointTimeDenseProduct<Lhs,Rhs,UpLo> >
+ : traits<ProductBase<MixedPrecisionSelfAdjointTimeDenseProduct<Lhs,Rhs,UpLo>, Lhs, Rhs> >
+{
+  typedef Dense StorageKind;
+};
+
+} // end namespace internal
+
+/** \ingroup SparseExtra_Module
+  * \class MixedPrecisionSelfAdjointView
+  *
+  * Expression of a selfadjoint matrix stored in a MixedPrecisionSparseMatrix, as returned by
+  * MixedPrecisionSparseMatrix::selfadjointView().
+  */
+template<typename MatrixType, unsigned int UpLo> class MixedPrecisionSelfAdjointView
+  : public EigenBase<MixedPrecisionSelfAdjointView<MatrixType,UpLo> >
+{
+  public:
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
+
+    inline MixedPrecisionSelfAdjointView(const MatrixType& matrix) : m_matrix(matrix)
+    {
+      eigen_assert(rows()==cols() && "SelfAdjointView is only for squared matrices");
+    }
+
+    inline Index rows() const { return m_matrix.rows(); }
+    inline Index cols() const { return m_matrix.cols(); }
+
+    /** \returns a reference to the nested matrix */
+    const MatrixType& matrix() const { return m_matrix; }
+
+    template<typename OtherDerived>
+    MixedPrecisionSelfAdjointTimeDenseProduct<MatrixType,OtherDerived,UpLo>
+    operator*(const MatrixBase<OtherDerived>& rhs) const
+    {
+      return MixedPrecisionSelfAdjointTimeDenseProduct<MatrixType,OtherDerived,UpLo>(m_matrix, rhs.derived());
+    }
+
+  protected:
+    const MatrixType& m_matrix;
+};
+
+template<typename Lhs, typename Rhs, int UpLo>
+class MixedPrecisionSelfAdjointTimeDenseProduct
+  : public ProductBase<MixedPrecisionSelfAdjointTimeDenseProduct<Lhs,Rhs,UpLo>, Lhs, Rhs>
+{
+  public:
+    EIGEN_PRODUCT_PUBLIC_INTERFACE(MixedPrecisionSelfAdjointTimeDenseProduct)
+
+    MixedPrecisionSelfAdjointTimeDenseProduct(const Lhs& lhs, const Rhs& rhs) : Base(lhs,rhs)
+    {}
+
+    template<typename Dest> void scaleAndAddTo(Dest& dest, Scalar alpha) const
+    {
+      typedef typename internal::remove_all<Lhs>::type _Lhs;
+      const _Lhs& lhs = m_lhs;
+      if((UpLo&(Lower|Upper))==(Lower|Upper))
+        internal::mixed_precision_time_dense_product(lhs, m_rhs, dest, alpha);
+      else
+        // only one triangular part is used: fall back to the generic selfadjoint product
+        dest += alpha * (static_cast<const SparseMatrixBase<_Lhs>&>(lhs).template selfadjointView<UpLo>() * m_rhs);
+    }
+
+  private:
+    MixedPrecisionSelfAdjointTimeDenseProduct& operator=(const MixedPrecisionSelfAdjointTimeDenseProduct&);
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_MIXEDPRECISIONSPARSEMATRIX_H
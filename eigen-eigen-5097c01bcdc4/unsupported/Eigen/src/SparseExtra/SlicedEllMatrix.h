@@ -0,0 +1,514 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SLICEDELLMATRIX_H
+#define EIGEN_SLICEDELLMATRIX_H
+
+namespace Eigen {
+
+template<typename _Scalar, int _ChunkHeight = 8, typename _Index = int> class SlicedEllMatrix;
+template<typename MatrixType, unsigned int UpLo> class SlicedEllSelfAdjointView;
+template<typename Lhs, typename Rhs, int UpLo> class SlicedEllSelfAdjointTimeDenseProduct;
+
+namespace internal {
+template<typename _Scalar, int _ChunkHeight, typename _Index>
+struct traits<SlicedEllMatrix<_Scalar,_ChunkHeight,_Index> >
+{
+  typedef _Scalar Scalar;
+  typedef _Index Index;
+  typedef Sparse StorageKind;
+  typedef MatrixXpr XprKind;
+  enum {
+    RowsAtCompileTime = Dynamic,
+    ColsAtCompileTime = Dynamic,
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = Dynamic,
+    Flags = RowMajorBit | NestByRefBit | LvalueBit,
+    CoeffReadCost = NumTraits<Scalar>::ReadCost,
+    SupportedAccessPatterns = OuterRandomAccessPattern
+  };
+};
+}
+
+/** \ingroup SparseExtra_Module
+  * \class SlicedEllMatrix
+  *
+  * \brief A read-only sparse matrix in the sliced ELLPACK format SELL-C-sigma
+  *
+  * \tparam _Scalar the scalar type, i.e. the type of the coefficients
+  * \tparam _ChunkHeight the number C of rows per chunk, typically the number of SIMD lanes (default is 8)
+  * \tparam _Index the type of the indices
+  *
+  * The rows are grouped in chunks of C consecutive rows, and each chunk is stored as a dense column major
+  * C x w array of values and column indices, w being the length of the longest row of the chunk. The shorter rows
+  * are padded with explicit zeros. The matrix-vector product thus processes the C rows of a chunk simultaneously,
+  * one row per SIMD lane, with a regular inner loop of w iterations.
+  *
+  * To limit the padding, the rows are first sorted by decreasing lengths within windows of sigma consecutive rows.
+  * A large sigma reduces the padding of matrices with highly variable row lengths, while a small sigma keeps
+  * the rows close to their original positions, and thus the locality of the accesses to the vector. The fill ratio
+  * of the storage is returned by fillRatio().
+  *
+  * The matrix is built from any sparse matrix:
+  * \code
+  * SparseMatrix<double> A;
+  * // ... fill A
+  * SlicedEllMatrix<double,8> S(A, 256);     // C = 8, sigma = 256
+  * y = S * x;
+  * \endcode
+  * Its inner vectors are the rows of the matrix, such that it can be converted back to a SparseMatrix and used by
+  * the generic sparse algorithms, e.g., by the preconditioners of the IterativeLinearSolvers module. The products
+  * with dense vectors and matrices are multithreaded when OpenMP is enabled. For the ConjugateGradient solver, the
+  * full selfadjoint matrix should be stored and the solver be instantiated with Lower|Upper, e.g.,
+  * ConjugateGradient<SlicedEllMatrix<double>, Lower|Upper>, such that the SELL product is used as is.
+  *
+  * \sa SparseMatrix, BlockSparseMatrix
+  */
+template<typename _Scalar, int _ChunkHeight, typename _Index>
+class SlicedEllMatrix
+  : public SparseMatrixBase<SlicedEllMatrix<_Scalar,_ChunkHeight,_Index> >
+{
+  public:
+    EIGEN_SPARSE_PUBLIC_INTERFACE(SlicedEllMatrix)
+
+    enum { ChunkHeight = _ChunkHeight };
+    typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+
+    class InnerIterator;
+    class ReverseInnerIterator;
+
+    /** Default constructor yielding an empty \c 0 \c x \c 0 matrix with the default sorting window */
+    SlicedEllMatrix() : m_rows(0), m_cols(0), m_nonZeros(0), m_sigma(16*ChunkHeight), m_chunkPtr(IndexVector::Zero(1)) {}
+
+    /** Builds the SELL-C-sigma representation of \a other with the sorting window \a sigma */
+    template<typename OtherDerived>
+    SlicedEllMatrix(const SparseMatrixBase<OtherDerived>& other, Index sigma = 16*ChunkHeight)
+      : m_rows(0), m_cols(0), m_nonZeros(0), m_sigma(sigma)
+    {
+      *this = other.derived();
+    }
+
+    SlicedEllMatrix(const SlicedEllMatrix& other)
+      : Base(), m_rows(other.m_rows), m_cols(other.m_cols), m_nonZeros(other.m_nonZeros), m_sigma(other.m_sigma),
+        m_chunkPtr(other.m_chunkPtr), m_innerIndex(other.m_innerIndex), m_values(other.m_values),
+        m_rowLength(other.m_rowLength), m_perm(other.m_perm), m_invPerm(other.m_invPerm)
+    {}
+
+    SlicedEllMatrix& operator=(const SlicedEllMatrix& other)
+    {
+      m_rows = other.m_rows;
+      m_cols = other.m_cols;
+      m_nonZeros = other.m_nonZeros;
+      m_sigma = other.m_sigma;
+      m_chunkPtr = other.m_chunkPtr;
+      m_innerIndex = other.m_innerIndex;
+      m_values = other.m_values;
+      m_rowLength = other.m_rowLength;
+      m_perm = other.m_perm;
+      m_invPerm = other.m_invPerm;
+      return *this;
+    }
+
+    /** Builds the SELL-C-sigma representation of \a other using the current sortingWindow() */
+    template<typename OtherDerived>
+    SlicedEllMatrix& operator=(const SparseMatrixBase<OtherDerived>& other);
+
+    /** Sets the size sigma of the windows in which the rows are sorted by decreasing lengths.
+      * It is used by the next conversion, and rounded up to a multiple of the chunk height. 1 disables the sorting. */
+    void setSortingWindow(Index sigma) { m_sigma = sigma; }
+
+    /** \returns the size of the sorting windows \sa setSortingWindow() */
+    Index sortingWindow() const { return m_sigma; }
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+    inline Index innerSize() const { return m_cols; }
+    inline Index outerSize() const { return m_rows; }
+
+    /** \returns the number of nonzeros, without the padding */
+    inline Index nonZeros() const { return m_nonZeros; }
+    /** \returns the number of chunks */
+    inline Index chunks() const { return Index(m_chunkPtr.size())-1; }
+    /** \returns the number of stored coefficients divided by nonZeros(), i.e., 1 + the relative amount of padding */
+    double fillRatio() const { return m_nonZeros==0 ? 1. : double(m_values.size())/double(m_nonZeros); }
+
+    /** \returns the row stored at the position \a i, i.e., in the lane i%C of the chunk i/C */
+    inline Index permutedRow(Index i) const { return m_perm[i]; }
+
+    inline const Index* chunkPtr() const { return m_chunkPtr.data(); }
+    inline const Index* innerIndexPtr() const { return m_innerIndex.data(); }
+    inline const Scalar* valuePtr() const { return m_values.data(); }
+    inline Scalar* valuePtr() { return m_values.data(); }
+    inline const Index* rowLengthPtr() const { return m_rowLength.data(); }
+
+    /** \returns an expression of the selfadjoint matrix whose \a UpLo triangular part is the one of \c *this.
+      * If \a UpLo is Lower|Upper, the full matrix is assumed to be selfadjoint and the products are the plain
+      * SELL products. Otherwise the mirrored coefficients are scattered sequentially. */
+    template<unsigned int UpLo> inline const SlicedEllSelfAdjointView<SlicedEllMatrix, UpLo> selfadjointView() const
+    {
+      return SlicedEllSelfAdjointView<SlicedEllMatrix, UpLo>(*this);
+    }
+
+    void swap(SlicedEllMatrix& other)
+    {
+      std::swap(m_rows, other.m_rows);
+      std::swap(m_cols, other.m_cols);
+      std::swap(m_nonZeros, other.m_nonZeros);
+      std::swap(m_sigma, other.m_sigma);
+      m_chunkPtr.swap(other.m_chunkPtr);
+      m_innerIndex.swap(other.m_innerIndex);
+      m_values.swap(other.m_values);
+      m_rowLength.swap(other.m_rowLength);
+      m_perm.swap(other.m_perm);
+      m_invPerm.swap(other.m_invPerm);
+    }
+
+  protected:
+    Index m_rows;
+    Index m_cols;
+    Index m_nonZeros;
+    Index m_sigma;
+    IndexVector m_chunkPtr;     // the chunk c starts at m_chunkPtr[c] in m_innerIndex and m_values
+    IndexVector m_innerIndex;
+    ScalarVector m_values;
+    IndexVector m_rowLength;    // length of the row stored at each position
+    IndexVector m_perm;         // position -> row
+    IndexVector m_invPerm;      // row -> position
+};
+
+namespace internal {
+template<typename Index>
+struct sliced_ell_row_length_greater
+{
+  sliced_ell_row_length_greater(const Index* lengths) : m_lengths(lengths) {}
+  bool operator()(Index a, Index b) const { return m_lengths[a] > m_lengths[b]; }
+  const Index* m_lengths;
+};
+}
+
+template<typename Scalar, int _ChunkHeight, typename _Index>
+template<typename OtherDerived>
+SlicedEllMatrix<Scalar,_ChunkHeight,_Index>&
+SlicedEllMatrix<Scalar,_ChunkHeight,_Index>::operator=(const SparseMatrixBase<OtherDerived>& other)
+{
+  typedef SparseMatrix<Scalar,RowMajor,Index> RowMajorMatrix;
+  const Index C = ChunkHeight;
+  // the copy also protects from aliasing
+  RowMajorMatrix mat(other.derived());
+  mat.makeCompressed();
+  const Index n = mat.rows();
+  const Index nchunks = (n+C-1)/C;
+  const Index* outer = mat.outerIndexPtr();
+  IndexVector lengths(n);
+  for(Index i=0; i<n; ++i)
+    lengths[i] = outer[i+1]-outer[i];
+
+  // sort the rows by decreasing lengths within each window; stable_sort preserves the order of rows of equal lengths
+  const Index sigma = (std::max)(Index(1), m_sigma);
+  const Index window = sigma==1 ? 1 : ((sigma+C-1)/C)*C;
+  IndexVector perm(nchunks*C);
+  for(Index i=0; i<n; ++i)
+    perm[i] = i;
+  if(window>1)
+    for(Index w=0; w<n; w+=window)
+      std::stable_sort(perm.data()+w, perm.data()+(std::min)(n,w+window),
+                       internal::sliced_ell_row_length_greater<Index>(lengths.data()));
+
+  IndexVector rowLength = IndexVector::Zero(nchunks*C);
+  IndexVector chunkPtr(nchunks+1);
+  chunkPtr[0] = 0;
+  for(Index c=0; c<nchunks; ++c)
+  {
+    Index width = 0;
+    for(Index l=0; l<C && c*C+l<n; ++l)
+    {
+      rowLength[c*C+l] = lengths[perm[c*C+l]];
+      width = (std::max)(width, rowLength[c*C+l]);
+    }
+    chunkPtr[c+1] = chunkPtr[c] + width*C;
+  }
+
+  // fill the chunks in column major order; the padding points to the first column of the row with a zero value
+  IndexVector innerIndex = IndexVector::Zero(chunkPtr[nchunks]);
+  ScalarVector values = ScalarVector::Zero(chunkPtr[nchunks]);
+  for(Index s=0; s<n; ++s)
+  {
+    const Index c = s/C, l = s%C, width = (chunkPtr[c+1]-chunkPtr[c])/C;
+    const Index row = perm[s];
+    Index* dstIndex = innerIndex.data() + chunkPtr[c] + l;
+    Scalar* dstValue = values.data() + chunkPtr[c] + l;
+    for(Index k=0; k<rowLength[s]; ++k)
+    {
+      dstIndex[k*C] = mat.innerIndexPtr()[outer[row]+k];
+      dstValue[k*C] = mat.valuePtr()[outer[row]+k];
+    }
+    for(Index k=rowLength[s]; k<width; ++k)
+      dstIndex[k*C] = rowLength[s]>0 ? dstIndex[0] : Index(0);
+  }
+
+  m_rows = n;
+  m_cols = mat.cols();
+  m_nonZeros = mat.nonZeros();
+  m_chunkPtr.swap(chunkPtr);
+  m_innerIndex.swap(innerIndex);
+  m_values.swap(values);
+  m_rowLength.swap(rowLength);
+  m_perm.swap(perm);
+  m_invPerm.resize(n);
+  for(Index s=0; s<n; ++s)
+    m_invPerm[m_perm[s]] = s;
+  return *this;
+}
+
+/** \class SlicedEllMatrix::InnerIterator
+  * Iterates over the nonzeros of a row, the padding being skipped. */
+template<typename Scalar, int _ChunkHeight, typename _Index>
+class SlicedEllMatrix<Scalar,_ChunkHeight,_Index>::InnerIterator
+{
+  public:
+    InnerIterator(const SlicedEllMatrix& mat, Index outer)
+      : m_outer(outer)
+    {
+      const Index s = mat.m_invPerm[outer];
+      const Index start = mat.m_chunkPtr[s/ChunkHeight] + s%ChunkHeight;
+      m_values = mat.m_values.data() + start;
+      m_indices = mat.m_innerIndex.data() + start;
+      m_id = 0;
+      m_end = mat.m_rowLength[s]*ChunkHeight;
+    }
+
+    inline InnerIterator& operator++() { m_id += ChunkHeight; return *this; }
+
+    inline const Scalar& value() const { return m_values[m_id]; }
+    inline Scalar& valueRef() { return const_cast<Scalar&>(m_values[m_id]); }
+
+    inline Index index() const { return m_indices[m_id]; }
+    inline Index outer() const { return m_outer; }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_id < m_end; }
+
+  protected:
+    const Scalar* m_values;
+    const Index* m_indices;
+    const Index m_outer;
+    Index m_id;
+    Index m_end;
+};
+
+template<typename Scalar, int _ChunkHeight, typename _Index>
+class SlicedEllMatrix<Scalar,_ChunkHeight,_Index>::ReverseInnerIterator
+{
+  public:
+    ReverseInnerIterator(const SlicedEllMatrix& mat, Index outer)
+      : m_outer(outer)
+    {
+      const Index s = mat.m_invPerm[outer];
+      const Index start = mat.m_chunkPtr[s/ChunkHeight] + s%ChunkHeight;
+      m_values = mat.m_values.data() + start;
+      m_indices = mat.m_innerIndex.data() + start;
+      m_id = mat.m_rowLength[s]*ChunkHeight;
+    }
+
+    inline ReverseInnerIterator& operator--() { m_id -= ChunkHeight; return *this; }
+
+    inline const Scalar& value() const { return m_values[m_id-ChunkHeight]; }
+    inline Scalar& valueRef() { return const_cast<Scalar&>(m_values[m_id-ChunkHeight]); }
+
+    inline Index index() const { return m_indices[m_id-ChunkHeight]; }
+    inline Index outer() const { return m_outer; }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_id > 0; }
+
+  protected:
+    const Scalar* m_values;
+    const Index* m_indices;
+    const Index m_outer;
+    Index m_id;
+};
+
+namespace internal {
+
+// Provides a pointer to the contiguous coefficients of a column of a dense expression, copying it if needed.
+template<typename Rhs, bool Direct = (int(traits<Rhs>::Flags)&DirectAccessBit) && !(int(traits<Rhs>::Flags)&RowMajorBit)>
+struct sliced_ell_rhs_column
+{
+  typedef typename Rhs::Scalar Scalar;
+  sliced_ell_rhs_column(const Rhs& rhs, typename Rhs::Index c) : m_copy(rhs.col(c)) {}
+  const Scalar* data() const { return m_copy.data(); }
+  Matrix<Scalar,Dynamic,1> m_copy;
+};
+
+template<typename Rhs>
+struct sliced_ell_rhs_column<Rhs,true>
+{
+  typedef typename Rhs::Scalar Scalar;
+  sliced_ell_rhs_column(const Rhs& rhs, typename Rhs::Index c) : m_data(rhs.data() + c*rhs.outerStride())
+  {
+    eigen_internal_assert(rhs.innerStride()==1);
+  }
+  const Scalar* data() const { return m_data; }
+  const Scalar* m_data;
+};
+
+// res += alpha * lhs * rhs: the C rows of each chunk are accumulated simultaneously, and the chunks are
+// distributed over the threads.
+template<typename Lhs, typename Rhs, typename Res>
+void sliced_ell_time_dense_product(const Lhs& lhs, const Rhs& rhs, Res& res, typename Res::Scalar alpha)
+{
+  typedef typename Lhs::Scalar Scalar;
+  typedef typename Lhs::Index Index;
+  enum { C = Lhs::ChunkHeight };
+
+  const Index* chunkPtr = lhs.chunkPtr();
+  const Index* innerIndex = lhs.innerIndexPtr();
+  const Scalar* values = lhs.valuePtr();
+  const Index nchunks = lhs.chunks();
+  const Index n = lhs.rows();
+  const Index threads = sparse_product_threads<Index>(nchunks, lhs.nonZeros());
+  EIGEN_UNUSED_VARIABLE(threads);
+
+  for(Index col=0; col<rhs.cols(); ++col)
+  {
+    sliced_ell_rhs_column<Rhs> rhsCol(rhs, col);
+    const Scalar* x = rhsCol.data();
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(dynamic,64) num_threads(threads) if(threads>1)
+#endif
+    for(Index c=0; c<nchunks; ++c)
+    {
+      Scalar acc[C];
+      for(int l=0; l<C; ++l)
+        acc[l] = Scalar(0);
+      const Index end = chunkPtr[c+1];
+      for(Index p=chunkPtr[c]; p<end; p+=C)
+        for(int l=0; l<C; ++l)
+          acc[l] += values[p+l] * x[innerIndex[p+l]];
+      for(int l=0; l<C && c*C+l<n; ++l)
+        res.coeffRef(lhs.permutedRow(c*C+l), col) += alpha * acc[l];
+    }
+  }
+}
+
+template<typename Scalar, int C, typename Index, typename DenseRhsType, typename DenseResType>
+struct sparse_time_dense_product_impl<SlicedEllMatrix<Scalar,C,Index>,DenseRhsType,DenseResType,RowMajor,true>
+{
+  static void run(const SlicedEllMatrix<Scalar,C,Index>& lhs, const DenseRhsType& rhs, DenseResType& res,
+                  typename DenseResType::Scalar alpha)
+  {
+    sliced_ell_time_dense_product(lhs, rhs, res, alpha);
+  }
+};
+
+template<typename Scalar, int C, typename Index, typename DenseRhsType, typename DenseResType>
+struct sparse_time_dense_product_impl<SlicedEllMatrix<Scalar,C,Index>,DenseRhsType,DenseResType,RowMajor,false>
+{
+  static void run(const SlicedEllMatrix<Scalar,C,Index>& lhs, const DenseRhsType& rhs, DenseResType& res,
+                  typename DenseResType::Scalar alpha)
+  {
+    sliced_ell_time_dense_product(lhs, rhs, res, alpha);
+  }
+};
+
+template<typename MatrixType, unsigned int UpLo>
+struct traits<SlicedEllSelfAdjointView<MatrixType,UpLo> > : traits<MatrixType> {};
+
+template<typename Lhs, typename Rhs, int UpLo>
+struct traits<SlicedEllSelfAdjointTimeDenseProduct<Lhs,Rhs,UpLo> >
+ : traits<ProductBase<SlicedEllSelfAdjointTimeDenseProduct<Lhs,Rhs,UpLo>, Lhs, Rhs> >
+{
+  typedef Dense StorageKind;
+};
+
+} // end namespace internal
+
+/** \ingroup SparseExtra_Module
+  * \class SlicedEllSelfAdjointView
+  *
+  * Expression of a selfadjoint matrix stored in a SlicedEllMatrix, as returned by SlicedEllMatrix::selfadjointView().
+  */
+template<typename MatrixType, unsigned int UpLo> class SlicedEllSelfAdjointView
+  : public EigenBase<SlicedEllSelfAdjointView<MatrixType,UpLo> >
+{
+  public:
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
+
+    inline SlicedEllSelfAdjointView(const MatrixType& matrix) : m_matrix(matrix)
+    {
+      eigen_assert(rows()==cols() && "SelfAdjointView is only for squared matrices");
+    }
+
+    inline Index rows() const { return m_matrix.rows(); }
+    inline Index cols() const { return m_matrix.cols(); }
+
+    /** \returns a reference to the nested matrix */
+    const MatrixType& matrix() const { return m_matrix; }
+
+    template<typename OtherDerived>
+    SlicedEllSelfAdjointTimeDenseProduct<MatrixType,OtherDerived,UpLo>
+    operator*(const MatrixBase<OtherDerived>& rhs) const
+    {
+      return SlicedEllSelfAdjointTimeDenseProduct<MatrixType,OtherDerived,UpLo>(m_matrix, rhs.derived());
+    }
+
+  protected:
+    const MatrixType& m_matrix;
+};
+
+template<typename Lhs, typename Rhs, int UpLo>
+class SlicedEllSelfAdjointTimeDenseProduct
+  : public ProductBase<SlicedEllSelfAdjointTimeDenseProduct<Lhs,Rhs,UpLo>, Lhs, Rhs>
+{
+  public:
+    EIGEN_PRODUCT_PUBLIC_INTERFACE(SlicedEllSelfAdjointTimeDenseProduct)
+
+    SlicedEllSelfAdjointTimeDenseProduct(const Lhs& lhs, const Rhs& rhs) : Base(lhs,rhs)
+    {}
+
+    template<typename Dest> void scaleAndAddTo(Dest& dest, Scalar alpha) const
+    {
+      typedef typename internal::remove_all<Lhs>::type _Lhs;
+      typedef typename _Lhs::Index LhsIndex;
+      const _Lhs& lhs = m_lhs;
+      if((UpLo&(Lower|Upper))==(Lower|Upper))
+      {
+        internal::sliced_ell_time_dense_product(lhs, m_rhs, dest, alpha);
+        return;
+      }
+      // only one triangular part is used: the mirrored coefficients are scattered
+      for(Index c=0; c<m_rhs.cols(); ++c)
+        for(LhsIndex i=0; i<lhs.rows(); ++i)
+        {
+          Scalar xi = alpha * m_rhs.coeff(i,c);
+          Scalar acc(0);
+          for(typename _Lhs::InnerIterator it(lhs,i); it; ++it)
+          {
+            const LhsIndex j = it.index();
+            if(j==i)
+              acc += it.value() * m_rhs.coeff(i,c);
+            else if((UpLo&Lower) ? j<i : j>i)
+            {
+              acc += it.value() * m_rhs.coeff(j,c);
+              dest.coeffRef(j,c) += internal::conj(it.value()) * xi;
+            }
+          }
+          dest.coeffRef(i,c) += alpha * acc;
+        }
+    }
+
+  private:
+    SlicedEllSelfAdjointTimeDenseProduct& operator=(const SlicedEllSelfAdjointTimeDenseProduct&);
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_SLICEDELLMATRIX_H
@@ -0,0 +1,156 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <Eigen/SparseExtra>
+#include <Eigen/IterativeLinearSolvers>
+
+template<typename Scalar, int BR, int BC> void block_sparse_matrix_basic()
+{
+  typedef BlockSparseMatrix<Scalar,BR,BC> BlockMatrix;
+  typedef SparseMatrix<Scalar> SpMat;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowDenseMatrix;
+
+  const int nbr = internal::random<int>(1,40);
+  const int nbc = internal::random<int>(1,40);
+  const int rows = nbr*BR, cols = nbc*BC;
+  double density = (std::max)(8./(rows*cols), 0.01);
+
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SpMat m(rows, cols);
+  initSparse<Scalar>(density, refMat, m);
+
+  // conversions
+  BlockMatrix bm(m);
+  VERIFY_IS_EQUAL(bm.rows(), rows);
+  VERIFY_IS_EQUAL(bm.cols(), cols);
+  VERIFY_IS_EQUAL(bm.nonZeros(), bm.nonZeroBlocks()*BR*BC);
+  VERIFY(bm.nonZeroBlocks() <= m.nonZeros());
+  VERIFY_IS_APPROX(bm.toDense(), refMat);
+  SpMat m2 = bm;
+  VERIFY_IS_APPROX(m2, m);
+  SparseMatrix<Scalar,RowMajor> m3 = bm;
+  VERIFY_IS_APPROX(DenseMatrix(m3), refMat);
+
+  // block accessors
+  int i = internal::random<int>(0,nbr-1), j = internal::random<int>(0,nbc-1);
+  typename BlockMatrix::BlockType refBlock = refMat.template block<BR,BC>(i*BR,j*BC);
+  VERIFY_IS_APPROX(bm.block(i,j), refBlock);
+  if(bm.blockIndex(i,j)>=0)
+  {
+    bm.blockRef(i,j).setOnes();
+    refMat.template block<BR,BC>(i*BR,j*BC).setOnes();
+    VERIFY_IS_APPROX(bm.toDense(), refMat);
+  }
+
+  // triplets
+  std::vector<Triplet<Scalar> > triplets;
+  for(int k=0; k<m.outerSize(); ++k)
+    for(typename SpMat::InnerIterator it(m,k); it; ++it)
+      triplets.push_back(Triplet<Scalar>(it.row(), internal::random<int>(0,cols-1), it.value()));
+  BlockMatrix bt(nbr, nbc);
+  bt.setFromTriplets(triplets.begin(), triplets.end());
+  SpMat mt(rows, cols);
+  mt.setFromTriplets(triplets.begin(), triplets.end());
+  VERIFY_IS_APPROX(bt.toDense(), DenseMatrix(mt));
+
+  // products with dense vectors and matrices
+  Matrix<Scalar,Dynamic,1> x = Matrix<Scalar,Dynamic,1>::Random(cols), y = Matrix<Scalar,Dynamic,1>::Random(rows);
+  Matrix<Scalar,Dynamic,1> refY = y;
+  Scalar s = internal::random<Scalar>();
+  VERIFY_IS_APPROX(y = bm*x, refY = refMat*x);
+  VERIFY_IS_APPROX(y.noalias() += s*(bm*x), refY += s*(refMat*x));
+  int k = internal::random<int>(2,5);
+  DenseMatrix X = DenseMatrix::Random(cols,k), Y;
+  RowDenseMatrix Xr = X, Yr;
+  VERIFY_IS_APPROX(Y = bm*X, refMat*X);
+  VERIFY_IS_APPROX(Yr = bm*Xr, refMat*X);
+  VERIFY_IS_APPROX(Y = X.transpose()*bm.transpose(), (refMat*X).transpose());
+
+  // generic sparse expressions
+  VERIFY_IS_APPROX(DenseMatrix(SpMat(s*bm)), s*refMat);
+  VERIFY_IS_APPROX(DenseMatrix(SpMat(bm.transpose())), refMat.transpose());
+
+  // keep the pattern and reset the values
+  bm.coeffs().setZero();
+  VERIFY_IS_EQUAL(bm.toDense().norm(), 0);
+}
+
+// assembles the mass like matrix of a structured mesh of triangles with BS unknowns per node
+template<typename Scalar, int BS> void block_sparse_matrix_fem()
+{
+  typedef BlockSparseMatrix<Scalar,BS,BS> BlockMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+
+  const int n = internal::random<int>(2,12);
+  const int nbNodes = n*n;
+  std::vector<int> connectivity;
+  for(int j=0; j+1<n; ++j)
+    for(int i=0; i+1<n; ++i)
+    {
+      int a = i+j*n, b = a+1, c = a+n, d = c+1;
+      int t1[3] = {a,b,d}, t2[3] = {a,d,c};
+      connectivity.insert(connectivity.end(), t1, t1+3);
+      connectivity.insert(connectivity.end(), t2, t2+3);
+    }
+  const int nbElements = int(connectivity.size())/3;
+
+  BlockMatrix A(nbNodes, nbNodes);
+  A.setPatternFromElements(&connectivity[0], nbElements, 3);
+  VERIFY(A.nonZeroBlocks()>=nbNodes);
+
+  DenseMatrix refA = DenseMatrix::Zero(nbNodes*BS, nbNodes*BS);
+  for(int e=0; e<nbElements; ++e)
+  {
+    DenseMatrix Ke = DenseMatrix::Random(3*BS, 3*BS);
+    Ke = (Ke*Ke.adjoint()).eval();
+    Ke.diagonal().array() += RealScalar(3*BS);
+    A.addElement(&connectivity[3*e], 3, Ke);
+    for(int a=0; a<3; ++a)
+      for(int b=0; b<3; ++b)
+        refA.block(connectivity[3*e+a]*BS, connectivity[3*e+b]*BS, BS, BS) += Ke.block(a*BS, b*BS, BS, BS);
+  }
+  VERIFY_IS_APPROX(A.toDense(), refA);
+
+  DenseVector x = DenseVector::Random(A.cols()), y;
+  VERIFY_IS_APPROX(y = A.template selfadjointView<Lower>()*x, refA*x);
+  VERIFY_IS_APPROX(y = A.template selfadjointView<Upper>()*x, refA*x);
+  // only the requested triangular part is read
+  DenseMatrix refL = refA.template triangularView<Lower>();
+  BlockMatrix L(SparseMatrix<Scalar>(refL.sparseView()));
+  VERIFY_IS_APPROX(y = L.template selfadjointView<Lower>()*x, refA*x);
+
+  // iterative solvers
+  DenseVector b = refA * DenseVector::Random(A.cols());
+  ConjugateGradient<BlockMatrix> cg;
+  cg.setTolerance(RealScalar(1e-6));
+  DenseVector xcg = cg.compute(A).solve(b);
+  VERIFY(cg.info()==Success);
+  VERIFY((refA*xcg - b).norm() <= RealScalar(1e-4)*b.norm());
+
+  BiCGSTAB<BlockMatrix, IncompleteLUT<Scalar> > bicg;
+  bicg.setTolerance(RealScalar(1e-6));
+  DenseVector xbicg = bicg.compute(A).solve(b);
+  VERIFY(bicg.info()==Success);
+  VERIFY((refA*xbicg - b).norm() <= RealScalar(1e-4)*b.norm());
+}
+
+void test_block_sparse_matrix()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( block_sparse_matrix_basic<double,3,3>() ));
+    CALL_SUBTEST_1(( block_sparse_matrix_basic<double,2,4>() ));
+    CALL_SUBTEST_2(( block_sparse_matrix_basic<float,1,2>() ));
+    CALL_SUBTEST_2(( block_sparse_matrix_basic<std::complex<double>,2,2>() ));
+    CALL_SUBTEST_3(( block_sparse_matrix_fem<double,3>() ));
+    CALL_SUBTEST_3(( block_sparse_matrix_fem<double,2>() ));
+    CALL_SUBTEST_4(( block_sparse_matrix_fem<std::complex<double>,2>() ));
+  }
+}
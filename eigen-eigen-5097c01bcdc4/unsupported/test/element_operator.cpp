@@ -0,0 +1,135 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <Eigen/SparseExtra>
+
+// connectivity of the bilinear quadrangles of a nx x ny grid
+template<typename Index>
+Matrix<Index,Dynamic,Dynamic> quad_connectivity(int nx, int ny)
+{
+  Matrix<Index,Dynamic,Dynamic> connectivity(4, nx*ny);
+  for(int y=0; y<ny; ++y)
+    for(int x=0; x<nx; ++x)
+    {
+      int e = y*nx+x, i = y*(nx+1)+x;
+      connectivity.col(e) << i, i+1, i+nx+1, i+nx+2;
+    }
+  return connectivity;
+}
+
+template<typename Kernel, typename Connectivity>
+SparseMatrix<typename Kernel::Scalar> assemble(int n, const Connectivity& connectivity, const Kernel& kernel)
+{
+  typedef typename Kernel::Scalar Scalar;
+  typedef typename Kernel::Index Index;
+  const Index k = kernel.size();
+  Matrix<Scalar,Dynamic,Dynamic> X = Matrix<Scalar,Dynamic,Dynamic>::Identity(k,k), Y(k,k);
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index e=0; e<connectivity.cols(); ++e)
+  {
+    // apply the kernel to the canonical basis to get the element matrix
+    std::vector<Index> elements(k, e);
+    kernel.apply(&elements[0], k, X, Y);
+    for(Index a=0; a<k; ++a)
+      for(Index b=0; b<k; ++b)
+        triplets.push_back(Triplet<Scalar>(connectivity(a,e), connectivity(b,e), Y(b,a)));
+  }
+  SparseMatrix<Scalar> A(n,n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+template<typename Scalar> void element_operator(bool shared)
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef ElementMatrixKernel<Scalar> Kernel;
+  typedef ElementOperator<Kernel> Operator;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  const int nx = internal::random<int>(1,40), ny = internal::random<int>(1,40);
+  const int n = (nx+1)*(ny+1), ne = nx*ny;
+  Matrix<int,Dynamic,Dynamic> connectivity = quad_connectivity<int>(nx, ny);
+
+  // selfadjoint positive definite element matrices
+  Kernel kernel;
+  if(shared)
+  {
+    DenseMatrix R = DenseMatrix::Random(4,4);
+    Matrix<Scalar,Dynamic,1> scales = (Matrix<RealScalar,Dynamic,1>::Random(ne).array()+RealScalar(2)).template cast<Scalar>();
+    kernel = Kernel(R*R.adjoint() + DenseMatrix::Identity(4,4), scales);
+  }
+  else
+  {
+    DenseMatrix matrices(4, 4*ne);
+    for(int e=0; e<ne; ++e)
+    {
+      DenseMatrix R = DenseMatrix::Random(4,4);
+      matrices.middleCols(4*e,4) = R*R.adjoint() + DenseMatrix::Identity(4,4);
+    }
+    kernel = Kernel(matrices);
+  }
+  VERIFY_IS_EQUAL(kernel.elements(), ne);
+
+  Operator op(n, connectivity, kernel);
+  op.setBatchSize(internal::random<int>(1,40));
+  VERIFY_IS_EQUAL(op.rows(), n);
+  VERIFY_IS_EQUAL(op.cols(), n);
+  VERIFY_IS_EQUAL(op.elements(), ne);
+  VERIFY(op.colors() <= 4 || ne==0);
+  // the elements sharing a node have different colors
+  for(int e=0; e<ne; ++e)
+    for(int f=0; f<e; ++f)
+      if(op.elementColors()(e)==op.elementColors()(f))
+        for(int a=0; a<4; ++a)
+          VERIFY((connectivity.col(f).array()!=connectivity(a,e)).all());
+
+  SparseMatrix<Scalar> A = assemble(n, connectivity, kernel);
+  DenseMatrix refA = A;
+
+  // products
+  DenseVector x = DenseVector::Random(n), y = DenseVector::Random(n), refY = y;
+  Scalar s = internal::random<Scalar>();
+  VERIFY_IS_APPROX(y = op*x, refY = refA*x);
+  VERIFY_IS_APPROX(y.noalias() += s*(op*x), refY += s*(refA*x));
+  VERIFY_IS_APPROX(y = op.template selfadjointView<Lower|Upper>()*x, refA*x);
+  DenseMatrix X = DenseMatrix::Random(n,3), Y;
+  VERIFY_IS_APPROX(Y = op*X, refA*X);
+  VERIFY_IS_APPROX(op.diagonal(), refA.diagonal());
+
+  // solvers
+  DenseVector b = refA * DenseVector::Random(n), xs;
+  RealScalar tol = RealScalar(1e-10);
+  ConjugateGradient<Operator, Lower|Upper> cg(op);
+  cg.setTolerance(tol);
+  xs = cg.solve(b);
+  VERIFY(cg.info()==Success);
+  VERIFY((refA*xs - b).norm() <= RealScalar(10)*tol*b.norm());
+
+  ConjugateGradient<Operator, Lower|Upper, IdentityPreconditioner> cgi(op);
+  cgi.setTolerance(tol);
+  xs = cgi.solve(b);
+  VERIFY(cgi.info()==Success);
+  VERIFY((refA*xs - b).norm() <= RealScalar(10)*tol*b.norm());
+
+  BiCGSTAB<Operator> bicg(op);
+  bicg.setTolerance(tol);
+  xs = bicg.solve(b);
+  VERIFY(bicg.info()==Success);
+  VERIFY((refA*xs - b).norm() <= RealScalar(10)*tol*b.norm());
+}
+
+void test_element_operator()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( element_operator<double>(false) ));
+    CALL_SUBTEST_1(( element_operator<double>(true) ));
+    CALL_SUBTEST_2(( element_operator<std::complex<double> >(false) ));
+    CALL_SUBTEST_2(( element_operator<std::complex<double> >(true) ));
+  }
+}
@@ -0,0 +1,139 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <Eigen/SparseExtra>
+#include <cstdio>
+
+template<typename MatrixType> void mapped_dense_file(const MatrixType& _m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::PlainObject PlainObject;
+  const PlainObject m = _m;
+  enum { OtherOrder = (int(MatrixType::Flags)&RowMajorBit) ? ColMajor : RowMajor };
+  const Index rows = m.rows();
+  const Index cols = m.cols();
+
+  std::string filename = "mapped_dense_file.mat";
+  VERIFY(saveMappedMatrix(m, filename));
+  {
+    MappedDenseFile<PlainObject> file(filename, MapHugePages | MapPrefetch | MapSequential);
+    VERIFY(file.isOpen());
+    VERIFY_IS_EQUAL(file.matrix().rows(), rows);
+    VERIFY_IS_EQUAL(file.matrix().cols(), cols);
+    VERIFY_IS_EQUAL(PlainObject(file.matrix()), m);
+    VERIFY(std::size_t(file.matrix().data()) % 64 == 0);
+    // the mapping is private
+    file.matrix().array() += Scalar(1);
+  }
+  MappedDenseFile<PlainObject> file;
+  VERIFY(file.open(filename));
+  VERIFY_IS_EQUAL(PlainObject(file.matrix()), m);
+  file.close();
+  VERIFY(!file.isOpen());
+
+  // the types must match, but the storage order of vectors does not matter
+  VERIFY(!file.open("mapped_dense_file_missing.mat"));
+  MappedDenseFile<Matrix<Scalar,Dynamic,Dynamic,OtherOrder> > otherOrder;
+  VERIFY(otherOrder.open(filename) == (rows==1 || cols==1));
+  MappedDenseFile<Matrix<short,Dynamic,Dynamic> > otherScalar;
+  VERIFY(!otherScalar.open(filename));
+  MappedSparseFile<Scalar> sparse;
+  VERIFY(!sparse.open(filename));
+
+  // a shared mapping writes the changes to the file
+  {
+    MappedDenseFile<PlainObject> out;
+    VERIFY(out.create(filename, rows, cols));
+    VERIFY_IS_EQUAL(PlainObject(out.matrix()), PlainObject::Zero(rows,cols));
+    out.matrix() = m;
+    VERIFY(out.flush());
+  }
+  {
+    MappedDenseFile<PlainObject> inout(filename, MapShared);
+    VERIFY(inout.isOpen());
+    VERIFY_IS_EQUAL(PlainObject(inout.matrix()), m);
+    inout.matrix() *= Scalar(2);
+  }
+  VERIFY(file.open(filename));
+  VERIFY_IS_APPROX(PlainObject(file.matrix()), Scalar(2)*m);
+  file.close();
+  std::remove(filename.c_str());
+}
+
+template<typename SparseMatrixType> void mapped_sparse_file(int rows, int cols, double density)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::Index Index;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  enum { Options = SparseMatrixType::IsRowMajor ? RowMajor : ColMajor };
+
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrixType m(rows, cols);
+  initSparse<Scalar>(density, refMat, m);
+
+  std::string filename = "mapped_sparse_file.mat";
+  VERIFY(saveMappedMatrix(m, filename));
+  {
+    MappedSparseFile<Scalar,Options,Index> file(filename, MapPrefetch);
+    VERIFY(file.isOpen());
+    VERIFY_IS_EQUAL(file.matrix().nonZeros(), m.nonZeros());
+    VERIFY_IS_EQUAL(DenseMatrix(file.matrix()), refMat);
+    VERIFY(std::size_t(file.matrix().outerIndexPtr()) % 64 == 0);
+    VERIFY(std::size_t(file.matrix().innerIndexPtr()) % 64 == 0);
+    VERIFY(std::size_t(file.matrix().valuePtr()) % 64 == 0);
+  }
+  MappedSparseFile<Scalar,int(Options)^int(RowMajorBit),Index> otherOrder;
+  VERIFY(!otherOrder.open(filename));
+  MappedSparseFile<Scalar,Options,char> otherIndex;
+  VERIFY(!otherIndex.open(filename));
+  MappedDenseFile<DenseMatrix> dense;
+  VERIFY(!dense.open(filename));
+
+  // expressions are evaluated by their iterators
+  VERIFY(saveMappedMatrix(Scalar(3)*m.transpose(), filename));
+  {
+    MappedSparseFile<Scalar,int(Options)^int(RowMajorBit),Index> file(filename);
+    VERIFY(file.isOpen());
+    VERIFY_IS_APPROX(DenseMatrix(file.matrix()), Scalar(3)*refMat.transpose());
+  }
+
+  // the arrays of a created file are filled in place
+  m.makeCompressed();
+  {
+    MappedSparseFile<Scalar,Options,Index> out;
+    VERIFY(out.create(filename, rows, cols, m.nonZeros()));
+    const Index outerSize = m.outerSize();
+    std::copy(m.outerIndexPtr(), m.outerIndexPtr()+outerSize+1, out.matrix().outerIndexPtr());
+    std::copy(m.innerIndexPtr(), m.innerIndexPtr()+m.nonZeros(), out.matrix().innerIndexPtr());
+    std::copy(m.valuePtr(), m.valuePtr()+m.nonZeros(), out.matrix().valuePtr());
+    VERIFY_IS_EQUAL(DenseMatrix(out.matrix()), refMat);
+  }
+  MappedSparseFile<Scalar,Options,Index> file(filename);
+  VERIFY(file.isOpen());
+  VERIFY_IS_EQUAL(DenseMatrix(file.matrix()), refMat);
+  file.close();
+  std::remove(filename.c_str());
+}
+
+void test_mapped_matrix_file()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    int r = internal::random<int>(1,200), c = internal::random<int>(1,200);
+    EIGEN_UNUSED_VARIABLE(r);
+    EIGEN_UNUSED_VARIABLE(c);
+    CALL_SUBTEST_1( mapped_dense_file(MatrixXd::Random(r,c)) );
+    CALL_SUBTEST_1( mapped_dense_file(VectorXf::Random(r)) );
+    CALL_SUBTEST_1( mapped_dense_file(Matrix4d::Random()) );
+    CALL_SUBTEST_2(( mapped_dense_file(Matrix<std::complex<double>,Dynamic,Dynamic,RowMajor>::Random(r,c)) ));
+    CALL_SUBTEST_2(( mapped_dense_file(Matrix<int,1,Dynamic>::Random(c)) ));
+    CALL_SUBTEST_3(( mapped_sparse_file<SparseMatrix<double> >(r, c, 0.05) ));
+    CALL_SUBTEST_3(( mapped_sparse_file<SparseMatrix<float,RowMajor> >(r, c, 0.1) ));
+    CALL_SUBTEST_3(( mapped_sparse_file<SparseMatrix<std::complex<double>,ColMajor,long> >(r, r, 0.05) ));
+  }
+}
@@ -0,0 +1,162 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <Eigen/SparseExtra>
+#include <cstdio>
+
+template<typename SparseMatrixType> void market_io_roundtrip(int rows, int cols, double density)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::Index Index;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  enum { Options = SparseMatrixType::IsRowMajor ? RowMajor : ColMajor };
+
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrixType m(rows, cols);
+  initSparse<Scalar>(density, refMat, m);
+
+  // text files, read back exactly
+  std::string filename = "market_io_roundtrip.mtx";
+  VERIFY(saveMarket(m, filename));
+  SparseMatrixType m2;
+  VERIFY(loadMarket(m2, filename));
+  VERIFY_IS_EQUAL(m2.nonZeros(), m.nonZeros());
+  VERIFY_IS_EQUAL(DenseMatrix(m2), refMat);
+  SparseMatrix<Scalar,int(Options)^int(RowMajorBit),Index> m3;
+  VERIFY(loadMarket(m3, filename));
+  VERIFY_IS_EQUAL(DenseMatrix(m3), refMat);
+  std::remove(filename.c_str());
+
+  // binary cache, mapped without copy
+  filename = "market_io_roundtrip.bin";
+  VERIFY(saveMarketBinary(m, filename));
+  {
+    MappedMarketBinary<Scalar,Options,Index> cache(filename);
+    VERIFY(cache.isOpen());
+    VERIFY_IS_EQUAL(cache.matrix().rows(), rows);
+    VERIFY_IS_EQUAL(cache.matrix().cols(), cols);
+    VERIFY_IS_EQUAL(cache.matrix().nonZeros(), m.nonZeros());
+    VERIFY_IS_EQUAL(DenseMatrix(cache.matrix()), refMat);
+    VERIFY(std::size_t(cache.matrix().valuePtr()) % 64 == 0);
+    VERIFY(std::size_t(cache.matrix().innerIndexPtr()) % 64 == 0);
+    // the mapping is private
+    if(m.nonZeros()>0)
+      cache.matrix().valuePtr()[0] += Scalar(1);
+  }
+  MappedMarketBinary<Scalar,Options,Index> cache;
+  VERIFY(cache.open(filename));
+  VERIFY_IS_EQUAL(DenseMatrix(cache.matrix()), refMat);
+  cache.close();
+  VERIFY(!cache.isOpen());
+  // the types must match
+  VERIFY(!cache.open("market_io_missing.bin"));
+  MappedMarketBinary<Scalar,int(Options)^int(RowMajorBit),Index> otherOrder;
+  VERIFY(!otherOrder.open(filename));
+  MappedMarketBinary<Scalar,Options,char> otherIndex;
+  VERIFY(!otherIndex.open(filename));
+  VERIFY(loadMarketBinary(m2, filename));
+  VERIFY_IS_EQUAL(DenseMatrix(m2), refMat);
+  VERIFY(loadMarketBinary(m3, filename));
+  VERIFY_IS_EQUAL(DenseMatrix(m3), refMat);
+  std::remove(filename.c_str());
+}
+
+void market_io_parser()
+{
+  typedef SparseMatrix<double> SpMat;
+  std::string filename = "market_io_parser.mtx";
+  {
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+    out << "%%MatrixMarket matrix coordinate real general\n"
+        << "% a comment\n"
+        << "\n"
+        << "  4 3   6\r\n"
+        << "1 1 1.5\n"
+        << "4\t3 -2e-3\r\n"
+        << "% another comment\n"
+        << "2 2 +.25\n"
+        << "1 1 0.5\n"
+        << "5 1 3\n"
+        << "\n"
+        << "3 1 -7E+2";
+  }
+  SpMat m;
+  VERIFY(loadMarket(m, filename));
+  MatrixXd ref = MatrixXd::Zero(4,3);
+  ref(0,0) = 2; ref(3,2) = -2e-3; ref(1,1) = 0.25; ref(2,0) = -700;
+  VERIFY_IS_EQUAL(m.nonZeros(), 4);
+  VERIFY_IS_EQUAL(MatrixXd(m), ref);
+
+  {
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+    out << "%%MatrixMarket matrix coordinate pattern general\n"
+        << "3 3 3\n1 2\n3 3\n2 1\n";
+  }
+  VERIFY(loadMarket(m, filename));
+  ref = MatrixXd::Zero(3,3);
+  ref(0,1) = ref(2,2) = ref(1,0) = 1;
+  VERIFY_IS_EQUAL(MatrixXd(m), ref);
+
+  {
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+    out << "%%MatrixMarket matrix coordinate real general\nthis is not a size line\n";
+  }
+  VERIFY(!loadMarket(m, filename));
+  VERIFY(!loadMarket(m, "market_io_missing.mtx"));
+  std::remove(filename.c_str());
+}
+
+// entries in random order with duplicates, spread over several outer blocks and chunks
+template<typename SparseMatrixType> void market_io_unordered(int rows, int cols, int nnz)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  std::vector<Triplet<Scalar> > triplets;
+  std::string filename = "market_io_unordered.mtx";
+  {
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+    out << "%%MatrixMarket matrix coordinate real general\n" << rows << " " << cols << " " << 3*nnz << "\n";
+    for(int e = 0; e < nnz; ++e)
+    {
+      int i = internal::random<int>(0,rows-1), j = internal::random<int>(0,cols-1);
+      int v = internal::random<int>(-9,9), w = internal::random<int>(-9,9);
+      triplets.push_back(Triplet<Scalar>(i, j, Scalar(v)));
+      triplets.push_back(Triplet<Scalar>(i, j, Scalar(w)));
+      out << i+1 << " " << j+1 << " " << v << "\n";
+      // the duplicate is written at a random later position
+      int i2 = internal::random<int>(0,rows-1), j2 = internal::random<int>(0,cols-1);
+      triplets.push_back(Triplet<Scalar>(i2, j2, Scalar(1)));
+      out << i2+1 << " " << j2+1 << " 1\n" << i+1 << " " << j+1 << " " << w << "\n";
+    }
+  }
+  SparseMatrixType m, ref(rows, cols);
+  ref.setFromTriplets(triplets.begin(), triplets.end());
+  VERIFY(loadMarket(m, filename));
+  VERIFY_IS_EQUAL(m.nonZeros(), ref.nonZeros());
+  VERIFY_IS_APPROX(m, ref);
+  for(int k = 0; k < m.outerSize(); ++k)
+    for(int p = m.outerIndexPtr()[k]+1; p < m.outerIndexPtr()[k+1]; ++p)
+      VERIFY(m.innerIndexPtr()[p-1] < m.innerIndexPtr()[p]);
+  std::remove(filename.c_str());
+}
+
+void test_market_io()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    int s = internal::random<int>(1,300);
+    EIGEN_UNUSED_VARIABLE(s);
+    CALL_SUBTEST_1( market_io_parser() );
+    CALL_SUBTEST_1(( market_io_roundtrip<SparseMatrix<double> >(s, internal::random<int>(1,300), 0.05) ));
+    CALL_SUBTEST_1(( market_io_roundtrip<SparseMatrix<double,RowMajor> >(s, s, 0.05) ));
+    CALL_SUBTEST_2(( market_io_roundtrip<SparseMatrix<float> >(s, s, 0.1) ));
+    CALL_SUBTEST_2(( market_io_roundtrip<SparseMatrix<std::complex<double>,RowMajor,long> >(s, s, 0.05) ));
+    // large enough to be parsed and converted by several threads
+    CALL_SUBTEST_3(( market_io_roundtrip<SparseMatrix<double> >(2000, 1500, 0.02) ));
+    CALL_SUBTEST_3(( market_io_unordered<SparseMatrix<double> >(9000, 5000, 20000) ));
+    CALL_SUBTEST_3(( market_io_unordered<SparseMatrix<double,RowMajor> >(9000, 5000, 20000) ));
+  }
+}
@@ -0,0 +1,123 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <Eigen/SparseExtra>
+#include <Eigen/IterativeSolvers>
+
+template<typename Scalar, typename StorageScalar> void mixed_precision_sparse_basic()
+{
+  typedef MixedPrecisionSparseMatrix<Scalar,StorageScalar> MixedMatrix;
+  typedef SparseMatrix<Scalar> SpMat;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowDenseMatrix;
+
+  const int rows = internal::random<int>(1,200);
+  const int cols = internal::random<int>(1,200);
+  double density = (std::max)(8./(rows*cols), 0.02);
+
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SpMat m(rows, cols);
+  initSparse<Scalar>(density, refMat, m);
+  // the coefficients are rounded to StorageScalar
+  refMat = SpMat(m.template cast<StorageScalar>().template cast<Scalar>());
+
+  MixedMatrix mm(m);
+  VERIFY_IS_EQUAL(mm.rows(), rows);
+  VERIFY_IS_EQUAL(mm.cols(), cols);
+  VERIFY_IS_EQUAL(mm.nonZeros(), m.nonZeros());
+  VERIFY_IS_EQUAL(mm.toDense(), refMat);
+  VERIFY_IS_APPROX(mm.toDense(), DenseMatrix(m));
+  SpMat m2 = mm;
+  VERIFY_IS_EQUAL(DenseMatrix(m2), refMat);
+  VERIFY_IS_EQUAL(DenseMatrix(mm.storage().template cast<Scalar>()), refMat);
+
+  // the products are accumulated in Scalar
+  Matrix<Scalar,Dynamic,1> x = Matrix<Scalar,Dynamic,1>::Random(cols), y = Matrix<Scalar,Dynamic,1>::Random(rows);
+  Matrix<Scalar,Dynamic,1> refY = y;
+  Scalar s = internal::random<Scalar>();
+  VERIFY_IS_APPROX(y = mm*x, refY = refMat*x);
+  VERIFY_IS_APPROX(y.noalias() += s*(mm*x), refY += s*(refMat*x));
+  int k = internal::random<int>(2,5);
+  DenseMatrix X = DenseMatrix::Random(cols,k), Y;
+  RowDenseMatrix Xr = X, Yr;
+  VERIFY_IS_APPROX(Y = mm*X, refMat*X);
+  VERIFY_IS_APPROX(Yr = mm*Xr, refMat*X);
+  VERIFY_IS_APPROX(Y = X.transpose()*mm.transpose(), (refMat*X).transpose());
+
+  // generic sparse expressions
+  VERIFY_IS_APPROX(DenseMatrix(SpMat(s*mm)), s*refMat);
+  VERIFY_IS_APPROX(DenseMatrix(SpMat(mm.transpose())), refMat.transpose());
+}
+
+template<typename Scalar> void mixed_precision_sparse_solvers()
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef typename internal::conditional<NumTraits<Scalar>::IsComplex, std::complex<float>, float>::type StorageScalar;
+  typedef MixedPrecisionSparseMatrix<Scalar,StorageScalar> MixedMatrix;
+  typedef SparseMatrix<Scalar> SpMat;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  const int n = internal::random<int>(10,300);
+  DenseMatrix refA = DenseMatrix::Zero(n,n);
+  SpMat m(n,n);
+  initSparse<Scalar>(0.05, refA, m, ForceNonZeroDiag);
+  SpMat A = m*m.adjoint();
+  for(int i=0; i<n; ++i)
+    A.coeffRef(i,i) += RealScalar(1);
+  refA = A;
+
+  MixedMatrix mA(A);
+  DenseMatrix refMixed = mA.toDense();
+  DenseVector x = DenseVector::Random(n), y;
+  VERIFY_IS_APPROX(y = mA.template selfadjointView<Lower|Upper>()*x, refMixed*x);
+  VERIFY_IS_APPROX(y = mA.template selfadjointView<Lower>()*x, refMixed*x);
+  VERIFY_IS_APPROX(y = mA.template selfadjointView<Upper>()*x, refMixed*x);
+
+  // the refinement reaches the double precision accuracy on A
+  DenseVector b = refA * DenseVector::Random(n);
+  RealScalar tol = RealScalar(1e-13);
+  IterativeRefinement<SpMat, ConjugateGradient<MixedMatrix, Lower|Upper> > cg(A);
+  cg.setTolerance(tol);
+  DenseVector xcg = cg.solve(b);
+  VERIFY(cg.info()==Success);
+  VERIFY(cg.refinements()>=1);
+  VERIFY(cg.error()<=tol);
+  VERIFY((refA*xcg - b).norm() <= tol*b.norm());
+
+  IterativeRefinement<SpMat, ConjugateGradient<MixedMatrix> > cgl;
+  cgl.setTolerance(tol);
+  cgl.innerSolver().setTolerance(RealScalar(1e-4));
+  DenseMatrix B = refA * DenseMatrix::Random(n,2);
+  DenseMatrix Xcg = cgl.compute(A).solve(B);
+  VERIFY(cgl.info()==Success);
+  VERIFY((refA*Xcg - B).norm() <= RealScalar(2)*tol*B.norm());
+
+  IterativeRefinement<SpMat, BiCGSTAB<MixedMatrix> > bicg(A);
+  bicg.setTolerance(tol);
+  DenseVector xbicg = bicg.solveWithGuess(b, xcg);
+  VERIFY(bicg.info()==Success);
+  VERIFY((refA*xbicg - b).norm() <= tol*b.norm());
+
+  // without enough refinements, the accuracy is bounded by the one of the inner solves
+  bicg.setMaxRefinements(1);
+  bicg.innerSolver().setTolerance(RealScalar(1e-3));
+  xbicg = bicg.solve(b);
+  VERIFY(bicg.info()==NoConvergence);
+  VERIFY(bicg.refinements()==1);
+}
+
+void test_mixed_precision_sparse()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( mixed_precision_sparse_basic<double,float>() ));
+    CALL_SUBTEST_2(( mixed_precision_sparse_basic<std::complex<double>,std::complex<float> >() ));
+    CALL_SUBTEST_3(( mixed_precision_sparse_solvers<double>() ));
+    CALL_SUBTEST_4(( mixed_precision_sparse_solvers<std::complex<double> >() ));
+  }
+}
@@ -0,0 +1,134 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <Eigen/SparseExtra>
+#include <Eigen/IterativeLinearSolvers>
+
+template<typename Scalar, int C> void sliced_ell_matrix_basic(int sigma)
+{
+  typedef SlicedEllMatrix<Scalar,C> SellMatrix;
+  typedef SparseMatrix<Scalar> SpMat;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowDenseMatrix;
+
+  const int rows = internal::random<int>(1,200);
+  const int cols = internal::random<int>(1,200);
+  double density = (std::max)(8./(rows*cols), 0.02);
+
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SpMat m(rows, cols);
+  initSparse<Scalar>(density, refMat, m);
+  // a few dense rows make the row lengths highly variable
+  for(int k=0; k<3; ++k)
+  {
+    int i = internal::random<int>(0,rows-1);
+    for(int j=0; j<cols; j+=2)
+      m.coeffRef(i,j) = refMat(i,j) = internal::random<Scalar>();
+  }
+
+  // conversions
+  SellMatrix sm(m, sigma);
+  VERIFY_IS_EQUAL(sm.rows(), rows);
+  VERIFY_IS_EQUAL(sm.cols(), cols);
+  VERIFY_IS_EQUAL(sm.nonZeros(), m.nonZeros());
+  VERIFY_IS_EQUAL(sm.chunks(), (rows+C-1)/C);
+  VERIFY(sm.fillRatio() >= 1.);
+  VERIFY_IS_APPROX(sm.toDense(), refMat);
+  SpMat m2 = sm;
+  VERIFY_IS_APPROX(m2, m);
+  SparseMatrix<Scalar,RowMajor> m3 = sm;
+  VERIFY_IS_APPROX(DenseMatrix(m3), refMat);
+
+  // sorting the rows reduces the padding
+  SellMatrix unsorted;
+  unsorted.setSortingWindow(1);
+  unsorted = m;
+  VERIFY_IS_APPROX(unsorted.toDense(), refMat);
+  if(sigma>=rows)
+    VERIFY(sm.fillRatio() <= unsorted.fillRatio());
+
+  // products with dense vectors and matrices
+  Matrix<Scalar,Dynamic,1> x = Matrix<Scalar,Dynamic,1>::Random(cols), y = Matrix<Scalar,Dynamic,1>::Random(rows);
+  Matrix<Scalar,Dynamic,1> refY = y;
+  Scalar s = internal::random<Scalar>();
+  VERIFY_IS_APPROX(y = sm*x, refY = refMat*x);
+  VERIFY_IS_APPROX(y.noalias() += s*(sm*x), refY += s*(refMat*x));
+  int k = internal::random<int>(2,5);
+  DenseMatrix X = DenseMatrix::Random(cols,k), Y;
+  RowDenseMatrix Xr = X, Yr;
+  VERIFY_IS_APPROX(Y = sm*X, refMat*X);
+  VERIFY_IS_APPROX(Yr = sm*Xr, refMat*X);
+  VERIFY_IS_APPROX(Y = sm*X.middleCols(1,k-1), refMat*X.middleCols(1,k-1));
+  VERIFY_IS_APPROX(Y = X.transpose()*sm.transpose(), (refMat*X).transpose());
+
+  // generic sparse expressions
+  VERIFY_IS_APPROX(DenseMatrix(SpMat(s*sm)), s*refMat);
+  VERIFY_IS_APPROX(DenseMatrix(SpMat(sm.transpose())), refMat.transpose());
+}
+
+template<typename Scalar, int C> void sliced_ell_matrix_solvers()
+{
+  typedef SlicedEllMatrix<Scalar,C> SellMatrix;
+  typedef SparseMatrix<Scalar> SpMat;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+
+  const int n = internal::random<int>(10,300);
+  DenseMatrix refA = DenseMatrix::Zero(n,n);
+  SpMat m(n,n);
+  initSparse<Scalar>(0.05, refA, m, ForceNonZeroDiag);
+  SpMat spd = m*m.adjoint();
+  for(int i=0; i<n; ++i)
+    spd.coeffRef(i,i) += RealScalar(1);
+  refA = spd;
+
+  SellMatrix A(spd, internal::random<int>(1,4*C));
+  DenseVector x = DenseVector::Random(n), y;
+  VERIFY_IS_APPROX(y = A.template selfadjointView<Lower|Upper>()*x, refA*x);
+  VERIFY_IS_APPROX(y = A.template selfadjointView<Lower>()*x, refA*x);
+  VERIFY_IS_APPROX(y = A.template selfadjointView<Upper>()*x, refA*x);
+  // only the requested triangular part is read
+  DenseMatrix refL = refA.template triangularView<Lower>();
+  SellMatrix L(SpMat(refL.sparseView()));
+  VERIFY_IS_APPROX(y = L.template selfadjointView<Lower>()*x, refA*x);
+
+  // iterative solvers
+  DenseVector b = refA * DenseVector::Random(n);
+  ConjugateGradient<SellMatrix, Lower|Upper> cg;
+  cg.setTolerance(RealScalar(1e-8));
+  DenseVector xcg = cg.compute(A).solve(b);
+  VERIFY(cg.info()==Success);
+  VERIFY((refA*xcg - b).norm() <= RealScalar(1e-6)*b.norm());
+
+  ConjugateGradient<SellMatrix> cgl;
+  cgl.setTolerance(RealScalar(1e-8));
+  xcg = cgl.compute(L).solve(b);
+  VERIFY(cgl.info()==Success);
+  VERIFY((refA*xcg - b).norm() <= RealScalar(1e-6)*b.norm());
+
+  BiCGSTAB<SellMatrix, IncompleteLUT<Scalar> > bicg;
+  bicg.setTolerance(RealScalar(1e-8));
+  DenseVector xbicg = bicg.compute(A).solve(b);
+  VERIFY(bicg.info()==Success);
+  VERIFY((refA*xbicg - b).norm() <= RealScalar(1e-6)*b.norm());
+}
+
+void test_sliced_ell_matrix()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( sliced_ell_matrix_basic<double,8>(1) ));
+    CALL_SUBTEST_1(( sliced_ell_matrix_basic<double,4>(internal::random<int>(2,64)) ));
+    CALL_SUBTEST_1(( sliced_ell_matrix_basic<double,8>(1000) ));
+    CALL_SUBTEST_2(( sliced_ell_matrix_basic<float,16>(internal::random<int>(1,300)) ));
+    CALL_SUBTEST_2(( sliced_ell_matrix_basic<std::complex<double>,1>(internal::random<int>(1,300)) ));
+    CALL_SUBTEST_3(( sliced_ell_matrix_solvers<double,8>() ));
+    CALL_SUBTEST_3(( sliced_ell_matrix_solvers<double,4>() ));
+    CALL_SUBTEST_4(( sliced_ell_matrix_solvers<std::complex<double>,4>() ));
+  }
+}
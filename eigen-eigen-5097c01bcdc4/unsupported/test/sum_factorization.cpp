@@ -0,0 +1,186 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <Eigen/SparseExtra>
+#include <Eigen/KroneckerProduct>
+
+template<typename Scalar, int Ra, int Ca, int Rb, int Cb, int Rc, int Cc> void kronecker_product_apply()
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  Matrix<Scalar,Ra,Ca> A = Matrix<Scalar,Ra,Ca>::Random();
+  Matrix<Scalar,Rb,Cb> B = Matrix<Scalar,Rb,Cb>::Random();
+  Matrix<Scalar,Rc,Cc> C = Matrix<Scalar,Rc,Cc>::Random();
+  DenseMatrix BC, K;
+  kroneckerProduct(B, C, BC);
+  kroneckerProduct(A, BC, K);
+
+  const int rows = internal::random<int>(1,20);
+  DenseMatrix X = DenseMatrix::Random(rows, Ca*Cb*Cc), Y(rows, Ra*Rb*Rc);
+  kroneckerProductApply(A, B, C, X, Y);
+  VERIFY_IS_APPROX(Y, X*K.transpose());
+
+  // block destination
+  const int count = internal::random<int>(0,rows);
+  DenseMatrix refY = DenseMatrix::Random(rows, Ra*Rb*Rc);
+  Y = refY;
+  kroneckerProductApply(A, B, C, X.topRows(count), Y.topRows(count));
+  refY.topRows(count) = X.topRows(count)*K.transpose();
+  VERIFY_IS_APPROX(Y, refY);
+}
+
+// connectivity of the hexahedra of degree p of a nx x ny x nz grid
+template<typename Index>
+Matrix<Index,Dynamic,Dynamic> hex_connectivity(int p, int nx, int ny, int nz)
+{
+  const int n = p+1, sx = p*nx+1, sy = p*ny+1;
+  Matrix<Index,Dynamic,Dynamic> connectivity(n*n*n, nx*ny*nz);
+  for(int z=0; z<nz; ++z)
+    for(int y=0; y<ny; ++y)
+      for(int x=0; x<nx; ++x)
+        for(int i2=0; i2<n; ++i2)
+          for(int i1=0; i1<n; ++i1)
+            for(int i0=0; i0<n; ++i0)
+              connectivity(i0 + n*(i1 + n*i2), x + nx*(y + ny*z)) = (p*x+i0) + sx*((p*y+i1) + sy*(p*z+i2));
+  return connectivity;
+}
+
+template<typename Scalar, int Degree, int Points> void sum_factorization_kernel(bool mass, bool stiffness)
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef SumFactorizationKernel<Scalar,Degree,Points> Kernel;
+  typedef ElementOperator<Kernel> Operator;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  enum { Size = Kernel::Size };
+
+  // a well conditioned basis, such that the mass matrix is too
+  typename Kernel::BasisType values = Kernel::BasisType::Identity() + RealScalar(0.1)*Kernel::BasisType::Random();
+  typename Kernel::BasisType derivatives = Kernel::BasisType::Random();
+  typename Kernel::WeightsType weights = Kernel::WeightsType::Random().cwiseAbs().array() + RealScalar(0.5);
+  Kernel kernel(values, derivatives, weights);
+  VERIFY_IS_EQUAL(kernel.size(), int(Size));
+
+  // reference matrices
+  DenseMatrix tmp, phi, d0, d1, d2;
+  kroneckerProduct(values, values, tmp);
+  kroneckerProduct(values, tmp, phi);
+  kroneckerProduct(values, derivatives, tmp);
+  kroneckerProduct(values, tmp, d0);
+  kroneckerProduct(derivatives, values, tmp);
+  kroneckerProduct(values, tmp, d1);
+  kroneckerProduct(values, values, tmp);
+  kroneckerProduct(derivatives, tmp, d2);
+  DenseVector w(Points*Points*Points);
+  for(int q=0; q<w.size(); ++q)
+    w(q) = weights(q%Points) * weights((q/Points)%Points) * weights(q/(Points*Points));
+  DenseMatrix M = phi.transpose()*w.asDiagonal()*phi;
+  DenseMatrix K0 = d0.transpose()*w.asDiagonal()*d0;
+  DenseMatrix K1 = d1.transpose()*w.asDiagonal()*d1;
+  DenseMatrix K2 = d2.transpose()*w.asDiagonal()*d2;
+
+  // interpolation, gradient and integration
+  const int rows = internal::random<int>(1,20);
+  DenseMatrix X = DenseMatrix::Random(rows, Size), U, G0, G1, G2, Y;
+  kernel.interpolate(X, U);
+  VERIFY_IS_APPROX(U, X*phi.transpose());
+  kernel.gradient(X, G0, G1, G2);
+  VERIFY_IS_APPROX(G0, X*d0.transpose());
+  VERIFY_IS_APPROX(G1, X*d1.transpose());
+  VERIFY_IS_APPROX(G2, X*d2.transpose());
+  kernel.integrate(U, Y);
+  VERIFY_IS_APPROX(Y, U*phi);
+
+  // element matrices
+  const int nx = internal::random<int>(1,3), ny = internal::random<int>(1,3), nz = internal::random<int>(1,3);
+  const int ne = nx*ny*nz, n = (Degree*nx+1)*(Degree*ny+1)*(Degree*nz+1);
+  DenseVector massScales = DenseVector::Random(ne).cwiseAbs().array() + RealScalar(0.5);
+  Matrix<Scalar,3,Dynamic> stiffnessScales = Matrix<Scalar,3,Dynamic>::Random(3,ne).cwiseAbs().array() + RealScalar(0.5);
+  if(mass)
+    kernel.setMassScales(massScales);
+  if(stiffness)
+    kernel.setStiffnessScales(stiffnessScales);
+  VERIFY_IS_EQUAL(kernel.elements(), ne);
+  std::vector<DenseMatrix> refA(ne);
+  for(int e=0; e<ne; ++e)
+  {
+    refA[e] = DenseMatrix::Zero(Size, Size);
+    if(mass)
+      refA[e] += massScales(e)*M;
+    if(stiffness)
+      refA[e] += stiffnessScales(0,e)*K0 + stiffnessScales(1,e)*K1 + stiffnessScales(2,e)*K2;
+    DenseVector diag;
+    kernel.diagonal(e, diag);
+    VERIFY_IS_APPROX(diag, refA[e].diagonal());
+  }
+
+  const int count = internal::random<int>(1,20);
+  std::vector<int> elements(count);
+  for(int b=0; b<count; ++b)
+    elements[b] = internal::random<int>(0,ne-1);
+  X = DenseMatrix::Random(count+2, Size);
+  Y = DenseMatrix::Random(count+2, Size);
+  DenseMatrix refY = Y;
+  kernel.apply(&elements[0], count, X, Y);
+  for(int b=0; b<count; ++b)
+    refY.row(b) = X.row(b)*refA[elements[b]].transpose();
+  VERIFY_IS_APPROX(Y, refY);
+
+  // the work arrays are reused across batches
+  typename Kernel::Workspace work;
+  for(int batch=0; batch<2; ++batch)
+  {
+    DenseMatrix Yw = DenseMatrix::Random(count+2, Size);
+    Yw.bottomRows(2) = refY.bottomRows(2);
+    kernel.apply(&elements[0], count, X, Yw, work);
+    VERIFY_IS_APPROX(Yw, refY);
+  }
+
+  // operator
+  Matrix<int,Dynamic,Dynamic> connectivity = hex_connectivity<int>(Degree, nx, ny, nz);
+  std::vector<Triplet<Scalar> > triplets;
+  for(int e=0; e<ne; ++e)
+    for(int a=0; a<Size; ++a)
+      for(int b=0; b<Size; ++b)
+        triplets.push_back(Triplet<Scalar>(connectivity(a,e), connectivity(b,e), refA[e](a,b)));
+  SparseMatrix<Scalar> A(n,n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+
+  Operator op(n, connectivity, kernel);
+  op.setBatchSize(internal::random<int>(1,40));
+  VERIFY(op.colors() <= 8);
+  DenseVector x = DenseVector::Random(n), y;
+  VERIFY_IS_APPROX(y = op*x, A*x);
+  VERIFY_IS_APPROX(op.diagonal(), DenseVector(A.diagonal()));
+
+  // the stiffness matrix alone is singular
+  if(mass && internal::is_same<RealScalar,double>::value)
+  {
+    DenseVector b = A * DenseVector::Random(n), xs;
+    RealScalar tol = RealScalar(1e-10);
+    ConjugateGradient<Operator, Lower|Upper> cg(op);
+    cg.setTolerance(tol);
+    xs = cg.solve(b);
+    VERIFY(cg.info()==Success);
+    VERIFY((A*xs - b).norm() <= RealScalar(10)*tol*b.norm());
+  }
+}
+
+void test_sum_factorization()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( kronecker_product_apply<double,2,2,3,3,4,4>() ));
+    CALL_SUBTEST_1(( kronecker_product_apply<double,4,3,2,5,3,2>() ));
+    CALL_SUBTEST_1(( kronecker_product_apply<float,3,4,1,2,5,3>() ));
+    CALL_SUBTEST_1(( kronecker_product_apply<std::complex<double>,2,3,3,2,2,2>() ));
+    CALL_SUBTEST_2(( sum_factorization_kernel<double,1,2>(true,true) ));
+    CALL_SUBTEST_2(( sum_factorization_kernel<double,2,3>(true,false) ));
+    CALL_SUBTEST_2(( sum_factorization_kernel<double,2,4>(false,true) ));
+    CALL_SUBTEST_3(( sum_factorization_kernel<double,3,4>(true,true) ));
+    CALL_SUBTEST_3(( sum_factorization_kernel<float,2,3>(true,true) ));
+  }
+}